@@ -183,6 +183,49 @@ declare global {
          */
         getRandom(min: number, max: number): number;
 
+        /**
+         * Gets the work done by the pathfinding during the last tick and since the
+         * statistics were last reset. The statistics are local to this instance of
+         * OpenRCT2 and are always counted.
+         */
+        getPathfindingStats(): PathfindingStats;
+
+        /**
+         * Resets the statistics returned by getPathfindingStats.
+         */
+        resetPathfindingStats(): void;
+
+        /**
+         * Gets the time spent in each loaded plugin since the statistics were last reset,
+         * in total and per hook or kind of callback.
+         */
+        getPluginStats(): PluginStats[];
+
+        /**
+         * Resets the statistics returned by getPluginStats.
+         */
+        resetPluginStats(): void;
+
+        /**
+         * Gets the time spent in each stage of the game tick over the last ticks,
+         * or null if the tick profiler is not running.
+         */
+        getTickStats(): TickStats | null;
+
+        /**
+         * Starts or stops the tick profiler, which is also started by the profiler console command.
+         */
+        setTickProfiling(enabled: boolean): void;
+
+        /**
+         * Starts a worker that runs the given source code on its own thread, for long computations that
+         * should not hold up the game. The worker has no access to the game or this plugin, it only has
+         * postMessage, onmessage and console.log. Messages are copied as JSON in both directions.
+         * @param source The code to run in the worker.
+         * @throws An error if the plugin already has too many workers.
+         */
+        createWorker(source: string): Worker;
+
         /**
          * Registers a new game action that allows clients to interact with the game.
          * @param action The unique name of the action.
@@ -230,6 +273,35 @@ declare global {
         subscribe(hook: "network.leave", callback: (e: NetworkEventArgs) => void): IDisposable;
         subscribe(hook: "ride.ratings.calculate", callback: (e: RideRatingsCalculateArgs) => void): IDisposable;
         subscribe(hook: "action.location", callback: (e: ActionLocationArgs) => void): IDisposable;
+
+        /**
+         * Calls the function repeatedly, every delay milliseconds, until the interval is cleared.
+         * @returns A handle for clearInterval.
+         */
+        setInterval(callback: Function, delay: number): number;
+
+        /**
+         * Calls the function once, after delay milliseconds.
+         * @returns A handle for clearTimeout.
+         */
+        setTimeout(callback: Function, delay: number): number;
+
+        /**
+         * Like setInterval, but the delay is in game ticks and the function is called as part of the game tick,
+         * with the same rules as the interval.tick hook. It does not run while the game is paused.
+         */
+        setTickInterval(callback: Function, ticks: number): number;
+
+        /**
+         * Like setTimeout, but the delay is in game ticks and the function is called as part of the game tick.
+         */
+        setTickTimeout(callback: Function, ticks: number): number;
+
+        /**
+         * Stops an interval or timeout of this plugin, either function can be used for any handle.
+         */
+        clearInterval(handle: number): void;
+        clearTimeout(handle: number): void;
     }
 
     interface Configuration {
@@ -276,6 +348,143 @@ declare global {
         rotation: number;
     }
 
+    interface PathfindingCounters {
+        /**
+         * The number of times a direction was chosen towards a goal.
+         */
+        calls: number;
+
+        /**
+         * The number of heuristic searches started, one for each direction tried.
+         */
+        searches: number;
+
+        /**
+         * The number of tiles visited by the heuristic searches.
+         */
+        tilesChecked: number;
+
+        /**
+         * The number of thin junctions the heuristic searches went through.
+         */
+        junctions: number;
+
+        /**
+         * The number of search paths cut off by the step, tile or junction limits.
+         */
+        limitReached: number;
+
+        /**
+         * The number of directions taken from a shared distance field without searching.
+         */
+        distanceFieldHits: number;
+
+        /**
+         * The number of searches put off to a later junction because the pathfinding budget of the tick ran out.
+         */
+        budgetDeferred: number;
+
+        /**
+         * The time spent in milliseconds.
+         */
+        time: number;
+    }
+
+    interface PathfindingRideStats {
+        /**
+         * The ride that was searched for, null for park entrances, exits and staff.
+         */
+        ride: number | null;
+        calls: number;
+
+        /**
+         * The time spent in milliseconds.
+         */
+        time: number;
+    }
+
+    interface PathfindingStats {
+        /**
+         * The tick lastTick was counted in.
+         */
+        tick: number;
+        lastTick: PathfindingCounters;
+
+        /**
+         * The number of ticks since the statistics were reset.
+         */
+        ticks: number;
+        total: PathfindingCounters;
+
+        /**
+         * The time spent per ride since the statistics were reset, most expensive first.
+         */
+        rides: PathfindingRideStats[];
+    }
+
+    interface Worker {
+        /**
+         * Called on the game thread for every message the worker sends with postMessage.
+         */
+        onMessage: (data: any) => void;
+
+        /**
+         * Called when the worker code throws an error, if not set the error is written to the console.
+         */
+        onError: (message: string) => void;
+
+        /**
+         * Sends a copy of the data to the onmessage function of the worker.
+         */
+        postMessage(data: any): void;
+
+        /**
+         * Stops the worker once it has finished handling its current message.
+         */
+        terminate(): void;
+    }
+
+    interface PluginCallStats {
+        /**
+         * The hook or kind of callback, or the plugin name for the totals.
+         */
+        name: string;
+        calls: number;
+
+        /**
+         * The total and longest time spent in a single call, in milliseconds.
+         */
+        time: number;
+        maxTime: number;
+    }
+
+    interface PluginStats extends PluginCallStats {
+        hooks: PluginCallStats[];
+    }
+
+    interface TickPhaseStats {
+        name: string;
+        /**
+         * The average, 99th percentile and longest time of the stage, in milliseconds.
+         */
+        average: number;
+        p99: number;
+        max: number;
+        /**
+         * The time of the stage in the longest tick since the profiler was started.
+         */
+        worst: number;
+    }
+
+    interface TickStats {
+        /**
+         * The number of ticks the statistics are taken over.
+         */
+        ticks: number;
+        worstTick: number;
+        phases: TickPhaseStats[];
+    }
+
     type ObjectType =
         "ride" |
         "small_scenery" |
@@ -372,6 +581,7 @@ declare global {
         "signsetname" |
         "smallsceneryplace" |
         "smallsceneryremove" |
+        "smallsceneryscatter" |
         "stafffire" |
         "staffhire" |
         "staffsetcolour" |
@@ -490,9 +700,68 @@ declare global {
 
         getRide(id: number): Ride;
         getTile(x: number, y: number): Tile;
+        /**
+         * Gets the number of guests and staff on the tile at the given tile coordinates.
+         */
+        getPeepCount(x: number, y: number): number;
         getEntity(id: number): Entity;
         getAllEntities(type: EntityType): Entity[];
         getAllEntities(type: "peep"): Peep[];
+        /**
+         * Gets all the entities positioned within the given map coordinates (inclusive).
+         */
+        getAllEntitiesInRange(left: number, top: number, right: number, bottom: number): Entity[];
+        /**
+         * Gets the state of every guest in the park as packed arrays, where the same index refers to the same guest.
+         */
+        getGuestData(): GuestData;
+        /**
+         * Gets the surface heights of the given tile range (inclusive), one value per tile from the top left, row by row.
+         */
+        getSurfaceData(left: number, top: number, right: number, bottom: number): SurfaceData;
+        /**
+         * Gets the location of every tile element of the given type within the given tile range (inclusive) without
+         * creating a tile object for each tile. The index can be passed to Tile.getElement.
+         */
+        getTileElementsInRange(
+            type: TileElementType, left: number, top: number, right: number, bottom: number): TileElementData;
+        /**
+         * Starts a tile edit: until it is committed, tiles whose elements are changed, inserted or removed are
+         * redrawn once each when the edit is committed rather than after every change. An edit that is still open
+         * is committed when the plugin call that began it returns.
+         */
+        beginTileEdit(): void;
+        commitTileEdit(): void;
+    }
+
+    interface GuestData {
+        readonly count: number;
+        readonly id: Int32Array;
+        readonly x: Int32Array;
+        readonly y: Int32Array;
+        readonly z: Int32Array;
+        readonly cash: Int32Array;
+        readonly happiness: Uint8Array;
+        readonly energy: Uint8Array;
+        readonly nausea: Uint8Array;
+        readonly hunger: Uint8Array;
+        readonly thirst: Uint8Array;
+    }
+
+    interface SurfaceData {
+        readonly width: number;
+        readonly height: number;
+        readonly baseHeight: Uint8Array;
+        readonly waterHeight: Uint16Array;
+    }
+
+    interface TileElementData {
+        readonly count: number;
+        readonly x: Int32Array;
+        readonly y: Int32Array;
+        readonly index: Uint16Array;
+        readonly baseHeight: Uint8Array;
+        readonly clearanceHeight: Uint8Array;
     }
 
     type TileElementType =
@@ -904,6 +1173,70 @@ declare global {
          * The value of the ride.
          */
         value: number;
+
+        /**
+         * Gets the current queue, customer and income figures of the ride.
+         */
+        getStats(): RideStats;
+
+        /**
+         * Gets the measurements recorded from the trains of the ride, or null if none have been recorded since the
+         * park was loaded or the track last changed. Only rides with data logging are recorded.
+         */
+        getMeasurements(): RideMeasurements | null;
+    }
+
+    interface RideMeasurements {
+        /**
+         * The total number of samples recorded.
+         */
+        numSamples: number;
+        /**
+         * The number of ticks each recent sample covers.
+         */
+        ticksPerSample: number;
+        /**
+         * The number of recent samples averaged into each history sample.
+         */
+        historyInterval: number;
+        /**
+         * The latest samples, oldest first.
+         */
+        recent: RideMeasurementSamples;
+        /**
+         * A longer, downsampled history, oldest first.
+         */
+        history: RideMeasurementSamples;
+    }
+
+    /**
+     * The samples in the same units as the graphs of the ride window. The G-forces are 0 for rides without them.
+     */
+    interface RideMeasurementSamples {
+        velocity: number[];
+        altitude: number[];
+        vertical: number[];
+        lateral: number[];
+    }
+
+    interface RideStats {
+        id: number;
+        /**
+         * The number of guests in all the queues of the ride.
+         */
+        queueLength: number;
+        /**
+         * The longest time a guest is waiting in one of the queues, in minutes.
+         */
+        maxQueueTime: number;
+        riders: number;
+        customersPerHour: number;
+        totalCustomers: number;
+        incomePerHour: number;
+        profit: number;
+        totalProfit: number;
+        satisfaction: number;
+        popularity: number;
     }
 
     type RideClassification = "ride" | "stall" | "facility";
@@ -1298,6 +1631,10 @@ declare global {
         readonly players: Player[];
         readonly currentPlayer: Player;
         defaultGroup: number;
+        /**
+         * The traffic of all the connections, the server's connection for clients.
+         */
+        readonly stats: NetworkStats;
 
         getServerInfo(): ServerInfo;
         addGroup(): void;
@@ -1326,6 +1663,39 @@ declare global {
         readonly moneySpent: number;
         readonly ipAddress: string;
         readonly publicKeyHash: string;
+        /**
+         * The traffic of the player's connection, only known by the server.
+         */
+        readonly stats: NetworkStats;
+    }
+
+    interface NetworkCommandStats {
+        readonly packetsSent: number;
+        readonly bytesSent: number;
+        readonly packetsReceived: number;
+        readonly bytesReceived: number;
+    }
+
+    interface NetworkStats {
+        readonly bytesSent: number;
+        readonly bytesReceived: number;
+        /**
+         * The traffic of each type of packet, e.g. "map", "tick" or "game_action".
+         */
+        readonly commands: { [command: string]: NetworkCommandStats };
+        readonly queuedPackets: number;
+        readonly queuedBytes: number;
+        /**
+         * The time in milliseconds from queueing a packet until it was sent.
+         */
+        readonly sendLatencyAverage: number;
+        readonly sendLatencyMax: number;
+        /**
+         * The maps saved for joining or desynchronised clients, before and after compression.
+         */
+        readonly mapsSaved: number;
+        readonly mapBytesUncompressed: number;
+        readonly mapBytesCompressed: number;
     }
 
     interface PlayerGroup {
@@ -1472,6 +1842,40 @@ declare global {
 
         postMessage(message: string): void;
         postMessage(message: ParkMessageDesc): void;
+
+        /**
+         * Gets totals and averages over all the guests, cheaper than going through map.getAllEntities("peep").
+         */
+        getGuestStats(): GuestStats;
+
+        /**
+         * Gets the statistics of every ride in the park.
+         */
+        getRideStats(): RideStats[];
+    }
+
+    interface GuestStats {
+        /**
+         * The number of guests, including the ones still heading to the park.
+         */
+        count: number;
+        inPark: number;
+        queuing: number;
+        onRide: number;
+        /**
+         * Averages over the guests in the park.
+         */
+        happiness: number;
+        energy: number;
+        hunger: number;
+        thirst: number;
+        nausea: number;
+        toilet: number;
+        /**
+         * Totals over the guests in the park.
+         */
+        cashInPocket: number;
+        cashSpent: number;
     }
 
     type ScenarioObjectiveType =
@@ -1918,18 +2322,43 @@ declare global {
      * Based on node.js net.Socket, see https://nodejs.org/api/net.html for more information.
      */
     interface Socket {
+        /**
+         * The number of bytes that have been written but not yet sent.
+         */
+        readonly bufferedAmount: number;
+
         connect(port: number, host: string, callback: Function): Socket;
         destroy(error: object): Socket;
         setNoDelay(noDelay: boolean): Socket;
-        end(data?: string): Socket;
-        write(data: string): boolean;
+        /**
+         * Whether received data is given to the data event as an ArrayBuffer instead of a string.
+         * @param binary True for ArrayBuffer, false for string (the default).
+         */
+        setBinary(binary: boolean): Socket;
+        /**
+         * Ends the connection once everything written so far has been sent.
+         */
+        end(data?: string | ArrayBuffer | Uint8Array): Socket;
+        /**
+         * Queues the data to be sent.
+         * @returns false if too much data is waiting to be sent, wait for the drain event before writing more.
+         */
+        write(data: string | ArrayBuffer | Uint8Array): boolean;
 
         on(event: 'close', callback: (hadError: boolean) => void): Socket;
         on(event: 'error', callback: (hadError: boolean) => void): Socket;
-        on(event: 'data', callback: (data: string) => void): Socket;
+        /**
+         * Raised at most once per update with all the data received since the last one.
+         */
+        on(event: 'data', callback: (data: string | ArrayBuffer) => void): Socket;
+        /**
+         * Raised when all queued data has been sent after write returned false.
+         */
+        on(event: 'drain', callback: () => void): Socket;
 
         off(event: 'close', callback: (hadError: boolean) => void): Socket;
         off(event: 'error', callback: (hadError: boolean) => void): Socket;
-        off(event: 'data', callback: (data: string) => void): Socket;
+        off(event: 'data', callback: (data: string | ArrayBuffer) => void): Socket;
+        off(event: 'drain', callback: () => void): Socket;
     }
 }
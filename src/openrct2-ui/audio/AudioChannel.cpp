@@ -97,7 +97,18 @@ namespace OpenRCT2::Audio
 
         void SetRate(double rate) override
         {
-            _rate = std::max(0.001, rate);
+            // Vehicle sounds change their rate every tick, changes too small to hear are skipped so the resampler keeps
+            // its rate and rates close to 1 do not need resampling at all
+            constexpr double threshold = 0.002;
+            rate = std::max(0.001, rate);
+            if (std::abs(rate - 1) < threshold)
+            {
+                rate = 1;
+            }
+            if (rate == 1 || std::abs(rate - _rate) >= _rate * threshold)
+            {
+                _rate = rate;
+            }
         }
 
         [[nodiscard]] uint64_t GetOffset() const override
@@ -12,6 +12,7 @@
 #include "../SDLException.h"
 
 #include <SDL.h>
+#include <openrct2/MemoryReport.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/common.h>
 #include <openrct2/core/String.hpp>
@@ -31,10 +32,12 @@ namespace OpenRCT2::Audio
                 SDLException::Throw("SDL_Init(SDL_INIT_AUDIO)");
             }
             _audioMixer = AudioMixer::Create();
+            memory_report_set_provider(MemorySubsystem::Audio, AudioSource::GetMemoryUsage);
         }
 
         ~AudioContext() override
         {
+            memory_report_set_provider(MemorySubsystem::Audio, nullptr);
             delete _audioMixer;
             SDL_QuitSubSystem(SDL_INIT_AUDIO);
         }
@@ -66,6 +66,9 @@ namespace OpenRCT2::Audio
         IAudioSource* CreateMemoryFromWAV(const std::string& path, const AudioFormat* targetFormat = nullptr);
         IAudioSource* CreateStreamFromWAV(const std::string& path);
         IAudioSource* CreateStreamFromWAV(SDL_RWops* rw);
+
+        // The size of the sounds of all memory audio sources
+        size_t GetMemoryUsage();
     } // namespace AudioSource
 
     namespace AudioChannel
@@ -16,6 +16,7 @@
 #include <list>
 #include <openrct2/Context.h>
 #include <openrct2/OpenRCT2.h>
+#include <openrct2/Profiling.h>
 #include <openrct2/audio/AudioChannel.h>
 #include <openrct2/audio/AudioMixer.h>
 #include <openrct2/audio/AudioSource.h>
@@ -47,6 +48,16 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _channelBuffer;
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
+        // Channels are accumulated as floats and only clamped once when the chunk is written out
+        std::vector<float> _mixBuffer;
+        std::vector<float> _sampleBuffer;
+
+        // Resamplers of deleted channels, kept for the next channel that plays at another rate
+        std::vector<SpeexResamplerState*> _resamplerPool;
+
+        // The conversion of the last stream that was not in the output format, streams rarely change format
+        AudioFormat _convertFormat = {};
+        SDL_AudioCVT _convertCVT = {};
 
     public:
         AudioMixerImpl()
@@ -90,11 +101,16 @@ namespace OpenRCT2::Audio
         {
             // Free channels
             Lock();
-            for (IAudioChannel* channel : _channels)
+            for (auto* channel : _channels)
             {
-                delete channel;
+                DeleteChannel(channel);
             }
             _channels.clear();
+            for (auto* resampler : _resamplerPool)
+            {
+                speex_resampler_destroy(resampler);
+            }
+            _resamplerPool.clear();
             Unlock();
 
             SDL_CloseAudioDevice(_deviceId);
@@ -122,6 +138,11 @@ namespace OpenRCT2::Audio
             _convertBuffer.shrink_to_fit();
             _effectBuffer.clear();
             _effectBuffer.shrink_to_fit();
+            _mixBuffer.clear();
+            _mixBuffer.shrink_to_fit();
+            _sampleBuffer.clear();
+            _sampleBuffer.shrink_to_fit();
+            _convertFormat = {};
         }
 
         void Lock() override
@@ -209,12 +230,13 @@ namespace OpenRCT2::Audio
 
         void GetNextAudioChunk(uint8_t* dst, size_t length)
         {
+            PROFILE_ZONE("AudioMixer::GetNextAudioChunk");
             UpdateAdjustedSound();
 
-            // Zero the output buffer
-            std::fill_n(dst, length, 0);
+            // Zero the mix buffer
+            _mixBuffer.assign(length / _format.BytesPerSample(), 0.0f);
 
-            // Mix channels onto output buffer
+            // Mix channels onto the mix buffer
             auto it = _channels.begin();
             while (it != _channels.end())
             {
@@ -227,7 +249,7 @@ namespace OpenRCT2::Audio
                 }
                 if ((channel->IsDone() && channel->DeleteOnDone()) || channel->IsStopping())
                 {
-                    delete channel;
+                    DeleteChannel(channel);
                     it = _channels.erase(it);
                 }
                 else
@@ -235,6 +257,31 @@ namespace OpenRCT2::Audio
                     it++;
                 }
             }
+
+            // Clamp and convert the mix to the output format
+            switch (_format.format)
+            {
+                case AUDIO_S16SYS:
+                    ConvertFromFloat(reinterpret_cast<int16_t*>(dst), _mixBuffer.data(), _mixBuffer.size());
+                    break;
+                case AUDIO_U8:
+                    ConvertFromFloat(dst, _mixBuffer.data(), _mixBuffer.size());
+                    break;
+                default:
+                    std::fill_n(dst, length, 0);
+                    break;
+            }
+        }
+
+        void DeleteChannel(ISDLAudioChannel* channel)
+        {
+            auto resampler = channel->GetResampler();
+            if (resampler != nullptr)
+            {
+                channel->SetResampler(nullptr);
+                _resamplerPool.push_back(resampler);
+            }
+            delete channel;
         }
 
         void UpdateAdjustedSound()
@@ -263,25 +310,30 @@ namespace OpenRCT2::Audio
             }
 
             bool mustConvert = false;
-            SDL_AudioCVT cvt;
-            cvt.len_ratio = 1;
+            double lengthRatio = 1;
             AudioFormat streamformat = channel->GetFormat();
             if (streamformat != _format)
             {
-                if (SDL_BuildAudioCVT(
-                        &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels,
-                        _format.freq)
-                    == -1)
+                if (streamformat != _convertFormat)
                 {
-                    // Unable to convert channel data
-                    return;
+                    if (SDL_BuildAudioCVT(
+                            &_convertCVT, streamformat.format, streamformat.channels, streamformat.freq, _format.format,
+                            _format.channels, _format.freq)
+                        == -1)
+                    {
+                        // Unable to convert channel data
+                        _convertFormat = {};
+                        return;
+                    }
+                    _convertFormat = streamformat;
                 }
+                lengthRatio = _convertCVT.len_ratio;
                 mustConvert = true;
             }
 
             // Read raw PCM from channel
             int32_t readSamples = numSamples * rate;
-            auto readLength = static_cast<size_t>(readSamples / cvt.len_ratio) * byteRate;
+            auto readLength = static_cast<size_t>(readSamples / lengthRatio) * byteRate;
             _channelBuffer.resize(readLength);
             size_t bytesRead = channel->Read(_channelBuffer.data(), readLength);
 
@@ -290,10 +342,10 @@ namespace OpenRCT2::Audio
             size_t bufferLen = 0;
             if (mustConvert)
             {
-                if (Convert(&cvt, _channelBuffer.data(), bytesRead))
+                if (Convert(&_convertCVT, _channelBuffer.data(), bytesRead))
                 {
-                    buffer = cvt.buf;
-                    bufferLen = cvt.len_cvt;
+                    buffer = _convertCVT.buf;
+                    bufferLen = _convertCVT.len_cvt;
                 }
                 else
                 {
@@ -322,14 +374,9 @@ namespace OpenRCT2::Audio
                 buffer = _effectBuffer.data();
             }
 
-            // Apply panning and volume
-            ApplyPan(channel, buffer, bufferLen, byteRate);
-            int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
-
-            // Finally mix on to destination buffer
+            // Finally apply panning and volume while mixing on to the mix buffer
             size_t dstLength = std::min(length, bufferLen);
-            SDL_MixAudioFormat(
-                data, static_cast<const uint8_t*>(buffer), _format.format, static_cast<uint32_t>(dstLength), mixVolume);
+            MixOnToBuffer(channel, buffer, dstLength / byteRate);
 
             channel->UpdateOldVolume();
         }
@@ -344,11 +391,20 @@ namespace OpenRCT2::Audio
         {
             int32_t byteRate = _format.GetByteRate();
 
-            // Create resampler
+            // Take a resampler from the pool or create one, the rate is only updated by speex if it changed
             SpeexResamplerState* resampler = channel->GetResampler();
             if (resampler == nullptr)
             {
-                resampler = speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr);
+                if (!_resamplerPool.empty())
+                {
+                    resampler = _resamplerPool.back();
+                    _resamplerPool.pop_back();
+                    speex_resampler_reset_mem(resampler);
+                }
+                else
+                {
+                    resampler = speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr);
+                }
                 channel->SetResampler(resampler);
             }
             speex_resampler_set_rate(resampler, inRate, outRate);
@@ -362,23 +418,7 @@ namespace OpenRCT2::Audio
             return outLen * byteRate;
         }
 
-        void ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize)
-        {
-            if (channel->GetPan() != 0.5f && _format.channels == 2)
-            {
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectPanS16(channel, static_cast<int16_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                        break;
-                    case AUDIO_U8:
-                        EffectPanU8(channel, static_cast<uint8_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                        break;
-                }
-            }
-        }
-
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        float GetVolumeAdjustment(const IAudioChannel* channel) const
         {
             float volumeAdjust = _volume;
             volumeAdjust *= gConfigSound.master_sound_enabled ? (static_cast<float>(gConfigSound.master_volume) / 100.0f)
@@ -400,90 +440,116 @@ namespace OpenRCT2::Audio
                     volumeAdjust *= _adjustMusicVolume;
                     break;
             }
+            return volumeAdjust;
+        }
+
+        /**
+         * Adds the frames in buffer, which is in the mixer format, to the mix buffer. The volume fades from the old to the
+         * new volume of the channel over the buffer to minimize clicks from sudden volume changes, and so does the panning.
+         */
+        void MixOnToBuffer(const IAudioChannel* channel, const void* buffer, size_t numFrames)
+        {
+            if (numFrames == 0)
+            {
+                return;
+            }
 
+            float volumeAdjust = GetVolumeAdjustment(channel);
             int32_t startVolume = channel->GetOldVolume() * volumeAdjust;
-            int32_t endVolume = channel->GetVolume() * volumeAdjust;
-            if (channel->IsStopping())
+            int32_t endVolume = channel->IsStopping() ? 0 : channel->GetVolume() * volumeAdjust;
+            float startGain = static_cast<float>(startVolume) / MIXER_VOLUME_MAX;
+            float endGain = static_cast<float>(endVolume) / MIXER_VOLUME_MAX;
+            if (startGain == 0 && endGain == 0)
             {
-                endVolume = 0;
+                return;
             }
 
-            int32_t mixVolume = channel->GetVolume() * volumeAdjust;
-            if (startVolume != endVolume)
+            size_t numSamples = numFrames * _format.channels;
+            _sampleBuffer.resize(numSamples);
+            switch (_format.format)
             {
-                // Set to max since we are adjusting the volume ourselves
-                mixVolume = MIXER_VOLUME_MAX;
+                case AUDIO_S16SYS:
+                    ConvertToFloat(_sampleBuffer.data(), static_cast<const int16_t*>(buffer), numSamples);
+                    break;
+                case AUDIO_U8:
+                    ConvertToFloat(_sampleBuffer.data(), static_cast<const uint8_t*>(buffer), numSamples);
+                    break;
+                default:
+                    return;
+            }
 
-                // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
-                int32_t fadeLength = static_cast<int32_t>(len) / _format.BytesPerSample();
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectFadeS16(static_cast<int16_t*>(buffer), fadeLength, startVolume, endVolume);
-                        break;
-                    case AUDIO_U8:
-                        EffectFadeU8(static_cast<uint8_t*>(buffer), fadeLength, startVolume, endVolume);
-                        break;
-                }
+            const float* src = _sampleBuffer.data();
+            float* dst = _mixBuffer.data();
+            if (_format.channels == 2)
+            {
+                float startGainL = startGain * channel->GetOldVolumeL();
+                float startGainR = startGain * channel->GetOldVolumeR();
+                float stepL = (endGain * channel->GetVolumeL() - startGainL) / numFrames;
+                float stepR = (endGain * channel->GetVolumeR() - startGainR) / numFrames;
+                MixStereo(dst, src, numFrames, startGainL, stepL, startGainR, stepR);
+            }
+            else
+            {
+                MixInterleaved(dst, src, numFrames, _format.channels, startGain, (endGain - startGain) / numFrames);
             }
-            return mixVolume;
         }
 
-        static void EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length)
-        {
-            const float dt = 1.0f / static_cast<float>(length * 2.0f);
-            float volumeL = channel->GetOldVolumeL();
-            float volumeR = channel->GetOldVolumeR();
-            const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
-            const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
+        // The kernels below are kept to plain loops without dependencies between the iterations, so the compiler can
+        // vectorise them.
 
-            for (int32_t i = 0; i < length * 2; i += 2)
+        static void ConvertToFloat(float* dst, const int16_t* src, size_t numSamples)
+        {
+            for (size_t i = 0; i < numSamples; i++)
             {
-                data[i + 0] = static_cast<int16_t>(volumeL * static_cast<float>(data[i + 0]));
-                data[i + 1] = static_cast<int16_t>(volumeR * static_cast<float>(data[i + 1]));
-                volumeL += d_left;
-                volumeR += d_right;
+                dst[i] = static_cast<float>(src[i]);
             }
         }
 
-        static void EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length)
+        static void ConvertToFloat(float* dst, const uint8_t* src, size_t numSamples)
         {
-            float volumeL = channel->GetVolumeL();
-            float volumeR = channel->GetVolumeR();
-            float oldVolumeL = channel->GetOldVolumeL();
-            float oldVolumeR = channel->GetOldVolumeR();
-
-            for (int32_t i = 0; i < length * 2; i += 2)
+            for (size_t i = 0; i < numSamples; i++)
             {
-                float t = static_cast<float>(i) / static_cast<float>(length * 2.0f);
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0 - t) * oldVolumeL + t * volumeL));
-                data[i + 1] = static_cast<uint8_t>(data[i + 1] * ((1.0 - t) * oldVolumeR + t * volumeR));
+                dst[i] = (static_cast<float>(src[i]) - 128.0f) * 256.0f;
             }
         }
 
-        static void EffectFadeS16(int16_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+        static void ConvertFromFloat(int16_t* dst, const float* src, size_t numSamples)
         {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
+            for (size_t i = 0; i < numSamples; i++)
+            {
+                dst[i] = static_cast<int16_t>(std::clamp(src[i], -32768.0f, 32767.0f));
+            }
+        }
 
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+        static void ConvertFromFloat(uint8_t* dst, const float* src, size_t numSamples)
+        {
+            for (size_t i = 0; i < numSamples; i++)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<int16_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                dst[i] = static_cast<uint8_t>(std::clamp(src[i] / 256.0f + 128.0f, 0.0f, 255.0f));
             }
         }
 
-        static void EffectFadeU8(uint8_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+        static void MixStereo(
+            float* dst, const float* src, size_t numFrames, float gainL, float stepL, float gainR, float stepR)
         {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
+            for (size_t i = 0; i < numFrames; i++)
+            {
+                auto t = static_cast<float>(i);
+                dst[i * 2 + 0] += src[i * 2 + 0] * (gainL + t * stepL);
+                dst[i * 2 + 1] += src[i * 2 + 1] * (gainR + t * stepR);
+            }
+        }
 
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+        static void MixInterleaved(
+            float* dst, const float* src, size_t numFrames, int32_t numChannels, float gain, float step)
+        {
+            for (size_t i = 0; i < numFrames; i++)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                auto frameGain = gain + static_cast<float>(i) * step;
+                for (int32_t j = 0; j < numChannels; j++)
+                {
+                    dst[i * numChannels + j] += src[i * numChannels + j] * frameGain;
+                }
             }
         }
 
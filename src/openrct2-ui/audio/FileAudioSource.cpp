@@ -12,23 +12,57 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <thread>
 
 namespace OpenRCT2::Audio
 {
     /**
      * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * a file. The data is read ahead into a ring buffer on a thread of its own, the mixer callback only copies from the
+     * buffer and never waits for the disk.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
     private:
+        static constexpr size_t BufferSize = 256 * 1024;
+        static constexpr size_t ReadChunkSize = 16 * 1024;
+        static constexpr size_t PrefillChunks = 4;
+
         AudioFormat _format = {};
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
 
+        // The ring buffer, positions only ever increase and are wrapped when indexing the buffer. The reader thread
+        // reads the data from start to end over and over, as streams usually loop.
+        std::unique_ptr<uint8_t[]> _buffer;
+        std::atomic<size_t> _readPosition{};
+        std::atomic<size_t> _writePosition{};
+        std::thread _readerThread;
+        std::atomic<bool> _stopReader{};
+
+        // Repositioning the reader, requested by the mixer when it reads from another offset than the buffer continues at
+        std::atomic<uint64_t> _seekRequestOffset{};
+        std::atomic<uint32_t> _seekRequestGeneration{};
+        std::atomic<size_t> _seekStartPosition{};
+        std::atomic<uint64_t> _seekStartOffset{};
+        std::atomic<uint32_t> _seekCompletedGeneration{};
+
+        // Only used from the reader thread
+        uint64_t _streamOffset = 0;
+        uint32_t _streamGeneration = 0;
+
+        // Only used from the mixer
+        uint64_t _readOffset = 0;
+        uint32_t _readGeneration = 0;
+        uint32_t _lastSeekGeneration = 0;
+
     public:
         ~FileAudioSource() override
         {
@@ -47,25 +81,75 @@ namespace OpenRCT2::Audio
 
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
-            size_t bytesRead = 0;
-            int64_t currentPosition = SDL_RWtell(_rw);
-            if (currentPosition != -1)
+            if (_buffer == nullptr || offset >= _dataLength)
             {
-                size_t bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
-                int64_t dataOffset = _dataBegin + offset;
-                if (currentPosition != dataOffset)
+                return 0;
+            }
+
+            // Skip what was read ahead before the reader last repositioned
+            auto completedGeneration = _seekCompletedGeneration.load(std::memory_order_acquire);
+            if (completedGeneration != _readGeneration)
+            {
+                _readGeneration = completedGeneration;
+                _readPosition.store(_seekStartPosition.load(), std::memory_order_release);
+                _readOffset = _seekStartOffset.load();
+            }
+
+            auto bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
+            size_t bytesCopied = 0;
+            if (offset == _readOffset)
+            {
+                auto readPosition = _readPosition.load();
+                auto available = _writePosition.load(std::memory_order_acquire) - readPosition;
+                bytesCopied = std::min(bytesToRead, available);
+
+                auto index = readPosition % BufferSize;
+                auto firstLength = std::min(bytesCopied, BufferSize - index);
+                std::memcpy(dst, &_buffer[index], firstLength);
+                std::memcpy(static_cast<uint8_t*>(dst) + firstLength, &_buffer[0], bytesCopied - firstLength);
+                _readPosition.store(readPosition + bytesCopied, std::memory_order_release);
+
+                _readOffset += bytesCopied;
+                if (_readOffset >= _dataLength)
                 {
-                    int64_t newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
-                    if (newPosition == -1)
-                    {
-                        return 0;
-                    }
+                    _readOffset = 0;
                 }
-                bytesRead = SDL_RWread(_rw, dst, 1, bytesToRead);
             }
-            return bytesRead;
+
+            if (bytesCopied < bytesToRead)
+            {
+                // Play silence until the reader has caught up with where the channel will be next
+                auto nextOffset = offset + bytesToRead;
+                RequestSeek(nextOffset >= _dataLength ? 0 : nextOffset);
+                std::memset(
+                    static_cast<uint8_t*>(dst) + bytesCopied, _format.format == AUDIO_U8 ? 0x80 : 0,
+                    bytesToRead - bytesCopied);
+            }
+            return bytesToRead;
         }
 
+        bool Load(SDL_RWops* rw)
+        {
+            if (!LoadWAV(rw))
+            {
+                return false;
+            }
+
+            _buffer = std::make_unique<uint8_t[]>(BufferSize);
+
+            // Have the start ready before the channel is first mixed
+            size_t numChunks = 0;
+            while (numChunks < PrefillChunks && ReadNextChunk())
+            {
+                numChunks++;
+            }
+
+            _stopReader = false;
+            _readerThread = std::thread([this]() { ReadAhead(); });
+            return true;
+        }
+
+    private:
         bool LoadWAV(SDL_RWops* rw)
         {
             const uint32_t DATA = 0x61746164;
@@ -143,7 +227,88 @@ namespace OpenRCT2::Audio
             return true;
         }
 
-    private:
+        void RequestSeek(uint64_t offset)
+        {
+            // Only one request is in flight at a time, unless the channel itself has moved on
+            if (_lastSeekGeneration != _readGeneration && _seekRequestOffset.load() == offset)
+            {
+                return;
+            }
+            _seekRequestOffset.store(offset);
+            _lastSeekGeneration = _seekRequestGeneration.load() + 1;
+            _seekRequestGeneration.store(_lastSeekGeneration, std::memory_order_release);
+        }
+
+        void ReadAhead()
+        {
+            while (!_stopReader)
+            {
+                if (!ReadNextChunk())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+        }
+
+        // Returns false if the buffer is full or nothing could be read
+        bool ReadNextChunk()
+        {
+            auto writePosition = _writePosition.load();
+            auto requestedGeneration = _seekRequestGeneration.load(std::memory_order_acquire);
+            if (requestedGeneration != _streamGeneration)
+            {
+                _streamGeneration = requestedGeneration;
+                _streamOffset = _seekRequestOffset.load();
+                _seekStartPosition.store(writePosition);
+                _seekStartOffset.store(_streamOffset);
+                _seekCompletedGeneration.store(_streamGeneration, std::memory_order_release);
+            }
+
+            auto freeSpace = BufferSize - (writePosition - _readPosition.load(std::memory_order_acquire));
+            if (freeSpace < ReadChunkSize)
+            {
+                return false;
+            }
+
+            auto index = writePosition % BufferSize;
+            auto readLength = static_cast<size_t>(
+                std::min<uint64_t>({ ReadChunkSize, BufferSize - index, _dataLength - _streamOffset }));
+            auto bytesRead = ReadFile(&_buffer[index], _streamOffset, readLength);
+            if (bytesRead == 0)
+            {
+                return false;
+            }
+
+            _writePosition.store(writePosition + bytesRead, std::memory_order_release);
+            _streamOffset += bytesRead;
+            if (_streamOffset >= _dataLength)
+            {
+                _streamOffset = 0;
+            }
+            return true;
+        }
+
+        size_t ReadFile(void* dst, uint64_t offset, size_t len)
+        {
+            size_t bytesRead = 0;
+            int64_t currentPosition = SDL_RWtell(_rw);
+            if (currentPosition != -1)
+            {
+                size_t bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
+                int64_t dataOffset = _dataBegin + offset;
+                if (currentPosition != dataOffset)
+                {
+                    int64_t newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
+                    if (newPosition == -1)
+                    {
+                        return 0;
+                    }
+                }
+                bytesRead = SDL_RWread(_rw, dst, 1, bytesToRead);
+            }
+            return bytesRead;
+        }
+
         static uint32_t FindChunk(SDL_RWops* rw, uint32_t wantedId)
         {
             uint32_t subchunkId = SDL_ReadLE32(rw);
@@ -171,6 +336,12 @@ namespace OpenRCT2::Audio
 
         void Unload()
         {
+            if (_readerThread.joinable())
+            {
+                _stopReader = true;
+                _readerThread.join();
+            }
+            _buffer = nullptr;
             if (_rw != nullptr)
             {
                 SDL_RWclose(_rw);
@@ -195,7 +366,7 @@ namespace OpenRCT2::Audio
     IAudioSource* AudioSource::CreateStreamFromWAV(SDL_RWops* rw)
     {
         auto source = new FileAudioSource();
-        if (!source->LoadWAV(rw))
+        if (!source->Load(rw))
         {
             delete source;
             source = nullptr;
@@ -12,12 +12,15 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <atomic>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
 #include <vector>
 
 namespace OpenRCT2::Audio
 {
+    static std::atomic<size_t> _memoryUsage;
+
     /**
      * An audio source where raw PCM data is initially loaded into RAM from
      * a file and then streamed.
@@ -30,6 +33,13 @@ namespace OpenRCT2::Audio
         uint8_t* _dataSDL = nullptr;
         size_t _length = 0;
 
+        void SetLength(size_t length)
+        {
+            _memoryUsage += length;
+            _memoryUsage -= _length;
+            _length = length;
+        }
+
         const uint8_t* GetData()
         {
             return _dataSDL != nullptr ? _dataSDL : _data.data();
@@ -85,7 +95,7 @@ namespace OpenRCT2::Audio
                     _format.freq = spec->freq;
                     _format.format = spec->format;
                     _format.channels = spec->channels;
-                    _length = audioLen;
+                    SetLength(audioLen);
                     result = true;
                 }
                 else
@@ -123,7 +133,7 @@ namespace OpenRCT2::Audio
 
                     uint32_t pcmSize;
                     SDL_RWread(rw, &pcmSize, sizeof(pcmSize), 1);
-                    _length = pcmSize;
+                    SetLength(pcmSize);
 
                     WaveFormatEx waveFormat{};
                     SDL_RWread(rw, &waveFormat, sizeof(waveFormat), 1);
@@ -171,7 +181,7 @@ namespace OpenRCT2::Audio
 
                         Unload();
                         _data = std::move(cvtBuffer);
-                        _length = cvt.len_cvt;
+                        SetLength(cvt.len_cvt);
                         _format = *format;
                         return true;
                     }
@@ -191,10 +201,15 @@ namespace OpenRCT2::Audio
             SDL_FreeWAV(_dataSDL);
             _dataSDL = nullptr;
 
-            _length = 0;
+            SetLength(0);
         }
     };
 
+    size_t AudioSource::GetMemoryUsage()
+    {
+        return _memoryUsage;
+    }
+
     IAudioSource* AudioSource::CreateMemoryFromCSS1(const std::string& path, size_t index, const AudioFormat* targetFormat)
     {
         auto source = new MemoryAudioSource();
@@ -11,9 +11,12 @@
 
 #include <SDL.h>
 #include <cmath>
+#include <cstring>
 #include <openrct2/Game.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <openrct2/drawing/Drawing.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/LightFX.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
@@ -29,6 +32,8 @@ class HardwareDisplayDrawingEngine final : public X8DrawingEngine
 {
 private:
     constexpr static uint32_t DIRTY_VISUAL_TIME = 32;
+    // Unchanged rows between two changed ones are converted too if the gap is smaller than this, saving a texture lock
+    constexpr static int32_t TEXTURE_ROW_MERGE_GAP = 16;
 
     std::shared_ptr<IUiContext> const _uiContext;
     SDL_Window* _window = nullptr;
@@ -50,6 +55,11 @@ private:
 
     std::vector<uint32_t> _dirtyVisualsTime;
 
+    // The frame last copied to the screen texture, to only convert the rows that changed since
+    std::vector<uint8_t> _textureBits;
+    std::vector<uint8_t> _textureRowChanged;
+    bool _textureStale = true;
+
     bool smoothNN = false;
 
 public:
@@ -153,6 +163,7 @@ public:
         _screenTextureFormat = SDL_AllocFormat(format);
 
         ConfigureBits(width, height, width);
+        _textureStale = true;
     }
 
     void SetPalette(const GamePalette& palette) override
@@ -163,6 +174,7 @@ public:
             {
                 _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
             }
+            _textureStale = true;
 
 #ifdef __ENABLE_LIGHTFX__
             if (gConfigGeneral.enable_light_fx)
@@ -217,6 +229,7 @@ private:
                 lightfx_render_to_texture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _textureStale = true;
         }
         else
 #endif
@@ -256,48 +269,137 @@ private:
         }
     }
 
+    template<typename TFunc> static void ForEachRow(int32_t numRows, TFunc&& fn)
+    {
+        if (gConfigGeneral.multithreading)
+        {
+            TaskScheduler::GetGlobal().ParallelFor(0, numRows, 0, fn);
+        }
+        else
+        {
+            for (int32_t y = 0; y < numRows; y++)
+            {
+                fn(y);
+            }
+        }
+    }
+
     void CopyBitsToTexture(SDL_Texture* texture, uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
     {
-        void* pixels;
-        int32_t pitch;
-        if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
+        if (_screenTextureFormat == nullptr || _screenTextureFormat->BytesPerPixel != 4)
         {
-            int32_t padding = pitch - (width * 4);
-            if (pitch == width * 4)
+            CopyBitsToTextureNarrow(texture, src, width, height, palette);
+            return;
+        }
+
+        const int32_t srcPitch = static_cast<int32_t>(_pitch);
+        const size_t bitsSize = static_cast<size_t>(srcPitch) * height;
+        if (_textureBits.size() != bitsSize)
+        {
+            _textureBits.resize(bitsSize);
+            _textureStale = true;
+        }
+        if (_textureStale)
+        {
+            if (CopyRowsToTexture(texture, src, width, 0, height, palette))
             {
-                uint32_t* dst = static_cast<uint32_t*>(pixels);
-                for (int32_t i = width * height; i > 0; i--)
+                std::memcpy(_textureBits.data(), src, bitsSize);
+                _textureStale = false;
+            }
+            return;
+        }
+
+        // Anything drawn to the frame buffer shows up here, including overlays that do not use dirty blocks
+        _textureRowChanged.resize(height);
+        ForEachRow(height, [&](int32_t y) {
+            const uint8_t* row = src + static_cast<size_t>(y) * srcPitch;
+            uint8_t* lastRow = _textureBits.data() + static_cast<size_t>(y) * srcPitch;
+            const bool changed = std::memcmp(row, lastRow, width) != 0;
+            if (changed)
+            {
+                std::memcpy(lastRow, row, width);
+            }
+            _textureRowChanged[y] = changed;
+        });
+
+        int32_t y = 0;
+        while (y < height)
+        {
+            if (!_textureRowChanged[y])
+            {
+                y++;
+                continue;
+            }
+            const int32_t top = y;
+            int32_t bottom = y + 1;
+            for (y = bottom; y < height && y - bottom < TEXTURE_ROW_MERGE_GAP; y++)
+            {
+                if (_textureRowChanged[y])
                 {
-                    *dst++ = palette[*src++];
+                    bottom = y + 1;
                 }
             }
-            else
+            if (!CopyRowsToTexture(texture, src, width, top, bottom, palette))
+            {
+                _textureStale = true;
+                return;
+            }
+            y = bottom;
+        }
+    }
+
+    bool CopyRowsToTexture(
+        SDL_Texture* texture, const uint8_t* src, int32_t width, int32_t top, int32_t bottom, const uint32_t* palette)
+    {
+        void* pixels;
+        int32_t pitch;
+        SDL_Rect rect = { 0, top, width, bottom - top };
+        if (SDL_LockTexture(texture, &rect, &pixels, &pitch) != 0)
+        {
+            return false;
+        }
+
+        const size_t srcPitch = _pitch;
+        ForEachRow(bottom - top, [=](int32_t row) {
+            const uint8_t* srcRow = src + (top + row) * srcPitch;
+            uint32_t* dstRow = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + static_cast<size_t>(row) * pitch);
+            palette_expand_fn(srcRow, dstRow, width, palette);
+        });
+        SDL_UnlockTexture(texture);
+        return true;
+    }
+
+    void CopyBitsToTextureNarrow(SDL_Texture* texture, uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
+    {
+        void* pixels;
+        int32_t pitch;
+        if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
+        {
+            int32_t padding = pitch - (width * 4);
+            if (pitch == (width * 2) + padding)
             {
-                if (pitch == (width * 2) + padding)
+                uint16_t* dst = static_cast<uint16_t*>(pixels);
+                for (int32_t y = height; y > 0; y--)
                 {
-                    uint16_t* dst = static_cast<uint16_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    for (int32_t x = width; x > 0; x--)
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            const uint8_t lower = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            const uint8_t upper = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            *dst++ = (lower << 8) | upper;
-                        }
-                        dst = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + padding);
+                        const uint8_t lower = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
+                        const uint8_t upper = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
+                        *dst++ = (lower << 8) | upper;
                     }
+                    dst = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + padding);
                 }
-                else if (pitch == width + padding)
+            }
+            else if (pitch == width + padding)
+            {
+                uint8_t* dst = static_cast<uint8_t*>(pixels);
+                for (int32_t y = height; y > 0; y--)
                 {
-                    uint8_t* dst = static_cast<uint8_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    for (int32_t x = width; x > 0; x--)
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            *dst++ = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                        }
-                        dst += padding;
+                        *dst++ = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
                     }
+                    dst += padding;
                 }
             }
             SDL_UnlockTexture(texture);
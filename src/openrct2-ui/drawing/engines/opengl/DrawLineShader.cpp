@@ -32,7 +32,6 @@ DrawLineShader::DrawLineShader()
     GetLocations();
 
     glGenBuffers(1, &_vbo);
-    glGenBuffers(1, &_vboInstances);
     glGenVertexArrays(1, &_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -48,15 +47,6 @@ DrawLineShader::DrawLineShader()
     glVertexAttribPointer(
         vVertMat + 3, 2, GL_FLOAT, GL_FALSE, sizeof(VDStruct), reinterpret_cast<void*>(offsetof(VDStruct, mat[3])));
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, clip)));
-    glVertexAttribIPointer(
-        vBounds, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, bounds)));
-    glVertexAttribIPointer(
-        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, colour)));
-    glVertexAttribIPointer(
-        vDepth, 1, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, depth)));
-
     glEnableVertexAttribArray(vVertMat + 0);
     glEnableVertexAttribArray(vVertMat + 1);
     glEnableVertexAttribArray(vVertMat + 2);
@@ -98,14 +88,26 @@ void DrawLineShader::SetScreenSize(int32_t width, int32_t height)
     glUniform2i(uScreenSize, width, height);
 }
 
-void DrawLineShader::DrawInstances(const LineCommandBatch& instances)
+void DrawLineShader::DrawInstances(StreamBuffer& instanceBuffer, const LineCommandBatch& instances)
 {
     glBindVertexArray(_vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawLineCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
+    auto offset = instanceBuffer.Upload(instances.data(), sizeof(DrawLineCommand) * instances.size());
+    SetInstanceAttributes(offset);
 
     glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(instances.size()));
 }
 
+// Points the per-instance attributes at the commands uploaded at the given offset of the bound buffer
+void DrawLineShader::SetInstanceAttributes(GLintptr offset)
+{
+    auto attribute = [offset](size_t member) { return reinterpret_cast<void*>(offset + member); };
+
+    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawLineCommand), attribute(offsetof(DrawLineCommand, clip)));
+    glVertexAttribIPointer(vBounds, 4, GL_INT, sizeof(DrawLineCommand), attribute(offsetof(DrawLineCommand, bounds)));
+    glVertexAttribIPointer(
+        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand), attribute(offsetof(DrawLineCommand, colour)));
+    glVertexAttribIPointer(vDepth, 1, GL_INT, sizeof(DrawLineCommand), attribute(offsetof(DrawLineCommand, depth)));
+}
+
 #endif /* DISABLE_OPENGL */
@@ -38,6 +38,7 @@
 #    define glTexImage3D __static__glTexImage3D
 #    define glGetIntegerv __static__glGetIntegerv
 #    define glGetTexImage __static__glGetTexImage
+#    define glScissor __static__glScissor
 
 #endif
 
@@ -72,6 +73,7 @@
 #    undef glTexImage3D
 #    undef glGetIntegerv
 #    undef glGetTexImage
+#    undef glScissor
 
 // 1.1 function signatures
 using PFNGLBEGINPROC = void(APIENTRYP)(GLenum mode);
@@ -104,6 +106,7 @@ using PFNGLTEXIMAGE3DPROC = void(APIENTRYP)(
     GLenum type, const GLvoid* data);
 using PFNGLGETINTERGERVPROC = void(APIENTRYP)(GLenum pname, GLint* data);
 using PFNGLGETTEXIMAGEPROC = void(APIENTRYP)(GLenum target, GLint level, GLenum format, GLenum type, GLvoid* img);
+using PFNGLSCISSORPROC = void(APIENTRYP)(GLint x, GLint y, GLsizei width, GLsizei height);
 
 #    define OPENGL_PROC(TYPE, PROC) extern TYPE PROC;
 #    include "OpenGLAPIProc.h"
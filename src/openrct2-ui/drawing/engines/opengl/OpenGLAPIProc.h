@@ -36,6 +36,7 @@ OPENGL_PROC(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D)
 OPENGL_PROC(PFNGLTEXIMAGE3DPROC, glTexImage3D)
 OPENGL_PROC(PFNGLGETINTERGERVPROC, glGetIntegerv)
 OPENGL_PROC(PFNGLGETTEXIMAGEPROC, glGetTexImage)
+OPENGL_PROC(PFNGLSCISSORPROC, glScissor)
 
 // 2.0+ function pointers
 OPENGL_PROC(PFNGLATTACHSHADERPROC, glAttachShader)
@@ -84,3 +85,14 @@ OPENGL_PROC(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer)
 OPENGL_PROC(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced)
 OPENGL_PROC(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor)
 OPENGL_PROC(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+OPENGL_PROC(PFNGLGENQUERIESPROC, glGenQueries)
+OPENGL_PROC(PFNGLDELETEQUERIESPROC, glDeleteQueries)
+OPENGL_PROC(PFNGLBEGINQUERYPROC, glBeginQuery)
+OPENGL_PROC(PFNGLENDQUERYPROC, glEndQuery)
+
+// 3.0+ function pointers
+OPENGL_PROC(PFNGLBUFFERSUBDATAPROC, glBufferSubData)
+OPENGL_PROC(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange)
+OPENGL_PROC(PFNGLUNMAPBUFFERPROC, glUnmapBuffer)
+OPENGL_PROC(PFNGLBEGINCONDITIONALRENDERPROC, glBeginConditionalRender)
+OPENGL_PROC(PFNGLENDCONDITIONALRENDERPROC, glEndConditionalRender)
@@ -17,15 +17,17 @@
 #    include "GLSLTypes.h"
 #    include "OpenGLAPI.h"
 #    include "OpenGLFramebuffer.h"
+#    include "StreamBuffer.h"
 #    include "SwapFramebuffer.h"
 #    include "TextureCache.h"
-#    include "TransparencyDepth.h"
 
 #    include <SDL.h>
 #    include <algorithm>
 #    include <cmath>
+#    include <limits>
 #    include <openrct2-ui/interface/Window.h>
 #    include <openrct2/Intro.h>
+#    include <openrct2/MemoryReport.h>
 #    include <openrct2/config/Config.h>
 #    include <openrct2/core/Console.hpp>
 #    include <openrct2/drawing/Drawing.h>
@@ -33,10 +35,13 @@
 #    include <openrct2/drawing/IDrawingEngine.h>
 #    include <openrct2/drawing/LightFX.h>
 #    include <openrct2/drawing/Weather.h>
+#    include <openrct2/drawing/X8DrawingEngine.h>
 #    include <openrct2/interface/Screenshot.h>
 #    include <openrct2/ui/UiContext.h>
 #    include <openrct2/world/Climate.h>
 #    include <unordered_map>
+#    include <utility>
+#    include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -50,6 +55,12 @@ struct OpenGLVersion
 
 constexpr OpenGLVersion OPENGL_MINIMUM_REQUIRED_VERSION = { 3, 3 };
 
+// Initial size of the buffer the draw commands are streamed through, enough for a few frames of a busy park
+constexpr GLsizeiptr INSTANCE_BUFFER_INITIAL_CAPACITY = 8 * 1024 * 1024;
+
+// Upper bound for the number of transparent layers peeled per batch, the GPU stops sooner once a layer is empty
+constexpr size_t MAX_TRANSPARENCY_LAYERS = 16;
+
 class OpenGLDrawingEngine;
 
 class OpenGLDrawingContext final : public IDrawingContext
@@ -61,6 +72,8 @@ private:
     DrawLineShader* _drawLineShader = nullptr;
     DrawRectShader* _drawRectShader = nullptr;
     SwapFramebuffer* _swapFramebuffer = nullptr;
+    StreamBuffer* _instanceBuffer = nullptr;
+    GLuint _transparencyQueries[MAX_TRANSPARENCY_LAYERS] = {};
 
     TextureCache* _textureCache = nullptr;
 
@@ -81,6 +94,9 @@ private:
         RectCommandBatch transparent;
     } _commandBuffers;
 
+    uint32_t _drawCalls = 0;
+    DrawingEngineStatistics _lastFrameStatistics = {};
+
 public:
     explicit OpenGLDrawingContext(OpenGLDrawingEngine* engine);
     ~OpenGLDrawingContext() override;
@@ -94,11 +110,16 @@ public:
     {
         return _swapFramebuffer->GetFinalFramebuffer();
     }
+    const DrawingEngineStatistics& GetLastFrameStatistics() const
+    {
+        return _lastFrameStatistics;
+    }
 
     void Initialise();
     void Resize(int32_t width, int32_t height);
     void ResetPalette();
     void StartNewDraw();
+    void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy);
 
     void Clear(uint8_t paletteIndex) override;
     void FillRect(uint32_t colour, int32_t x, int32_t y, int32_t w, int32_t h) override;
@@ -110,6 +131,7 @@ public:
     void DrawGlyph(uint32_t image, int32_t x, int32_t y, const PaletteMap& palette) override;
 
     void FlushCommandBuffers();
+    void UpdateFrameStatistics();
 
     void FlushLines();
     void FlushRectangles();
@@ -125,6 +147,8 @@ public:
 class OpenGLWeatherDrawer final : public IWeatherDrawer
 {
     OpenGLDrawingContext* _drawingContext;
+    // The canvas is kept between frames, so the regions weather was drawn over are redrawn in the next one
+    std::vector<ScreenRect> _drawnRegions;
 
 public:
     explicit OpenGLWeatherDrawer(OpenGLDrawingContext* drawingContext)
@@ -132,6 +156,16 @@ public:
     {
     }
 
+    const std::vector<ScreenRect>& GetDrawnRegions() const
+    {
+        return _drawnRegions;
+    }
+
+    void ClearDrawnRegions()
+    {
+        _drawnRegions.clear();
+    }
+
     virtual void Draw(
         int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
         const uint8_t* weatherpattern) override
@@ -144,31 +178,28 @@ public:
         uint8_t patternStartYOffset = yStart % patternYSpace;
 
         const auto* dpi = _drawingContext->GetDPI();
+        int32_t maxX = std::min<int32_t>(x + width, dpi->width);
+        int32_t maxY = std::min<int32_t>(y + height, dpi->height);
+        if (x < maxX && y < maxY)
+        {
+            _drawnRegions.emplace_back(x, y, maxX, maxY);
+        }
 
-        uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
+        // Walk each pattern row as a span and queue its pixels, they are drawn in one batch with the other lines
         uint8_t patternYPos = patternStartYOffset % patternYSpace;
-
-        for (; height != 0; height--)
+        for (int32_t pixelY = y; pixelY < maxY; pixelY++)
         {
             uint8_t patternX = pattern[patternYPos * 2];
             if (patternX != 0xFF)
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
                 uint8_t patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
+                int32_t pixelX = x + (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+                for (; pixelX < maxX; pixelX += patternXSpace)
                 {
-                    int32_t pixelX = xPixelOffset % dpi->width;
-                    int32_t pixelY = (xPixelOffset / dpi->width) % dpi->height;
-
                     _drawingContext->DrawLine(patternPixel, pixelX, pixelY, pixelX + 1, pixelY + 1);
                 }
             }
 
-            pixelOffset += dpi->pitch + dpi->width;
             patternYPos++;
             patternYPos %= patternYSpace;
         }
@@ -190,6 +221,8 @@ private:
 
     rct_drawpixelinfo _bitsDPI = {};
 
+    DirtyGrid _dirtyGrid = {};
+
     OpenGLDrawingContext* _drawingContext;
 
     ApplyPaletteShader* _applyPaletteShader = nullptr;
@@ -198,6 +231,8 @@ private:
     OpenGLFramebuffer* _smoothScaleFramebuffer = nullptr;
     OpenGLWeatherDrawer _weatherDrawer;
 
+    std::vector<std::pair<uint32_t, uint32_t>> _prewarmedImageRanges;
+
 public:
     SDL_Color Palette[256];
     vec4 GLPalette[256];
@@ -220,6 +255,7 @@ public:
         delete _screenFramebuffer;
 
         delete _drawingContext;
+        delete[] _dirtyGrid.Blocks;
         delete[] _bits;
 
         SDL_GL_DeleteContext(_context);
@@ -254,6 +290,7 @@ public:
     void Resize(uint32_t width, uint32_t height) override
     {
         ConfigureBits(width, height, width);
+        ConfigureDirtyGrid();
         ConfigureCanvas();
         _drawingContext->Resize(width, height);
     }
@@ -289,18 +326,48 @@ public:
 
     void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom) override
     {
+        left = std::max(left, 0);
+        top = std::max(top, 0);
+        right = std::min(right, static_cast<int32_t>(_width));
+        bottom = std::min(bottom, static_cast<int32_t>(_height));
+
+        if (left >= right)
+            return;
+        if (top >= bottom)
+            return;
+
+        right--;
+        bottom--;
+
+        left >>= _dirtyGrid.BlockShiftX;
+        right >>= _dirtyGrid.BlockShiftX;
+        top >>= _dirtyGrid.BlockShiftY;
+        bottom >>= _dirtyGrid.BlockShiftY;
+
+        for (int32_t y = top; y <= bottom; y++)
+        {
+            std::fill_n(_dirtyGrid.Blocks + (y * _dirtyGrid.BlockColumns) + left, right - left + 1, 0xFF);
+        }
     }
 
     void BeginDraw() override
     {
         assert(_screenFramebuffer != nullptr);
 
+        for (const auto& region : _weatherDrawer.GetDrawnRegions())
+        {
+            Invalidate(region.GetLeft(), region.GetTop(), region.GetRight(), region.GetBottom());
+        }
+        _weatherDrawer.ClearDrawnRegions();
+
+        PrewarmTextureCache();
         _drawingContext->StartNewDraw();
     }
 
     void EndDraw() override
     {
         _drawingContext->FlushCommandBuffers();
+        _drawingContext->UpdateFrameStatistics();
 
         glDisable(GL_DEPTH_TEST);
         if (_scaleFramebuffer != nullptr)
@@ -333,8 +400,13 @@ public:
 
     void PaintWindows() override
     {
+        window_reset_visibilities();
+
+        // Redraw dirty regions before updating the viewports, otherwise
+        // when viewports get panned, they copy dirty pixels
+        DrawAllDirtyBlocks();
         window_update_all_viewports();
-        window_draw_all(&_bitsDPI, 0, 0, _width, _height);
+        DrawAllDirtyBlocks();
     }
 
     void UpdateWindows() override
@@ -359,7 +431,24 @@ public:
 
     void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy) override
     {
-        // Not applicable for this engine
+        if (dx == 0 && dy == 0)
+            return;
+
+        // Adjust for move off screen, see X8DrawingEngine::CopyRect
+        int32_t lmargin = std::min(x - dx, 0);
+        int32_t rmargin = std::min(static_cast<int32_t>(_width) - (x - dx + width), 0);
+        int32_t tmargin = std::min(y - dy, 0);
+        int32_t bmargin = std::min(static_cast<int32_t>(_height) - (y - dy + height), 0);
+        x -= lmargin;
+        y -= tmargin;
+        width += lmargin + rmargin;
+        height += tmargin + bmargin;
+        if (width <= 0 || height <= 0)
+            return;
+
+        // Anything queued so far has to be on the canvas before its pixels are moved
+        _drawingContext->FlushCommandBuffers();
+        _drawingContext->CopyRect(x, y, width, height, dx, dy);
     }
 
     IDrawingContext* GetDrawingContext(rct_drawpixelinfo* dpi) override
@@ -375,7 +464,12 @@ public:
 
     DRAWING_ENGINE_FLAGS GetFlags() override
     {
-        return DEF_NONE;
+        return DEF_DIRTY_OPTIMISATIONS;
+    }
+
+    DrawingEngineStatistics GetLastFrameStatistics() override
+    {
+        return _drawingContext->GetLastFrameStatistics();
     }
 
     void InvalidateImage(uint32_t image) override
@@ -389,6 +483,22 @@ public:
     }
 
 private:
+    void PrewarmTextureCache()
+    {
+        auto textureCache = _drawingContext->GetTextureCache();
+        if (gConfigGeneral.prewarm_texture_atlases)
+        {
+            // Prewarm again whenever objects have been loaded or unloaded
+            auto imageRanges = ImageListGetAllocatedRanges();
+            if (imageRanges != _prewarmedImageRanges)
+            {
+                textureCache->PrewarmImages(imageRanges);
+                _prewarmedImageRanges = std::move(imageRanges);
+            }
+        }
+        textureCache->UploadPrewarmedImages();
+    }
+
     static OpenGLVersion GetOpenGLVersion()
     {
         CheckGLError(); // Clear Any Errors
@@ -479,6 +589,90 @@ private:
         }
     }
 
+    void ConfigureDirtyGrid()
+    {
+        _dirtyGrid.BlockShiftX = 7;
+        _dirtyGrid.BlockShiftY = 6;
+        _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
+        _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
+        _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
+        _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
+
+        // The canvas is re-created, so everything has to be drawn again
+        size_t numBlocks = _dirtyGrid.BlockColumns * _dirtyGrid.BlockRows;
+        delete[] _dirtyGrid.Blocks;
+        _dirtyGrid.Blocks = new uint8_t[numBlocks];
+        std::fill_n(_dirtyGrid.Blocks, numBlocks, 0xFF);
+    }
+
+    void DrawAllDirtyBlocks()
+    {
+        for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+        {
+            for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
+            {
+                uint32_t yOffset = y * _dirtyGrid.BlockColumns;
+                if (_dirtyGrid.Blocks[yOffset + x] == 0)
+                {
+                    continue;
+                }
+
+                // Determine columns
+                uint32_t xx;
+                for (xx = x; xx < _dirtyGrid.BlockColumns; xx++)
+                {
+                    if (_dirtyGrid.Blocks[yOffset + xx] == 0)
+                    {
+                        break;
+                    }
+                }
+
+                // Check rows
+                uint32_t columns = xx - x;
+                auto rows = GetNumDirtyRows(x, y, columns);
+                DrawDirtyBlocks(x, y, columns, rows);
+            }
+        }
+    }
+
+    uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
+    {
+        uint32_t yy;
+        for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
+        {
+            uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
+            for (uint32_t xx = x; xx < x + columns; xx++)
+            {
+                if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
+                {
+                    return yy - y;
+                }
+            }
+        }
+        return yy - y;
+    }
+
+    void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
+    {
+        // Unset dirty blocks
+        for (uint32_t top = y; top < y + rows; top++)
+        {
+            std::fill_n(_dirtyGrid.Blocks + (top * _dirtyGrid.BlockColumns) + x, columns, 0);
+        }
+
+        // Determine region in pixels
+        uint32_t left = x * _dirtyGrid.BlockWidth;
+        uint32_t top = y * _dirtyGrid.BlockHeight;
+        uint32_t right = std::min(_width, left + (columns * _dirtyGrid.BlockWidth));
+        uint32_t bottom = std::min(_height, top + (rows * _dirtyGrid.BlockHeight));
+        if (right <= left || bottom <= top)
+        {
+            return;
+        }
+
+        window_draw_all(&_bitsDPI, left, top, right, bottom);
+    }
+
     void Display()
     {
         SDL_GL_SwapWindow(_window);
@@ -501,7 +695,13 @@ OpenGLDrawingContext::~OpenGLDrawingContext()
     delete _drawLineShader;
     delete _drawRectShader;
     delete _swapFramebuffer;
+    delete _instanceBuffer;
+    if (_transparencyQueries[0] != 0)
+    {
+        glDeleteQueries(static_cast<GLsizei>(MAX_TRANSPARENCY_LAYERS), _transparencyQueries);
+    }
 
+    memory_report_set_provider(MemorySubsystem::TextureCache, nullptr);
     delete _textureCache;
 }
 
@@ -513,9 +713,12 @@ IDrawingEngine* OpenGLDrawingContext::GetEngine()
 void OpenGLDrawingContext::Initialise()
 {
     _textureCache = new TextureCache();
+    memory_report_set_provider(MemorySubsystem::TextureCache, [this]() { return _textureCache->GetMemoryUsage(); });
+    _instanceBuffer = new StreamBuffer(INSTANCE_BUFFER_INITIAL_CAPACITY);
     _applyTransparencyShader = new ApplyTransparencyShader();
     _drawRectShader = new DrawRectShader();
     _drawLineShader = new DrawLineShader();
+    glGenQueries(static_cast<GLsizei>(MAX_TRANSPARENCY_LAYERS), _transparencyQueries);
 }
 
 void OpenGLDrawingContext::Resize(int32_t width, int32_t height)
@@ -544,6 +747,11 @@ void OpenGLDrawingContext::StartNewDraw()
     _swapFramebuffer->Clear();
 }
 
+void OpenGLDrawingContext::CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy)
+{
+    _swapFramebuffer->CopyRect(x, y, width, height, dx, dy);
+}
+
 void OpenGLDrawingContext::Clear(uint8_t paletteIndex)
 {
     FillRect(paletteIndex, _clipLeft - _offsetX, _clipTop - _offsetY, _clipRight - _offsetX, _clipBottom - _offsetY);
@@ -946,13 +1154,22 @@ void OpenGLDrawingContext::FlushCommandBuffers()
     HandleTransparency();
 }
 
+void OpenGLDrawingContext::UpdateFrameStatistics()
+{
+    _lastFrameStatistics.DrawCalls = _drawCalls;
+    _lastFrameStatistics.BytesUploaded = _instanceBuffer->GetBytesUploaded();
+    _drawCalls = 0;
+    _instanceBuffer->ResetBytesUploaded();
+}
+
 void OpenGLDrawingContext::FlushLines()
 {
     if (_commandBuffers.lines.empty())
         return;
 
     _drawLineShader->Use();
-    _drawLineShader->DrawInstances(_commandBuffers.lines);
+    _drawLineShader->DrawInstances(*_instanceBuffer, _commandBuffers.lines);
+    _drawCalls++;
 
     _commandBuffers.lines.clear();
 }
@@ -966,8 +1183,9 @@ void OpenGLDrawingContext::FlushRectangles()
     OpenGLAPI::SetTexture(1, GL_TEXTURE_RECTANGLE, _textureCache->GetPaletteTexture());
 
     _drawRectShader->Use();
-    _drawRectShader->SetInstances(_commandBuffers.rects);
+    _drawRectShader->SetInstances(*_instanceBuffer, _commandBuffers.rects);
     _drawRectShader->DrawInstances();
+    _drawCalls++;
 
     _commandBuffers.rects.clear();
 }
@@ -980,30 +1198,70 @@ void OpenGLDrawingContext::HandleTransparency()
     }
 
     _drawRectShader->Use();
-    _drawRectShader->SetInstances(_commandBuffers.transparent);
+    _drawRectShader->SetInstances(*_instanceBuffer, _commandBuffers.transparent);
+
+    // Only the area covered by the transparent commands needs to be cleared, drawn and mixed for each layer
+    int32_t left = std::numeric_limits<int32_t>::max();
+    int32_t top = std::numeric_limits<int32_t>::max();
+    int32_t right = std::numeric_limits<int32_t>::min();
+    int32_t bottom = std::numeric_limits<int32_t>::min();
+    for (const DrawRectCommand& command : _commandBuffers.transparent)
+    {
+        left = std::min(left, std::clamp(command.bounds.x, command.clip.x, command.clip.z));
+        top = std::min(top, std::clamp(command.bounds.y, command.clip.y, command.clip.w));
+        right = std::max(right, std::clamp(command.bounds.z, command.clip.x, command.clip.z));
+        bottom = std::max(bottom, std::clamp(command.bounds.w, command.clip.y, command.clip.w));
+    }
+    if (left >= right || top >= bottom)
+    {
+        _commandBuffers.transparent.clear();
+        return;
+    }
+
+    // Framebuffers are stored bottom up
+    const auto framebufferHeight = static_cast<int32_t>(_swapFramebuffer->GetFinalFramebuffer().GetHeight());
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(left, framebufferHeight - bottom, right - left, bottom - top);
+
+    OpenGLAPI::SetTexture(0, GL_TEXTURE_2D_ARRAY, _textureCache->GetAtlasesTexture());
+    OpenGLAPI::SetTexture(1, GL_TEXTURE_RECTANGLE, _textureCache->GetPaletteTexture());
 
-    int32_t max_depth = MaxTransparencyDepth(_commandBuffers.transparent);
-    for (int32_t i = 0; i < max_depth; ++i)
+    // Each layer peels the transparent pixels behind the ones of the previous layer. Whether a layer produced any
+    // pixels is left for the GPU to decide through conditional rendering, once one comes out empty every following
+    // layer is skipped without the result having to be read back. A skipped layer leaves the mix framebuffer equal to
+    // the opaque one inside the scissor, so the copy back does no harm should the driver not skip it.
+    const size_t numLayers = std::min(_commandBuffers.transparent.size(), MAX_TRANSPARENCY_LAYERS);
+    for (size_t i = 0; i < numLayers; ++i)
     {
-        _swapFramebuffer->BindTransparent();
+        if (i > 0)
+        {
+            glBeginConditionalRender(_transparencyQueries[i - 1], GL_QUERY_WAIT);
+        }
+
+        _swapFramebuffer->ClearTransparent();
 
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_GREATER);
         _drawRectShader->Use();
-
         if (i > 0)
         {
             _drawRectShader->EnablePeeling(_swapFramebuffer->GetBackDepthTexture());
         }
 
-        OpenGLAPI::SetTexture(0, GL_TEXTURE_2D_ARRAY, _textureCache->GetAtlasesTexture());
-        OpenGLAPI::SetTexture(1, GL_TEXTURE_RECTANGLE, _textureCache->GetPaletteTexture());
-
-        _drawRectShader->Use();
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, _transparencyQueries[i]);
         _drawRectShader->DrawInstances();
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
         _swapFramebuffer->ApplyTransparency(*_applyTransparencyShader, _textureCache->GetPaletteTexture());
+
+        if (i > 0)
+        {
+            glEndConditionalRender();
+        }
+        _drawCalls += 2;
     }
 
+    glDisable(GL_SCISSOR_TEST);
+    _swapFramebuffer->BindOpaque();
     _commandBuffers.transparent.clear();
 }
 
@@ -105,17 +105,6 @@ void OpenGLFramebuffer::GetPixels(rct_drawpixelinfo& dpi) const
     }
 }
 
-void OpenGLFramebuffer::SwapColourBuffer(OpenGLFramebuffer& other)
-{
-    std::swap(_texture, other._texture);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, _id);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture, 0);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, other._id);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, other._texture, 0);
-}
-
 GLuint OpenGLFramebuffer::SwapDepthTexture(GLuint depth)
 {
     std::swap(_depth, depth);
@@ -56,7 +56,6 @@ public:
     void BindRead() const;
     void GetPixels(rct_drawpixelinfo& dpi) const;
 
-    void SwapColourBuffer(OpenGLFramebuffer& other);
     GLuint SwapDepthTexture(GLuint depth);
     void Copy(OpenGLFramebuffer& src, GLenum filter);
 
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_OPENGL
+
+#    include "StreamBuffer.h"
+
+#    include <algorithm>
+#    include <cstring>
+
+// Uploads start on a boundary that keeps the mapped ranges friendly to the driver's copy routines
+constexpr GLintptr STREAM_BUFFER_ALIGNMENT = 64;
+
+StreamBuffer::StreamBuffer(GLsizeiptr capacity)
+    : _capacity(capacity)
+{
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    Orphan();
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    glDeleteBuffers(1, &_buffer);
+}
+
+GLintptr StreamBuffer::Upload(const void* data, GLsizeiptr size)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+
+    if (size > _capacity)
+    {
+        while (_capacity < size)
+        {
+            _capacity <<= 1;
+        }
+        Orphan();
+    }
+    else if (_offset + size > _capacity)
+    {
+        Orphan();
+    }
+
+    GLintptr offset = _offset;
+    void* dst = glMapBufferRange(
+        GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst != nullptr)
+    {
+        std::memcpy(dst, data, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+
+    _offset = (offset + size + STREAM_BUFFER_ALIGNMENT - 1) & ~(STREAM_BUFFER_ALIGNMENT - 1);
+    _bytesUploaded += size;
+    return offset;
+}
+
+void StreamBuffer::Orphan()
+{
+    // Give the buffer fresh storage, the driver keeps the old one alive until the GPU is done with it.
+    glBufferData(GL_ARRAY_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+    _offset = 0;
+}
+
+#endif /* DISABLE_OPENGL */
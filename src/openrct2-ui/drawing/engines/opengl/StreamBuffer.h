@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "OpenGLAPI.h"
+
+#include <openrct2/common.h>
+
+/**
+ * Ring buffer that the per-instance data of the draw commands is streamed through. Uploads are appended to the
+ * buffer with unsynchronised mappings, and the buffer storage is orphaned when it wraps around, so the driver never
+ * has to wait for the GPU to finish with the data of earlier draws.
+ */
+class StreamBuffer final
+{
+private:
+    GLuint _buffer = 0;
+    GLsizeiptr _capacity = 0;
+    GLintptr _offset = 0;
+    size_t _bytesUploaded = 0;
+
+public:
+    explicit StreamBuffer(GLsizeiptr capacity);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    GLuint GetBuffer() const
+    {
+        return _buffer;
+    }
+
+    /**
+     * Copies the data into the buffer, leaving it bound to GL_ARRAY_BUFFER.
+     * @returns the offset of the data in the buffer.
+     */
+    GLintptr Upload(const void* data, GLsizeiptr size);
+
+    size_t GetBytesUploaded() const
+    {
+        return _bytesUploaded;
+    }
+    void ResetBytesUploaded()
+    {
+        _bytesUploaded = 0;
+    }
+
+private:
+    void Orphan();
+};
@@ -27,6 +27,13 @@ SwapFramebuffer::SwapFramebuffer(int32_t width, int32_t height)
     glClearBufferfv(GL_DEPTH, 0, depthValueTransparent);
 }
 
+void SwapFramebuffer::ClearTransparent()
+{
+    _transparentFramebuffer.Bind();
+    glClearBufferuiv(GL_COLOR, 0, indexValue);
+    glClearBufferfv(GL_DEPTH, 0, depthValueTransparent);
+}
+
 void SwapFramebuffer::ApplyTransparency(ApplyTransparencyShader& shader, GLuint paletteTex)
 {
     _mixFramebuffer.Bind();
@@ -37,16 +44,15 @@ void SwapFramebuffer::ApplyTransparency(ApplyTransparencyShader& shader, GLuint
         _transparentFramebuffer.GetDepthTexture(), paletteTex);
     shader.Draw();
 
-    _backDepth = _transparentFramebuffer.SwapDepthTexture(_backDepth);
-
-    // Clear transparency buffers
-    _transparentFramebuffer.Bind();
-    glClearBufferuiv(GL_COLOR, 0, indexValue);
-    glClearBufferfv(GL_DEPTH, 0, depthValueTransparent);
+    // The mixed pixels are copied back instead of swapping the colour buffers, whether this runs at all is decided
+    // by the GPU so the buffers have to stay where they are.
+    GLint width = static_cast<GLint>(_opaqueFramebuffer.GetWidth());
+    GLint height = static_cast<GLint>(_opaqueFramebuffer.GetHeight());
+    _opaqueFramebuffer.BindDraw();
+    _mixFramebuffer.BindRead();
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
-    _opaqueFramebuffer.SwapColourBuffer(_mixFramebuffer);
-    // Change binding to guaruntee no undefined behavior
-    _opaqueFramebuffer.Bind();
+    _backDepth = _transparentFramebuffer.SwapDepthTexture(_backDepth);
 }
 
 void SwapFramebuffer::Clear()
@@ -55,4 +61,26 @@ void SwapFramebuffer::Clear()
     glClearBufferfv(GL_DEPTH, 0, depthValue);
 }
 
+void SwapFramebuffer::CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy)
+{
+    // Framebuffers are stored bottom up. A blit within one framebuffer may not overlap, so the pixels go through the
+    // mix framebuffer, which only holds pixels while a transparent layer is mixed in.
+    int32_t framebufferHeight = static_cast<int32_t>(_opaqueFramebuffer.GetHeight());
+    int32_t srcX = x - dx;
+    int32_t srcY = framebufferHeight - (y - dy) - height;
+    int32_t dstY = framebufferHeight - y - height;
+
+    _mixFramebuffer.BindDraw();
+    _opaqueFramebuffer.BindRead();
+    glBlitFramebuffer(
+        srcX, srcY, srcX + width, srcY + height, srcX, srcY, srcX + width, srcY + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    _opaqueFramebuffer.BindDraw();
+    _mixFramebuffer.BindRead();
+    glBlitFramebuffer(
+        srcX, srcY, srcX + width, srcY + height, x, dstY, x + width, dstY + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    _opaqueFramebuffer.Bind();
+}
+
 #endif /* DISABLE_OPENGL */
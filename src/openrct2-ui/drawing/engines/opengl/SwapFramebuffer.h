@@ -51,6 +51,8 @@ public:
         _transparentFramebuffer.Bind();
     }
 
+    void ClearTransparent();
     void ApplyTransparency(ApplyTransparencyShader& shader, GLuint paletteTex);
     void Clear();
+    void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy);
 };
@@ -12,6 +12,8 @@
 #    include "TextureCache.h"
 
 #    include <algorithm>
+#    include <chrono>
+#    include <iterator>
 #    include <openrct2/drawing/Drawing.h>
 #    include <openrct2/world/Location.hpp>
 #    include <stdexcept>
@@ -19,6 +21,12 @@
 
 constexpr uint32_t UNUSED_INDEX = 0xFFFFFFFF;
 
+// Number of images rasterised by a single prewarm task
+constexpr size_t PREWARM_IMAGES_PER_TASK = 256;
+
+// Time a frame may spend uploading prewarmed images, so prewarming does not cause a visible stutter
+constexpr auto PREWARM_UPLOAD_BUDGET = std::chrono::milliseconds(2);
+
 TextureCache::TextureCache()
 {
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
@@ -26,11 +34,15 @@ TextureCache::TextureCache()
 
 TextureCache::~TextureCache()
 {
+    CancelPrewarm();
     FreeTextures();
 }
 
 void TextureCache::InvalidateImage(uint32_t image)
 {
+    // The prewarm tasks read the image data that is about to change
+    CancelPrewarm();
+
     unique_lock lock(_mutex);
 
     uint32_t index = _indexMap[image];
@@ -133,6 +145,108 @@ BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image, const Palet
     return (*it.first).second;
 }
 
+void TextureCache::PrewarmImages(const std::vector<std::pair<uint32_t, uint32_t>>& imageRanges)
+{
+    CancelPrewarm();
+
+    std::vector<uint32_t> images;
+    std::array<int32_t, 32> slotsNeeded{};
+    {
+        shared_lock lock(_mutex);
+        for (const auto& [baseImageId, count] : imageRanges)
+        {
+            for (uint32_t image = baseImageId; image < baseImageId + count; image++)
+            {
+                if (_indexMap[image] != UNUSED_INDEX)
+                    continue;
+
+                // Deferred images are decoded by the prewarm tasks, only their size is needed here
+                auto g1Element = gfx_peek_g1_element(image);
+                if (g1Element == nullptr || g1Element->width <= 0 || g1Element->height <= 0)
+                    continue;
+
+                images.push_back(image);
+                slotsNeeded[Atlas::CalculateImageSizeOrder(g1Element->width, g1Element->height)]++;
+            }
+        }
+    }
+
+    if (images.empty())
+        return;
+
+    ReserveAtlases(slotsNeeded);
+
+    auto& scheduler = TaskScheduler::GetGlobal();
+    for (size_t start = 0; start < images.size(); start += PREWARM_IMAGES_PER_TASK)
+    {
+        auto end = std::min(start + PREWARM_IMAGES_PER_TASK, images.size());
+        std::vector<uint32_t> taskImages(images.begin() + start, images.begin() + end);
+        scheduler.Schedule(_prewarmTasks, [this, taskImages = std::move(taskImages)]() {
+            std::vector<PrewarmedImage> prewarmed;
+            prewarmed.reserve(taskImages.size());
+            for (auto image : taskImages)
+            {
+                if (_prewarmCancelled)
+                    return;
+
+                rct_drawpixelinfo dpi = GetImageAsDPI(image, 0);
+                prewarmed.push_back({ image, dpi.width, dpi.height, std::unique_ptr<uint8_t[]>(dpi.bits) });
+            }
+
+            std::lock_guard<std::mutex> lock(_prewarmMutex);
+            std::move(prewarmed.begin(), prewarmed.end(), std::back_inserter(_prewarmedImages));
+        });
+    }
+}
+
+void TextureCache::UploadPrewarmedImages()
+{
+    std::vector<PrewarmedImage> images;
+    {
+        std::lock_guard<std::mutex> lock(_prewarmMutex);
+        images.swap(_prewarmedImages);
+    }
+    if (images.empty())
+        return;
+
+    auto deadline = std::chrono::steady_clock::now() + PREWARM_UPLOAD_BUDGET;
+    auto it = images.begin();
+    {
+        unique_lock lock(_mutex);
+        for (; it != images.end() && std::chrono::steady_clock::now() < deadline; it++)
+        {
+            // The image may have been drawn, and therefore loaded, since it was rasterised
+            if (_indexMap[it->Image] != UNUSED_INDEX)
+                continue;
+
+            auto index = static_cast<uint32_t>(_textureCache.size());
+            _textureCache.push_back(UploadImageTexture(it->Image, it->Width, it->Height, it->Pixels.get()));
+            _indexMap[it->Image] = index;
+        }
+    }
+
+    // Keep what did not fit in this frame for the next one
+    if (it != images.end())
+    {
+        std::lock_guard<std::mutex> lock(_prewarmMutex);
+        _prewarmedImages.insert(
+            _prewarmedImages.end(), std::make_move_iterator(it), std::make_move_iterator(images.end()));
+    }
+}
+
+void TextureCache::CancelPrewarm()
+{
+    if (!_prewarmTasks.IsComplete())
+    {
+        _prewarmCancelled = true;
+        TaskScheduler::GetGlobal().Wait(_prewarmTasks);
+        _prewarmCancelled = false;
+    }
+
+    std::lock_guard<std::mutex> lock(_prewarmMutex);
+    _prewarmedImages.clear();
+}
+
 void TextureCache::CreateTextures()
 {
     if (!_initialized)
@@ -201,68 +315,105 @@ void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
     CreateTextures();
 
     GLuint newIndices = _atlasesTextureIndices + newEntries;
+    ReserveAtlasesTexture(newIndices);
+    _atlasesTextureIndices = newIndices;
+}
 
+void TextureCache::ReserveAtlasesTexture(GLuint capacity)
+{
+    if (capacity <= _atlasesTextureCapacity)
+        return;
+
+    // Retrieve current array data, growing buffer.
     std::vector<char> oldPixels;
+    oldPixels.resize(_atlasesTextureDimensions * _atlasesTextureDimensions * _atlasesTextureCapacity);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+    if (!oldPixels.empty())
+    {
+        glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+    }
 
-    if (newIndices > _atlasesTextureCapacity)
+    // Initial capacity will be 12 which covers most cases of a fully visible park.
+    GLuint newCapacity = _atlasesTextureCapacity;
+    while (newCapacity < capacity)
     {
-        // Retrieve current array data, growing buffer.
-        oldPixels.resize(_atlasesTextureDimensions * _atlasesTextureDimensions * _atlasesTextureCapacity);
-        if (!oldPixels.empty())
-        {
-            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
-        }
+        newCapacity = (newCapacity + 6) << 1UL;
+    }
+    newCapacity = std::max(capacity, std::min(newCapacity, static_cast<GLuint>(_atlasesTextureIndicesLimit)));
+    _atlasesTextureCapacity = newCapacity;
 
-        // Initial capacity will be 12 which covers most cases of a fully visible park.
-        _atlasesTextureCapacity = (_atlasesTextureCapacity + 6) << 1UL;
+    glTexImage3D(
+        GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
+        GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
 
-        glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-        glTexImage3D(
-            GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
-            GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+    // Restore old data
+    if (!oldPixels.empty())
+    {
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureIndices,
+            GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+    }
+}
+
+// Grows the texture array once for all the atlases the given number of slots of each size order still need, rather
+// than copying it back and forth every time AllocateImage runs out of atlases.
+void TextureCache::ReserveAtlases(const std::array<int32_t, 32>& slotsNeeded)
+{
+    unique_lock lock(_mutex);
+    CreateTextures();
 
-        // Restore old data
-        if (!oldPixels.empty())
+    GLuint newAtlases = 0;
+    for (size_t order = 0; order < slotsNeeded.size(); order++)
+    {
+        if (slotsNeeded[order] == 0)
+            continue;
+
+        int32_t imageSize = 1 << order;
+        int32_t missingSlots = slotsNeeded[order];
+        for (const auto& atlas : _atlases)
+        {
+            if (atlas.IsImageSuitable(imageSize, imageSize))
+            {
+                missingSlots -= atlas.GetFreeSlots();
+            }
+        }
+        if (missingSlots > 0)
         {
-            glTexSubImage3D(
-                GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureIndices,
-                GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+            int32_t slotsPerRow = std::max(1, _atlasesTextureDimensions / imageSize);
+            int32_t slotsPerAtlas = slotsPerRow * slotsPerRow;
+            newAtlases += (missingSlots + slotsPerAtlas - 1) / slotsPerAtlas;
         }
     }
 
-    _atlasesTextureIndices = newIndices;
+    auto capacity = std::min<GLuint>(_atlasesTextureIndices + newAtlases, _atlasesTextureIndicesLimit);
+    ReserveAtlasesTexture(capacity);
 }
 
 AtlasTextureInfo TextureCache::LoadImageTexture(uint32_t image)
 {
     rct_drawpixelinfo dpi = GetImageAsDPI(image, 0);
-
-    auto cacheInfo = AllocateImage(dpi.width, dpi.height);
-    cacheInfo.image = image;
-
-    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-    glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
-
+    auto cacheInfo = UploadImageTexture(image, dpi.width, dpi.height, dpi.bits);
     DeleteDPI(dpi);
-
     return cacheInfo;
 }
 
 AtlasTextureInfo TextureCache::LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap)
 {
     rct_drawpixelinfo dpi = GetGlyphAsDPI(image, paletteMap);
+    auto cacheInfo = UploadImageTexture(image, dpi.width, dpi.height, dpi.bits);
+    DeleteDPI(dpi);
+    return cacheInfo;
+}
 
-    auto cacheInfo = AllocateImage(dpi.width, dpi.height);
+AtlasTextureInfo TextureCache::UploadImageTexture(uint32_t image, int32_t width, int32_t height, const uint8_t* pixels)
+{
+    auto cacheInfo = AllocateImage(width, height);
     cacheInfo.image = image;
 
     glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
     glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
-
-    DeleteDPI(dpi);
+        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, width, height, 1, GL_RED_INTEGER,
+        GL_UNSIGNED_BYTE, pixels);
 
     return cacheInfo;
 }
@@ -367,6 +518,16 @@ GLuint TextureCache::GetPaletteTexture()
     return _paletteTexture;
 }
 
+size_t TextureCache::GetMemoryUsage() const
+{
+    if (!_initialized)
+        return 0;
+
+    // Both textures use a single byte per pixel
+    size_t atlasSize = static_cast<size_t>(_atlasesTextureDimensions) * _atlasesTextureDimensions;
+    return atlasSize * _atlasesTextureCapacity + 256 * (PALETTE_TO_G1_OFFSET_COUNT + 5);
+}
+
 GLint TextureCache::PaletteToY(uint32_t palette)
 {
     return palette > PALETTE_WATER ? palette + 5 : palette + 1;
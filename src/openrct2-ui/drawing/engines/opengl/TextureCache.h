@@ -15,12 +15,16 @@
 #include <SDL_pixels.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <openrct2/common.h>
+#include <openrct2/core/TaskScheduler.h>
 #ifndef __MACOSX__
 #    include <shared_mutex>
 #endif
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 struct rct_drawpixelinfo;
@@ -204,6 +208,20 @@ private:
 
     GLuint _paletteTexture = 0;
 
+    // An image rasterised in the background by PrewarmImages, waiting to be uploaded on the GL thread
+    struct PrewarmedImage
+    {
+        uint32_t Image;
+        int32_t Width;
+        int32_t Height;
+        std::unique_ptr<uint8_t[]> Pixels;
+    };
+
+    TaskGroup _prewarmTasks;
+    std::atomic<bool> _prewarmCancelled{ false };
+    std::mutex _prewarmMutex;
+    std::vector<PrewarmedImage> _prewarmedImages;
+
 #ifndef __MACOSX__
     std::shared_mutex _mutex;
     using shared_lock = std::shared_lock<std::shared_mutex>;
@@ -221,15 +239,29 @@ public:
     BasicTextureInfo GetOrLoadImageTexture(uint32_t image);
     BasicTextureInfo GetOrLoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
 
+    /**
+     * Rasterises every image of the given ranges that is not cached yet on the task scheduler, reserving the atlas
+     * space for them up front. The images are moved to the atlases by UploadPrewarmedImages.
+     */
+    void PrewarmImages(const std::vector<std::pair<uint32_t, uint32_t>>& imageRanges);
+    void UploadPrewarmedImages();
+    void CancelPrewarm();
+
     GLuint GetAtlasesTexture();
     GLuint GetPaletteTexture();
     static GLint PaletteToY(uint32_t palette);
 
+    // The size of the atlases and palette texture on the GPU
+    size_t GetMemoryUsage() const;
+
 private:
     void CreateTextures();
     void GeneratePaletteTexture();
     void EnlargeAtlasesTexture(GLuint newEntries);
+    void ReserveAtlasesTexture(GLuint capacity);
+    void ReserveAtlases(const std::array<int32_t, 32>& slotsNeeded);
     AtlasTextureInfo LoadImageTexture(uint32_t image);
+    AtlasTextureInfo UploadImageTexture(uint32_t image, int32_t width, int32_t height, const uint8_t* pixels);
     AtlasTextureInfo LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
     AtlasTextureInfo AllocateImage(int32_t imageWidth, int32_t imageHeight);
     static rct_drawpixelinfo GetImageAsDPI(uint32_t image, uint32_t tertiaryColour);
@@ -134,6 +134,7 @@ rct_window* window_create(
     // Setup window
     w->classification = cls;
     w->flags = flags;
+    window_index_add(w);
 
     // Play sounds and flash the window
     if (!(flags & (WF_STICK_TO_BACK | WF_STICK_TO_FRONT)))
@@ -18,15 +18,20 @@
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/StartupTrace.h>
 #include <openrct2/common.h>
 #include <openrct2/core/Console.hpp>
+#include <openrct2/core/FileStream.hpp>
 #include <openrct2/core/Guard.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/core/TaskScheduler.h>
 #include <openrct2/interface/Viewport.h>
 #include <openrct2/interface/Window.h>
 #include <openrct2/management/NewsItem.h>
 #include <openrct2/object/ObjectManager.h>
+#include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/scenario/Scenario.h>
 #include <openrct2/scenario/ScenarioRepository.h>
 #include <openrct2/scenario/ScenarioSources.h>
 #include <openrct2/title/TitleScreen.h>
@@ -39,6 +44,7 @@
 #include <openrct2/world/Map.h>
 #include <openrct2/world/Scenery.h>
 #include <openrct2/world/Sprite.h>
+#include <optional>
 
 using namespace OpenRCT2;
 
@@ -55,6 +61,23 @@ private:
     int32_t _lastScreenHeight = 0;
     CoordsXY _viewCentreLocation = {};
 
+    /**
+     * The next park of the sequence, read and parsed on a worker thread while the current one plays.
+     */
+    struct PreloadedPark
+    {
+        int32_t Position = 0;
+        // Set for LOAD commands
+        std::unique_ptr<TitleSequenceParkHandle> Handle;
+        // Set for LOADSC commands
+        std::string Path;
+        // Only set when the park has been parsed, the importer is then ready to import it
+        std::unique_ptr<IParkImporter> Importer;
+        std::optional<ParkLoadResult> Result;
+    };
+    std::unique_ptr<PreloadedPark> _preloadedPark;
+    TaskGroup _preloadTask;
+
 public:
     explicit TitleSequencePlayer(GameState& gameState)
         : _gameState(gameState)
@@ -71,8 +94,14 @@ public:
         return _position;
     }
 
+    bool IsLoadingPark() const override
+    {
+        return _preloadedPark != nullptr && !_preloadTask.IsComplete();
+    }
+
     void Eject() override
     {
+        DiscardPreloadedPark();
         _sequence = nullptr;
     }
 
@@ -95,6 +124,7 @@ public:
         _sequence = std::move(sequence);
 
         Reset();
+        PreloadPark(0);
         return true;
     }
 
@@ -276,11 +306,29 @@ private:
             {
                 bool loadSuccess = false;
                 uint8_t saveIndex = command.SaveIndex;
-                auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
-                if (parkHandle != nullptr)
+                auto preloadedPark = TakePreloadedPark(_position);
+                if (preloadedPark != nullptr && preloadedPark->Importer != nullptr && !gPreviewingTitleSequenceInGame)
+                {
+                    loadSuccess = LoadPreloadedPark(*preloadedPark, preloadedPark->Handle->HintPath);
+                }
+                else
                 {
-                    loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    std::unique_ptr<TitleSequenceParkHandle> parkHandle;
+                    if (preloadedPark != nullptr && preloadedPark->Handle != nullptr)
+                    {
+                        parkHandle = std::move(preloadedPark->Handle);
+                        parkHandle->Stream->SetPosition(0);
+                    }
+                    else
+                    {
+                        parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
+                    }
+                    if (parkHandle != nullptr)
+                    {
+                        loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    }
                 }
+                PreloadPark(_position + 1);
                 if (!loadSuccess)
                 {
                     if (_sequence->Saves.size() > saveIndex)
@@ -295,11 +343,20 @@ private:
             case TITLE_SCRIPT_LOADSC:
             {
                 bool loadSuccess = false;
-                auto scenario = GetScenarioRepository()->GetByInternalName(command.Scenario);
-                if (scenario != nullptr)
+                auto preloadedPark = TakePreloadedPark(_position);
+                if (preloadedPark != nullptr && preloadedPark->Importer != nullptr && !gPreviewingTitleSequenceInGame)
+                {
+                    loadSuccess = LoadPreloadedPark(*preloadedPark, preloadedPark->Path);
+                }
+                else
                 {
-                    loadSuccess = LoadParkFromFile(scenario->path);
+                    auto scenario = GetScenarioRepository()->GetByInternalName(command.Scenario);
+                    if (scenario != nullptr)
+                    {
+                        loadSuccess = LoadParkFromFile(scenario->path);
+                    }
                 }
+                PreloadPark(_position + 1);
                 if (!loadSuccess)
                 {
                     Console::Error::WriteLine("Failed to load: \"%s\" for the title sequence.", command.Scenario);
@@ -422,6 +479,152 @@ private:
         return success;
     }
 
+    /**
+     * Starts reading the first park the sequence loads from the given position onwards in the background, unless it is
+     * already being read.
+     */
+    void PreloadPark(int32_t fromPosition)
+    {
+        auto numCommands = static_cast<int32_t>(_sequence->Commands.size());
+        for (int32_t i = 0; i < numCommands; i++)
+        {
+            auto position = (fromPosition + i) % numCommands;
+            const auto& command = _sequence->Commands[position];
+            if (!TitleSequenceIsLoadCommand(command))
+            {
+                continue;
+            }
+            if (_preloadedPark != nullptr && _preloadedPark->Position == position)
+            {
+                return;
+            }
+            DiscardPreloadedPark();
+
+            auto park = std::make_unique<PreloadedPark>();
+            park->Position = position;
+            if (command.Type == TITLE_SCRIPT_LOADSC)
+            {
+                // Scenarios previewed in game are loaded by path, there is nothing to read before
+                auto scenario = GetScenarioRepository()->GetByInternalName(command.Scenario);
+                if (scenario == nullptr || gPreviewingTitleSequenceInGame)
+                {
+                    return;
+                }
+                park->Path = scenario->path;
+            }
+
+            // Parks previewed in game are loaded by the context, so they can only be read into memory before
+            auto parse = !gPreviewingTitleSequenceInGame;
+            auto saveIndex = command.SaveIndex;
+            _preloadedPark = std::move(park);
+            TaskScheduler::GetGlobal().Schedule(
+                _preloadTask, [sequence = _sequence.get(), park = _preloadedPark.get(), saveIndex, parse]() {
+                    ReadPreloadedPark(*sequence, *park, saveIndex, parse);
+                });
+            return;
+        }
+    }
+
+    static void ReadPreloadedPark(const TitleSequence& sequence, PreloadedPark& park, uint8_t saveIndex, bool parse)
+    {
+        StartupTraceSpan span("TitleSequencePlayer::ReadPreloadedPark");
+        try
+        {
+            if (park.Path.empty())
+            {
+                park.Handle = TitleSequenceGetParkHandle(sequence, saveIndex);
+                if (park.Handle == nullptr || !parse || HasPackedObjects(*park.Handle->Stream, park.Handle->HintPath))
+                {
+                    return;
+                }
+
+                const auto& hintPath = park.Handle->HintPath;
+                park.Importer = ParkImporter::Create(hintPath);
+                park.Result = park.Importer->LoadFromStream(
+                    park.Handle->Stream.get(), ParkImporter::ExtensionIsScenario(hintPath));
+            }
+            else
+            {
+                auto fileStream = FileStream(park.Path, FILE_MODE_OPEN);
+                if (!parse || HasPackedObjects(fileStream, park.Path))
+                {
+                    return;
+                }
+
+                park.Importer = ParkImporter::Create(park.Path);
+                park.Result = park.Importer->Load(park.Path.c_str());
+            }
+        }
+        catch (const std::exception&)
+        {
+            // The park is read again when it is loaded, which reports the error
+            park.Importer = nullptr;
+            park.Result = std::nullopt;
+        }
+    }
+
+    /**
+     * Packed objects are added to the object repository while a park is parsed, which must not happen on a worker thread.
+     */
+    static bool HasPackedObjects(OpenRCT2::IStream& stream, const std::string& path)
+    {
+        if (ParkImporter::ExtensionIsRCT1(Path::GetExtension(path)))
+        {
+            return false;
+        }
+        auto position = stream.GetPosition();
+        auto header = SawyerChunkReader(&stream).ReadChunkAs<rct_s6_header>();
+        stream.SetPosition(position);
+        return header.num_packed_objects != 0;
+    }
+
+    /**
+     * Returns the preloaded park if it is the one of the given position, waiting for it to be read if it is not yet.
+     */
+    std::unique_ptr<PreloadedPark> TakePreloadedPark(int32_t position)
+    {
+        if (_preloadedPark == nullptr)
+        {
+            return nullptr;
+        }
+        TaskScheduler::GetGlobal().Wait(_preloadTask);
+        if (_preloadedPark->Position != position)
+        {
+            _preloadedPark = nullptr;
+            return nullptr;
+        }
+        return std::move(_preloadedPark);
+    }
+
+    void DiscardPreloadedPark()
+    {
+        if (_preloadedPark != nullptr)
+        {
+            TaskScheduler::GetGlobal().Wait(_preloadTask);
+            _preloadedPark = nullptr;
+        }
+    }
+
+    bool LoadPreloadedPark(PreloadedPark& park, const std::string& path)
+    {
+        log_verbose("TitleSequencePlayer::LoadPreloadedPark(%s)", path.c_str());
+        bool success = false;
+        try
+        {
+            auto& objectManager = GetContext()->GetObjectManager();
+            objectManager.LoadObjects(park.Result->RequiredObjects.data(), park.Result->RequiredObjects.size());
+
+            park.Importer->Import();
+            PrepareParkForPlayback();
+            success = true;
+        }
+        catch (const std::exception&)
+        {
+            Console::Error::WriteLine("Unable to load park: %s", path.c_str());
+        }
+        return success;
+    }
+
     void CloseParkSpecificWindows()
     {
         window_close_by_class(WC_CONSTRUCT_RIDE);
@@ -68,6 +68,24 @@ static uint16_t _filter_object_counts[OBJECT_TYPE_COUNT];
 
 static char _filter_string[MAX_PATH];
 
+/**
+ * The lowercase text of a repository item the filter string is searched in, prepared once so typing in the filter box
+ * does not have to convert every object again.
+ */
+struct object_search_item
+{
+    std::string Name;
+    std::string RideType;
+    std::string Path;
+    std::vector<std::string> Authors;
+    uint32_t SourceFilterFlags;
+};
+
+static std::vector<object_search_item> _searchIndex;
+// Whether each repository item matches _filterStringMatched, the lowercase filter string they were last checked against
+static std::vector<bool> _filterStringMatches;
+static std::string _filterStringMatched;
+
 #define _FILTER_ALL ((_filter_flags & FILTER_ALL) == FILTER_ALL)
 #define _FILTER_RCT1 (_filter_flags & FILTER_RCT1)
 #define _FILTER_AA (_filter_flags & FILTER_AA)
@@ -220,6 +238,8 @@ static bool filter_string(const ObjectRepositoryItem* item);
 static bool filter_source(const ObjectRepositoryItem* item);
 static bool filter_chunks(const ObjectRepositoryItem* item);
 static void filter_update_counts();
+static void filter_string_update_matches();
+static void search_index_dispose();
 
 static std::string object_get_description(const Object* object);
 static int32_t get_selected_object_type(rct_window* w);
@@ -289,6 +309,7 @@ static void visible_list_refresh(rct_window* w)
 
     visible_list_dispose();
     w->selected_list_item = -1;
+    filter_string_update_matches();
 
     const ObjectRepositoryItem* items = object_repository_get_items();
     for (int32_t i = 0; i < numObjects; i++)
@@ -434,6 +455,7 @@ static void window_editor_object_selection_close(rct_window* w)
     context_broadcast_intent(&intent);
 
     visible_list_dispose();
+    search_index_dispose();
 
     intent = Intent(INTENT_ACTION_REFRESH_SCENERY);
     context_broadcast_intent(&intent);
@@ -1392,66 +1414,129 @@ static bool filter_selected(uint8_t objectFlag)
     }
 }
 
-static bool filter_string(const ObjectRepositoryItem* item)
+static std::string search_index_to_lower(std::string_view text)
 {
-    // Nothing to search for
-    if (_filter_string[0] == '\0')
-        return true;
+    std::string result(text);
+    for (auto& c : result)
+        c = static_cast<char>(tolower(c));
+    return result;
+}
 
+static uint32_t search_index_get_source_filter_flag(ObjectSourceGame source)
+{
+    switch (source)
+    {
+        case ObjectSourceGame::RCT1:
+            return FILTER_RCT1;
+        case ObjectSourceGame::AddedAttractions:
+            return FILTER_AA;
+        case ObjectSourceGame::LoopyLandscapes:
+            return FILTER_LL;
+        case ObjectSourceGame::RCT2:
+            return FILTER_RCT2;
+        case ObjectSourceGame::WackyWorlds:
+            return FILTER_WW;
+        case ObjectSourceGame::TimeTwister:
+            return FILTER_TT;
+        case ObjectSourceGame::OpenRCT2Official:
+            return FILTER_OO;
+        default:
+            return FILTER_CUSTOM;
+    }
+}
+
+static void search_index_build()
+{
+    size_t numObjects = object_repository_get_items_count();
+    const ObjectRepositoryItem* items = object_repository_get_items();
+    _searchIndex.clear();
+    _searchIndex.reserve(numObjects);
+    for (size_t i = 0; i < numObjects; i++)
+    {
+        const ObjectRepositoryItem* item = &items[i];
+        object_search_item searchItem;
+        searchItem.Name = search_index_to_lower(item->Name);
+        if (item->ObjectEntry.GetType() == OBJECT_TYPE_RIDE)
+        {
+            searchItem.RideType = search_index_to_lower(language_get_string(get_ride_type_string_id(item)));
+        }
+        searchItem.Path = search_index_to_lower(item->Path);
+        for (const auto& author : item->Authors)
+        {
+            searchItem.Authors.push_back(search_index_to_lower(author));
+        }
+        searchItem.SourceFilterFlags = 0;
+        for (auto source : item->Sources)
+        {
+            searchItem.SourceFilterFlags |= search_index_get_source_filter_flag(source);
+        }
+        _searchIndex.push_back(std::move(searchItem));
+    }
+
+    // Every item matches the empty filter
+    _filterStringMatches.assign(numObjects, true);
+    _filterStringMatched.clear();
+}
+
+static void search_index_dispose()
+{
+    _searchIndex.clear();
+    _searchIndex.shrink_to_fit();
+    _filterStringMatches.clear();
+    _filterStringMatches.shrink_to_fit();
+    _filterStringMatched.clear();
+}
+
+static bool search_index_matches(const object_search_item& searchItem, const std::string& filter)
+{
     // Object doesn't have a name
-    if (item->Name.empty())
+    if (searchItem.Name.empty())
         return false;
 
-    // Get ride type
-    const char* rideTypeName = language_get_string(get_ride_type_string_id(item));
-
-    // Get object name (ride/vehicle for rides) and type name (rides only)
-    char name_lower[MAX_PATH];
-    char type_lower[MAX_PATH];
-    char object_path[MAX_PATH];
-    char filter_lower[sizeof(_filter_string)];
-    safe_strcpy(name_lower, item->Name.c_str(), MAX_PATH);
-    safe_strcpy(type_lower, rideTypeName, MAX_PATH);
-    safe_strcpy(object_path, item->Path.c_str(), MAX_PATH);
-    safe_strcpy(filter_lower, _filter_string, sizeof(_filter_string));
-
-    // Make use of lowercase characters only
-    for (int32_t i = 0; name_lower[i] != '\0'; i++)
-        name_lower[i] = static_cast<char>(tolower(name_lower[i]));
-    for (int32_t i = 0; type_lower[i] != '\0'; i++)
-        type_lower[i] = static_cast<char>(tolower(type_lower[i]));
-    for (int32_t i = 0; object_path[i] != '\0'; i++)
-        object_path[i] = static_cast<char>(tolower(object_path[i]));
-    for (int32_t i = 0; filter_lower[i] != '\0'; i++)
-        filter_lower[i] = static_cast<char>(tolower(filter_lower[i]));
-
-    // Check if the searched string exists in the name, ride type, or filename
-    bool inName = strstr(name_lower, filter_lower) != nullptr;
-    bool inRideType = (item->ObjectEntry.GetType() == OBJECT_TYPE_RIDE) && strstr(type_lower, filter_lower) != nullptr;
-    bool inPath = strstr(object_path, filter_lower) != nullptr;
-
-    return inName || inRideType || inPath;
+    // Check if the searched string exists in the name, ride type, filename or authors
+    if (searchItem.Name.find(filter) != std::string::npos || searchItem.RideType.find(filter) != std::string::npos
+        || searchItem.Path.find(filter) != std::string::npos)
+    {
+        return true;
+    }
+    return std::any_of(searchItem.Authors.begin(), searchItem.Authors.end(), [&filter](const std::string& author) {
+        return author.find(filter) != std::string::npos;
+    });
+}
+
+/**
+ * Brings _filterStringMatches up to date with _filter_string. When text is added to the filter, only the items that
+ * matched before can still match, so just those are checked again.
+ */
+static void filter_string_update_matches()
+{
+    if (_searchIndex.size() != object_repository_get_items_count())
+    {
+        search_index_build();
+    }
+
+    auto filter = search_index_to_lower(_filter_string);
+    if (filter == _filterStringMatched)
+        return;
+
+    bool narrowing = filter.find(_filterStringMatched) != std::string::npos;
+    for (size_t i = 0; i < _searchIndex.size(); i++)
+    {
+        if (narrowing && !_filterStringMatches[i])
+            continue;
+
+        _filterStringMatches[i] = filter.empty() || search_index_matches(_searchIndex[i], filter);
+    }
+    _filterStringMatched = std::move(filter);
 }
 
-static bool sources_match(ObjectSourceGame source)
+static bool filter_string(const ObjectRepositoryItem* item)
 {
-    // clang-format off
-    return (_FILTER_RCT1 && source == ObjectSourceGame::RCT1) ||
-           (_FILTER_AA && source == ObjectSourceGame::AddedAttractions) ||
-           (_FILTER_LL && source == ObjectSourceGame::LoopyLandscapes) ||
-           (_FILTER_RCT2 && source == ObjectSourceGame::RCT2) ||
-           (_FILTER_WW && source == ObjectSourceGame::WackyWorlds) ||
-           (_FILTER_TT && source == ObjectSourceGame::TimeTwister) ||
-           (_FILTER_OO && source == ObjectSourceGame::OpenRCT2Official) ||
-           (_FILTER_CUSTOM &&
-            source != ObjectSourceGame::RCT1 &&
-            source != ObjectSourceGame::AddedAttractions &&
-            source != ObjectSourceGame::LoopyLandscapes &&
-            source != ObjectSourceGame::RCT2 &&
-            source != ObjectSourceGame::WackyWorlds &&
-            source != ObjectSourceGame::TimeTwister &&
-            source != ObjectSourceGame::OpenRCT2Official);
-    // clang-format on
+    // Nothing to search for
+    if (_filter_string[0] == '\0')
+        return true;
+
+    return _filterStringMatches[item->Id];
 }
 
 static bool filter_source(const ObjectRepositoryItem* item)
@@ -1459,13 +1544,7 @@ static bool filter_source(const ObjectRepositoryItem* item)
     if (_FILTER_ALL)
         return true;
 
-    for (auto source : item->Sources)
-    {
-        if (sources_match(source))
-            return true;
-    }
-
-    return false;
+    return (_searchIndex[item->Id].SourceFilterFlags & _filter_flags) != 0;
 }
 
 static bool filter_chunks(const ObjectRepositoryItem* item)
@@ -1492,6 +1571,7 @@ static void filter_update_counts()
 {
     if (!_FILTER_ALL || strlen(_filter_string) > 0)
     {
+        filter_string_update_matches();
         const auto& selectionFlags = _objectSelectionFlags;
         std::fill(std::begin(_filter_object_counts), std::end(_filter_object_counts), 0);
 
@@ -732,7 +732,8 @@ static void window_footpath_set_provisional_path_at_point(const ScreenCoordsXY&
         gMapSelectPositionA = info.Loc;
         gMapSelectPositionB = info.Loc;
 
-        footpath_provisional_update();
+        // The previous provisional path is removed when placing the new one, unless it is the same path.
+        footpath_provisional_hide_arrow();
 
         // Set provisional path
         int32_t slope = 0;
@@ -7,7 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
@@ -21,6 +23,7 @@
 #include <openrct2/sprites.h>
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Sprite.h>
+#include <unordered_map>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_GUESTS;
@@ -123,7 +126,7 @@ struct FilterArguments
 {
     uint8_t args[12]{};
 
-    rct_string_id GetFirstStringId()
+    rct_string_id GetFirstStringId() const
     {
         rct_string_id firstStrId{};
         std::memcpy(&firstStrId, args, sizeof(firstStrId));
@@ -139,6 +142,20 @@ static bool operator!=(const FilterArguments& l, const FilterArguments& r)
     return !(l == r);
 }
 
+struct FilterArgumentsHash
+{
+    size_t operator()(const FilterArguments& value) const
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (auto b : value.args)
+        {
+            hash = (hash ^ b) * 16777619u;
+        }
+        return hash;
+    }
+};
+
 static uint32_t _window_guest_list_last_find_groups_tick;
 static uint32_t _window_guest_list_last_find_groups_selected_view;
 static uint32_t _window_guest_list_last_find_groups_wait;
@@ -156,7 +173,6 @@ static FilterArguments _window_guest_list_filter_arguments;
 static uint16_t _window_guest_list_groups_num_guests[240];
 static FilterArguments _window_guest_list_groups_arguments[240];
 static uint8_t _window_guest_list_groups_guest_faces[240 * 58];
-static uint8_t _window_guest_list_group_index[240];
 
 static char _window_guest_list_filter_name[32];
 
@@ -249,7 +265,7 @@ void window_guest_list_refresh_list()
         GuestList.push_back(peep->sprite_index);
     }
 
-    std::sort(GuestList.begin(), GuestList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
+    peep_sort(GuestList);
 }
 
 /**
@@ -745,15 +761,18 @@ static void window_guest_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
     {
         case PAGE_INDIVIDUAL:
         {
-            uint32_t i = 0;
-            y = _window_guest_list_selected_page * -GUEST_PAGE_HEIGHT;
+            auto pageTop = _window_guest_list_selected_page * -GUEST_PAGE_HEIGHT;
 
-            // For each guest
-            for (auto spriteIndex : GuestList)
+            // Skip straight to the first guest that can be visible, only the visible rows are formatted
+            auto firstRow = std::max(0, (dpi->y - pageTop) / SCROLLABLE_ROW_HEIGHT - 1);
+            for (uint32_t i = firstRow; i < GuestList.size(); i++)
             {
+                y = pageTop + static_cast<int32_t>(i) * SCROLLABLE_ROW_HEIGHT;
+                if (y >= dpi->y + dpi->height)
+                    break;
+
                 // Check if y is beyond the scroll control
-                if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi->y && y < 0x7FFF
-                    && y < dpi->y + dpi->height)
+                if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi->y && y < 0x7FFF)
                 {
                     // Highlight backcolour and text colour (format)
                     format = STR_BLACK_STRING;
@@ -764,7 +783,7 @@ static void window_guest_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
                     }
 
                     // Guest name
-                    auto peep = GetEntity<Guest>(spriteIndex);
+                    auto peep = GetEntity<Guest>(GuestList[i]);
                     if (peep == nullptr)
                     {
                         continue;
@@ -808,10 +827,6 @@ static void window_guest_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
                             break;
                     }
                 }
-
-                // Increment list item index and y
-                i++;
-                y += SCROLLABLE_ROW_HEIGHT;
             }
             break;
         }
@@ -942,104 +957,58 @@ static void window_guest_list_find_groups()
     _window_guest_list_last_find_groups_wait = 320;
     _window_guest_list_num_groups = 0;
 
-    // Set all guests to unassigned
+    struct GuestGroup
     {
-        for (auto peep : EntityList<Guest>(EntityListId::Peep))
-        {
-            if (!peep->OutsideOfPark)
-            {
-                peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
-            }
-        }
-    }
-    // For each guest / group
+        FilterArguments Arguments;
+        uint32_t NumGuests{};
+        uint8_t Faces[56]{};
+    };
+
+    // Assign each guest to the group with the same arguments in a single pass, groups stay in the order they are found
+    std::vector<GuestGroup> groups;
+    std::unordered_map<FilterArguments, size_t, FilterArgumentsHash> groupIndices;
     for (auto peep : EntityList<Guest>(EntityListId::Peep))
     {
-        if (peep->OutsideOfPark || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
+        if (peep->OutsideOfPark)
             continue;
 
-        // New group, cap at 240 though
-        int32_t groupIndex = _window_guest_list_num_groups;
-        if (groupIndex >= 240)
-            break;
-
-        _window_guest_list_num_groups++;
-        _window_guest_list_groups_num_guests[groupIndex] = 1;
-        peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-        _window_guest_list_groups_arguments[groupIndex] = get_arguments_from_peep(peep);
-        _window_guest_list_filter_arguments = _window_guest_list_groups_arguments[groupIndex];
-
-        _window_guest_list_group_index[groupIndex] = groupIndex;
-        auto faceIndex = groupIndex * 56;
-        _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep)
-            - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-
-        // Find more peeps that belong to same group
-        for (auto peep2 : EntityList<Guest>(EntityListId::Peep))
+        auto arguments = get_arguments_from_peep(peep);
+        auto [it, added] = groupIndices.try_emplace(arguments, groups.size());
+        if (added)
         {
-            if (peep2->OutsideOfPark || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-                continue;
-
-            // Get and check if in same group
-            auto argument12 = get_arguments_from_peep(peep2);
-            if (argument12 != _window_guest_list_groups_arguments[groupIndex])
-                continue;
-
-            // Assign guest
-            _window_guest_list_groups_num_guests[groupIndex]++;
-            peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-            // Add face sprite, cap at 56 though
-            if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
-                continue;
-            _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2)
-                - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+            groups.push_back({ arguments });
         }
 
-        if (_window_guest_list_filter_arguments.GetFirstStringId() == 0)
+        // Add face sprite, cap at 56 though
+        auto& group = groups[it->second];
+        if (group.NumGuests < std::size(group.Faces))
         {
-            _window_guest_list_num_groups--;
-            continue;
-        }
-
-        auto curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-        int32_t swap_position = 0;
-        // This section places the groups in size order.
-        bool gotoNextPeep = false;
-        while (1)
-        {
-            if (swap_position >= groupIndex)
-            {
-                gotoNextPeep = true;
-                break;
-            }
-            if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
-                break;
-            swap_position++;
-        }
-        if (gotoNextPeep)
-        {
-            continue;
+            group.Faces[group.NumGuests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
         }
+        group.NumGuests++;
+    }
 
-        auto arguments12 = _window_guest_list_groups_arguments[groupIndex];
-        auto bl = _window_guest_list_group_index[groupIndex];
+    // Guests without an action or thought are not shown as a group
+    groups.erase(
+        std::remove_if(
+            groups.begin(), groups.end(), [](const GuestGroup& group) { return group.Arguments.GetFirstStringId() == 0; }),
+        groups.end());
+
+    // Place the groups in size order, groups of the same size keep the order they were found in. Cap at 240 though.
+    std::stable_sort(groups.begin(), groups.end(), [](const GuestGroup& a, const GuestGroup& b) {
+        return a.NumGuests > b.NumGuests;
+    });
+    for (const auto& group : groups)
+    {
+        auto groupIndex = _window_guest_list_num_groups;
+        if (groupIndex >= 240)
+            break;
 
-        do
-        {
-            std::swap(curr_num_guests, _window_guest_list_groups_num_guests[swap_position]);
-            std::swap(arguments12, _window_guest_list_groups_arguments[swap_position]);
-
-            uint8_t temp_faces[56];
-            std::memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex * 56]), 56);
-            std::memcpy(
-                &(_window_guest_list_groups_guest_faces[groupIndex * 56]),
-                &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-            std::memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
-
-            std::swap(bl, _window_guest_list_group_index[swap_position]);
-        } while (++swap_position <= groupIndex);
+        _window_guest_list_num_groups++;
+        _window_guest_list_groups_num_guests[groupIndex] = static_cast<uint16_t>(
+            std::min<uint32_t>(group.NumGuests, std::numeric_limits<uint16_t>::max()));
+        _window_guest_list_groups_arguments[groupIndex] = group.Arguments;
+        std::memcpy(&_window_guest_list_groups_guest_faces[groupIndex * 56], group.Faces, sizeof(group.Faces));
     }
 }
 
@@ -28,7 +28,9 @@
 #include <openrct2/platform/platform.h>
 #include <openrct2/rct2/T6Exporter.h>
 #include <openrct2/ride/TrackDesign.h>
+#include <openrct2/scenario/SavedGameRepository.h>
 #include <openrct2/scenario/Scenario.h>
+#include <openrct2/sprites.h>
 #include <openrct2/title/TitleScreen.h>
 #include <openrct2/util/Util.h>
 #include <openrct2/windows/Intent.h>
@@ -41,6 +43,8 @@
 static constexpr const rct_string_id WINDOW_TITLE = STR_NONE;
 static constexpr const int32_t WW = 350;
 static constexpr const int32_t WH = 400;
+// Space next to the file list for the details of saved games, which shows their map preview at double size
+static constexpr const int32_t PREVIEW_PANEL_WIDTH = SAVED_GAME_PREVIEW_SIZE * 2 + 8;
 
 // clang-format off
 enum
@@ -82,6 +86,7 @@ static rct_widget window_loadsave_widgets[] =
 static void window_loadsave_close(rct_window *w);
 static void window_loadsave_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_loadsave_resize(rct_window *w);
+static void window_loadsave_update(rct_window *w);
 static void window_loadsave_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
 static void window_loadsave_scrollmousedown(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
 static void window_loadsave_scrollmouseover(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
@@ -96,6 +101,7 @@ static rct_window_event_list window_loadsave_events([](auto& events)
     events.close = &window_loadsave_close;
     events.mouse_up = &window_loadsave_mouseup;
     events.resize = &window_loadsave_resize;
+    events.update = &window_loadsave_update;
     events.get_scroll_size = &window_loadsave_scrollgetsize;
     events.scroll_mousedown = &window_loadsave_scrollmousedown;
     events.scroll_mouseover = &window_loadsave_scrollmouseover;
@@ -135,6 +141,9 @@ static char _parentDirectory[MAX_PATH];
 static char _extension[256];
 static char _defaultName[MAX_PATH];
 static int32_t _type;
+static bool _showPreviews;
+static bool _previewsRefreshing;
+static std::vector<uint8_t> _previewPixels;
 
 static int32_t maxDateWidth = 0;
 static int32_t maxTimeWidth = 0;
@@ -200,7 +209,7 @@ static const char* getFilterPatternByType(const int32_t type, const bool isSave)
     switch (type & 0x0E)
     {
         case LOADSAVETYPE_GAME:
-            return isSave ? "*.sv6" : "*.sv6;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;";
+            return isSave ? "*.sv6" : "*.sv6;*.sv6d;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;";
 
         case LOADSAVETYPE_LANDSCAPE:
             return isSave ? "*.sc6" : "*.sc6;*.sv6;*.sc4;*.sv4;*.sv7;*.sea;";
@@ -261,10 +270,19 @@ rct_window* window_loadsave_open(int32_t type, const char* defaultName, loadsave
         return nullptr;
     }
 
+    // Saved games are indexed in the background, the details show up once that is done
+    _showPreviews = (type & 0x0E) == LOADSAVETYPE_GAME;
+    if (_showPreviews)
+    {
+        SavedGameRepository::RefreshAsync();
+        _previewsRefreshing = true;
+    }
+
     rct_window* w = window_bring_to_front_by_class(WC_LOADSAVE);
     if (w == nullptr)
     {
-        w = window_create_centred(WW, WH, &window_loadsave_events, WC_LOADSAVE, WF_STICK_TO_FRONT | WF_RESIZABLE);
+        int32_t width = _showPreviews ? WW + PREVIEW_PANEL_WIDTH : WW;
+        w = window_create_centred(width, WH, &window_loadsave_events, WC_LOADSAVE, WF_STICK_TO_FRONT | WF_RESIZABLE);
         w->widgets = window_loadsave_widgets;
         w->enabled_widgets = (1 << WIDX_CLOSE) | (1 << WIDX_UP) | (1 << WIDX_NEW_FOLDER) | (1 << WIDX_NEW_FILE)
             | (1 << WIDX_SORT_NAME) | (1 << WIDX_SORT_DATE) | (1 << WIDX_BROWSE) | (1 << WIDX_DEFAULT);
@@ -317,6 +335,8 @@ rct_window* window_loadsave_open(int32_t type, const char* defaultName, loadsave
 static void window_loadsave_close(rct_window* w)
 {
     _listItems.clear();
+    _previewPixels.clear();
+    _previewPixels.shrink_to_fit();
     window_close_by_class(WC_LOADSAVE_OVERWRITE_PROMPT);
 }
 
@@ -334,6 +354,15 @@ static void window_loadsave_resize(rct_window* w)
     }
 }
 
+static void window_loadsave_update(rct_window* w)
+{
+    if (_previewsRefreshing && !SavedGameRepository::IsRefreshing())
+    {
+        _previewsRefreshing = false;
+        w->Invalidate();
+    }
+}
+
 static bool browse(bool isSave, char* path, size_t pathSize)
 {
     file_dialog_desc desc = {};
@@ -666,20 +695,84 @@ static void window_loadsave_invalidate(rct_window* w)
     window_loadsave_widgets[WIDX_RESIZE].right = w->width - 1;
     window_loadsave_widgets[WIDX_RESIZE].bottom = w->height - 1;
 
+    const int32_t listRight = _showPreviews ? w->width - 4 - PREVIEW_PANEL_WIDTH : w->width - 4;
+
     rct_widget* date_widget = &window_loadsave_widgets[WIDX_SORT_DATE];
-    date_widget->right = w->width - 5;
+    date_widget->right = listRight - 1;
     date_widget->left = date_widget->right - (maxDateWidth + maxTimeWidth + (4 * DATE_TIME_GAP) + (SCROLLBAR_WIDTH + 1));
 
     window_loadsave_widgets[WIDX_SORT_NAME].left = 4;
     window_loadsave_widgets[WIDX_SORT_NAME].right = window_loadsave_widgets[WIDX_SORT_DATE].left - 1;
 
-    window_loadsave_widgets[WIDX_SCROLL].right = w->width - 4;
+    window_loadsave_widgets[WIDX_SCROLL].right = listRight;
     window_loadsave_widgets[WIDX_SCROLL].bottom = w->height - 30;
 
     window_loadsave_widgets[WIDX_BROWSE].top = w->height - 24;
     window_loadsave_widgets[WIDX_BROWSE].bottom = w->height - 6;
 }
 
+static void window_loadsave_draw_preview(rct_window* w, rct_drawpixelinfo* dpi)
+{
+    if (w->selected_list_item < 0 || w->selected_list_item >= static_cast<int32_t>(_listItems.size()))
+        return;
+
+    const auto& listItem = _listItems[w->selected_list_item];
+    if (listItem.type != TYPE_FILE)
+        return;
+
+    auto preview = SavedGameRepository::GetPreview(listItem.path);
+    if (!preview.has_value() || preview->Pixels.empty())
+        return;
+
+    const rct_widget& scrollWidget = window_loadsave_widgets[WIDX_SCROLL];
+    auto screenPos = w->windowPos + ScreenCoordsXY{ scrollWidget.right + 5, scrollWidget.top };
+    const int32_t width = PREVIEW_PANEL_WIDTH - 8;
+
+    // Double the size of the preview so it is easier to make out
+    constexpr int32_t imageSize = SAVED_GAME_PREVIEW_SIZE * 2;
+    _previewPixels.resize(imageSize * imageSize);
+    for (int32_t y = 0; y < imageSize; y++)
+    {
+        for (int32_t x = 0; x < imageSize; x++)
+        {
+            _previewPixels[y * imageSize + x] = preview->Pixels[(y / 2) * SAVED_GAME_PREVIEW_SIZE + (x / 2)];
+        }
+    }
+
+    rct_g1_element g1temp = {};
+    g1temp.offset = _previewPixels.data();
+    g1temp.width = imageSize;
+    g1temp.height = imageSize;
+    g1temp.flags = G1_FLAG_BMP;
+    gfx_set_g1_element(SPR_TEMP, &g1temp);
+    drawing_engine_invalidate_image(SPR_TEMP);
+    gfx_draw_sprite(dpi, SPR_TEMP, screenPos, 0);
+    screenPos.y += imageSize + 4;
+
+    if (!preview->ParkName.empty())
+    {
+        auto ft = Formatter();
+        ft.Add<rct_string_id>(STR_STRING);
+        ft.Add<const char*>(preview->ParkName.c_str());
+        DrawTextEllipsised(dpi, screenPos, width, STR_WINDOW_COLOUR_2_STRINGID, ft, COLOUR_BLACK);
+        screenPos.y += 12;
+    }
+
+    auto ft = Formatter();
+    ft.Add<uint16_t>(preview->ElapsedMonths);
+    DrawTextEllipsised(dpi, screenPos, width, STR_WINDOW_OBJECTIVE_VALUE_DATE, ft, COLOUR_BLACK);
+    screenPos.y += 12;
+
+    ft = Formatter();
+    ft.Add<uint32_t>(preview->NumGuests);
+    DrawTextEllipsised(dpi, screenPos, width, STR_GUESTS_IN_PARK_LABEL, ft, COLOUR_BLACK);
+    screenPos.y += 12;
+
+    ft = Formatter();
+    ft.Add<uint16_t>(preview->ParkRating);
+    DrawTextEllipsised(dpi, screenPos, width, STR_PARK_RATING_LABEL, ft, COLOUR_BLACK);
+}
+
 static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
 {
     window_draw_widgets(w, dpi);
@@ -725,6 +818,11 @@ static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
     rct_widget sort_date_widget = window_loadsave_widgets[WIDX_SORT_DATE];
     gfx_draw_string_left(
         dpi, STR_DATE, &id, COLOUR_GREY, w->windowPos + ScreenCoordsXY{ sort_date_widget.left + 5, sort_date_widget.top + 1 });
+
+    if (_showPreviews)
+    {
+        window_loadsave_draw_preview(w, dpi);
+    }
 }
 
 static void window_loadsave_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_t scrollIndex)
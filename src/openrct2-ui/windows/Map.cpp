@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <openrct2-ui/interface/LandTool.h>
 #include <openrct2-ui/interface/Viewport.h>
@@ -166,7 +167,11 @@ static uint8_t _activeTool;
 static uint32_t _currentLine;
 
 /** rct2: 0x00F1AD68 */
-static std::vector<uint8_t> _mapImageData;
+// The map image of each rotation, only drawn once the map is viewed in that rotation
+static std::array<std::vector<uint8_t>, NumOrthogonalDirections> _mapImageData;
+static std::array<bool, NumOrthogonalDirections> _mapImageValid;
+static int32_t _mapImageTab;
+static std::vector<TileCoordsXY> _mapChangedTiles;
 
 static uint16_t _landRightsToolSize;
 
@@ -187,7 +192,10 @@ static void window_map_place_park_entrance_tool_down(const ScreenCoordsXY& scree
 static void window_map_set_peep_spawn_tool_down(const ScreenCoordsXY& screenCoords);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
-static void map_window_set_pixels(rct_window* w);
+static std::vector<uint8_t>& window_map_get_image(rct_window* w);
+static void window_map_update_image(rct_window* w);
+static void map_window_set_pixels(std::vector<uint8_t>& image, int32_t rotation, int32_t tab, int32_t line);
+static void map_window_set_tile_pixel(std::vector<uint8_t>& image, int32_t rotation, int32_t tab, const TileCoordsXY& tile);
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords);
 
@@ -210,7 +218,7 @@ rct_window* window_map_open()
 
     try
     {
-        _mapImageData.resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE);
+        _mapImageData[get_current_rotation()].resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE);
     }
     catch (const std::bad_alloc&)
     {
@@ -264,8 +272,13 @@ void window_map_reset()
  */
 static void window_map_close(rct_window* w)
 {
-    _mapImageData.clear();
-    _mapImageData.shrink_to_fit();
+    for (auto& image : _mapImageData)
+    {
+        image.clear();
+        image.shrink_to_fit();
+    }
+    _mapChangedTiles.clear();
+    _mapChangedTiles.shrink_to_fit();
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == w->classification
         && gCurrentToolWidget.window_number == w->number)
     {
@@ -423,12 +436,10 @@ static void window_map_update(rct_window* w)
     if (get_current_rotation() != w->map.rotation)
     {
         w->map.rotation = get_current_rotation();
-        window_map_init_map();
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
-        map_window_set_pixels(w);
+    window_map_update_image(w);
 
     w->Invalidate();
 
@@ -860,7 +871,7 @@ static void window_map_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_
     gfx_clear(dpi, PALETTE_INDEX_10);
 
     rct_g1_element g1temp = {};
-    g1temp.offset = _mapImageData.data();
+    g1temp.offset = window_map_get_image(w).data();
     g1temp.width = MAP_WINDOW_MAP_SIZE;
     g1temp.height = MAP_WINDOW_MAP_SIZE;
     g1temp.x_offset = -8;
@@ -886,10 +897,65 @@ static void window_map_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_
  */
 static void window_map_init_map()
 {
-    std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
+    _mapImageValid.fill(false);
     _currentLine = 0;
 }
 
+/**
+ * The map image of the current rotation, drawn in full if it is not up to date.
+ */
+static std::vector<uint8_t>& window_map_get_image(rct_window* w)
+{
+    if (_mapImageTab != w->selected_tab)
+    {
+        _mapImageTab = w->selected_tab;
+        _mapImageValid.fill(false);
+    }
+
+    auto rotation = get_current_rotation();
+    auto& image = _mapImageData[rotation];
+    if (!_mapImageValid[rotation])
+    {
+        image.resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE);
+        std::fill(image.begin(), image.end(), PALETTE_INDEX_10);
+        for (int32_t line = 0; line < MAXIMUM_MAP_SIZE_TECHNICAL; line++)
+        {
+            map_window_set_pixels(image, rotation, _mapImageTab, line);
+        }
+        _mapImageValid[rotation] = true;
+    }
+    return image;
+}
+
+static void window_map_update_image(rct_window* w)
+{
+    // Redraw the tiles invalidated since the last update in every image that is kept
+    if (map_take_changed_tiles(_mapChangedTiles))
+    {
+        for (int32_t rotation = 0; rotation < NumOrthogonalDirections; rotation++)
+        {
+            if (_mapImageValid[rotation] && _mapImageTab == w->selected_tab)
+            {
+                for (const auto& tile : _mapChangedTiles)
+                {
+                    map_window_set_tile_pixel(_mapImageData[rotation], rotation, _mapImageTab, tile);
+                }
+            }
+        }
+    }
+    else
+    {
+        _mapImageValid.fill(false);
+    }
+
+    // Not every change of a tile invalidates it, so keep going over the map one line per update to catch up with those
+    auto& image = window_map_get_image(w);
+    map_window_set_pixels(image, get_current_rotation(), _mapImageTab, _currentLine);
+    _currentLine++;
+    if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        _currentLine = 0;
+}
+
 /**
  *
  *  rct2: 0x0068C990
@@ -1030,16 +1096,53 @@ static MapCoordsXY window_map_transform_to_map_coords(CoordsXY c)
     return { -x + y + MAXIMUM_MAP_SIZE_TECHNICAL - 8, x + y - 8 };
 }
 
+/**
+ * The map area shown in the part of the map image covered by dpi, with a tile to spare on each side. numTiles is set to
+ * the number of tiles in the area.
+ */
+static MapRange window_map_get_visible_range(rct_drawpixelinfo* dpi, int32_t& numTiles)
+{
+    // Inverse of window_map_transform_to_map_coords, in tiles of the rotated map
+    constexpr int32_t lastTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    auto left = dpi->x;
+    auto top = dpi->y;
+    auto right = dpi->x + dpi->width;
+    auto bottom = dpi->y + dpi->height;
+    auto minX = std::clamp((top - right + MAXIMUM_MAP_SIZE_TECHNICAL) / 2 - 1, 0, lastTile);
+    auto maxX = std::clamp((bottom - left + MAXIMUM_MAP_SIZE_TECHNICAL) / 2 + 1, 0, lastTile);
+    auto minY = std::clamp((top + left - MAXIMUM_MAP_SIZE_TECHNICAL + 16) / 2 - 1, 0, lastTile);
+    auto maxY = std::clamp((bottom + right - MAXIMUM_MAP_SIZE_TECHNICAL + 16) / 2 + 1, 0, lastTile);
+    numTiles = (maxX - minX + 1) * (maxY - minY + 1);
+
+    // Undo the rotation, which keeps the range a rectangle
+    auto unrotate = [](int32_t x, int32_t y) {
+        switch (get_current_rotation())
+        {
+            case 1:
+                return TileCoordsXY(lastTile - y, x).ToCoordsXY();
+            case 2:
+                return TileCoordsXY(lastTile - x, lastTile - y).ToCoordsXY();
+            case 3:
+                return TileCoordsXY(y, lastTile - x).ToCoordsXY();
+        }
+        return TileCoordsXY(x, y).ToCoordsXY();
+    };
+    auto a = unrotate(minX, minY);
+    auto b = unrotate(maxX, maxY);
+    return MapRange(
+        std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x) + COORDS_XY_STEP - 1,
+        std::max(a.y, b.y) + COORDS_XY_STEP - 1);
+}
+
 /**
  *
  *  rct2: 0x0068DADA
  */
 static void window_map_paint_peep_overlay(rct_drawpixelinfo* dpi)
 {
-    for (auto peep : EntityList<Peep>(EntityListId::Peep))
-    {
+    auto paintPeep = [dpi](Peep* peep) {
         if (peep->x == LOCATION_NULL)
-            continue;
+            return;
 
         MapCoordsXY c = window_map_transform_to_map_coords({ peep->x, peep->y });
         auto leftTop = ScreenCoordsXY{ c.x, c.y };
@@ -1071,6 +1174,21 @@ static void window_map_paint_peep_overlay(rct_drawpixelinfo* dpi)
             }
         }
         gfx_fill_rect(dpi, { leftTop, rightBottom }, colour);
+    };
+
+    // Only look up the visible tiles in the spatial index when that is less work than going through every peep
+    int32_t numTiles;
+    auto range = window_map_get_visible_range(dpi, numTiles);
+    if (numTiles < GetEntityListCount(EntityListId::Peep))
+    {
+        ForEachEntityInRange<Peep>(range, paintPeep);
+    }
+    else
+    {
+        for (auto peep : EntityList<Peep>(EntityListId::Peep))
+        {
+            paintPeep(peep);
+        }
     }
 }
 
@@ -1080,16 +1198,29 @@ static void window_map_paint_peep_overlay(rct_drawpixelinfo* dpi)
  */
 static void window_map_paint_train_overlay(rct_drawpixelinfo* dpi)
 {
-    for (auto train : EntityList<Vehicle>(EntityListId::TrainHead))
-    {
-        for (Vehicle* vehicle = train; vehicle != nullptr; vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train))
-        {
-            if (vehicle->x == LOCATION_NULL)
-                continue;
+    auto paintVehicle = [dpi](Vehicle* vehicle) {
+        if (vehicle->x == LOCATION_NULL)
+            return;
 
-            MapCoordsXY c = window_map_transform_to_map_coords({ vehicle->x, vehicle->y });
+        MapCoordsXY c = window_map_transform_to_map_coords({ vehicle->x, vehicle->y });
 
-            gfx_fill_rect(dpi, { { c.x, c.y }, { c.x, c.y } }, PALETTE_INDEX_171);
+        gfx_fill_rect(dpi, { { c.x, c.y }, { c.x, c.y } }, PALETTE_INDEX_171);
+    };
+
+    int32_t numTiles;
+    auto range = window_map_get_visible_range(dpi, numTiles);
+    if (numTiles < GetEntityListCount(EntityListId::TrainHead) + GetEntityListCount(EntityListId::Vehicle))
+    {
+        ForEachEntityInRange<Vehicle>(range, paintVehicle);
+    }
+    else
+    {
+        for (auto train : EntityList<Vehicle>(EntityListId::TrainHead))
+        {
+            for (Vehicle* vehicle = train; vehicle != nullptr; vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train))
+            {
+                paintVehicle(vehicle);
+            }
         }
     }
 }
@@ -1501,37 +1632,56 @@ static uint16_t map_window_get_pixel_colour_ride(const CoordsXY& c)
     return colourB;
 }
 
-static void map_window_set_pixels(rct_window* w)
+static void map_window_set_pixel(std::vector<uint8_t>& image, int32_t tab, const CoordsXY& c, int32_t line, int32_t i)
 {
-    uint16_t colour = 0;
-    int32_t x = 0, y = 0, dx = 0, dy = 0;
+    if (c.x > 0 && c.y > 0 && c.x < gMapSizeUnits && c.y < gMapSizeUnits)
+    {
+        uint16_t colour = 0;
+        switch (tab)
+        {
+            case PAGE_PEEPS:
+                colour = map_window_get_pixel_colour_peep(c);
+                break;
+            case PAGE_RIDES:
+                colour = map_window_get_pixel_colour_ride(c);
+                break;
+        }
 
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE };
-    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
-    switch (get_current_rotation())
+        // Lines start along the top left edge of the diamond and run down to the right
+        int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+        auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE + i, pos / MAP_WINDOW_MAP_SIZE + i };
+        auto destination = image.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+        destination[0] = (colour >> 8) & 0xFF;
+        destination[1] = colour;
+    }
+}
+
+static void map_window_set_pixels(std::vector<uint8_t>& image, int32_t rotation, int32_t tab, int32_t line)
+{
+    int32_t x = 0, y = 0, dx = 0, dy = 0;
+    switch (rotation)
     {
         case 0:
-            x = _currentLine * COORDS_XY_STEP;
+            x = line * COORDS_XY_STEP;
             y = 0;
             dx = 0;
             dy = COORDS_XY_STEP;
             break;
         case 1:
             x = MAXIMUM_TILE_START_XY;
-            y = _currentLine * COORDS_XY_STEP;
+            y = line * COORDS_XY_STEP;
             dx = -COORDS_XY_STEP;
             dy = 0;
             break;
         case 2:
-            x = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
+            x = MAXIMUM_MAP_SIZE_BIG - ((line + 1) * COORDS_XY_STEP);
             y = MAXIMUM_TILE_START_XY;
             dx = 0;
             dy = -COORDS_XY_STEP;
             break;
         case 3:
             x = 0;
-            y = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
+            y = MAXIMUM_MAP_SIZE_BIG - ((line + 1) * COORDS_XY_STEP);
             dx = COORDS_XY_STEP;
             dy = 0;
             break;
@@ -1539,30 +1689,39 @@ static void map_window_set_pixels(rct_window* w)
 
     for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
     {
-        if (x > 0 && y > 0 && x < gMapSizeUnits && y < gMapSizeUnits)
-        {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = map_window_get_pixel_colour_peep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = map_window_get_pixel_colour_ride({ x, y });
-                    break;
-            }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
-        }
+        map_window_set_pixel(image, tab, { x, y }, line, i);
         x += dx;
         y += dy;
+    }
+}
 
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+/**
+ * Redraws a single tile, at the line and position in it map_window_set_pixels draws the tile at.
+ */
+static void map_window_set_tile_pixel(std::vector<uint8_t>& image, int32_t rotation, int32_t tab, const TileCoordsXY& tile)
+{
+    constexpr int32_t lastTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    int32_t line = 0, i = 0;
+    switch (rotation)
+    {
+        case 0:
+            line = tile.x;
+            i = tile.y;
+            break;
+        case 1:
+            line = tile.y;
+            i = lastTile - tile.x;
+            break;
+        case 2:
+            line = lastTile - tile.x;
+            i = lastTile - tile.y;
+            break;
+        case 3:
+            line = lastTile - tile.y;
+            i = tile.x;
+            break;
     }
-    _currentLine++;
-    if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
-        _currentLine = 0;
+    map_window_set_pixel(image, tab, tile.ToCoordsXY(), line, i);
 }
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords)
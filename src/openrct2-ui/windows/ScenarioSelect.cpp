@@ -103,6 +103,7 @@ static void window_scenarioselect_init_tabs(rct_window *w);
 static void window_scenarioselect_close(rct_window *w);
 static void window_scenarioselect_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_scenarioselect_mousedown(rct_window *w, rct_widgetindex widgetIndex, rct_widget* widget);
+static void window_scenarioselect_update(rct_window *w);
 static void window_scenarioselect_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
 static void window_scenarioselect_scrollmousedown(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
 static void window_scenarioselect_scrollmouseover(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
@@ -115,6 +116,7 @@ static rct_window_event_list window_scenarioselect_events([](auto& events)
     events.close = &window_scenarioselect_close;
     events.mouse_up = &window_scenarioselect_mouseup;
     events.mouse_down = &window_scenarioselect_mousedown;
+    events.update = &window_scenarioselect_update;
     events.get_scroll_size = &window_scenarioselect_scrollgetsize;
     events.scroll_mousedown = &window_scenarioselect_scrollmousedown;
     events.scroll_mouseover = &window_scenarioselect_scrollmouseover;
@@ -133,6 +135,8 @@ static bool is_locking_enabled(rct_window* w);
 static scenarioselect_callback _callback;
 static bool _showLockedInformation = false;
 static bool _titleEditor = false;
+// The scenarios are being rescanned, the list is filled in once the scan is done
+static bool _listItemsPending = false;
 
 /**
  *
@@ -156,8 +160,9 @@ rct_window* window_scenarioselect_open(scenarioselect_callback callback, bool ti
     if (window != nullptr)
         return window;
 
-    // Load scenario list
-    scenario_repository_scan();
+    // Rescan the scenario list and highscores without holding up the window, a placeholder is shown until it is done
+    GetScenarioRepository()->ScanInBackground(LocalisationService_GetCurrentLanguage());
+    _listItemsPending = GetScenarioRepository()->IsScanning();
 
     // Shrink the window if we're showing scenarios by difficulty level.
     if (gConfigGeneral.scenario_select_mode == SCENARIO_SELECT_MODE_DIFFICULTY && !_titleEditor)
@@ -172,8 +177,12 @@ rct_window* window_scenarioselect_open(scenarioselect_callback callback, bool ti
     window->enabled_widgets = (1 << WIDX_CLOSE) | (1 << WIDX_TAB1) | (1 << WIDX_TAB2) | (1 << WIDX_TAB3) | (1 << WIDX_TAB4)
         | (1 << WIDX_TAB5) | (1 << WIDX_TAB6) | (1 << WIDX_TAB7) | (1 << WIDX_TAB8);
 
-    window_scenarioselect_init_tabs(window);
-    initialise_list_items(window);
+    _listItems.clear();
+    if (!_listItemsPending)
+    {
+        window_scenarioselect_init_tabs(window);
+        initialise_list_items(window);
+    }
 
     window_init_scroll_widgets(window);
     window->viewport_focus_coordinates.var_480 = -1;
@@ -244,6 +253,7 @@ static void window_scenarioselect_close(rct_window* w)
 {
     _listItems.clear();
     _listItems.shrink_to_fit();
+    _listItemsPending = false;
 }
 
 static void window_scenarioselect_mouseup(rct_window* w, rct_widgetindex widgetIndex)
@@ -256,7 +266,7 @@ static void window_scenarioselect_mouseup(rct_window* w, rct_widgetindex widgetI
 
 static void window_scenarioselect_mousedown(rct_window* w, rct_widgetindex widgetIndex, rct_widget* widget)
 {
-    if (widgetIndex >= WIDX_TAB1 && widgetIndex <= WIDX_TAB8)
+    if (widgetIndex >= WIDX_TAB1 && widgetIndex <= WIDX_TAB8 && !_listItemsPending)
     {
         w->selected_tab = widgetIndex - 4;
         w->highlighted_scenario = nullptr;
@@ -271,6 +281,18 @@ static void window_scenarioselect_mousedown(rct_window* w, rct_widgetindex widge
     }
 }
 
+static void window_scenarioselect_update(rct_window* w)
+{
+    if (_listItemsPending && !GetScenarioRepository()->IsScanning())
+    {
+        _listItemsPending = false;
+        window_scenarioselect_init_tabs(w);
+        initialise_list_items(w);
+        window_init_scroll_widgets(w);
+        w->Invalidate();
+    }
+}
+
 static int32_t get_scenario_list_item_size()
 {
     if (!LocalisationService_UseTrueTypeFont())
@@ -560,6 +582,12 @@ static void window_scenarioselect_scrollpaint(rct_window* w, rct_drawpixelinfo*
     // Scenario title
     int32_t scenarioTitleHeight = font_get_line_height(FONT_SPRITE_BASE_MEDIUM);
 
+    if (_listItemsPending)
+    {
+        gfx_draw_string_centred(dpi, STR_SCENARIO_LIST_LOADING, { listWidth / 2, 4 }, COLOUR_BLACK, nullptr);
+        return;
+    }
+
     int32_t y = 0;
     for (const auto& listItem : _listItems)
     {
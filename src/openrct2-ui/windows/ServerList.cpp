@@ -36,7 +36,9 @@
 
 static char _playerName[32 + 1];
 static ServerList _serverList;
-static std::future<std::tuple<std::vector<ServerListEntry>, rct_string_id>> _fetchFuture;
+// The LAN and the master server are queried at the same time, the servers of each are listed as soon as they arrive
+static std::future<std::vector<ServerListEntry>> _fetchLocalFuture;
+static std::future<std::vector<ServerListEntry>> _fetchOnlineFuture;
 static uint32_t _numPlayersOnline = 0;
 static rct_string_id _statusText = STR_SERVER_LIST_CONNECTING;
 
@@ -112,7 +114,7 @@ static std::string _version;
 
 static void server_list_get_item_button(int32_t buttonIndex, int32_t x, int32_t y, int32_t width, int32_t* outX, int32_t* outY);
 static void join_server(std::string address);
-static void server_list_fetch_servers_begin();
+static void server_list_fetch_servers_begin(bool refresh);
 static void server_list_fetch_servers_check(rct_window* w);
 
 rct_window* window_server_list_open()
@@ -150,7 +152,7 @@ rct_window* window_server_list_open()
     _serverList.ReadAndAddFavourites();
     window->no_list_items = static_cast<uint16_t>(_serverList.GetCount());
 
-    server_list_fetch_servers_begin();
+    server_list_fetch_servers_begin(false);
 
     return window;
 }
@@ -158,7 +160,8 @@ rct_window* window_server_list_open()
 static void window_server_list_close(rct_window* w)
 {
     _serverList = {};
-    _fetchFuture = {};
+    _fetchLocalFuture = {};
+    _fetchOnlineFuture = {};
 }
 
 static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetIndex)
@@ -191,7 +194,7 @@ static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetInde
             break;
         }
         case WIDX_FETCH_SERVERS:
-            server_list_fetch_servers_begin();
+            server_list_fetch_servers_begin(true);
             break;
         case WIDX_ADD_SERVER:
             window_text_input_open(w, widgetIndex, STR_ADD_SERVER, STR_ENTER_HOSTNAME_OR_IP_ADDRESS, STR_NONE, 0, 128);
@@ -549,9 +552,13 @@ static void join_server(std::string address)
     }
 }
 
-static void server_list_fetch_servers_begin()
+/**
+ * Fetches the servers on the LAN and those of the master server. The list of the master server is cached for a few minutes
+ * and only fetched again before then when refreshing.
+ */
+static void server_list_fetch_servers_begin(bool refresh)
 {
-    if (_fetchFuture.valid())
+    if (_fetchLocalFuture.valid() || _fetchOnlineFuture.valid())
     {
         // A fetch is already in progress
         return;
@@ -561,70 +568,67 @@ static void server_list_fetch_servers_begin()
     _serverList.ReadAndAddFavourites();
     _statusText = STR_SERVER_LIST_CONNECTING;
 
-    _fetchFuture = std::async(std::launch::async, [] {
-        // Spin off background fetches
-        auto lanF = _serverList.FetchLocalServerListAsync();
-        auto wanF = _serverList.FetchOnlineServerListAsync();
+    _fetchLocalFuture = _serverList.FetchLocalServerListAsync();
 
-        // Merge or deal with errors
-        std::vector<ServerListEntry> allEntries;
+    auto cachedEntries = refresh ? std::nullopt : _serverList.ReadCachedOnlineServerList();
+    if (cachedEntries)
+    {
+        _serverList.AddRange(*cachedEntries);
+        _numPlayersOnline = _serverList.GetTotalPlayerCount();
+        _statusText = STR_X_PLAYERS_ONLINE;
+    }
+    else
+    {
+        _fetchOnlineFuture = _serverList.FetchOnlineServerListAsync();
+        if (!_fetchOnlineFuture.valid())
+        {
+            // Built without HTTP support
+            _statusText = STR_SERVER_LIST_NO_CONNECTION;
+        }
+    }
+}
+
+static bool server_list_fetch_is_ready(const std::future<std::vector<ServerListEntry>>& future)
+{
+    return future.valid() && future.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+static void server_list_fetch_servers_check(rct_window* w)
+{
+    if (server_list_fetch_is_ready(_fetchLocalFuture))
+    {
         try
         {
-            auto entries = lanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
+            _serverList.AddRange(_fetchLocalFuture.get());
+            _numPlayersOnline = _serverList.GetTotalPlayerCount();
         }
-        catch (...)
+        catch (const std::exception& e)
         {
+            log_warning("Unable to query the LAN for servers: %s", e.what());
         }
+        _fetchLocalFuture = {};
+        w->Invalidate();
+    }
 
-        auto status = STR_NONE;
+    if (server_list_fetch_is_ready(_fetchOnlineFuture))
+    {
         try
         {
-            auto entries = wanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
+            _serverList.AddRange(_fetchOnlineFuture.get());
+            _numPlayersOnline = _serverList.GetTotalPlayerCount();
+            _statusText = STR_X_PLAYERS_ONLINE;
         }
         catch (const MasterServerException& e)
         {
-            status = e.StatusText;
+            _statusText = e.StatusText;
         }
-        catch (...)
+        catch (const std::exception& e)
         {
-            status = STR_SERVER_LIST_NO_CONNECTION;
-        }
-        return std::make_tuple(allEntries, status);
-    });
-}
-
-static void server_list_fetch_servers_check(rct_window* w)
-{
-    if (_fetchFuture.valid())
-    {
-        auto status = _fetchFuture.wait_for(std::chrono::seconds::zero());
-        if (status == std::future_status::ready)
-        {
-            try
-            {
-                auto [entries, statusText] = _fetchFuture.get();
-                _serverList.AddRange(entries);
-                _numPlayersOnline = _serverList.GetTotalPlayerCount();
-                _statusText = STR_X_PLAYERS_ONLINE;
-                if (statusText != STR_NONE)
-                {
-                    _statusText = statusText;
-                }
-            }
-            catch (const MasterServerException& e)
-            {
-                _statusText = e.StatusText;
-            }
-            catch (const std::exception& e)
-            {
-                _statusText = STR_SERVER_LIST_NO_CONNECTION;
-                log_warning("Unable to connect to master server: %s", e.what());
-            }
-            _fetchFuture = {};
-            w->Invalidate();
+            _statusText = STR_SERVER_LIST_NO_CONNECTION;
+            log_warning("Unable to connect to master server: %s", e.what());
         }
+        _fetchOnlineFuture = {};
+        w->Invalidate();
     }
 }
 
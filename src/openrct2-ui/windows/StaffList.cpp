@@ -186,7 +186,7 @@ void WindowStaffListRefresh()
         StaffList.push_back(peep->sprite_index);
     }
 
-    std::sort(StaffList.begin(), StaffList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
+    peep_sort(StaffList);
 }
 
 static void window_staff_list_cancel_tools(rct_window* w)
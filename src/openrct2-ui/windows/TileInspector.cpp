@@ -1150,7 +1150,7 @@ static void window_tile_inspector_mousedown(rct_window* w, rct_widgetindex widge
 static void window_tile_inspector_update(rct_window* w)
 {
     // Check if the mouse is hovering over the list
-    if (!widget_is_highlighted(w, WIDX_LIST))
+    if (!widget_is_highlighted(w, WIDX_LIST) && windowTileInspectorHighlightedIndex != -1)
     {
         windowTileInspectorHighlightedIndex = -1;
         widget_invalidate(w, WIDX_LIST);
@@ -1330,11 +1330,13 @@ static void window_tile_inspector_scrollmouseover(rct_window* w, int32_t scrollI
 {
     int16_t index = windowTileInspectorElementCount - (screenCoords.y - 1) / SCROLLABLE_ROW_HEIGHT - 1;
     if (index < 0 || index >= windowTileInspectorElementCount)
-        windowTileInspectorHighlightedIndex = -1;
-    else
-        windowTileInspectorHighlightedIndex = index;
+        index = -1;
 
-    widget_invalidate(w, WIDX_LIST);
+    if (index != windowTileInspectorHighlightedIndex)
+    {
+        windowTileInspectorHighlightedIndex = index;
+        widget_invalidate(w, WIDX_LIST);
+    }
 }
 
 static void window_tile_inspector_invalidate(rct_window* w)
@@ -2234,6 +2236,15 @@ static void window_tile_inspector_scrollpaint(rct_window* w, rct_drawpixelinfo*
     {
         if (tileElement == nullptr)
             break;
+
+        // The first elements are listed at the bottom, only the rows in view are described and drawn
+        if (screenCoords.y >= dpi->y + dpi->height || screenCoords.y + SCROLLABLE_ROW_HEIGHT <= dpi->y)
+        {
+            screenCoords.y -= SCROLLABLE_ROW_HEIGHT;
+            i++;
+            continue;
+        }
+
         const bool selectedRow = i == windowTileInspectorSelectedIndex;
         const bool hoveredRow = i == windowTileInspectorHighlightedIndex;
         int32_t type = tileElement->GetType();
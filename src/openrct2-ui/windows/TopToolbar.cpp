@@ -39,6 +39,7 @@
 #include <openrct2/actions/PauseToggleAction.hpp>
 #include <openrct2/actions/SetCheatAction.hpp>
 #include <openrct2/actions/SmallSceneryPlaceAction.hpp>
+#include <openrct2/actions/SmallSceneryScatterAction.hpp>
 #include <openrct2/actions/SmallScenerySetColourAction.hpp>
 #include <openrct2/actions/SurfaceSetStyleAction.hpp>
 #include <openrct2/actions/WallPlaceAction.hpp>
@@ -1746,13 +1747,19 @@ static void window_top_toolbar_scenery_tool_down(const ScreenCoordsXY& windowPos
             if (gridPos.isNull())
                 return;
 
-            int32_t quantity = 1;
             bool isCluster = gWindowSceneryScatterEnabled
                 && (network_get_mode() != NETWORK_MODE_CLIENT
                     || network_can_perform_command(network_get_current_player_group_index(), -2));
 
+            uint8_t zAttemptRange = 1;
+            if (gSceneryPlaceZ != 0 && gSceneryShiftPressed)
+            {
+                zAttemptRange = 20;
+            }
+
             if (isCluster)
             {
+                int32_t quantity = 1;
                 switch (gWindowSceneryScatterDensity)
                 {
                     case ScatterToolDensity::LowDensity:
@@ -1767,18 +1774,12 @@ static void window_top_toolbar_scenery_tool_down(const ScreenCoordsXY& windowPos
                         quantity = gWindowSceneryScatterSize * 3;
                         break;
                 }
-            }
 
-            bool forceError = true;
-            for (int32_t q = 0; q < quantity; q++)
-            {
-                int32_t zCoordinate = gSceneryPlaceZ;
+                // The whole cluster is checked and placed by one action
                 rct_scenery_entry* scenery = get_small_scenery_entry(selectedScenery);
-
-                int16_t cur_grid_x = gridPos.x;
-                int16_t cur_grid_y = gridPos.y;
-
-                if (isCluster)
+                std::vector<CoordsXYZD> locs;
+                std::vector<uint8_t> quadrants;
+                for (int32_t q = 0; q < quantity; q++)
                 {
                     if (!scenery_small_entry_has_flag(scenery, SMALL_SCENERY_FLAG_FULL_TILE))
                     {
@@ -1792,71 +1793,59 @@ static void window_top_toolbar_scenery_tool_down(const ScreenCoordsXY& windowPos
                         grid_x_offset += 1;
                         grid_y_offset += 1;
                     }
-                    cur_grid_x += grid_x_offset * COORDS_XY_STEP;
-                    cur_grid_y += grid_y_offset * COORDS_XY_STEP;
 
                     if (!scenery_small_entry_has_flag(scenery, SMALL_SCENERY_FLAG_ROTATABLE))
                     {
                         gSceneryPlaceRotation = (gSceneryPlaceRotation + 1) & 3;
                     }
-                }
 
-                uint8_t zAttemptRange = 1;
-                if (gSceneryPlaceZ != 0 && gSceneryShiftPressed)
-                {
-                    zAttemptRange = 20;
+                    auto loc = CoordsXY{ gridPos.x + grid_x_offset * COORDS_XY_STEP,
+                                         gridPos.y + grid_y_offset * COORDS_XY_STEP };
+                    locs.push_back({ loc, gSceneryPlaceZ, gSceneryPlaceRotation });
+                    quadrants.push_back(quadrant);
                 }
 
-                auto success = GameActions::Status::Unknown;
-                // Try find a valid z coordinate
-                for (; zAttemptRange != 0; zAttemptRange--)
-                {
-                    auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
-                        { cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery,
-                        primaryColour, secondaryColour);
-                    auto res = GameActions::Query(&smallSceneryPlaceAction);
-                    success = res->Error;
-                    if (res->Error == GameActions::Status::Ok)
+                auto scatterAction = SmallSceneryScatterAction(
+                    locs, quadrants, selectedScenery, primaryColour, secondaryColour, zAttemptRange);
+                scatterAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
+                    if (result->Error == GameActions::Status::Ok)
                     {
-                        break;
+                        OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
                     }
+                });
+                GameActions::Execute(&scatterAction);
+                break;
+            }
 
-                    if (res->Error == GameActions::Status::InsufficientFunds)
-                    {
-                        break;
-                    }
-                    if (zAttemptRange != 1)
-                    {
-                        gSceneryPlaceZ += 8;
-                    }
+            // Try find a valid z coordinate
+            int32_t zCoordinate = gSceneryPlaceZ;
+            for (; zAttemptRange != 0; zAttemptRange--)
+            {
+                auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
+                    { gridPos, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery, primaryColour,
+                    secondaryColour);
+                auto res = GameActions::Query(&smallSceneryPlaceAction);
+                if (res->Error == GameActions::Status::Ok || res->Error == GameActions::Status::InsufficientFunds)
+                {
+                    break;
                 }
-
-                // Actually place
-                if (success == GameActions::Status::Ok || ((q + 1 == quantity) && forceError))
+                if (zAttemptRange != 1)
                 {
-                    auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
-                        { cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery,
-                        primaryColour, secondaryColour);
-
-                    smallSceneryPlaceAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
-                        if (result->Error == GameActions::Status::Ok)
-                        {
-                            OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
-                        }
-                    });
-                    auto res = GameActions::Execute(&smallSceneryPlaceAction);
-                    if (res->Error == GameActions::Status::Ok)
-                    {
-                        forceError = false;
-                    }
-
-                    if (res->Error == GameActions::Status::InsufficientFunds)
-                    {
-                        break;
-                    }
+                    gSceneryPlaceZ += 8;
                 }
-                gSceneryPlaceZ = zCoordinate;
             }
+
+            // Actually place, a failure is shown as an error
+            auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
+                { gridPos, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery, primaryColour, secondaryColour);
+            smallSceneryPlaceAction.SetCallback([=](const GameAction* ga, const GameActions::Result* result) {
+                if (result->Error == GameActions::Status::Ok)
+                {
+                    OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
+                }
+            });
+            GameActions::Execute(&smallSceneryPlaceAction);
+            gSceneryPlaceZ = zCoordinate;
             break;
         }
         case SCENERY_TYPE_PATH_ITEM:
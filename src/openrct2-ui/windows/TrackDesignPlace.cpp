@@ -102,6 +102,8 @@ static CoordsXYZ _windowTrackPlaceLastValid;
 static money32 _window_track_place_last_cost;
 
 static std::unique_ptr<TrackDesign> _trackDesign;
+// The footprint of _trackDesign for the current rotation, worked out again when the design is rotated or mirrored.
+static std::unique_ptr<TrackDesignFootprint> _trackDesignFootprint;
 
 static void window_track_place_clear_provisional();
 static int32_t window_track_place_get_base_z(const CoordsXY& loc);
@@ -133,6 +135,7 @@ static void window_track_place_clear_mini_preview()
 rct_window* window_track_place_open(const track_design_file_ref* tdFileRef)
 {
     _trackDesign = track_design_open(tdFileRef->path);
+    _trackDesignFootprint = nullptr;
     if (_trackDesign == nullptr)
     {
         return nullptr;
@@ -175,6 +178,7 @@ static void window_track_place_close(rct_window* w)
     _window_track_place_mini_preview.clear();
     _window_track_place_mini_preview.shrink_to_fit();
     _trackDesign = nullptr;
+    _trackDesignFootprint = nullptr;
 }
 
 /**
@@ -197,6 +201,7 @@ static void window_track_place_mouseup(rct_window* w, rct_widgetindex widgetInde
             break;
         case WIDX_MIRROR:
             track_design_mirror(_trackDesign.get());
+            _trackDesignFootprint = nullptr;
             _currentTrackPieceDirection = (0 - _currentTrackPieceDirection) & 3;
             w->Invalidate();
             _windowTrackPlaceLast.setNull();
@@ -224,6 +229,16 @@ static void window_track_place_update(rct_window* w)
             window_close(w);
 }
 
+static const TrackDesignFootprint& window_track_place_get_footprint()
+{
+    if (_trackDesignFootprint == nullptr || _trackDesignFootprint->Rotation != _currentTrackPieceDirection
+        || _trackDesignFootprint->PlaceScenery == gTrackDesignSceneryToggle)
+    {
+        _trackDesignFootprint = track_design_get_footprint(_trackDesign.get(), true, GetOrAllocateRide(0));
+    }
+    return *_trackDesignFootprint;
+}
+
 static GameActions::Result::Ptr FindValidTrackDesignPlaceHeight(CoordsXYZ& loc, uint32_t flags)
 {
     GameActions::Result::Ptr res;
@@ -239,6 +254,12 @@ static GameActions::Result::Ptr FindValidTrackDesignPlaceHeight(CoordsXYZ& loc,
         {
             return res;
         }
+
+        // With only the ground below the design there is nothing that a higher placement could clear.
+        if (i == 0 && track_design_footprint_is_clear(window_track_place_get_footprint(), loc))
+        {
+            return res;
+        }
     }
     return res;
 }
@@ -267,7 +288,7 @@ static void window_track_place_toolupdate(rct_window* w, rct_widgetindex widgetI
     // Check if tool map position has changed since last update
     if (mapCoords == _windowTrackPlaceLast)
     {
-        place_virtual_track(_trackDesign.get(), PTD_OPERATION_DRAW_OUTLINES, true, GetOrAllocateRide(0), { mapCoords, 0 });
+        track_design_footprint_draw_outlines(window_track_place_get_footprint(), mapCoords);
         return;
     }
 
@@ -307,7 +328,7 @@ static void window_track_place_toolupdate(rct_window* w, rct_widgetindex widgetI
         widget_invalidate(w, WIDX_PRICE);
     }
 
-    place_virtual_track(_trackDesign.get(), PTD_OPERATION_DRAW_OUTLINES, true, GetOrAllocateRide(0), trackLoc);
+    track_design_footprint_draw_outlines(window_track_place_get_footprint(), trackLoc);
 }
 
 /**
@@ -468,7 +489,7 @@ static int32_t window_track_place_get_base_z(const CoordsXY& loc)
     if (surfaceElement->GetWaterHeight() > 0)
         z = std::max(z, surfaceElement->GetWaterHeight());
 
-    return z + place_virtual_track(_trackDesign.get(), PTD_OPERATION_GET_PLACE_Z, true, GetOrAllocateRide(0), { loc, z });
+    return z + track_design_footprint_get_place_z(window_track_place_get_footprint(), { loc, z });
 }
 
 /**
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <list>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
 #include <openrct2/Context.h>
@@ -22,6 +23,7 @@
 #include <openrct2/ride/TrackDesignRepository.h>
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
+#include <string>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_SELECT_DESIGN;
@@ -83,6 +85,7 @@ static rct_window_event_list window_track_list_events([](auto& events)
 // clang-format on
 
 constexpr uint16_t TRACK_DESIGN_INDEX_UNLOADED = UINT16_MAX;
+constexpr size_t TRACK_DESIGN_PREVIEW_CACHE_SIZE = 16;
 
 RideSelection _window_track_list_item;
 
@@ -90,8 +93,21 @@ static std::vector<track_design_file_ref> _trackDesigns;
 static utf8 _filterString[USER_STRING_MAX_LENGTH];
 static std::vector<uint16_t> _filteredTrackIds;
 static uint16_t _loadedTrackDesignIndex;
-static std::unique_ptr<TrackDesign> _loadedTrackDesign;
-static std::vector<uint8_t> _trackDesignPreviewPixels;
+static TrackDesign* _loadedTrackDesign;
+static const uint8_t* _trackDesignPreviewPixels;
+
+/**
+ * The designs shown most recently together with their previews, most recent first. Drawing a preview places the
+ * design on a cleared copy of the map, so going back and forth through the list should not do that every time.
+ */
+struct TrackDesignPreview
+{
+    std::string Path;
+    bool SceneryToggle;
+    std::unique_ptr<TrackDesign> Design;
+    std::vector<uint8_t> Pixels;
+};
+static std::list<TrackDesignPreview> _trackDesignPreviews;
 
 static void track_list_load_designs(RideSelection item);
 static bool track_list_load_design_for_preview(utf8* path);
@@ -142,9 +158,9 @@ rct_window* window_track_list_open(RideSelection item)
     window_push_others_right(w);
     _currentTrackPieceDirection = 2;
 
-    _trackDesignPreviewPixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
-
+    _trackDesignPreviews.clear();
     _loadedTrackDesign = nullptr;
+    _trackDesignPreviewPixels = nullptr;
     _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
 
     return w;
@@ -192,8 +208,8 @@ static void window_track_list_close(rct_window* w)
 {
     // Dispose track design and preview
     _loadedTrackDesign = nullptr;
-    _trackDesignPreviewPixels.clear();
-    _trackDesignPreviewPixels.shrink_to_fit();
+    _trackDesignPreviewPixels = nullptr;
+    _trackDesignPreviews.clear();
 
     // Dispose track list
     for (auto& trackDesign : _trackDesigns)
@@ -414,6 +430,11 @@ static void window_track_list_update(rct_window* w)
 
     if (w->track_list.reload_track_designs)
     {
+        // Designs may have been renamed or deleted, so their previews can no longer be trusted.
+        _trackDesignPreviews.clear();
+        _loadedTrackDesign = nullptr;
+        _trackDesignPreviewPixels = nullptr;
+        _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
         track_list_load_designs(_window_track_list_item);
         w->selected_list_item = 0;
         w->Invalidate();
@@ -517,27 +538,26 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
         }
     }
 
-    if (!_loadedTrackDesign)
-    {
-        return;
-    }
-
+    // The design is only needed for its preview and the warnings, the statistics come from the track design index
     auto trackPreview = screenPos;
     screenPos = w->windowPos + ScreenCoordsXY{ widget->midX(), widget->midY() };
-
-    rct_g1_element g1temp = {};
-    g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
-    g1temp.width = 370;
-    g1temp.height = 217;
-    g1temp.flags = G1_FLAG_BMP;
-    gfx_set_g1_element(SPR_TEMP, &g1temp);
-    drawing_engine_invalidate_image(SPR_TEMP);
-    gfx_draw_sprite(dpi, SPR_TEMP, trackPreview, 0);
+    if (_loadedTrackDesign != nullptr)
+    {
+        rct_g1_element g1temp = {};
+        g1temp.offset = const_cast<uint8_t*>(_trackDesignPreviewPixels)
+            + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
+        g1temp.width = 370;
+        g1temp.height = 217;
+        g1temp.flags = G1_FLAG_BMP;
+        gfx_set_g1_element(SPR_TEMP, &g1temp);
+        drawing_engine_invalidate_image(SPR_TEMP);
+        gfx_draw_sprite(dpi, SPR_TEMP, trackPreview, 0);
+    }
 
     screenPos.y = w->windowPos.y + widget->bottom - 12;
 
     // Warnings
-    if ((_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_VEHICLE_UNAVAILABLE)
+    if (_loadedTrackDesign != nullptr && (_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_VEHICLE_UNAVAILABLE)
         && !(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER))
     {
         // Vehicle design not available
@@ -545,7 +565,7 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
         screenPos.y -= SCROLLABLE_ROW_HEIGHT;
     }
 
-    if (_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_SCENERY_UNAVAILABLE)
+    if (_loadedTrackDesign != nullptr && (_loadedTrackDesign->track_flags & TRACK_DESIGN_FLAG_SCENERY_UNAVAILABLE))
     {
         if (!gTrackDesignSceneryToggle)
         {
@@ -565,39 +585,41 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
     screenPos = w->windowPos + ScreenCoordsXY{ widget->left + 1, widget->bottom + 2 };
 
     // Stats
-    fixed32_2dp rating = _loadedTrackDesign->excitement * 10;
+    const auto& stats = _trackDesigns[trackIndex].stats;
+    const auto rideType = _window_track_list_item.Type;
+    fixed32_2dp rating = stats.excitement * 10;
     gfx_draw_string_left(dpi, STR_TRACK_LIST_EXCITEMENT_RATING, &rating, COLOUR_BLACK, screenPos);
     screenPos.y += LIST_ROW_HEIGHT;
 
-    rating = _loadedTrackDesign->intensity * 10;
+    rating = stats.intensity * 10;
     gfx_draw_string_left(dpi, STR_TRACK_LIST_INTENSITY_RATING, &rating, COLOUR_BLACK, screenPos);
     screenPos.y += LIST_ROW_HEIGHT;
 
-    rating = _loadedTrackDesign->nausea * 10;
+    rating = stats.nausea * 10;
     gfx_draw_string_left(dpi, STR_TRACK_LIST_NAUSEA_RATING, &rating, COLOUR_BLACK, screenPos);
     screenPos.y += LIST_ROW_HEIGHT + 4;
 
     // Information for tracked rides.
-    if (ride_type_has_flag(_loadedTrackDesign->type, RIDE_TYPE_FLAG_HAS_TRACK))
+    if (ride_type_has_flag(rideType, RIDE_TYPE_FLAG_HAS_TRACK))
     {
-        if (_loadedTrackDesign->type != RIDE_TYPE_MAZE)
+        if (rideType != RIDE_TYPE_MAZE)
         {
-            if (_loadedTrackDesign->type == RIDE_TYPE_MINI_GOLF)
+            if (rideType == RIDE_TYPE_MINI_GOLF)
             {
                 // Holes
-                uint16_t holes = _loadedTrackDesign->holes & 0x1F;
+                uint16_t holes = stats.holes & 0x1F;
                 gfx_draw_string_left(dpi, STR_HOLES, &holes, COLOUR_BLACK, screenPos);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
             else
             {
                 // Maximum speed
-                uint16_t speed = ((_loadedTrackDesign->max_speed << 16) * 9) >> 18;
+                uint16_t speed = ((stats.max_speed << 16) * 9) >> 18;
                 gfx_draw_string_left(dpi, STR_MAX_SPEED, &speed, COLOUR_BLACK, screenPos);
                 screenPos.y += LIST_ROW_HEIGHT;
 
                 // Average speed
-                speed = ((_loadedTrackDesign->average_speed << 16) * 9) >> 18;
+                speed = ((stats.average_speed << 16) * 9) >> 18;
                 gfx_draw_string_left(dpi, STR_AVERAGE_SPEED, &speed, COLOUR_BLACK, screenPos);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
@@ -605,53 +627,53 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
             // Ride length
             ft = Formatter();
             ft.Add<rct_string_id>(STR_RIDE_LENGTH_ENTRY);
-            ft.Add<uint16_t>(_loadedTrackDesign->ride_length);
+            ft.Add<uint16_t>(stats.ride_length);
             DrawTextEllipsised(dpi, screenPos, 214, STR_TRACK_LIST_RIDE_LENGTH, ft, COLOUR_BLACK);
             screenPos.y += LIST_ROW_HEIGHT;
         }
 
-        if (ride_type_has_flag(_loadedTrackDesign->type, RIDE_TYPE_FLAG_HAS_G_FORCES))
+        if (ride_type_has_flag(rideType, RIDE_TYPE_FLAG_HAS_G_FORCES))
         {
             // Maximum positive vertical Gs
-            int32_t gForces = _loadedTrackDesign->max_positive_vertical_g * 32;
+            int32_t gForces = stats.max_positive_vertical_g * 32;
             gfx_draw_string_left(dpi, STR_MAX_POSITIVE_VERTICAL_G, &gForces, COLOUR_BLACK, screenPos);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Maximum negative vertical Gs
-            gForces = _loadedTrackDesign->max_negative_vertical_g * 32;
+            gForces = stats.max_negative_vertical_g * 32;
             gfx_draw_string_left(dpi, STR_MAX_NEGATIVE_VERTICAL_G, &gForces, COLOUR_BLACK, screenPos);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Maximum lateral Gs
-            gForces = _loadedTrackDesign->max_lateral_g * 32;
+            gForces = stats.max_lateral_g * 32;
             gfx_draw_string_left(dpi, STR_MAX_LATERAL_G, &gForces, COLOUR_BLACK, screenPos);
             screenPos.y += LIST_ROW_HEIGHT;
 
-            if (_loadedTrackDesign->total_air_time != 0)
+            if (stats.total_air_time != 0)
             {
                 // Total air time
-                int32_t airTime = _loadedTrackDesign->total_air_time * 25;
+                int32_t airTime = stats.total_air_time * 25;
                 gfx_draw_string_left(dpi, STR_TOTAL_AIR_TIME, &airTime, COLOUR_BLACK, screenPos);
                 screenPos.y += LIST_ROW_HEIGHT;
             }
         }
 
-        if (ride_type_has_flag(_loadedTrackDesign->type, RIDE_TYPE_FLAG_HAS_DROPS))
+        if (ride_type_has_flag(rideType, RIDE_TYPE_FLAG_HAS_DROPS))
         {
             // Drops
-            uint16_t drops = _loadedTrackDesign->drops & 0x3F;
+            uint16_t drops = stats.drops & 0x3F;
             gfx_draw_string_left(dpi, STR_DROPS, &drops, COLOUR_BLACK, screenPos);
             screenPos.y += LIST_ROW_HEIGHT;
 
             // Drop height is multiplied by 0.75
-            uint16_t highestDropHeight = (_loadedTrackDesign->highest_drop_height * 3) / 4;
+            uint16_t highestDropHeight = (stats.highest_drop_height * 3) / 4;
             gfx_draw_string_left(dpi, STR_HIGHEST_DROP_HEIGHT, &highestDropHeight, COLOUR_BLACK, screenPos);
             screenPos.y += LIST_ROW_HEIGHT;
         }
 
-        if (_loadedTrackDesign->type != RIDE_TYPE_MINI_GOLF)
+        if (rideType != RIDE_TYPE_MINI_GOLF)
         {
-            uint16_t inversions = _loadedTrackDesign->inversions & 0x1F;
+            uint16_t inversions = stats.inversions & 0x1F;
             if (inversions != 0)
             {
                 // Inversions
@@ -662,17 +684,17 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
         screenPos.y += 4;
     }
 
-    if (_loadedTrackDesign->space_required_x != 0xFF)
+    if (stats.space_required_x != 0xFF)
     {
         // Space required
         ft = Formatter();
-        ft.Add<uint16_t>(_loadedTrackDesign->space_required_x);
-        ft.Add<uint16_t>(_loadedTrackDesign->space_required_y);
+        ft.Add<uint16_t>(stats.space_required_x);
+        ft.Add<uint16_t>(stats.space_required_y);
         gfx_draw_string_left(dpi, STR_TRACK_LIST_SPACE_REQUIRED, ft.Data(), COLOUR_BLACK, screenPos);
         screenPos.y += LIST_ROW_HEIGHT;
     }
 
-    if (_loadedTrackDesign->cost != 0)
+    if (_loadedTrackDesign != nullptr && _loadedTrackDesign->cost != 0)
     {
         ft = Formatter();
         ft.Add<uint32_t>(_loadedTrackDesign->cost);
@@ -771,11 +793,39 @@ static void track_list_load_designs(RideSelection item)
 
 static bool track_list_load_design_for_preview(utf8* path)
 {
-    _loadedTrackDesign = track_design_open(path);
-    if (_loadedTrackDesign != nullptr)
+    auto it = std::find_if(
+        _trackDesignPreviews.begin(), _trackDesignPreviews.end(), [path](const TrackDesignPreview& preview) {
+            return preview.Path == path && preview.SceneryToggle == gTrackDesignSceneryToggle;
+        });
+    if (it != _trackDesignPreviews.end())
+    {
+        _trackDesignPreviews.splice(_trackDesignPreviews.begin(), _trackDesignPreviews, it);
+    }
+    else
     {
-        track_design_draw_preview(_loadedTrackDesign.get(), _trackDesignPreviewPixels.data());
-        return true;
+        auto trackDesign = track_design_open(path);
+        if (trackDesign == nullptr)
+        {
+            _loadedTrackDesign = nullptr;
+            _trackDesignPreviewPixels = nullptr;
+            return false;
+        }
+
+        TrackDesignPreview preview;
+        preview.Path = path;
+        preview.SceneryToggle = gTrackDesignSceneryToggle;
+        preview.Pixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
+        track_design_draw_preview(trackDesign.get(), preview.Pixels.data());
+        preview.Design = std::move(trackDesign);
+        _trackDesignPreviews.push_front(std::move(preview));
+        if (_trackDesignPreviews.size() > TRACK_DESIGN_PREVIEW_CACHE_SIZE)
+        {
+            _trackDesignPreviews.pop_back();
+        }
     }
-    return false;
+
+    auto& preview = _trackDesignPreviews.front();
+    _loadedTrackDesign = preview.Design.get();
+    _trackDesignPreviewPixels = preview.Pixels.data();
+    return true;
 }
@@ -53,6 +53,8 @@ bool gCheatsDisableRideValueAging = false;
 bool gCheatsIgnoreResearchStatus = false;
 bool gCheatsEnableAllDrawableTrackPieces = false;
 bool gCheatsAllowTrackPlaceInvalidHeights = false;
+uint32_t gCheatsPathfindingBudget = 0;
+uint8_t gCheatsRideRatingsPerTick = 0;
 
 void CheatsReset()
 {
@@ -78,6 +80,8 @@ void CheatsReset()
     gCheatsIgnoreResearchStatus = false;
     gCheatsEnableAllDrawableTrackPieces = false;
     gCheatsAllowTrackPlaceInvalidHeights = false;
+    gCheatsPathfindingBudget = 0;
+    gCheatsRideRatingsPerTick = 0;
 }
 
 void CheatsSet(CheatType cheatType, int32_t param1 /* = 0*/, int32_t param2 /* = 0*/)
@@ -126,6 +130,8 @@ void CheatsSerialise(DataSerialiser& ds)
         CheatEntrySerialise(ds, CheatType::IgnoreResearchStatus, gCheatsIgnoreResearchStatus, count);
         CheatEntrySerialise(ds, CheatType::EnableAllDrawableTrackPieces, gCheatsEnableAllDrawableTrackPieces, count);
         CheatEntrySerialise(ds, CheatType::AllowTrackPlaceInvalidHeights, gCheatsAllowTrackPlaceInvalidHeights, count);
+        CheatEntrySerialise(ds, CheatType::PathfindingBudget, gCheatsPathfindingBudget, count);
+        CheatEntrySerialise(ds, CheatType::RideRatingsPerTick, gCheatsRideRatingsPerTick, count);
 
         // Remember current position and update count.
         uint64_t endOffset = stream.GetPosition();
@@ -213,6 +219,12 @@ void CheatsSerialise(DataSerialiser& ds)
                 case CheatType::AllowTrackPlaceInvalidHeights:
                     ds << gCheatsAllowTrackPlaceInvalidHeights;
                     break;
+                case CheatType::PathfindingBudget:
+                    ds << gCheatsPathfindingBudget;
+                    break;
+                case CheatType::RideRatingsPerTick:
+                    ds << gCheatsRideRatingsPerTick;
+                    break;
                 default:
                     break;
             }
@@ -318,6 +330,10 @@ const char* CheatsGetName(CheatType cheatType)
             return language_get_string(STR_CHEAT_ENABLE_ALL_DRAWABLE_TRACK_PIECES);
         case CheatType::AllowTrackPlaceInvalidHeights:
             return language_get_string(STR_CHEAT_ALLOW_TRACK_PLACE_INVALID_HEIGHTS);
+        case CheatType::PathfindingBudget:
+            return language_get_string(STR_CHEAT_PATHFINDING_BUDGET);
+        case CheatType::RideRatingsPerTick:
+            return language_get_string(STR_CHEAT_RIDE_RATINGS_PER_TICK);
         default:
             return "Unknown Cheat";
     }
@@ -34,6 +34,10 @@ extern bool gCheatsAllowArbitraryRideTypeChanges;
 extern bool gCheatsIgnoreResearchStatus;
 extern bool gCheatsEnableAllDrawableTrackPieces;
 extern bool gCheatsAllowTrackPlaceInvalidHeights;
+// The number of tiles guests may search for rides in a tick, 0 for no limit.
+extern uint32_t gCheatsPathfindingBudget;
+// The number of rides rated in full every tick, 0 to advance the ratings by a single step per tick.
+extern uint8_t gCheatsRideRatingsPerTick;
 
 enum class CheatType : int32_t
 {
@@ -87,6 +91,8 @@ enum class CheatType : int32_t
     CreateDucks,
     RemoveDucks,
     AllowTrackPlaceInvalidHeights,
+    PathfindingBudget,
+    RideRatingsPerTick,
     Count,
 };
 
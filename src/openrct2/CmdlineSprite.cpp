@@ -13,8 +13,12 @@
 
 #include "Context.h"
 #include "OpenRCT2.h"
+#include "core/File.h"
 #include "core/Imaging.h"
 #include "core/Json.hpp"
+#include "core/MemoryStream.h"
+#include "core/String.hpp"
+#include "core/TaskScheduler.h"
 #include "drawing/Drawing.h"
 #include "drawing/ImageImporter.h"
 #include "object/ObjectLimits.h"
@@ -24,13 +28,11 @@
 #include "util/Util.h"
 #include "world/Entrance.h"
 #include "world/Scenery.h"
+#include "zlib.h"
 
 #include <cmath>
 #include <cstring>
-
-#ifdef _WIN32
-#    include "core/String.hpp"
-#endif
+#include <unordered_map>
 
 using namespace OpenRCT2::Drawing;
 
@@ -238,37 +240,175 @@ static bool sprite_file_export(rct_g1_element* spriteHeader, const char* outPath
     }
 }
 
+static ImageImporter::ImportResult sprite_import_image(
+    const Image& image, int16_t x_offset, int16_t y_offset, bool keep_palette, bool forceBmp, int32_t mode)
+{
+    auto flags = ImageImporter::IMPORT_FLAGS::NONE;
+    if (!forceBmp)
+    {
+        flags = ImageImporter::IMPORT_FLAGS::RLE;
+    }
+
+    if (keep_palette)
+    {
+        flags = static_cast<ImageImporter::IMPORT_FLAGS>(flags | ImageImporter::IMPORT_FLAGS::KEEP_PALETTE);
+    }
+
+    ImageImporter importer;
+    return importer.Import(image, x_offset, y_offset, flags, static_cast<ImageImporter::IMPORT_MODE>(mode));
+}
+
 static std::optional<ImageImporter::ImportResult> sprite_file_import(
     const char* path, int16_t x_offset, int16_t y_offset, bool keep_palette, bool forceBmp, int32_t mode)
 {
     try
     {
-        auto format = IMAGE_FORMAT::PNG_32;
-        auto flags = ImageImporter::IMPORT_FLAGS::NONE;
+        auto image = Imaging::ReadFromFile(path, keep_palette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32);
+        return sprite_import_image(image, x_offset, y_offset, keep_palette, forceBmp, mode);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return std::nullopt;
+    }
+}
+
+static constexpr uint32_t SPRITE_BUILD_CACHE_MAGIC = 0x43425053; // SPBC
+// Increase whenever the format changes, or importing images changes what they encode to
+static constexpr uint16_t SPRITE_BUILD_CACHE_VERSION = 1;
+static constexpr auto SPRITE_BUILD_CACHE_EXTENSION = ".buildcache";
 
-        if (!forceBmp)
+struct SpriteBuildEntry
+{
+    std::string ImagePath;
+    int16_t XOffset{};
+    int16_t YOffset{};
+    bool KeepPalette{};
+    bool ForceBmp{};
+
+    // Set when the image has been imported, or taken from the build cache
+    std::string CacheKey;
+    std::optional<ImageImporter::ImportResult> Result;
+    std::string Error;
+};
+
+using SpriteBuildCache = std::unordered_map<std::string, ImageImporter::ImportResult>;
+
+/**
+ * Returns a key for the contents of the image and the way it is imported, images with the same key encode the same.
+ */
+static std::string sprite_build_get_key(const std::vector<uint8_t>& data, const SpriteBuildEntry& entry, int32_t mode)
+{
+    auto crc = crc32(crc32(0, nullptr, 0), data.data(), static_cast<uInt>(data.size()));
+    auto adler = adler32(adler32(0, nullptr, 0), data.data(), static_cast<uInt>(data.size()));
+    return String::StdFormat(
+        "%08x%08x%llx:%d:%d:%d:%d:%d", static_cast<uint32_t>(crc), static_cast<uint32_t>(adler),
+        static_cast<unsigned long long>(data.size()), entry.XOffset, entry.YOffset, entry.KeepPalette ? 1 : 0,
+        entry.ForceBmp ? 1 : 0, mode);
+}
+
+static SpriteBuildCache sprite_build_cache_load(const std::string& path)
+{
+    SpriteBuildCache cache;
+    if (!File::Exists(path))
+    {
+        return cache;
+    }
+    try
+    {
+        auto data = File::ReadAllBytes(path);
+        auto stream = OpenRCT2::MemoryStream(data.data(), data.size());
+        if (stream.ReadValue<uint32_t>() != SPRITE_BUILD_CACHE_MAGIC
+            || stream.ReadValue<uint16_t>() != SPRITE_BUILD_CACHE_VERSION)
         {
-            flags = ImageImporter::IMPORT_FLAGS::RLE;
+            return cache;
         }
 
-        if (keep_palette)
+        auto numEntries = stream.ReadValue<uint32_t>();
+        for (uint32_t i = 0; i < numEntries; i++)
         {
-            format = IMAGE_FORMAT::PNG;
-            flags = static_cast<ImageImporter::IMPORT_FLAGS>(flags | ImageImporter::IMPORT_FLAGS::KEEP_PALETTE);
+            auto key = stream.ReadStdString();
+            ImageImporter::ImportResult result;
+            result.Element.width = stream.ReadValue<int16_t>();
+            result.Element.height = stream.ReadValue<int16_t>();
+            result.Element.x_offset = stream.ReadValue<int16_t>();
+            result.Element.y_offset = stream.ReadValue<int16_t>();
+            result.Element.flags = stream.ReadValue<uint16_t>();
+            result.Element.zoomed_offset = stream.ReadValue<int32_t>();
+            result.Buffer.resize(stream.ReadValue<uint32_t>());
+            stream.Read(result.Buffer.data(), result.Buffer.size());
+            cache.emplace(std::move(key), std::move(result));
         }
+    }
+    catch (const std::exception& e)
+    {
+        // Whatever could be read is still fine to use
+        fprintf(stderr, "Unable to read sprite build cache: %s\n", e.what());
+    }
+    return cache;
+}
 
-        ImageImporter importer;
-        auto image = Imaging::ReadFromFile(path, format);
+static void sprite_build_cache_save(const std::string& path, const std::vector<SpriteBuildEntry>& entries)
+{
+    OpenRCT2::MemoryStream stream;
+    stream.WriteValue(SPRITE_BUILD_CACHE_MAGIC);
+    stream.WriteValue(SPRITE_BUILD_CACHE_VERSION);
+    stream.WriteValue(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries)
+    {
+        const auto& element = entry.Result->Element;
+        stream.WriteString(entry.CacheKey);
+        stream.WriteValue(element.width);
+        stream.WriteValue(element.height);
+        stream.WriteValue(element.x_offset);
+        stream.WriteValue(element.y_offset);
+        stream.WriteValue(element.flags);
+        stream.WriteValue(element.zoomed_offset);
+        stream.WriteValue(static_cast<uint32_t>(entry.Result->Buffer.size()));
+        stream.Write(entry.Result->Buffer.data(), entry.Result->Buffer.size());
+    }
 
-        return importer.Import(image, x_offset, y_offset, flags, static_cast<ImageImporter::IMPORT_MODE>(mode));
+    try
+    {
+        File::WriteAllBytes(path, stream.GetData(), static_cast<size_t>(stream.GetLength()));
     }
     catch (const std::exception& e)
     {
-        fprintf(stderr, "%s\n", e.what());
-        return std::nullopt;
+        fprintf(stderr, "Unable to write sprite build cache: %s\n", e.what());
     }
 }
 
+/**
+ * Imports the images of the entries on the task scheduler, images that are in the cache are taken from there.
+ */
+static void sprite_build_import(std::vector<SpriteBuildEntry>& entries, const SpriteBuildCache& cache, int32_t mode)
+{
+    TaskScheduler::GetGlobal().ParallelFor(0, entries.size(), 0, [&entries, &cache, mode](size_t i) {
+        auto& entry = entries[i];
+        try
+        {
+            auto data = File::ReadAllBytes(entry.ImagePath);
+            entry.CacheKey = sprite_build_get_key(data, entry, mode);
+            auto it = cache.find(entry.CacheKey);
+            if (it != cache.end())
+            {
+                entry.Result = it->second;
+            }
+            else
+            {
+                auto image = Imaging::ReadFromBuffer(data, entry.KeepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32);
+                entry.Result = sprite_import_image(
+                    image, entry.XOffset, entry.YOffset, entry.KeepPalette, entry.ForceBmp, mode);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            entry.Result = std::nullopt;
+            entry.Error = e.what();
+        }
+    });
+}
+
 int32_t cmdline_for_sprite(const char** argv, int32_t argc)
 {
     gOpenRCT2Headless = true;
@@ -696,7 +836,7 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
 
         fprintf(stdout, "Building: %s\n", spriteFilePath);
 
-        json_t sprite_description;
+        std::vector<SpriteBuildEntry> entries;
 
         // Note: jsonSprite is deliberately left non-const: json_t behaviour changes when const
         for (auto& [jsonKey, jsonSprite] : jsonSprites.items())
@@ -721,52 +861,61 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
             bool keep_palette = Json::GetString(jsonSprite["palette"]) == "keep";
             bool forceBmp = !jsonSprite["palette"].is_null() && Json::GetBoolean(jsonSprite["forceBmp"]);
 
-            auto imagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+            SpriteBuildEntry entry;
+            entry.ImagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+            entry.XOffset = Json::GetNumber<int16_t>(x_offset);
+            entry.YOffset = Json::GetNumber<int16_t>(y_offset);
+            entry.KeepPalette = keep_palette;
+            entry.ForceBmp = forceBmp;
+            entries.push_back(std::move(entry));
+        }
 
-            auto importResult = sprite_file_import(
-                imagePath.c_str(), Json::GetNumber<int16_t>(x_offset), Json::GetNumber<int16_t>(y_offset), keep_palette,
-                forceBmp, gSpriteMode);
-            if (importResult == std::nullopt)
-            {
-                fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath.c_str());
-                return -1;
-            }
+        free(directoryPath);
 
-            if (!sprite_file_open(spriteFilePath))
+        // Images are imported in parallel, then added to the sprite file in the order they were described in
+        auto cachePath = std::string(spriteFilePath) + SPRITE_BUILD_CACHE_EXTENSION;
+        sprite_build_import(entries, sprite_build_cache_load(cachePath), gSpriteMode);
+
+        size_t totalSize = 0;
+        for (const auto& entry : entries)
+        {
+            if (entry.Result == std::nullopt)
             {
-                fprintf(stderr, "Unable to open sprite file: %s\nCanceling\n", spriteFilePath);
+                fprintf(stderr, "%s\n", entry.Error.c_str());
+                fprintf(stderr, "Could not import image file: %s\nCanceling\n", entry.ImagePath.c_str());
                 return -1;
             }
+            totalSize += entry.Result->Buffer.size();
+        }
 
-            spriteFileHeader.num_entries++;
-            spriteFileHeader.total_size += static_cast<uint32_t>(importResult->Buffer.size());
-            spriteFileEntries = static_cast<rct_g1_element*>(
-                realloc(spriteFileEntries, spriteFileHeader.num_entries * sizeof(rct_g1_element)));
-
-            sprite_entries_make_relative();
-            spriteFileData = static_cast<uint8_t*>(realloc(spriteFileData, spriteFileHeader.total_size));
-            sprite_entries_make_absolute();
-
-            spriteFileEntries[spriteFileHeader.num_entries - 1] = importResult->Element;
-
-            const auto& buffer = importResult->Buffer;
-            std::memcpy(spriteFileData + (spriteFileHeader.total_size - buffer.size()), buffer.data(), buffer.size());
-            spriteFileEntries[spriteFileHeader.num_entries - 1].offset = spriteFileData
-                + (spriteFileHeader.total_size - buffer.size());
+        spriteFileHeader.num_entries = static_cast<uint32_t>(entries.size());
+        spriteFileHeader.total_size = static_cast<uint32_t>(totalSize);
+        spriteFileEntries = static_cast<rct_g1_element*>(
+            malloc(std::max<size_t>(1, entries.size()) * sizeof(rct_g1_element)));
+        spriteFileData = static_cast<uint8_t*>(malloc(std::max<size_t>(1, totalSize)));
 
-            if (!sprite_file_save(spriteFilePath))
-            {
-                fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", imagePath.c_str());
-                return -1;
-            }
+        size_t offset = 0;
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            const auto& buffer = entries[i].Result->Buffer;
+            std::memcpy(spriteFileData + offset, buffer.data(), buffer.size());
+            spriteFileEntries[i] = entries[i].Result->Element;
+            spriteFileEntries[i].offset = spriteFileData + offset;
+            offset += buffer.size();
 
             if (!silent)
-                fprintf(stdout, "Added: %s\n", imagePath.c_str());
+                fprintf(stdout, "Added: %s\n", entries[i].ImagePath.c_str());
+        }
 
-            sprite_file_close();
+        bool saved = sprite_file_save(spriteFilePath);
+        sprite_file_close();
+        if (!saved)
+        {
+            fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", spriteFilePath);
+            return -1;
         }
 
-        free(directoryPath);
+        sprite_build_cache_save(cachePath, entries);
 
         fprintf(stdout, "Finished\n");
         return 1;
@@ -17,12 +17,18 @@
 #include "Game.h"
 #include "GameState.h"
 #include "GameStateSnapshots.h"
+#include "HitchTracker.h"
 #include "Input.h"
 #include "Intro.h"
+#include "MemoryReport.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
 #include "PlatformEnvironment.h"
+#include "Profiling.h"
 #include "ReplayManager.h"
+#include "RepositoryWatcher.h"
+#include "StartupTrace.h"
+#include "TickProfiler.h"
 #include "Version.h"
 #include "actions/GameAction.h"
 #include "audio/AudioContext.h"
@@ -37,6 +43,8 @@
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
+#include "core/TaskScheduler.h"
+#include "drawing/FrameProfiler.h"
 #include "drawing/IDrawingEngine.h"
 #include "drawing/LightFX.h"
 #include "interface/Chat.h"
@@ -53,6 +61,7 @@
 #include "platform/Crash.h"
 #include "platform/Platform2.h"
 #include "platform/platform.h"
+#include "rct2/S6Delta.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/Scenario.h"
 #include "scenario/ScenarioRepository.h"
@@ -66,12 +75,14 @@
 #include "world/Park.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <exception>
 #include <future>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <thread>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Audio;
@@ -97,6 +108,7 @@ namespace OpenRCT2
         std::unique_ptr<IObjectManager> _objectManager;
         std::unique_ptr<ITrackDesignRepository> _trackDesignRepository;
         std::unique_ptr<IScenarioRepository> _scenarioRepository;
+        std::unique_ptr<RepositoryWatcher> _repositoryWatcher;
         std::unique_ptr<IReplayManager> _replayManager;
         std::unique_ptr<IGameStateSnapshots> _gameStateSnapshots;
 #ifdef __ENABLE_DISCORD__
@@ -114,6 +126,8 @@ namespace OpenRCT2
         DrawingEngine _drawingEngineType = DrawingEngine::Software;
         std::unique_ptr<IDrawingEngine> _drawingEngine;
         std::unique_ptr<Painter> _painter;
+        // The glyph metrics and bitmaps of the sprite font, computed while the rest of the context initialises
+        TaskGroup _fontInitTask;
 
         bool _initialised = false;
         bool _isWindowMinimised = false;
@@ -122,6 +136,15 @@ namespace OpenRCT2
         uint32_t _lastUpdateTime = 0;
         bool _variableFrame = false;
 
+        // The tick loop of headless servers, which counts the ticks that took too long for the periodic report
+        bool _headlessLoopStarted = false;
+        std::chrono::steady_clock::time_point _nextHeadlessTick;
+        std::chrono::steady_clock::time_point _headlessReportTime;
+        uint32_t _headlessTicks = 0;
+        uint32_t _headlessTickOverruns = 0;
+        uint32_t _headlessTicksDropped = 0;
+        std::chrono::steady_clock::duration _headlessLongestTick{};
+
         // If set, will end the OpenRCT2 game loop. Intentially private to this module so that the flag can not be set back to
         // false.
         bool _finished = false;
@@ -162,6 +185,7 @@ namespace OpenRCT2
 
             GameActions::ClearQueue();
             network_close();
+            scenario_autosave_wait();
             window_close_all();
 
             // Unload objects after closing all windows, this is to overcome windows like
@@ -171,6 +195,7 @@ namespace OpenRCT2
                 _objectManager->UnloadAll();
             }
 
+            scrolling_text_dispose_bitmaps();
             gfx_object_check_all_images_freed();
             gfx_unload_g2();
             gfx_unload_g1();
@@ -258,11 +283,17 @@ namespace OpenRCT2
 
         int32_t RunOpenRCT2(int argc, const char** argv) override
         {
-            if (Initialise())
+            bool initialised;
+            {
+                StartupTraceSpan span("Initialise");
+                initialised = Initialise();
+            }
+            if (initialised)
             {
                 Launch();
                 return EXIT_SUCCESS;
             }
+            startup_trace_finish();
             return EXIT_FAILURE;
         }
 
@@ -338,6 +369,7 @@ namespace OpenRCT2
             _initialised = true;
 
             crash_init();
+            hitch_tracker_set_threshold(static_cast<uint32_t>(std::max(gConfigGeneral.hitch_log_threshold, 0)));
 
             if (gConfigGeneral.last_run_version != nullptr && String::Equals(gConfigGeneral.last_run_version, OPENRCT2_VERSION))
             {
@@ -352,6 +384,7 @@ namespace OpenRCT2
 
             try
             {
+                StartupTraceSpan span("OpenLanguage");
                 _localisationService->OpenLanguage(gConfigGeneral.language);
             }
             catch (const std::exception& e)
@@ -359,6 +392,7 @@ namespace OpenRCT2
                 log_error("Failed to open configured language: %s", e.what());
                 try
                 {
+                    StartupTraceSpan span("OpenLanguage (fallback)");
                     _localisationService->OpenLanguage(LANGUAGE_ENGLISH_UK);
                 }
                 catch (const std::exception& eFallback)
@@ -425,6 +459,7 @@ namespace OpenRCT2
 
             if (!gOpenRCT2Headless)
             {
+                StartupTraceSpan span("CreateWindow");
                 _uiContext->CreateWindow();
             }
 
@@ -433,18 +468,33 @@ namespace OpenRCT2
             // TODO Ideally we want to delay this until we show the title so that we can
             //      still open the game window and draw a progress screen for the creation
             //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
+            {
+                StartupTraceSpan span("ObjectRepository::LoadOrConstruct");
+                _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
+            }
 
             // TODO Like objects, this can take a while if there are a lot of track designs
             //      its also really something really we might want to do in the background
             //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
+            {
+                StartupTraceSpan span("TrackDesignRepository::Scan");
+                _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
+            }
+
+            if (gConfigGeneral.watch_content_directories)
+            {
+                _repositoryWatcher = std::make_unique<RepositoryWatcher>(
+                    *_env, *_objectRepository, *_trackDesignRepository, *_scenarioRepository);
+            }
 
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
+            {
+                StartupTraceSpan span("TitleSequenceManager::Scan");
+                TitleSequenceManager::Scan();
+            }
 
             if (!gOpenRCT2Headless)
             {
+                StartupTraceSpan span("Audio");
                 Init();
                 PopulateDevices();
                 InitRideSoundsAndInfo();
@@ -453,7 +503,10 @@ namespace OpenRCT2
 
             network_set_env(_env);
             chat_init();
-            CopyOriginalUserFilesOver();
+            {
+                StartupTraceSpan span("CopyOriginalUserFilesOver");
+                CopyOriginalUserFilesOver();
+            }
 
             if (!gOpenRCT2NoGraphics)
             {
@@ -470,11 +523,18 @@ namespace OpenRCT2
             input_reset_place_obj_modifier();
             viewport_init_all();
 
-            _gameState = std::make_unique<GameState>();
-            _gameState->InitAll(150);
+            {
+                StartupTraceSpan span("GameState::InitAll");
+                _gameState = std::make_unique<GameState>();
+                _gameState->InitAll(150);
+            }
 
+            TaskScheduler::GetGlobal().Wait(_fontInitTask);
             _titleScreen = std::make_unique<TitleScreen>(*_gameState);
-            _uiContext->Initialise();
+            {
+                StartupTraceSpan span("UiContext::Initialise");
+                _uiContext->Initialise();
+            }
 
             return true;
         }
@@ -546,6 +606,7 @@ namespace OpenRCT2
 
         bool LoadParkFromFile(const std::string& path, bool loadTitleScreenOnFail) final override
         {
+            StartupTraceSpan span("LoadParkFromFile");
             log_verbose("Context::LoadParkFromFile(%s)", path.c_str());
             try
             {
@@ -559,6 +620,17 @@ namespace OpenRCT2
                     }
                     return true;
                 }
+                else if (String::Equals(Path::GetExtension(path), S6_DELTA_EXTENSION, true))
+                {
+                    // Saving the park again writes a regular saved game next to the delta
+                    auto ms = S6Delta::Reconstruct(path);
+                    auto savePath = Path::Combine(Path::GetDirectory(path), Path::GetFileNameWithoutExtension(path) + ".sv6");
+                    if (!LoadParkFromStream(ms.get(), savePath, loadTitleScreenOnFail))
+                    {
+                        throw std::runtime_error("Failed to load park");
+                    }
+                    return true;
+                }
                 else
                 {
                     auto fs = FileStream(path, FILE_MODE_OPEN);
@@ -584,6 +656,7 @@ namespace OpenRCT2
 
         bool LoadParkFromStream(IStream* stream, const std::string& path, bool loadTitleScreenFirstOnFail) final override
         {
+            PROFILE_ZONE("Context::LoadParkFromStream");
             try
             {
                 ClassifiedFileInfo info;
@@ -724,13 +797,19 @@ namespace OpenRCT2
 
         bool LoadBaseGraphics()
         {
+            StartupTraceSpan span("LoadBaseGraphics");
             if (!gfx_load_g1(*_env))
             {
                 return false;
             }
             gfx_load_g2();
+
+            // Only needs the glyphs of g1 and g2, Initialise waits for it before the UI is set up
+            TaskScheduler::GetGlobal().Schedule(_fontInitTask, []() {
+                StartupTraceSpan fontSpan("font_sprite_initialise_characters");
+                font_sprite_initialise_characters();
+            });
             gfx_load_csg();
-            font_sprite_initialise_characters();
             return true;
         }
 
@@ -767,6 +846,7 @@ namespace OpenRCT2
                 }
             }
 
+            auto launchSpan = std::make_unique<StartupTraceSpan>("Launch");
             switch (gOpenRCT2StartupAction)
             {
                 case StartupAction::Intro:
@@ -871,10 +951,33 @@ namespace OpenRCT2
                 {
                     gNetworkStartPort = gConfigNetwork.default_port;
                 }
-                network_begin_client(gNetworkStartHost, gNetworkStartPort);
+                if (gNetworkStartRelayPort != 0)
+                {
+                    if (gNetworkStartAddress.empty())
+                    {
+                        gNetworkStartAddress = gConfigNetwork.listen_address;
+                    }
+                    network_set_password(gConfigNetwork.default_password.c_str());
+                    network_begin_relay(gNetworkStartHost, gNetworkStartPort, gNetworkStartRelayPort, gNetworkStartAddress);
+                }
+                else
+                {
+                    network_begin_client(gNetworkStartHost, gNetworkStartPort);
+                }
             }
 #endif // DISABLE_NETWORK
 
+            // Scenarios are otherwise scanned on first use, scanning now keeps the scenario index up to date for when the
+            // scenario list is opened. Headless servers only scan them if they are ever needed.
+            if (!gOpenRCT2Headless)
+            {
+                _scenarioRepository->ScanInBackground(_localisationService->GetCurrentLanguage());
+            }
+
+            // The trace ends where the game loop starts
+            launchSpan = nullptr;
+            startup_trace_finish();
+
             _stdInOutConsole.Start();
             RunGameLoop();
         }
@@ -919,6 +1022,17 @@ namespace OpenRCT2
 
         void RunFrame()
         {
+            if (gOpenRCT2Headless)
+            {
+                RunHeadlessFrame();
+                return;
+            }
+            if (game_is_turbo())
+            {
+                RunTurboFrame();
+                return;
+            }
+
             // Make sure we catch the state change and reset it.
             bool useVariableFrame = ShouldRunVariableFrame();
             if (_variableFrame != useVariableFrame)
@@ -966,9 +1080,98 @@ namespace OpenRCT2
 
             if (!_isWindowMinimised && !gOpenRCT2Headless)
             {
-                _drawingEngine->BeginDraw();
-                _painter->Paint(*_drawingEngine);
-                _drawingEngine->EndDraw();
+                DrawFrame();
+                _drawingEngine->UpdateWindows();
+            }
+        }
+
+        /**
+         * Runs the game ticks of a headless server at a fixed rate. There is nothing to draw, so rather than polling the
+         * millisecond timer every frame the loop sleeps until the next tick is due.
+         */
+        void RunHeadlessFrame()
+        {
+            using clock = std::chrono::steady_clock;
+            constexpr auto tickDuration = std::chrono::milliseconds(GAME_UPDATE_TIME_MS);
+
+            auto now = clock::now();
+            if (!_headlessLoopStarted)
+            {
+                _headlessLoopStarted = true;
+                _nextHeadlessTick = now;
+                _headlessReportTime = now;
+            }
+            if (now < _nextHeadlessTick)
+            {
+                std::this_thread::sleep_until(_nextHeadlessTick);
+                return;
+            }
+
+            _uiContext->ProcessMessages();
+
+            // A server that fell far behind drops the ticks it missed rather than running them all at once
+            auto ticksBehind = static_cast<uint32_t>((now - _nextHeadlessTick) / tickDuration);
+            if (ticksBehind >= GAME_MAX_UPDATES)
+            {
+                _headlessTicksDropped += ticksBehind - (GAME_MAX_UPDATES - 1);
+                _nextHeadlessTick = now - tickDuration * (GAME_MAX_UPDATES - 1);
+            }
+
+            while (_nextHeadlessTick <= now && !_finished)
+            {
+                auto updateStart = clock::now();
+                Update();
+                auto updateTime = clock::now() - updateStart;
+
+                _headlessTicks++;
+                if (updateTime > tickDuration)
+                {
+                    _headlessTickOverruns++;
+                }
+                _headlessLongestTick = std::max(_headlessLongestTick, updateTime);
+                _nextHeadlessTick += tickDuration;
+            }
+
+            if (now - _headlessReportTime >= std::chrono::minutes(1))
+            {
+                if (_headlessTickOverruns != 0 || _headlessTicksDropped != 0)
+                {
+                    auto longestTick = std::chrono::duration_cast<std::chrono::milliseconds>(_headlessLongestTick).count();
+                    log_warning(
+                        "Server is running behind, %u of %u ticks in the last minute took longer than %d ms (longest %d ms), "
+                        "%u ticks were dropped",
+                        _headlessTickOverruns, _headlessTicks, GAME_UPDATE_TIME_MS, static_cast<int32_t>(longestTick),
+                        _headlessTicksDropped);
+                }
+                if (tick_profiler_is_enabled())
+                {
+                    log_info("Tick profile: %s", tick_profiler_get_summary().c_str());
+                }
+                log_verbose("Memory usage: %s", memory_report_get_summary().c_str());
+                _headlessReportTime = now;
+                _headlessTicks = 0;
+                _headlessTickOverruns = 0;
+                _headlessTicksDropped = 0;
+                _headlessLongestTick = {};
+            }
+        }
+
+        /**
+         * Runs ticks for GAME_TURBO_FRAME_TIME_MS, then draws a single frame. The simulation is not held back by the
+         * frame rate, the windows, viewports and input are only updated about ten times a second.
+         */
+        void RunTurboFrame()
+        {
+            _uiContext->ProcessMessages();
+            Update();
+
+            // Start over from the current time once turbo mode ends, the ticks run here are not owed to the normal loop
+            _lastTick = 0;
+            _accumulator = 0;
+
+            if (!_isWindowMinimised)
+            {
+                DrawFrame();
                 _drawingEngine->UpdateWindows();
             }
         }
@@ -1011,9 +1214,7 @@ namespace OpenRCT2
                 const float alpha = std::min(static_cast<float>(_accumulator) / GAME_UPDATE_TIME_MS, 1.0f);
                 sprite_position_tween_all(alpha);
 
-                _drawingEngine->BeginDraw();
-                _painter->Paint(*_drawingEngine);
-                _drawingEngine->EndDraw();
+                DrawFrame();
 
                 sprite_position_tween_restore();
 
@@ -1025,8 +1226,27 @@ namespace OpenRCT2
             }
         }
 
+        void DrawFrame()
+        {
+            PROFILE_ZONE("Context::DrawFrame");
+            hitch_tracker_begin_frame();
+            frame_profiler_begin_frame();
+            sprite_flush_invalidations();
+            _drawingEngine->BeginDraw();
+            _painter->Paint(*_drawingEngine);
+            {
+                FramePhaseTimer timer(FramePhase::EndDraw);
+                _drawingEngine->EndDraw();
+            }
+            frame_profiler_end_frame();
+            hitch_tracker_end_frame();
+            PROFILE_FRAME();
+        }
+
         void Update()
         {
+            PROFILE_ZONE("Context::Update");
+            hitch_tracker_begin_update();
             uint32_t currentUpdateTime = platform_get_ticks();
 
             gCurrentDeltaTime = std::min<uint32_t>(currentUpdateTime - _lastUpdateTime, 500);
@@ -1063,8 +1283,15 @@ namespace OpenRCT2
 #ifdef ENABLE_SCRIPTING
             _scriptEngine.Update();
 #endif
+            if (_repositoryWatcher != nullptr)
+            {
+                _repositoryWatcher->Update();
+            }
             _stdInOutConsole.ProcessEvalQueue();
             _uiContext->Update();
+            sprite_flush_invalidations();
+            memory_report_update();
+            hitch_tracker_end_update();
         }
 
         /**
@@ -169,6 +169,8 @@ enum
     GAME_MAX_UPDATES = 4,
     // The maximum threshold to advance.
     GAME_UPDATE_MAX_THRESHOLD = GAME_UPDATE_TIME_MS * GAME_MAX_UPDATES,
+    // How long the game runs ticks in turbo mode before a frame is drawn and the input is handled
+    GAME_TURBO_FRAME_TIME_MS = 100,
 };
 
 /**
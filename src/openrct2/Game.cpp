@@ -40,6 +40,7 @@
 #include "peep/Staff.h"
 #include "platform/Platform2.h"
 #include "rct1/RCT1.h"
+#include "rct2/S6Delta.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
 #include "ride/Station.h"
@@ -74,6 +75,7 @@
 uint16_t gCurrentDeltaTime;
 uint8_t gGamePaused = 0;
 int32_t gGameSpeed = 1;
+bool gGameTurbo = false;
 bool gDoSingleUpdate = false;
 float gDayNightCycle = 0;
 bool gInUpdateCode = false;
@@ -93,6 +95,7 @@ using namespace OpenRCT2;
 void game_reset_speed()
 {
     gGameSpeed = 1;
+    gGameTurbo = false;
     window_invalidate_by_class(WC_TOP_TOOLBAR);
 }
 
@@ -112,6 +115,16 @@ void game_reduce_game_speed()
     window_invalidate_by_class(WC_TOP_TOOLBAR);
 }
 
+/**
+ * Whether the game runs as many ticks as it can rather than at a fixed rate. Only single player games that are not
+ * paused run in turbo mode, network games have to keep to the rate of the server.
+ */
+bool game_is_turbo()
+{
+    return gGameTurbo && network_get_mode() == NETWORK_MODE_NONE && game_is_not_paused()
+        && gScreenFlags == SCREEN_FLAGS_PLAYING;
+}
+
 /**
  *
  *  rct2: 0x0066B5C0 (part of 0x0066B3E8)
@@ -550,6 +563,7 @@ void game_load_init()
     snapshots->Reset();
 
     gScreenFlags = SCREEN_FLAGS_PLAYING;
+    gGameTurbo = false;
     OpenRCT2::Audio::StopAll();
     if (!gLoadKeepWindowsOpen)
     {
@@ -571,6 +585,7 @@ void game_load_init()
         GameActions::ClearQueue();
     }
     reset_sprite_spatial_index();
+    reset_entity_hot_data();
     scenery_set_default_placement_configuration();
 
     auto intent = Intent(INTENT_ACTION_REFRESH_NEW_RIDES);
@@ -612,7 +627,7 @@ void game_unload_scripts()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* spr = GetEntity(i);
         if (spr != nullptr && spr->sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -681,6 +696,31 @@ void save_game_as()
     delete intent;
 }
 
+/**
+ * Deletes the autosave deltas that were written before the autosave with the given name, or all of them if empty.
+ */
+static void delete_stale_autosave_deltas(const std::string& folderDirectory, const std::string& oldestKept)
+{
+    auto autosaveDirectory = Path::Combine(folderDirectory, "autosave");
+    auto filter = Path::Combine(autosaveDirectory, std::string("autosave_*") + S6_DELTA_EXTENSION);
+    std::vector<std::string> staleDeltas;
+    {
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(filter, false));
+        while (scanner->Next())
+        {
+            std::string name = scanner->GetPathRelative();
+            if (oldestKept.empty() || Path::GetFileNameWithoutExtension(name) < oldestKept)
+            {
+                staleDeltas.push_back(Path::Combine(autosaveDirectory, name));
+            }
+        }
+    }
+    for (const auto& path : staleDeltas)
+    {
+        platform_file_delete(path.c_str());
+    }
+}
+
 static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processLandscapeFolder)
 {
     size_t autosavesCount = 0;
@@ -741,10 +781,30 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
     {
         platform_file_delete(autosaveFiles[i].data());
     }
+
+    if (!processLandscapeFolder)
+    {
+        // Deltas older than the oldest remaining autosave were made against one of the deleted ones
+        std::string oldestKept;
+        if (numberOfFilesToKeep > 0)
+        {
+            // The paths are padded with null characters
+            const auto& oldestKeptPath = autosaveFiles[autosavesCount - numberOfFilesToKeep];
+            oldestKept = Path::GetFileNameWithoutExtension(std::string(oldestKeptPath.c_str()));
+        }
+        delete_stale_autosave_deltas(folderDirectory, oldestKept);
+    }
 }
 
 void game_autosave()
 {
+    // Writing the previous autosave may not have finished yet on large parks or slow disks.
+    if (scenario_autosave_is_in_progress())
+    {
+        log_warning("Skipping autosave, the previous one is still being written.");
+        return;
+    }
+
     const char* subDirectory = "save";
     const char* fileExtension = ".sv6";
     uint32_t saveFlags = 0x80000000;
@@ -754,6 +814,16 @@ void game_autosave()
         fileExtension = ".sc6";
         saveFlags |= 2;
     }
+    if (gConfigGeneral.autosave_compressed)
+    {
+        // Faster to write, but only OpenRCT2 can load the autosave
+        saveFlags |= 4;
+    }
+    if (gConfigGeneral.autosave_deltas > 0 && !(gScreenFlags & SCREEN_FLAGS_EDITOR))
+    {
+        // Most autosaves only store what changed since the last full one
+        saveFlags |= 8;
+    }
 
     // Retrieve current time
     auto currentDate = Platform::GetDateLocal();
@@ -778,13 +848,8 @@ void game_autosave()
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-    if (Platform::FileExists(path))
-    {
-        platform_file_copy(path, backupPath, true);
-    }
-
-    if (!scenario_save(path, saveFlags))
-        std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+    // The previous autosave is backed up and the new one written in the background.
+    scenario_autosave(path, backupPath, saveFlags);
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -834,6 +899,7 @@ void game_load_or_quit_no_save_prompt()
                 input_set_flag(INPUT_FLAG_5, false);
             }
             gGameSpeed = 1;
+            gGameTurbo = false;
             gFirstTimeSaving = true;
             game_unload_scripts();
             title_load();
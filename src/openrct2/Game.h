@@ -99,6 +99,7 @@ enum GAME_COMMAND
     GAME_COMMAND_GUEST_SET_FLAGS,              // GA
     GAME_COMMAND_SET_DATE,                     // GA
     GAME_COMMAND_CUSTOM,                       // GA
+    GAME_COMMAND_SCATTER_SCENERY,              // GA
     GAME_COMMAND_COUNT,
 };
 
@@ -138,6 +139,7 @@ extern uint32_t gCurrentRealTimeTicks;
 extern uint16_t gCurrentDeltaTime;
 extern uint8_t gGamePaused;
 extern int32_t gGameSpeed;
+extern bool gGameTurbo;
 extern bool gDoSingleUpdate;
 extern float gDayNightCycle;
 extern bool gInUpdateCode;
@@ -149,6 +151,7 @@ extern bool gLoadKeepWindowsOpen;
 void game_reset_speed();
 void game_increase_game_speed();
 void game_reduce_game_speed();
+bool game_is_turbo();
 
 void game_create_windows();
 void reset_all_sprite_quadrant_placements();
@@ -15,7 +15,9 @@
 #include "GameStateSnapshots.h"
 #include "Input.h"
 #include "OpenRCT2.h"
+#include "Profiling.h"
 #include "ReplayManager.h"
+#include "TickProfiler.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
 #include "interface/Screenshot.h"
@@ -32,11 +34,13 @@
 #include "ui/UiContext.h"
 #include "windows/Intent.h"
 #include "world/Climate.h"
+#include "world/EntityScheduler.h"
 #include "world/MapAnimation.h"
 #include "world/Park.h"
 #include "world/Scenery.h"
 
 #include <algorithm>
+#include <limits>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
@@ -89,6 +93,7 @@ void GameState::Update()
 
     // Normal game play will update only once every GAME_UPDATE_TIME_MS
     uint32_t numUpdates = 1;
+    bool isTurbo = false;
 
     // 0x006E3AEC // screen_game_process_mouse_input();
     screenshot_check();
@@ -116,6 +121,12 @@ void GameState::Update()
     {
         numUpdates = std::clamp<uint32_t>(network_get_server_tick() - gCurrentTicks, 0, 10);
     }
+    else if (game_is_turbo())
+    {
+        // Turbo mode runs ticks until the time for the frame is up, see the loop below
+        isTurbo = true;
+        numUpdates = std::numeric_limits<uint32_t>::max();
+    }
     else
     {
         // Determine how many times we need to update the game
@@ -160,9 +171,14 @@ void GameState::Update()
     }
 
     // Update the game one or more times
+    auto updateStartTime = Platform::GetTicks();
     for (uint32_t i = 0; i < numUpdates; i++)
     {
         UpdateLogic();
+        if (isTurbo && (!game_is_turbo() || Platform::GetTicks() - updateStartTime >= GAME_TURBO_FRAME_TIME_MS))
+        {
+            break;
+        }
         if (gGameSpeed == 1)
         {
             if (input_get_state() == InputState::Reset || input_get_state() == InputState::Normal)
@@ -179,6 +195,10 @@ void GameState::Update()
             }
         }
     }
+    if (isTurbo)
+    {
+        UpdateSounds();
+    }
 
     if (!gOpenRCT2Headless)
     {
@@ -227,44 +247,52 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    PROFILE_ZONE("GameState::UpdateLogic");
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    GetContext()->GetReplayManager()->Update();
+    tick_profiler_begin_tick(gCurrentTicks);
+    {
+        TickPhaseTimer timer(TickPhase::Network);
+        GetContext()->GetReplayManager()->Update();
 
-    network_update();
+        network_update();
 
-    if (network_get_mode() == NETWORK_MODE_SERVER)
-    {
-        if (network_gamestate_snapshots_enabled())
+        if (network_get_mode() == NETWORK_MODE_SERVER)
         {
-            CreateStateSnapshot();
-        }
+            if (network_gamestate_snapshots_enabled())
+            {
+                CreateStateSnapshot();
+            }
 
-        // Send current tick out.
-        network_send_tick();
-    }
-    else if (network_get_mode() == NETWORK_MODE_CLIENT)
-    {
-        // Don't run past the server, this condition can happen during map changes.
-        if (network_get_server_tick() == gCurrentTicks)
-        {
-            return;
+            // Send current tick out.
+            network_send_tick();
         }
-
-        // Check desync.
-        bool desynced = network_check_desynchronisation();
-        if (desynced)
+        else if (network_get_mode() == NETWORK_MODE_CLIENT)
         {
-            // If desync debugging is enabled and we are still connected request the specific game state from server.
-            if (network_gamestate_snapshots_enabled() && network_get_status() == NETWORK_STATUS_CONNECTED)
+            // Don't run past the server, this condition can happen during map changes.
+            if (network_get_server_tick() == gCurrentTicks)
             {
-                // Create snapshot from this tick so we can compare it later
-                // as we won't pause the game on this event.
-                CreateStateSnapshot();
+                return;
+            }
+
+            // Check desync.
+            bool desynced = network_check_desynchronisation();
+            if (desynced)
+            {
+                // If desync debugging is enabled and we are still connected request the specific game state from server.
+                if (network_gamestate_snapshots_enabled() && network_get_status() == NETWORK_STATUS_CONNECTED)
+                {
+                    // Create snapshot from this tick so we can compare it later
+                    // as we won't pause the game on this event.
+                    CreateStateSnapshot();
+
+                    network_request_gamestate_snapshot();
+                }
 
-                network_request_gamestate_snapshot();
+                // Only the parts of the map that differ are sent by the server, after the game state requested above
+                network_request_resync();
             }
         }
     }
@@ -275,35 +303,73 @@ void GameState::UpdateLogic()
     auto day = _date.GetDay();
 #endif
 
-    date_update();
-    _date = Date(static_cast<uint32_t>(gDateMonthsElapsed), gDateMonthTicks);
+    {
+        TickPhaseTimer timer(TickPhase::Scenario);
+        date_update();
+        _date = Date(static_cast<uint32_t>(gDateMonthsElapsed), gDateMonthTicks);
 
-    scenario_update();
-    climate_update();
-    map_update_tiles();
+        scenario_update();
+        climate_update();
+    }
+    {
+        TickPhaseTimer timer(TickPhase::MapTiles);
+        map_update_tiles();
+    }
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
-    map_update_path_wide_flags();
-    peep_update_all();
+    {
+        TickPhaseTimer timer(TickPhase::PathWideFlags);
+        map_update_path_wide_flags();
+    }
+    {
+        TickPhaseTimer timer(TickPhase::Peeps);
+        entity_scheduler_update(EntityUpdateGroup::Peep);
+    }
     map_restore_provisional_elements();
-    vehicle_update_all();
-    sprite_misc_update_all();
-    Ride::UpdateAll();
+    {
+        TickPhaseTimer timer(TickPhase::Vehicles);
+        entity_scheduler_update(EntityUpdateGroup::Vehicle);
+    }
+    {
+        TickPhaseTimer timer(TickPhase::Misc);
+        entity_scheduler_update(EntityUpdateGroup::Misc);
+    }
+    {
+        TickPhaseTimer timer(TickPhase::Rides);
+        Ride::UpdateAll();
+    }
 
     if (!(gScreenFlags & SCREEN_FLAGS_EDITOR))
     {
+        TickPhaseTimer timer(TickPhase::Park);
         _park->Update(_date);
     }
 
-    research_update();
-    ride_ratings_update_all();
-    ride_measurements_update();
-    News::UpdateCurrentItem();
+    {
+        TickPhaseTimer timer(TickPhase::Research);
+        research_update();
+    }
+    {
+        TickPhaseTimer timer(TickPhase::RideRatings);
+        ride_ratings_update_all();
+    }
+    {
+        TickPhaseTimer timer(TickPhase::RideMeasurements);
+        ride_measurements_update();
+    }
 
-    map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+    {
+        TickPhaseTimer timer(TickPhase::Sounds);
+        News::UpdateCurrentItem();
+
+        map_animation_invalidate_all();
+
+        // Turbo mode only updates the sounds once per frame, after all its ticks
+        if (!game_is_turbo())
+        {
+            UpdateSounds();
+        }
+    }
     editor_open_windows_for_current_step();
 
     // Update windows
@@ -315,24 +381,40 @@ void GameState::UpdateLogic()
         gLastAutoSaveUpdate = Platform::GetTicks();
     }
 
-    GameActions::ProcessQueue();
+    {
+        TickPhaseTimer timer(TickPhase::GameActions);
+        GameActions::ProcessQueue();
 
-    network_process_pending();
-    network_flush();
+        network_process_pending();
+        network_flush();
+    }
 
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
 
 #ifdef ENABLE_SCRIPTING
-    auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
-    hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
-
-    if (day != _date.GetDay())
     {
-        hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
+        TickPhaseTimer timer(TickPhase::Scripting);
+        auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
+        hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+        GetContext()->GetScriptEngine().UpdateTickIntervals();
+
+        if (day != _date.GetDay())
+        {
+            hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
+        }
     }
 #endif
+
+    tick_profiler_end_tick();
+}
+
+void GameState::UpdateSounds()
+{
+    vehicle_sounds_update();
+    peep_update_crowd_noise();
+    climate_update_sound();
 }
 
 void GameState::CreateStateSnapshot()
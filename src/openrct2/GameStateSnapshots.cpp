@@ -10,12 +10,22 @@
 #include "GameStateSnapshots.h"
 
 #include "core/CircularBuffer.h"
+#include "core/File.h"
+#include "core/TaskScheduler.h"
 #include "peep/Peep.h"
+#include "util/Util.h"
 #include "world/Sprite.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
+// "GSCD" followed by the format version, see IGameStateSnapshots::WriteCompareDataToFile
+static constexpr uint32_t GameStateCompareDataMagic = 0x44435347;
+static constexpr uint16_t GameStateCompareDataVersion = 1;
+
 struct GameStateSnapshot_t
 {
     GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
@@ -31,6 +41,12 @@ struct GameStateSnapshot_t
     OpenRCT2::MemoryStream storedSprites;
     OpenRCT2::MemoryStream parkParameters;
 
+    // Once a newer snapshot has been captured the sprites are only kept as the compressed XOR against the sprites of
+    // deltaBase, which may itself be stored as a delta.
+    const GameStateSnapshot_t* deltaBase = nullptr;
+    std::vector<uint8_t> storedDelta;
+    size_t storedLength = 0;
+
     // Must pass a function that can access the sprite.
     void SerialiseSprites(std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites, bool saving)
     {
@@ -122,11 +138,35 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _linkedSnapshots.clear();
+        _lastCaptured = nullptr;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
-        auto snapshot = std::make_unique<GameStateSnapshot_t>();
+        std::unique_ptr<GameStateSnapshot_t> snapshot;
+        if (_snapshots.size() == _snapshots.capacity())
+        {
+            // Reuse the oldest snapshot, only older snapshots can use it as their delta base so nothing refers to it
+            snapshot = std::move(_snapshots.front());
+            auto it = _linkedSnapshots.find(snapshot->tick);
+            if (it != _linkedSnapshots.end() && it->second == snapshot.get())
+                _linkedSnapshots.erase(it);
+            if (_lastCaptured == snapshot.get())
+                _lastCaptured = nullptr;
+
+            snapshot->tick = InvalidTick;
+            snapshot->srand0 = 0;
+            snapshot->storedSprites.Clear();
+            snapshot->parkParameters.Clear();
+            snapshot->deltaBase = nullptr;
+            snapshot->storedDelta.clear();
+            snapshot->storedLength = 0;
+        }
+        else
+        {
+            snapshot = std::make_unique<GameStateSnapshot_t>();
+        }
         _snapshots.push_back(std::move(snapshot));
 
         return *_snapshots.back();
@@ -136,24 +176,101 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     {
         snapshot.tick = tick;
         snapshot.srand0 = srand0;
+        _linkedSnapshots[tick] = &snapshot;
     }
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
+        snapshot.storedSprites.Clear();
         snapshot.SerialiseSprites(
-            [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); }, MAX_SPRITES, true);
+            [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); }, GetEntityCapacity(),
+            true);
+
+        // Consecutive captures barely differ, so the previous one is only kept as a delta against this one
+        if (_lastCaptured != nullptr && _lastCaptured != &snapshot)
+        {
+            EncodeDelta(*_lastCaptured, snapshot);
+        }
+        _lastCaptured = &snapshot;
 
         // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
 
     virtual const GameStateSnapshot_t* GetLinkedSnapshot(uint32_t tick) const override final
     {
-        for (size_t i = 0; i < _snapshots.size(); i++)
+        auto it = _linkedSnapshots.find(tick);
+        if (it == _linkedSnapshots.end())
+            return nullptr;
+
+        const GameStateSnapshot_t* snapshot = it->second;
+        if (snapshot->deltaBase == nullptr)
+            return snapshot;
+
+        // Walk the chain up to a snapshot that is stored in full and apply the deltas back down to this one
+        std::vector<const GameStateSnapshot_t*> chain;
+        for (auto entry = snapshot; entry->deltaBase != nullptr; entry = entry->deltaBase)
         {
-            if (_snapshots[i]->tick == tick)
-                return _snapshots[i].get();
+            chain.push_back(entry);
         }
-        return nullptr;
+
+        const auto& fullSprites = chain.back()->deltaBase->storedSprites;
+        const auto* fullData = static_cast<const uint8_t*>(fullSprites.GetData());
+        std::vector<uint8_t> sprites(fullData, fullData + fullSprites.GetLength());
+        for (auto entry = chain.rbegin(); entry != chain.rend(); entry++)
+        {
+            const auto& storedDelta = (*entry)->storedDelta;
+            size_t length = (*entry)->storedLength;
+            auto delta = util_zlib_inflate(const_cast<uint8_t*>(storedDelta.data()), storedDelta.size(), &length);
+            if (delta == nullptr || length != (*entry)->storedLength)
+            {
+                log_error("Unable to decode game state snapshot for tick %u", tick);
+                free(delta);
+                return nullptr;
+            }
+
+            auto common = std::min(length, sprites.size());
+            sprites.resize(length);
+            for (size_t i = 0; i < common; i++)
+            {
+                sprites[i] ^= delta[i];
+            }
+            std::copy(delta + common, delta + length, sprites.begin() + common);
+            free(delta);
+        }
+
+        _decodedSnapshot.tick = snapshot->tick;
+        _decodedSnapshot.srand0 = snapshot->srand0;
+        _decodedSnapshot.storedSprites.Clear();
+        _decodedSnapshot.storedSprites.Write(sprites.data(), sprites.size());
+        _decodedSnapshot.parkParameters.Clear();
+        _decodedSnapshot.parkParameters.Write(snapshot->parkParameters.GetData(), snapshot->parkParameters.GetLength());
+        return &_decodedSnapshot;
+    }
+
+    static void EncodeDelta(GameStateSnapshot_t& snapshot, const GameStateSnapshot_t& base)
+    {
+        const auto* data = static_cast<const uint8_t*>(snapshot.storedSprites.GetData());
+        const auto* baseData = static_cast<const uint8_t*>(base.storedSprites.GetData());
+        size_t length = snapshot.storedSprites.GetLength();
+        size_t common = std::min<size_t>(length, base.storedSprites.GetLength());
+
+        std::vector<uint8_t> delta(data, data + length);
+        for (size_t i = 0; i < common; i++)
+        {
+            delta[i] ^= baseData[i];
+        }
+
+        auto compressed = util_zlib_deflate(delta.data(), delta.size());
+        if (!compressed)
+        {
+            // Keep it in full, which ends the delta chain of older snapshots here
+            return;
+        }
+
+        snapshot.deltaBase = &base;
+        snapshot.storedDelta = std::move(*compressed);
+        snapshot.storedLength = length;
+        snapshot.storedSprites = OpenRCT2::MemoryStream();
     }
 
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& ds) const override final
@@ -166,16 +283,21 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
     {
-        std::vector<rct_sprite> spriteList;
-        spriteList.resize(MAX_SPRITES);
+        // By default they don't exist.
+        rct_sprite nullSprite;
+        nullSprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
 
-        for (auto& sprite : spriteList)
-        {
-            // By default they don't exist.
-            sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
-        }
-
-        snapshot.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_SPRITES, false);
+        // The snapshot may be of a larger entity pool than ours, so size the list by the indices it contains.
+        std::vector<rct_sprite> spriteList(MAX_SPRITES, nullSprite);
+        snapshot.SerialiseSprites(
+            [&spriteList, &nullSprite](const size_t index) -> rct_sprite* {
+                if (index >= MAX_ENTITIES_LIMIT)
+                    return nullptr;
+                if (index >= spriteList.size())
+                    spriteList.resize(index + 1, nullSprite);
+                return &spriteList[index];
+            },
+            MAX_ENTITIES_LIMIT, false);
 
         return spriteList;
     }
@@ -535,10 +657,17 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
         std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
 
-        for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
-        {
-            GameStateSpriteChange_t changeData;
-            changeData.spriteIndex = i;
+        rct_sprite nullSprite;
+        nullSprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        auto numSprites = std::max(spritesBase.size(), spritesCmp.size());
+        spritesBase.resize(numSprites, nullSprite);
+        spritesCmp.resize(numSprites, nullSprite);
+
+        // Compared in parallel chunks, every sprite writes its own slot so the result stays in index order
+        res.spriteChanges.resize(numSprites);
+        TaskScheduler::GetGlobal().ParallelFor(0, numSprites, 1024, [&](size_t i) {
+            auto& changeData = res.spriteChanges[i];
+            changeData.spriteIndex = static_cast<uint32_t>(i);
 
             const rct_sprite& spriteBase = spritesBase[i];
             const rct_sprite& spriteCmp = spritesCmp[i];
@@ -580,9 +709,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
                     changeData.changeType = GameStateSpriteChange_t::MODIFIED;
                 }
             }
-
-            res.spriteChanges.push_back(changeData);
-        }
+        });
 
         return res;
     }
@@ -685,8 +812,86 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         return true;
     }
 
+    virtual bool WriteCompareDataToFile(const std::string& fileName, const GameStateCompareData_t& cmpData) const override
+    {
+        // Struct and field names are written once and referred to by index
+        std::vector<const char*> names;
+        std::unordered_map<std::string_view, uint16_t> nameIndices;
+        auto getNameIndex = [&names, &nameIndices](const char* name) {
+            auto it = nameIndices.find(name);
+            if (it != nameIndices.end())
+                return it->second;
+            auto index = static_cast<uint16_t>(names.size());
+            names.push_back(name);
+            nameIndices.emplace(name, index);
+            return index;
+        };
+
+        uint32_t numChanges = 0;
+        for (auto& change : cmpData.spriteChanges)
+        {
+            if (change.changeType == GameStateSpriteChange_t::EQUAL)
+                continue;
+            numChanges++;
+            for (auto& diff : change.diffs)
+            {
+                getNameIndex(diff.structname);
+                getNameIndex(diff.fieldname);
+            }
+        }
+
+        OpenRCT2::MemoryStream ms;
+        ms.WriteValue<uint32_t>(GameStateCompareDataMagic);
+        ms.WriteValue<uint16_t>(GameStateCompareDataVersion);
+        ms.WriteValue<uint32_t>(cmpData.tick);
+        ms.WriteValue<uint32_t>(cmpData.srand0Left);
+        ms.WriteValue<uint32_t>(cmpData.srand0Right);
+
+        ms.WriteValue<uint16_t>(static_cast<uint16_t>(names.size()));
+        for (auto name : names)
+        {
+            ms.WriteString(name);
+        }
+
+        ms.WriteValue<uint32_t>(numChanges);
+        for (auto& change : cmpData.spriteChanges)
+        {
+            if (change.changeType == GameStateSpriteChange_t::EQUAL)
+                continue;
+
+            ms.WriteValue<uint8_t>(change.changeType);
+            ms.WriteValue<uint8_t>(change.spriteIdentifier);
+            ms.WriteValue<uint8_t>(change.miscIdentifier);
+            ms.WriteValue<uint32_t>(change.spriteIndex);
+            ms.WriteValue<uint16_t>(static_cast<uint16_t>(change.diffs.size()));
+            for (auto& diff : change.diffs)
+            {
+                ms.WriteValue<uint16_t>(getNameIndex(diff.structname));
+                ms.WriteValue<uint16_t>(getNameIndex(diff.fieldname));
+                ms.WriteValue<uint16_t>(static_cast<uint16_t>(diff.offset));
+                ms.WriteValue<uint8_t>(static_cast<uint8_t>(diff.length));
+                ms.WriteValue<uint64_t>(diff.valueA);
+                ms.WriteValue<uint64_t>(diff.valueB);
+            }
+        }
+
+        try
+        {
+            File::WriteAllBytes(fileName, ms.GetData(), ms.GetLength());
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to write desync report '%s': %s", fileName.c_str(), e.what());
+            return false;
+        }
+        return true;
+    }
+
 private:
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::unordered_map<uint32_t, GameStateSnapshot_t*> _linkedSnapshots;
+    GameStateSnapshot_t* _lastCaptured = nullptr;
+    mutable GameStateSnapshot_t _decodedSnapshot;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
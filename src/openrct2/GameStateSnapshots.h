@@ -59,6 +59,8 @@ struct GameStateCompareData_t
  * the oldest snapshot will be removed from the buffer. Never store the snapshot pointer
  * as it may become invalid at any time when a snapshot is created, rather Link the snapshot
  * to a specific tick which can be obtained by that later again assuming its still valid.
+ * Captured snapshots are kept as compressed deltas against the next capture, GetLinkedSnapshot
+ * decodes them into a shared scratch snapshot which is only valid until the next call.
  */
 struct IGameStateSnapshots
 {
@@ -103,6 +105,17 @@ struct IGameStateSnapshots
      * Writes the GameStateCompareData_t into the specified file as readable text.
      */
     virtual bool LogCompareDataToFile(const std::string& fileName, const GameStateCompareData_t& cmpData) const = 0;
+
+    /*
+     * Writes the GameStateCompareData_t into the specified file in a compact binary form for external tools.
+     * All values are little endian:
+     *   uint32 magic "GSCD", uint16 version, uint32 tick, uint32 srand0 left, uint32 srand0 right
+     *   uint16 name count, names as null terminated strings
+     *   uint32 change count, for each change that is not EQUAL:
+     *     uint8 change type, uint8 sprite identifier, uint8 misc identifier, uint32 sprite index, uint16 diff count
+     *     for each diff: uint16 struct name, uint16 field name, uint16 offset, uint8 length, uint64 left, uint64 right
+     */
+    virtual bool WriteCompareDataToFile(const std::string& fileName, const GameStateCompareData_t& cmpData) const = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots();
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "HitchTracker.h"
+
+#include "Game.h"
+#include "TickProfiler.h"
+#include "core/AllocationCounter.h"
+#include "core/Console.hpp"
+#include "core/String.hpp"
+#include "drawing/FrameProfiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+constexpr size_t NUM_HITCH_EVENTS = static_cast<size_t>(HitchEvent::Count);
+
+static constexpr const char* HitchEventNames[] = {
+    "map_reorganise",
+    "autosave",
+    "object_loading",
+};
+static_assert(std::size(HitchEventNames) == NUM_HITCH_EVENTS);
+
+namespace
+{
+    // An update or a frame that is being timed
+    struct HitchSpan
+    {
+        const char* Name;
+        std::chrono::steady_clock::time_point StartTime;
+        uint64_t StartAllocations;
+        uint32_t StartTick;
+        // Events noted since the span started, one bit each
+        std::atomic<uint32_t> Events;
+    };
+} // namespace
+
+static uint32_t _threshold = 0;
+static uint32_t _numHitches = 0;
+static HitchSpan _update{ "update", {}, 0, 0, {} };
+static HitchSpan _frame{ "frame", {}, 0, 0, {} };
+
+static void hitch_tracker_begin(HitchSpan& span)
+{
+    span.StartTime = std::chrono::steady_clock::now();
+    span.StartAllocations = AllocationCounter::GetCount();
+    span.StartTick = gCurrentTicks;
+    span.Events.store(0, std::memory_order_relaxed);
+}
+
+static std::string hitch_tracker_get_events(uint32_t events)
+{
+    std::string result;
+    for (size_t i = 0; i < NUM_HITCH_EVENTS; i++)
+    {
+        if (events & (1u << i))
+        {
+            if (!result.empty())
+                result += ", ";
+            result += HitchEventNames[i];
+        }
+    }
+    return result.empty() ? "none" : result;
+}
+
+static std::string hitch_tracker_get_tick_phases(uint32_t startTick)
+{
+    std::string result;
+    for (const auto& sample : tick_profiler_get_samples())
+    {
+        if (sample.Tick < startTick)
+            continue;
+
+        result += String::StdFormat("\n  tick %u:", sample.Tick);
+        for (size_t i = 0; i < static_cast<size_t>(TickPhase::Count); i++)
+        {
+            // Leave out the phases that barely took any time, the line is long enough as it is
+            auto ms = sample.Nanoseconds[i] / 1e6;
+            if (ms >= 0.1)
+            {
+                result += String::StdFormat(" %s %.1f ms", tick_profiler_get_phase_name(static_cast<TickPhase>(i)), ms);
+            }
+        }
+    }
+    return result;
+}
+
+static std::string hitch_tracker_get_frame_phases()
+{
+    auto samples = frame_profiler_get_samples();
+    if (samples.empty())
+        return {};
+
+    std::string result = "\n  phases:";
+    const auto& sample = samples.back();
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::Count); i++)
+    {
+        result += String::StdFormat(
+            " %s %.1f ms", frame_profiler_get_phase_name(static_cast<FramePhase>(i)), sample.Nanoseconds[i] / 1e6);
+    }
+    return result;
+}
+
+static void hitch_tracker_end(HitchSpan& span, bool isFrame)
+{
+    auto duration = std::chrono::steady_clock::now() - span.StartTime;
+    auto ms = std::chrono::duration<double, std::milli>(duration).count();
+    if (ms < _threshold)
+        return;
+
+    _numHitches++;
+    auto allocations = AllocationCounter::GetCount() - span.StartAllocations;
+    auto events = span.Events.load(std::memory_order_relaxed);
+    auto phases = isFrame ? hitch_tracker_get_frame_phases() : hitch_tracker_get_tick_phases(span.StartTick);
+    log_warning(
+        "Hitch: %s at tick %u took %.1f ms, %llu allocations, events: %s%s", span.Name, span.StartTick, ms,
+        static_cast<unsigned long long>(allocations), hitch_tracker_get_events(events).c_str(), phases.c_str());
+}
+
+void hitch_tracker_set_threshold(uint32_t milliseconds)
+{
+    bool enabled = milliseconds != 0;
+    if (enabled && _threshold == 0)
+    {
+        // Spans that started before the tracker was turned on are not reported
+        _update.StartTime = {};
+        _frame.StartTime = {};
+        _numHitches = 0;
+        frame_profiler_set_enabled(true);
+        tick_profiler_set_enabled(true);
+    }
+    _threshold = milliseconds;
+    AllocationCounter::SetEnabled(enabled);
+}
+
+uint32_t hitch_tracker_get_threshold()
+{
+    return _threshold;
+}
+
+uint32_t hitch_tracker_get_count()
+{
+    return _numHitches;
+}
+
+void hitch_tracker_note(HitchEvent event)
+{
+    auto bit = 1u << static_cast<uint32_t>(event);
+    _update.Events.fetch_or(bit, std::memory_order_relaxed);
+    _frame.Events.fetch_or(bit, std::memory_order_relaxed);
+}
+
+void hitch_tracker_begin_update()
+{
+    if (_threshold != 0)
+    {
+        hitch_tracker_begin(_update);
+    }
+}
+
+void hitch_tracker_end_update()
+{
+    if (_threshold != 0 && _update.StartTime != std::chrono::steady_clock::time_point())
+    {
+        hitch_tracker_end(_update, false);
+    }
+}
+
+void hitch_tracker_begin_frame()
+{
+    if (_threshold != 0)
+    {
+        hitch_tracker_begin(_frame);
+    }
+}
+
+void hitch_tracker_end_frame()
+{
+    if (_threshold != 0 && _frame.StartTime != std::chrono::steady_clock::time_point())
+    {
+        hitch_tracker_end(_frame, true);
+    }
+}
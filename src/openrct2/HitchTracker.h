@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+/**
+ * Work that is known to take long, which is logged with the update or frame it ran in.
+ */
+enum class HitchEvent : uint8_t
+{
+    MapReorganise, // map_reorganise_elements
+    Autosave,      // Starting an autosave or waiting for the previous one
+    ObjectLoading, // Loading objects through the object manager
+    Count,
+};
+
+/**
+ * Logs every update and frame that takes longer than the threshold, 0 turns the tracker off. While it is on the tick and
+ * frame profilers are enabled to log the times of the phases, and heap allocations are counted.
+ */
+void hitch_tracker_set_threshold(uint32_t milliseconds);
+uint32_t hitch_tracker_get_threshold();
+uint32_t hitch_tracker_get_count();
+
+// Notes that the work ran, can be called from any thread.
+void hitch_tracker_note(HitchEvent event);
+
+// Only called by the thread that runs the game loop.
+void hitch_tracker_begin_update();
+void hitch_tracker_end_update();
+void hitch_tracker_begin_frame();
+void hitch_tracker_end_frame();
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryReport.h"
+
+#include "Context.h"
+#include "core/String.hpp"
+#include "drawing/TTF.h"
+#include "object/ObjectManager.h"
+#include "scripting/ScriptEngine.h"
+#include "world/Map.h"
+#include "world/Sprite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+constexpr size_t NUM_MEMORY_SUBSYSTEMS = static_cast<size_t>(MemorySubsystem::Count);
+constexpr auto MEMORY_REPORT_INTERVAL = std::chrono::seconds(1);
+
+static constexpr const char* MemorySubsystemNames[] = {
+    "tile_elements", "entities", "object_images", "texture_cache", "audio", "ttf", "scripting",
+};
+static_assert(std::size(MemorySubsystemNames) == NUM_MEMORY_SUBSYSTEMS);
+
+static std::mutex _providersMutex;
+static std::array<MemoryUsageProvider, NUM_MEMORY_SUBSYSTEMS> _providers;
+static std::array<size_t, NUM_MEMORY_SUBSYSTEMS> _peaks;
+static std::chrono::steady_clock::time_point _lastUpdateTime;
+
+static bool memory_report_measure(MemorySubsystem subsystem, size_t& usage)
+{
+    switch (subsystem)
+    {
+        case MemorySubsystem::TileElements:
+            usage = map_get_tile_element_memory_usage();
+            return true;
+        case MemorySubsystem::Entities:
+            usage = GetEntityMemoryUsage();
+            return true;
+        case MemorySubsystem::ObjectImages:
+        {
+            auto context = OpenRCT2::GetContext();
+            if (context == nullptr)
+                return false;
+            usage = context->GetObjectManager().GetImageMemoryUsage();
+            return true;
+        }
+        case MemorySubsystem::TrueTypeFonts:
+            usage = ttf_get_memory_usage();
+            return true;
+        case MemorySubsystem::Scripting:
+#ifdef ENABLE_SCRIPTING
+            usage = OpenRCT2::Scripting::GetDukHeapMemoryUsage();
+            return true;
+#else
+            return false;
+#endif
+        default:
+        {
+            std::lock_guard<std::mutex> lock(_providersMutex);
+            const auto& provider = _providers[static_cast<size_t>(subsystem)];
+            if (!provider)
+                return false;
+            usage = provider();
+            return true;
+        }
+    }
+}
+
+void memory_report_set_provider(MemorySubsystem subsystem, MemoryUsageProvider provider)
+{
+    std::lock_guard<std::mutex> lock(_providersMutex);
+    _providers[static_cast<size_t>(subsystem)] = std::move(provider);
+}
+
+void memory_report_update()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - _lastUpdateTime >= MEMORY_REPORT_INTERVAL)
+    {
+        _lastUpdateTime = now;
+        memory_report_get();
+    }
+}
+
+MemoryReport memory_report_get()
+{
+    MemoryReport report{};
+    for (size_t i = 0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    {
+        auto& entry = report[i];
+        entry.Available = memory_report_measure(static_cast<MemorySubsystem>(i), entry.Current);
+        if (entry.Available)
+        {
+            _peaks[i] = std::max(_peaks[i], entry.Current);
+            entry.Peak = _peaks[i];
+        }
+    }
+    return report;
+}
+
+void memory_report_reset_peaks()
+{
+    _peaks = {};
+}
+
+const char* memory_report_get_subsystem_name(MemorySubsystem subsystem)
+{
+    auto index = static_cast<size_t>(subsystem);
+    return index < NUM_MEMORY_SUBSYSTEMS ? MemorySubsystemNames[index] : "";
+}
+
+std::string memory_report_get_summary()
+{
+    std::string summary;
+    size_t total = 0;
+    auto report = memory_report_get();
+    for (size_t i = 0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    {
+        if (!report[i].Available)
+            continue;
+
+        summary += String::StdFormat(
+            "%s %zu KiB, ", memory_report_get_subsystem_name(static_cast<MemorySubsystem>(i)), report[i].Current / 1024);
+        total += report[i].Current;
+    }
+    summary += String::StdFormat("total %zu KiB", total / 1024);
+    return summary;
+}
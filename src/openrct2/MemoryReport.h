@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <array>
+#include <functional>
+#include <string>
+
+/**
+ * The subsystems whose memory is accounted in the memory report.
+ */
+enum class MemorySubsystem : uint8_t
+{
+    TileElements,  // gTileElements, the tile pointers and the extra tile element pages
+    Entities,      // The entity slots and their per-slot data
+    ObjectImages,  // The image tables of the loaded objects, including the deferred PNG images
+    TextureCache,  // The atlases and palette texture of the OpenGL renderer
+    Audio,         // The sounds loaded into memory
+    TrueTypeFonts, // The rendered text and text width caches
+    Scripting,     // The Duktape heaps of the plugins and their workers
+    Count,
+};
+
+struct MemoryUsage
+{
+    size_t Current;
+    // The highest usage measured since the peaks were reset
+    size_t Peak;
+    // False when nothing reports the subsystem, e.g. there is no texture cache with the software renderer
+    bool Available;
+};
+
+using MemoryUsageProvider = std::function<size_t()>;
+using MemoryReport = std::array<MemoryUsage, static_cast<size_t>(MemorySubsystem::Count)>;
+
+/**
+ * Subsystems outside of libopenrct2 report their usage through a provider, which is called on the game thread. Pass
+ * nullptr when the subsystem goes away.
+ */
+void memory_report_set_provider(MemorySubsystem subsystem, MemoryUsageProvider provider);
+
+/**
+ * Measures the usage of every subsystem once a second. The peaks are the highest of these measurements, so a short
+ * lived spike in between may not show up in them.
+ */
+void memory_report_update();
+
+/**
+ * Measures the usage of every subsystem now, raising the peaks if needed.
+ */
+MemoryReport memory_report_get();
+void memory_report_reset_peaks();
+const char* memory_report_get_subsystem_name(MemorySubsystem subsystem);
+
+/**
+ * Returns the current usage of every available subsystem as a single line for the log.
+ */
+std::string memory_report_get_summary();
@@ -54,6 +54,8 @@ extern int32_t gNetworkStart;
 extern std::string gNetworkStartHost;
 extern int32_t gNetworkStartPort;
 extern std::string gNetworkStartAddress;
+// Non-zero when joining as a relay, the port its own clients connect to
+extern int32_t gNetworkStartRelayPort;
 #endif
 
 extern uint32_t gCurrentDrawCount;
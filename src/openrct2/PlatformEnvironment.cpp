@@ -86,6 +86,8 @@ private:
             case PATHID::CACHE_OBJECTS:
             case PATHID::CACHE_TRACKS:
             case PATHID::CACHE_SCENARIOS:
+            case PATHID::CACHE_SAVES:
+            case PATHID::CACHE_SERVERS:
                 return DIRBASE::CACHE;
             case PATHID::MP_DAT:
                 return DIRBASE::RCT1;
@@ -236,6 +238,8 @@ const char * PlatformEnvironment::FileNames[] =
     "objects.idx",          // CACHE_OBJECTS
     "tracks.idx",           // CACHE_TRACKS
     "scenarios.idx",        // CACHE_SCENARIOS
+    "saves.idx",            // CACHE_SAVES
+    "servers.json",         // CACHE_SERVERS
     "Data" PATH_SEPARATOR "mp.dat", // MP_DAT
     "groups.json",          // NETWORK_GROUPS
     "servers.cfg",          // NETWORK_SERVERS
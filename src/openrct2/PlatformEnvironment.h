@@ -58,6 +58,8 @@ namespace OpenRCT2
         CACHE_OBJECTS,   // Object repository cache (objects.idx).
         CACHE_TRACKS,    // Track repository cache (tracks.idx).
         CACHE_SCENARIOS, // Scenario repository cache (scenarios.idx).
+        CACHE_SAVES,     // Saved game repository cache (saves.idx).
+        CACHE_SERVERS,   // Server list of the master server (servers.json).
         MP_DAT,          // Mega Park data, Steam RCT1 only (\RCTdeluxe_install\Data\mp.dat)
         NETWORK_GROUPS,  // Server groups with permissions (groups.json).
         NETWORK_SERVERS, // Saved servers (servers.cfg).
@@ -0,0 +1,48 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+/**
+ * Instrumentation for the Tracy profiler, which shows the zones of every thread on one timeline. It is only built
+ * with ENABLE_TRACY, without it the macros compile to nothing and the mutexes are plain std::mutex.
+ *
+ * PROFILE_ZONE(name)                  Times the rest of the enclosing scope, name has to be a string literal.
+ * PROFILE_FRAME()                     Marks the end of a frame.
+ * PROFILE_THREAD_NAME(name)           Names the calling thread.
+ * PROFILE_LOCKABLE(type, var, name)   Declares a mutex whose lock contention is shown, lock it as
+ *                                     PROFILE_LOCKABLE_TYPE(type) and wait on it with ProfiledConditionVariable.
+ */
+#ifdef ENABLE_TRACY
+
+#    include <condition_variable>
+#    include <tracy/Tracy.hpp>
+
+#    define PROFILE_ZONE(name) ZoneScopedN(name)
+#    define PROFILE_FRAME() FrameMark
+#    define PROFILE_THREAD_NAME(name) tracy::SetThreadName(name)
+#    define PROFILE_LOCKABLE(type, var, name) TracyLockableN(type, var, name)
+#    define PROFILE_LOCKABLE_TYPE(type) LockableBase(type)
+
+// Tracy's lockables are not std::mutex, which std::condition_variable requires
+using ProfiledConditionVariable = std::condition_variable_any;
+
+#else
+
+#    include <condition_variable>
+
+#    define PROFILE_ZONE(name)
+#    define PROFILE_FRAME()
+#    define PROFILE_THREAD_NAME(name)
+#    define PROFILE_LOCKABLE(type, var, name) type var
+#    define PROFILE_LOCKABLE_TYPE(type) type
+
+using ProfiledConditionVariable = std::condition_variable;
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -32,7 +33,9 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -67,6 +70,15 @@ namespace OpenRCT2
         }
     };
 
+    // The full state of the park at a tick of the replay, playback can start from it instead of the start of the replay
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+        OpenRCT2::MemoryStream cheatData;
+    };
+
     struct ReplayRecordFile
     {
         uint32_t magic;
@@ -89,18 +101,22 @@ namespace OpenRCT2
         uint32_t tickStart;    // First tick of replay.
         uint32_t tickEnd;      // Last tick of replay.
         std::multiset<ReplayCommand> commands;
+        std::multiset<ReplayCommand>::iterator nextCommand;
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 4;
+        static constexpr uint16_t ReplayVersion = 5;
+        static constexpr uint16_t ReplayMinVersion = 4; // Replays without keyframes
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
+        static constexpr uint32_t KeyframeTicks = 40 * 60 * 5;  // Five minutes at normal speed
 
         enum class ReplayMode
         {
@@ -164,6 +180,15 @@ namespace OpenRCT2
                 _nextChecksumTick = gCurrentTicks + ChecksumTicksDelta();
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && gCurrentTicks >= _nextKeyframeTick)
+            {
+                auto& keyframe = _currentRecording->keyframes.emplace_back();
+                keyframe.tick = gCurrentTicks;
+                CaptureParkState(keyframe.parkData, keyframe.parkParams, keyframe.cheatData);
+
+                _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -240,23 +265,10 @@ namespace OpenRCT2
 
             replayData->filePath = name;
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
+            CaptureParkState(replayData->parkData, replayData->parkParams, replayData->cheatData);
 
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
-
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
-
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
             if (_mode != ReplayMode::NORMALISATION)
@@ -265,6 +277,7 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
 
             return true;
         }
@@ -369,6 +382,7 @@ namespace OpenRCT2
                 info.Ticks = data->tickEnd - data->tickStart;
             info.NumCommands = static_cast<uint32_t>(data->commands.size());
             info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumKeyframes = static_cast<uint32_t>(data->keyframes.size());
 
             return true;
         }
@@ -400,10 +414,11 @@ namespace OpenRCT2
                     std::string outputPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(
                         DIRBASE::USER, DIRID::LOG_DESYNCS);
                     char uniqueFileName[128] = {};
-                    snprintf(uniqueFileName, sizeof(uniqueFileName), "replay_desync_%u.txt", gCurrentTicks);
+                    snprintf(uniqueFileName, sizeof(uniqueFileName), "replay_desync_%u", gCurrentTicks);
 
                     std::string outputFile = Path::Combine(outputPath, uniqueFileName);
-                    snapshots->LogCompareDataToFile(outputFile, cmpData);
+                    snapshots->LogCompareDataToFile(outputFile + ".txt", cmpData);
+                    snapshots->WriteCompareDataToFile(outputFile + ".dat", cmpData);
                 }
             }
             catch (const std::runtime_error& err)
@@ -425,7 +440,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadParkState(replayData->parkData, replayData->parkParams, replayData->cheatData))
             {
                 log_error("Unable to load map.");
                 return false;
@@ -436,6 +451,7 @@ namespace OpenRCT2
             LoadAndCompareSnapshot(replayData->gameStateSnapshots);
 
             _currentReplay = std::move(replayData);
+            _currentReplay->nextCommand = _currentReplay->commands.begin();
             _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
 
@@ -482,6 +498,58 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& replay = *_currentReplay;
+            auto targetTick = replay.tickEnd - replay.tickStart > replayTick ? replay.tickStart + replayTick : replay.tickEnd;
+
+            // Keyframes are in the order they were taken
+            ReplayKeyframe* keyframe = nullptr;
+            for (auto& candidate : replay.keyframes)
+            {
+                if (candidate.tick > targetTick)
+                    break;
+                keyframe = &candidate;
+            }
+
+            // Simulating on from the current state is quicker if it is past the keyframe
+            bool continuePlayback = gCurrentTicks <= targetTick && (keyframe == nullptr || keyframe->tick <= gCurrentTicks);
+            if (!continuePlayback)
+            {
+                bool loaded = keyframe != nullptr
+                    ? LoadParkState(keyframe->parkData, keyframe->parkParams, keyframe->cheatData)
+                    : LoadParkState(replay.parkData, replay.parkParams, replay.cheatData);
+                if (!loaded)
+                {
+                    log_error("Unable to load map.");
+                    StopPlayback();
+                    return false;
+                }
+                gCurrentTicks = keyframe != nullptr ? keyframe->tick : replay.tickStart;
+                gGamePaused = 0;
+
+                ReplayCommand firstCommand;
+                firstCommand.tick = gCurrentTicks;
+                replay.nextCommand = replay.commands.lower_bound(firstCommand);
+
+                auto checksum = std::find_if(replay.checksums.begin(), replay.checksums.end(), [](const auto& item) {
+                    return item.first >= gCurrentTicks;
+                });
+                replay.checksumIndex = static_cast<uint32_t>(std::distance(replay.checksums.begin(), checksum));
+                _faultyChecksumIndex = -1;
+            }
+
+            auto gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+            return true;
+        }
+
         virtual bool NormaliseReplay(const std::string& file, const std::string& outFile) override
         {
             _mode = ReplayMode::NORMALISATION;
@@ -515,17 +583,36 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        void CaptureParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
+        {
+            auto& objManager = GetContext()->GetObjectManager();
+            auto objects = objManager.GetPackableObjects();
+
+            auto s6exporter = std::make_unique<S6Exporter>();
+            s6exporter->ExportObjectsList = objects;
+            s6exporter->Export();
+            s6exporter->SaveGame(&parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+        }
+
+        bool LoadParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
+                cheatData.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
 
                 importer->Import();
@@ -533,13 +620,13 @@ namespace OpenRCT2
                 sprite_position_tween_reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 // New cheats might not be serialised, make sure they are using their defaults.
                 CheatsReset();
 
-                DataSerialiser cheatDataDs(false, data.cheatData);
+                DataSerialiser cheatDataDs(false, cheatData);
                 SerialiseCheats(cheatDataDs);
 
                 game_load_init();
@@ -712,7 +799,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version >= ReplayMinVersion && data.version <= ReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -785,6 +872,25 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version >= 5)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                    serialiser << keyframe.cheatData;
+                }
+            }
             return true;
         }
 
@@ -826,10 +932,11 @@ namespace OpenRCT2
         void ReplayCommands()
         {
             auto& replayQueue = _currentReplay->commands;
+            auto& nextCommand = _currentReplay->nextCommand;
 
-            while (replayQueue.begin() != replayQueue.end())
+            while (nextCommand != replayQueue.end())
             {
-                const ReplayCommand& command = (*replayQueue.begin());
+                const ReplayCommand& command = *nextCommand;
 
                 if (_mode == ReplayMode::PLAYING)
                 {
@@ -865,7 +972,11 @@ namespace OpenRCT2
                         window_scroll_to_location(mainWindow, result->Position);
                 }
 
-                replayQueue.erase(replayQueue.begin());
+                // Playback keeps the commands so it can seek back, normalisation stops once they are used up
+                if (_mode == ReplayMode::NORMALISATION)
+                    nextCommand = replayQueue.erase(nextCommand);
+                else
+                    ++nextCommand;
             }
         }
 
@@ -877,6 +988,7 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _nextKeyframeTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
 
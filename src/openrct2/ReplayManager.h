@@ -28,6 +28,7 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
@@ -62,6 +63,12 @@ namespace OpenRCT2
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
+        /**
+         * Moves the playback to the given tick of the replay, counted from its start. Loads the closest keyframe before
+         * the tick, unless the playback is already past it, and simulates the remaining ticks.
+         */
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
+
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
     };
 
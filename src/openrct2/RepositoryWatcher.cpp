@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RepositoryWatcher.h"
+
+#include "OpenRCT2.h"
+#include "PlatformEnvironment.h"
+#include "core/Console.hpp"
+#include "core/FileWatcher.h"
+#include "core/Path.hpp"
+#include "interface/Window.h"
+#include "object/ObjectRepository.h"
+#include "ride/TrackDesignRepository.h"
+#include "scenario/ScenarioRepository.h"
+
+using namespace OpenRCT2;
+
+// Some platforms report a file several times while it is being written, it is scanned once it has not changed for this long
+static constexpr auto FileSettleTime = std::chrono::seconds(1);
+
+RepositoryWatcher::RepositoryWatcher(
+    const IPlatformEnvironment& env, IObjectRepository& objectRepository, ITrackDesignRepository& trackDesignRepository,
+    IScenarioRepository& scenarioRepository)
+    : _objectRepository(objectRepository)
+    , _trackDesignRepository(trackDesignRepository)
+    , _scenarioRepository(scenarioRepository)
+{
+    for (auto directoryId : { DIRID::OBJECT, DIRID::TRACK, DIRID::SCENARIO })
+    {
+        auto directory = Path::GetAbsolute(env.GetDirectoryPath(DIRBASE::USER, directoryId));
+        try
+        {
+            auto watcher = std::make_unique<FileWatcher>(directory);
+            watcher->OnFileChanged = [this](const std::string& path) {
+                std::lock_guard<std::mutex> lock(_changedFilesMutex);
+                _changedFiles[path] = std::chrono::steady_clock::now();
+            };
+            _watchers.push_back(std::move(watcher));
+            Console::WriteLine("Watching '%s' for new and changed files.", directory.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to watch '%s': %s", directory.c_str(), e.what());
+        }
+    }
+}
+
+RepositoryWatcher::~RepositoryWatcher()
+{
+    // Stop the threads of the watchers before the list they write to is gone
+    _watchers.clear();
+}
+
+void RepositoryWatcher::Update()
+{
+    if (!CanUpdateRepositories())
+    {
+        return;
+    }
+
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lock(_changedFilesMutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = _changedFiles.begin(); it != _changedFiles.end();)
+        {
+            if (now - it->second >= FileSettleTime)
+            {
+                paths.push_back(it->first);
+                it = _changedFiles.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    for (const auto& path : paths)
+    {
+        try
+        {
+            if (_objectRepository.ScanFile(path) || _trackDesignRepository.ScanFile(path)
+                || _scenarioRepository.ScanFile(path))
+            {
+                Console::WriteLine("Scanned changed file '%s'.", path.c_str());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to scan '%s': %s", path.c_str(), e.what());
+        }
+    }
+}
+
+/**
+ * The editors and the lists of the windows below refer to the items of the repositories by their position, the files
+ * that changed in the meantime are scanned once they are closed.
+ */
+bool RepositoryWatcher::CanUpdateRepositories() const
+{
+    if (gScreenFlags & SCREEN_FLAGS_EDITOR)
+    {
+        return false;
+    }
+    for (auto windowClass : { WC_EDITOR_OBJECT_SELECTION, WC_SCENARIO_SELECT, WC_TRACK_DESIGN_LIST })
+    {
+        if (window_find_by_class(windowClass) != nullptr)
+        {
+            return false;
+        }
+    }
+    return true;
+}
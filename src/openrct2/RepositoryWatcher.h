@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileWatcher;
+struct IObjectRepository;
+struct IScenarioRepository;
+struct ITrackDesignRepository;
+
+namespace OpenRCT2
+{
+    struct IPlatformEnvironment;
+
+    /**
+     * Watches the user directories of objects, track designs and scenarios, and adds the files that are created or
+     * changed in them to the repositories while the game runs, without scanning the directories again.
+     */
+    class RepositoryWatcher
+    {
+    private:
+        IObjectRepository& _objectRepository;
+        ITrackDesignRepository& _trackDesignRepository;
+        IScenarioRepository& _scenarioRepository;
+
+        // Written by the threads of the watchers, by the time of the last change of each file
+        std::mutex _changedFilesMutex;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> _changedFiles;
+
+        std::vector<std::unique_ptr<FileWatcher>> _watchers;
+
+    public:
+        RepositoryWatcher(
+            const IPlatformEnvironment& env, IObjectRepository& objectRepository,
+            ITrackDesignRepository& trackDesignRepository, IScenarioRepository& scenarioRepository);
+        ~RepositoryWatcher();
+
+        /**
+         * Scans the files that changed, called from the game thread.
+         */
+        void Update();
+
+    private:
+        bool CanUpdateRepositories() const;
+    };
+} // namespace OpenRCT2
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "StartupTrace.h"
+
+#include "core/Console.hpp"
+#include "core/Json.hpp"
+#include "platform/Platform2.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+struct StartupTraceEvent
+{
+    std::string Name;
+    uint32_t Thread;
+    int64_t StartTime;
+    int64_t Duration;
+    int64_t StartCpuTime;
+    int64_t CpuDuration;
+};
+
+static std::atomic<bool> _enabled{ false };
+static std::mutex _mutex;
+static std::string _path;
+static std::vector<StartupTraceEvent> _events;
+static int64_t _traceStartTime = 0;
+
+// Threads are numbered in the order they record their first span, thread 0 is the one that started the trace
+static std::atomic<uint32_t> _numThreads{ 0 };
+static thread_local int32_t _currentThread = -1;
+
+static int64_t startup_trace_now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static uint32_t startup_trace_get_current_thread()
+{
+    if (_currentThread == -1)
+    {
+        _currentThread = static_cast<int32_t>(_numThreads++);
+    }
+    return static_cast<uint32_t>(_currentThread);
+}
+
+void startup_trace_start(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _path = path;
+    _events.clear();
+    _traceStartTime = startup_trace_now();
+    startup_trace_get_current_thread();
+    _enabled = true;
+}
+
+bool startup_trace_is_enabled()
+{
+    return _enabled;
+}
+
+void startup_trace_finish()
+{
+    if (!_enabled)
+    {
+        return;
+    }
+    _enabled = false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Chrome trace event format, times are in microseconds
+    auto jEvents = json_t::array();
+    for (uint32_t thread = 0; thread < _numThreads; thread++)
+    {
+        jEvents.push_back({
+            { "name", "thread_name" },
+            { "ph", "M" },
+            { "pid", 1 },
+            { "tid", thread },
+            { "args", { { "name", thread == 0 ? std::string("main") : "worker " + std::to_string(thread) } } },
+        });
+    }
+    for (const auto& e : _events)
+    {
+        jEvents.push_back({
+            { "name", e.Name },
+            { "ph", "X" },
+            { "pid", 1 },
+            { "tid", e.Thread },
+            { "ts", (e.StartTime - _traceStartTime) / 1000.0 },
+            { "dur", e.Duration / 1000.0 },
+            { "tts", e.StartCpuTime / 1000.0 },
+            { "tdur", e.CpuDuration / 1000.0 },
+        });
+    }
+    json_t jTrace = {
+        { "traceEvents", jEvents },
+        { "displayTimeUnit", "ms" },
+    };
+
+    try
+    {
+        Json::WriteToFile(_path.c_str(), jTrace, -1);
+        Console::WriteLine("Startup trace written to '%s'", _path.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to write startup trace '%s': %s", _path.c_str(), e.what());
+    }
+    _events.clear();
+}
+
+StartupTraceSpan::StartupTraceSpan(std::string name)
+    : _name(std::move(name))
+{
+    if (_enabled)
+    {
+        _startTime = startup_trace_now();
+        _startCpuTime = Platform::GetThreadCpuTime();
+    }
+}
+
+StartupTraceSpan::~StartupTraceSpan()
+{
+    // Spans that started before the trace did are left out
+    if (!_enabled || _startTime == 0)
+    {
+        return;
+    }
+
+    StartupTraceEvent e;
+    e.Name = std::move(_name);
+    e.Thread = startup_trace_get_current_thread();
+    e.StartTime = _startTime;
+    e.Duration = startup_trace_now() - _startTime;
+    e.StartCpuTime = _startCpuTime;
+    e.CpuDuration = Platform::GetThreadCpuTime() - _startCpuTime;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.push_back(std::move(e));
+}
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <string>
+
+/**
+ * Starts recording the spans of the startup, which are written to path as a Chrome trace (chrome://tracing or
+ * Perfetto) by startup_trace_finish.
+ */
+void startup_trace_start(const std::string& path);
+bool startup_trace_is_enabled();
+
+/**
+ * Stops recording and writes the trace, does nothing if the trace was not started.
+ */
+void startup_trace_finish();
+
+/**
+ * Records the wall and CPU time of the calling thread between its construction and destruction as a span of the
+ * startup trace. Spans on the same thread nest by time.
+ */
+class StartupTraceSpan
+{
+private:
+    std::string _name;
+    int64_t _startTime = 0;
+    int64_t _startCpuTime = 0;
+
+public:
+    explicit StartupTraceSpan(std::string name);
+    ~StartupTraceSpan();
+
+    StartupTraceSpan(const StartupTraceSpan&) = delete;
+    StartupTraceSpan& operator=(const StartupTraceSpan&) = delete;
+};
@@ -0,0 +1,187 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TickProfiler.h"
+
+#include "core/String.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+constexpr size_t NUM_TICK_PHASES = static_cast<size_t>(TickPhase::Count);
+
+static constexpr const char* TickPhaseNames[] = {
+    "network", "scenario", "map_tiles", "path_flags", "peeps", "vehicles", "misc", "rides",
+    "park", "research", "ride_ratings", "ride_measurements", "sounds", "actions", "scripting", "tick",
+};
+static_assert(std::size(TickPhaseNames) == NUM_TICK_PHASES);
+
+static bool _enabled = false;
+
+static std::array<TickProfilerSample, TICK_PROFILER_HISTORY> _samples;
+static TickProfilerSample _currentSample;
+static TickProfilerSample _worstSample;
+static std::array<int64_t, NUM_TICK_PHASES> _totalNanoseconds;
+static uint32_t _completedTicks = 0;
+static uint32_t _firstTick = 0;
+static int64_t _tickStartTime = 0;
+
+static int64_t tick_profiler_now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void tick_profiler_set_enabled(bool enabled)
+{
+    if (enabled && !_enabled)
+    {
+        tick_profiler_reset();
+    }
+    _enabled = enabled;
+    _tickStartTime = 0;
+}
+
+bool tick_profiler_is_enabled()
+{
+    return _enabled;
+}
+
+void tick_profiler_reset()
+{
+    _firstTick = _completedTicks;
+    _worstSample = {};
+    _totalNanoseconds = {};
+}
+
+void tick_profiler_begin_tick(uint32_t tick)
+{
+    if (!_enabled)
+        return;
+
+    _currentSample = {};
+    _currentSample.Tick = tick;
+    _tickStartTime = tick_profiler_now();
+}
+
+void tick_profiler_end_tick()
+{
+    if (!_enabled || _tickStartTime == 0)
+        return;
+
+    auto& total = _currentSample.Nanoseconds[static_cast<size_t>(TickPhase::Tick)];
+    total = tick_profiler_now() - _tickStartTime;
+    _tickStartTime = 0;
+
+    if (total > _worstSample.Nanoseconds[static_cast<size_t>(TickPhase::Tick)])
+    {
+        _worstSample = _currentSample;
+    }
+    for (size_t phase = 0; phase < NUM_TICK_PHASES; phase++)
+    {
+        _totalNanoseconds[phase] += _currentSample.Nanoseconds[phase];
+    }
+    _samples[_completedTicks % TICK_PROFILER_HISTORY] = _currentSample;
+    _completedTicks++;
+}
+
+void tick_profiler_record(TickPhase phase, int64_t nanoseconds)
+{
+    // Phases timed outside of a tick, such as a game action run from the UI, are not part of any sample
+    if (_tickStartTime != 0)
+    {
+        _currentSample.Nanoseconds[static_cast<size_t>(phase)] += nanoseconds;
+    }
+}
+
+std::vector<TickProfilerSample> tick_profiler_get_samples()
+{
+    std::vector<TickProfilerSample> samples;
+    uint32_t numTicks = std::min<uint32_t>(_completedTicks - _firstTick, TICK_PROFILER_HISTORY);
+    samples.reserve(numTicks);
+    for (uint32_t tick = _completedTicks - numTicks; tick != _completedTicks; tick++)
+    {
+        samples.push_back(_samples[tick % TICK_PROFILER_HISTORY]);
+    }
+    return samples;
+}
+
+TickProfilerStats tick_profiler_get_stats()
+{
+    TickProfilerStats stats{};
+    auto samples = tick_profiler_get_samples();
+    stats.Ticks = samples.size();
+    stats.Worst = _worstSample;
+    stats.TotalTicks = _completedTicks - _firstTick;
+    stats.TotalNanoseconds = _totalNanoseconds;
+    if (samples.empty())
+        return stats;
+
+    std::vector<int64_t> times(samples.size());
+    for (size_t phase = 0; phase < NUM_TICK_PHASES; phase++)
+    {
+        int64_t total = 0;
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            times[i] = samples[i].Nanoseconds[phase];
+            total += times[i];
+        }
+
+        auto& phaseStats = stats.Phases[phase];
+        phaseStats.AverageNanoseconds = total / static_cast<int64_t>(samples.size());
+        phaseStats.MaxNanoseconds = *std::max_element(times.begin(), times.end());
+        auto p99 = times.begin() + (times.size() - 1) * 99 / 100;
+        std::nth_element(times.begin(), p99, times.end());
+        phaseStats.P99Nanoseconds = *p99;
+    }
+    return stats;
+}
+
+const char* tick_profiler_get_phase_name(TickPhase phase)
+{
+    return TickPhaseNames[static_cast<size_t>(phase)];
+}
+
+std::string tick_profiler_get_summary()
+{
+    auto stats = tick_profiler_get_stats();
+    const auto& tick = stats.Phases[static_cast<size_t>(TickPhase::Tick)];
+    auto summary = String::StdFormat(
+        "tick %.2f ms (p99 %.2f ms, worst %.2f ms at tick %u)", tick.AverageNanoseconds / 1e6, tick.P99Nanoseconds / 1e6,
+        stats.Worst.Nanoseconds[static_cast<size_t>(TickPhase::Tick)] / 1e6, stats.Worst.Tick);
+
+    std::array<size_t, NUM_TICK_PHASES - 1> phases;
+    for (size_t i = 0; i < phases.size(); i++)
+    {
+        phases[i] = i;
+    }
+    std::partial_sort(phases.begin(), phases.begin() + 3, phases.end(), [&stats](size_t a, size_t b) {
+        return stats.Phases[a].AverageNanoseconds > stats.Phases[b].AverageNanoseconds;
+    });
+    for (size_t i = 0; i < 3; i++)
+    {
+        summary += String::StdFormat(
+            ", %s %.2f ms", TickPhaseNames[phases[i]], stats.Phases[phases[i]].AverageNanoseconds / 1e6);
+    }
+    return summary;
+}
+
+TickPhaseTimer::TickPhaseTimer(TickPhase phase)
+    : _phase(phase)
+    , _startTime(_enabled ? tick_profiler_now() : 0)
+{
+}
+
+TickPhaseTimer::~TickPhaseTimer()
+{
+    if (_startTime != 0 && _enabled)
+    {
+        tick_profiler_record(_phase, tick_profiler_now() - _startTime);
+    }
+}
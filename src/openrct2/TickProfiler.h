@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * The stages of GameState::UpdateLogic that are timed by the tick profiler, in the order they run.
+ */
+enum class TickPhase : uint8_t
+{
+    Network,          // Replays, network_update and the desync checks
+    Scenario,         // date_update, scenario_update and climate_update
+    MapTiles,         // map_update_tiles
+    PathWideFlags,    // map_update_path_wide_flags
+    Peeps,            // entity_scheduler_update(EntityUpdateGroup::Peep)
+    Vehicles,         // entity_scheduler_update(EntityUpdateGroup::Vehicle)
+    Misc,             // entity_scheduler_update(EntityUpdateGroup::Misc)
+    Rides,            // Ride::UpdateAll
+    Park,             // Park::Update
+    Research,         // research_update
+    RideRatings,      // ride_ratings_update_all
+    RideMeasurements, // ride_measurements_update
+    Sounds,           // Map animations, news, vehicle sounds, crowd noise and climate sounds
+    GameActions,      // GameActions::ProcessQueue and the network flush
+    Scripting,        // Tick hooks and tick intervals of plugins
+    Tick,             // All of UpdateLogic
+    Count,
+};
+
+// Number of ticks the profiler keeps the samples of, about 40 seconds at normal speed
+constexpr size_t TICK_PROFILER_HISTORY = 1024;
+
+struct TickProfilerSample
+{
+    uint32_t Tick;
+    std::array<int64_t, static_cast<size_t>(TickPhase::Count)> Nanoseconds;
+};
+
+struct TickPhaseStats
+{
+    int64_t AverageNanoseconds;
+    int64_t P99Nanoseconds;
+    int64_t MaxNanoseconds;
+};
+
+struct TickProfilerStats
+{
+    // Number of ticks in the history the statistics are taken over
+    size_t Ticks;
+    std::array<TickPhaseStats, static_cast<size_t>(TickPhase::Count)> Phases;
+    // The longest tick since the profiler was reset, which may have left the history already
+    TickProfilerSample Worst;
+    // Number of ticks and time of each phase since the profiler was reset, including the ones no longer in the history
+    uint32_t TotalTicks;
+    std::array<int64_t, static_cast<size_t>(TickPhase::Count)> TotalNanoseconds;
+};
+
+void tick_profiler_set_enabled(bool enabled);
+bool tick_profiler_is_enabled();
+void tick_profiler_reset();
+
+// Only called by the thread that runs the game logic.
+void tick_profiler_begin_tick(uint32_t tick);
+void tick_profiler_end_tick();
+
+void tick_profiler_record(TickPhase phase, int64_t nanoseconds);
+
+/**
+ * Returns the samples of the last completed ticks, oldest first.
+ */
+std::vector<TickProfilerSample> tick_profiler_get_samples();
+TickProfilerStats tick_profiler_get_stats();
+const char* tick_profiler_get_phase_name(TickPhase phase);
+
+/**
+ * Returns the average time of the whole tick and of the slowest phases as a single line for the log.
+ */
+std::string tick_profiler_get_summary();
+
+/**
+ * Adds the time between its construction and destruction to a phase of the current tick.
+ */
+class TickPhaseTimer
+{
+private:
+    TickPhase _phase;
+    int64_t _startTime;
+
+public:
+    explicit TickPhaseTimer(TickPhase phase);
+    ~TickPhaseTimer();
+
+    TickPhaseTimer(const TickPhaseTimer&) = delete;
+    TickPhaseTimer& operator=(const TickPhaseTimer&) = delete;
+};
@@ -23,11 +23,14 @@
 #include "../scripting/ScriptEngine.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 
 #include <algorithm>
+#include <deque>
 #include <iterator>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -84,32 +87,23 @@ namespace GameActions
 
     struct QueuedGameAction
     {
-        uint32_t tick;
         uint32_t uniqueId;
         GameAction::Ptr action;
+    };
 
-        explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
-            : tick(t)
-            , uniqueId(id)
-            , action(std::move(ga))
-        {
-        }
-
-        bool operator<(const QueuedGameAction& comp) const
-        {
-            // First sort by tick
-            if (tick < comp.tick)
-                return true;
-            if (tick > comp.tick)
-                return false;
-
-            // If the ticks are equal sort by commandIndex
-            return uniqueId < comp.uniqueId;
-        }
+    // All actions queued for one tick, unique ids only increase so they are in order as they are appended
+    struct QueuedGameActionBucket
+    {
+        uint32_t tick;
+        size_t next;
+        std::vector<QueuedGameAction> actions;
     };
 
     static GameActionFactory _actions[GAME_COMMAND_COUNT];
-    static std::multiset<QueuedGameAction> _actionQueue;
+    // Sorted by tick, actions nearly always arrive for the last or a new tick
+    static std::deque<QueuedGameActionBucket> _actionQueue;
+    // Emptied action lists of processed ticks, kept to reuse their storage
+    static std::vector<std::vector<QueuedGameAction>> _actionQueueFreeLists;
     static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
 
@@ -155,7 +149,33 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+
+        auto it = _actionQueue.end();
+        while (it != _actionQueue.begin() && std::prev(it)->tick > tick)
+        {
+            it--;
+        }
+        if (it == _actionQueue.begin() || std::prev(it)->tick != tick)
+        {
+            QueuedGameActionBucket bucket{ tick, 0, {} };
+            if (!_actionQueueFreeLists.empty())
+            {
+                bucket.actions = std::move(_actionQueueFreeLists.back());
+                _actionQueueFreeLists.pop_back();
+            }
+            it = _actionQueue.insert(it, std::move(bucket));
+        }
+        else
+        {
+            it--;
+        }
+        it->actions.push_back({ _nextUniqueId++, std::move(ga) });
+    }
+
+    static void RecycleQueueBucket(QueuedGameActionBucket& bucket)
+    {
+        bucket.actions.clear();
+        _actionQueueFreeLists.push_back(std::move(bucket.actions));
     }
 
     void ProcessQueue()
@@ -168,14 +188,20 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (!_actionQueue.empty())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
+            auto& bucket = _actionQueue.front();
+            if (bucket.next == bucket.actions.size())
+            {
+                RecycleQueueBucket(bucket);
+                _actionQueue.pop_front();
+                continue;
+            }
 
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                if (bucket.tick < currentTick)
                 {
                     // This should never happen.
                     Guard::Assert(
@@ -183,16 +209,21 @@ namespace GameActions
                         "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
                         "Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        bucket.actions[bucket.next].action->GetName(), bucket.actions[bucket.next].action->GetType(),
+                        bucket.actions[bucket.next].uniqueId, bucket.tick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (bucket.tick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Take the action out first, executing it may queue more actions and move the bucket
+            auto queuedAction = std::move(bucket.actions[bucket.next].action);
+            bucket.next++;
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
-            switch (queued.action->GetType())
+            switch (queuedAction->GetType())
             {
                 case GAME_COMMAND_PLACE_WALL:
                 case GAME_COMMAND_PLACE_LARGE_SCENERY:
@@ -202,7 +233,7 @@ namespace GameActions
                     break;
             }
 
-            GameAction* action = queued.action.get();
+            GameAction* action = queuedAction.get();
             action->SetFlags(action->GetFlags() | GAME_COMMAND_FLAG_NETWORKED);
 
             Guard::Assert(action != nullptr);
@@ -213,13 +244,15 @@ namespace GameActions
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
-
-            _actionQueue.erase(_actionQueue.begin());
         }
     }
 
     void ClearQueue()
     {
+        for (auto& bucket : _actionQueue)
+        {
+            RecycleQueueBucket(bucket);
+        }
         _actionQueue.clear();
     }
 
@@ -258,12 +291,13 @@ namespace GameActions
         std::unique_ptr<GameAction> ga = GameActions::Create(action->GetType());
         ga->SetCallback(action->GetCallback());
 
-        // Serialise action data into stream.
-        DataSerialiser dsOut(true);
+        // Serialise action data into stream, which is kept to reuse its buffer.
+        static MemoryStream stream;
+        stream.Clear();
+        DataSerialiser dsOut(true, stream);
         action->Serialise(dsOut);
 
         // Serialise into new action.
-        IStream& stream = dsOut.GetStream();
         stream.SetPosition(0);
 
         DataSerialiser dsIn(false, stream);
@@ -447,6 +481,7 @@ namespace GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+            footpath_node_cache_invalidate();
 #ifdef ENABLE_SCRIPTING
             if (result->Error == GameActions::Status::Ok)
             {
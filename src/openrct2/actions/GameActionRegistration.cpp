@@ -68,6 +68,7 @@
 #include "SignSetStyleAction.hpp"
 #include "SmallSceneryPlaceAction.hpp"
 #include "SmallSceneryRemoveAction.hpp"
+#include "SmallSceneryScatterAction.hpp"
 #include "SmallScenerySetColourAction.hpp"
 #include "StaffFireAction.hpp"
 #include "StaffHireNewAction.hpp"
@@ -149,6 +150,7 @@ namespace GameActions
         Register<SmallSceneryPlaceAction>();
         Register<SmallSceneryRemoveAction>();
         Register<SmallScenerySetColourAction>();
+        Register<SmallSceneryScatterAction>();
         Register<LargeSceneryPlaceAction>();
         Register<LargeSceneryRemoveAction>();
         Register<LargeScenerySetColourAction>();
@@ -65,7 +65,7 @@ public:
 
     GameActions::Result::Ptr Query() const override
     {
-        if (_spriteIndex >= MAX_SPRITES)
+        if (_spriteIndex >= GetEntityCapacity())
         {
             return std::make_unique<GameActions::Result>(GameActions::Status::InvalidParameters, STR_CANT_NAME_GUEST, STR_NONE);
         }
@@ -100,6 +100,7 @@ private:
         res->Expenditure = ExpenditureType::LandPurchase;
 
         // Game command modified to accept selection size
+        auto oldParkSize = gParkSize;
         for (auto y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
         {
             for (auto x = validRange.GetLeft(); x <= validRange.GetRight(); x += COORDS_XY_STEP)
@@ -115,7 +116,11 @@ private:
         }
         if (isExecuting)
         {
-            map_count_remaining_land_rights();
+            // The park size and remaining land rights are kept up to date as each tile's ownership is changed
+            if (gParkSize != oldParkSize)
+            {
+                window_invalidate_by_class(WC_PARK_INFORMATION);
+            }
         }
         return res;
     }
@@ -151,7 +156,7 @@ private:
                 }
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(OWNERSHIP_OWNED);
+                    map_set_surface_ownership(surfaceElement, OWNERSHIP_OWNED);
                     update_park_fences_around_tile(loc);
                 }
                 res->Cost = gLandPrice;
@@ -172,7 +177,8 @@ private:
 
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(surfaceElement->GetOwnership() | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
+                    map_set_surface_ownership(
+                        surfaceElement, surfaceElement->GetOwnership() | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
                     uint16_t baseZ = surfaceElement->GetBaseZ();
                     map_invalidate_tile({ loc, baseZ, baseZ + 16 });
                 }
@@ -109,6 +109,7 @@ private:
         }
 
         // Game command modified to accept selection size
+        auto oldParkSize = gParkSize;
         for (auto y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
         {
             for (auto x = validRange.GetLeft(); x <= validRange.GetRight(); x += COORDS_XY_STEP)
@@ -125,7 +126,11 @@ private:
 
         if (isExecuting)
         {
-            map_count_remaining_land_rights();
+            // The park size and remaining land rights are kept up to date as each tile's ownership is changed
+            if (gParkSize != oldParkSize)
+            {
+                window_invalidate_by_class(WC_PARK_INFORMATION);
+            }
             OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, centre);
         }
         return res;
@@ -146,7 +151,8 @@ private:
             case LandSetRightSetting::UnownLand:
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(
+                    map_set_surface_ownership(
+                        surfaceElement,
                         surfaceElement->GetOwnership() & ~(OWNERSHIP_OWNED | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED));
                     update_park_fences_around_tile(loc);
                 }
@@ -154,7 +160,8 @@ private:
             case LandSetRightSetting::UnownConstructionRights:
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(surfaceElement->GetOwnership() & ~OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
+                    map_set_surface_ownership(
+                        surfaceElement, surfaceElement->GetOwnership() & ~OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
                     uint16_t baseZ = surfaceElement->GetBaseZ();
                     map_invalidate_tile({ loc, baseZ, baseZ + 16 });
                 }
@@ -162,7 +169,7 @@ private:
             case LandSetRightSetting::SetForSale:
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(surfaceElement->GetOwnership() | OWNERSHIP_AVAILABLE);
+                    map_set_surface_ownership(surfaceElement, surfaceElement->GetOwnership() | OWNERSHIP_AVAILABLE);
                     uint16_t baseZ = surfaceElement->GetBaseZ();
                     map_invalidate_tile({ loc, baseZ, baseZ + 16 });
                 }
@@ -170,7 +177,8 @@ private:
             case LandSetRightSetting::SetConstructionRightsForSale:
                 if (isExecuting)
                 {
-                    surfaceElement->SetOwnership(surfaceElement->GetOwnership() | OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE);
+                    map_set_surface_ownership(
+                        surfaceElement, surfaceElement->GetOwnership() | OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE);
                     uint16_t baseZ = surfaceElement->GetBaseZ();
                     map_invalidate_tile({ loc, baseZ, baseZ + 16 });
                 }
@@ -222,7 +230,7 @@ private:
                                 }),
                             gPeepSpawns.end());
                     }
-                    surfaceElement->SetOwnership(_ownership);
+                    map_set_surface_ownership(surfaceElement, _ownership);
                     update_park_fences_around_tile(loc);
                     gMapLandRightsUpdateSuccess = true;
                 }
@@ -66,7 +66,11 @@ public:
 
     GameActions::Result::Ptr Execute() const override
     {
-        return SmoothLand(true);
+        // Every tile of the area is invalidated, redraw them all at once
+        map_invalidate_batch_begin();
+        auto result = SmoothLand(true);
+        map_invalidate_batch_end();
+        return result;
     }
 
 private:
@@ -196,6 +196,7 @@ public:
         ride->lift_hill_speed = RideTypeDescriptors[ride->type].LiftData.minimum_speed;
 
         ride->measurement = {};
+        ride->measurement_recorder = {};
         ride->excitement = RIDE_RATING_UNDEFINED;
         ride->cur_num_customers = 0;
         ride->num_customers_timeout = 0;
@@ -238,6 +238,7 @@ private:
                     i--;
                 }
             }
+            park_update_guest_thought(peep);
         }
 
         MarketingCancelCampaignsForRide(_rideIndex);
@@ -249,6 +249,12 @@ public:
             case CheatType::AllowTrackPlaceInvalidHeights:
                 gCheatsAllowTrackPlaceInvalidHeights = _param1 != 0;
                 break;
+            case CheatType::PathfindingBudget:
+                gCheatsPathfindingBudget = static_cast<uint32_t>(_param1);
+                break;
+            case CheatType::RideRatingsPerTick:
+                gCheatsRideRatingsPerTick = static_cast<uint8_t>(_param1);
+                break;
             default:
             {
                 log_error("Unabled cheat: %d", _cheatType.id);
@@ -364,6 +370,10 @@ private:
                 return { { 0, 999 }, { 0, 0 } };
             case CheatType::CreateDucks:
                 return { { 0, 100 }, { 0, 0 } };
+            case CheatType::PathfindingBudget:
+                return { { 0, 10000000 }, { 0, 0 } };
+            case CheatType::RideRatingsPerTick:
+                return { { 0, MAX_RIDES }, { 0, 0 } };
             default:
                 return { { 0, 0 }, { 0, 0 } };
         }
@@ -672,15 +682,17 @@ private:
             }
         }
 
-        // Do not use the FOR_ALL_PEEPS macro for this as next sprite index
-        // will be fetched on a deleted peep.
+        // The rides no longer refer to any guest, so they can all be removed in one go.
+        std::vector<Guest*> guests;
         for (auto peep : EntityList<Peep>(EntityListId::Peep))
         {
-            if (peep->AssignedPeepType == PeepType::Guest)
+            auto guest = peep->AsGuest();
+            if (guest != nullptr)
             {
-                peep->Remove();
+                guests.push_back(guest);
             }
         }
+        peep_remove_guests_bulk(guests);
 
         window_invalidate_by_class(WC_RIDE);
         gfx_invalidate_screen();
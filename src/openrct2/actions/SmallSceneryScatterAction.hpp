@@ -0,0 +1,155 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../localisation/StringIds.h"
+#include "../management/Finance.h"
+#include "../world/Location.hpp"
+#include "GameAction.h"
+#include "SmallSceneryPlaceAction.hpp"
+
+#include <vector>
+
+/**
+ * Places a cluster of small scenery from the scatter tool as one action. Placements that can not be built are skipped,
+ * the action only fails if none of them could be placed.
+ */
+DEFINE_GAME_ACTION(SmallSceneryScatterAction, GAME_COMMAND_SCATTER_SCENERY, GameActions::Result)
+{
+public:
+    static constexpr size_t MaxPlacements = 64;
+
+private:
+    std::vector<CoordsXYZD> _locs;
+    std::vector<uint8_t> _quadrants;
+    ObjectEntryIndex _sceneryType{};
+    uint8_t _primaryColour{};
+    uint8_t _secondaryColour{};
+    // Number of heights tried for each placement, starting at its z and going up
+    uint8_t _zAttempts{ 1 };
+
+public:
+    SmallSceneryScatterAction() = default;
+
+    SmallSceneryScatterAction(
+        const std::vector<CoordsXYZD>& locs, const std::vector<uint8_t>& quadrants, ObjectEntryIndex sceneryType,
+        uint8_t primaryColour, uint8_t secondaryColour, uint8_t zAttempts)
+        : _locs(locs)
+        , _quadrants(quadrants)
+        , _sceneryType(sceneryType)
+        , _primaryColour(primaryColour)
+        , _secondaryColour(secondaryColour)
+        , _zAttempts(zAttempts)
+    {
+    }
+
+    uint32_t GetCooldownTime() const override
+    {
+        return 20;
+    }
+
+    void Serialise(DataSerialiser & stream) override
+    {
+        GameAction::Serialise(stream);
+
+        stream << DS_TAG(_locs) << DS_TAG(_quadrants) << DS_TAG(_sceneryType) << DS_TAG(_primaryColour)
+               << DS_TAG(_secondaryColour) << DS_TAG(_zAttempts);
+    }
+
+    GameActions::Result::Ptr Query() const override
+    {
+        return QueryExecute(false);
+    }
+
+    GameActions::Result::Ptr Execute() const override
+    {
+        return QueryExecute(true);
+    }
+
+private:
+    GameActions::Result::Ptr QueryExecute(bool executing) const
+    {
+        if (_locs.empty() || _locs.size() != _quadrants.size() || _locs.size() > MaxPlacements || _zAttempts == 0)
+        {
+            log_error("Invalid scenery cluster, placements: %u", static_cast<uint32_t>(_locs.size()));
+            return MakeResult(GameActions::Status::InvalidParameters, STR_CANT_POSITION_THIS_HERE);
+        }
+
+        auto result = MakeResult();
+        result->ErrorTitle = STR_CANT_POSITION_THIS_HERE;
+        result->Expenditure = ExpenditureType::Landscaping;
+
+        GameActions::Result::Ptr lastError;
+        money32 totalCost = 0;
+        bool placedAny = false;
+        for (size_t i = 0; i < _locs.size(); i++)
+        {
+            GameActions::Result::Ptr res;
+            auto placement = FindPlacement(_locs[i], _quadrants[i], res);
+            if (res->Error == GameActions::Status::Ok && !finance_check_affordability(totalCost + res->Cost, GetFlags()))
+            {
+                res->Error = GameActions::Status::InsufficientFunds;
+                res->ErrorTitle = STR_CANT_DO_THIS;
+                res->ErrorMessage = STR_NOT_ENOUGH_CASH_REQUIRES;
+                Formatter(res->ErrorMessageArgs.data()).Add<uint32_t>(totalCost + res->Cost);
+            }
+            if (res->Error == GameActions::Status::Ok && executing)
+            {
+                res = GameActions::ExecuteNested(&placement);
+            }
+
+            if (res->Error != GameActions::Status::Ok)
+            {
+                bool outOfMoney = res->Error == GameActions::Status::InsufficientFunds;
+                lastError = std::move(res);
+                if (outOfMoney)
+                    break;
+                continue;
+            }
+
+            if (!placedAny)
+            {
+                result->Position = res->Position;
+                placedAny = true;
+            }
+            totalCost += res->Cost;
+        }
+
+        if (!placedAny)
+        {
+            return lastError;
+        }
+
+        result->Cost = totalCost;
+        return result;
+    }
+
+    /**
+     * Returns the action for the first height that can be built at, or the last height tried, along with its query result.
+     */
+    SmallSceneryPlaceAction FindPlacement(const CoordsXYZD& loc, uint8_t quadrant, GameActions::Result::Ptr& queryResult) const
+    {
+        auto placeLoc = loc;
+        for (uint8_t attempt = 1;; attempt++)
+        {
+            auto action = SmallSceneryPlaceAction(placeLoc, quadrant, _sceneryType, _primaryColour, _secondaryColour);
+            action.SetFlags(GetFlags());
+
+            queryResult = GameActions::QueryNested(&action);
+            if (queryResult->Error == GameActions::Status::Ok
+                || queryResult->Error == GameActions::Status::InsufficientFunds || attempt >= _zAttempts)
+            {
+                return action;
+            }
+
+            placeLoc.z += 8;
+        }
+    }
+};
@@ -39,7 +39,7 @@ public:
 
     GameActions::Result::Ptr Query() const override
     {
-        if (_spriteId >= MAX_SPRITES)
+        if (_spriteId >= GetEntityCapacity())
         {
             log_error("Invalid spriteId. spriteId = %u", _spriteId);
             return MakeResult(GameActions::Status::InvalidParameters, STR_NONE);
@@ -246,10 +246,7 @@ private:
 
             gStaffModes[staffIndex] = StaffMode::Walk;
 
-            for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-            {
-                gStaffPatrolAreas[staffIndex * STAFF_PATROL_AREA_SIZE + i] = 0;
-            }
+            staff_get_patrol_area(staffIndex).Clear();
 
             res->peepSriteIndex = newPeep->sprite_index;
         }
@@ -50,7 +50,7 @@ public:
 
     GameActions::Result::Ptr Query() const override
     {
-        if (_spriteIndex >= MAX_SPRITES)
+        if (_spriteIndex >= GetEntityCapacity())
         {
             return std::make_unique<GameActions::Result>(
                 GameActions::Status::InvalidParameters, STR_STAFF_ERROR_CANT_NAME_STAFF_MEMBER, STR_NONE);
@@ -46,7 +46,7 @@ public:
 
     GameActions::Result::Ptr Query() const override
     {
-        if (_spriteIndex >= MAX_SPRITES)
+        if (_spriteIndex >= GetEntityCapacity())
         {
             return std::make_unique<GameActions::Result>(GameActions::Status::InvalidParameters, STR_NONE);
         }
@@ -42,7 +42,7 @@ public:
 
     GameActions::Result::Ptr Query() const override
     {
-        if (_spriteId >= MAX_SPRITES)
+        if (_spriteId >= GetEntityCapacity())
         {
             log_error("Invalid spriteId. spriteId = %u", _spriteId);
             return MakeResult(GameActions::Status::InvalidParameters, STR_NONE);
@@ -72,20 +72,9 @@ public:
             return MakeResult(GameActions::Status::InvalidParameters, STR_NONE);
         }
 
-        int32_t patrolOffset = staff->StaffId * STAFF_PATROL_AREA_SIZE;
-
         staff_toggle_patrol_area(staff->StaffId, _loc);
 
-        bool isPatrolling = false;
-        for (int32_t i = 0; i < 128; i++)
-        {
-            if (gStaffPatrolAreas[patrolOffset + i])
-            {
-                isPatrolling = true;
-                break;
-            }
-        }
-
+        bool isPatrolling = !staff_get_patrol_area(staff->StaffId).IsEmpty();
         if (isPatrolling)
         {
             gStaffModes[staff->StaffId] = StaffMode::Patrol;
@@ -44,7 +44,11 @@ public:
 
     GameActions::Result::Ptr Execute() const override
     {
-        return QueryExecute(true);
+        // Every tile of the area is invalidated, redraw them all at once
+        map_invalidate_batch_begin();
+        auto result = QueryExecute(true);
+        map_invalidate_batch_end();
+        return result;
     }
 
 private:
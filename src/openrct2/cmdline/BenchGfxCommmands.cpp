@@ -10,12 +10,36 @@
 #include "../interface/Screenshot.h"
 #include "CommandLine.hpp"
 
+static GfxBenchOptions _options;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition BenchGfxOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_options.warmup,      NAC, "warmup",      "number of renders before measuring (default 2)" },
+    { CMDLINE_TYPE_INTEGER, &_options.repetitions, NAC, "repetitions", "number of measured renders (default 10)"      },
+    { CMDLINE_TYPE_INTEGER, &_options.zoom,        NAC, "zoom",        "only measure this zoom level"                  },
+    { CMDLINE_TYPE_INTEGER, &_options.rotation,    NAC, "rotation",    "only measure this rotation"                    },
+    { CMDLINE_TYPE_STRING,  &_options.json_path,   NAC, "json",        "write the results to a JSON file"              },
+    OptionTableEnd
+};
+
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchGfxGenerate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchGfxArrange(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchGfxDraw(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchGfxFrame(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::BenchGfxCommands[]{
+const CommandLineCommand CommandLine::BenchGfxCommands[]
+{
     // Main commands
-    DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx), CommandTableEnd
+    DefineCommand("",         "<file> [iterations count]", nullptr,            HandleBenchGfx        ),
+    DefineCommand("generate", "<file>...",                 BenchGfxOptionsDef, HandleBenchGfxGenerate),
+    DefineCommand("arrange",  "<file>...",                 BenchGfxOptionsDef, HandleBenchGfxArrange ),
+    DefineCommand("draw",     "<file>...",                 BenchGfxOptionsDef, HandleBenchGfxDraw    ),
+    DefineCommand("frame",    "<file>...",                 BenchGfxOptionsDef, HandleBenchGfxFrame   ),
+    CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator)
 {
@@ -28,3 +52,35 @@ static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator)
     }
     return EXITCODE_OK;
 }
+
+static exitcode_t HandleBenchGfxPhase(CommandLineArgEnumerator* argEnumerator, GfxBenchPhase phase)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_gfxbench_phase(argv, argc, phase, &_options);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchGfxGenerate(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleBenchGfxPhase(argEnumerator, GfxBenchPhase::Generate);
+}
+
+static exitcode_t HandleBenchGfxArrange(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleBenchGfxPhase(argEnumerator, GfxBenchPhase::Arrange);
+}
+
+static exitcode_t HandleBenchGfxDraw(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleBenchGfxPhase(argEnumerator, GfxBenchPhase::Draw);
+}
+
+static exitcode_t HandleBenchGfxFrame(CommandLineArgEnumerator* argEnumerator)
+{
+    return HandleBenchGfxPhase(argEnumerator, GfxBenchPhase::Frame);
+}
@@ -0,0 +1,240 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/DataSerialiser.h"
+#    include "../core/MemoryStream.h"
+#    include "../world/Sprite.h"
+
+#    include <array>
+#    include <benchmark/benchmark.h>
+#    include <cstring>
+#    include <vector>
+
+// Sprites as the game state snapshots store them, each one an array of the bytes of a peep
+static constexpr size_t NumSnapshotSprites = 4096;
+struct SnapshotSprite
+{
+    uint8_t Bytes[sizeof(Peep)];
+};
+
+// A replay command carrying a list of tiles, in the same shape as the game actions that take one
+static constexpr size_t NumReplayValues = 16384;
+
+template<typename T> static void fill_pattern(T* values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = static_cast<T>(i * 2654435761u);
+    }
+}
+
+// Encodes the elements one at a time, the way the traits did before the bulk copies
+template<typename T> static void encode_elements(DataSerialiser& ds, const T* values, size_t count)
+{
+    uint16_t len = ByteSwapBE(static_cast<uint16_t>(count));
+    ds.GetStream().Write(&len);
+    for (size_t i = 0; i < count; i++)
+    {
+        ds << values[i];
+    }
+}
+
+static std::vector<SnapshotSprite> create_snapshot_sprites()
+{
+    std::vector<SnapshotSprite> sprites(NumSnapshotSprites);
+    for (auto& sprite : sprites)
+    {
+        fill_pattern(sprite.Bytes, std::size(sprite.Bytes));
+    }
+    return sprites;
+}
+
+static std::vector<uint32_t> create_replay_values()
+{
+    std::vector<uint32_t> values(NumReplayValues);
+    fill_pattern(values.data(), values.size());
+    return values;
+}
+
+// Checks that the bulk copies encode the same bytes as the elements encoded one at a time
+static bool validate_bulk_encoding()
+{
+    auto sprites = create_snapshot_sprites();
+    DataSerialiser bulkSprite(true);
+    DataSerialiser elementSprite(true);
+    bulkSprite << sprites[0].Bytes;
+    encode_elements(elementSprite, sprites[0].Bytes, std::size(sprites[0].Bytes));
+
+    auto values = create_replay_values();
+    DataSerialiser bulkValues(true);
+    DataSerialiser elementValues(true);
+    bulkValues << values;
+    encode_elements(elementValues, values.data(), values.size());
+
+    auto equal = [](DataSerialiser& a, DataSerialiser& b) {
+        auto& streamA = static_cast<OpenRCT2::MemoryStream&>(a.GetStream());
+        auto& streamB = static_cast<OpenRCT2::MemoryStream&>(b.GetStream());
+        return streamA.GetLength() == streamB.GetLength()
+            && std::memcmp(streamA.GetData(), streamB.GetData(), streamA.GetLength()) == 0;
+    };
+    if (!equal(bulkSprite, elementSprite) || !equal(bulkValues, elementValues))
+    {
+        log_error("The bulk copies encode different bytes than the elements encoded one at a time.");
+        return false;
+    }
+
+    DataSerialiser loader(false, bulkValues.GetStream());
+    loader.GetStream().SetPosition(0);
+    std::vector<uint32_t> decoded;
+    loader << decoded;
+    if (decoded != values)
+    {
+        log_error("The bulk copies do not decode the values they encoded.");
+        return false;
+    }
+    return true;
+}
+
+static void BM_serialise_snapshot(benchmark::State& state, bool bulk)
+{
+    auto sprites = create_snapshot_sprites();
+    for (auto _ : state)
+    {
+        DataSerialiser ds(true);
+        for (const auto& sprite : sprites)
+        {
+            if (bulk)
+                ds << sprite.Bytes;
+            else
+                encode_elements(ds, sprite.Bytes, std::size(sprite.Bytes));
+        }
+        benchmark::DoNotOptimize(ds.GetStream().GetLength());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(SnapshotSprite) * NumSnapshotSprites);
+}
+
+static void BM_deserialise_snapshot(benchmark::State& state)
+{
+    auto sprites = create_snapshot_sprites();
+    DataSerialiser encoded(true);
+    for (const auto& sprite : sprites)
+    {
+        encoded << sprite.Bytes;
+    }
+
+    for (auto _ : state)
+    {
+        DataSerialiser ds(false, encoded.GetStream());
+        ds.GetStream().SetPosition(0);
+        for (auto& sprite : sprites)
+        {
+            ds << sprite.Bytes;
+        }
+        benchmark::DoNotOptimize(sprites.data());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(SnapshotSprite) * NumSnapshotSprites);
+}
+
+static void BM_serialise_replay(benchmark::State& state, bool bulk)
+{
+    auto values = create_replay_values();
+    for (auto _ : state)
+    {
+        DataSerialiser ds(true);
+        if (bulk)
+            ds << values;
+        else
+            encode_elements(ds, values.data(), values.size());
+        benchmark::DoNotOptimize(ds.GetStream().GetLength());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(uint32_t) * NumReplayValues);
+}
+
+static void BM_deserialise_replay(benchmark::State& state)
+{
+    auto values = create_replay_values();
+    DataSerialiser encoded(true);
+    encoded << values;
+
+    for (auto _ : state)
+    {
+        DataSerialiser ds(false, encoded.GetStream());
+        ds.GetStream().SetPosition(0);
+        std::vector<uint32_t> decoded;
+        ds << decoded;
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(uint32_t) * NumReplayValues);
+}
+
+static int cmdline_for_bench_serialiser(int argc, const char** argv)
+{
+    if (!validate_bulk_encoding())
+    {
+        return -1;
+    }
+
+    benchmark::RegisterBenchmark("serialise/snapshot/elements", BM_serialise_snapshot, false);
+    benchmark::RegisterBenchmark("serialise/snapshot/bulk", BM_serialise_snapshot, true);
+    benchmark::RegisterBenchmark("deserialise/snapshot/bulk", BM_deserialise_snapshot);
+    benchmark::RegisterBenchmark("serialise/replay/elements", BM_serialise_replay, false);
+    benchmark::RegisterBenchmark("serialise/replay/bulk", BM_serialise_replay, true);
+    benchmark::RegisterBenchmark("deserialise/replay/bulk", BM_deserialise_replay);
+
+    // Google benchmark reorders the pointers in argv, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSerialiser(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_serialiser(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSerialiser(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSerialiserCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>]",
+        nullptr, HandleBenchSerialiser),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSerialiser), CommandTableEnd
+#endif // USE_BENCHMARK
+};
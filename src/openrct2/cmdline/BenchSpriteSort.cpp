@@ -34,42 +34,31 @@
 #    include <iterator>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+static void fixup_pointers(std::vector<RecordedPaintSession>& s)
 {
-    for (size_t i = 0; i < paint_session_entries; i++)
+    for (auto& recordedSession : s)
     {
-        for (size_t j = 0; j < paint_struct_entries; j++)
+        auto& entries = recordedSession.Entries;
+        const auto entriesSize = entries.size();
+        for (auto& entry : entries)
         {
-            if (s[i].PaintStructs[j].basic.next_quadrant_ps == reinterpret_cast<paint_struct*>(paint_struct_entries))
-            {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = nullptr;
-            }
-            else
-            {
-                auto nextQuadrantPs = reinterpret_cast<uintptr_t>(s[i].PaintStructs[j].basic.next_quadrant_ps);
-                s[i].PaintStructs[j].basic.next_quadrant_ps = &s[i].PaintStructs[nextQuadrantPs].basic;
-            }
+            auto nextQuadrantPs = reinterpret_cast<size_t>(entry.basic.next_quadrant_ps);
+            entry.basic.next_quadrant_ps = nextQuadrantPs < entriesSize ? &entries[nextQuadrantPs].basic : nullptr;
         }
-        for (size_t j = 0; j < quadrant_entries; j++)
+        for (auto& quadrant : recordedSession.Session.Quadrants)
         {
-            if (s[i].Quadrants[j] == reinterpret_cast<paint_struct*>(quadrant_entries))
-            {
-                s[i].Quadrants[j] = nullptr;
-            }
-            else
-            {
-                s[i].Quadrants[j] = &s[i].PaintStructs[reinterpret_cast<size_t>(s[i].Quadrants[j])].basic;
-            }
+            auto quadrantIndex = reinterpret_cast<size_t>(quadrant);
+            quadrant = quadrantIndex < entriesSize ? &entries[quadrantIndex].basic : nullptr;
         }
     }
 }
 
-static std::vector<paint_session> extract_paint_session(const std::string parkFileName)
+static std::vector<RecordedPaintSession> extract_paint_session(const std::string parkFileName)
 {
     core_init();
     gOpenRCT2Headless = true;
     auto context = OpenRCT2::CreateContext();
-    std::vector<paint_session> sessions;
+    std::vector<RecordedPaintSession> sessions;
     log_info("Starting...");
     if (context->Initialise())
     {
@@ -132,42 +121,95 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
     return sessions;
 }
 
+static std::vector<size_t> arrange_recorded_session(const RecordedPaintSession& recordedSession, PaintSortMethod method)
+{
+    std::vector<RecordedPaintSession> sessions{ recordedSession };
+    fixup_pointers(sessions);
+    auto& entries = sessions[0].Entries;
+    paint_session session;
+    static_cast<paint_session_core&>(session) = sessions[0].Session;
+
+    auto previousMethod = gPaintSortMethod;
+    gPaintSortMethod = method;
+    paint_session_arrange(&session);
+    gPaintSortMethod = previousMethod;
+
+    std::vector<size_t> order;
+    for (auto ps = session.PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+    {
+        order.push_back(reinterpret_cast<paint_entry*>(ps) - entries.data());
+    }
+    return order;
+}
+
+// Checks that the indexed sort draws the recorded sessions in the same order as the legacy one
+static bool validate_sort_methods(const char* name, const std::vector<RecordedPaintSession>& sessions)
+{
+    size_t mismatches = 0;
+    for (const auto& session : sessions)
+    {
+        if (arrange_recorded_session(session, PaintSortMethod::Legacy)
+            != arrange_recorded_session(session, PaintSortMethod::Indexed))
+        {
+            mismatches++;
+        }
+    }
+    if (mismatches != 0)
+    {
+        log_error("%s: %zu of %zu sessions sorted differently by the indexed sort.", name, mismatches, std::size(sessions));
+        return false;
+    }
+    log_info("%s: indexed sort matches legacy sort for all %zu sessions.", name, std::size(sessions));
+    return true;
+}
+
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions, PaintSortMethod method)
 {
-    std::vector<paint_session> sessions = inputSessions;
+    std::vector<RecordedPaintSession> sessions = inputSessions;
     // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
     // Keep in mind we need bit-exact copy, as the lists use pointers.
     // Once sorted, just restore the copy with the original fixed-up version.
-    paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
-    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+    fixup_pointers(sessions);
+    const std::vector<RecordedPaintSession> localSessions = sessions;
+    std::vector<paint_session> paintSessions(std::size(sessions));
+    auto previousMethod = gPaintSortMethod;
+    gPaintSortMethod = method;
     for (auto _ : state)
     {
         state.PauseTiming();
-        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        for (size_t i = 0; i < std::size(sessions); i++)
+        {
+            std::copy(localSessions[i].Entries.cbegin(), localSessions[i].Entries.cend(), sessions[i].Entries.begin());
+            static_cast<paint_session_core&>(paintSessions[i]) = localSessions[i].Session;
+        }
         state.ResumeTiming();
-        paint_session_arrange(&sessions[0]);
-        benchmark::DoNotOptimize(sessions);
+        paint_session_arrange(&paintSessions[0]);
+        benchmark::DoNotOptimize(paintSessions);
     }
+    gPaintSortMethod = previousMethod;
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
-    delete[] local_s;
+}
+
+static void register_benchmarks(const std::string& name, const std::vector<RecordedPaintSession>& sessions)
+{
+    benchmark::RegisterBenchmark(name.c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::Automatic);
+    benchmark::RegisterBenchmark((name + " (legacy)").c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::Legacy);
+    benchmark::RegisterBenchmark(
+        (name + " (indexed)").c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::Indexed);
 }
 
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
         // Register some basic "baseline" benchmark
-        std::vector<paint_session> sessions(1);
-        for (auto& ps : sessions[0].PaintStructs)
+        std::vector<RecordedPaintSession> sessions(1);
+        for (auto& quad : sessions[0].Session.Quadrants)
         {
-            ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>((std::size(sessions[0].PaintStructs)));
+            quad = reinterpret_cast<paint_struct*>((std::size(sessions[0].Entries)));
         }
-        for (auto& quad : sessions[0].Quadrants)
-        {
-            quad = reinterpret_cast<paint_struct*>((std::size(sessions[0].Quadrants)));
-        }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        register_benchmarks("baseline", sessions);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -178,14 +220,18 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
     argv_for_benchmark.push_back(nullptr);
 
     // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    bool sortMethodsMatch = true;
     for (int i = 0; i < argc; i++)
     {
         if (Platform::FileExists(argv[i]))
         {
             // Register benchmark for sv6 if valid
-            std::vector<paint_session> sessions = extract_paint_session(argv[i]);
+            std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                sortMethodsMatch &= validate_sort_methods(argv[i], sessions);
+                register_benchmarks(argv[i], sessions);
+            }
         }
         else
         {
@@ -198,7 +244,7 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
     if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
         return -1;
     ::benchmark::RunSpecifiedBenchmarks();
-    return 0;
+    return sortMethodsMatch ? 0 : -1;
 }
 
 static exitcode_t HandleBenchSpriteSort(CommandLineArgEnumerator* argEnumerator)
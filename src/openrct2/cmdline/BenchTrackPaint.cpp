@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/String.hpp"
+#    include "../ride/Ride.h"
+#    include "../ride/RideData.h"
+#    include "../ride/Track.h"
+#    include "../ride/TrackPaint.h"
+
+#    include <benchmark/benchmark.h>
+#    include <vector>
+
+// Looks up the paint function of every track type the way track_paint did before the lookup tables.
+static void BM_track_paint_getter(benchmark::State& state, uint8_t rideType)
+{
+    TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = RideTypeDescriptors[rideType].TrackPaintFunction;
+    for (auto _ : state)
+    {
+        for (int32_t trackType = 0; trackType < TrackElemType::Count; trackType++)
+        {
+            benchmark::DoNotOptimize(paintFunctionGetter(trackType));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * TrackElemType::Count);
+}
+
+static void BM_track_paint_table(benchmark::State& state, uint8_t rideType)
+{
+    for (auto _ : state)
+    {
+        for (int32_t trackType = 0; trackType < TrackElemType::Count; trackType++)
+        {
+            benchmark::DoNotOptimize(track_paint_get_function(rideType, trackType));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * TrackElemType::Count);
+}
+
+static int cmdline_for_bench_track_paint(int argc, const char** argv)
+{
+    for (uint8_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+    {
+        const auto& rtd = RideTypeDescriptors[rideType];
+        if (rtd.Category != RIDE_CATEGORY_ROLLERCOASTER || rtd.TrackPaintFunction == nullptr)
+            continue;
+
+        auto name = String::StdFormat("track_paint/%u", rideType);
+        benchmark::RegisterBenchmark((name + "/getter").c_str(), BM_track_paint_getter, rideType);
+        benchmark::RegisterBenchmark((name + "/table").c_str(), BM_track_paint_table, rideType);
+    }
+
+    // Google benchmark reorders the pointers in argv, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchTrackPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_track_paint(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchTrackPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchTrackPaintCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>]",
+        nullptr, HandleBenchTrackPaint),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchTrackPaint), CommandTableEnd
+#endif // USE_BENCHMARK
+};
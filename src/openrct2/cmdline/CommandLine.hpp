@@ -118,6 +118,8 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
+    extern const CommandLineCommand BenchTrackPaintCommands[];
+    extern const CommandLineCommand BenchSerialiserCommands[];
     extern const CommandLineCommand SimulateCommands[];
 
     extern const CommandLineExample RootExamples[];
@@ -126,5 +128,6 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
+    exitcode_t HandleCommandGenerateMap(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
 } // namespace CommandLine
@@ -7,18 +7,33 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../FileClassifier.h"
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/FileScanner.h"
 #include "../core/Path.hpp"
 #include "../interface/Window.h"
+#include "../object/ObjectManager.h"
+#include "../platform/platform.h"
 #include "../rct2/S6Exporter.h"
+#include "../scenario/Scenario.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
+using namespace OpenRCT2;
+
+static exitcode_t ConvertDirectory(const utf8* sourceDirectory, const utf8* destinationDirectory);
+static std::unique_ptr<IContext> CreateConvertContext();
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType);
 static const utf8* GetFileTypeFriendlyName(uint32_t fileType);
 
@@ -54,6 +69,12 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     Path::GetAbsolute(destinationPath, sizeof(sourcePath), rawDestinationPath);
     uint32_t destinationFileType = get_file_extension_type(destinationPath);
 
+    // Every RCT1 park in a directory is converted in one go
+    if (Path::DirectoryExists(sourcePath))
+    {
+        return ConvertDirectory(sourcePath, destinationPath);
+    }
+
     // Validate target type
     if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6)
     {
@@ -89,12 +110,21 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     // Perform conversion
     WriteConvertFromAndToMessage(sourceFileType, destinationFileType);
 
-    gOpenRCT2Headless = true;
+    auto context = CreateConvertContext();
+    if (context == nullptr)
+    {
+        return EXITCODE_FAIL;
+    }
 
     try
     {
         auto importer = ParkImporter::Create(sourcePath);
-        importer->Load(sourcePath);
+        auto loadResult = importer->Load(sourcePath);
+        if (sourceFileType == FILE_EXTENSION_SC6 || sourceFileType == FILE_EXTENSION_SV6)
+        {
+            // RCT1 parks load their own objects when imported
+            context->GetObjectManager().LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
+        }
         importer->Import();
     }
     catch (const std::exception& ex)
@@ -137,6 +167,155 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     return EXITCODE_OK;
 }
 
+/**
+ * Converts all RCT1 parks in the source directory and its sub directories to RCT2 parks of the same name in the
+ * destination directory. The parks have to be imported and exported one at a time as they use the game state, but
+ * the next parks are read and decoded and the previous ones encoded and written on other threads in the meantime.
+ * Objects used by one park are kept loaded for the next.
+ */
+static exitcode_t ConvertDirectory(const utf8* sourceDirectory, const utf8* destinationDirectory)
+{
+    struct PendingConversion
+    {
+        std::string SourcePath;
+        std::string DestinationPath;
+        bool IsScenario;
+        std::unique_ptr<IParkImporter> Importer;
+        std::future<void> Load;
+    };
+
+    auto context = CreateConvertContext();
+    if (context == nullptr)
+    {
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<PendingConversion> conversions;
+    {
+        auto pattern = Path::Combine(sourceDirectory, "*.sc4;*.sv4");
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(pattern, true));
+        while (scanner->Next())
+        {
+            PendingConversion conversion;
+            conversion.SourcePath = scanner->GetPath();
+            conversion.IsScenario = get_file_extension_type(scanner->GetPath()) == FILE_EXTENSION_SC4;
+            auto relativePath = Path::GetFileNameWithoutExtension(std::string(scanner->GetPathRelative()));
+            auto relativeDirectory = Path::GetDirectory(std::string(scanner->GetPathRelative()));
+            conversion.DestinationPath = Path::Combine(
+                destinationDirectory, relativeDirectory, relativePath + (conversion.IsScenario ? ".sc6" : ".sv6"));
+            conversions.push_back(std::move(conversion));
+        }
+    }
+    if (conversions.empty())
+    {
+        Console::Error::WriteLine("No .SC4 or .SV4 files found in '%s'.", sourceDirectory);
+        return EXITCODE_FAIL;
+    }
+    Console::WriteLine("Converting %u RollerCoaster Tycoon 1 parks.", static_cast<uint32_t>(conversions.size()));
+
+    // Bounds the number of decoded and exported parks held in memory at once
+    const size_t maxInFlight = std::max(1u, std::thread::hardware_concurrency());
+
+    size_t numLoadsStarted = 0;
+    auto startLoads = [&](size_t upTo) {
+        for (; numLoadsStarted < std::min(upTo, conversions.size()); numLoadsStarted++)
+        {
+            auto& conversion = conversions[numLoadsStarted];
+            conversion.Importer = ParkImporter::CreateS4();
+            conversion.Load = std::async(std::launch::async, [importer = conversion.Importer.get(), &conversion]() {
+                importer->Load(conversion.SourcePath.c_str());
+            });
+        }
+    };
+
+    size_t numConverted = 0;
+    std::deque<std::pair<const PendingConversion*, std::future<void>>> saves;
+    auto finishSave = [&]() {
+        auto& [conversion, save] = saves.front();
+        try
+        {
+            save.get();
+            Console::WriteLine("Converted '%s'.", conversion->SourcePath.c_str());
+            numConverted++;
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to write '%s': %s", conversion->DestinationPath.c_str(), e.what());
+        }
+        saves.pop_front();
+    };
+
+    for (size_t i = 0; i < conversions.size(); i++)
+    {
+        startLoads(i + maxInFlight);
+
+        auto& conversion = conversions[i];
+        std::unique_ptr<S6Exporter> exporter;
+        try
+        {
+            conversion.Load.get();
+            conversion.Importer->Import();
+            conversion.Importer = nullptr;
+            if (conversion.IsScenario)
+            {
+                // We are converting a scenario, so reset the park
+                scenario_begin();
+            }
+
+            exporter = std::make_unique<S6Exporter>();
+            window_close_by_class(WC_MAIN_WINDOW);
+            exporter->Export();
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to convert '%s': %s", conversion.SourcePath.c_str(), e.what());
+            conversion.Importer = nullptr;
+            continue;
+        }
+
+        // The exporter holds everything it saves, the next park can be imported while it is written
+        while (saves.size() >= maxInFlight)
+        {
+            finishSave();
+        }
+        auto save = std::async(
+            std::launch::async, [exporter = std::move(exporter), &conversion]() {
+                platform_ensure_directory_exists(Path::GetDirectory(conversion.DestinationPath).c_str());
+                if (conversion.IsScenario)
+                {
+                    exporter->SaveScenario(conversion.DestinationPath.c_str());
+                }
+                else
+                {
+                    exporter->SaveGame(conversion.DestinationPath.c_str());
+                }
+            });
+        saves.emplace_back(&conversion, std::move(save));
+    }
+    while (!saves.empty())
+    {
+        finishSave();
+    }
+
+    Console::WriteLine(
+        "Converted %u of %u parks.", static_cast<uint32_t>(numConverted), static_cast<uint32_t>(conversions.size()));
+    return numConverted == conversions.size() ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static std::unique_ptr<IContext> CreateConvertContext()
+{
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return nullptr;
+    }
+    return context;
+}
+
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType)
 {
     const utf8* sourceFileTypeName = GetFileTypeFriendlyName(sourceFileType);
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Editor.h"
+#include "../FileClassifier.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../common.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../localisation/Localisation.h"
+#include "../object/ObjectManager.h"
+#include "../platform/platform.h"
+#include "../scenario/Scenario.h"
+#include "../util/Util.h"
+#include "../world/Map.h"
+#include "../world/MapGen.h"
+#include "../world/Park.h"
+#include "CommandLine.hpp"
+
+#include <memory>
+
+using namespace OpenRCT2;
+
+exitcode_t CommandLine::HandleCommandGenerateMap(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    // Get the destination path
+    const utf8* rawDestinationPath;
+    if (!enumerator->TryPopString(&rawDestinationPath))
+    {
+        Console::Error::WriteLine("Expected a destination path.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 destinationPath[MAX_PATH];
+    Path::GetAbsolute(destinationPath, sizeof(destinationPath), rawDestinationPath);
+    if (get_file_extension_type(destinationPath) != FILE_EXTENSION_SC6)
+    {
+        Console::Error::WriteLine("Only saving to a .SC6 landscape is supported.");
+        return EXITCODE_FAIL;
+    }
+
+    // Same default size as the map generator window, given without the black edge like it is shown there
+    int32_t mapSize = 150;
+    int32_t practicalMapSize;
+    if (enumerator->TryPopInteger(&practicalMapSize))
+    {
+        if (practicalMapSize < MINIMUM_MAP_SIZE_PRACTICAL || practicalMapSize > MAXIMUM_MAP_SIZE_PRACTICAL)
+        {
+            Console::Error::WriteLine(
+                "The map size must be between %d and %d.", MINIMUM_MAP_SIZE_PRACTICAL, MAXIMUM_MAP_SIZE_PRACTICAL);
+            return EXITCODE_FAIL;
+        }
+        mapSize = practicalMapSize + 2;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // Set up the scenario editor the way Editor::Load does, without its windows
+    context->GetObjectManager().LoadDefaultObjects();
+    context->GetGameState()->InitAll(mapSize);
+    gScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR;
+    gS6Info.editor_step = EDITOR_STEP_LANDSCAPE_EDITOR;
+    gParkFlags |= PARK_FLAGS_SHOW_REAL_GUEST_NAMES;
+    gS6Info.category = SCENARIO_CATEGORY_OTHER;
+    gScenarioName = language_get_string(STR_MY_NEW_SCENARIO);
+
+    // Same settings as the random page of the map generator window
+    mapgen_settings settings{};
+    settings.mapSize = mapSize;
+    settings.height = 12 + 2;
+    settings.water_level = 6 + 2;
+    settings.floor = -1;
+    settings.wall = -1;
+    settings.trees = 1;
+    settings.simplex_low = util_rand() % 4;
+    settings.simplex_high = 12 + (util_rand() % (32 - 12));
+    settings.simplex_base_freq = 1.75f;
+    settings.simplex_octaves = 6;
+
+    Console::WriteLine("Generating a %d x %d map...", mapSize - 2, mapSize - 2);
+    mapgen_generate(&settings);
+
+    // Saved the same way as saving a landscape from the editor
+    if (!scenario_save(destinationPath, 2))
+    {
+        Console::Error::WriteLine("Unable to save the map to '%s'.", destinationPath);
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("Map saved to '%s'.", destinationPath);
+    return EXITCODE_OK;
+}
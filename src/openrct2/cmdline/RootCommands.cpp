@@ -10,6 +10,7 @@
 #include "../Context.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
+#include "../StartupTrace.h"
 #include "../Version.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
@@ -40,9 +41,11 @@ int32_t gNetworkStart = NETWORK_MODE_NONE;
 std::string gNetworkStartHost;
 int32_t gNetworkStartPort = NETWORK_DEFAULT_PORT;
 std::string gNetworkStartAddress;
+int32_t gNetworkStartRelayPort = 0;
 
 static uint32_t _port = 0;
 static char* _address = nullptr;
+static uint32_t _relayPort = 0;
 #endif
 
 static bool _help = false;
@@ -57,6 +60,7 @@ static utf8* _userDataPath = nullptr;
 static utf8* _openrct2DataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
+static utf8* _startupTracePath = nullptr;
 static bool _silentBreakpad = false;
 
 // clang-format off
@@ -71,13 +75,15 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_SWITCH,  &_headless,         NAC, "headless",           "run " OPENRCT2_NAME " headless" IMPLIES_SILENT_BREAKPAD     },
 #ifndef DISABLE_NETWORK                                                    
     { CMDLINE_TYPE_INTEGER, &_port,             NAC, "port",               "port to use for hosting or joining a server"                },
-    { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server"                 },
+    { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server or relay"        },
+    { CMDLINE_TYPE_INTEGER, &_relayPort,        NAC, "relay-port",         "port a relay listens on for its clients"                    },
 #endif                                                                     
     { CMDLINE_TYPE_STRING,  &_password,         NAC, "password",           "password needed to join the server"                         },
     { CMDLINE_TYPE_STRING,  &_userDataPath,     NAC, "user-data-path",     "path to the user data directory (containing config.ini)"    },
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, NAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     NAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     NAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_startupTracePath, NAC, "startup-trace",      "write a Chrome trace of the startup to the given path"      },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -90,6 +96,7 @@ static exitcode_t HandleCommandIntro(CommandLineArgEnumerator * enumerator);
 #ifndef DISABLE_NETWORK
 static exitcode_t HandleCommandHost(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandJoin(CommandLineArgEnumerator * enumerator);
+static exitcode_t HandleCommandRelay(CommandLineArgEnumerator * enumerator);
 #endif
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandScanObjects(CommandLineArgEnumerator * enumerator);
@@ -125,9 +132,11 @@ const CommandLineCommand CommandLine::RootCommands[]
 #ifndef DISABLE_NETWORK
     DefineCommand("host",     "<uri>",                  StandardOptions, HandleCommandHost   ),
     DefineCommand("join",     "<hostname>",             StandardOptions, HandleCommandJoin   ),
+    DefineCommand("relay",    "<hostname>",             StandardOptions, HandleCommandRelay  ),
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
+    DefineCommand("generate-map", "<destination> [size]", StandardOptions, CommandLine::HandleCommandGenerateMap),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
     DefineCommand("handle-uri", "openrct2://.../",      StandardOptions, CommandLine::HandleCommandUri),
 
@@ -140,6 +149,8 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
+    DefineSubCommand("benchtrackpaint", CommandLine::BenchTrackPaintCommands  ),
+    DefineSubCommand("benchserialiser", CommandLine::BenchSerialiserCommands  ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
     CommandTableEnd
 };
@@ -154,6 +165,7 @@ const CommandLineExample CommandLine::RootExamples[]
 #endif
 #ifndef DISABLE_NETWORK
     { "host ./my_park.sv6 --port 11753 --headless",   "run a headless server for a saved park" },
+    { "relay example.com --headless",                 "relay a server to more clients"         },
 #endif
     ExampleTableEnd
 };
@@ -230,6 +242,14 @@ exitcode_t CommandLine::HandleCommandDefault()
         Memory::Free(_password);
     }
 
+    if (_startupTracePath != nullptr)
+    {
+        utf8 absolutePath[MAX_PATH]{};
+        Path::GetAbsolute(absolutePath, std::size(absolutePath), _startupTracePath);
+        startup_trace_start(absolutePath);
+        Memory::Free(_startupTracePath);
+    }
+
     return result;
 }
 
@@ -331,6 +351,19 @@ exitcode_t HandleCommandJoin(CommandLineArgEnumerator* enumerator)
     return EXITCODE_CONTINUE;
 }
 
+exitcode_t HandleCommandRelay(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = HandleCommandJoin(enumerator);
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    gNetworkStartRelayPort = _relayPort != 0 ? _relayPort : NETWORK_DEFAULT_PORT;
+    gNetworkStartAddress = String::ToStd(_address);
+    return EXITCODE_CONTINUE;
+}
+
 #endif // DISABLE_NETWORK
 
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator* enumerator)
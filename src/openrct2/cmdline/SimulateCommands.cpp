@@ -11,22 +11,105 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../PlatformEnvironment.h"
+#include "../ReplayManager.h"
+#include "../TickProfiler.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../drawing/NewDrawing.h"
+#include "../interface/Screenshot.h"
 #include "../network/network.h"
+#include "../platform/Platform2.h"
 #include "../platform/platform.h"
+#include "../world/Map.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <ctime>
 #include <memory>
+#include <thread>
 
 using namespace OpenRCT2;
 
+struct SimulateBenchOptions
+{
+    int32_t warmup = 100;
+    int32_t ticks = 1000;
+    int32_t repetitions = 3;
+    utf8* json_path = nullptr;
+};
+
+struct SimulateBatchOptions
+{
+    int32_t ticks = 1000;
+    int32_t jobs = 0;
+    utf8* json_path = nullptr;
+};
+
+struct SimulateReplayOptions
+{
+    int32_t render_interval = 100;
+    float threshold = 10;
+    utf8* baseline_path = nullptr;
+    utf8* json_path = nullptr;
+};
+
+static SimulateBenchOptions _benchOptions;
+static SimulateBatchOptions _batchOptions;
+static SimulateReplayOptions _replayOptions;
+
+static constexpr const char* BENCH_PARK_PATTERN = "*.sv6;*.sc6;*.sv4;*.sc4";
+static constexpr const char* BENCH_REPLAY_PATTERN = "*.sv6r";
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateBenchOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchOptions.warmup,      NAC, "warmup",      "number of ticks before measuring (default 100)" },
+    { CMDLINE_TYPE_INTEGER, &_benchOptions.ticks,       NAC, "ticks",       "number of measured ticks (default 1000)"        },
+    { CMDLINE_TYPE_INTEGER, &_benchOptions.repetitions, NAC, "repetitions", "number of runs of each park (default 3)"        },
+    { CMDLINE_TYPE_STRING,  &_benchOptions.json_path,   NAC, "json",        "write the results to a JSON file"               },
+    OptionTableEnd
+};
+
+static constexpr const CommandLineOptionDefinition SimulateBatchOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_batchOptions.ticks,     NAC, "ticks", "number of ticks for each park (default 1000)"      },
+    { CMDLINE_TYPE_INTEGER, &_batchOptions.jobs,      NAC, "jobs",  "parks simulated at once (default number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_batchOptions.json_path, NAC, "json",  "write the results to a JSON file"                  },
+    OptionTableEnd
+};
+
+static constexpr const CommandLineOptionDefinition SimulateReplayOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_replayOptions.render_interval, NAC, "render-interval", "ticks between renders (default 100)" },
+    { CMDLINE_TYPE_REAL,    &_replayOptions.threshold,       NAC, "threshold",       "allowed slowdown in % (default 10)"  },
+    { CMDLINE_TYPE_STRING,  &_replayOptions.baseline_path,   NAC, "baseline",        "JSON results to compare with"        },
+    { CMDLINE_TYPE_STRING,  &_replayOptions.json_path,       NAC, "json",            "write the results to a JSON file"    },
+    OptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBench(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateReplay(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("",       "<file> <ticks>",      nullptr,                  HandleSimulate      ),
+    DefineCommand("bench",  "<file|directory>...", SimulateBenchOptionsDef,  HandleSimulateBench ),
+    DefineCommand("batch",  "<file|directory>...", SimulateBatchOptionsDef,  HandleSimulateBatch ),
+    DefineCommand("replay", "<file|directory>...", SimulateReplayOptionsDef, HandleSimulateReplay),
+    CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -73,3 +156,511 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+static std::vector<std::string> GetBenchFiles(const char** argv, int32_t argc, const char* pattern)
+{
+    // Options come last, everything before them is a file or a directory of files
+    std::vector<std::string> parks;
+    for (int32_t i = 0; i < argc && argv[i][0] != '-'; i++)
+    {
+        if (Path::DirectoryExists(argv[i]))
+        {
+            std::vector<std::string> directoryParks;
+            auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(argv[i], pattern), true));
+            while (scanner->Next())
+            {
+                directoryParks.push_back(scanner->GetPath());
+            }
+            std::sort(directoryParks.begin(), directoryParks.end());
+            parks.insert(parks.end(), directoryParks.begin(), directoryParks.end());
+        }
+        else
+        {
+            parks.push_back(argv[i]);
+        }
+    }
+    return parks;
+}
+
+/**
+ * Loads the park for each run so every run starts from the same state, the checksums of the runs have to match.
+ */
+static bool BenchSimulatePark(IContext& context, const std::string& path, const SimulateBenchOptions& options, json_t& results)
+{
+    json_t runs = json_t::array();
+    std::vector<double> ticksPerSecond;
+    std::array<int64_t, static_cast<size_t>(TickPhase::Count)> phaseTotals{};
+    std::string checksum;
+    bool deterministic = true;
+    for (int32_t run = 0; run < options.repetitions; run++)
+    {
+        if (!context.LoadParkFromFile(path))
+        {
+            return false;
+        }
+
+        auto gameState = context.GetGameState();
+        for (int32_t i = 0; i < options.warmup; i++)
+        {
+            gameState->UpdateLogic();
+        }
+
+        tick_profiler_reset();
+        auto startTime = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < options.ticks; i++)
+        {
+            gameState->UpdateLogic();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        auto stats = tick_profiler_get_stats();
+        for (size_t phase = 0; phase < phaseTotals.size(); phase++)
+        {
+            phaseTotals[phase] += stats.TotalNanoseconds[phase];
+        }
+
+        auto runChecksum = sprite_checksum().ToString();
+        if (run == 0)
+        {
+            checksum = runChecksum;
+        }
+        else if (runChecksum != checksum)
+        {
+            deterministic = false;
+        }
+
+        auto rate = options.ticks / elapsed.count();
+        ticksPerSecond.push_back(rate);
+        std::printf("%s run %d: %.1f ticks/s, checksum %s\n", path.c_str(), run + 1, rate, runChecksum.c_str());
+        runs.push_back({ { "seconds", elapsed.count() }, { "ticksPerSecond", rate }, { "checksum", runChecksum } });
+    }
+
+    // Time of each phase per tick, averaged over all runs
+    auto numTicks = static_cast<double>(options.ticks) * options.repetitions;
+    json_t phases = json_t::object();
+    for (size_t phase = 0; phase < phaseTotals.size(); phase++)
+    {
+        auto name = tick_profiler_get_phase_name(static_cast<TickPhase>(phase));
+        auto time = phaseTotals[phase] / 1e6 / numTicks;
+        phases[name] = time;
+        std::printf("  %-17s %8.3f ms\n", name, time);
+    }
+
+    std::sort(ticksPerSecond.begin(), ticksPerSecond.end());
+    auto median = ticksPerSecond[ticksPerSecond.size() / 2];
+    std::printf(
+        "%s: min %.1f, median %.1f, max %.1f ticks/s, %s\n", path.c_str(), ticksPerSecond.front(), median,
+        ticksPerSecond.back(), deterministic ? "deterministic" : "NOT DETERMINISTIC");
+
+    results.push_back({
+        { "park", path },
+        { "min", ticksPerSecond.front() },
+        { "median", median },
+        { "max", ticksPerSecond.back() },
+        { "deterministic", deterministic },
+        { "checksum", checksum },
+        { "phases", phases },
+        { "runs", runs },
+    });
+    return deterministic;
+}
+
+static exitcode_t HandleSimulateBench(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    const auto& options = _benchOptions;
+
+    auto parks = GetBenchFiles(argv, argc, BENCH_PARK_PATTERN);
+    if (parks.empty() || options.warmup < 0 || options.ticks < 1 || options.repetitions < 1)
+    {
+        Console::Error::WriteLine(
+            "Usage: openrct2 simulate bench <file|directory>... [--warmup <ticks>] [--ticks <ticks>] "
+            "[--repetitions <count>] [--json <output_file>]");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+#ifndef DISABLE_NETWORK
+    gNetworkStart = NETWORK_MODE_SERVER;
+#endif
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    tick_profiler_set_enabled(true);
+
+    auto result = EXITCODE_OK;
+    json_t results = json_t::array();
+    for (const auto& park : parks)
+    {
+        try
+        {
+            if (!BenchSimulatePark(*context, park, options, results))
+            {
+                // Also fails when the runs did not end in the same state
+                Console::Error::WriteLine("Benchmark failed: %s", park.c_str());
+                result = EXITCODE_FAIL;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("%s: %s", park.c_str(), e.what());
+            result = EXITCODE_FAIL;
+        }
+    }
+    tick_profiler_set_enabled(false);
+
+    if (options.json_path != nullptr)
+    {
+        json_t document = {
+            { "unit", "ms" },
+            { "warmup", options.warmup },
+            { "ticks", options.ticks },
+            { "repetitions", options.repetitions },
+            { "results", results },
+        };
+        Json::WriteToFile(options.json_path, document);
+    }
+    return result;
+}
+
+struct BatchPark
+{
+    std::string Path;
+    std::string ResultPath;
+    int32_t ExitCode = -1;
+};
+
+/**
+ * The game state is global, so each park is simulated by a bench run in a process of its own. The index files and g1
+ * are brought up to date first and are only read by these processes, which map them so they share the pages.
+ */
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    const auto& options = _batchOptions;
+
+    auto parkPaths = GetBenchFiles(argv, argc, BENCH_PARK_PATTERN);
+    if (parkPaths.empty() || options.ticks < 1 || options.jobs < 0)
+    {
+        Console::Error::WriteLine(
+            "Usage: openrct2 simulate batch <file|directory>... [--ticks <ticks>] [--jobs <count>] "
+            "[--json <output_file>]");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::string cacheDirectory;
+    {
+        // Builds the indexes the processes load, so they do not all scan and write them at once
+        std::unique_ptr<IContext> context(CreateContext());
+        if (!context->Initialise())
+        {
+            Console::Error::WriteLine("Context initialization failed.");
+            return EXITCODE_FAIL;
+        }
+        cacheDirectory = context->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::CACHE);
+    }
+
+    auto exePath = Platform::GetCurrentExecutablePath();
+    auto batchId = std::to_string(std::time(nullptr));
+    std::vector<BatchPark> parks;
+    for (size_t i = 0; i < parkPaths.size(); i++)
+    {
+        BatchPark park;
+        park.Path = parkPaths[i];
+        park.ResultPath = Path::Combine(cacheDirectory, "batch_" + batchId + "_" + std::to_string(i) + ".json");
+        parks.push_back(std::move(park));
+    }
+
+    size_t numJobs = options.jobs != 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    numJobs = std::min(numJobs, parks.size());
+    Console::WriteLine(
+        "Simulating %u parks for %d ticks, %u at once.", static_cast<uint32_t>(parks.size()), options.ticks,
+        static_cast<uint32_t>(numJobs));
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextPark = 0;
+    std::vector<std::thread> jobs;
+    for (size_t i = 0; i < numJobs; i++)
+    {
+        jobs.emplace_back([&]() {
+            for (auto index = nextPark++; index < parks.size(); index = nextPark++)
+            {
+                auto& park = parks[index];
+                auto process = Platform::StartProcess(
+                    exePath,
+                    { "simulate", "bench", park.Path, "--warmup", "0", "--ticks", std::to_string(options.ticks),
+                      "--repetitions", "1", "--json", park.ResultPath });
+                park.ExitCode = process != 0 ? Platform::WaitForProcess(process) : -1;
+            }
+        });
+    }
+    for (auto& job : jobs)
+    {
+        job.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    auto result = EXITCODE_OK;
+    uint32_t numFailed = 0;
+    json_t results = json_t::array();
+    for (const auto& park : parks)
+    {
+        json_t parkResult;
+        if (File::Exists(park.ResultPath))
+        {
+            try
+            {
+                auto document = Json::ReadFromFile(park.ResultPath.c_str());
+                if (document["results"].is_array() && !document["results"].empty())
+                {
+                    parkResult = document["results"][0];
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to read the result of %s: %s", park.Path.c_str(), e.what());
+            }
+            File::Delete(park.ResultPath);
+        }
+
+        if (park.ExitCode != EXITCODE_OK || !parkResult.is_object())
+        {
+            Console::Error::WriteLine("Simulation failed: %s (exit code %d)", park.Path.c_str(), park.ExitCode);
+            parkResult = { { "park", park.Path }, { "error", park.ExitCode } };
+            result = EXITCODE_FAIL;
+            numFailed++;
+        }
+        results.push_back(parkResult);
+    }
+    Console::WriteLine(
+        "Simulated %u parks in %.1f s, %u failed.", static_cast<uint32_t>(parks.size()), elapsed.count(), numFailed);
+
+    if (options.json_path != nullptr)
+    {
+        json_t document = {
+            { "ticks", options.ticks },
+            { "jobs", numJobs },
+            { "seconds", elapsed.count() },
+            { "results", results },
+        };
+        Json::WriteToFile(options.json_path, document);
+    }
+    return result;
+}
+
+// Smaller times are mostly noise, they are not compared with the baseline
+static constexpr double REPLAY_BENCH_MIN_COMPARED_MS = 0.01;
+static constexpr int32_t REPLAY_BENCH_VIEW_WIDTH = 1280;
+static constexpr int32_t REPLAY_BENCH_VIEW_HEIGHT = 720;
+
+/**
+ * Plays the replay back as fast as possible. Every render interval the centre of the map is rendered from all four
+ * rotations, so the views are the same on every run of the replay.
+ */
+static bool BenchReplay(IContext& context, const std::string& path, const SimulateReplayOptions& options, json_t& results)
+{
+    auto replayManager = context.GetReplayManager();
+    if (!replayManager->StartPlayback(path))
+    {
+        return false;
+    }
+
+    tick_profiler_reset();
+    auto gameState = context.GetGameState();
+    std::vector<double> renderSamples;
+    uint32_t numTicks = 0;
+    bool mismatch = false;
+    while (replayManager->IsReplaying())
+    {
+        gameState->UpdateLogic();
+        numTicks++;
+        mismatch |= replayManager->IsPlaybackStateMismatching();
+
+        if (options.render_interval > 0 && numTicks % options.render_interval == 0)
+        {
+            CaptureView view;
+            view.Width = REPLAY_BENCH_VIEW_WIDTH;
+            view.Height = REPLAY_BENCH_VIEW_HEIGHT;
+            view.Position = TileCoordsXY(gMapSize / 2, gMapSize / 2).ToCoordsXY();
+            for (uint8_t rotation = 0; rotation < 4; rotation++)
+            {
+                renderSamples.push_back(benchgfx_render_view(view, 0, rotation) * 1e3);
+            }
+        }
+    }
+    if (numTicks == 0)
+    {
+        return false;
+    }
+
+    auto stats = tick_profiler_get_stats();
+    json_t phases = json_t::object();
+    for (size_t phase = 0; phase < stats.TotalNanoseconds.size(); phase++)
+    {
+        auto name = tick_profiler_get_phase_name(static_cast<TickPhase>(phase));
+        auto time = stats.TotalNanoseconds[phase] / 1e6 / numTicks;
+        phases[name] = time;
+        std::printf("  %-17s %8.3f ms\n", name, time);
+    }
+
+    double renderMedian = 0;
+    if (!renderSamples.empty())
+    {
+        std::sort(renderSamples.begin(), renderSamples.end());
+        renderMedian = renderSamples[renderSamples.size() / 2];
+        std::printf("  %-17s %8.3f ms\n", "Render", renderMedian);
+    }
+    std::printf("%s: %u ticks%s\n", path.c_str(), numTicks, mismatch ? ", STATE MISMATCH" : "");
+
+    results.push_back({
+        { "replay", Path::GetFileName(path) },
+        { "ticks", numTicks },
+        { "mismatch", mismatch },
+        { "phases", phases },
+        { "render", renderMedian },
+        { "renders", renderSamples.size() },
+    });
+    return !mismatch;
+}
+
+static bool CompareReplayTime(const std::string& replay, const char* name, double time, const json_t& baseline, float threshold)
+{
+    if (!baseline.is_number())
+    {
+        return true;
+    }
+
+    auto baselineTime = baseline.get<double>();
+    if (baselineTime < REPLAY_BENCH_MIN_COMPARED_MS || time <= baselineTime * (1 + threshold / 100))
+    {
+        return true;
+    }
+    Console::Error::WriteLine(
+        "%s: %s took %.3f ms, %.1f%% slower than the baseline of %.3f ms", replay.c_str(), name, time,
+        (time / baselineTime - 1) * 100, baselineTime);
+    return false;
+}
+
+/**
+ * Compares the results with those of the same replays in the baseline, returns false if any time grew by more than
+ * the threshold.
+ */
+static bool CompareReplayResults(const json_t& results, const json_t& baselineResults, float threshold)
+{
+    bool passed = true;
+    for (const auto& result : results)
+    {
+        auto replay = result["replay"].get<std::string>();
+        auto baseline = std::find_if(baselineResults.begin(), baselineResults.end(), [&replay](const json_t& item) {
+            return item.is_object() && item.value("replay", "") == replay;
+        });
+        if (baseline == baselineResults.end())
+        {
+            Console::WriteLine("%s: not in the baseline", replay.c_str());
+            continue;
+        }
+
+        auto baselinePhases = baseline->value("phases", json_t::object());
+        for (const auto& [name, time] : result["phases"].items())
+        {
+            auto baselineTime = baselinePhases.value(name, json_t());
+            passed &= CompareReplayTime(replay, name.c_str(), time.get<double>(), baselineTime, threshold);
+        }
+        auto baselineRender = baseline->value("render", json_t());
+        passed &= CompareReplayTime(replay, "Render", result["render"].get<double>(), baselineRender, threshold);
+    }
+    return passed;
+}
+
+static exitcode_t HandleSimulateReplay(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    const auto& options = _replayOptions;
+
+    auto replays = GetBenchFiles(argv, argc, BENCH_REPLAY_PATTERN);
+    if (replays.empty() || options.render_interval < 0 || options.threshold < 0)
+    {
+        Console::Error::WriteLine(
+            "Usage: openrct2 simulate replay <file|directory>... [--render-interval <ticks>] [--threshold <percent>] "
+            "[--baseline <file>] [--json <output_file>]");
+        return EXITCODE_FAIL;
+    }
+
+    json_t baselineResults = json_t::array();
+    if (options.baseline_path != nullptr)
+    {
+        try
+        {
+            baselineResults = Json::ReadFromFile(options.baseline_path)["results"];
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to read the baseline: %s", e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+    drawing_engine_init();
+    tick_profiler_set_enabled(true);
+
+    auto result = EXITCODE_OK;
+    json_t results = json_t::array();
+    for (const auto& replay : replays)
+    {
+        try
+        {
+            if (!BenchReplay(*context, replay, options, results))
+            {
+                Console::Error::WriteLine("Replay failed: %s", replay.c_str());
+                result = EXITCODE_FAIL;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("%s: %s", replay.c_str(), e.what());
+            result = EXITCODE_FAIL;
+        }
+    }
+    tick_profiler_set_enabled(false);
+    drawing_engine_dispose();
+
+    if (options.baseline_path != nullptr && baselineResults.is_array()
+        && !CompareReplayResults(results, baselineResults, options.threshold))
+    {
+        result = EXITCODE_FAIL;
+    }
+
+    if (options.json_path != nullptr)
+    {
+        json_t document = {
+            { "unit", "ms" },
+            { "renderInterval", options.render_interval },
+            { "results", results },
+        };
+        Json::WriteToFile(options.json_path, document);
+    }
+    return result;
+}
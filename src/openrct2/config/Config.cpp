@@ -32,6 +32,7 @@
 #include "../scenario/Scenario.h"
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
+#include "../world/Sprite.h"
 #include "ConfigEnum.hpp"
 #include "IniReader.hpp"
 #include "IniWriter.hpp"
@@ -143,6 +144,8 @@ namespace Config
             model->always_show_gridlines = reader->GetBoolean("always_show_gridlines", false);
             model->autosave_frequency = reader->GetInt32("autosave", AUTOSAVE_EVERY_5MINUTES);
             model->autosave_amount = reader->GetInt32("autosave_amount", DEFAULT_NUM_AUTOSAVES_TO_KEEP);
+            model->autosave_compressed = reader->GetBoolean("autosave_compressed", false);
+            model->autosave_deltas = reader->GetInt32("autosave_deltas", 0);
             model->confirmation_prompt = reader->GetBoolean("confirmation_prompt", false);
             model->currency_format = reader->GetEnum<int32_t>("currency_format", platform_get_locale_currency(), Enum_Currency);
             model->custom_currency_rate = reader->GetInt32("custom_currency_rate", 10);
@@ -163,6 +166,7 @@ namespace Config
             model->play_intro = reader->GetBoolean("play_intro", false);
             model->save_plugin_data = reader->GetBoolean("save_plugin_data", true);
             model->debugging_tools = reader->GetBoolean("debugging_tools", false);
+            model->hitch_log_threshold = reader->GetInt32("hitch_log_threshold", 0);
             model->show_height_as_units = reader->GetBoolean("show_height_as_units", false);
             model->temperature_format = reader->GetEnum<TemperatureUnit>(
                 "temperature_format", platform_get_locale_temperature_format(), Enum_Temperature);
@@ -199,6 +203,7 @@ namespace Config
                 "scale_quality", ScaleQuality::SmoothNearestNeighbour, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->prewarm_texture_atlases = reader->GetBoolean("prewarm_texture_atlases", false);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -210,6 +215,9 @@ namespace Config
             model->last_save_track_directory = reader->GetCString("last_track_directory", nullptr);
             model->use_native_browse_dialog = reader->GetBoolean("use_native_browse_dialog", false);
             model->window_limit = reader->GetInt32("window_limit", WINDOW_LIMIT_MAX);
+            model->max_entities = reader->GetInt32("max_entities", MAX_SPRITES);
+            model->lazy_object_images = reader->GetBoolean("lazy_object_images", false);
+            model->watch_content_directories = reader->GetBoolean("watch_content_directories", false);
             model->zoom_to_cursor = reader->GetBoolean("zoom_to_cursor", true);
             model->render_weather_effects = reader->GetBoolean("render_weather_effects", true);
             model->render_weather_gloom = reader->GetBoolean("render_weather_gloom", true);
@@ -228,6 +236,8 @@ namespace Config
         writer->WriteBoolean("always_show_gridlines", model->always_show_gridlines);
         writer->WriteInt32("autosave", model->autosave_frequency);
         writer->WriteInt32("autosave_amount", model->autosave_amount);
+        writer->WriteBoolean("autosave_compressed", model->autosave_compressed);
+        writer->WriteInt32("autosave_deltas", model->autosave_deltas);
         writer->WriteBoolean("confirmation_prompt", model->confirmation_prompt);
         writer->WriteEnum<int32_t>("currency_format", model->currency_format, Enum_Currency);
         writer->WriteInt32("custom_currency_rate", model->custom_currency_rate);
@@ -246,6 +256,7 @@ namespace Config
         writer->WriteBoolean("play_intro", model->play_intro);
         writer->WriteBoolean("save_plugin_data", model->save_plugin_data);
         writer->WriteBoolean("debugging_tools", model->debugging_tools);
+        writer->WriteInt32("hitch_log_threshold", model->hitch_log_threshold);
         writer->WriteBoolean("show_height_as_units", model->show_height_as_units);
         writer->WriteEnum<TemperatureUnit>("temperature_format", model->temperature_format, Enum_Temperature);
         writer->WriteInt32("window_height", model->window_height);
@@ -274,6 +285,7 @@ namespace Config
         writer->WriteEnum<ScaleQuality>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("prewarm_texture_atlases", model->prewarm_texture_atlases);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -285,6 +297,9 @@ namespace Config
         writer->WriteString("last_track_directory", model->last_save_track_directory);
         writer->WriteBoolean("use_native_browse_dialog", model->use_native_browse_dialog);
         writer->WriteInt32("window_limit", model->window_limit);
+        writer->WriteInt32("max_entities", model->max_entities);
+        writer->WriteBoolean("lazy_object_images", model->lazy_object_images);
+        writer->WriteBoolean("watch_content_directories", model->watch_content_directories);
         writer->WriteBoolean("zoom_to_cursor", model->zoom_to_cursor);
         writer->WriteBoolean("render_weather_effects", model->render_weather_effects);
         writer->WriteBoolean("render_weather_gloom", model->render_weather_gloom);
@@ -407,6 +422,8 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->stats_log_interval = reader->GetInt32("stats_log_interval", 0);
+            model->checksum_interval = reader->GetInt32("checksum_interval", 100);
         }
     }
 
@@ -434,6 +451,8 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("stats_log_interval", model->stats_log_interval);
+        writer->WriteInt32("checksum_interval", model->checksum_interval);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -534,6 +553,8 @@ namespace Config
         {
             auto model = &gConfigPlugin;
             model->enable_hot_reloading = reader->GetBoolean("enable_hot_reloading", false);
+            model->tick_budget = std::max(0, reader->GetInt32("tick_budget", 0));
+            model->suspend_over_budget = reader->GetBoolean("suspend_over_budget", false);
         }
     }
 
@@ -542,6 +563,8 @@ namespace Config
         auto model = &gConfigPlugin;
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->enable_hot_reloading);
+        writer->WriteInt32("tick_budget", model->tick_budget);
+        writer->WriteBoolean("suspend_over_budget", model->suspend_over_budget);
     }
 
     static bool SetDefaults()
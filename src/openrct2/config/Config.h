@@ -41,6 +41,7 @@ struct GeneralConfiguration
     bool use_vsync;
     bool show_fps;
     bool multithreading;
+    bool prewarm_texture_atlases;
     bool minimize_fullscreen_focus_loss;
 
     // Map rendering
@@ -81,13 +82,19 @@ struct GeneralConfiguration
     bool allow_loading_with_incorrect_checksum;
     bool save_plugin_data;
     bool debugging_tools;
+    int32_t hitch_log_threshold;
     int32_t autosave_frequency;
     int32_t autosave_amount;
+    bool autosave_compressed;
+    int32_t autosave_deltas;
     bool auto_staff_placement;
     bool handymen_mow_default;
     bool auto_open_shops;
     int32_t default_inspection_interval;
     int32_t window_limit;
+    int32_t max_entities;
+    bool lazy_object_images;
+    bool watch_content_directories;
     int32_t scenario_select_mode;
     bool scenario_unlocking_enabled;
     bool scenario_hide_mega_park;
@@ -158,6 +165,8 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t stats_log_interval;
+    int32_t checksum_interval;
 };
 
 struct NotificationConfiguration
@@ -203,6 +212,8 @@ struct FontConfiguration
 struct PluginConfiguration
 {
     bool enable_hot_reloading;
+    int32_t tick_budget;
+    bool suspend_over_budget;
 };
 
 enum SORT
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<bool> _enabled;
+static std::atomic<uint64_t> _count;
+
+namespace AllocationCounter
+{
+    void SetEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool IsEnabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetCount()
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+} // namespace AllocationCounter
+
+static void* CountedAllocate(std::size_t size) noexcept
+{
+    if (_enabled.load(std::memory_order_relaxed))
+    {
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+    // malloc(0) may return nullptr, operator new has to return a unique pointer
+    return std::malloc(size != 0 ? size : 1);
+}
+
+static void* CountedAllocateOrThrow(std::size_t size)
+{
+    while (true)
+    {
+        auto ptr = CountedAllocate(size);
+        if (ptr != nullptr)
+            return ptr;
+
+        auto handler = std::get_new_handler();
+        if (handler == nullptr)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return CountedAllocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return CountedAllocateOrThrow(size);
+}
+
+static void* CountedAllocateNoThrow(std::size_t size) noexcept
+{
+    try
+    {
+        return CountedAllocateOrThrow(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocateNoThrow(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocateNoThrow(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
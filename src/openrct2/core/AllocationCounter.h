@@ -9,13 +9,17 @@
 
 #pragma once
 
-#include "DrawCommands.h"
+#include <cstdint>
 
-#include <openrct2/common.h>
-
-/*
- * Determines an aproximation of the number of depth peeling iterations needed
- * to render the command batch. It will never underestimate the number of
- * iterations, but it can overestimate, usually by no more than +2.
+/**
+ * Counts the heap allocations made through operator new on every thread, which replaces the global operator new and
+ * delete. Counting is off until enabled, which leaves a single relaxed load per allocation.
  */
-int32_t MaxTransparencyDepth(const RectCommandBatch& transparent);
+namespace AllocationCounter
+{
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // The number of allocations made while counting was enabled
+    uint64_t GetCount();
+} // namespace AllocationCounter
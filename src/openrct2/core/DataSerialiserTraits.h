@@ -22,11 +22,14 @@
 #include "Endianness.h"
 #include "MemoryStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 template<typename T> struct DataSerializerTraits_t
 {
@@ -280,6 +283,61 @@ template<> struct DataSerializerTraits_t<OpenRCT2::MemoryStream>
     }
 };
 
+/**
+ * Types that are encoded as their bytes in memory, with integers byte swapped by ByteSwapBE. Arrays of them are copied
+ * with one stream call instead of one per element, the encoding stays the same.
+ */
+template<typename T> struct DataSerializerIsBulk : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T>>
+{
+};
+
+template<> struct DataSerializerIsBulk<rct_vehicle_colour> : std::true_type
+{
+};
+
+template<typename T> constexpr bool DataSerializerIsBulk_v = DataSerializerIsBulk<T>::value;
+
+template<typename T> struct DataSerializerTraitsBulk
+{
+    static_assert(DataSerializerIsBulk_v<T>);
+
+    // Enums, bools and the opted in structs are written as they are in memory
+    static constexpr bool NeedsByteSwap = std::is_integral_v<T> && sizeof(T) > 1;
+
+    static void encode(OpenRCT2::IStream* stream, const T* values, size_t count)
+    {
+        if constexpr (!NeedsByteSwap)
+        {
+            stream->Write(values, count * sizeof(T));
+        }
+        else
+        {
+            // Swapped in chunks on the stack, a plain loop the compiler can vectorise
+            T swapped[256];
+            for (size_t chunkStart = 0; chunkStart < count; chunkStart += std::size(swapped))
+            {
+                const size_t chunkSize = std::min(count - chunkStart, std::size(swapped));
+                for (size_t i = 0; i < chunkSize; i++)
+                {
+                    swapped[i] = ByteSwapBE(values[chunkStart + i]);
+                }
+                stream->Write(swapped, chunkSize * sizeof(T));
+            }
+        }
+    }
+    static void decode(OpenRCT2::IStream* stream, T* values, size_t count)
+    {
+        stream->Read(values, count * sizeof(T));
+        if constexpr (NeedsByteSwap)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                values[i] = ByteSwapBE(values[i]);
+            }
+        }
+    }
+};
+
 template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
 {
     static void encode(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -288,10 +346,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<uint8_t> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulk_v<_Ty>)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, val, _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
@@ -303,10 +368,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulk_v<_Ty>)
         {
-            s.decode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::decode(stream, val, _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -322,19 +394,8 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
     }
 };
 
-template<size_t _Size> struct DataSerializerTraits_t<uint8_t[_Size]> : public DataSerializerTraitsPODArray<uint8_t, _Size>
-{
-};
-
-template<size_t _Size> struct DataSerializerTraits_t<uint16_t[_Size]> : public DataSerializerTraitsPODArray<uint16_t, _Size>
-{
-};
-
-template<size_t _Size> struct DataSerializerTraits_t<uint32_t[_Size]> : public DataSerializerTraitsPODArray<uint32_t, _Size>
-{
-};
-
-template<size_t _Size> struct DataSerializerTraits_t<uint64_t[_Size]> : public DataSerializerTraitsPODArray<uint64_t, _Size>
+template<typename _Ty, size_t _Size>
+struct DataSerializerTraits_t<_Ty[_Size]> : public DataSerializerTraitsPODArray<_Ty, _Size>
 {
 };
 
@@ -346,10 +407,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulk_v<_Ty>)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, val.data(), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
@@ -361,10 +429,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulk_v<_Ty>)
         {
-            s.decode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::decode(stream, val.data(), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
@@ -382,16 +457,26 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
 
 template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
 {
+    // The elements of std::vector<bool> are not stored as bools
+    static constexpr bool IsBulk = DataSerializerIsBulk_v<_Ty> && !std::is_same_v<_Ty, bool>;
+
     static void encode(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
     {
         uint16_t len = static_cast<uint16_t>(val.size());
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (IsBulk)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, val.data(), len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -400,12 +485,22 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (IsBulk)
         {
-            _Ty sub;
-            s.decode(stream, sub);
-            val.push_back(sub);
+            // Appended to the elements already in the vector, like the elements decoded one at a time
+            const size_t offset = val.size();
+            val.resize(offset + len);
+            DataSerializerTraitsBulk<_Ty>::decode(stream, val.data() + offset, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub;
+                s.decode(stream, sub);
+                val.push_back(sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
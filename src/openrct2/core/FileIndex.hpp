@@ -9,18 +9,23 @@
 
 #pragma once
 
+#include "../Profiling.h"
+#include "../StartupTrace.h"
 #include "../common.h"
 #include "Console.hpp"
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
-#include "JobPool.hpp"
+#include "MappedFileStream.h"
 #include "Path.hpp"
+#include "String.hpp"
+#include "TaskScheduler.h"
 
 #include <chrono>
 #include <list>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -34,18 +39,34 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct ScannedFile
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<ScannedFile> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<ScannedFile> files)
             : Stats(stats)
             , Files(files)
         {
         }
     };
 
+    // An item together with the file it was created from, so it can be kept when the file has not changed.
+    // Files no item could be created from are kept as well, so they are not loaded again until they change.
+    struct IndexedItem
+    {
+        ScannedFile File;
+        TItem Item;
+        bool Valid = true;
+    };
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -58,7 +79,7 @@ private:
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 6;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,21 +117,25 @@ public:
     /**
      * Queries and directories and loads the index header. If the index is up to date,
      * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Items of files that have the same size and modification date as when the out of
+     * date index was written are kept, only new and changed files are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
+        StartupTraceSpan span(_name);
         std::vector<TItem> items;
         auto scanResult = Scan();
         auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
         if (std::get<0>(readIndexResult))
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            items = GetValidItems(std::get<1>(readIndexResult));
         }
         else
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            // Index was not loaded or is out of date
+            StartupTraceSpan buildSpan(_name + " build");
+            items = Build(language, scanResult, std::get<1>(readIndexResult));
         }
         return items;
     }
@@ -118,10 +143,33 @@ public:
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
+        auto items = Build(language, scanResult, {});
         return items;
     }
 
+    /**
+     * Returns whether the file is in one of the search directories and matches the pattern of the index, i.e. it would
+     * be indexed by the next scan.
+     */
+    bool IsIndexedFile(const std::string& path) const
+    {
+        if (!Path::MatchesPattern(Path::GetFileName(path), _pattern))
+        {
+            return false;
+        }
+
+        for (const auto& directory : SearchPaths)
+        {
+            // Ends with a separator, so a directory whose name only starts with the same name is not matched
+            auto absoluteDirectory = Path::Combine(Path::GetAbsolute(directory), "");
+            if (String::StartsWith(path, absoluteDirectory, true))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
 protected:
     /**
      * Loads the given file and creates the item representing the data to store in the index.
@@ -143,76 +191,98 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), absoluteDirectory.c_str());
 
+            // Listed in the same order as a single threaded scan, the checksums depend on it
             auto pattern = Path::Combine(absoluteDirectory, _pattern);
-            auto scanner = Path::ScanDirectory(pattern, true);
-            while (scanner->Next())
+            for (auto& fileInfo : Path::ScanDirectoryParallel(pattern))
             {
-                auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
-                files.push_back(path);
-
                 stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo->LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo->LastModified & 0xFFFFFFFF);
+                stats.TotalFileSize += fileInfo.Size;
+                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo.LastModified >> 32)
+                    ^ static_cast<uint32_t>(fileInfo.LastModified & 0xFFFFFFFF);
                 stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                stats.PathChecksum += GetPathChecksum(fileInfo.Path);
+
+                files.push_back({ std::move(fileInfo.Path), fileInfo.Size, fileInfo.LastModified });
             }
-            delete scanner;
         }
         return ScanResult(stats, files);
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const ScanResult& scanResult, const std::unordered_map<std::string, const IndexedItem*>& oldItems,
+        size_t rangeStart, size_t rangeEnd, std::vector<IndexedItem>& items, std::atomic<size_t>& processed,
+        std::atomic<size_t>& reused, std::mutex& printLock) const
     {
         items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto& file = scanResult.Files.at(i);
+
+            auto oldItem = oldItems.find(file.Path);
+            if (oldItem != oldItems.end() && oldItem->second->File.Size == file.Size
+                && oldItem->second->File.LastModified == file.LastModified)
+            {
+                items.push_back(*oldItem->second);
+                reused++;
+                processed++;
+                continue;
+            }
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
             }
 
-            auto item = Create(language, filePath);
+            auto item = Create(language, file.Path);
             if (std::get<0>(item))
             {
-                items.push_back(std::get<1>(item));
+                items.push_back({ file, std::get<1>(item) });
+            }
+            else
+            {
+                items.push_back({ file, TItem(), false });
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    std::vector<TItem> Build(
+        int32_t language, const ScanResult& scanResult, const std::vector<IndexedItem>& previousItems) const
     {
-        std::vector<TItem> allItems;
+        PROFILE_ZONE("FileIndex::Build");
+        std::vector<IndexedItem> allItems;
         Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
+        std::unordered_map<std::string, const IndexedItem*> oldItems;
+        oldItems.reserve(previousItems.size());
+        for (const auto& item : previousItems)
+        {
+            oldItems.emplace(item.File.Path, &item);
+        }
+
         const size_t totalCount = scanResult.Files.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
+            auto& scheduler = TaskScheduler::GetGlobal();
+            TaskGroup buildTasks;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
+            std::list<std::vector<IndexedItem>> containers;
 
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+            std::atomic<size_t> reused = ATOMIC_VAR_INIT(0);
 
             auto reportProgress = [&]() {
                 const size_t completed = processed;
@@ -228,19 +298,26 @@ private:
 
                 auto& items = containers.emplace_back();
 
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                scheduler.Schedule(
+                    buildTasks,
+                    std::bind(
+                        &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), std::cref(oldItems),
+                        rangeStart, rangeStart + stepSize, std::ref(items), std::ref(processed), std::ref(reused),
+                        std::ref(printLock)));
 
                 reportProgress();
             }
 
-            jobPool.Join(reportProgress);
+            scheduler.Wait(buildTasks, reportProgress);
 
             for (auto&& itr : containers)
             {
                 allItems.insert(allItems.end(), itr.begin(), itr.end());
             }
+            if (reused > 0)
+            {
+                Console::WriteLine("Kept %zu unchanged items of %s", static_cast<size_t>(reused), _name.c_str());
+            }
         }
 
         WriteIndexFile(language, scanResult.Stats, allItems);
@@ -249,44 +326,75 @@ private:
         auto duration = std::chrono::duration<float>(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
 
-        return allItems;
+        return GetValidItems(allItems);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    static std::vector<TItem> GetValidItems(std::vector<IndexedItem>& indexedItems)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
+        items.reserve(indexedItems.size());
+        for (auto& indexedItem : indexedItems)
+        {
+            if (indexedItem.Valid)
+            {
+                items.push_back(std::move(indexedItem.Item));
+            }
+        }
+        return items;
+    }
+
+    /**
+     * Reads the items of the index file. The bool is only true when the index is up to date, the items of
+     * an out of date index are still returned if they were created the same way.
+     */
+    std::tuple<bool, std::vector<IndexedItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    {
+        bool loadedItems = false;
+        std::vector<IndexedItem> items;
         if (File::Exists(_indexPath))
         {
             try
             {
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
+                // Mapped, so processes loading the same index share its pages
+                auto stream = OpenRCT2::OpenFileForReading(_indexPath);
+                auto& fs = *stream;
 
                 // Read header, check if we need to re-scan
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
                     items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
                     for (uint32_t i = 0; i < header.NumItems; i++)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        IndexedItem item;
+                        item.File.Path = fs.ReadStdString();
+                        item.File.Size = fs.ReadValue<uint64_t>();
+                        item.File.LastModified = fs.ReadValue<uint64_t>();
+                        item.Valid = fs.ReadValue<uint8_t>() != 0;
+                        if (item.Valid)
+                        {
+                            item.Item = Deserialise(&fs);
+                        }
+                        items.push_back(std::move(item));
                     }
-                    loadedItems = true;
+
+                    // Directory is the same, the saved items can be used as they are
+                    loadedItems = header.Stats.TotalFiles == stats.TotalFiles
+                        && header.Stats.TotalFileSize == stats.TotalFileSize
+                        && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                        && header.Stats.PathChecksum == stats.PathChecksum;
                 }
-                else
+                if (!loadedItems)
                 {
                     Console::WriteLine("%s out of date", _name.c_str());
                 }
             }
             catch (const std::exception& e)
             {
+                loadedItems = false;
+                items.clear();
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
             }
@@ -294,7 +402,7 @@ private:
         return std::make_tuple(loadedItems, items);
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<IndexedItem>& items) const
     {
         try
         {
@@ -315,7 +423,14 @@ private:
             // Write items
             for (const auto& item : items)
             {
-                Serialise(&fs, item);
+                fs.WriteString(item.File.Path);
+                fs.WriteValue(item.File.Size);
+                fs.WriteValue(item.File.LastModified);
+                fs.WriteValue<uint8_t>(item.Valid ? 1 : 0);
+                if (item.Valid)
+                {
+                    Serialise(&fs, item.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -27,7 +27,9 @@
 #include "Memory.hpp"
 #include "Path.hpp"
 #include "String.hpp"
+#include "TaskScheduler.h"
 
+#include <iterator>
 #include <memory>
 #include <stack>
 #include <string>
@@ -164,17 +166,7 @@ public:
 
     virtual void GetDirectoryChildren(std::vector<DirectoryChild>& children, const std::string& path) abstract;
 
-private:
-    void PushState(const std::string& directory)
-    {
-        DirectoryState newState;
-        newState.Path = directory;
-        newState.Index = -1;
-        GetDirectoryChildren(newState.Listing, directory);
-        _directoryStack.push(newState);
-    }
-
-    bool PatternMatch(const std::string& fileName)
+    bool PatternMatch(const std::string& fileName) const
     {
         for (const auto& pattern : _patterns)
         {
@@ -212,6 +204,16 @@ private:
         patterns.shrink_to_fit();
         return patterns;
     }
+
+private:
+    void PushState(const std::string& directory)
+    {
+        DirectoryState newState;
+        newState.Path = directory;
+        newState.Index = -1;
+        GetDirectoryChildren(newState.Listing, directory);
+        _directoryStack.push(newState);
+    }
 };
 
 #ifdef _WIN32
@@ -354,6 +356,62 @@ IFileScanner* Path::ScanDirectory(const std::string& pattern, bool recurse)
 #endif
 }
 
+std::vector<ScannedFileInfo> Path::ScanDirectoryParallel(const std::string& pattern)
+{
+    auto rootPath = Path::GetDirectory(pattern);
+    auto patterns = Path::GetFileName(pattern);
+    auto scanner = std::unique_ptr<IFileScanner>(ScanDirectory(pattern, false));
+    auto baseScanner = static_cast<FileScannerBase*>(scanner.get());
+
+    std::vector<DirectoryChild> children;
+    baseScanner->GetDirectoryChildren(children, rootPath);
+
+    // Each child gets its own list so they can be joined in the order of the listing
+    std::vector<std::vector<ScannedFileInfo>> childFiles(children.size());
+    auto& scheduler = TaskScheduler::GetGlobal();
+    TaskGroup scanTasks;
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        const auto& child = children[i];
+        auto childPath = Path::Combine(rootPath, child.Name);
+        if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+        {
+            scheduler.Schedule(scanTasks, [&files = childFiles[i], childPattern = Path::Combine(childPath, patterns)]() {
+                auto childScanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(childPattern, true));
+                while (childScanner->Next())
+                {
+                    auto fileInfo = childScanner->GetFileInfo();
+                    files.push_back({ childScanner->GetPath(), fileInfo->Size, fileInfo->LastModified });
+                }
+            });
+        }
+        else if (baseScanner->PatternMatch(child.Name))
+        {
+            childFiles[i].push_back({ childPath, child.Size, child.LastModified });
+        }
+    }
+    scheduler.Wait(scanTasks);
+
+    std::vector<ScannedFileInfo> files;
+    for (auto& list : childFiles)
+    {
+        std::move(list.begin(), list.end(), std::back_inserter(files));
+    }
+    return files;
+}
+
+bool Path::MatchesPattern(const std::string& fileName, const std::string& patterns)
+{
+    for (const auto& pattern : FileScannerBase::GetPatterns(patterns))
+    {
+        if (MatchWildcard(fileName.c_str(), pattern.c_str()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Path::QueryDirectory(QueryDirectoryResult* result, const std::string& pattern)
 {
     IFileScanner* scanner = Path::ScanDirectory(pattern, true);
@@ -33,6 +33,13 @@ struct IFileScanner
     virtual bool Next() abstract;
 };
 
+struct ScannedFileInfo
+{
+    std::string Path;
+    uint64_t Size;
+    uint64_t LastModified;
+};
+
 struct QueryDirectoryResult
 {
     uint32_t TotalFiles;
@@ -52,6 +59,19 @@ namespace Path
      */
     IFileScanner* ScanDirectory(const std::string& pattern, bool recurse);
 
+    /**
+     * Scans a directory and all sub directories for files that match the given pattern, each sub directory of the
+     * directory is scanned on its own task. The files are listed in the same order ScanDirectory enumerates them.
+     * @param pattern The path followed by a semi-colon delimited list of wildcard patterns.
+     */
+    std::vector<ScannedFileInfo> ScanDirectoryParallel(const std::string& pattern);
+
+    /**
+     * Returns whether the file name matches one of the patterns.
+     * @param patterns A semi-colon delimited list of wildcard patterns.
+     */
+    bool MatchesPattern(const std::string& fileName, const std::string& patterns);
+
     /**
      * Scans a directory and all sub directories
      * @param result The query result to modify.
@@ -60,7 +60,7 @@ void FileWatcher::FileDescriptor::Close()
 
 FileWatcher::WatchDescriptor::WatchDescriptor(int fd, const std::string& path)
     : Fd(fd)
-    , Wd(inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE))
+    , Wd(inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE))
     , Path(path)
 {
     if (Wd >= 0)
@@ -79,6 +79,27 @@ FileWatcher::WatchDescriptor::~WatchDescriptor()
     inotify_rm_watch(Fd, Wd);
     log_verbose("FileWatcher: inotify watch removed");
 }
+
+/**
+ * Watches the directory and its sub directories. The files already in a directory that was added to the tree are
+ * reported as well, they may have been created before the watch was.
+ */
+void FileWatcher::AddDirectory(const std::string& directoryPath, bool reportFiles)
+{
+    _watchDescs.emplace_back(_fileDesc.Fd, directoryPath);
+    for (auto& p : fs::recursive_directory_iterator(directoryPath))
+    {
+        auto type = p.status().type();
+        if (type == fs::file_type::directory)
+        {
+            _watchDescs.emplace_back(_fileDesc.Fd, p.path().string());
+        }
+        else if (type == fs::file_type::regular && reportFiles && OnFileChanged)
+        {
+            OnFileChanged(p.path().string());
+        }
+    }
+}
 #endif
 
 FileWatcher::FileWatcher(const std::string& directoryPath)
@@ -94,14 +115,7 @@ FileWatcher::FileWatcher(const std::string& directoryPath)
     }
 #elif defined(__linux__)
     _fileDesc.Initialise();
-    _watchDescs.emplace_back(_fileDesc.Fd, directoryPath);
-    for (auto& p : fs::recursive_directory_iterator(directoryPath))
-    {
-        if (p.status().type() == fs::file_type::directory)
-        {
-            _watchDescs.emplace_back(_fileDesc.Fd, p.path().string());
-        }
-    }
+    AddDirectory(directoryPath, false);
 #else
     throw std::runtime_error("FileWatcher not supported on this platform.");
 #endif
@@ -134,8 +148,8 @@ void FileWatcher::WatchDirectory()
     std::array<char, 1024> eventData;
     DWORD bytesReturned;
     while (ReadDirectoryChangesW(
-        _directoryHandle, eventData.data(), static_cast<DWORD>(eventData.size()), TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE,
-        &bytesReturned, nullptr, nullptr))
+        _directoryHandle, eventData.data(), static_cast<DWORD>(eventData.size()), TRUE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, &bytesReturned, nullptr, nullptr))
     {
         auto onFileChanged = OnFileChanged;
         if (onFileChanged)
@@ -146,6 +160,10 @@ void FileWatcher::WatchDirectory()
             {
                 notifyInfo = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(eventData.data() + offset);
                 offset += notifyInfo->NextEntryOffset;
+                if (notifyInfo->Action == FILE_ACTION_REMOVED || notifyInfo->Action == FILE_ACTION_RENAMED_OLD_NAME)
+                {
+                    continue;
+                }
 
                 std::wstring fileNameW(notifyInfo->FileName, notifyInfo->FileNameLength / sizeof(wchar_t));
                 auto fileName = String::ToUtf8(fileNameW);
@@ -170,7 +188,10 @@ void FileWatcher::WatchDirectory()
                 while (offset < length)
                 {
                     auto e = reinterpret_cast<inotify_event*>(eventData.data() + offset);
-                    if ((e->mask & IN_CLOSE_WRITE) && !(e->mask & IN_ISDIR))
+                    bool isDirectory = (e->mask & IN_ISDIR) != 0;
+                    bool isNewDirectory = isDirectory && (e->mask & (IN_CREATE | IN_MOVED_TO));
+                    bool isChangedFile = !isDirectory && (e->mask & (IN_CLOSE_WRITE | IN_MOVED_TO));
+                    if (isNewDirectory || isChangedFile)
                     {
                         log_verbose("FileWatcher: inotify event received for %s", e->name);
 
@@ -183,7 +204,21 @@ void FileWatcher::WatchDirectory()
                         {
                             auto directory = findResult->Path;
                             auto path = fs::path(directory) / fs::path(e->name);
-                            onFileChanged(path);
+                            if (isNewDirectory)
+                            {
+                                try
+                                {
+                                    AddDirectory(path.string(), true);
+                                }
+                                catch (const std::exception& ex)
+                                {
+                                    log_verbose("FileWatcher: unable to watch %s: %s", path.string().c_str(), ex.what());
+                                }
+                            }
+                            else
+                            {
+                                onFileChanged(path);
+                            }
                         }
                     }
                     offset += sizeof(inotify_event) + e->len;
@@ -10,16 +10,17 @@
 #pragma once
 
 #include <functional>
+#include <list>
 #include <string>
 #include <thread>
-#include <vector>
 
 #ifdef _WIN32
 typedef void* HANDLE;
 #endif
 
 /**
- * Creates a new thread that watches a directory tree for file modifications.
+ * Creates a new thread that watches a directory tree for file modifications. Files that are written, or moved or copied
+ * into the tree, are reported, including the files of directories added to it.
  */
 class FileWatcher
 {
@@ -49,7 +50,8 @@ private:
     };
 
     FileDescriptor _fileDesc;
-    std::vector<WatchDescriptor> _watchDescs;
+    // A list as the descriptors remove their watch when destroyed, they must never be moved
+    std::list<WatchDescriptor> _watchDescs;
 #endif
 
 public:
@@ -64,4 +66,7 @@ private:
 #endif
 
     void WatchDirectory();
+#if defined(__linux__)
+    void AddDirectory(const std::string& directoryPath, bool reportFiles);
+#endif
 };
@@ -171,6 +171,12 @@ namespace Http
             if (hSession == nullptr)
                 ThrowWin32Exception("WinHttpOpen");
 
+            if (req.timeout != 0)
+            {
+                auto timeoutMs = static_cast<int>(req.timeout * 1000);
+                WinHttpSetTimeouts(hSession, timeoutMs, timeoutMs, timeoutMs, timeoutMs);
+            }
+
             auto wHostName = std::wstring(url.lpszHostName, url.dwHostNameLength);
             hConnect = WinHttpConnect(hSession, wHostName.c_str(), url.nPort, 0);
             if (hConnect == nullptr)
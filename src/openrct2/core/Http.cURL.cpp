@@ -105,6 +105,9 @@ namespace Http
         if (req.forceIPv4)
             curl_easy_setopt(curl, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
 
+        if (req.timeout != 0)
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(req.timeout));
+
         if (req.method == Method::POST)
             curl_easy_setopt(curl, CURLOPT_POST, 1L);
 
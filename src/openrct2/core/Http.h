@@ -49,6 +49,8 @@ namespace Http
         Method method = Method::GET;
         std::string body = "";
         bool forceIPv4 = false;
+        // The time in seconds the whole request may take, 0 to wait for as long as it takes
+        uint32_t timeout = 0;
     };
 
     Response Do(const Request& req);
@@ -17,9 +17,13 @@
 #include "IStream.hpp"
 #include "Memory.hpp"
 #include "String.hpp"
+#include "TaskScheduler.h"
+#include "zlib.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <limits>
 #include <png.h>
 #include <stdexcept>
 #include <unordered_map>
@@ -162,83 +166,320 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    /**
+     * Sets the palette and writes the header of an image, which is 8-bit if it has a palette and 32-bit otherwise. The
+     * palette is allocated with png_malloc and has to be freed by the caller.
+     */
+    static void WritePngHeader(
+        png_structp png_ptr, png_infop info_ptr, png_colorp& png_palette, uint32_t width, uint32_t height,
+        const GamePalette* palette)
     {
-        png_structp png_ptr = nullptr;
-        png_colorp png_palette = nullptr;
-        try
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+
+        auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
+        if (palette != nullptr)
         {
-            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
-            if (png_ptr == nullptr)
+            // Set the palette
+            png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+            if (png_palette == nullptr)
             {
-                throw std::runtime_error("png_create_write_struct failed.");
+                throw std::runtime_error("png_malloc failed.");
+            }
+            for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+            {
+                const auto& entry = (*palette)[static_cast<uint16_t>(i)];
+                png_palette[i].blue = entry.Blue;
+                png_palette[i].green = entry.Green;
+                png_palette[i].red = entry.Red;
             }
+            png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
 
-            png_text text_ptr[1];
-            text_ptr[0].key = const_cast<char*>("Software");
-            text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
-            text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+            png_byte transparentIndex = 0;
+            png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+            colourType = PNG_COLOR_TYPE_PALETTE;
+        }
 
-            auto info_ptr = png_create_info_struct(png_ptr);
-            if (info_ptr == nullptr)
+        // Write header
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, width, height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
+    /**
+     * Filters and compresses the image data of a PNG on the task scheduler, rather than a row at a time through libpng.
+     * The filtered rows are split into blocks that are deflated on their own, each primed with the data before it, and
+     * joined into a single zlib stream. Rows can be encoded in several calls, as long as they are passed top to bottom.
+     */
+    class PngDataEncoder
+    {
+    private:
+        static constexpr size_t BlockSize = 128 * 1024;
+        static constexpr size_t WindowSize = 32 * 1024;
+        static constexpr size_t RowsPerTask = 32;
+
+        size_t _rowBytes;
+        size_t _bytesPerPixel;
+        // The unfiltered last row that was encoded, the rows after it are filtered against it
+        std::vector<uint8_t> _previousRow;
+        // The end of the data compressed so far, which the next block is primed with
+        std::vector<uint8_t> _window;
+        uLong _adler = adler32(0, nullptr, 0);
+        bool _headerWritten = false;
+
+    public:
+        PngDataEncoder(uint32_t width, uint32_t bytesPerPixel)
+            : _rowBytes(static_cast<size_t>(width) * bytesPerPixel)
+            , _bytesPerPixel(bytesPerPixel)
+        {
+        }
+
+        /**
+         * Returns the compressed rows, which are completed by the zlib trailer if they are the last of the image.
+         */
+        std::vector<uint8_t> Encode(const uint8_t* pixels, uint32_t numRows, uint32_t stride, bool last)
+        {
+            auto& scheduler = TaskScheduler::GetGlobal();
+
+            const size_t filteredRowBytes = _rowBytes + 1;
+            std::vector<uint8_t> filtered(numRows * filteredRowBytes);
+            scheduler.ParallelFor(0, numRows, RowsPerTask, [&](size_t y) {
+                const uint8_t* previousRow = y != 0 ? pixels + (y - 1) * stride : nullptr;
+                if (y == 0 && !_previousRow.empty())
+                {
+                    previousRow = _previousRow.data();
+                }
+                FilterRow(pixels + y * stride, previousRow, filtered.data() + y * filteredRowBytes);
+            });
+            if (numRows != 0)
             {
-                throw std::runtime_error("png_create_info_struct failed.");
+                const auto* lastRow = pixels + (numRows - 1) * stride;
+                _previousRow.assign(lastRow, lastRow + _rowBytes);
             }
 
-            if (image.Depth == 8)
-            {
-                if (image.Palette == nullptr)
+            // There is always a block when finishing, even if empty, to end the deflate stream
+            const size_t numBlocks = std::max<size_t>(last ? 1 : 0, (filtered.size() + BlockSize - 1) / BlockSize);
+            std::vector<std::vector<uint8_t>> blocks(numBlocks);
+            std::vector<uLong> blockAdlers(numBlocks);
+            std::vector<uint8_t> blockResults(numBlocks);
+            scheduler.ParallelFor(0, numBlocks, 1, [&](size_t i) {
+                const size_t start = i * BlockSize;
+                const size_t length = std::min(BlockSize, filtered.size() - start);
+                const uint8_t* dictionary = _window.data();
+                size_t dictionaryLength = _window.size();
+                if (i != 0)
                 {
-                    throw std::runtime_error("Expected a palette for 8-bit image.");
+                    dictionary = filtered.data() + start - WindowSize;
+                    dictionaryLength = WindowSize;
                 }
+                const bool finish = last && i == numBlocks - 1;
+                blockResults[i] = DeflateBlock(
+                    filtered.data() + start, length, dictionary, dictionaryLength, finish, blocks[i]);
+                blockAdlers[i] = adler32(adler32(0, nullptr, 0), filtered.data() + start, static_cast<uInt>(length));
+            });
+            if (std::find(blockResults.begin(), blockResults.end(), 0) != blockResults.end())
+            {
+                throw std::runtime_error("Unable to compress the image.");
+            }
 
-                // Set the palette
-                png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
-                if (png_palette == nullptr)
+            std::vector<uint8_t> result;
+            if (!_headerWritten)
+            {
+                // Deflate with a 32 KiB window and the default compression level
+                result.push_back(0x78);
+                result.push_back(0x9C);
+                _headerWritten = true;
+            }
+            for (size_t i = 0; i < numBlocks; i++)
+            {
+                result.insert(result.end(), blocks[i].begin(), blocks[i].end());
+                const size_t length = std::min(BlockSize, filtered.size() - i * BlockSize);
+                _adler = adler32_combine(_adler, blockAdlers[i], static_cast<z_off_t>(length));
+            }
+            if (last)
+            {
+                result.push_back(static_cast<uint8_t>(_adler >> 24));
+                result.push_back(static_cast<uint8_t>(_adler >> 16));
+                result.push_back(static_cast<uint8_t>(_adler >> 8));
+                result.push_back(static_cast<uint8_t>(_adler));
+            }
+
+            if (filtered.size() >= WindowSize)
+            {
+                _window.assign(filtered.end() - WindowSize, filtered.end());
+            }
+            else
+            {
+                _window.insert(_window.end(), filtered.begin(), filtered.end());
+                if (_window.size() > WindowSize)
                 {
-                    throw std::runtime_error("png_malloc failed.");
+                    _window.erase(_window.begin(), _window.end() - WindowSize);
                 }
-                for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+            }
+            return result;
+        }
+
+    private:
+        static uint8_t PaethPredictor(int32_t a, int32_t b, int32_t c)
+        {
+            const int32_t p = a + b - c;
+            const int32_t pa = std::abs(p - a);
+            const int32_t pb = std::abs(p - b);
+            const int32_t pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc)
+                return static_cast<uint8_t>(a);
+            if (pb <= pc)
+                return static_cast<uint8_t>(b);
+            return static_cast<uint8_t>(c);
+        }
+
+        uint8_t FilterByte(uint8_t filterType, const uint8_t* row, const uint8_t* previousRow, size_t i) const
+        {
+            const uint8_t a = i >= _bytesPerPixel ? row[i - _bytesPerPixel] : 0;
+            const uint8_t b = previousRow != nullptr ? previousRow[i] : 0;
+            const uint8_t c = i >= _bytesPerPixel && previousRow != nullptr ? previousRow[i - _bytesPerPixel] : 0;
+            switch (filterType)
+            {
+                case PNG_FILTER_VALUE_SUB:
+                    return row[i] - a;
+                case PNG_FILTER_VALUE_UP:
+                    return row[i] - b;
+                case PNG_FILTER_VALUE_AVG:
+                    return row[i] - static_cast<uint8_t>((a + b) / 2);
+                case PNG_FILTER_VALUE_PAETH:
+                    return row[i] - PaethPredictor(a, b, c);
+                default:
+                    return row[i];
+            }
+        }
+
+        /**
+         * Writes the filter type followed by the filtered row. Like libpng, paletted rows are not filtered and other rows
+         * use the filter with the lowest sum of absolute differences.
+         */
+        void FilterRow(const uint8_t* row, const uint8_t* previousRow, uint8_t* dst) const
+        {
+            uint8_t bestFilter = PNG_FILTER_VALUE_NONE;
+            if (_bytesPerPixel > 1)
+            {
+                uint64_t bestSum = std::numeric_limits<uint64_t>::max();
+                for (uint8_t filterType = PNG_FILTER_VALUE_NONE; filterType < PNG_FILTER_VALUE_LAST; filterType++)
                 {
-                    const auto& entry = (*image.Palette)[static_cast<uint16_t>(i)];
-                    png_palette[i].blue = entry.Blue;
-                    png_palette[i].green = entry.Green;
-                    png_palette[i].red = entry.Red;
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i < _rowBytes; i++)
+                    {
+                        sum += std::abs(static_cast<int8_t>(FilterByte(filterType, row, previousRow, i)));
+                    }
+                    if (sum < bestSum)
+                    {
+                        bestFilter = filterType;
+                        bestSum = sum;
+                    }
                 }
-                png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
             }
 
-            png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+            dst[0] = bestFilter;
+            for (size_t i = 0; i < _rowBytes; i++)
+            {
+                dst[i + 1] = FilterByte(bestFilter, row, previousRow, i);
+            }
+        }
 
-            // Set error handler
-            if (setjmp(png_jmpbuf(png_ptr)))
+        /**
+         * Compresses the block as raw deflate data. Blocks other than the last end with a sync flush, so they are byte
+         * aligned and can be joined with the next block.
+         */
+        static bool DeflateBlock(
+            const uint8_t* data, size_t length, const uint8_t* dictionary, size_t dictionaryLength, bool finish,
+            std::vector<uint8_t>& output)
+        {
+            z_stream strm{};
+            if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
             {
-                throw std::runtime_error("PNG ERROR");
+                return false;
+            }
+            if (dictionaryLength != 0)
+            {
+                deflateSetDictionary(&strm, dictionary, static_cast<uInt>(dictionaryLength));
             }
 
-            // Write header
-            auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
-            if (image.Depth == 8)
+            // The bound is for a finished stream, leave room for the empty stored block of a sync flush
+            output.resize(deflateBound(&strm, static_cast<uLong>(length)) + 16);
+            strm.next_in = const_cast<Bytef*>(data);
+            strm.avail_in = static_cast<uInt>(length);
+            strm.next_out = output.data();
+            strm.avail_out = static_cast<uInt>(output.size());
+            auto ret = deflate(&strm, finish ? Z_FINISH : Z_SYNC_FLUSH);
+            bool success = finish ? ret == Z_STREAM_END : ret == Z_OK && strm.avail_in == 0 && strm.avail_out != 0;
+            output.resize(strm.total_out);
+            deflateEnd(&strm);
+            return success;
+        }
+    };
+
+    /**
+     * Writes the compressed image data, split into chunks that are not too large for readers to buffer.
+     */
+    static void WritePngData(png_structp png_ptr, const std::vector<uint8_t>& data)
+    {
+        static constexpr png_byte chunkName[] = { 'I', 'D', 'A', 'T', '\0' };
+        static constexpr size_t maxChunkLength = 1024 * 1024;
+        for (size_t start = 0; start < data.size(); start += maxChunkLength)
+        {
+            png_write_chunk(png_ptr, chunkName, data.data() + start, std::min(maxChunkLength, data.size() - start));
+        }
+    }
+
+    static void WritePngEnd(png_structp png_ptr)
+    {
+        static constexpr png_byte chunkName[] = { 'I', 'E', 'N', 'D', '\0' };
+        png_write_chunk(png_ptr, chunkName, nullptr, 0);
+    }
+
+    static void WritePng(std::ostream& ostream, const Image& image)
+    {
+        if (image.Depth == 8 && image.Palette == nullptr)
+        {
+            throw std::runtime_error("Expected a palette for 8-bit image.");
+        }
+
+        // Compress the pixels first, libpng only writes the header and the chunks around them
+        auto imageData = PngDataEncoder(image.Width, image.Depth == 8 ? 1 : 4)
+                             .Encode(image.Pixels.data(), image.Height, image.Stride, true);
+
+        png_structp png_ptr = nullptr;
+        png_colorp png_palette = nullptr;
+        try
+        {
+            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+            if (png_ptr == nullptr)
             {
-                png_byte transparentIndex = 0;
-                png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
-                colourType = PNG_COLOR_TYPE_PALETTE;
+                throw std::runtime_error("png_create_write_struct failed.");
             }
-            png_set_text(png_ptr, info_ptr, text_ptr, 1);
-            png_set_IHDR(
-                png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
-                PNG_FILTER_TYPE_DEFAULT);
-            png_write_info(png_ptr, info_ptr);
-
-            // Write pixels
-            auto pixels = image.Pixels.data();
-            for (uint32_t y = 0; y < image.Height; y++)
+
+            auto info_ptr = png_create_info_struct(png_ptr);
+            if (info_ptr == nullptr)
             {
-                png_write_row(png_ptr, const_cast<png_byte*>(pixels));
-                pixels += image.Stride;
+                throw std::runtime_error("png_create_info_struct failed.");
             }
 
-            png_write_end(png_ptr, nullptr);
+            png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+
+            // Set error handler
+            if (setjmp(png_jmpbuf(png_ptr)))
+            {
+                throw std::runtime_error("PNG ERROR");
+            }
+
+            WritePngHeader(
+                png_ptr, info_ptr, png_palette, image.Width, image.Height, image.Depth == 8 ? image.Palette.get() : nullptr);
+
+            WritePngData(png_ptr, imageData);
+            WritePngEnd(png_ptr);
             png_destroy_info_struct(png_ptr, &info_ptr);
             png_free(png_ptr, png_palette);
             png_destroy_write_struct(&png_ptr, nullptr);
@@ -251,6 +492,107 @@ namespace Imaging
         }
     }
 
+    struct PngRowWriter::Data
+    {
+        std::ofstream Stream;
+        png_structp Png = nullptr;
+        png_infop Info = nullptr;
+        png_colorp Palette = nullptr;
+        std::unique_ptr<PngDataEncoder> Encoder;
+        uint32_t Height = 0;
+        uint32_t RowsWritten = 0;
+        bool Finished = false;
+    };
+
+    PngRowWriter::PngRowWriter(const std::string_view& path, uint32_t width, uint32_t height, const GamePalette& palette)
+        : _data(std::make_unique<Data>())
+    {
+#if defined(_WIN32) && !defined(__MINGW32__)
+        auto pathW = String::ToWideChar(path);
+        _data->Stream.open(pathW, std::ios::binary);
+#else
+        _data->Stream.open(std::string(path), std::ios::binary);
+#endif
+        if (!_data->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open the file to write the image to.");
+        }
+
+        _data->Height = height;
+        _data->Encoder = std::make_unique<PngDataEncoder>(width, 1);
+        try
+        {
+            _data->Png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+            if (_data->Png == nullptr)
+            {
+                throw std::runtime_error("png_create_write_struct failed.");
+            }
+            _data->Info = png_create_info_struct(_data->Png);
+            if (_data->Info == nullptr)
+            {
+                throw std::runtime_error("png_create_info_struct failed.");
+            }
+
+            png_set_write_fn(_data->Png, &_data->Stream, PngWriteData, PngFlush);
+            if (setjmp(png_jmpbuf(_data->Png)))
+            {
+                throw std::runtime_error("PNG ERROR");
+            }
+            WritePngHeader(_data->Png, _data->Info, _data->Palette, width, height, &palette);
+        }
+        catch (const std::exception&)
+        {
+            Release();
+            throw;
+        }
+    }
+
+    PngRowWriter::~PngRowWriter()
+    {
+        Release();
+    }
+
+    void PngRowWriter::Release()
+    {
+        if (_data->Png != nullptr)
+        {
+            png_free(_data->Png, _data->Palette);
+            png_destroy_write_struct(&_data->Png, &_data->Info);
+            _data->Palette = nullptr;
+        }
+    }
+
+    void PngRowWriter::WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        Guard::Assert(_data->RowsWritten + numRows <= _data->Height, "More rows written than the image has");
+        const bool lastRows = _data->RowsWritten + numRows == _data->Height;
+        auto imageData = _data->Encoder->Encode(pixels, numRows, stride, lastRows);
+        if (setjmp(png_jmpbuf(_data->Png)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        WritePngData(_data->Png, imageData);
+        _data->RowsWritten += numRows;
+    }
+
+    void PngRowWriter::Finish()
+    {
+        if (_data->Finished)
+            return;
+
+        if (_data->RowsWritten != _data->Height)
+        {
+            throw std::runtime_error("Not all rows of the image have been written.");
+        }
+        if (setjmp(png_jmpbuf(_data->Png)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        WritePngEnd(_data->Png);
+        _data->Stream.flush();
+        _data->Finished = true;
+    }
+
     IMAGE_FORMAT GetImageFormatFromPath(const std::string_view& path)
     {
         if (String::EndsWith(path, ".png", true))
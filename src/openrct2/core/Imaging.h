@@ -52,4 +52,28 @@ namespace Imaging
     void WriteToFile(const std::string_view& path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Writes an 8-bit PNG a band of rows at a time, so large images never have to be in memory as a whole. The rows
+     * have to be written top to bottom, the image is complete once Finish has been called after the last of them.
+     */
+    class PngRowWriter
+    {
+    private:
+        struct Data;
+        std::unique_ptr<Data> _data;
+
+    public:
+        PngRowWriter(const std::string_view& path, uint32_t width, uint32_t height, const GamePalette& palette);
+        ~PngRowWriter();
+
+        PngRowWriter(const PngRowWriter&) = delete;
+        PngRowWriter& operator=(const PngRowWriter&) = delete;
+
+        void WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride);
+        void Finish();
+
+    private:
+        void Release();
+    };
 } // namespace Imaging
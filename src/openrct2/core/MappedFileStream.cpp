@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MappedFileStream.h"
+
+#include "../platform/Platform2.h"
+#include "FileStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpenRCT2
+{
+    MappedFileStream::MappedFileStream(const std::string& path)
+    {
+        _data = static_cast<const uint8_t*>(Platform::MapFile(path, &_dataSize));
+        if (_data == nullptr)
+        {
+            throw IOException("Unable to map file.");
+        }
+    }
+
+    MappedFileStream::~MappedFileStream()
+    {
+        Platform::UnmapFile(_data, _dataSize);
+    }
+
+    bool MappedFileStream::CanRead() const
+    {
+        return true;
+    }
+
+    bool MappedFileStream::CanWrite() const
+    {
+        return false;
+    }
+
+    uint64_t MappedFileStream::GetLength() const
+    {
+        return _dataSize;
+    }
+
+    uint64_t MappedFileStream::GetPosition() const
+    {
+        return _position;
+    }
+
+    void MappedFileStream::SetPosition(uint64_t position)
+    {
+        Seek(position, STREAM_SEEK_BEGIN);
+    }
+
+    void MappedFileStream::Seek(int64_t offset, int32_t origin)
+    {
+        uint64_t newPosition;
+        switch (origin)
+        {
+            default:
+            case STREAM_SEEK_BEGIN:
+                newPosition = offset;
+                break;
+            case STREAM_SEEK_CURRENT:
+                newPosition = _position + offset;
+                break;
+            case STREAM_SEEK_END:
+                newPosition = _dataSize + offset;
+                break;
+        }
+
+        if (newPosition > _dataSize)
+        {
+            throw IOException("New position out of bounds.");
+        }
+        _position = static_cast<size_t>(newPosition);
+    }
+
+    void MappedFileStream::Read(void* buffer, uint64_t length)
+    {
+        if (_position + length > _dataSize)
+        {
+            throw IOException("Attempted to read past end of stream.");
+        }
+
+        std::memcpy(buffer, _data + _position, static_cast<size_t>(length));
+        _position += static_cast<size_t>(length);
+    }
+
+    void MappedFileStream::Write(const void* buffer, uint64_t length)
+    {
+        throw IOException("Stream is read only.");
+    }
+
+    uint64_t MappedFileStream::TryRead(void* buffer, uint64_t length)
+    {
+        uint64_t bytesToRead = std::min<uint64_t>(length, _dataSize - _position);
+        Read(buffer, bytesToRead);
+        return bytesToRead;
+    }
+
+    const void* MappedFileStream::GetData() const
+    {
+        return _data;
+    }
+
+    std::unique_ptr<IStream> OpenFileForReading(const std::string& path)
+    {
+        try
+        {
+            return std::make_unique<MappedFileStream>(path);
+        }
+        catch (const IOException&)
+        {
+            // Empty files and files on some file systems can not be mapped, FileStream reports any real error
+            return std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+        }
+    }
+
+} // namespace OpenRCT2
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "IStream.hpp"
+
+#include <memory>
+#include <string>
+
+namespace OpenRCT2
+{
+    /**
+     * A read only stream over a file that is mapped into memory. GetData returns the mapping, so readers such as
+     * SawyerChunkReader can decode straight from it rather than copying the file into buffers first.
+     */
+    class MappedFileStream final : public IStream
+    {
+    private:
+        const uint8_t* _data = nullptr;
+        size_t _dataSize = 0;
+        size_t _position = 0;
+
+    public:
+        explicit MappedFileStream(const std::string& path);
+        MappedFileStream(const MappedFileStream&) = delete;
+        MappedFileStream& operator=(const MappedFileStream&) = delete;
+        ~MappedFileStream() override;
+
+        ///////////////////////////////////////////////////////////////////////////
+        // ISteam methods
+        ///////////////////////////////////////////////////////////////////////////
+        bool CanRead() const override;
+        bool CanWrite() const override;
+
+        uint64_t GetLength() const override;
+        uint64_t GetPosition() const override;
+        void SetPosition(uint64_t position) override;
+        void Seek(int64_t offset, int32_t origin) override;
+
+        void Read(void* buffer, uint64_t length) override;
+        void Write(const void* buffer, uint64_t length) override;
+
+        uint64_t TryRead(void* buffer, uint64_t length) override;
+
+        const void* GetData() const override;
+    };
+
+    /**
+     * Opens the file for reading as a MappedFileStream, or as a FileStream if the file can not be mapped.
+     */
+    std::unique_ptr<IStream> OpenFileForReading(const std::string& path);
+
+} // namespace OpenRCT2
@@ -69,8 +69,18 @@ namespace OpenRCT2
 
     MemoryStream& MemoryStream::operator=(MemoryStream&& mv) noexcept
     {
+        if (this == &mv)
+        {
+            return *this;
+        }
+        if (_access & MEMORY_ACCESS::OWNER)
+        {
+            Memory::Free(_data);
+        }
+
         _access = mv._access;
         _dataCapacity = mv._dataCapacity;
+        _dataSize = mv._dataSize;
         _data = mv._data;
         _position = mv._position;
 
@@ -100,6 +110,24 @@ namespace OpenRCT2
         return _data;
     }
 
+    void MemoryStream::Reserve(size_t capacity)
+    {
+        if ((_access & MEMORY_ACCESS::OWNER) && _dataCapacity < capacity)
+        {
+            // Unlike growing while writing, allocate exactly what was asked for
+            uint64_t position = GetPosition();
+            _dataCapacity = capacity;
+            _data = Memory::Reallocate(_data, _dataCapacity);
+            _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + static_cast<uintptr_t>(position));
+        }
+    }
+
+    void MemoryStream::Clear()
+    {
+        _dataSize = 0;
+        _position = _data;
+    }
+
     bool MemoryStream::CanRead() const
     {
         return (_access & MEMORY_ACCESS::READ) != 0;
@@ -50,6 +50,18 @@ namespace OpenRCT2
         void* GetDataCopy() const;
         void* TakeData();
 
+        /**
+         * Grows the buffer so that up to capacity bytes can be written without reallocating, for writers that know
+         * roughly how much they are going to write. Only streams that own their buffer can grow.
+         */
+        void Reserve(size_t capacity);
+
+        /**
+         * Empties the stream but keeps its buffer, so a stream that is written over and over again only allocates
+         * until it has reached the largest size it is needed for.
+         */
+        void Clear();
+
         ///////////////////////////////////////////////////////////////////////////
         // ISteam methods
         ///////////////////////////////////////////////////////////////////////////
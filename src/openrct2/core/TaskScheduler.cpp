@@ -0,0 +1,203 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <string>
+
+static constexpr size_t NoWorker = std::numeric_limits<size_t>::max();
+
+// Identifies the worker running on the current thread, if any.
+static thread_local const TaskScheduler* _currentScheduler = nullptr;
+static thread_local size_t _currentWorkerIndex = NoWorker;
+
+TaskScheduler::TaskScheduler(size_t numWorkers)
+{
+    if (numWorkers == 0)
+    {
+        // The thread waiting on a group takes part in the work, so leave a core for it.
+        auto hardwareThreads = std::thread::hardware_concurrency();
+        numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    for (size_t n = 0; n < numWorkers; n++)
+    {
+        _queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t n = 0; n < numWorkers; n++)
+    {
+        _threads.emplace_back(&TaskScheduler::ProcessQueue, this, n);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::unique_lock<MutexType> lock(_sleepMutex);
+        _shouldStop = true;
+        _condWork.notify_all();
+    }
+
+    for (auto&& th : _threads)
+    {
+        assert(th.joinable() != false);
+        th.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::GetGlobal()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+void TaskScheduler::Schedule(TaskGroup& group, TaskFn fn)
+{
+    group._pending++;
+
+    // Workers push onto their own queue so nested work stays local, other threads spread it out.
+    auto queueIndex = GetCurrentWorkerIndex();
+    if (queueIndex == NoWorker)
+    {
+        queueIndex = _nextQueue++ % _queues.size();
+    }
+
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<MutexType> lock(queue.Mutex);
+        queue.Tasks.push_back({ std::move(fn), &group });
+    }
+
+    _numQueued++;
+    {
+        std::lock_guard<MutexType> lock(_sleepMutex);
+        _condWork.notify_one();
+    }
+}
+
+void TaskScheduler::Wait(TaskGroup& group, const std::function<void()>& reportFn)
+{
+    auto preferredQueue = GetCurrentWorkerIndex();
+    if (preferredQueue == NoWorker)
+    {
+        preferredQueue = 0;
+    }
+
+    while (!group.IsComplete())
+    {
+        if (RunPendingTask(preferredQueue))
+        {
+            continue;
+        }
+
+        // Nothing left to help with, the remaining tasks of the group are running on other threads.
+        PROFILE_ZONE("TaskScheduler::Wait");
+        std::unique_lock<MutexType> lock(_sleepMutex);
+        if (reportFn)
+        {
+            _condDone.wait_for(lock, std::chrono::milliseconds(50), [&group]() { return group.IsComplete(); });
+            lock.unlock();
+            reportFn();
+        }
+        else
+        {
+            _condDone.wait(lock, [&group]() { return group.IsComplete(); });
+        }
+    }
+
+    if (reportFn)
+    {
+        reportFn();
+    }
+}
+
+void TaskScheduler::ProcessQueue(size_t workerIndex)
+{
+    _currentScheduler = this;
+    _currentWorkerIndex = workerIndex;
+    PROFILE_THREAD_NAME(("Task worker " + std::to_string(workerIndex)).c_str());
+
+    while (!_shouldStop)
+    {
+        if (RunPendingTask(workerIndex))
+        {
+            continue;
+        }
+
+        std::unique_lock<MutexType> lock(_sleepMutex);
+        _condWork.wait(lock, [this]() { return _shouldStop || _numQueued != 0; });
+    }
+}
+
+bool TaskScheduler::RunPendingTask(size_t preferredQueue)
+{
+    if (_numQueued == 0)
+    {
+        return false;
+    }
+
+    // Take the most recent task from our own queue, otherwise steal the oldest one from another.
+    Task task;
+    bool found = TryTakeTask(preferredQueue, true, task);
+    for (size_t i = 1; !found && i < _queues.size(); i++)
+    {
+        found = TryTakeTask((preferredQueue + i) % _queues.size(), false, task);
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    {
+        PROFILE_ZONE("Task");
+        task.Fn();
+    }
+    CompleteTask(*task.Group);
+    return true;
+}
+
+bool TaskScheduler::TryTakeTask(size_t queueIndex, bool fromBack, Task& task)
+{
+    auto& queue = *_queues[queueIndex];
+    std::lock_guard<MutexType> lock(queue.Mutex);
+    if (queue.Tasks.empty())
+    {
+        return false;
+    }
+
+    if (fromBack)
+    {
+        task = std::move(queue.Tasks.back());
+        queue.Tasks.pop_back();
+    }
+    else
+    {
+        task = std::move(queue.Tasks.front());
+        queue.Tasks.pop_front();
+    }
+    _numQueued--;
+    return true;
+}
+
+void TaskScheduler::CompleteTask(TaskGroup& group)
+{
+    if (--group._pending == 0)
+    {
+        std::lock_guard<MutexType> lock(_sleepMutex);
+        _condDone.notify_all();
+    }
+}
+
+size_t TaskScheduler::GetCurrentWorkerIndex() const
+{
+    return _currentScheduler == this ? _currentWorkerIndex : NoWorker;
+}
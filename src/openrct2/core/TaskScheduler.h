@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Profiling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A set of tasks that can be waited on as a whole. A group must outlive all the tasks scheduled in it.
+ */
+class TaskGroup
+{
+    friend class TaskScheduler;
+
+private:
+    std::atomic<size_t> _pending = { 0 };
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool IsComplete() const
+    {
+        return _pending == 0;
+    }
+};
+
+/**
+ * Work stealing task scheduler. Every worker owns a queue it pushes and pops from the back of, idle
+ * workers steal from the front of the other queues. Threads waiting on a task group help out with the
+ * remaining work instead of blocking, so waiting from within a task is safe.
+ */
+class TaskScheduler
+{
+public:
+    using TaskFn = std::function<void()>;
+
+private:
+    using MutexType = PROFILE_LOCKABLE_TYPE(std::mutex);
+
+    struct Task
+    {
+        TaskFn Fn;
+        TaskGroup* Group;
+    };
+
+    struct WorkerQueue
+    {
+        PROFILE_LOCKABLE(std::mutex, Mutex, "TaskScheduler::WorkerQueue");
+        std::deque<Task> Tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _numQueued = { 0 };
+    std::atomic<size_t> _nextQueue = { 0 };
+    std::atomic_bool _shouldStop = { false };
+    PROFILE_LOCKABLE(std::mutex, _sleepMutex, "TaskScheduler::Sleep");
+    ProfiledConditionVariable _condWork;
+    ProfiledConditionVariable _condDone;
+
+public:
+    explicit TaskScheduler(size_t numWorkers = 0);
+    ~TaskScheduler();
+
+    /**
+     * Returns the scheduler shared by the whole application, its workers are created on first use.
+     */
+    static TaskScheduler& GetGlobal();
+
+    size_t GetNumWorkers() const
+    {
+        return _threads.size();
+    }
+
+    void Schedule(TaskGroup& group, TaskFn fn);
+
+    /**
+     * Runs pending tasks on the calling thread until every task of the group has completed.
+     * @param reportFn Called periodically while waiting, e.g. to report progress.
+     */
+    void Wait(TaskGroup& group, const std::function<void()>& reportFn = nullptr);
+
+    /**
+     * Calls fn(i) for every i in [begin, end), split into chunks of chunkSize indices. A chunk size of
+     * zero picks one that gives each worker a few chunks to balance uneven items.
+     */
+    template<typename TFunc> void ParallelFor(size_t begin, size_t end, size_t chunkSize, TFunc&& fn)
+    {
+        if (begin >= end)
+            return;
+
+        const size_t count = end - begin;
+        if (chunkSize == 0)
+        {
+            chunkSize = std::max<size_t>(1, count / ((GetNumWorkers() + 1) * 4));
+        }
+
+        TaskGroup group;
+        for (size_t chunkStart = begin; chunkStart < end; chunkStart += chunkSize)
+        {
+            const size_t chunkEnd = std::min(end, chunkStart + chunkSize);
+            Schedule(group, [&fn, chunkStart, chunkEnd]() {
+                for (size_t i = chunkStart; i < chunkEnd; i++)
+                {
+                    fn(i);
+                }
+            });
+        }
+        Wait(group);
+    }
+
+private:
+    void ProcessQueue(size_t workerIndex);
+    bool RunPendingTask(size_t preferredQueue);
+    bool TryTakeTask(size_t queueIndex, bool fromBack, Task& task);
+    void CompleteTask(TaskGroup& group);
+    size_t GetCurrentWorkerIndex() const;
+};
@@ -42,6 +42,205 @@ void mask_avx2(
     }
 }
 
+template<int32_t TZoom> static __m128i LoadRLERunPixels(const uint8_t* src)
+{
+    // Picks every (1 << TZoom)th of the next (16 << TZoom) source pixels
+    if constexpr (TZoom == 0)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+    else if constexpr (TZoom == 1)
+    {
+        const __m256i mask = _mm256_set1_epi16(0xFF);
+        const __m256i pixels = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), mask);
+        return _mm_packus_epi16(_mm256_castsi256_si128(pixels), _mm256_extracti128_si256(pixels, 1));
+    }
+    else
+    {
+        static_assert(TZoom == 2);
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        const __m256i a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), mask);
+        const __m256i b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32)), mask);
+        const __m128i lo = _mm_packus_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+        const __m128i hi = _mm_packus_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+        return _mm_packus_epi16(lo, hi);
+    }
+}
+
+/**
+ * Looks up eight indices in a palette map. Indices outside of the map read as 0, like PaletteMap::operator[].
+ */
+static __m256i LookupPaletteMap(const uint8_t* data, __m256i dataLength, __m256i lastDword, __m256i indices)
+{
+    // Gather the dword starting at each index, the last dword of the map is shifted instead to not read past its end
+    const __m256i base = _mm256_max_epi32(_mm256_min_epi32(indices, lastDword), _mm256_setzero_si256());
+    const __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(indices, base), 3);
+    const __m256i gathered = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data), base, 1);
+    const __m256i values = _mm256_and_si256(_mm256_srlv_epi32(gathered, shift), _mm256_set1_epi32(0xFF));
+    const __m256i inRange = _mm256_andnot_si256(
+        _mm256_cmpgt_epi32(_mm256_setzero_si256(), indices), _mm256_cmpgt_epi32(dataLength, indices));
+    return _mm256_and_si256(values, inRange);
+}
+
+static __m128i PackLookups(__m256i lo, __m256i hi)
+{
+    // _mm256_packus_epi32 interleaves the 128-bit lanes of its arguments, so put them back in order
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+template<DrawBlendOp TBlendOp, int32_t TZoom>
+static void rle_run_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, const PaletteMap& paletteMap)
+{
+    constexpr int32_t sourceStep = 16 << TZoom;
+    const uint8_t* data = paletteMap.GetData();
+    const __m256i dataLength = _mm256_set1_epi32(static_cast<int32_t>(paletteMap.GetDataLength()));
+    const __m256i lastDword = _mm256_set1_epi32(static_cast<int32_t>(paletteMap.GetDataLength()) - 4);
+    const __m128i zero128 = {};
+    while (numPixels >= sourceStep)
+    {
+        const __m128i pixels = LoadRLERunPixels<TZoom>(src);
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+
+        __m256i indicesLo;
+        __m256i indicesHi;
+        if constexpr ((TBlendOp & BLEND_SRC) != 0 && (TBlendOp & BLEND_DST) != 0)
+        {
+            // Same index as PaletteMap::Blend
+            const __m256i one = _mm256_set1_epi32(1);
+            const __m256i srcLo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(pixels), one);
+            const __m256i srcHi = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8)), one);
+            indicesLo = _mm256_add_epi32(_mm256_slli_epi32(srcLo, 8), _mm256_cvtepu8_epi32(dest));
+            indicesHi = _mm256_add_epi32(_mm256_slli_epi32(srcHi, 8), _mm256_cvtepu8_epi32(_mm_srli_si128(dest, 8)));
+        }
+        else if constexpr ((TBlendOp & BLEND_SRC) != 0)
+        {
+            indicesLo = _mm256_cvtepu8_epi32(pixels);
+            indicesHi = _mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8));
+        }
+        else
+        {
+            indicesLo = _mm256_cvtepu8_epi32(dest);
+            indicesHi = _mm256_cvtepu8_epi32(_mm_srli_si128(dest, 8));
+        }
+
+        const __m128i remapped = PackLookups(
+            LookupPaletteMap(data, dataLength, lastDword, indicesLo), LookupPaletteMap(data, dataLength, lastDword, indicesHi));
+
+        // Transparent pixels and pixels remapped to 0 are left untouched
+        const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(pixels, zero128), _mm_cmpeq_epi8(remapped, zero128));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(remapped, dest, skip));
+
+        src += sourceStep;
+        dst += 16;
+        numPixels -= sourceStep;
+    }
+    rle_run_scalar(src, dst, numPixels, TZoom, TBlendOp, paletteMap);
+}
+
+template<DrawBlendOp TBlendOp>
+static void rle_run_remap_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, const PaletteMap& paletteMap)
+{
+    switch (zoom)
+    {
+        case 0:
+            rle_run_remap_avx2<TBlendOp, 0>(src, dst, numPixels, paletteMap);
+            break;
+        case 1:
+            rle_run_remap_avx2<TBlendOp, 1>(src, dst, numPixels, paletteMap);
+            break;
+        case 2:
+            rle_run_remap_avx2<TBlendOp, 2>(src, dst, numPixels, paletteMap);
+            break;
+        default:
+            rle_run_scalar(src, dst, numPixels, zoom, TBlendOp, paletteMap);
+            break;
+    }
+}
+
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+{
+    // The gather reads whole dwords, which needs a map of at least that size
+    if (paletteMap.GetDataLength() < 4)
+    {
+        rle_run_scalar(src, dst, numPixels, zoom, blendOp, paletteMap);
+        return;
+    }
+
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            rle_run_remap_avx2<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            rle_run_remap_avx2<BLEND_TRANSPARENT | BLEND_SRC>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            rle_run_remap_avx2<BLEND_TRANSPARENT | BLEND_DST>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        default:
+            // A plain copy gains nothing from AVX2 over the SSE4.1 kernel
+            rle_run_sse4_1(src, dst, numPixels, zoom, blendOp, paletteMap);
+            break;
+    }
+}
+
+void palette_expand_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette)
+{
+    const int* table = reinterpret_cast<const int*>(palette);
+    for (; numPixels >= 32; numPixels -= 32)
+    {
+        const __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m128i lo = _mm256_castsi256_si128(indices);
+        const __m128i hi = _mm256_extracti128_si256(indices, 1);
+        const __m256i a = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(lo), 4);
+        const __m256i b = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)), 4);
+        const __m256i c = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(hi), 4);
+        const __m256i d = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 8), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 16), c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 24), d);
+        src += 32;
+        dst += 32;
+    }
+    for (; numPixels >= 8; numPixels -= 8)
+    {
+        const __m128i indices = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dst), _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices), 4));
+        src += 8;
+        dst += 8;
+    }
+    palette_expand_scalar(src, dst, numPixels, palette);
+}
+
+void palette_remap_avx2(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap)
+{
+    // The gather reads whole dwords, which needs a map of at least that size
+    if (paletteMap.GetDataLength() < 4)
+    {
+        palette_remap_scalar(dst, numPixels, paletteMap);
+        return;
+    }
+
+    const uint8_t* data = paletteMap.GetData();
+    const __m256i dataLength = _mm256_set1_epi32(static_cast<int32_t>(paletteMap.GetDataLength()));
+    const __m256i lastDword = _mm256_set1_epi32(static_cast<int32_t>(paletteMap.GetDataLength()) - 4);
+    for (; numPixels >= 16; numPixels -= 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+        const __m256i lo = LookupPaletteMap(data, dataLength, lastDword, _mm256_cvtepu8_epi32(pixels));
+        const __m256i hi = LookupPaletteMap(data, dataLength, lastDword, _mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), PackLookups(lo, hi));
+        dst += 16;
+    }
+    palette_remap_scalar(dst, numPixels, paletteMap);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +254,21 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void palette_expand_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void palette_remap_avx2(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
@@ -9,24 +9,24 @@
 
 #include "Drawing.h"
 
-template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMagnify(DrawSpriteArgs& args)
+#include <array>
+#include <iterator>
+
+template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawBMPSpriteMagnify(DrawSpriteArgs& args)
 {
     auto& g1 = args.SourceImage;
     auto src = g1.offset + ((static_cast<size_t>(g1.width) * args.SrcY) + args.SrcX);
     auto dst = args.DestinationBits;
     auto& paletteMap = args.PalMap;
     auto dpi = args.DPI;
-    auto zoomLevel = dpi->zoom_level;
     size_t srcLineWidth = g1.width;
-    size_t dstLineWidth = (static_cast<size_t>(dpi->width) / zoomLevel) + dpi->pitch;
-    uint8_t zoom = 1 / zoomLevel;
-    auto width = args.Width / zoomLevel;
-    auto height = args.Height / zoomLevel;
-    for (; height > 0; height -= zoom)
+    size_t dstLineWidth = (static_cast<size_t>(dpi->width) << TZoom) + dpi->pitch;
+    constexpr uint8_t zoom = 1 << TZoom;
+    for (int32_t height = args.Height; height > 0; height--)
     {
         auto nextSrc = src + srcLineWidth;
         auto nextDst = dst + (dstLineWidth * zoom);
-        for (int32_t widthRemaining = width; widthRemaining > 0; widthRemaining -= zoom, src++, dst += zoom)
+        for (int32_t widthRemaining = args.Width; widthRemaining > 0; widthRemaining--, src++, dst += zoom)
         {
             // Copy src to a block of zoom * zoom on dst
             BlitPixels<TBlendOp>(src, dst, paletteMap, zoom, dstLineWidth);
@@ -36,7 +36,7 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMagnify(DrawSpr
     }
 }
 
-template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(DrawSpriteArgs& args)
+template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawBMPSpriteMinify(DrawSpriteArgs& args)
 {
     auto& g1 = args.SourceImage;
     auto src = g1.offset + ((static_cast<size_t>(g1.width) * args.SrcY) + args.SrcX);
@@ -45,10 +45,9 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(DrawSpri
     auto width = args.Width;
     auto height = args.Height;
     auto dpi = args.DPI;
-    auto zoomLevel = dpi->zoom_level;
-    size_t srcLineWidth = g1.width * zoomLevel;
-    size_t dstLineWidth = (static_cast<size_t>(dpi->width) / zoomLevel) + dpi->pitch;
-    uint8_t zoom = 1 * zoomLevel;
+    size_t srcLineWidth = static_cast<size_t>(g1.width) << TZoom;
+    size_t dstLineWidth = (static_cast<size_t>(dpi->width) >> TZoom) + dpi->pitch;
+    constexpr int32_t zoom = 1 << TZoom;
     for (; height > 0; height -= zoom)
     {
         auto nextSrc = src + srcLineWidth;
@@ -62,18 +61,38 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(DrawSpri
     }
 }
 
-template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSprite(DrawSpriteArgs& args)
+template<DrawBlendOp TBlendOp, int8_t TZoomLevel> static void FASTCALL DrawBMPSprite(DrawSpriteArgs& args)
 {
-    if (args.DPI->zoom_level < 0)
+    if constexpr (TZoomLevel < 0)
     {
-        DrawBMPSpriteMagnify<TBlendOp>(args);
+        DrawBMPSpriteMagnify<TBlendOp, -TZoomLevel>(args);
     }
     else
     {
-        DrawBMPSpriteMinify<TBlendOp>(args);
+        DrawBMPSpriteMinify<TBlendOp, TZoomLevel>(args);
     }
 }
 
+template<int8_t TZoomLevel>
+static constexpr std::array<DrawSpriteFn, SPRITE_BLEND_OP_COUNT> BMPSpriteFns = {
+    DrawBMPSprite<GetSpriteBlendOp(0), TZoomLevel>, DrawBMPSprite<GetSpriteBlendOp(1), TZoomLevel>,
+    DrawBMPSprite<GetSpriteBlendOp(2), TZoomLevel>, DrawBMPSprite<GetSpriteBlendOp(3), TZoomLevel>,
+    DrawBMPSprite<GetSpriteBlendOp(4), TZoomLevel>, DrawBMPSprite<GetSpriteBlendOp(5), TZoomLevel>,
+    DrawBMPSprite<GetSpriteBlendOp(6), TZoomLevel>, DrawBMPSprite<GetSpriteBlendOp(7), TZoomLevel>,
+};
+
+static constexpr const std::array<DrawSpriteFn, SPRITE_BLEND_OP_COUNT>* BMPSpriteFnsByZoom[] = {
+    &BMPSpriteFns<-2>, &BMPSpriteFns<-1>, &BMPSpriteFns<0>, &BMPSpriteFns<1>, &BMPSpriteFns<2>, &BMPSpriteFns<3>,
+};
+static_assert(std::size(BMPSpriteFnsByZoom) == SPRITE_DRAW_ZOOM_MAX - SPRITE_DRAW_ZOOM_MIN + 1);
+
+DrawSpriteFn gfx_get_bmp_sprite_fn(ZoomLevel zoomLevel, DrawBlendOp blendOp)
+{
+    auto level = static_cast<int8_t>(zoomLevel);
+    assert(level >= SPRITE_DRAW_ZOOM_MIN && level <= SPRITE_DRAW_ZOOM_MAX);
+    return (*BMPSpriteFnsByZoom[level - SPRITE_DRAW_ZOOM_MIN])[GetSpriteBlendIndex(blendOp)];
+}
+
 /**
  * Copies a sprite onto the buffer. There is no compression used on the sprite
  * image.
@@ -82,37 +101,39 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSprite(DrawSpriteArgs
  */
 void FASTCALL gfx_bmp_sprite_to_buffer(DrawSpriteArgs& args)
 {
-    auto imageId = args.Image;
+    gfx_get_bmp_sprite_fn(args.DPI->zoom_level, gfx_get_bmp_sprite_blend_op(args.Image, args.SourceImage))(args);
+}
 
+DrawBlendOp gfx_get_bmp_sprite_blend_op(ImageId imageId, const rct_g1_element& g1)
+{
     // Image uses the palette pointer to remap the colours of the image
     if (imageId.HasPrimary())
     {
         if (imageId.IsBlended())
         {
             // Copy non-transparent bitmap data but blend src and dst pixel using the palette map.
-            DrawBMPSprite<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(args);
+            return BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST;
         }
         else
         {
             // Copy non-transparent bitmap data but re-colour using the palette map.
-            DrawBMPSprite<BLEND_TRANSPARENT | BLEND_SRC>(args);
+            return BLEND_TRANSPARENT | BLEND_SRC;
         }
     }
     else if (imageId.IsBlended())
     {
         // Image is only a transparency mask. Just colour the pixels using the palette map.
         // Used for glass.
-        DrawBMPSprite<BLEND_TRANSPARENT | BLEND_DST>(args);
-        return;
+        return BLEND_TRANSPARENT | BLEND_DST;
     }
-    else if (!(args.SourceImage.flags & G1_FLAG_BMP))
+    else if (!(g1.flags & G1_FLAG_BMP))
     {
         // Copy raw bitmap data to target
-        DrawBMPSprite<BLEND_NONE>(args);
+        return BLEND_NONE;
     }
     else
     {
         // Copy raw bitmap data to target but exclude transparent pixels
-        DrawBMPSprite<BLEND_TRANSPARENT>(args);
+        return BLEND_TRANSPARENT;
     }
 }
@@ -10,7 +10,46 @@
 #include "Drawing.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <iterator>
+
+// The number of destination pixels the vectorised run kernels draw at once.
+static constexpr int32_t RLERunVectorPixels = 16;
+
+template<DrawBlendOp TBlendOp>
+static void RLERunScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, const PaletteMap& paletteMap)
+{
+    auto step = 1 << zoom;
+    while (numPixels > 0)
+    {
+        BlitPixel<TBlendOp>(src, dst, paletteMap);
+        numPixels -= step;
+        src += step;
+        dst++;
+    }
+}
+
+void rle_run_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+{
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            RLERunScalar<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            RLERunScalar<BLEND_TRANSPARENT | BLEND_SRC>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            RLERunScalar<BLEND_TRANSPARENT | BLEND_DST>(src, dst, numPixels, zoom, paletteMap);
+            break;
+        default:
+            RLERunScalar<BLEND_TRANSPARENT>(src, dst, numPixels, zoom, paletteMap);
+            break;
+    }
+}
 
 template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteMagnify(DrawSpriteArgs& args)
 {
@@ -166,6 +205,13 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
             else
             {
                 auto& paletteMap = args.PalMap;
+                if (numPixels >= (RLERunVectorPixels << TZoom))
+                {
+                    // Long runs are worth the call into the vectorised kernels
+                    rle_run_fn(src, dst, numPixels, TZoom, TBlendOp, paletteMap);
+                    continue;
+                }
+
                 while (numPixels > 0)
                 {
                     BlitPixel<TBlendOp>(src, dst, paletteMap);
@@ -178,35 +224,43 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     }
 }
 
-template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawSpriteArgs& args)
+template<DrawBlendOp TBlendOp, int8_t TZoomLevel> static void FASTCALL DrawRLESprite(DrawSpriteArgs& args)
 {
-    auto zoom_level = static_cast<int8_t>(args.DPI->zoom_level);
-    switch (zoom_level)
+    if constexpr (TZoomLevel < 0)
     {
-        case -2:
-            DrawRLESpriteMagnify<TBlendOp, 2>(args);
-            break;
-        case -1:
-            DrawRLESpriteMagnify<TBlendOp, 1>(args);
-            break;
-        case 0:
-            DrawRLESpriteMinify<TBlendOp, 0>(args);
-            break;
-        case 1:
-            DrawRLESpriteMinify<TBlendOp, 1>(args);
-            break;
-        case 2:
-            DrawRLESpriteMinify<TBlendOp, 2>(args);
-            break;
-        case 3:
-            DrawRLESpriteMinify<TBlendOp, 3>(args);
-            break;
-        default:
-            assert(false);
-            break;
+        DrawRLESpriteMagnify<TBlendOp, -TZoomLevel>(args);
+    }
+    else
+    {
+        DrawRLESpriteMinify<TBlendOp, TZoomLevel>(args);
     }
 }
 
+// RLE images always encode transparency, so ops without it share the transparent variant
+template<int8_t TZoomLevel>
+static constexpr std::array<DrawSpriteFn, SPRITE_BLEND_OP_COUNT> RLESpriteFns = {
+    DrawRLESprite<GetSpriteBlendOp(0) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(1) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(2) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(3) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(4) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(5) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(6) | BLEND_TRANSPARENT, TZoomLevel>,
+    DrawRLESprite<GetSpriteBlendOp(7) | BLEND_TRANSPARENT, TZoomLevel>,
+};
+
+static constexpr const std::array<DrawSpriteFn, SPRITE_BLEND_OP_COUNT>* RLESpriteFnsByZoom[] = {
+    &RLESpriteFns<-2>, &RLESpriteFns<-1>, &RLESpriteFns<0>, &RLESpriteFns<1>, &RLESpriteFns<2>, &RLESpriteFns<3>,
+};
+static_assert(std::size(RLESpriteFnsByZoom) == SPRITE_DRAW_ZOOM_MAX - SPRITE_DRAW_ZOOM_MIN + 1);
+
+DrawSpriteFn gfx_get_rle_sprite_fn(ZoomLevel zoomLevel, DrawBlendOp blendOp)
+{
+    auto level = static_cast<int8_t>(zoomLevel);
+    assert(level >= SPRITE_DRAW_ZOOM_MIN && level <= SPRITE_DRAW_ZOOM_MAX);
+    return (*RLESpriteFnsByZoom[level - SPRITE_DRAW_ZOOM_MIN])[GetSpriteBlendIndex(blendOp)];
+}
+
 /**
  * Transfers readied images onto buffers
  * This function copies the sprite data onto the screen
@@ -215,23 +269,28 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawSpriteArgs
  */
 void FASTCALL gfx_rle_sprite_to_buffer(DrawSpriteArgs& args)
 {
-    if (args.Image.HasPrimary())
+    gfx_get_rle_sprite_fn(args.DPI->zoom_level, gfx_get_rle_sprite_blend_op(args.Image))(args);
+}
+
+DrawBlendOp gfx_get_rle_sprite_blend_op(ImageId imageId)
+{
+    if (imageId.HasPrimary())
     {
-        if (args.Image.IsBlended())
+        if (imageId.IsBlended())
         {
-            DrawRLESprite<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(args);
+            return BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST;
         }
         else
         {
-            DrawRLESprite<BLEND_TRANSPARENT | BLEND_SRC>(args);
+            return BLEND_TRANSPARENT | BLEND_SRC;
         }
     }
-    else if (args.Image.IsBlended())
+    else if (imageId.IsBlended())
     {
-        DrawRLESprite<BLEND_TRANSPARENT | BLEND_DST>(args);
+        return BLEND_TRANSPARENT | BLEND_DST;
     }
     else
     {
-        DrawRLESprite<BLEND_TRANSPARENT>(args);
+        return BLEND_TRANSPARENT;
     }
 }
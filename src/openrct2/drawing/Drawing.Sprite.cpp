@@ -12,6 +12,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -20,6 +21,7 @@
 #include "Drawing.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -186,6 +188,42 @@ static rct_g1_element _g1Temp = {};
 static std::vector<rct_g1_element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+// The files the image data of the gx files is used from when they could be mapped, nullptr when it was read instead
+static std::unique_ptr<IStream> _g1File;
+static std::unique_ptr<IStream> _g2File;
+static std::unique_ptr<IStream> _csgFile;
+
+/**
+ * Reads the image data that follows the element headers of a gx file. A mapped file is kept open and its data used in
+ * place, so only the sprites that are drawn are paged in and the pages are shared by every process using the file.
+ */
+static void* read_gxdat_data(std::unique_ptr<IStream>& file, size_t size, std::unique_ptr<IStream>& mappedFile)
+{
+    const auto* fileData = static_cast<const uint8_t*>(file->GetData());
+    const auto position = file->GetPosition();
+    if (fileData != nullptr && position + size <= file->GetLength())
+    {
+        file->Seek(size, STREAM_SEEK_CURRENT);
+        mappedFile = std::move(file);
+        return const_cast<uint8_t*>(fileData + position);
+    }
+    mappedFile = nullptr;
+    return file->ReadArray<uint8_t>(size);
+}
+
+static void free_gxdat_data(rct_gx& gx, std::unique_ptr<IStream>& mappedFile)
+{
+    if (mappedFile != nullptr)
+    {
+        gx.data = nullptr;
+        mappedFile = nullptr;
+    }
+    else
+    {
+        SafeFree(gx.data);
+    }
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -196,8 +234,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g1.header = fs.ReadValue<rct_g1_header>();
+        auto fs = OpenFileForReading(path);
+        _g1.header = fs->ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
 
@@ -209,11 +247,11 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         // Read element headers
         bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
         _g1.elements.resize(_g1.header.num_entries);
-        read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
+        read_and_convert_gxdat(fs.get(), _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
         // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
+        _g1.data = read_gxdat_data(fs, _g1.header.total_size, _g1File);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
@@ -239,21 +277,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    free_gxdat_data(_g1, _g1File);
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    free_gxdat_data(_g2, _g2File);
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    free_gxdat_data(_csg, _csgFile);
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -268,15 +306,15 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g2.header = fs.ReadValue<rct_g1_header>();
+        auto fs = OpenFileForReading(path);
+        _g2.header = fs->ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
-        read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
+        read_and_convert_gxdat(fs.get(), _g2.header.num_entries, false, _g2.elements.data());
 
         // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        _g2.data = read_gxdat_data(fs, _g2.header.total_size, _g2File);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
@@ -315,9 +353,9 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileData = OpenFileForReading(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = fileData->GetLength();
 
         _csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = static_cast<uint32_t>(fileDataSize);
@@ -333,7 +371,7 @@ bool gfx_load_csg()
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
         // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        _csg.data = read_gxdat_data(fileData, _csg.header.total_size, _csgFile);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
@@ -414,68 +452,45 @@ void FASTCALL gfx_draw_sprite_software(rct_drawpixelinfo* dpi, ImageId imageId,
     }
 }
 
-/*
- * rct: 0x0067A46E
- * image_id (ebx) and also (0x00EDF81C)
- * palette_pointer (0x9ABDA4)
- * unknown_pointer (0x9E3CDC)
- * dpi (edi)
- * x (cx)
- * y (dx)
- */
-void FASTCALL gfx_draw_sprite_palette_set_software(
-    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap)
+template<int8_t TZoomLevel, typename T> static constexpr T ZoomDivide(T value)
 {
-    int32_t x = coords.x;
-    int32_t y = coords.y;
-
-    const auto* g1 = gfx_get_g1_element(imageId);
-    if (g1 == nullptr)
+    if constexpr (TZoomLevel < 0)
     {
-        return;
+        return value << -TZoomLevel;
     }
-
-    if (dpi->zoom_level > 0 && (g1->flags & G1_FLAG_HAS_ZOOM_SPRITE))
-    {
-        rct_drawpixelinfo zoomed_dpi = *dpi;
-        zoomed_dpi.bits = dpi->bits;
-        zoomed_dpi.x = dpi->x >> 1;
-        zoomed_dpi.y = dpi->y >> 1;
-        zoomed_dpi.height = dpi->height >> 1;
-        zoomed_dpi.width = dpi->width >> 1;
-        zoomed_dpi.pitch = dpi->pitch;
-        zoomed_dpi.zoom_level = dpi->zoom_level - 1;
-
-        const auto spriteCoords = ScreenCoordsXY{ x >> 1, y >> 1 };
-        gfx_draw_sprite_palette_set_software(
-            &zoomed_dpi, imageId.WithIndex(imageId.GetIndex() - g1->zoomed_offset), spriteCoords, paletteMap);
-        return;
-    }
-
-    if (dpi->zoom_level > 0 && (g1->flags & G1_FLAG_NO_ZOOM_DRAW))
+    else
     {
-        return;
+        return value >> TZoomLevel;
     }
+}
 
-    // Its used super often so we will define it to a separate variable.
-    auto zoom_level = dpi->zoom_level;
-    int32_t zoom_mask = zoom_level > 0 ? 0xFFFFFFFF * zoom_level : 0xFFFFFFFF;
+/**
+ * Clips the sprite to the dpi and draws it, compiled for each zoom level so the masks and shifts are constant.
+ */
+template<int8_t TZoomLevel>
+static void FASTCALL DrawSpriteClipped(
+    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap,
+    const rct_g1_element& g1)
+{
+    int32_t x = coords.x;
+    int32_t y = coords.y;
+    constexpr int32_t zoom_mask = TZoomLevel > 0 ? static_cast<int32_t>(0xFFFFFFFFu << TZoomLevel) : -1;
 
-    if (zoom_level > 0 && g1->flags & G1_FLAG_RLE_COMPRESSION)
+    if (TZoomLevel > 0 && (g1.flags & G1_FLAG_RLE_COMPRESSION))
     {
         x -= ~zoom_mask;
         y -= ~zoom_mask;
     }
 
     // This will be the height of the drawn image
-    int32_t height = g1->height;
+    int32_t height = g1.height;
 
     // This is the start y coordinate on the destination
-    int16_t dest_start_y = y + g1->y_offset;
+    int16_t dest_start_y = y + g1.y_offset;
 
     // For whatever reason the RLE version does not use
     // the zoom mask on the y coordinate but does on x.
-    if (g1->flags & G1_FLAG_RLE_COMPRESSION)
+    if (g1.flags & G1_FLAG_RLE_COMPRESSION)
     {
         dest_start_y -= dpi->y;
     }
@@ -503,7 +518,7 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
     }
     else
     {
-        if ((g1->flags & G1_FLAG_RLE_COMPRESSION) && zoom_level > 0)
+        if (TZoomLevel > 0 && (g1.flags & G1_FLAG_RLE_COMPRESSION))
         {
             source_start_y -= dest_start_y & ~zoom_mask;
             height += dest_start_y & ~zoom_mask;
@@ -522,15 +537,15 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
     if (height <= 0)
         return;
 
-    dest_start_y = dest_start_y / zoom_level;
+    dest_start_y = ZoomDivide<TZoomLevel>(dest_start_y);
 
     // This will be the width of the drawn image
-    int32_t width = g1->width;
+    int32_t width = g1.width;
 
     // This is the source start x coordinate
     int32_t source_start_x = 0;
     // This is the destination start x coordinate
-    int16_t dest_start_x = ((x + g1->x_offset + ~zoom_mask) & zoom_mask) - dpi->x;
+    int16_t dest_start_x = ((x + g1.x_offset + ~zoom_mask) & zoom_mask) - dpi->x;
 
     if (dest_start_x < 0)
     {
@@ -549,7 +564,7 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
     }
     else
     {
-        if ((g1->flags & G1_FLAG_RLE_COMPRESSION) && zoom_level > 0)
+        if (TZoomLevel > 0 && (g1.flags & G1_FLAG_RLE_COMPRESSION))
         {
             source_start_x -= dest_start_x & ~zoom_mask;
         }
@@ -567,16 +582,71 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
             return;
     }
 
-    dest_start_x = dest_start_x / zoom_level;
+    dest_start_x = ZoomDivide<TZoomLevel>(dest_start_x);
 
     uint8_t* dest_pointer = dpi->bits;
     // Move the pointer to the start point of the destination
-    dest_pointer += ((dpi->width / zoom_level) + dpi->pitch) * dest_start_y + dest_start_x;
+    dest_pointer += (ZoomDivide<TZoomLevel>(dpi->width) + dpi->pitch) * dest_start_y + dest_start_x;
 
-    DrawSpriteArgs args(dpi, imageId, paletteMap, *g1, source_start_x, source_start_y, width, height, dest_pointer);
+    DrawSpriteArgs args(dpi, imageId, paletteMap, g1, source_start_x, source_start_y, width, height, dest_pointer);
     gfx_sprite_to_buffer(args);
 }
 
+using DrawSpriteClippedFn = void(FASTCALL*)(
+    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap,
+    const rct_g1_element& g1);
+
+static constexpr DrawSpriteClippedFn DrawSpriteClippedFns[] = {
+    DrawSpriteClipped<-2>, DrawSpriteClipped<-1>, DrawSpriteClipped<0>,
+    DrawSpriteClipped<1>,  DrawSpriteClipped<2>,  DrawSpriteClipped<3>,
+};
+static_assert(std::size(DrawSpriteClippedFns) == SPRITE_DRAW_ZOOM_MAX - SPRITE_DRAW_ZOOM_MIN + 1);
+
+/*
+ * rct: 0x0067A46E
+ * image_id (ebx) and also (0x00EDF81C)
+ * palette_pointer (0x9ABDA4)
+ * unknown_pointer (0x9E3CDC)
+ * dpi (edi)
+ * x (cx)
+ * y (dx)
+ */
+void FASTCALL gfx_draw_sprite_palette_set_software(
+    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap)
+{
+    const auto* g1 = gfx_get_g1_element(imageId);
+    if (g1 == nullptr)
+    {
+        return;
+    }
+
+    if (dpi->zoom_level > 0 && (g1->flags & G1_FLAG_HAS_ZOOM_SPRITE))
+    {
+        rct_drawpixelinfo zoomed_dpi = *dpi;
+        zoomed_dpi.bits = dpi->bits;
+        zoomed_dpi.x = dpi->x >> 1;
+        zoomed_dpi.y = dpi->y >> 1;
+        zoomed_dpi.height = dpi->height >> 1;
+        zoomed_dpi.width = dpi->width >> 1;
+        zoomed_dpi.pitch = dpi->pitch;
+        zoomed_dpi.zoom_level = dpi->zoom_level - 1;
+
+        const auto spriteCoords = ScreenCoordsXY{ coords.x >> 1, coords.y >> 1 };
+        gfx_draw_sprite_palette_set_software(
+            &zoomed_dpi, imageId.WithIndex(imageId.GetIndex() - g1->zoomed_offset), spriteCoords, paletteMap);
+        return;
+    }
+
+    if (dpi->zoom_level > 0 && (g1->flags & G1_FLAG_NO_ZOOM_DRAW))
+    {
+        return;
+    }
+
+    auto level = static_cast<int8_t>(dpi->zoom_level);
+    assert(level >= SPRITE_DRAW_ZOOM_MIN && level <= SPRITE_DRAW_ZOOM_MAX);
+    DrawSpriteClippedFns[level - SPRITE_DRAW_ZOOM_MIN](dpi, imageId, coords, paletteMap, *g1);
+}
+
 void FASTCALL gfx_sprite_to_buffer(DrawSpriteArgs& args)
 {
     if (args.SourceImage.flags & G1_FLAG_RLE_COMPRESSION)
@@ -655,6 +725,17 @@ const rct_g1_element* gfx_get_g1_element(ImageId imageId)
 }
 
 const rct_g1_element* gfx_get_g1_element(int32_t image_id)
+{
+    auto g1 = gfx_peek_g1_element(image_id);
+    if (g1 != nullptr && (g1->flags & G1_FLAG_DEFERRED))
+    {
+        // The decoded image is kept by the deferred image, so the element itself never changes while it is drawn
+        return reinterpret_cast<DeferredImage*>(g1->offset)->Decode();
+    }
+    return g1;
+}
+
+const rct_g1_element* gfx_peek_g1_element(int32_t image_id)
 {
     openrct2_assert(!gOpenRCT2NoGraphics, "gfx_get_g1_element called on headless instance");
 
@@ -19,6 +19,10 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <unordered_map>
 
 enum : uint32_t
 {
@@ -33,6 +37,61 @@ enum : uint32_t
 
 static int32_t ttf_get_string_width(const utf8* text);
 
+namespace
+{
+    struct WrappedStringKey
+    {
+        std::string Text;
+        int32_t Width;
+        int16_t FontSpriteBase;
+        uint16_t FontFlags;
+        bool UseTrueTypeFont;
+
+        bool operator==(const WrappedStringKey& other) const
+        {
+            return Width == other.Width && FontSpriteBase == other.FontSpriteBase && FontFlags == other.FontFlags
+                && UseTrueTypeFont == other.UseTrueTypeFont && Text == other.Text;
+        }
+    };
+
+    struct WrappedStringKeyHash
+    {
+        size_t operator()(const WrappedStringKey& key) const
+        {
+            size_t hash = std::hash<std::string>()(key.Text);
+            hash = hash * 31 + static_cast<size_t>(key.Width);
+            hash = hash * 31 + static_cast<uint16_t>(key.FontSpriteBase);
+            hash = hash * 31 + key.FontFlags;
+            return hash * 2 + (key.UseTrueTypeFont ? 1 : 0);
+        }
+    };
+
+    struct WrappedString
+    {
+        // The wrapped text including the terminators inserted between the lines
+        std::string Text;
+        int32_t NumLines;
+        int32_t MaxWidth;
+    };
+
+    struct WrappedStringCache
+    {
+        uint32_t Generation = 0;
+        std::unordered_map<WrappedStringKey, WrappedString, WrappedStringKeyHash> Entries;
+    };
+} // namespace
+
+// Wrapping measures the text once per character, so the same labels and descriptions drawn every frame are only wrapped
+// once. Text is also drawn from the viewport worker threads, hence a cache per thread which is cleared when the fonts change.
+static constexpr size_t WRAPPED_STRING_CACHE_SIZE = 1024;
+static std::atomic<uint32_t> _wrappedStringCacheGeneration;
+static thread_local WrappedStringCache _wrappedStringCache;
+
+void gfx_wrap_string_cache_dispose_all()
+{
+    _wrappedStringCacheGeneration++;
+}
+
 /**
  *
  *  rct2: 0x006C23B1
@@ -159,11 +218,12 @@ int32_t gfx_clip_string(utf8* text, int32_t width)
  * num_lines (edi) - out
  * font_height (ebx) - out
  */
-int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t* outFontHeight)
+static int32_t gfx_wrap_string_uncached(utf8* text, int32_t width, int32_t* outNumLines, size_t* outInsertedLength)
 {
     int32_t lineWidth = 0;
     int32_t maxWidth = 0;
     *outNumLines = 0;
+    *outInsertedLength = 0;
 
     // Pointer to the start of the current word
     utf8* currentWord = nullptr;
@@ -215,7 +275,9 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t
         else if (currentWord == nullptr)
         {
             // Single word is longer than line, insert null terminator
-            ch += utf8_insert_codepoint(ch, 0);
+            auto insertedLength = utf8_insert_codepoint(ch, 0);
+            ch += insertedLength;
+            *outInsertedLength += insertedLength;
             maxWidth = std::max(maxWidth, lineWidth);
             (*outNumLines)++;
             lineWidth = 0;
@@ -237,10 +299,43 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t
         }
     }
     maxWidth = std::max(maxWidth, lineWidth);
-    *outFontHeight = gCurrentFontSpriteBase;
     return maxWidth == 0 ? lineWidth : maxWidth;
 }
 
+int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t* outFontHeight)
+{
+    *outFontHeight = gCurrentFontSpriteBase;
+
+    auto& cache = _wrappedStringCache;
+    auto generation = _wrappedStringCacheGeneration.load();
+    if (cache.Generation != generation)
+    {
+        cache.Entries.clear();
+        cache.Generation = generation;
+    }
+
+    WrappedStringKey key{ text, width, gCurrentFontSpriteBase, gCurrentFontFlags, LocalisationService_UseTrueTypeFont() };
+    auto it = cache.Entries.find(key);
+    if (it != cache.Entries.end())
+    {
+        const auto& wrapped = it->second;
+        std::memcpy(text, wrapped.Text.c_str(), wrapped.Text.size() + 1);
+        *outNumLines = wrapped.NumLines;
+        return wrapped.MaxWidth;
+    }
+
+    auto length = key.Text.size();
+    size_t insertedLength;
+    auto maxWidth = gfx_wrap_string_uncached(text, width, outNumLines, &insertedLength);
+
+    if (cache.Entries.size() >= WRAPPED_STRING_CACHE_SIZE)
+    {
+        cache.Entries.clear();
+    }
+    cache.Entries.emplace(std::move(key), WrappedString{ std::string(text, length + insertedLength), *outNumLines, maxWidth });
+    return maxWidth;
+}
+
 /**
  * Draws text that is left aligned and vertically centred.
  */
@@ -14,6 +14,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "../object/Object.h"
+#include "../paint/ImpostorCache.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../util/Util.h"
@@ -578,6 +579,118 @@ void mask_init()
     }
 }
 
+void (*rle_run_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+    = rle_run_scalar;
+
+void rle_run_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 RLE run function");
+        rle_run_fn = rle_run_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 RLE run function");
+        rle_run_fn = rle_run_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar RLE run function");
+        rle_run_fn = rle_run_scalar;
+    }
+}
+
+void palette_expand_scalar(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette)
+{
+    for (; numPixels >= 4; numPixels -= 4)
+    {
+        dst[0] = palette[src[0]];
+        dst[1] = palette[src[1]];
+        dst[2] = palette[src[2]];
+        dst[3] = palette[src[3]];
+        src += 4;
+        dst += 4;
+    }
+    for (; numPixels > 0; numPixels--)
+    {
+        *dst++ = palette[*src++];
+    }
+}
+
+void (*palette_expand_fn)(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette)
+    = palette_expand_scalar;
+
+void palette_expand_init()
+{
+    // SSE4.1 has no gather and its byte shuffles only cover 16 entry tables, so it gains nothing over scalar loads
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 palette expand function");
+        palette_expand_fn = palette_expand_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar palette expand function");
+        palette_expand_fn = palette_expand_scalar;
+    }
+}
+
+void palette_remap_scalar(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap)
+{
+    for (int32_t i = 0; i < numPixels; i++)
+    {
+        dst[i] = paletteMap[dst[i]];
+    }
+}
+
+void (*palette_remap_fn)(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap) = palette_remap_scalar;
+
+void palette_remap_init()
+{
+    // Same as for palette_expand_init, the 256 entry lookups need a gather to be any faster
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 palette remap function");
+        palette_remap_fn = palette_remap_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar palette remap function");
+        palette_remap_fn = palette_remap_scalar;
+    }
+}
+
+void pattern_fill_scalar(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour)
+{
+    for (int32_t i = 0; i < numPixels; i++)
+    {
+        if (pattern & (1 << (i & 15)))
+        {
+            dst[i] = colour;
+        }
+    }
+}
+
+void (*pattern_fill_fn)(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour) = pattern_fill_scalar;
+
+void pattern_fill_init()
+{
+    // The pattern repeats every 16 pixels, which a 128-bit vector already covers
+    if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 pattern fill function");
+        pattern_fill_fn = pattern_fill_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar pattern fill function");
+        pattern_fill_fn = pattern_fill_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, int32_t colour)
 {
     gfx_fill_rect(dpi, { coords, coords }, colour);
@@ -663,6 +776,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    impostor_cache_invalidate_all();
     gfx_set_dirty_blocks({ { 0, 0 }, { context_get_width(), context_get_height() } });
 }
 
@@ -17,6 +17,7 @@
 #include "Text.h"
 
 #include <optional>
+#include <utility>
 #include <vector>
 
 struct ScreenCoordsXY;
@@ -145,6 +146,21 @@ enum
     G1_FLAG_PALETTE = (1 << 3),         // Image data is a sequence of palette entries R8G8B8
     G1_FLAG_HAS_ZOOM_SPRITE = (1 << 4), // Use a different sprite for higher zoom levels
     G1_FLAG_NO_ZOOM_DRAW = (1 << 5),    // Does not get drawn at higher zoom levels (only zoom 0)
+    G1_FLAG_DEFERRED = (1 << 6),        // Offset points to a DeferredImage, the image data is decoded when first used
+};
+
+/**
+ * An image whose data is only decoded when it is first drawn. Elements flagged with G1_FLAG_DEFERRED already
+ * have the size and offsets of the decoded image, so they can be laid out without decoding them.
+ */
+struct DeferredImage
+{
+    virtual ~DeferredImage() = default;
+
+    /**
+     * Returns the decoded image, or nullptr if it could not be decoded. Safe to call from several threads at once.
+     */
+    virtual const rct_g1_element* Decode() abstract;
 };
 
 enum : uint32_t
@@ -179,6 +195,21 @@ constexpr DrawBlendOp BLEND_SRC = 1 << 1;
  */
 constexpr DrawBlendOp BLEND_DST = 2 << 2;
 
+/**
+ * Number of distinct combinations of the blend flags, sprite drawing functions are compiled for each of them.
+ */
+constexpr size_t SPRITE_BLEND_OP_COUNT = 8;
+
+constexpr size_t GetSpriteBlendIndex(DrawBlendOp op)
+{
+    return ((op & BLEND_TRANSPARENT) ? 1 : 0) | ((op & BLEND_SRC) ? 2 : 0) | ((op & BLEND_DST) ? 4 : 0);
+}
+
+constexpr DrawBlendOp GetSpriteBlendOp(size_t index)
+{
+    return ((index & 1) ? BLEND_TRANSPARENT : 0) | ((index & 2) ? BLEND_SRC : 0) | ((index & 4) ? BLEND_DST : 0);
+}
+
 enum
 {
     INSET_RECT_FLAG_FILL_GREY = (1 << 2),         // 0x04
@@ -525,6 +556,17 @@ public:
 
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
+
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+
+    uint32_t GetDataLength() const
+    {
+        return _dataLength;
+    }
+
     uint8_t Blend(uint8_t src, uint8_t dst) const;
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
@@ -557,6 +599,15 @@ struct DrawSpriteArgs
     }
 };
 
+/**
+ * Draws an already clipped sprite, each function is compiled for a single zoom level and blend op.
+ */
+using DrawSpriteFn = void(FASTCALL*)(DrawSpriteArgs& args);
+
+// Range of zoom levels sprite drawing functions are compiled for
+constexpr int8_t SPRITE_DRAW_ZOOM_MIN = -2;
+constexpr int8_t SPRITE_DRAW_ZOOM_MAX = 3;
+
 template<DrawBlendOp TBlendOp> bool FASTCALL BlitPixel(const uint8_t* src, uint8_t* dst, const PaletteMap& paletteMap)
 {
     if constexpr (TBlendOp & BLEND_TRANSPARENT)
@@ -708,6 +759,8 @@ void gfx_unload_g2();
 void gfx_unload_csg();
 const rct_g1_element* gfx_get_g1_element(ImageId imageId);
 const rct_g1_element* gfx_get_g1_element(int32_t image_id);
+// Like gfx_get_g1_element, but leaves deferred images undecoded. Only the size and offsets of those can be used.
+const rct_g1_element* gfx_peek_g1_element(int32_t image_id);
 void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1);
 bool is_csg_loaded();
 uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count);
@@ -715,9 +768,14 @@ void gfx_object_free_images(uint32_t baseImageId, uint32_t count);
 void gfx_object_check_all_images_freed();
 size_t ImageListGetUsedCount();
 size_t ImageListGetMaximum();
+std::vector<std::pair<uint32_t, uint32_t>> ImageListGetAllocatedRanges();
 void FASTCALL gfx_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_bmp_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_rle_sprite_to_buffer(DrawSpriteArgs& args);
+DrawSpriteFn gfx_get_bmp_sprite_fn(ZoomLevel zoomLevel, DrawBlendOp blendOp);
+DrawSpriteFn gfx_get_rle_sprite_fn(ZoomLevel zoomLevel, DrawBlendOp blendOp);
+DrawBlendOp gfx_get_bmp_sprite_blend_op(ImageId imageId, const rct_g1_element& g1);
+DrawBlendOp gfx_get_rle_sprite_blend_op(ImageId imageId);
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo* dpi, int32_t image_id, const ScreenCoordsXY& coords, uint32_t tertiary_colour);
 void FASTCALL
     gfx_draw_glyph(rct_drawpixelinfo* dpi, int32_t image_id, const ScreenCoordsXY& coords, const PaletteMap& paletteMap);
@@ -757,6 +815,10 @@ void gfx_draw_string_with_y_offsets(
     bool forceSpriteFont);
 
 int32_t gfx_wrap_string(char* buffer, int32_t width, int32_t* num_lines, int32_t* font_height);
+/**
+ * Forgets the strings wrapped so far, they have to be wrapped again after the fonts have changed.
+ */
+void gfx_wrap_string_cache_dispose_all();
 int32_t gfx_get_string_width(const utf8* buffer);
 int32_t gfx_get_string_width_new_lined(char* buffer);
 int32_t string_get_height_raw(char* buffer);
@@ -766,6 +828,7 @@ void ttf_draw_string(rct_drawpixelinfo* dpi, const_utf8string text, int32_t colo
 
 // scrolling text
 void scrolling_text_initialise_bitmaps();
+void scrolling_text_dispose_bitmaps();
 void scrolling_text_invalidate();
 
 class Formatter;
@@ -792,6 +855,54 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Draws a run of an RLE sprite, sampling every (1 << zoom)th of the numPixels source pixels onto consecutive
+ * destination pixels with the same result as BlitPixel<blendOp>.
+ */
+void rle_run_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap);
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap);
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap);
+void rle_run_init();
+
+extern void (*rle_run_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap);
+
+/**
+ * Converts numPixels paletted pixels to the 32 bit colours of the corresponding palette entries.
+ */
+void palette_expand_scalar(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette);
+void palette_expand_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette);
+void palette_expand_init();
+
+extern void (*palette_expand_fn)(
+    const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t numPixels, const uint32_t* palette);
+
+/**
+ * Replaces each of the numPixels pixels with its entry in the palette map, as used by the filtered rectangles.
+ */
+void palette_remap_scalar(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap);
+void palette_remap_avx2(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap);
+void palette_remap_init();
+
+extern void (*palette_remap_fn)(uint8_t* dst, int32_t numPixels, const PaletteMap& paletteMap);
+
+/**
+ * Sets the pixels of a row of numPixels pixels to colour where the pattern has its bit set, bit n of the pattern
+ * covering every 16th pixel starting from pixel n.
+ */
+void pattern_fill_scalar(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour);
+void pattern_fill_sse4_1(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour);
+void pattern_fill_init();
+
+extern void (*pattern_fill_fn)(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
@@ -267,6 +267,7 @@ void font_sprite_initialise_characters()
     }
 
     scrolling_text_initialise_bitmaps();
+    gfx_wrap_string_cache_dispose_all();
 }
 
 int32_t font_sprite_get_codepoint_offset(int32_t codepoint)
@@ -0,0 +1,213 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FrameProfiler.h"
+
+#include "../core/File.h"
+#include "../core/String.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+constexpr size_t NUM_FRAME_PHASES = static_cast<size_t>(FramePhase::Count);
+
+static constexpr const char* FramePhaseNames[] = {
+    "generate", "arrange", "draw", "windows", "end_draw", "frame",
+};
+static_assert(std::size(FramePhaseNames) == NUM_FRAME_PHASES);
+
+// The phase times a thread has recorded for each frame of the history, indexed by frame number.
+struct FrameProfilerThread
+{
+    std::array<std::array<std::atomic<int64_t>, NUM_FRAME_PHASES>, FRAME_PROFILER_HISTORY> Samples{};
+};
+
+static std::atomic<bool> _enabled{ false };
+static bool _overlayVisible = false;
+
+// The threads are never removed so their samples stay available when the thread has exited.
+static std::mutex _threadsMutex;
+static std::vector<std::unique_ptr<FrameProfilerThread>> _threads;
+static thread_local FrameProfilerThread* _currentThread = nullptr;
+
+// Frame that is being recorded, the number of frames that have been completed and the first one since the reset.
+static std::atomic<uint32_t> _currentFrame{ 0 };
+static uint32_t _completedFrames = 0;
+static uint32_t _firstFrame = 0;
+static int64_t _frameStartTime = 0;
+
+static int64_t frame_profiler_now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static FrameProfilerThread& frame_profiler_get_current_thread()
+{
+    if (_currentThread == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        _threads.push_back(std::make_unique<FrameProfilerThread>());
+        _currentThread = _threads.back().get();
+    }
+    return *_currentThread;
+}
+
+void frame_profiler_set_enabled(bool enabled)
+{
+    if (enabled && !_enabled)
+    {
+        frame_profiler_reset();
+    }
+    _enabled = enabled;
+}
+
+bool frame_profiler_is_enabled()
+{
+    return _enabled;
+}
+
+void frame_profiler_set_overlay_visible(bool visible)
+{
+    _overlayVisible = visible;
+}
+
+bool frame_profiler_is_overlay_visible()
+{
+    return _overlayVisible;
+}
+
+void frame_profiler_reset()
+{
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    for (auto& thread : _threads)
+    {
+        for (auto& frame : thread->Samples)
+        {
+            for (auto& phase : frame)
+            {
+                phase = 0;
+            }
+        }
+    }
+    _currentFrame = _completedFrames;
+    _firstFrame = _completedFrames;
+}
+
+void frame_profiler_begin_frame()
+{
+    if (!_enabled)
+        return;
+
+    // The slot of the new frame still holds the samples of the frame it replaces
+    uint32_t frame = _completedFrames;
+    {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        for (auto& thread : _threads)
+        {
+            for (auto& phase : thread->Samples[frame % FRAME_PROFILER_HISTORY])
+            {
+                phase.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    _currentFrame = frame;
+    _frameStartTime = frame_profiler_now();
+}
+
+void frame_profiler_end_frame()
+{
+    if (!_enabled || _frameStartTime == 0)
+        return;
+
+    frame_profiler_record(FramePhase::Frame, frame_profiler_now() - _frameStartTime);
+    _frameStartTime = 0;
+    _completedFrames++;
+}
+
+void frame_profiler_record(FramePhase phase, int64_t nanoseconds)
+{
+    auto& thread = frame_profiler_get_current_thread();
+    auto& sample = thread.Samples[_currentFrame.load(std::memory_order_relaxed) % FRAME_PROFILER_HISTORY];
+    sample[static_cast<size_t>(phase)].fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+std::vector<FrameProfilerSample> frame_profiler_get_samples()
+{
+    std::vector<FrameProfilerSample> samples;
+    uint32_t numFrames = std::min<uint32_t>(_completedFrames - _firstFrame, FRAME_PROFILER_HISTORY);
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    for (uint32_t frame = _completedFrames - numFrames; frame != _completedFrames; frame++)
+    {
+        FrameProfilerSample sample{};
+        sample.Frame = frame;
+        for (const auto& thread : _threads)
+        {
+            const auto& threadSample = thread->Samples[frame % FRAME_PROFILER_HISTORY];
+            for (size_t phase = 0; phase < NUM_FRAME_PHASES; phase++)
+            {
+                sample.Nanoseconds[phase] += threadSample[phase].load(std::memory_order_relaxed);
+            }
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+const char* frame_profiler_get_phase_name(FramePhase phase)
+{
+    return FramePhaseNames[static_cast<size_t>(phase)];
+}
+
+bool frame_profiler_write_csv(const std::string& path)
+{
+    std::string csv = "frame";
+    for (auto name : FramePhaseNames)
+    {
+        csv += String::StdFormat(",%s_ms", name);
+    }
+    csv += "\n";
+
+    for (const auto& sample : frame_profiler_get_samples())
+    {
+        csv += std::to_string(sample.Frame);
+        for (auto nanoseconds : sample.Nanoseconds)
+        {
+            csv += String::StdFormat(",%.3f", nanoseconds / 1e6);
+        }
+        csv += "\n";
+    }
+
+    try
+    {
+        File::WriteAllBytes(path, csv.data(), csv.size());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write %s: %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+FramePhaseTimer::FramePhaseTimer(FramePhase phase)
+    : _phase(phase)
+    , _startTime(_enabled ? frame_profiler_now() : 0)
+{
+}
+
+FramePhaseTimer::~FramePhaseTimer()
+{
+    if (_startTime != 0 && _enabled)
+    {
+        frame_profiler_record(_phase, frame_profiler_now() - _startTime);
+    }
+}
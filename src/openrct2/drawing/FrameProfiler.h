@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * The phases of a frame that are timed by the frame profiler. Windows includes the time of the viewport phases of
+ * the windows it paints. The viewport phases run on several threads when multithreading is enabled, their times are
+ * summed over all threads and can exceed the duration of the frame.
+ */
+enum class FramePhase : uint8_t
+{
+    Generate, // paint_session_generate
+    Arrange,  // paint_session_arrange
+    Draw,     // paint_draw_structs
+    Windows,  // IDrawingEngine::PaintWindows
+    EndDraw,  // IDrawingEngine::EndDraw
+    Frame,    // From frame_profiler_begin_frame to frame_profiler_end_frame
+    Count,
+};
+
+// Number of frames the profiler keeps the samples of
+constexpr size_t FRAME_PROFILER_HISTORY = 256;
+
+struct FrameProfilerSample
+{
+    uint32_t Frame;
+    std::array<int64_t, static_cast<size_t>(FramePhase::Count)> Nanoseconds;
+};
+
+void frame_profiler_set_enabled(bool enabled);
+bool frame_profiler_is_enabled();
+void frame_profiler_set_overlay_visible(bool visible);
+bool frame_profiler_is_overlay_visible();
+void frame_profiler_reset();
+
+// Only called by the thread that runs the game loop.
+void frame_profiler_begin_frame();
+void frame_profiler_end_frame();
+
+void frame_profiler_record(FramePhase phase, int64_t nanoseconds);
+
+/**
+ * Returns the samples of the last completed frames, oldest first.
+ */
+std::vector<FrameProfilerSample> frame_profiler_get_samples();
+const char* frame_profiler_get_phase_name(FramePhase phase);
+bool frame_profiler_write_csv(const std::string& path);
+
+/**
+ * Adds the time between its construction and destruction to a phase of the current frame.
+ */
+class FramePhaseTimer
+{
+private:
+    FramePhase _phase;
+    int64_t _startTime;
+
+public:
+    explicit FramePhaseTimer(FramePhase phase);
+    ~FramePhaseTimer();
+
+    FramePhaseTimer(const FramePhaseTimer&) = delete;
+    FramePhaseTimer& operator=(const FramePhaseTimer&) = delete;
+};
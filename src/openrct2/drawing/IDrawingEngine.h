@@ -31,6 +31,16 @@ enum DRAWING_ENGINE_FLAGS
      * Whether or not the engine will only draw changed blocks of the screen each frame.
      */
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
+
+    /**
+     * Whether or not the engine's drawing context can be used from several threads at once.
+     */
+    DEF_PARALLEL_DRAWING = 1 << 1,
+
+    /**
+     * Whether or not the engine draws into the bits of its drawing pixel info, so they can be written to directly.
+     */
+    DEF_PIXEL_BUFFER = 1 << 2,
 };
 
 struct rct_drawpixelinfo;
@@ -45,6 +55,12 @@ namespace OpenRCT2::Drawing
 {
     struct IDrawingContext;
 
+    struct DrawingEngineStatistics
+    {
+        uint32_t DrawCalls;
+        size_t BytesUploaded;
+    };
+
     struct IDrawingEngine
     {
         virtual ~IDrawingEngine()
@@ -72,6 +88,15 @@ namespace OpenRCT2::Drawing
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32_t image) abstract;
+
+        /**
+         * Returns the number of draw calls issued and bytes uploaded to the GPU for the previous frame, if the engine
+         * keeps track of them.
+         */
+        virtual DrawingEngineStatistics GetLastFrameStatistics()
+        {
+            return {};
+        }
     };
 
     struct IDrawingEngineFactory
@@ -201,11 +201,12 @@ uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count
         return INVALID_IMAGE_ID;
     }
 
+    // The drawing engine is told first so it can stop any of its background work that reads the images
     uint32_t imageId = baseImageId;
     for (uint32_t i = 0; i < count; i++)
     {
-        gfx_set_g1_element(imageId, &images[i]);
         drawing_engine_invalidate_image(imageId);
+        gfx_set_g1_element(imageId, &images[i]);
         imageId++;
     }
 
@@ -222,8 +223,8 @@ void gfx_object_free_images(uint32_t baseImageId, uint32_t count)
         {
             uint32_t imageId = baseImageId + i;
             rct_g1_element g1 = {};
-            gfx_set_g1_element(imageId, &g1);
             drawing_engine_invalidate_image(imageId);
+            gfx_set_g1_element(imageId, &g1);
         }
 
         FreeImageList(baseImageId, count);
@@ -251,3 +252,16 @@ size_t ImageListGetMaximum()
 {
     return MAX_IMAGES;
 }
+
+/**
+ * Returns the base image ID and the number of images of every allocated image list.
+ */
+std::vector<std::pair<uint32_t, uint32_t>> ImageListGetAllocatedRanges()
+{
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (const auto& imageList : _allocatedLists)
+    {
+        ranges.emplace_back(imageList.BaseId, imageList.Count);
+    }
+    return ranges;
+}
@@ -11,7 +11,9 @@
 
 #include "../core/Imaging.h"
 
+#include <array>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -69,6 +71,7 @@ std::vector<int32_t> ImageImporter::GetPixels(
     }
 
     auto rgbaSrc = rgbaSrcBuffer.get();
+    ClosestIndexCache closestIndices;
     if (!(flags & IMPORT_FLAGS::KEEP_PALETTE))
     {
         for (uint32_t x = 0; x < height * width * 4; x++)
@@ -93,7 +96,7 @@ std::vector<int32_t> ImageImporter::GetPixels(
             }
             else
             {
-                paletteIndex = CalculatePaletteIndex(mode, rgbaSrc, x, y, width, height);
+                paletteIndex = CalculatePaletteIndex(mode, rgbaSrc, x, y, width, height, closestIndices);
             }
 
             rgbaSrc += 4;
@@ -213,20 +216,21 @@ std::vector<uint8_t> ImageImporter::EncodeRLE(const int32_t* pixels, uint32_t wi
 }
 
 int32_t ImageImporter::CalculatePaletteIndex(
-    IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
+    IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height,
+    ClosestIndexCache& closestIndices)
 {
     auto& palette = StandardPalette;
-    auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
+    auto paletteIndex = GetPaletteIndex(rgbaSrc);
     if (mode == IMPORT_MODE::CLOSEST || mode == IMPORT_MODE::DITHERING)
     {
         if (paletteIndex == PALETTE_TRANSPARENT && !IsTransparentPixel(rgbaSrc))
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc, closestIndices);
         }
     }
     if (mode == IMPORT_MODE::DITHERING)
     {
-        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc)))
+        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(rgbaSrc)))
         {
             auto dr = rgbaSrc[0] - static_cast<int16_t>(palette[paletteIndex].Red);
             auto dg = rgbaSrc[1] - static_cast<int16_t>(palette[paletteIndex].Green);
@@ -234,7 +238,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
 
             if (x + 1 < width)
             {
-                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4)))
+                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4)))
                 {
                     // Right
                     rgbaSrc[4] += dr * 7 / 16;
@@ -248,7 +252,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x > 0)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width - 1))))
                     {
                         // Bottom left
                         rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -258,7 +262,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 }
 
                 // Bottom
-                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * width)))
+                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * width)))
                 {
                     rgbaSrc[4 * width] += dr * 5 / 16;
                     rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -268,7 +272,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x + 1 < width)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width + 1))))
                     {
                         // Bottom right
                         rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -282,16 +286,36 @@ int32_t ImageImporter::CalculatePaletteIndex(
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+static uint32_t PackColour(int32_t red, int32_t green, int32_t blue)
 {
+    return (static_cast<uint32_t>(red) << 16) | (static_cast<uint32_t>(green) << 8) | static_cast<uint32_t>(blue);
+}
+
+/**
+ * Returns the index of the colour in the standard palette, or the transparent index if it is not in there.
+ */
+int32_t ImageImporter::GetPaletteIndex(const int16_t* colour)
+{
+    // The first index of every colour, most colours of the palette are in there more than once
+    static const auto paletteIndices = [] {
+        std::unordered_map<uint32_t, int32_t> indices;
+        for (int32_t i = 0; i < PALETTE_SIZE; i++)
+        {
+            const auto& entry = StandardPalette[i];
+            indices.emplace(PackColour(entry.Red, entry.Green, entry.Blue), i);
+        }
+        return indices;
+    }();
+
     if (!IsTransparentPixel(colour))
     {
-        for (int32_t i = 0; i < PALETTE_SIZE; i++)
+        // Dithering can move colours outside of the range of the palette
+        if (colour[0] >= 0 && colour[0] <= 255 && colour[1] >= 0 && colour[1] <= 255 && colour[2] >= 0 && colour[2] <= 255)
         {
-            if (static_cast<int16_t>(palette[i].Red) == colour[0] && static_cast<int16_t>(palette[i].Green) == colour[1]
-                && static_cast<int16_t>(palette[i].Blue) == colour[2])
+            auto it = paletteIndices.find(PackColour(colour[0], colour[1], colour[2]));
+            if (it != paletteIndices.end())
             {
-                return i;
+                return it->second;
             }
         }
     }
@@ -323,25 +347,67 @@ bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
     return true;
 }
 
-int32_t ImageImporter::GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour)
+/**
+ * Returns the first of the changable palette indices with the smallest squared distance to the colour.
+ */
+int32_t ImageImporter::GetClosestPaletteIndex(const int16_t* colour, ClosestIndexCache& closestIndices)
 {
-    auto smallestError = static_cast<uint32_t>(-1);
-    auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < PALETTE_SIZE; x++)
+    // The changable colours of the palette as separate components, so the distances can be calculated for all of them
+    // in a loop that can be vectorised
+    struct Candidates
     {
-        if (IsChangablePixel(x))
+        std::array<int32_t, PALETTE_SIZE> Red{};
+        std::array<int32_t, PALETTE_SIZE> Green{};
+        std::array<int32_t, PALETTE_SIZE> Blue{};
+        std::array<int32_t, PALETTE_SIZE> Index{};
+        size_t Count{};
+    };
+    static const auto candidates = [] {
+        Candidates result;
+        for (int32_t i = 0; i < PALETTE_SIZE; i++)
         {
-            uint32_t error = (static_cast<int16_t>(palette[x].Red) - colour[0])
-                    * (static_cast<int16_t>(palette[x].Red) - colour[0])
-                + (static_cast<int16_t>(palette[x].Green) - colour[1]) * (static_cast<int16_t>(palette[x].Green) - colour[1])
-                + (static_cast<int16_t>(palette[x].Blue) - colour[2]) * (static_cast<int16_t>(palette[x].Blue) - colour[2]);
-
-            if (smallestError == static_cast<uint32_t>(-1) || smallestError > error)
+            if (IsChangablePixel(i))
             {
-                bestMatch = x;
-                smallestError = error;
+                result.Red[result.Count] = StandardPalette[i].Red;
+                result.Green[result.Count] = StandardPalette[i].Green;
+                result.Blue[result.Count] = StandardPalette[i].Blue;
+                result.Index[result.Count] = i;
+                result.Count++;
             }
         }
+        return result;
+    }();
+
+    const uint64_t key = (static_cast<uint64_t>(static_cast<uint16_t>(colour[0])) << 32)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(colour[1])) << 16) | static_cast<uint16_t>(colour[2]);
+    auto it = closestIndices.find(key);
+    if (it != closestIndices.end())
+    {
+        return it->second;
+    }
+
+    std::array<uint32_t, PALETTE_SIZE> errors;
+    const int32_t red = colour[0];
+    const int32_t green = colour[1];
+    const int32_t blue = colour[2];
+    for (size_t i = 0; i < candidates.Count; i++)
+    {
+        const int32_t dr = candidates.Red[i] - red;
+        const int32_t dg = candidates.Green[i] - green;
+        const int32_t db = candidates.Blue[i] - blue;
+        errors[i] = static_cast<uint32_t>(dr * dr + dg * dg + db * db);
+    }
+
+    auto bestMatch = PALETTE_TRANSPARENT;
+    auto smallestError = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < candidates.Count; i++)
+    {
+        if (bestMatch == PALETTE_TRANSPARENT || errors[i] < smallestError)
+        {
+            bestMatch = candidates.Index[i];
+            smallestError = errors[i];
+        }
     }
+    closestIndices.emplace(key, bestMatch);
     return bestMatch;
 }
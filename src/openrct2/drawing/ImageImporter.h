@@ -14,6 +14,7 @@
 
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 
 struct Image;
 
@@ -50,17 +51,21 @@ namespace OpenRCT2::Drawing
             IMPORT_MODE mode = IMPORT_MODE::DEFAULT) const;
 
     private:
+        // The closest palette index of each colour found so far, by its packed components
+        using ClosestIndexCache = std::unordered_map<uint64_t, int32_t>;
+
         static std::vector<int32_t> GetPixels(
             const uint8_t* pixels, uint32_t width, uint32_t height, IMPORT_FLAGS flags, IMPORT_MODE mode);
         static std::vector<uint8_t> EncodeRaw(const int32_t* pixels, uint32_t width, uint32_t height);
         static std::vector<uint8_t> EncodeRLE(const int32_t* pixels, uint32_t width, uint32_t height);
 
         static int32_t CalculatePaletteIndex(
-            IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height);
-        static int32_t GetPaletteIndex(const GamePalette& palette, int16_t* colour);
+            IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height,
+            ClosestIndexCache& closestIndices);
+        static int32_t GetPaletteIndex(const int16_t* colour);
         static bool IsTransparentPixel(const int16_t* colour);
         static bool IsChangablePixel(int32_t paletteIndex);
-        static int32_t GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour);
+        static int32_t GetClosestPaletteIndex(const int16_t* colour, ClosestIndexCache& closestIndices);
     };
 } // namespace OpenRCT2::Drawing
 
@@ -14,6 +14,7 @@
 #    include "../Game.h"
 #    include "../common.h"
 #    include "../config/Config.h"
+#    include "../core/TaskScheduler.h"
 #    include "../interface/Viewport.h"
 #    include "../interface/Window.h"
 #    include "../interface/Window_internal.h"
@@ -28,6 +29,7 @@
 #    include <algorithm>
 #    include <cmath>
 #    include <cstring>
+#    include <vector>
 
 static uint8_t _bakedLightTexture_lantern_0[32 * 32];
 static uint8_t _bakedLightTexture_lantern_1[64 * 64];
@@ -58,6 +60,22 @@ struct lightlist_entry
     uint8_t pad[1];
 };
 
+// A light clipped to the light buffer, ready to be blended into it
+struct lightfx_draw_entry
+{
+    const uint8_t* source;
+    uint32_t sourcePitch;
+    int32_t x, y;
+    int32_t width, height;
+    uint8_t intensity;
+};
+
+// The light buffer is cleared and lit in bands of rows, which can be rendered in parallel as each light is clipped to
+// the band and the saturating blend gives the same result in any order
+static constexpr int32_t LIGHTFX_BAND_HEIGHT = 32;
+
+static std::vector<lightfx_draw_entry> _lightDrawList;
+
 static lightlist_entry _LightListA[16000];
 static lightlist_entry _LightListB[16000];
 
@@ -103,18 +121,50 @@ static uint8_t calc_light_intensity_spot(int32_t x, int32_t y)
 
 static void calc_rescale_light_half(uint8_t* target, uint8_t* source, uint32_t targetWidth, uint32_t targetHeight)
 {
-    uint8_t* parcerRead = source;
-    uint8_t* parcerWrite = target;
-
     for (uint32_t y = 0; y < targetHeight; y++)
     {
+        const uint8_t* sourceRow = source + y * 2 * (targetWidth * 2);
+        uint8_t* targetRow = target + y * targetWidth;
         for (uint32_t x = 0; x < targetWidth; x++)
         {
-            *parcerWrite = (*parcerRead);
-            parcerWrite++;
-            parcerRead += 2;
+            targetRow[x] = sourceRow[x * 2];
+        }
+    }
+}
+
+/**
+ * Runs fn for every index in [0, count), spreading the calls over the task scheduler when multithreading is enabled.
+ */
+template<typename TFunc> static void lightfx_for_each(size_t count, TFunc&& fn)
+{
+    if (gConfigGeneral.multithreading)
+    {
+        TaskScheduler::GetGlobal().ParallelFor(0, count, 1, fn);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            fn(i);
         }
-        parcerRead += targetWidth * 2;
+    }
+}
+
+// The blend loops have no dependencies between pixels so the compiler can turn them into saturating vector adds
+static void lightfx_blend_row(uint8_t* dst, const uint8_t* src, int32_t width)
+{
+    for (int32_t x = 0; x < width; x++)
+    {
+        dst[x] = static_cast<uint8_t>(std::min<uint32_t>(0xFF, dst[x] + src[x]));
+    }
+}
+
+static void lightfx_blend_row_scaled(uint8_t* dst, const uint8_t* src, int32_t width, uint8_t intensity)
+{
+    uint32_t scale = 1 + intensity;
+    for (int32_t x = 0; x < width; x++)
+    {
+        dst[x] = static_cast<uint8_t>(std::min<uint32_t>(0xFF, dst[x] + ((src[x] * scale) >> 8)));
     }
 }
 
@@ -449,20 +499,17 @@ void lightfx_render_lights_to_frontbuffer()
         return;
     }
 
-    std::memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
-
     _lightPolution_back = 0;
+    _lightDrawList.clear();
 
     //  log_warning("%i lights", LightListCurrentCountFront);
 
     for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
     {
         const uint8_t* bufReadBase = nullptr;
-        uint8_t* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
         uint32_t bufReadWidth, bufReadHeight;
         int32_t bufWriteX, bufWriteY;
         int32_t bufWriteWidth, bufWriteHeight;
-        uint32_t bufReadSkip, bufWriteSkip;
 
         lightlist_entry* entry = &_LightListFront[light];
 
@@ -533,10 +580,7 @@ void lightfx_render_lights_to_frontbuffer()
         {
             bufReadBase += -bufWriteX;
             bufWriteWidth += bufWriteX;
-        }
-        else
-        {
-            bufWriteBase += bufWriteX;
+            bufWriteX = 0;
         }
 
         if (bufWriteWidth <= 0)
@@ -546,10 +590,7 @@ void lightfx_render_lights_to_frontbuffer()
         {
             bufReadBase += -bufWriteY * bufReadWidth;
             bufWriteHeight += bufWriteY;
-        }
-        else
-        {
-            bufWriteBase += bufWriteY * _pixelInfo.width;
+            bufWriteY = 0;
         }
 
         if (bufWriteHeight <= 0)
@@ -574,40 +615,36 @@ void lightfx_render_lights_to_frontbuffer()
 
         _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
-        bufReadSkip = bufReadWidth - bufWriteWidth;
-        bufWriteSkip = _pixelInfo.width - bufWriteWidth;
+        _lightDrawList.push_back(
+            { bufReadBase, bufReadWidth, bufWriteX, bufWriteY, bufWriteWidth, bufWriteHeight, entry->lightIntensity });
+    }
+
+    auto* buffer = static_cast<uint8_t*>(_light_rendered_buffer_front);
+    int32_t numBands = (_pixelInfo.height + LIGHTFX_BAND_HEIGHT - 1) / LIGHTFX_BAND_HEIGHT;
+    lightfx_for_each(numBands, [buffer](size_t band) {
+        int32_t bandTop = static_cast<int32_t>(band) * LIGHTFX_BAND_HEIGHT;
+        int32_t bandBottom = std::min<int32_t>(bandTop + LIGHTFX_BAND_HEIGHT, _pixelInfo.height);
+        std::memset(buffer + bandTop * _pixelInfo.width, 0, (bandBottom - bandTop) * _pixelInfo.width);
 
-        if (entry->lightIntensity == 0xFF)
+        for (const auto& draw : _lightDrawList)
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
+            int32_t top = std::max(draw.y, bandTop);
+            int32_t bottom = std::min(draw.y + draw.height, bandBottom);
+            for (int32_t y = top; y < bottom; y++)
             {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
+                uint8_t* dst = buffer + y * _pixelInfo.width + draw.x;
+                const uint8_t* src = draw.source + (y - draw.y) * draw.sourcePitch;
+                if (draw.intensity == 0xFF)
                 {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
+                    lightfx_blend_row(dst, src, draw.width);
                 }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
-        else
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
+                else
                 {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
+                    lightfx_blend_row_scaled(dst, src, draw.width, draw.intensity);
                 }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
             }
         }
-    }
+    });
 }
 
 void* lightfx_get_front_buffer()
@@ -995,32 +1032,32 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32_t y = 0; y < height; y++)
-    {
+    lightfx_for_each(height, [=](size_t row) {
+        auto y = static_cast<uint32_t>(row);
         uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
         uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
+        const uint8_t* srcRow = &bits[y * width];
+        const uint8_t* lightRow = &lightBits[y * width];
+
+        // Expand the whole row to the dark colours, then mix in the light where there is any
+        palette_expand_fn(srcRow, dst, static_cast<int32_t>(width), palette);
         for (uint32_t x = 0; x < width; x++)
         {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
-            {
-                colour = darkColour;
-            }
-            else
+            uint8_t lightIntensity = lightRow[x];
+            if (lightIntensity != 0)
             {
+                uint32_t darkColour = dst[x];
+                uint32_t lightColour = lightPalette[srcRow[x]];
+
+                uint32_t colour = 0;
                 colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
                 colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
                 colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
                 colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+                dst[x] = colour;
             }
-            *dst++ = colour;
         }
-    }
+    });
 }
 
 #endif // __ENABLE_LIGHTFX__
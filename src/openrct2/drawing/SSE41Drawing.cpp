@@ -56,6 +56,95 @@ void mask_sse4_1(
     }
 }
 
+template<int32_t TZoom> static __m128i LoadRLERunPixels(const uint8_t* src)
+{
+    // Picks every (1 << TZoom)th of the next (16 << TZoom) source pixels
+    if constexpr (TZoom == 0)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+    else if constexpr (TZoom == 1)
+    {
+        const __m128i mask = _mm_set1_epi16(0xFF);
+        const __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), mask);
+        const __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), mask);
+        return _mm_packus_epi16(a, b);
+    }
+    else
+    {
+        static_assert(TZoom == 2);
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        const __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), mask);
+        const __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), mask);
+        const __m128i c = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)), mask);
+        const __m128i d = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48)), mask);
+        // _mm_packus_epi32 is SSE4.1
+        return _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d));
+    }
+}
+
+template<int32_t TZoom>
+static void rle_run_transparent_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, const PaletteMap& paletteMap)
+{
+    constexpr int32_t sourceStep = 16 << TZoom;
+    const __m128i zero128 = {};
+    while (numPixels >= sourceStep)
+    {
+        const __m128i pixels = LoadRLERunPixels<TZoom>(src);
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+        const __m128i transparent = _mm_cmpeq_epi8(pixels, zero128);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(pixels, dest, transparent));
+
+        src += sourceStep;
+        dst += 16;
+        numPixels -= sourceStep;
+    }
+    rle_run_scalar(src, dst, numPixels, TZoom, BLEND_TRANSPARENT, paletteMap);
+}
+
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+{
+    // Without a gather instruction the palette lookups are no faster than the scalar loop
+    if (blendOp == BLEND_TRANSPARENT)
+    {
+        switch (zoom)
+        {
+            case 0:
+                rle_run_transparent_sse4_1<0>(src, dst, numPixels, paletteMap);
+                return;
+            case 1:
+                rle_run_transparent_sse4_1<1>(src, dst, numPixels, paletteMap);
+                return;
+            case 2:
+                rle_run_transparent_sse4_1<2>(src, dst, numPixels, paletteMap);
+                return;
+        }
+    }
+    rle_run_scalar(src, dst, numPixels, zoom, blendOp, paletteMap);
+}
+
+void pattern_fill_sse4_1(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour)
+{
+    // Spread the pattern to one byte per pixel, the first eight pixels come from its low byte
+    const __m128i bytes = _mm_shuffle_epi8(
+        _mm_set1_epi16(static_cast<int16_t>(pattern)), _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+    const __m128i bits = _mm_set1_epi64x(static_cast<int64_t>(0x8040201008040201ULL));
+    const __m128i mask = _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+    const __m128i colours = _mm_set1_epi8(static_cast<char>(colour));
+
+    int32_t i = 0;
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(dest, colours, mask));
+    }
+    // The pattern lines up with the start of the row again every 16 pixels
+    pattern_fill_scalar(dst + i, numPixels - i, pattern, colour);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +158,16 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t numPixels, int32_t zoom, DrawBlendOp blendOp,
+    const PaletteMap& paletteMap)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void pattern_fill_sse4_1(uint8_t* dst, int32_t numPixels, uint16_t pattern, uint8_t colour)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
@@ -12,27 +12,70 @@
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Paint.h"
+#include "../paint/TilePaintCache.h"
 #include "../sprites.h"
 #include "Drawing.h"
 #include "TTF.h"
 
 #include <algorithm>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
-struct rct_draw_scroll_text
+struct rct_draw_scroll_text_key
 {
     rct_string_id string_id;
     uint8_t string_args[32];
     colour_t colour;
     uint16_t position;
     uint16_t mode;
+
+    bool operator==(const rct_draw_scroll_text_key& other) const
+    {
+        return string_id == other.string_id && colour == other.colour && position == other.position && mode == other.mode
+            && std::memcmp(string_args, other.string_args, sizeof(string_args)) == 0;
+    }
+};
+
+struct rct_draw_scroll_text_key_hash
+{
+    size_t operator()(const rct_draw_scroll_text_key& key) const
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](uint32_t value) {
+            hash ^= value;
+            hash *= 16777619u;
+        };
+        mix(key.string_id);
+        for (auto arg : key.string_args)
+        {
+            mix(arg);
+        }
+        mix(key.colour);
+        mix(key.position);
+        mix(key.mode);
+        return hash;
+    }
+};
+
+struct rct_draw_scroll_text
+{
+    rct_draw_scroll_text_key key;
     uint32_t id;
+    uint32_t image_id;
     uint8_t bitmap[64 * 40];
 };
 
-constexpr int32_t MAX_SCROLLING_TEXT_ENTRIES = 32;
+// The first entries use the scrolling text images of g1, the others use images allocated when the bitmaps are initialised
+// so that parks with many visible signs and banners do not have to render their text again every frame.
+constexpr int32_t MAX_SCROLLING_TEXT_G1_ENTRIES = SPR_SCROLLING_TEXT_END - SPR_SCROLLING_TEXT_START;
+constexpr int32_t MAX_SCROLLING_TEXT_ENTRIES = 512;
 
 static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
+static int32_t _numScrollTextEntries = MAX_SCROLLING_TEXT_G1_ENTRIES;
+static uint32_t _scrollTextImageListBase = 0;
+static std::unordered_map<rct_draw_scroll_text_key, int32_t, rct_draw_scroll_text_key_hash> _drawScrollTextIndex;
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
 static uint32_t _drawSCrollNextIndex = 0;
 static std::mutex _scrollingTextMutex;
@@ -93,9 +136,11 @@ void scrolling_text_initialise_bitmaps()
         }
     }
 
-    for (int32_t i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+    rct_g1_element g1template = {};
+    for (int32_t i = 0; i < MAX_SCROLLING_TEXT_G1_ENTRIES; i++)
     {
         int32_t imageId = SPR_SCROLLING_TEXT_START + i;
+        _drawScrollTextList[i].image_id = imageId;
         const rct_g1_element* g1original = gfx_get_g1_element(imageId);
         if (g1original != nullptr)
         {
@@ -110,8 +155,47 @@ void scrolling_text_initialise_bitmaps()
             g1.offset[16] = 0;
             g1.offset[17] = 0;
             gfx_set_g1_element(imageId, &g1);
+            g1template = g1;
         }
     }
+
+    if (_scrollTextImageListBase == 0 && g1template.offset != nullptr)
+    {
+        std::vector<rct_g1_element> images;
+        for (int32_t i = MAX_SCROLLING_TEXT_G1_ENTRIES; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+        {
+            auto& g1 = images.emplace_back(g1template);
+            g1.offset = _drawScrollTextList[i].bitmap;
+            std::copy_n(g1template.offset, sizeof(_drawScrollTextList[i].bitmap), g1.offset);
+        }
+
+        auto baseImageId = gfx_object_allocate_images(images.data(), static_cast<uint32_t>(images.size()));
+        if (baseImageId != UINT32_MAX)
+        {
+            _scrollTextImageListBase = baseImageId;
+            for (int32_t i = MAX_SCROLLING_TEXT_G1_ENTRIES; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+            {
+                _drawScrollTextList[i].image_id = baseImageId + (i - MAX_SCROLLING_TEXT_G1_ENTRIES);
+            }
+            _numScrollTextEntries = MAX_SCROLLING_TEXT_ENTRIES;
+        }
+    }
+}
+
+void scrolling_text_dispose_bitmaps()
+{
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+    if (_scrollTextImageListBase != 0)
+    {
+        gfx_object_free_images(_scrollTextImageListBase, MAX_SCROLLING_TEXT_ENTRIES - MAX_SCROLLING_TEXT_G1_ENTRIES);
+        _scrollTextImageListBase = 0;
+    }
+    _numScrollTextEntries = MAX_SCROLLING_TEXT_G1_ENTRIES;
+    for (auto& scrollText : _drawScrollTextList)
+    {
+        scrollText.key = {};
+    }
+    _drawScrollTextIndex.clear();
 }
 
 static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
@@ -127,28 +211,17 @@ static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
     }
 }
 
-static int32_t scrolling_text_get_matching_or_oldest(
-    rct_string_id stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+static int32_t scrolling_text_get_oldest()
 {
     uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
-    for (int32_t i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+    int32_t scrollIndex = 0;
+    for (int32_t i = 0; i < _numScrollTextEntries; i++)
     {
-        rct_draw_scroll_text* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
+        if (oldestId >= _drawScrollTextList[i].id)
         {
-            oldestId = scrollText->id;
+            oldestId = _drawScrollTextList[i].id;
             scrollIndex = i;
         }
-
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
-        {
-            scrollText->id = _drawSCrollNextIndex;
-            return i + SPR_SCROLLING_TEXT_START;
-        }
     }
     return scrollIndex;
 }
@@ -157,11 +230,11 @@ static void scrolling_text_format(utf8* dst, size_t size, rct_draw_scroll_text*
 {
     if (gConfigGeneral.upper_case_banners)
     {
-        format_string_to_upper(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string_to_upper(dst, size, scrollText->key.string_id, scrollText->key.string_args);
     }
     else
     {
-        format_string(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string(dst, size, scrollText->key.string_id, scrollText->key.string_args);
     }
 }
 
@@ -1433,12 +1506,12 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void scrolling_text_invalidate()
 {
-    for (int32_t i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+    for (auto& scrollText : _drawScrollTextList)
     {
-        rct_draw_scroll_text& scrollText = _drawScrollTextList[i];
-        scrollText.string_id = 0;
-        std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
+        scrollText.key = {};
     }
+    _drawScrollTextIndex.clear();
 }
 
 int32_t scrolling_text_setup(
@@ -1446,6 +1519,12 @@ int32_t scrolling_text_setup(
 {
     std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
 
+    // The scrolling text changes every frame, so it can't be part of a cached tile.
+    if (session->TileRecorder != nullptr)
+    {
+        tile_paint_cache_record_unsupported(session);
+    }
+
     assert(scrollingMode < MAX_SCROLLING_TEXT_MODES);
 
     rct_drawpixelinfo* dpi = &session->DPI;
@@ -1455,18 +1534,33 @@ int32_t scrolling_text_setup(
 
     _drawSCrollNextIndex++;
     ft.Rewind();
-    int32_t scrollIndex = scrolling_text_get_matching_or_oldest(stringId, ft, scroll, scrollingMode, colour);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START)
-        return scrollIndex;
 
-    // Setup scrolling text
+    rct_draw_scroll_text_key key;
+    key.string_id = stringId;
+    std::memcpy(key.string_args, ft.Buf(), sizeof(key.string_args));
+    key.colour = colour;
+    key.position = scroll;
+    key.mode = scrollingMode;
+
+    auto it = _drawScrollTextIndex.find(key);
+    if (it != _drawScrollTextIndex.end())
+    {
+        auto& scrollText = _drawScrollTextList[it->second];
+        scrollText.id = _drawSCrollNextIndex;
+        return scrollText.image_id;
+    }
+
+    // Setup scrolling text in the least recently used entry
+    int32_t scrollIndex = scrolling_text_get_oldest();
     auto scrollText = &_drawScrollTextList[scrollIndex];
-    scrollText->string_id = stringId;
-    std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
-    scrollText->colour = colour;
-    scrollText->position = scroll;
-    scrollText->mode = scrollingMode;
+    auto previous = _drawScrollTextIndex.find(scrollText->key);
+    if (previous != _drawScrollTextIndex.end() && previous->second == scrollIndex)
+    {
+        _drawScrollTextIndex.erase(previous);
+    }
+    scrollText->key = key;
     scrollText->id = _drawSCrollNextIndex;
+    _drawScrollTextIndex.emplace(key, scrollIndex);
 
     // Create the string to draw
     utf8 scrollString[256];
@@ -1484,7 +1578,7 @@ int32_t scrolling_text_setup(
         scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
     }
 
-    uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
+    uint32_t imageId = scrollText->image_id;
     drawing_engine_invalidate_image(imageId);
     return imageId;
 }
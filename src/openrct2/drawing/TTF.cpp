@@ -10,7 +10,9 @@
 #ifndef NO_TTF
 
 #    include <atomic>
+#    include <cstring>
 #    include <mutex>
+#    include <vector>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -22,12 +24,16 @@
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/platform.h"
+#    include "Drawing.h"
 #    include "TTF.h"
 
 static bool _ttfInitialised = false;
 
+// The caches start at these sizes and double whenever they are three quarters full, up to the maximum sizes
 #    define TTF_SURFACE_CACHE_SIZE 256
+#    define TTF_SURFACE_CACHE_MAX_SIZE 2048
 #    define TTF_GETWIDTH_CACHE_SIZE 1024
+#    define TTF_GETWIDTH_CACHE_MAX_SIZE 16384
 
 struct ttf_cache_entry
 {
@@ -45,12 +51,13 @@ struct ttf_getwidth_cache_entry
     uint32_t lastUseTick;
 };
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
+static std::vector<ttf_cache_entry> _ttfSurfaceCache = std::vector<ttf_cache_entry>(TTF_SURFACE_CACHE_SIZE);
 static int32_t _ttfSurfaceCacheCount = 0;
 static int32_t _ttfSurfaceCacheHitCount = 0;
 static int32_t _ttfSurfaceCacheMissCount = 0;
 
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
+static std::vector<ttf_getwidth_cache_entry> _ttfGetWidthCache = std::vector<ttf_getwidth_cache_entry>(
+    TTF_GETWIDTH_CACHE_SIZE);
 static int32_t _ttfGetWidthCacheCount = 0;
 static int32_t _ttfGetWidthCacheHitCount = 0;
 static int32_t _ttfGetWidthCacheMissCount = 0;
@@ -140,6 +147,7 @@ bool ttf_initialise()
     }
 
     ttf_toggle_hinting(true);
+    gfx_wrap_string_cache_dispose_all();
 
     _ttfInitialised = true;
 
@@ -155,6 +163,7 @@ void ttf_dispose()
 
     ttf_surface_cache_dispose_all();
     ttf_getwidth_cache_dispose_all();
+    gfx_wrap_string_cache_dispose_all();
 
     for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
     {
@@ -197,6 +206,7 @@ static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
     {
         ttf_free_surface(entry->surface);
         free(entry->text);
+        _ttfSurfaceCacheCount--;
 
         entry->surface = nullptr;
         entry->font = nullptr;
@@ -206,10 +216,34 @@ static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
 
 static void ttf_surface_cache_dispose_all()
 {
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    for (auto& entry : _ttfSurfaceCache)
     {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
+        ttf_surface_cache_dispose(&entry);
+    }
+}
+
+/**
+ * Doubles the size of the surface cache and moves the entries to their new slots, the surfaces themselves stay where they
+ * are.
+ */
+static void ttf_surface_cache_grow()
+{
+    std::vector<ttf_cache_entry> oldCache(_ttfSurfaceCache.size() * 2);
+    std::swap(oldCache, _ttfSurfaceCache);
+
+    size_t size = _ttfSurfaceCache.size();
+    for (const auto& entry : oldCache)
+    {
+        if (entry.surface != nullptr)
+        {
+            size_t index = ttf_surface_cache_hash(entry.font, entry.text) % size;
+            while (_ttfSurfaceCache[index].surface != nullptr)
+            {
+                if (++index >= size)
+                    index = 0;
+            }
+            _ttfSurfaceCache[index] = entry;
+        }
     }
 }
 
@@ -224,11 +258,12 @@ TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, const utf8* text)
     ttf_cache_entry* entry;
 
     uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
 
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    size_t size = _ttfSurfaceCache.size();
+    size_t index = hash % size;
+    for (size_t i = 0; i < size; i++)
     {
         entry = &_ttfSurfaceCache[index];
 
@@ -249,11 +284,24 @@ TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, const utf8* text)
         }
 
         // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
+        if (++index >= size)
             index = 0;
     }
 
-    // Cache miss, replace entry with new surface
+    // Cache miss, make room before the probe sequences get long or recently used surfaces have to be thrown away
+    if (_ttfSurfaceCacheCount >= static_cast<int32_t>(size / 4 * 3) && size < TTF_SURFACE_CACHE_MAX_SIZE)
+    {
+        ttf_surface_cache_grow();
+        size = _ttfSurfaceCache.size();
+        index = hash % size;
+        while (_ttfSurfaceCache[index].surface != nullptr)
+        {
+            if (++index >= size)
+                index = 0;
+        }
+    }
+
+    // Replace entry with new surface
     entry = &_ttfSurfaceCache[index];
     ttf_surface_cache_dispose(entry);
 
@@ -279,6 +327,7 @@ static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
     if (entry->text != nullptr)
     {
         free(entry->text);
+        _ttfGetWidthCacheCount--;
 
         entry->width = 0;
         entry->font = nullptr;
@@ -288,10 +337,30 @@ static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
 
 static void ttf_getwidth_cache_dispose_all()
 {
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    for (auto& entry : _ttfGetWidthCache)
     {
-        ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
+        ttf_getwidth_cache_dispose(&entry);
+    }
+}
+
+static void ttf_getwidth_cache_grow()
+{
+    std::vector<ttf_getwidth_cache_entry> oldCache(_ttfGetWidthCache.size() * 2);
+    std::swap(oldCache, _ttfGetWidthCache);
+
+    size_t size = _ttfGetWidthCache.size();
+    for (const auto& entry : oldCache)
+    {
+        if (entry.text != nullptr)
+        {
+            size_t index = ttf_surface_cache_hash(entry.font, entry.text) % size;
+            while (_ttfGetWidthCache[index].text != nullptr)
+            {
+                if (++index >= size)
+                    index = 0;
+            }
+            _ttfGetWidthCache[index] = entry;
+        }
     }
 }
 
@@ -300,11 +369,12 @@ uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, const utf8* text)
     ttf_getwidth_cache_entry* entry;
 
     uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
 
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    size_t size = _ttfGetWidthCache.size();
+    size_t index = hash % size;
+    for (size_t i = 0; i < size; i++)
     {
         entry = &_ttfGetWidthCache[index];
 
@@ -325,11 +395,24 @@ uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, const utf8* text)
         }
 
         // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE)
+        if (++index >= size)
             index = 0;
     }
 
-    // Cache miss, replace entry with new width
+    // Cache miss, grow the cache the same way as the surface cache
+    if (_ttfGetWidthCacheCount >= static_cast<int32_t>(size / 4 * 3) && size < TTF_GETWIDTH_CACHE_MAX_SIZE)
+    {
+        ttf_getwidth_cache_grow();
+        size = _ttfGetWidthCache.size();
+        index = hash % size;
+        while (_ttfGetWidthCache[index].text != nullptr)
+        {
+            if (++index >= size)
+                index = 0;
+        }
+    }
+
+    // Replace entry with new width
     entry = &_ttfGetWidthCache[index];
     ttf_getwidth_cache_dispose(entry);
 
@@ -380,6 +463,30 @@ void ttf_free_surface(TTFSurface* surface)
     free(surface);
 }
 
+size_t ttf_get_memory_usage()
+{
+    FontLockHelper<std::mutex> lock(_mutex);
+
+    size_t size = _ttfSurfaceCache.size() * sizeof(ttf_cache_entry)
+        + _ttfGetWidthCache.size() * sizeof(ttf_getwidth_cache_entry);
+    for (const auto& entry : _ttfSurfaceCache)
+    {
+        if (entry.surface != nullptr)
+        {
+            size += sizeof(TTFSurface) + static_cast<size_t>(entry.surface->pitch) * entry.surface->h;
+            size += std::strlen(entry.text) + 1;
+        }
+    }
+    for (const auto& entry : _ttfGetWidthCache)
+    {
+        if (entry.text != nullptr)
+        {
+            size += std::strlen(entry.text) + 1;
+        }
+    }
+    return size;
+}
+
 #else
 
 #    include "TTF.h"
@@ -393,4 +500,9 @@ void ttf_dispose()
 {
 }
 
+size_t ttf_get_memory_usage()
+{
+    return 0;
+}
+
 #endif // NO_TTF
@@ -13,6 +13,8 @@
 
 bool ttf_initialise();
 void ttf_dispose();
+// The size of the rendered text and text width caches
+size_t ttf_get_memory_usage();
 
 #ifndef NO_TTF
 
@@ -12,10 +12,13 @@
 #include "../Context.h"
 #include "../Game.h"
 #include "../Intro.h"
+#include "../Profiling.h"
 #include "../config/Config.h"
+#include "../core/TaskScheduler.h"
 #include "../interface/Screenshot.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
+#include "../interface/Window_internal.h"
 #include "../ui/UiContext.h"
 #include "../world/Climate.h"
 #include "Drawing.h"
@@ -33,12 +36,7 @@ using namespace OpenRCT2::Ui;
 
 X8WeatherDrawer::X8WeatherDrawer()
 {
-    _weatherPixels = new WeatherPixel[_weatherPixelsCapacity];
-}
-
-X8WeatherDrawer::~X8WeatherDrawer()
-{
-    delete[] _weatherPixels;
+    _weatherColours.reserve(MaxWeatherPixels);
 }
 
 void X8WeatherDrawer::SetDPI(rct_drawpixelinfo* dpi)
@@ -56,39 +54,40 @@ void X8WeatherDrawer::Draw(
     uint8_t patternStartXOffset = xStart % patternXSpace;
     uint8_t patternStartYOffset = yStart % patternYSpace;
 
-    uint32_t pixelOffset = (_screenDPI->pitch + _screenDPI->width) * y + x;
+    uint32_t stride = _screenDPI->pitch + _screenDPI->width;
+    uint32_t pixelOffset = stride * y + x;
     uint8_t patternYPos = patternStartYOffset % patternYSpace;
 
     uint8_t* screenBits = _screenDPI->bits;
-
-    // Stores the colours of changed pixels
-    WeatherPixel* newPixels = &_weatherPixels[_weatherPixelsCount];
     for (; height != 0; height--)
     {
         uint8_t patternX = pattern[patternYPos * 2];
         if (patternX != 0xFF)
         {
-            if (_weatherPixelsCount < (_weatherPixelsCapacity - static_cast<uint32_t>(width)))
+            uint32_t spanOffset = (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+            if (spanOffset < static_cast<uint32_t>(width))
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
-                uint8_t patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
+                uint32_t count = (width - spanOffset + patternXSpace - 1) / patternXSpace;
+                size_t colourIndex = _weatherColours.size();
+                if (colourIndex + count <= MaxWeatherPixels)
                 {
-                    uint8_t current_pixel = screenBits[xPixelOffset];
-                    screenBits[xPixelOffset] = patternPixel;
-                    _weatherPixelsCount++;
-
-                    // Store colour and position
-                    *newPixels++ = { xPixelOffset, current_pixel };
+                    // Save the colours of the span and draw it in one strided pass
+                    _weatherColours.resize(colourIndex + count);
+                    uint8_t* savedColours = &_weatherColours[colourIndex];
+                    uint8_t* dst = screenBits + pixelOffset + spanOffset;
+                    uint8_t patternPixel = pattern[patternYPos * 2 + 1];
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        savedColours[i] = *dst;
+                        *dst = patternPixel;
+                        dst += patternXSpace;
+                    }
+                    _weatherSpans.push_back({ pixelOffset + spanOffset, count, patternXSpace });
                 }
             }
         }
 
-        pixelOffset += _screenDPI->pitch + _screenDPI->width;
+        pixelOffset += stride;
         patternYPos++;
         patternYPos %= patternYSpace;
     }
@@ -96,22 +95,33 @@ void X8WeatherDrawer::Draw(
 
 void X8WeatherDrawer::Restore()
 {
-    if (_weatherPixelsCount > 0)
+    if (!_weatherSpans.empty())
     {
         uint32_t numPixels = (_screenDPI->width + _screenDPI->pitch) * _screenDPI->height;
         uint8_t* bits = _screenDPI->bits;
-        for (uint32_t i = 0; i < _weatherPixelsCount; i++)
+
+        // Restore in reverse so pixels covered by more than one pattern get their original colour back
+        size_t colourIndex = _weatherColours.size();
+        for (auto it = _weatherSpans.rbegin(); it != _weatherSpans.rend(); it++)
         {
-            WeatherPixel weatherPixel = _weatherPixels[i];
-            if (weatherPixel.Position >= numPixels)
+            const auto& span = *it;
+            colourIndex -= span.Count;
+            if (span.Start + (span.Count - 1) * span.Stride >= numPixels)
             {
-                // Pixel out of bounds, bail
-                break;
+                // Span out of bounds, the screen has been resized
+                continue;
             }
 
-            bits[weatherPixel.Position] = weatherPixel.Colour;
+            const uint8_t* savedColours = &_weatherColours[colourIndex];
+            uint8_t* dst = bits + span.Start;
+            for (uint32_t i = 0; i < span.Count; i++)
+            {
+                *dst = savedColours[i];
+                dst += span.Stride;
+            }
         }
-        _weatherPixelsCount = 0;
+        _weatherSpans.clear();
+        _weatherColours.clear();
     }
 }
 
@@ -122,7 +132,6 @@ void X8WeatherDrawer::Restore()
 
 X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiContext>& uiContext)
 {
-    _drawingContext = new X8DrawingContext(this);
     _bitsDPI.DrawingEngine = this;
 #ifdef __ENABLE_LIGHTFX__
     lightfx_set_available(true);
@@ -132,7 +141,6 @@ X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiC
 
 X8DrawingEngine::~X8DrawingEngine()
 {
-    delete _drawingContext;
     delete[] _dirtyGrid.Blocks;
     delete[] _bits;
 }
@@ -276,8 +284,12 @@ std::string X8DrawingEngine::Screenshot()
 
 IDrawingContext* X8DrawingEngine::GetDrawingContext(rct_drawpixelinfo* dpi)
 {
-    _drawingContext->SetDPI(dpi);
-    return _drawingContext;
+    // The context only carries the target DPI, give each thread its own so that
+    // viewport columns can be drawn in parallel.
+    thread_local X8DrawingContext drawingContext(nullptr);
+    drawingContext.SetEngine(this);
+    drawingContext.SetDPI(dpi);
+    return &drawingContext;
 }
 
 rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
@@ -287,7 +299,7 @@ rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
 
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
-    return DEF_DIRTY_OPTIMISATIONS;
+    return static_cast<DRAWING_ENGINE_FLAGS>(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING | DEF_PIXEL_BUFFER);
 }
 
 void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
@@ -405,6 +417,7 @@ void X8DrawingEngine::DrawAllDirtyBlocks()
             DrawDirtyBlocks(x, y, columns, rows);
         }
     }
+    DrawViewportRegions();
 }
 
 uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
@@ -452,9 +465,53 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
 
     // Draw region
     OnDrawDirtyBlock(x, y, columns, rows);
+    if (gConfigGeneral.multithreading)
+    {
+        // Regions only showing the main viewport are left for the workers, anything else is drawn right away
+        auto mainWindow = window_get_main_if_only_window_in(left, top, right, bottom);
+        if (mainWindow != nullptr)
+        {
+            ScreenRect rect(left, top, right, bottom);
+            _viewportRegions.push_back({ mainWindow->viewport, rect, {} });
+            return;
+        }
+    }
     window_draw_all(&_bitsDPI, left, top, right, bottom);
 }
 
+void X8DrawingEngine::DrawViewportRegions()
+{
+    if (_viewportRegions.size() == 1)
+    {
+        auto& rect = _viewportRegions[0].Rect;
+        window_draw_all(&_bitsDPI, rect.GetLeft(), rect.GetTop(), rect.GetRight(), rect.GetBottom());
+    }
+    else if (!_viewportRegions.empty())
+    {
+        // The regions are disjoint and were found after every other region had been drawn, so they can be rendered
+        // in any order. Their text is drawn back on this thread once all of them are done.
+        auto& scheduler = TaskScheduler::GetGlobal();
+        TaskGroup group;
+        for (auto& region : _viewportRegions)
+        {
+            scheduler.Schedule(group, [this, &region]() {
+                PROFILE_ZONE("Render viewport region");
+                auto& rect = region.Rect;
+                auto dpi = _bitsDPI.Crop({ rect.GetLeft(), rect.GetTop() }, { rect.GetWidth(), rect.GetHeight() });
+                viewport_render_deferred(
+                    &dpi, region.Viewport, rect.GetLeft(), rect.GetTop(), rect.GetRight(), rect.GetBottom(), region.Sessions);
+            });
+        }
+        scheduler.Wait(group);
+
+        for (auto& region : _viewportRegions)
+        {
+            viewport_finish_deferred(region.Sessions);
+        }
+    }
+    _viewportRegions.clear();
+}
+
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
 #    pragma GCC diagnostic pop
 #endif
@@ -477,6 +534,13 @@ void X8DrawingContext::Clear(uint8_t paletteIndex)
     int32_t h = dpi->height / dpi->zoom_level;
     uint8_t* ptr = dpi->bits;
 
+    // Without a pitch the rows follow each other, which lets the whole area go in a single fill
+    if (dpi->pitch == 0)
+    {
+        std::fill_n(ptr, static_cast<size_t>(w) * h, paletteIndex);
+        return;
+    }
+
     for (int32_t y = 0; y < h; y++)
     {
         std::fill_n(ptr, w, paletteIndex);
@@ -586,22 +650,11 @@ void X8DrawingContext::FillRect(uint32_t colour, int32_t left, int32_t top, int3
         uint8_t* dst = (startY * (dpi->width + dpi->pitch)) + startX + dpi->bits;
         for (int32_t i = 0; i < height; i++)
         {
-            uint8_t* nextdst = dst + dpi->width + dpi->pitch;
-            uint32_t p = ror32(crossPattern, 1);
-            p = (p & 0xFFFF0000) | width;
-
-            // Fill every other pixel with the colour
-            for (; (p & 0xFFFF) != 0; p--)
-            {
-                p = p ^ 0x80000000;
-                if (p & 0x80000000)
-                {
-                    *dst = colour & 0xFF;
-                }
-                dst++;
-            }
+            // Fill every other pixel with the colour, starting with the first one on rows where the pattern is even
+            const uint16_t rowPattern = (crossPattern & 1) ? 0b1010101010101010 : 0b0101010101010101;
+            pattern_fill_fn(dst, width, rowPattern, colour & 0xFF);
             crossPattern ^= 1;
-            dst = nextdst;
+            dst += dpi->width + dpi->pitch;
         }
     }
     else if (colour & 0x2000000)
@@ -618,33 +671,29 @@ void X8DrawingContext::FillRect(uint32_t colour, int32_t left, int32_t top, int3
 
         // The pattern loops every 15 pixels this is which
         // part the pattern is on.
-        int32_t startPatternX = (startX + dpi->x) % 16;
-        int32_t patternX = startPatternX;
+        int32_t startPatternX = (startX + dpi->x) & 15;
 
         const uint16_t* patternsrc = Patterns[colour >> 28]; // or possibly uint8_t)[esi*4] ?
 
         for (int32_t numLines = height; numLines > 0; numLines--)
         {
-            uint8_t* nextdst = dst + dpi->width + dpi->pitch;
+            // Rotate the pattern so that its first bit belongs to the first pixel of the row
             uint16_t pattern = patternsrc[patternY];
+            pattern = static_cast<uint16_t>((pattern >> startPatternX) | (pattern << ((16 - startPatternX) & 15)));
+            pattern_fill_fn(dst, width, pattern, colour & 0xFF);
 
-            for (int32_t numPixels = width; numPixels > 0; numPixels--)
-            {
-                if (pattern & (1 << patternX))
-                {
-                    *dst = colour & 0xFF;
-                }
-                patternX = (patternX + 1) % 16;
-                dst++;
-            }
-            patternX = startPatternX;
             patternY = (patternY + 1) % 16;
-            dst = nextdst;
+            dst += dpi->width + dpi->pitch;
         }
     }
     else
     {
         uint8_t* dst = startY * (dpi->width + dpi->pitch) + startX + dpi->bits;
+        if (width == dpi->width && dpi->pitch == 0)
+        {
+            std::fill_n(dst, static_cast<size_t>(width) * height, colour & 0xFF);
+            return;
+        }
         for (int32_t i = 0; i < height; i++)
         {
             std::fill_n(dst, width, colour & 0xFF);
@@ -715,12 +764,7 @@ void X8DrawingContext::FilterRect(FILTER_PALETTE_ID palette, int32_t left, int32
         auto c = height / dpi->zoom_level;
         for (int32_t i = 0; i < c; i++)
         {
-            uint8_t* nextdst = dst + step * i;
-            for (int32_t j = 0; j < scaled_width; j++)
-            {
-                auto index = *(nextdst + j);
-                *(nextdst + j) = (*paletteMap)[index];
-            }
+            palette_remap_fn(dst + step * i, scaled_width, *paletteMap);
         }
     }
 }
@@ -756,6 +800,11 @@ void X8DrawingContext::DrawGlyph(uint32_t image, int32_t x, int32_t y, const Pal
     gfx_draw_sprite_palette_set_software(_dpi, ImageId::FromUInt32(image), { x, y }, paletteMap);
 }
 
+void X8DrawingContext::SetEngine(X8DrawingEngine* engine)
+{
+    _engine = engine;
+}
+
 void X8DrawingContext::SetDPI(rct_drawpixelinfo* dpi)
 {
     _dpi = dpi;
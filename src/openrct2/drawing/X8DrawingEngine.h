@@ -10,9 +10,15 @@
 #pragma once
 
 #include "../common.h"
+#include "../world/Location.hpp"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 
+#include <vector>
+
+struct paint_session;
+struct rct_viewport;
+
 namespace OpenRCT2
 {
     namespace Ui
@@ -38,22 +44,22 @@ namespace OpenRCT2
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
-            struct WeatherPixel
+            // A row of evenly spaced weather pixels, their previous colours are stored in order in _weatherColours
+            struct WeatherSpan
             {
-                uint32_t Position;
-                uint8_t Colour;
+                uint32_t Start;
+                uint32_t Count;
+                uint8_t Stride;
             };
 
             static constexpr uint32_t MaxWeatherPixels = 0xFFFE;
 
-            size_t _weatherPixelsCapacity = MaxWeatherPixels;
-            uint32_t _weatherPixelsCount = 0;
-            WeatherPixel* _weatherPixels = nullptr;
+            std::vector<WeatherSpan> _weatherSpans;
+            std::vector<uint8_t> _weatherColours;
             rct_drawpixelinfo* _screenDPI = nullptr;
 
         public:
             X8WeatherDrawer();
-            ~X8WeatherDrawer();
             void SetDPI(rct_drawpixelinfo* dpi);
             void Draw(
                 int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
@@ -83,7 +89,15 @@ namespace OpenRCT2
 #endif
 
             X8WeatherDrawer _weatherDrawer;
-            X8DrawingContext* _drawingContext;
+
+            // A dirty region that only shows the main viewport, which can be rendered on a worker.
+            struct ViewportRegion
+            {
+                const rct_viewport* Viewport;
+                ScreenRect Rect;
+                std::vector<paint_session*> Sessions;
+            };
+            std::vector<ViewportRegion> _viewportRegions;
 
         public:
             explicit X8DrawingEngine(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -127,6 +141,7 @@ namespace OpenRCT2
             void DrawAllDirtyBlocks();
             uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
+            void DrawViewportRegions();
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
 #    pragma GCC diagnostic pop
@@ -152,6 +167,7 @@ namespace OpenRCT2
             void DrawSpriteSolid(uint32_t image, int32_t x, int32_t y, uint8_t colour) override;
             void DrawGlyph(uint32_t image, int32_t x, int32_t y, const PaletteMap& paletteMap) override;
 
+            void SetEngine(X8DrawingEngine* engine);
             void SetDPI(rct_drawpixelinfo* dpi);
         };
     } // namespace Drawing
@@ -12,7 +12,9 @@
 #include "../Context.h"
 #include "../EditorObjectSelectionSession.h"
 #include "../Game.h"
+#include "../HitchTracker.h"
 #include "../OpenRCT2.h"
+#include "../MemoryReport.h"
 #include "../PlatformEnvironment.h"
 #include "../ReplayManager.h"
 #include "../Version.h"
@@ -27,6 +29,8 @@
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../TickProfiler.h"
+#include "../drawing/FrameProfiler.h"
 #include "../interface/Chat.h"
 #include "../interface/Colour.h"
 #include "../interface/Window_internal.h"
@@ -39,13 +43,17 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/GuestPathfinding.h"
 #include "../peep/Staff.h"
 #include "../platform/platform.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideLocationIndex.h"
+#include "../scripting/ScriptEngine.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
+#include "../world/EntityScheduler.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
@@ -295,6 +303,7 @@ static int32_t cc_rides(InteractiveConsole& console, const arguments_t& argv)
                     else
                     {
                         ride->excitement = excitement;
+                        ride_visible_from_anywhere_invalidate();
                     }
                 }
             }
@@ -644,6 +653,10 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("game_speed %d", gGameSpeed);
         }
+        else if (argv[0] == "turbo")
+        {
+            console.WriteFormatLine("turbo %d", gGameTurbo);
+        }
         else if (argv[0] == "console_small_font")
         {
             console.WriteFormatLine("console_small_font %d", gConfigInterface.console_small_font);
@@ -689,6 +702,14 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("cheat_disable_support_limits %d", gCheatsDisableSupportLimits);
         }
+        else if (argv[0] == "cheat_pathfinding_budget")
+        {
+            console.WriteFormatLine("cheat_pathfinding_budget %u", gCheatsPathfindingBudget);
+        }
+        else if (argv[0] == "cheat_ride_ratings_per_tick")
+        {
+            console.WriteFormatLine("cheat_ride_ratings_per_tick %u", gCheatsRideRatingsPerTick);
+        }
         else if (argv[0] == "current_rotation")
         {
             console.WriteFormatLine("current_rotation %d", get_current_rotation());
@@ -897,6 +918,15 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             gGameSpeed = std::clamp(int_val[0], 1, 8);
             console.Execute("get game_speed");
         }
+        else if (argv[0] == "turbo" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gGameTurbo = (int_val[0] != 0);
+            if (gGameTurbo && network_get_mode() != NETWORK_MODE_NONE)
+            {
+                console.WriteLineWarning("Turbo mode has no effect in network games.");
+            }
+            console.Execute("get turbo");
+        }
         else if (argv[0] == "console_small_font" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             gConfigInterface.console_small_font = (int_val[0] != 0);
@@ -996,6 +1026,28 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
                 console.Execute("get cheat_disable_support_limits");
             }
         }
+        else if (argv[0] == "cheat_pathfinding_budget" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            auto setCheatAction = SetCheatAction(CheatType::PathfindingBudget, std::max(int_val[0], 0));
+            setCheatAction.SetCallback([&console](const GameAction*, const GameActions::Result* res) {
+                if (res->Error != GameActions::Status::Ok)
+                    console.WriteLineError("Network error: Permission denied!");
+                else
+                    console.Execute("get cheat_pathfinding_budget");
+            });
+            GameActions::Execute(&setCheatAction);
+        }
+        else if (argv[0] == "cheat_ride_ratings_per_tick" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            auto setCheatAction = SetCheatAction(CheatType::RideRatingsPerTick, std::clamp(int_val[0], 0, MAX_RIDES));
+            setCheatAction.SetCallback([&console](const GameAction*, const GameActions::Result* res) {
+                if (res->Error != GameActions::Status::Ok)
+                    console.WriteLineError("Network error: Permission denied!");
+                else
+                    console.Execute("get cheat_ride_ratings_per_tick");
+            });
+            GameActions::Execute(&setCheatAction);
+        }
         else if (argv[0] == "current_rotation" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             uint8_t currentRotation = get_current_rotation();
@@ -1223,8 +1275,7 @@ static int32_t cc_remove_park_fences(InteractiveConsole& console, [[maybe_unused
 
 static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
-    map_reorganise_elements();
-    int32_t tileElementCount = gNextFreeTileElement - gTileElements - 1;
+    int32_t tileElementCount = map_get_tile_element_count();
 
     int32_t rideCount = ride_get_count();
     int32_t spriteCount = 0;
@@ -1252,7 +1303,7 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
         }
     }
 
-    console.WriteFormatLine("Sprites: %d/%d", spriteCount, MAX_SPRITES);
+    console.WriteFormatLine("Sprites: %d/%zu", spriteCount, GetMaxEntities());
     console.WriteFormatLine("Map Elements: %d/%d", tileElementCount, MAX_TILE_ELEMENTS);
     console.WriteFormatLine("Banners: %d/%zu", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, MAX_RIDES);
@@ -1261,6 +1312,241 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static int32_t cc_profiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.empty())
+    {
+        console.WriteLine("Subcommands: start, stop, reset, overlay, csv <path>, entities, ticks, hitches [ms]");
+        return 1;
+    }
+
+    if (argv[0] == "start")
+    {
+        frame_profiler_set_enabled(true);
+        entity_scheduler_set_profiling(true);
+        tick_profiler_set_enabled(true);
+        console.WriteLine("Frame profiler started.");
+    }
+    else if (argv[0] == "stop")
+    {
+        frame_profiler_set_enabled(false);
+        frame_profiler_set_overlay_visible(false);
+        entity_scheduler_set_profiling(false);
+        tick_profiler_set_enabled(false);
+        hitch_tracker_set_threshold(0);
+        console.WriteLine("Frame profiler stopped.");
+    }
+    else if (argv[0] == "reset")
+    {
+        frame_profiler_reset();
+        entity_scheduler_reset();
+        tick_profiler_reset();
+    }
+    else if (argv[0] == "overlay")
+    {
+        bool visible = !frame_profiler_is_overlay_visible();
+        if (visible)
+        {
+            frame_profiler_set_enabled(true);
+            tick_profiler_set_enabled(true);
+        }
+        frame_profiler_set_overlay_visible(visible);
+    }
+    else if (argv[0] == "csv")
+    {
+        if (argv.size() < 2)
+        {
+            console.WriteLineError("Path required.");
+            return 1;
+        }
+        if (!frame_profiler_write_csv(argv[1]))
+        {
+            console.WriteLineError("Unable to write the samples.");
+            return 1;
+        }
+        console.WriteFormatLine("Wrote %zu frames to %s", frame_profiler_get_samples().size(), argv[1].c_str());
+    }
+    else if (argv[0] == "entities")
+    {
+        if (!entity_scheduler_is_profiling())
+        {
+            console.WriteLineError("The profiler is not running.");
+            return 1;
+        }
+
+        auto stats = entity_scheduler_get_stats();
+        console.WriteFormatLine(
+            "Entity updates at tick %u (last / average / max over %zu ticks, us):", stats.Tick, ENTITY_SCHEDULER_HISTORY);
+        for (size_t i = 0; i < static_cast<size_t>(EntityUpdateGroup::Count); i++)
+        {
+            console.WriteFormatLine(
+                "  %-8s %8.1f %8.1f %8.1f", entity_scheduler_get_group_name(static_cast<EntityUpdateGroup>(i)),
+                stats.LastNanoseconds[i] / 1000.0, stats.AverageNanoseconds[i] / 1000.0, stats.MaxNanoseconds[i] / 1000.0);
+        }
+        console.WriteFormatLine(
+            "Entities due: %u every tick, %u 128 tick updates, %u idle",
+            stats.Entities[static_cast<size_t>(EntityUpdateCadence::EveryTick)],
+            stats.Entities[static_cast<size_t>(EntityUpdateCadence::Every128Ticks)],
+            stats.Entities[static_cast<size_t>(EntityUpdateCadence::Idle)]);
+
+        auto dispatch = ride_get_mechanic_dispatch_stats();
+        console.WriteFormatLine(
+            "Mechanic dispatch: %u calls, %u mechanics checked, %.1f us", dispatch.Calls, dispatch.MechanicsChecked,
+            dispatch.Nanoseconds / 1000.0);
+
+        auto rides = ride_get_update_stats();
+        for (size_t i = 0; i < static_cast<size_t>(RideActivity::Count); i++)
+        {
+            auto count = rides.Rides[i];
+            console.WriteFormatLine(
+                "Rides %-8s %4u, %8.1f us, %6.2f us per ride", ride_get_activity_name(static_cast<RideActivity>(i)), count,
+                rides.Nanoseconds[i] / 1000.0, count == 0 ? 0.0 : rides.Nanoseconds[i] / 1000.0 / count);
+        }
+        console.WriteFormatLine(
+            "Ride stations: %u updated, %u settled and skipped", rides.StationsUpdated, rides.StationsSkipped);
+
+        auto motion = vehicle_get_motion_stats();
+        console.WriteFormatLine(
+            "Track motion: %u trains, %u cars, %.1f us", motion.Calls, motion.Cars, motion.Nanoseconds / 1000.0);
+        console.WriteFormatLine(
+            "  %u steps, %u on plain pieces, %u piece changes, %u move info lookups, %u collision checks", motion.Steps,
+            motion.PlainSteps, motion.PieceChanges, motion.MoveInfoLookups, motion.CollisionChecks);
+    }
+    else if (argv[0] == "ticks")
+    {
+        if (!tick_profiler_is_enabled())
+        {
+            console.WriteLineError("The profiler is not running.");
+            return 1;
+        }
+
+        auto stats = tick_profiler_get_stats();
+        console.WriteFormatLine("Tick phases over %zu ticks (average / p99 / max, us):", stats.Ticks);
+        for (size_t i = 0; i < static_cast<size_t>(TickPhase::Count); i++)
+        {
+            const auto& phase = stats.Phases[i];
+            console.WriteFormatLine(
+                "  %-17s %8.1f %8.1f %8.1f", tick_profiler_get_phase_name(static_cast<TickPhase>(i)),
+                phase.AverageNanoseconds / 1000.0, phase.P99Nanoseconds / 1000.0, phase.MaxNanoseconds / 1000.0);
+        }
+
+        console.WriteFormatLine("Worst tick %u:", stats.Worst.Tick);
+        for (size_t i = 0; i < static_cast<size_t>(TickPhase::Count); i++)
+        {
+            console.WriteFormatLine(
+                "  %-17s %8.1f", tick_profiler_get_phase_name(static_cast<TickPhase>(i)),
+                stats.Worst.Nanoseconds[i] / 1000.0);
+        }
+    }
+    else if (argv[0] == "hitches")
+    {
+        if (argv.size() >= 2)
+        {
+            hitch_tracker_set_threshold(static_cast<uint32_t>(std::max(atol(argv[1].c_str()), 0L)));
+        }
+
+        auto threshold = hitch_tracker_get_threshold();
+        if (threshold == 0)
+        {
+            console.WriteLine("Hitches are not logged.");
+        }
+        else
+        {
+            console.WriteFormatLine(
+                "Logging updates and frames over %u ms, %u logged so far.", threshold, hitch_tracker_get_count());
+        }
+    }
+    else
+    {
+        console.WriteLineError("Unknown subcommand.");
+        return 1;
+    }
+    return 0;
+}
+
+static int32_t cc_memory(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty())
+    {
+        if (argv[0] != "reset")
+        {
+            console.WriteLineError("Unknown subcommand.");
+            return 1;
+        }
+        memory_report_reset_peaks();
+    }
+
+    size_t total = 0;
+    auto report = memory_report_get();
+    console.WriteLine("Memory usage (current / peak, KiB):");
+    for (size_t i = 0; i < report.size(); i++)
+    {
+        const auto& usage = report[i];
+        auto name = memory_report_get_subsystem_name(static_cast<MemorySubsystem>(i));
+        if (usage.Available)
+        {
+            console.WriteFormatLine("  %-14s %10zu %10zu", name, usage.Current / 1024, usage.Peak / 1024);
+            total += usage.Current;
+        }
+        else
+        {
+            console.WriteFormatLine("  %-14s %10s", name, "n/a");
+        }
+    }
+    console.WriteFormatLine("  %-14s %10zu", "total", total / 1024);
+    return 0;
+}
+
+static int32_t cc_pathfinding(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty())
+    {
+        if (argv[0] != "reset")
+        {
+            console.WriteLineError("Unknown subcommand.");
+            return 1;
+        }
+        pathfind_stats_reset();
+        console.WriteLine("Pathfinding statistics reset.");
+        return 0;
+    }
+
+    auto stats = pathfind_stats_get();
+    const auto& last = stats.LastTick;
+    const auto& total = stats.Total;
+    auto ticks = std::max<uint32_t>(stats.Ticks, 1);
+    console.WriteFormatLine("Pathfinding at tick %u (last tick / average over %u ticks):", stats.Tick, stats.Ticks);
+    auto writeCounter = [&console, ticks](const char* name, uint32_t lastValue, uint32_t totalValue) {
+        console.WriteFormatLine("  %-16s %8u %10.1f", name, lastValue, static_cast<double>(totalValue) / ticks);
+    };
+    writeCounter("Calls", last.Calls, total.Calls);
+    writeCounter("Searches", last.Searches, total.Searches);
+    writeCounter("Tiles checked", last.TilesChecked, total.TilesChecked);
+    writeCounter("Junctions", last.Junctions, total.Junctions);
+    writeCounter("Limit reached", last.LimitReached, total.LimitReached);
+    writeCounter("Distance fields", last.DistanceFieldHits, total.DistanceFieldHits);
+    writeCounter("Budget deferred", last.BudgetDeferred, total.BudgetDeferred);
+    console.WriteFormatLine(
+        "  %-16s %8.1f %10.1f", "Time (us)", last.Nanoseconds / 1000.0, static_cast<double>(total.Nanoseconds) / ticks / 1000.0);
+
+    if (!stats.Rides.empty())
+    {
+        console.WriteLine("Time spent per goal (calls, ms):");
+        for (size_t i = 0; i < stats.Rides.size() && i < 10; i++)
+        {
+            const auto& rideStats = stats.Rides[i];
+            std::string name = "Park entrances, exits and staff";
+            auto ride = get_ride(rideStats.Ride);
+            if (ride != nullptr)
+            {
+                name = ride->GetName();
+            }
+            console.WriteFormatLine("  %-32s %8u %10.2f", name.c_str(), rideStats.Calls, rideStats.Nanoseconds / 1000000.0);
+        }
+    }
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1388,6 +1674,103 @@ static int32_t cc_say(InteractiveConsole& console, const arguments_t& argv)
     }
 }
 
+static int32_t cc_network_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() == NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command only works in multiplayer mode.");
+        return 0;
+    }
+
+    NetworkStats_t stats;
+    if (!argv.empty())
+    {
+        bool valid = false;
+        int32_t playerId = console_parse_int(argv[0], &valid);
+        if (!valid || network_get_mode() != NETWORK_MODE_SERVER || network_get_player_index(playerId) == -1)
+        {
+            console.WriteFormatLine("Invalid player id, the stats of single players are only known by the server.");
+            return 1;
+        }
+        stats = network_get_player_stats(playerId);
+    }
+    else
+    {
+        stats = network_get_stats();
+    }
+
+    console.WriteFormatLine("%-20s %10s %12s %10s %12s", "Command", "Sent", "Sent bytes", "Received", "Recv bytes");
+    for (uint32_t i = 0; i < EnumValue(NetworkCommand::Max); i++)
+    {
+        const auto& commandStats = stats.commands[i];
+        const auto* name = network_get_command_name(static_cast<NetworkCommand>(i));
+        if (name == nullptr || (commandStats.packetsSent == 0 && commandStats.packetsReceived == 0))
+        {
+            continue;
+        }
+        console.WriteFormatLine(
+            "%-20s %10llu %12llu %10llu %12llu", name, static_cast<unsigned long long>(commandStats.packetsSent),
+            static_cast<unsigned long long>(commandStats.bytesSent),
+            static_cast<unsigned long long>(commandStats.packetsReceived),
+            static_cast<unsigned long long>(commandStats.bytesReceived));
+    }
+    console.WriteFormatLine(
+        "Queued: %llu packets, %llu bytes", static_cast<unsigned long long>(stats.queuedPackets),
+        static_cast<unsigned long long>(stats.queuedBytes));
+    if (stats.sendLatencyCount != 0)
+    {
+        console.WriteFormatLine(
+            "Send latency: %llu ms average, %u ms max",
+            static_cast<unsigned long long>(stats.sendLatencyTotal / stats.sendLatencyCount), stats.sendLatencyMax);
+    }
+    if (stats.mapBytesUncompressed != 0)
+    {
+        console.WriteFormatLine(
+            "Maps: %llu saved, %llu of %llu bytes (%.1f%%)", static_cast<unsigned long long>(stats.mapsSaved),
+            static_cast<unsigned long long>(stats.mapBytesCompressed),
+            static_cast<unsigned long long>(stats.mapBytesUncompressed),
+            100.0 * stats.mapBytesCompressed / stats.mapBytesUncompressed);
+    }
+    return 0;
+}
+
+#ifdef ENABLE_SCRIPTING
+static int32_t cc_plugin_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    auto& plugins = OpenRCT2::GetContext()->GetScriptEngine().GetPlugins();
+    if (!argv.empty())
+    {
+        if (argv[0] != "reset")
+        {
+            console.WriteLineError("Unknown subcommand.");
+            return 1;
+        }
+        for (auto& plugin : plugins)
+        {
+            plugin->ResetCallStats();
+        }
+        console.WriteLine("Plugin statistics reset.");
+        return 0;
+    }
+
+    console.WriteFormatLine("%-32s %10s %12s %10s", "Plugin / hook", "Calls", "Time (ms)", "Max (ms)");
+    auto writeStats = [&console](const std::string& name, const OpenRCT2::Scripting::PluginCallStats& stats) {
+        console.WriteFormatLine(
+            "%-32s %10llu %12.1f %10.2f", name.c_str(), static_cast<unsigned long long>(stats.Calls),
+            stats.TotalTime / 1000.0, stats.MaxTime / 1000.0);
+    };
+    for (const auto& plugin : plugins)
+    {
+        writeStats(plugin->GetMetadata().Name, plugin->GetTotalCallStats());
+        for (const auto& [kind, stats] : plugin->GetCallStats())
+        {
+            writeStats("  " + kind, stats);
+        }
+    }
+    return 0;
+}
+#endif
+
 static int32_t cc_replay_startrecord(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1501,10 +1884,13 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        log_info(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+        log_info(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
 
         return 1;
     }
@@ -1530,6 +1916,38 @@ static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& ar
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("No replay playing.");
+        return 0;
+    }
+
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay at tick %u", tick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1575,7 +1993,7 @@ static int32_t cc_mp_desync(InteractiveConsole& console, const arguments_t& argv
 
     std::vector<Peep*> peeps;
 
-    for (int i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* sprite = GetEntity(i);
         if (sprite == nullptr || sprite->sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -1744,6 +2162,7 @@ static constexpr const utf8* console_variable_table[] = {
     "park_open",
     "climate",
     "game_speed",
+    "turbo",
     "console_small_font",
     "location",
     "window_scale",
@@ -1753,6 +2172,8 @@ static constexpr const utf8* console_variable_table[] = {
     "cheat_sandbox_mode",
     "cheat_disable_clearance_checks",
     "cheat_disable_support_limits",
+    "cheat_pathfinding_budget",
+    "cheat_ride_ratings_per_tick",
     "current_rotation",
 };
 static constexpr const utf8* console_window_table[] = {
@@ -1783,8 +2204,15 @@ static constexpr const console_command console_command_table[] = {
                                     "This is a safer method opposed to \"open object_selection\".",
                                     "load_object <objectfilenodat>" },
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
+    { "memory", cc_memory, "Shows the memory used by the map, entities, images, sounds, fonts and plugins.", "memory [reset]" },
+    { "network_stats", cc_network_stats, "Shows the network traffic by command, of all players or one of them.", "network_stats [player id]" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "pathfinding", cc_pathfinding, "Shows how much work the pathfinding does, always counted.", "pathfinding [reset]" },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_stats", cc_plugin_stats, "Shows the time spent in each plugin and its hooks.", "plugin_stats [reset]" },
+#endif
+    { "profiler", cc_profiler, "Times the phases of each frame and the stages of each tick.", "profiler start|stop|reset|overlay|csv <path>|entities|ticks|hitches [ms]" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
@@ -1802,6 +2230,7 @@ static constexpr const console_command console_command_table[] = {
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
+    { "replay_seek", cc_replay_seek, "Moves the replay to a tick, counted from its start", "replay_seek <tick>"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random peep, 1 = Remove random peep ]"},
 
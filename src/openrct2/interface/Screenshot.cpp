@@ -15,9 +15,13 @@
 #include "../OpenRCT2.h"
 #include "../actions/SetCheatAction.hpp"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Imaging.h"
+#include "../core/Json.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/FrameProfiler.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Localisation.h"
 #include "../platform/Platform2.h"
@@ -28,8 +32,11 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <algorithm>
+#include <array>
 #include <cctype>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
 #include <optional>
@@ -377,9 +384,93 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
     viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
 }
 
+// Number of rows of a large screenshot that are rendered at a time
+constexpr int32_t SCREENSHOT_BAND_HEIGHT = 256;
+
+/**
+ * Renders the viewport into a PNG a band of rows at a time, so only two bands are ever in memory instead of the whole
+ * image. Each band is drawn in columns on the task scheduler like any other viewport, while it is drawn the previous band
+ * is compressed on the scheduler as well.
+ */
+static void WriteViewportToFile(const std::string_view& path, const rct_viewport& viewport)
+{
+    Imaging::PngRowWriter writer(path, viewport.width, viewport.height, gPalette);
+
+    const int32_t bandHeight = std::min<int32_t>(SCREENSHOT_BAND_HEIGHT, viewport.height);
+    std::array<std::vector<uint8_t>, 2> bands;
+    try
+    {
+        for (auto& band : bands)
+        {
+            band.resize(static_cast<size_t>(viewport.width) * bandHeight);
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        throw std::runtime_error("Screenshot failed, unable to allocate memory for image.");
+    }
+
+    auto& scheduler = TaskScheduler::GetGlobal();
+    TaskGroup encodeTask;
+    std::exception_ptr encodeError;
+    auto drawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
+    try
+    {
+        for (int32_t top = 0, bandIndex = 0; top < viewport.height; top += bandHeight, bandIndex ^= 1)
+        {
+            // The band is a viewport of its own, covering its rows of the whole view
+            const int32_t numRows = std::min<int32_t>(bandHeight, viewport.height - top);
+            rct_viewport bandViewport = viewport;
+            bandViewport.viewPos.y = viewport.viewPos.y + top * viewport.zoom;
+            bandViewport.height = numRows;
+            bandViewport.view_height = numRows * viewport.zoom;
+
+            // The other band may still be compressed, but this one was written before that was started
+            auto& band = bands[bandIndex];
+            if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+            {
+                std::fill(band.begin(), band.end(), PALETTE_INDEX_0);
+            }
+            rct_drawpixelinfo dpi{};
+            dpi.bits = band.data();
+            dpi.width = bandViewport.width;
+            dpi.height = numRows;
+            RenderViewport(drawingEngine.get(), bandViewport, dpi);
+
+            // Rows have to be written in order, so the previous band has to be done first
+            scheduler.Wait(encodeTask);
+            if (encodeError)
+            {
+                std::rethrow_exception(encodeError);
+            }
+            scheduler.Schedule(encodeTask, [&writer, &encodeError, &band, numRows, width = viewport.width]() {
+                try
+                {
+                    writer.WriteRows(band.data(), numRows, width);
+                }
+                catch (const std::exception&)
+                {
+                    encodeError = std::current_exception();
+                }
+            });
+        }
+    }
+    catch (const std::exception&)
+    {
+        scheduler.Wait(encodeTask);
+        throw;
+    }
+
+    scheduler.Wait(encodeTask);
+    if (encodeError)
+    {
+        std::rethrow_exception(encodeError);
+    }
+    writer.Finish();
+}
+
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -408,10 +499,7 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path->c_str(), &dpi, gPalette);
+        WriteViewportToFile(*path, viewport);
 
         // Show user that screenshot saved successfully
         Formatter ft;
@@ -424,8 +512,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -548,6 +634,219 @@ int32_t cmdline_for_gfxbench(const char** argv, int32_t argc)
     return 1;
 }
 
+struct GfxBenchStatistics
+{
+    double Min{};
+    double Mean{};
+    double Median{};
+    double P90{};
+    double P99{};
+    double Max{};
+    double StdDev{};
+};
+
+static constexpr const char* GfxBenchPhaseNames[] = { "generate", "arrange", "draw", "frame" };
+
+static double benchgfx_percentile(const std::vector<double>& sortedSamples, double fraction)
+{
+    // Interpolate between the two closest ranks
+    auto rank = fraction * static_cast<double>(sortedSamples.size() - 1);
+    auto lower = static_cast<size_t>(rank);
+    auto upper = std::min(lower + 1, sortedSamples.size() - 1);
+    return sortedSamples[lower] + (sortedSamples[upper] - sortedSamples[lower]) * (rank - static_cast<double>(lower));
+}
+
+static GfxBenchStatistics benchgfx_calculate_statistics(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    GfxBenchStatistics stats;
+    double sum = 0.0;
+    for (auto sample : samples)
+    {
+        sum += sample;
+    }
+    stats.Mean = sum / static_cast<double>(samples.size());
+
+    double squaredDeviations = 0.0;
+    for (auto sample : samples)
+    {
+        squaredDeviations += (sample - stats.Mean) * (sample - stats.Mean);
+    }
+    stats.StdDev = std::sqrt(squaredDeviations / static_cast<double>(samples.size()));
+
+    stats.Min = samples.front();
+    stats.Median = benchgfx_percentile(samples, 0.5);
+    stats.P90 = benchgfx_percentile(samples, 0.9);
+    stats.P99 = benchgfx_percentile(samples, 0.99);
+    stats.Max = samples.back();
+    return stats;
+}
+
+static double benchgfx_get_phase_time(GfxBenchPhase phase, const FrameProfilerSample& sample, double frameTime)
+{
+    switch (phase)
+    {
+        case GfxBenchPhase::Generate:
+            return sample.Nanoseconds[EnumValue(FramePhase::Generate)] / 1e6;
+        case GfxBenchPhase::Arrange:
+            return sample.Nanoseconds[EnumValue(FramePhase::Arrange)] / 1e6;
+        case GfxBenchPhase::Draw:
+            return sample.Nanoseconds[EnumValue(FramePhase::Draw)] / 1e6;
+        default:
+            return frameTime * 1e3;
+    }
+}
+
+static bool benchgfx_measure_park(
+    IContext& context, const char* inputPath, GfxBenchPhase phase, const GfxBenchOptions& options, json_t& results)
+{
+    if (!context.LoadParkFromFile(inputPath))
+    {
+        return false;
+    }
+
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    constexpr int32_t MAX_ROTATIONS = 4;
+    auto drawingEngine = std::make_unique<X8DrawingEngine>(context.GetUiContext());
+    auto savedRotation = gCurrentRotation;
+    for (int32_t zoom = 0; zoom <= ZoomLevel::max(); zoom++)
+    {
+        if (options.zoom != -1 && options.zoom != zoom)
+            continue;
+
+        for (int32_t rotation = 0; rotation < MAX_ROTATIONS; rotation++)
+        {
+            if (options.rotation != -1 && options.rotation != rotation)
+                continue;
+
+            gCurrentRotation = rotation;
+            auto viewport = GetGiantViewport(gMapSize, rotation, zoom);
+            auto dpi = CreateDPI(viewport);
+
+            // The first renders warm up the caches and the tile paint cache, they are not part of the results
+            std::vector<double> samples;
+            for (int32_t i = 0; i < options.warmup + options.repetitions; i++)
+            {
+                frame_profiler_begin_frame();
+                double elapsed = MeasureFunctionTime(
+                    [&drawingEngine, &viewport, &dpi]() { RenderViewport(drawingEngine.get(), viewport, dpi); });
+                frame_profiler_end_frame();
+                if (i >= options.warmup)
+                {
+                    samples.push_back(benchgfx_get_phase_time(phase, frame_profiler_get_samples().back(), elapsed));
+                }
+            }
+            ReleaseDPI(dpi);
+
+            auto stats = benchgfx_calculate_statistics(samples);
+            std::printf(
+                "%s zoom %d rotation %d: min %.03fms, median %.03fms, p90 %.03fms, p99 %.03fms, max %.03fms, mean %.03fms, "
+                "stddev %.03fms\n",
+                inputPath, zoom, rotation, stats.Min, stats.Median, stats.P90, stats.P99, stats.Max, stats.Mean, stats.StdDev);
+
+            json_t result = {
+                { "park", inputPath },
+                { "zoom", zoom },
+                { "rotation", rotation },
+                { "width", viewport.width },
+                { "height", viewport.height },
+                { "min", stats.Min },
+                { "median", stats.Median },
+                { "p90", stats.P90 },
+                { "p99", stats.P99 },
+                { "max", stats.Max },
+                { "mean", stats.Mean },
+                { "stddev", stats.StdDev },
+                { "samples", samples },
+            };
+            results.push_back(result);
+        }
+    }
+    gCurrentRotation = savedRotation;
+    return true;
+}
+
+int32_t cmdline_for_gfxbench_phase(const char** argv, int32_t argc, GfxBenchPhase phase, const GfxBenchOptions* options)
+{
+    // Options come last, everything before them is a park to benchmark
+    std::vector<const char*> inputPaths;
+    for (int32_t i = 0; i < argc && argv[i][0] != '-'; i++)
+    {
+        inputPaths.push_back(argv[i]);
+    }
+
+    auto phaseName = GfxBenchPhaseNames[EnumValue(phase)];
+    if (inputPaths.empty() || options->warmup < 0 || options->repetitions < 1 || options->zoom < -1
+        || options->zoom > ZoomLevel::max() || options->rotation < -1 || options->rotation > 3)
+    {
+        std::printf(
+            "Usage: openrct2 benchgfx %s <file>... [--warmup <count>] [--repetitions <count>] [--zoom <zoom>] "
+            "[--rotation <rotation>] [--json <output_file>]\n",
+            phaseName);
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        return -1;
+    }
+    drawing_engine_init();
+
+    // The phases of concurrently painted columns overlap, so they can only be told apart on a single thread
+    auto savedMultithreading = gConfigGeneral.multithreading;
+    if (phase != GfxBenchPhase::Frame)
+    {
+        gConfigGeneral.multithreading = false;
+    }
+
+    auto profilerWasEnabled = frame_profiler_is_enabled();
+    frame_profiler_set_enabled(true);
+
+    int32_t result = 1;
+    json_t results = json_t::array();
+    try
+    {
+        for (auto inputPath : inputPaths)
+        {
+            if (!benchgfx_measure_park(*context, inputPath, phase, *options, results))
+            {
+                Console::Error::WriteLine("Unable to load park: %s", inputPath);
+                result = -1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        result = -1;
+    }
+    gConfigGeneral.multithreading = savedMultithreading;
+    frame_profiler_set_enabled(profilerWasEnabled);
+
+    if (options->json_path != nullptr)
+    {
+        json_t document = {
+            { "phase", phaseName },
+            { "unit", "ms" },
+            { "warmup", options->warmup },
+            { "repetitions", options->repetitions },
+            { "multithreading", static_cast<bool>(gConfigGeneral.multithreading) && phase == GfxBenchPhase::Frame },
+            { "results", results },
+        };
+        Json::WriteToFile(options->json_path, document);
+    }
+
+    drawing_engine_dispose();
+    return result;
+}
+
 static void ApplyOptions(const ScreenshotOptions* options, rct_viewport& viewport)
 {
     if (options->weather != 0)
@@ -624,7 +923,6 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
     }
 
     int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
     try
     {
         core_init();
@@ -726,17 +1024,13 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 
         ApplyOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+        WriteViewportToFile(outputPath, viewport);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(dpi);
 
     drawing_engine_dispose();
 
@@ -794,22 +1088,44 @@ static std::string ResolveFilenameForCapture(const fs::path& filename)
     }
 }
 
+static rct_viewport GetCaptureViewport(const CaptureView& view, ZoomLevel zoom, uint8_t rotation)
+{
+    rct_viewport viewport{};
+    viewport.width = view.Width;
+    viewport.height = view.Height;
+    viewport.view_width = viewport.width;
+    viewport.view_height = viewport.height;
+
+    auto z = tile_element_height(view.Position);
+    CoordsXYZ coords3d(view.Position, z);
+    auto coords2d = translate_3d_to_2d_with_z(rotation, coords3d);
+    viewport.viewPos = { coords2d.x - ((viewport.view_width * zoom) / 2), coords2d.y - ((viewport.view_height * zoom) / 2) };
+    viewport.zoom = zoom;
+    return viewport;
+}
+
+double benchgfx_render_view(const CaptureView& view, ZoomLevel zoom, uint8_t rotation)
+{
+    auto viewport = GetCaptureViewport(view, zoom, rotation);
+    auto backupRotation = gCurrentRotation;
+    gCurrentRotation = rotation;
+
+    auto drawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
+    auto dpi = CreateDPI(viewport);
+    double elapsed = MeasureFunctionTime(
+        [&drawingEngine, &viewport, &dpi]() { RenderViewport(drawingEngine.get(), viewport, dpi); });
+    ReleaseDPI(dpi);
+
+    gCurrentRotation = backupRotation;
+    return elapsed;
+}
+
 void CaptureImage(const CaptureOptions& options)
 {
     rct_viewport viewport{};
     if (options.View)
     {
-        viewport.width = options.View->Width;
-        viewport.height = options.View->Height;
-        viewport.view_width = viewport.width;
-        viewport.view_height = viewport.height;
-
-        auto z = tile_element_height(options.View->Position);
-        CoordsXYZ coords3d(options.View->Position, z);
-        auto coords2d = translate_3d_to_2d_with_z(options.Rotation, coords3d);
-        viewport.viewPos = { coords2d.x - ((viewport.view_width * options.Zoom) / 2),
-                             coords2d.y - ((viewport.view_height * options.Zoom) / 2) };
-        viewport.zoom = options.Zoom;
+        viewport = GetCaptureViewport(*options.View, options.Zoom, options.Rotation);
     }
     else
     {
@@ -819,11 +1135,16 @@ void CaptureImage(const CaptureOptions& options)
     auto backupRotation = gCurrentRotation;
     gCurrentRotation = options.Rotation;
 
-    auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, &dpi, gPalette);
-    ReleaseDPI(dpi);
+    try
+    {
+        auto outputPath = ResolveFilenameForCapture(options.Filename);
+        WriteViewportToFile(outputPath, viewport);
+    }
+    catch (const std::exception&)
+    {
+        gCurrentRotation = backupRotation;
+        throw;
+    }
 
     gCurrentRotation = backupRotation;
 }
@@ -35,6 +35,23 @@ struct ScreenshotOptions
     bool transparent = false;
 };
 
+enum class GfxBenchPhase : uint8_t
+{
+    Generate,
+    Arrange,
+    Draw,
+    Frame,
+};
+
+struct GfxBenchOptions
+{
+    int32_t warmup = 2;
+    int32_t repetitions = 10;
+    int32_t zoom = -1;
+    int32_t rotation = -1;
+    utf8* json_path = nullptr;
+};
+
 struct CaptureView
 {
     int32_t Width{};
@@ -58,5 +75,12 @@ std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void*
 void screenshot_giant();
 int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options);
 int32_t cmdline_for_gfxbench(const char** argv, int32_t argc);
+int32_t cmdline_for_gfxbench_phase(const char** argv, int32_t argc, GfxBenchPhase phase, const GfxBenchOptions* options);
+
+/**
+ * Renders the view of the park with the software renderer and returns the time it took in seconds, without the time
+ * to set up the drawing engine and image.
+ */
+double benchgfx_render_view(const CaptureView& view, ZoomLevel zoom, uint8_t rotation);
 
 void CaptureImage(const CaptureOptions& options);
@@ -13,11 +13,14 @@
 #include "../Game.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/FrameProfiler.h"
 #include "../drawing/IDrawingEngine.h"
+#include "../paint/ImpostorCache.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -44,13 +47,15 @@ uint8_t gShowConstuctionRightsRefCount;
 rct_viewport g_viewport_list[MAX_VIEWPORT_COUNT];
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
 
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
 
 paint_entry* gNextFreePaintStruct;
+
+// Columns which are finished by viewport_finish_deferred instead of viewport_paint on this thread.
+static thread_local std::vector<paint_session*>* _deferredColumns;
 uint8_t gCurrentRotation;
 
 static uint32_t _currentImageType;
@@ -791,7 +796,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     if (right <= viewport->pos.x)
         return;
@@ -832,41 +837,70 @@ void viewport_render(
 #endif
 }
 
-static void record_session(const paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void record_session(
+    const paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     // Perform a deep copy of the paint session, use relative offsets.
     // This is done to extract the session for benchmark.
     // Place the copied session at provided record_index, so the caller can decide which columns/paint sessions to copy; there
     // is no column information embedded in the session itself.
-    (*recorded_sessions)[record_index] = (*session);
-    paint_session* session_copy = &recorded_sessions->at(record_index);
+    auto& recordedSession = recorded_sessions->at(record_index);
+    recordedSession.Session = *session;
+    recordedSession.Entries.resize(session->PaintEntryChain.GetCount());
+
+    // Flatten the chain, remembering where each node starts so pointers can be turned into indices.
+    std::vector<std::pair<const PaintEntryPool::Node*, size_t>> nodeOffsets;
+    size_t offset = 0;
+    for (auto node = session->PaintEntryChain.Head; node != nullptr; node = node->Next)
+    {
+        std::copy_n(node->PaintStructs, node->Count, recordedSession.Entries.begin() + offset);
+        nodeOffsets.emplace_back(node, offset);
+        offset += node->Count;
+    }
 
-    // Mind the offset needs to be calculated against the original `session`, not `session_copy`
-    for (auto& ps : session_copy->PaintStructs)
+    // Mind the offset needs to be calculated against the original `session`, not the copy
+    const size_t nullIndex = recordedSession.Entries.size();
+    auto getIndex = [&nodeOffsets, nullIndex](const paint_struct* ps) {
+        auto entry = reinterpret_cast<const paint_entry*>(ps);
+        for (const auto& [node, nodeOffset] : nodeOffsets)
+        {
+            if (entry >= node->PaintStructs && entry < node->PaintStructs + node->Count)
+            {
+                return nodeOffset + static_cast<size_t>(entry - node->PaintStructs);
+            }
+        }
+        return nullIndex;
+    };
+    for (auto& entry : recordedSession.Entries)
     {
-        ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(
-            ps.basic.next_quadrant_ps ? int(ps.basic.next_quadrant_ps - &session->PaintStructs[0].basic)
-                                      : std::size(session->PaintStructs));
+        entry.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(getIndex(entry.basic.next_quadrant_ps));
     }
-    for (auto& quad : session_copy->Quadrants)
+    for (auto& quad : recordedSession.Session.Quadrants)
     {
-        quad = reinterpret_cast<paint_struct*>(
-            quad ? int(quad - &session->PaintStructs[0].basic) : std::size(session->Quadrants));
+        quad = reinterpret_cast<paint_struct*>(getIndex(quad));
     }
 }
 
-static void viewport_fill_column(paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void viewport_fill_column(paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
-    paint_session_generate(session);
+    {
+        FramePhaseTimer timer(FramePhase::Generate);
+        paint_session_generate(session);
+    }
+
     if (recorded_sessions != nullptr)
     {
         record_session(session, recorded_sessions, record_index);
     }
+
+    FramePhaseTimer timer(FramePhase::Arrange);
     paint_session_arrange(session);
 }
 
 static void viewport_paint_column(paint_session* session)
 {
+    FramePhaseTimer timer(FramePhase::Draw);
+
     if (session->ViewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
                | VIEWPORT_FLAG_CLIP_VIEW)
@@ -887,7 +921,14 @@ static void viewport_paint_column(paint_session* session)
     {
         viewport_paint_weather_gloom(&session->DPI);
     }
+}
 
+/**
+ * Text drawing and releasing the session are not thread safe, so this always runs on the
+ * calling thread once all columns have been drawn.
+ */
+static void viewport_finish_column(paint_session* session)
+{
     if (session->PSStringHead != nullptr)
     {
         paint_draw_money_structs(&session->DPI, session->PSStringHead);
@@ -896,6 +937,12 @@ static void viewport_paint_column(paint_session* session)
     paint_session_free(session);
 }
 
+static bool viewport_can_draw_in_parallel(const rct_drawpixelinfo* dpi)
+{
+    auto drawingEngine = dpi->DrawingEngine;
+    return drawingEngine != nullptr && (drawingEngine->GetFlags() & DEF_PARALLEL_DRAWING);
+}
+
 /**
  *
  *  rct2: 0x00685CBF
@@ -908,7 +955,7 @@ static void viewport_paint_column(paint_session* session)
  */
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* recorded_sessions)
+    std::vector<RecordedPaintSession>* recorded_sessions)
 {
     uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
@@ -941,6 +988,11 @@ void viewport_paint(
     dpi1.remX = std::max(0, dpi->x - x);
     dpi1.remY = std::max(0, dpi->y - y);
 
+    if (recorded_sessions == nullptr && impostor_cache_paint(viewport, &dpi1))
+    {
+        return;
+    }
+
     // make sure, the compare operation is done in int16_t to avoid the loop becoming an infiniteloop.
     // this as well as the [x += 32] in the loop causes signed integer overflow -> undefined behaviour.
     const int16_t rightBorder = dpi1.x + dpi1.width;
@@ -949,14 +1001,11 @@ void viewport_paint(
     std::vector<paint_session*> columns;
 
     bool useMultithreading = gConfigGeneral.multithreading;
-    if (useMultithreading && _paintJobs == nullptr)
-    {
-        _paintJobs = std::make_unique<JobPool>();
-    }
-    else if (useMultithreading == false && _paintJobs != nullptr)
-    {
-        _paintJobs.reset();
-    }
+    // Columns cover disjoint parts of the target, so if the engine allows it the whole
+    // fill -> arrange -> draw pipeline of a column can run on a worker.
+    const bool useParallelDrawing = useMultithreading && viewport_can_draw_in_parallel(dpi);
+    auto scheduler = useMultithreading ? &TaskScheduler::GetGlobal() : nullptr;
+    TaskGroup paintTasks;
 
     // Create space to record sessions and keep track which index is being drawn
     size_t index = 0;
@@ -994,8 +1043,14 @@ void viewport_paint(
 
         if (useMultithreading)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
+            scheduler->Schedule(paintTasks, [session, recorded_sessions, index, useParallelDrawing]() -> void {
+                PROFILE_ZONE("Paint column");
+                viewport_fill_column(session, recorded_sessions, index);
+                if (useParallelDrawing)
+                {
+                    viewport_paint_column(session);
+                }
+            });
         }
         else
         {
@@ -1005,13 +1060,43 @@ void viewport_paint(
 
     if (useMultithreading)
     {
-        _paintJobs->Join();
+        scheduler->Wait(paintTasks);
     }
 
     for (auto&& column : columns)
     {
-        viewport_paint_column(column);
+        if (!useParallelDrawing)
+        {
+            viewport_paint_column(column);
+        }
+
+        if (_deferredColumns != nullptr)
+        {
+            _deferredColumns->push_back(column);
+        }
+        else
+        {
+            viewport_finish_column(column);
+        }
+    }
+}
+
+void viewport_render_deferred(
+    rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
+    std::vector<paint_session*>& deferredSessions)
+{
+    _deferredColumns = &deferredSessions;
+    viewport_render(dpi, viewport, left, top, right, bottom);
+    _deferredColumns = nullptr;
+}
+
+void viewport_finish_deferred(std::vector<paint_session*>& deferredSessions)
+{
+    for (auto session : deferredSessions)
+    {
+        viewport_finish_column(session);
     }
+    deferredSessions.clear();
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
@@ -33,12 +33,16 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cmath>
 #include <functional>
 #include <iterator>
 #include <list>
+#include <vector>
 
 std::list<std::shared_ptr<rct_window>> g_window_list;
+static std::array<std::vector<rct_window*>, 256> _windowsByClass;
 rct_window* gWindowAudioExclusive;
 
 uint16_t TextInputDescriptionArgs[4];
@@ -94,6 +98,21 @@ std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_w
     });
 }
 
+void window_index_add(rct_window* w)
+{
+    _windowsByClass[w->classification].push_back(w);
+}
+
+void window_index_remove(rct_window* w)
+{
+    auto& windows = _windowsByClass[w->classification];
+    auto it = std::find(windows.begin(), windows.end(), w);
+    if (it != windows.end())
+    {
+        windows.erase(it);
+    }
+}
+
 void window_visit_each(std::function<void(rct_window*)> func)
 {
     auto windowList = g_window_list;
@@ -228,7 +247,10 @@ void window_close(rct_window* w)
     // The window list may have been modified in the close event
     itWindow = window_get_iterator(w);
     if (itWindow != g_window_list.end())
+    {
+        window_index_remove(w);
         g_window_list.erase(itWindow);
+    }
 }
 
 template<typename _TPred> static void window_close_by_condition(_TPred pred, uint32_t flags = WindowCloseFlags::None)
@@ -289,6 +311,9 @@ template<typename _TPred> static void window_close_by_condition(_TPred pred, uin
  */
 void window_close_by_class(rct_windowclass cls)
 {
+    if (_windowsByClass[cls].empty())
+        return;
+
     window_close_by_condition([&](rct_window* w) -> bool { return w->classification == cls; });
 }
 
@@ -300,6 +325,9 @@ void window_close_by_class(rct_windowclass cls)
  */
 void window_close_by_number(rct_windowclass cls, rct_windownumber number)
 {
+    if (window_find_by_number(cls, number) == nullptr)
+        return;
+
     window_close_by_condition([cls, number](rct_window* w) -> bool { return w->classification == cls && w->number == number; });
 }
 
@@ -311,6 +339,13 @@ void window_close_by_number(rct_windowclass cls, rct_windownumber number)
  */
 rct_window* window_find_by_class(rct_windowclass cls)
 {
+    const auto& windows = _windowsByClass[cls];
+    if (windows.size() <= 1)
+    {
+        return windows.empty() ? nullptr : windows.front();
+    }
+
+    // The first of several windows in the window list is wanted, which the index does not keep track of
     for (auto& w : g_window_list)
     {
         if (w->classification == cls)
@@ -330,6 +365,22 @@ rct_window* window_find_by_class(rct_windowclass cls)
  */
 rct_window* window_find_by_number(rct_windowclass cls, rct_windownumber number)
 {
+    // Window numbers are assigned after the window is created and may change, so only the class is indexed
+    rct_window* result = nullptr;
+    size_t numMatches = 0;
+    for (auto* w : _windowsByClass[cls])
+    {
+        if (w->number == number)
+        {
+            result = w;
+            numMatches++;
+        }
+    }
+    if (numMatches <= 1)
+    {
+        return result;
+    }
+
     for (auto& w : g_window_list)
     {
         if (w->classification == cls && w->number == number)
@@ -454,20 +505,31 @@ rct_widgetindex window_find_widget_from_point(rct_window* w, const ScreenCoordsX
     return widget_index;
 }
 
-/**
- * Invalidates the specified window.
- *  rct2: 0x006EB13A
- *
- * @param window The window to invalidate (esi).
- */
-template<typename _TPred> static void window_invalidate_by_condition(_TPred pred)
+// Invalidations requested by class or number, they are collected until the windows are drawn so that repeated requests
+// for the same windows cost nothing and the window list is only walked once.
+static struct
 {
-    window_visit_each([pred](rct_window* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
+    bool Any;
+    bool All;
+    std::bitset<256> Classes;
+    std::vector<std::pair<rct_windowclass, rct_windownumber>> Windows;
+    // Widgets of all windows of a class are stored with WINDOW_NUMBER_ANY
+    std::vector<std::tuple<rct_windowclass, int32_t, rct_widgetindex>> Widgets;
+} _pendingInvalidations;
+
+static constexpr int32_t WINDOW_NUMBER_ANY = -1;
+
+template<typename T> static void window_queue_invalidation(std::vector<T>& requests, const T& request)
+{
+    if (g_window_list.empty())
+        return;
+
+    auto& pending = _pendingInvalidations;
+    if (std::find(requests.begin(), requests.end(), request) == requests.end())
+    {
+        requests.push_back(request);
+    }
+    pending.Any = true;
 }
 
 /**
@@ -477,7 +539,11 @@ template<typename _TPred> static void window_invalidate_by_condition(_TPred pred
  */
 void window_invalidate_by_class(rct_windowclass cls)
 {
-    window_invalidate_by_condition([cls](rct_window* w) -> bool { return w->classification == cls; });
+    if (g_window_list.empty())
+        return;
+
+    _pendingInvalidations.Classes.set(cls);
+    _pendingInvalidations.Any = true;
 }
 
 /**
@@ -486,8 +552,7 @@ void window_invalidate_by_class(rct_windowclass cls)
  */
 void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
 {
-    window_invalidate_by_condition(
-        [cls, number](rct_window* w) -> bool { return w->classification == cls && w->number == number; });
+    window_queue_invalidation(_pendingInvalidations.Windows, { cls, number });
 }
 
 /**
@@ -495,7 +560,44 @@ void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
  */
 void window_invalidate_all()
 {
-    window_visit_each([](rct_window* w) { w->Invalidate(); });
+    if (g_window_list.empty())
+        return;
+
+    _pendingInvalidations.All = true;
+    _pendingInvalidations.Any = true;
+}
+
+void window_flush_invalidations()
+{
+    auto& pending = _pendingInvalidations;
+    if (!pending.Any)
+        return;
+
+    for (auto& w : g_window_list)
+    {
+        auto cls = w->classification;
+        if (pending.All || pending.Classes[cls]
+            || std::find(pending.Windows.begin(), pending.Windows.end(), std::make_pair(cls, w->number))
+                != pending.Windows.end())
+        {
+            w->Invalidate();
+            continue;
+        }
+
+        for (const auto& [widgetClass, widgetWindowNumber, widgetIndex] : pending.Widgets)
+        {
+            if (widgetClass == cls && (widgetWindowNumber == WINDOW_NUMBER_ANY || widgetWindowNumber == w->number))
+            {
+                widget_invalidate(w.get(), widgetIndex);
+            }
+        }
+    }
+
+    pending.Any = false;
+    pending.All = false;
+    pending.Classes.reset();
+    pending.Windows.clear();
+    pending.Widgets.clear();
 }
 
 /**
@@ -522,27 +624,12 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
                            { w->windowPos + ScreenCoordsXY{ widget->right + 1, widget->bottom + 1 } } });
 }
 
-template<typename _TPred> static void widget_invalidate_by_condition(_TPred pred)
-{
-    window_visit_each([pred](rct_window* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
-}
-
 /**
  * Invalidates the specified widget of all windows that match the specified window class.
  */
 void widget_invalidate_by_class(rct_windowclass cls, rct_widgetindex widgetIndex)
 {
-    window_visit_each([cls, widgetIndex](rct_window* w) {
-        if (w->classification == cls)
-        {
-            widget_invalidate(w, widgetIndex);
-        }
-    });
+    window_queue_invalidation(_pendingInvalidations.Widgets, { cls, WINDOW_NUMBER_ANY, widgetIndex });
 }
 
 /**
@@ -551,12 +638,7 @@ void widget_invalidate_by_class(rct_windowclass cls, rct_widgetindex widgetIndex
  */
 void widget_invalidate_by_number(rct_windowclass cls, rct_windownumber number, rct_widgetindex widgetIndex)
 {
-    window_visit_each([cls, number, widgetIndex](rct_window* w) {
-        if (w->classification == cls && w->number == number)
-        {
-            widget_invalidate(w, widgetIndex);
-        }
-    });
+    window_queue_invalidation(_pendingInvalidations.Widgets, { cls, static_cast<int32_t>(number), widgetIndex });
 }
 
 /**
@@ -2031,6 +2113,37 @@ void window_draw_all(rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t
     });
 }
 
+/**
+ * Returns the main window if it is the only window in the given region and the region lies within its viewport.
+ * Drawing such a region only renders the viewport, which neither depends on nor affects any other window.
+ */
+rct_window* window_get_main_if_only_window_in(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    rct_window* mainWindow = nullptr;
+    for (auto& w : g_window_list)
+    {
+        if (right <= w->windowPos.x || bottom <= w->windowPos.y)
+            continue;
+        if (left >= w->windowPos.x + w->width || top >= w->windowPos.y + w->height)
+            continue;
+        if (w->classification != WC_MAIN_WINDOW || mainWindow != nullptr)
+            return nullptr;
+        mainWindow = w.get();
+    }
+
+    if (mainWindow == nullptr || (mainWindow->flags & WF_TRANSPARENT) || !window_is_visible(mainWindow))
+        return nullptr;
+
+    auto viewport = mainWindow->viewport;
+    if (viewport == nullptr)
+        return nullptr;
+    if (left < viewport->pos.x || top < viewport->pos.y || right > viewport->pos.x + viewport->width
+        || bottom > viewport->pos.y + viewport->height)
+        return nullptr;
+
+    return mainWindow;
+}
+
 rct_viewport* window_get_previous_viewport(rct_viewport* current)
 {
     bool foundPrevious = (current == nullptr);
@@ -2071,7 +2184,7 @@ void window_init_all()
 
 void window_follow_sprite(rct_window* w, size_t spriteIndex)
 {
-    if (spriteIndex < MAX_SPRITES || spriteIndex == SPRITE_INDEX_NULL)
+    if (spriteIndex < GetEntityCapacity() || spriteIndex == SPRITE_INDEX_NULL)
     {
         w->viewport_smart_follow_sprite = static_cast<uint16_t>(spriteIndex);
     }
@@ -99,3 +99,8 @@ struct rct_window
 
 // rct2: 0x01420078
 extern std::list<std::shared_ptr<rct_window>> g_window_list;
+
+// The open windows of each class, kept up to date as windows are created and closed so that looking up a window does
+// not have to go through the whole window list.
+void window_index_add(rct_window* w);
+void window_index_remove(rct_window* w);
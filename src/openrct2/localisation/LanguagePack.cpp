@@ -10,16 +10,23 @@
 #include "LanguagePack.h"
 
 #include "../common.h"
+#include "../core/File.h"
 #include "../core/FileStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Memory.hpp"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
 #include "../core/RTL.h"
 #include "../core/String.hpp"
 #include "../core/StringBuilder.hpp"
 #include "../core/StringReader.hpp"
 #include "Language.h"
 #include "Localisation.h"
+#include "zlib.h"
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -28,6 +35,11 @@ constexpr uint64_t MAX_LANGUAGE_SIZE = 64 * 1024 * 1024;
 constexpr uint64_t MAX_OBJECT_OVERRIDES = 4096;
 constexpr uint64_t MAX_SCENARIO_OVERRIDES = 4096;
 
+constexpr uint32_t LANGUAGE_CACHE_MAGIC = 0x43474E4C; // LNGC
+// Increase whenever the format changes, or the way language files are parsed changes what they produce
+constexpr uint16_t LANGUAGE_CACHE_VERSION = 1;
+constexpr uint32_t LANGUAGE_CACHE_NO_STRING = 0xFFFFFFFF;
+
 constexpr rct_string_id ObjectOverrideBase = 0x6000;
 constexpr int32_t ObjectOverrideMaxStringCount = 3;
 
@@ -50,34 +62,54 @@ class LanguagePack final : public ILanguagePack
 {
 private:
     uint16_t const _id;
-    std::vector<std::string> _strings;
+    // Point into _stringData or the mapped cache, nullptr for strings that are not defined
+    std::vector<const utf8*> _strings;
+    // Every string of the pack, null terminated one after another
+    std::vector<utf8> _stringData;
+    // Only set when the strings were read from a mapped language cache
+    std::unique_ptr<OpenRCT2::IStream> _cacheStream;
+    // Strings changed by SetString, a deque so they keep their address
+    std::deque<std::string> _changedStrings;
     std::vector<ObjectOverride> _objectOverrides;
     std::vector<ScenarioOverride> _scenarioOverrides;
 
     ///////////////////////////////////////////////////////////////////////////
     // Parsing work data
     ///////////////////////////////////////////////////////////////////////////
+    std::vector<uint32_t> _stringOffsets;
     std::string _currentGroup;
     ObjectOverride* _currentObjectOverride = nullptr;
     ScenarioOverride* _currentScenarioOverride = nullptr;
 
 public:
-    static LanguagePack* FromFile(uint16_t id, const utf8* path)
+    static LanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
     {
         Guard::ArgumentNotNull(path);
 
         // Load file directly into memory
         utf8* fileData = nullptr;
+        uint64_t fileLength = 0;
+        uint64_t fileModified = 0;
         try
         {
             OpenRCT2::FileStream fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
 
-            size_t fileLength = static_cast<size_t>(fs.GetLength());
+            fileLength = fs.GetLength();
             if (fileLength > MAX_LANGUAGE_SIZE)
             {
                 throw IOException("Language file too large.");
             }
 
+            if (!cachePath.empty())
+            {
+                fileModified = File::GetLastModified(path);
+                auto cached = FromCache(id, cachePath, fileLength, fileModified);
+                if (cached != nullptr)
+                {
+                    return cached;
+                }
+            }
+
             fileData = Memory::Allocate<utf8>(fileLength + 1);
             fs.Read(fileData, fileLength);
             fileData[fileLength] = '\0';
@@ -93,6 +125,10 @@ public:
         LanguagePack* result = FromText(id, fileData);
 
         Memory::Free(fileData);
+        if (!cachePath.empty())
+        {
+            result->SaveCache(cachePath, fileLength, fileModified);
+        }
         return result;
     }
 
@@ -112,7 +148,15 @@ public:
             ParseLine(&reader);
         }
 
+        // The string data has stopped growing, so the strings can point into it now
+        _strings.resize(_stringOffsets.size());
+        for (size_t i = 0; i < _stringOffsets.size(); i++)
+        {
+            _strings[i] = _stringOffsets[i] != LANGUAGE_CACHE_NO_STRING ? _stringData.data() + _stringOffsets[i] : nullptr;
+        }
+
         // Clean up the parsing work data
+        _stringOffsets = std::vector<uint32_t>();
         _currentGroup = std::string();
         _currentObjectOverride = nullptr;
         _currentScenarioOverride = nullptr;
@@ -130,17 +174,17 @@ public:
 
     void RemoveString(rct_string_id stringId) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_strings.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = std::string();
+            _strings[stringId] = nullptr;
         }
     }
 
     void SetString(rct_string_id stringId, const std::string& str) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_strings.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = str;
+            _strings[stringId] = str.empty() ? nullptr : _changedStrings.emplace_back(str).c_str();
         }
     }
 
@@ -180,9 +224,9 @@ public:
         }
         else
         {
-            if ((_strings.size() > static_cast<size_t>(stringId)) && !_strings[stringId].empty())
+            if (_strings.size() > static_cast<size_t>(stringId))
             {
-                return _strings[stringId].c_str();
+                return _strings[stringId];
             }
             else
             {
@@ -235,6 +279,185 @@ public:
     }
 
 private:
+    explicit LanguagePack(uint16_t id)
+        : _id(id)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Cache
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Parsing a language file has to decode every codepoint and look up every token, so the result is written to the cache
+    // directory. The cache holds the string offsets followed by all the strings, it is mapped into memory when loaded and the
+    // strings are used in place. It is rewritten whenever the length or modification time of the language file changes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static uint32_t CalculateChecksum(const void* data, size_t length)
+    {
+        return static_cast<uint32_t>(crc32(0, static_cast<const Bytef*>(data), static_cast<uInt>(length)));
+    }
+
+    static LanguagePack* FromCache(uint16_t id, const std::string& cachePath, uint64_t sourceLength, uint64_t sourceModified)
+    {
+        if (!File::Exists(cachePath))
+        {
+            return nullptr;
+        }
+        try
+        {
+            auto languagePack = std::unique_ptr<LanguagePack>(new LanguagePack(id));
+            if (languagePack->ReadCache(OpenRCT2::OpenFileForReading(cachePath), sourceLength, sourceModified))
+            {
+                return languagePack.release();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to read language cache '%s': %s", cachePath.c_str(), e.what());
+        }
+        return nullptr;
+    }
+
+    static std::string ReadCacheString(OpenRCT2::IStream& stream)
+    {
+        std::string result(stream.ReadValue<uint32_t>(), '\0');
+        stream.Read(result.data(), result.size());
+        return result;
+    }
+
+    static void WriteCacheString(OpenRCT2::IStream& stream, const std::string& s)
+    {
+        stream.WriteValue(static_cast<uint32_t>(s.size()));
+        stream.Write(s.data(), s.size());
+    }
+
+    bool ReadCache(std::unique_ptr<OpenRCT2::IStream> file, uint64_t sourceLength, uint64_t sourceModified)
+    {
+        auto length = static_cast<size_t>(file->GetLength());
+        const auto* data = static_cast<const utf8*>(file->GetData());
+        if (data != nullptr)
+        {
+            _cacheStream = std::move(file);
+        }
+        else
+        {
+            // The file could not be mapped, so keep a copy of it instead
+            _stringData.resize(length);
+            file->Read(_stringData.data(), length);
+            data = _stringData.data();
+        }
+
+        if (length < sizeof(uint32_t))
+        {
+            return false;
+        }
+        length -= sizeof(uint32_t);
+        uint32_t checksum;
+        std::memcpy(&checksum, data + length, sizeof(checksum));
+        if (CalculateChecksum(data, length) != checksum)
+        {
+            return false;
+        }
+
+        auto stream = OpenRCT2::MemoryStream(data, length);
+        if (stream.ReadValue<uint32_t>() != LANGUAGE_CACHE_MAGIC || stream.ReadValue<uint16_t>() != LANGUAGE_CACHE_VERSION
+            || stream.ReadValue<uint64_t>() != sourceLength || stream.ReadValue<uint64_t>() != sourceModified)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> offsets(stream.ReadValue<uint32_t>());
+        for (auto& offset : offsets)
+        {
+            offset = stream.ReadValue<uint32_t>();
+        }
+        auto stringDataLength = stream.ReadValue<uint32_t>();
+        auto stringDataPosition = static_cast<size_t>(stream.GetPosition());
+        if (stringDataLength > length - stringDataPosition
+            || (stringDataLength != 0 && data[stringDataPosition + stringDataLength - 1] != '\0'))
+        {
+            return false;
+        }
+        const utf8* stringData = data + stringDataPosition;
+        _strings.resize(offsets.size());
+        for (size_t i = 0; i < offsets.size(); i++)
+        {
+            if (offsets[i] != LANGUAGE_CACHE_NO_STRING && offsets[i] >= stringDataLength)
+            {
+                return false;
+            }
+            _strings[i] = offsets[i] != LANGUAGE_CACHE_NO_STRING ? stringData + offsets[i] : nullptr;
+        }
+        stream.SetPosition(stringDataPosition + stringDataLength);
+
+        _objectOverrides.resize(std::min<uint64_t>(stream.ReadValue<uint32_t>(), MAX_OBJECT_OVERRIDES));
+        for (auto& objectOverride : _objectOverrides)
+        {
+            stream.Read(objectOverride.name, sizeof(objectOverride.name));
+            for (auto& s : objectOverride.strings)
+            {
+                s = ReadCacheString(stream);
+            }
+        }
+        _scenarioOverrides.resize(std::min<uint64_t>(stream.ReadValue<uint32_t>(), MAX_SCENARIO_OVERRIDES));
+        for (auto& scenarioOverride : _scenarioOverrides)
+        {
+            scenarioOverride.filename = ReadCacheString(stream);
+            for (auto& s : scenarioOverride.strings)
+            {
+                s = ReadCacheString(stream);
+            }
+        }
+        return true;
+    }
+
+    void SaveCache(const std::string& cachePath, uint64_t sourceLength, uint64_t sourceModified) const
+    {
+        OpenRCT2::MemoryStream stream;
+        stream.WriteValue(LANGUAGE_CACHE_MAGIC);
+        stream.WriteValue(LANGUAGE_CACHE_VERSION);
+        stream.WriteValue(sourceLength);
+        stream.WriteValue(sourceModified);
+        stream.WriteValue(static_cast<uint32_t>(_strings.size()));
+        for (const auto* s : _strings)
+        {
+            stream.WriteValue(s != nullptr ? static_cast<uint32_t>(s - _stringData.data()) : LANGUAGE_CACHE_NO_STRING);
+        }
+        stream.WriteValue(static_cast<uint32_t>(_stringData.size()));
+        stream.Write(_stringData.data(), _stringData.size());
+        stream.WriteValue(static_cast<uint32_t>(_objectOverrides.size()));
+        for (const auto& objectOverride : _objectOverrides)
+        {
+            stream.Write(objectOverride.name, sizeof(objectOverride.name));
+            for (const auto& s : objectOverride.strings)
+            {
+                WriteCacheString(stream, s);
+            }
+        }
+        stream.WriteValue(static_cast<uint32_t>(_scenarioOverrides.size()));
+        for (const auto& scenarioOverride : _scenarioOverrides)
+        {
+            WriteCacheString(stream, scenarioOverride.filename);
+            for (const auto& s : scenarioOverride.strings)
+            {
+                WriteCacheString(stream, s);
+            }
+        }
+        stream.WriteValue(CalculateChecksum(stream.GetData(), static_cast<size_t>(stream.GetLength())));
+
+        try
+        {
+            // Delete the old cache first rather than writing over it, another instance of the game may have it mapped
+            Path::CreateDirectory(Path::GetDirectory(cachePath));
+            File::Delete(cachePath);
+            File::WriteAllBytes(cachePath, stream.GetData(), static_cast<size_t>(stream.GetLength()));
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to write language cache '%s': %s", cachePath.c_str(), e.what());
+        }
+    }
+
     ObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
     {
         for (auto& oo : _objectOverrides)
@@ -581,11 +804,19 @@ private:
         if (_currentGroup.empty())
         {
             // Make sure the list is big enough to contain this string id
-            if (static_cast<size_t>(stringId) >= _strings.size())
+            if (static_cast<size_t>(stringId) >= _stringOffsets.size())
+            {
+                _stringOffsets.resize(stringId + 1, LANGUAGE_CACHE_NO_STRING);
+            }
+            if (s.empty())
+            {
+                _stringOffsets[stringId] = LANGUAGE_CACHE_NO_STRING;
+            }
+            else
             {
-                _strings.resize(stringId + 1);
+                _stringOffsets[stringId] = static_cast<uint32_t>(_stringData.size());
+                _stringData.insert(_stringData.end(), s.c_str(), s.c_str() + s.size() + 1);
             }
-            _strings[stringId] = s;
         }
         else
         {
@@ -644,9 +875,9 @@ private:
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path)
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
     {
-        auto languagePack = LanguagePack::FromFile(id, path);
+        auto languagePack = LanguagePack::FromFile(id, path, cachePath);
         return languagePack;
     }
 
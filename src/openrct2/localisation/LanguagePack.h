@@ -30,6 +30,9 @@ struct ILanguagePack
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path);
+    /**
+     * Opens the language file. When a cache path is given, the parsed language is read from and written to it.
+     */
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath = {});
     ILanguagePack* FromText(uint16_t id, const utf8* text);
 } // namespace LanguagePackFactory
@@ -23,11 +23,13 @@
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../core/String.hpp"
+#include "../drawing/Font.h"
 #include "../management/Marketing.h"
 #include "../ride/Ride.h"
 #include "../util/Util.h"
 #include "Date.h"
 #include "Localisation.h"
+#include "LocalisationService.h"
 
 #include <algorithm>
 #include <cmath>
@@ -780,6 +782,49 @@ static void format_comma_separated_fixed_2dp(char** dest, size_t* size, int64_t
     }
 }
 
+/**
+ * Gets the symbol to show for the currency, the unicode symbol is only used if the current font can draw it. Checking the
+ * font is slow, so the choice is kept until the currency or font changes.
+ */
+static void format_get_currency_symbol(const currency_descriptor* currencyDesc, const utf8** symbol, CurrencyAffix* affix)
+{
+    struct CurrencySymbolCache
+    {
+        const currency_descriptor* Currency = nullptr;
+        bool UseTrueTypeFont{};
+        const void* Font{};
+        bool UseUnicode{};
+    };
+    static CurrencySymbolCache cache;
+
+    bool useTrueTypeFont = LocalisationService_UseTrueTypeFont();
+    const void* font = nullptr;
+#ifndef NO_TTF
+    if (useTrueTypeFont && gCurrentTTFFontSet != nullptr)
+    {
+        font = gCurrentTTFFontSet->size[FONT_SIZE_MEDIUM].font;
+    }
+#endif
+    if (cache.Currency != currencyDesc || cache.UseTrueTypeFont != useTrueTypeFont || cache.Font != font)
+    {
+        cache.Currency = currencyDesc;
+        cache.UseTrueTypeFont = useTrueTypeFont;
+        cache.Font = font;
+        cache.UseUnicode = font_supports_string(currencyDesc->symbol_unicode, FONT_SIZE_MEDIUM);
+    }
+
+    if (cache.UseUnicode)
+    {
+        *symbol = currencyDesc->symbol_unicode;
+        *affix = currencyDesc->affix_unicode;
+    }
+    else
+    {
+        *symbol = currencyDesc->symbol_ascii;
+        *affix = currencyDesc->affix_ascii;
+    }
+}
+
 static void format_currency(char** dest, size_t* size, int64_t value)
 {
     if ((*size) == 0)
@@ -800,13 +845,9 @@ static void format_currency(char** dest, size_t* size, int64_t value)
     value = (value + 99) / 100;
 
     // Currency symbol
-    const utf8* symbol = currencyDesc->symbol_unicode;
-    CurrencyAffix affix = currencyDesc->affix_unicode;
-    if (!font_supports_string(symbol, FONT_SIZE_MEDIUM))
-    {
-        symbol = currencyDesc->symbol_ascii;
-        affix = currencyDesc->affix_ascii;
-    }
+    const utf8* symbol;
+    CurrencyAffix affix;
+    format_get_currency_symbol(currencyDesc, &symbol, &affix);
 
     // Prefix
     if (affix == CurrencyAffix::Prefix)
@@ -841,13 +882,9 @@ static void format_currency_2dp(char** dest, size_t* size, int64_t value)
     }
 
     // Currency symbol
-    const utf8* symbol = currencyDesc->symbol_unicode;
-    CurrencyAffix affix = currencyDesc->affix_unicode;
-    if (!font_supports_string(symbol, FONT_SIZE_MEDIUM))
-    {
-        symbol = currencyDesc->symbol_ascii;
-        affix = currencyDesc->affix_ascii;
-    }
+    const utf8* symbol;
+    CurrencyAffix affix;
+    format_get_currency_symbol(currencyDesc, &symbol, &affix);
 
     // Prefix
     if (affix == CurrencyAffix::Prefix)
@@ -1163,6 +1200,22 @@ static void format_string_part_from_raw(utf8** dest, size_t* size, const utf8* s
 
     while (*size > 1)
     {
+        // Copy runs of plain characters in one go
+        if (*src >= ' ' && *src <= 'z')
+        {
+            const utf8* runEnd = src + 1;
+            while (*runEnd >= ' ' && *runEnd <= 'z')
+            {
+                runEnd++;
+            }
+            size_t runLength = std::min<size_t>(runEnd - src, *size - 1);
+            std::memcpy(*dest, src, runLength);
+            *dest += runLength;
+            *size -= runLength;
+            src += runLength;
+            continue;
+        }
+
         uint32_t code = utf8_get_next(src, &src);
         if (code < ' ')
         {
@@ -1268,7 +1321,16 @@ static void format_string_part(utf8** dest, size_t* size, rct_string_id format,
 
 std::string format_string(rct_string_id format, const void* args)
 {
-    std::string buffer(256, 0);
+    // Most strings fit on the stack, so only the result is allocated
+    char stackBuffer[512];
+    format_string(stackBuffer, sizeof(stackBuffer), format, args);
+    size_t stackLength = std::strlen(stackBuffer);
+    if (stackLength < sizeof(stackBuffer) - 1)
+    {
+        return std::string(stackBuffer, stackLength);
+    }
+
+    std::string buffer(sizeof(stackBuffer) * 2, 0);
     size_t len{};
     for (;;)
     {
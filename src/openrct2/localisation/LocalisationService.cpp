@@ -34,11 +34,16 @@ LocalisationService::LocalisationService(const std::shared_ptr<IPlatformEnvironm
     {
         _availableObjectStringIds.push(stringId);
     }
+    _objectStrings.resize(MAX_OBJECT_CACHED_STRINGS + 1, STRING_POOL_ID_EMPTY);
 }
 
 // Define implementation here to avoid including LanguagePack.h in header
 LocalisationService::~LocalisationService()
 {
+    for (auto text : _objectStrings)
+    {
+        StringPool::Release(text);
+    }
 }
 
 const char* LocalisationService::GetString(rct_string_id id) const
@@ -48,6 +53,12 @@ const char* LocalisationService::GetString(rct_string_id id) const
     {
         result = "";
     }
+    else if (
+        id >= NONSTEX_BASE_STRING_ID && static_cast<size_t>(id - NONSTEX_BASE_STRING_ID) < _objectStrings.size()
+        && _objectStrings[id - NONSTEX_BASE_STRING_ID] != STRING_POOL_ID_EMPTY)
+    {
+        result = StringPool::Get(_objectStrings[id - NONSTEX_BASE_STRING_ID]).c_str();
+    }
     else if (id != STR_NONE)
     {
         if (_languageCurrent != nullptr)
@@ -74,6 +85,12 @@ std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
     return languagePath;
 }
 
+std::string LocalisationService::GetLanguageCachePath(uint32_t languageId) const
+{
+    auto locale = std::string(LanguagesDescriptors[languageId].locale);
+    return Path::Combine(_env->GetDirectoryPath(DIRBASE::CACHE), "language", locale + ".langcache");
+}
+
 void LocalisationService::OpenLanguage(int32_t id)
 {
     CloseLanguages();
@@ -87,11 +104,12 @@ void LocalisationService::OpenLanguage(int32_t id)
     {
         filename = GetLanguagePath(LANGUAGE_ENGLISH_UK);
         _languageFallback = std::unique_ptr<ILanguagePack>(
-            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str()));
+            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str(), GetLanguageCachePath(LANGUAGE_ENGLISH_UK)));
     }
 
     filename = GetLanguagePath(id);
-    _languageCurrent = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromFile(id, filename.c_str()));
+    _languageCurrent = std::unique_ptr<ILanguagePack>(
+        LanguagePackFactory::FromFile(id, filename.c_str(), GetLanguageCachePath(id)));
     if (_languageCurrent != nullptr)
     {
         _currentLanguage = id;
@@ -132,7 +150,7 @@ rct_string_id LocalisationService::AllocateObjectString(const std::string& targe
 {
     auto stringId = _availableObjectStringIds.top();
     _availableObjectStringIds.pop();
-    _languageCurrent->SetString(stringId, target);
+    _objectStrings[stringId - NONSTEX_BASE_STRING_ID] = StringPool::Intern(target);
     return stringId;
 }
 
@@ -140,10 +158,9 @@ void LocalisationService::FreeObjectString(rct_string_id stringId)
 {
     if (stringId != STR_EMPTY)
     {
-        if (_languageCurrent != nullptr)
-        {
-            _languageCurrent->RemoveString(stringId);
-        }
+        auto& text = _objectStrings[stringId - NONSTEX_BASE_STRING_ID];
+        StringPool::Release(text);
+        text = STRING_POOL_ID_EMPTY;
         _availableObjectStringIds.push(stringId);
     }
 }
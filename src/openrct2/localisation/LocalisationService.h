@@ -10,12 +10,14 @@
 #pragma once
 
 #include "../common.h"
+#include "StringPool.h"
 
 #include <memory>
 #include <stack>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <vector>
 
 struct ILanguagePack;
 struct IObjectManager;
@@ -36,6 +38,8 @@ namespace OpenRCT2::Localisation
         std::unique_ptr<ILanguagePack> _languageFallback;
         std::unique_ptr<ILanguagePack> _languageCurrent;
         std::stack<rct_string_id> _availableObjectStringIds;
+        // The text of allocated object strings in the string pool, by string id from the first object string
+        std::vector<StringPoolId> _objectStrings;
 
     public:
         int32_t GetCurrentLanguage() const
@@ -59,6 +63,7 @@ namespace OpenRCT2::Localisation
             const std::string& scenarioFilename) const;
         rct_string_id GetObjectOverrideStringId(const std::string_view& legacyIdentifier, uint8_t index) const;
         std::string GetLanguagePath(uint32_t languageId) const;
+        std::string GetLanguageCachePath(uint32_t languageId) const;
 
         void OpenLanguage(int32_t id);
         void CloseLanguages();
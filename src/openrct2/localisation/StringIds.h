@@ -3899,6 +3899,11 @@ enum
     STR_CHEAT_OBJECTIVE_GROUP = 6394,
     STR_CHEAT_MAINTENANCE_GROUP = 6395,
 
+    STR_CHEAT_PATHFINDING_BUDGET = 6396,
+    STR_CHEAT_RIDE_RATINGS_PER_TICK = 6397,
+
+    STR_SCENARIO_LIST_LOADING = 6398,
+
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     /* MAX_STR_COUNT = 32768 */ // MAX_STR_COUNT - upper limit for number of strings, not the current count strings
 };
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "StringPool.h"
+
+#include "../core/Guard.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct StringPoolSlot
+    {
+        std::string Text;
+        uint32_t RefCount = 0;
+    };
+
+    struct StringPoolData
+    {
+        std::shared_mutex Mutex;
+        // A deque so slots keep their address as the pool grows, the index refers to their text
+        std::deque<StringPoolSlot> Slots = std::deque<StringPoolSlot>(1);
+        std::unordered_map<std::string_view, StringPoolId> Index;
+        std::vector<StringPoolId> FreeIds;
+    };
+} // namespace
+
+static StringPoolData& GetData()
+{
+    static StringPoolData data;
+    return data;
+}
+
+namespace StringPool
+{
+    StringPoolId Intern(std::string_view s)
+    {
+        if (s.empty())
+        {
+            return STRING_POOL_ID_EMPTY;
+        }
+
+        auto& data = GetData();
+        std::unique_lock<std::shared_mutex> lock(data.Mutex);
+        auto it = data.Index.find(s);
+        if (it != data.Index.end())
+        {
+            data.Slots[it->second].RefCount++;
+            return it->second;
+        }
+
+        StringPoolId id;
+        if (!data.FreeIds.empty())
+        {
+            id = data.FreeIds.back();
+            data.FreeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<StringPoolId>(data.Slots.size());
+            data.Slots.emplace_back();
+        }
+        auto& slot = data.Slots[id];
+        slot.Text = s;
+        slot.RefCount = 1;
+        data.Index.emplace(slot.Text, id);
+        return id;
+    }
+
+    void AddRef(StringPoolId id)
+    {
+        if (id == STRING_POOL_ID_EMPTY)
+        {
+            return;
+        }
+
+        auto& data = GetData();
+        std::unique_lock<std::shared_mutex> lock(data.Mutex);
+        Guard::Assert(id < data.Slots.size() && data.Slots[id].RefCount != 0, "Invalid string pool id");
+        data.Slots[id].RefCount++;
+    }
+
+    void Release(StringPoolId id)
+    {
+        if (id == STRING_POOL_ID_EMPTY)
+        {
+            return;
+        }
+
+        auto& data = GetData();
+        std::unique_lock<std::shared_mutex> lock(data.Mutex);
+        Guard::Assert(id < data.Slots.size() && data.Slots[id].RefCount != 0, "Invalid string pool id");
+        auto& slot = data.Slots[id];
+        if (--slot.RefCount == 0)
+        {
+            data.Index.erase(slot.Text);
+            slot.Text = std::string();
+            data.FreeIds.push_back(id);
+        }
+    }
+
+    const std::string& Get(StringPoolId id)
+    {
+        auto& data = GetData();
+        std::shared_lock<std::shared_mutex> lock(data.Mutex);
+        Guard::Assert(id < data.Slots.size(), "Invalid string pool id");
+        return data.Slots[id].Text;
+    }
+
+    size_t GetCount()
+    {
+        auto& data = GetData();
+        std::shared_lock<std::shared_mutex> lock(data.Mutex);
+        return data.Index.size();
+    }
+} // namespace StringPool
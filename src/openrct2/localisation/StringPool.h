@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+#include <string_view>
+
+using StringPoolId = uint32_t;
+
+// The empty string, which is always in the pool and not reference counted
+constexpr StringPoolId STRING_POOL_ID_EMPTY = 0;
+
+/**
+ * A process wide pool of reference counted, immutable strings. Identical strings are only stored once and are referred to
+ * by a compact id, the storage of a string stays at the same address until its last reference is released.
+ */
+namespace StringPool
+{
+    /**
+     * Returns the id of the string, adding it to the pool if it is not there yet. Each call adds a reference which has
+     * to be given back with Release.
+     */
+    StringPoolId Intern(std::string_view s);
+    void AddRef(StringPoolId id);
+    void Release(StringPoolId id);
+
+    const std::string& Get(StringPoolId id);
+    size_t GetCount();
+} // namespace StringPool
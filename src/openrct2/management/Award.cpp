@@ -9,6 +9,8 @@
 
 #include "Award.h"
 
+#include "../Context.h"
+#include "../GameState.h"
 #include "../config/Config.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
@@ -21,6 +23,8 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <array>
+#include <iterator>
 
 constexpr uint8_t NEGATIVE = 0;
 constexpr uint8_t POSITIVE = 1;
@@ -74,97 +78,168 @@ bool award_is_positive(int32_t type)
 
 #pragma region Award checks
 
-/** More than 1/16 of the total guests must be thinking untidy thoughts. */
-static bool award_is_deserved_most_untidy(int32_t activeAwardTypes)
+/**
+ * Everything the award checks look at, gathered in one pass over the guests, staff and rides.
+ */
+struct AwardStats
 {
-    if (activeAwardTypes & EnumToFlag(ParkAward::MostBeautiful))
-        return false;
-    if (activeAwardTypes & EnumToFlag(ParkAward::BestStaff))
-        return false;
-    if (activeAwardTypes & EnumToFlag(ParkAward::MostTidy))
-        return false;
-
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
+    // Guests in the park whose most recent thought is still fresh, by thought type, as counted by the park
+    std::array<uint32_t, 256> FreshThoughts{};
+    uint32_t GuestsInPark{};
+    uint32_t Guests{};
+    uint32_t Staff{};
+    uint32_t StaffTypeFlags{};
+
+    // Open rides that have not crashed, by category
+    uint32_t RollerCoasters{};
+    uint32_t WaterRides{};
+    uint32_t GentleRides{};
+    uint32_t CustomDesignedRides{};
+
+    // Open stalls
+    uint32_t FoodShops{};
+    uint32_t UniqueFoodShops{};
+    uint32_t Restrooms{};
+
+    bool AnyRideCrashed{};
+    uint32_t RatedRides{};
+    uint32_t DisappointingRides{};
+    uint32_t TrackedRides{};
+    uint32_t ColourfulRides{};
+
+    uint32_t GetUntidyThoughts() const
     {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-        {
-            negativeCount++;
-        }
+        return FreshThoughts[PEEP_THOUGHT_TYPE_BAD_LITTER] + FreshThoughts[PEEP_THOUGHT_TYPE_PATH_DISGUSTING]
+            + FreshThoughts[PEEP_THOUGHT_TYPE_VANDALISM];
     }
+};
 
-    return (negativeCount > gNumGuestsInPark / 16);
-}
-
-/** More than 1/64 of the total guests must be thinking tidy thoughts and less than 6 guests thinking untidy thoughts. */
-static bool award_is_deserved_most_tidy(int32_t activeAwardTypes)
+static void award_stats_add_peeps(AwardStats& stats)
 {
-    if (activeAwardTypes & EnumToFlag(ParkAward::MostUntidy))
-        return false;
-    if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
-        return false;
-
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
+    for (auto peep : EntityList<Peep>(EntityListId::Peep))
     {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_VERY_CLEAN)
-            positiveCount++;
-
-        if (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
+        if (peep->AssignedPeepType == PeepType::Staff)
         {
-            negativeCount++;
+            stats.Staff++;
+            stats.StaffTypeFlags |= (1 << static_cast<uint8_t>(peep->AssignedStaffType));
+            continue;
         }
+
+        stats.Guests++;
+        if (!peep->OutsideOfPark)
+            stats.GuestsInPark++;
     }
 
-    return (negativeCount <= 5 && positiveCount > gNumGuestsInPark / 64);
+    const auto& park = OpenRCT2::GetContext()->GetGameState()->GetPark();
+    for (size_t i = 0; i < stats.FreshThoughts.size(); i++)
+    {
+        stats.FreshThoughts[i] = park.GetGuestThoughtCount(static_cast<uint8_t>(i));
+    }
 }
 
-/** At least 6 open roller coasters. */
-static bool award_is_deserved_best_rollercoasters([[maybe_unused]] int32_t activeAwardTypes)
+static void award_stats_add_rides(AwardStats& stats)
 {
-    auto rollerCoasters = 0;
+    static constexpr const colour_t dazzling_ride_colours[] = { COLOUR_BRIGHT_PURPLE, COLOUR_BRIGHT_GREEN, COLOUR_LIGHT_ORANGE,
+                                                                COLOUR_BRIGHT_PINK };
+
+    uint64_t foodShopTypes = 0;
     for (const auto& ride : GetRideManager())
     {
         auto rideEntry = ride.GetRideEntry();
-        if (rideEntry == nullptr)
+        bool isOpen = ride.status == RIDE_STATUS_OPEN;
+        bool isRunning = isOpen && !(ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED);
+        if (rideEntry != nullptr && isRunning)
         {
-            continue;
+            if (ride_entry_has_category(rideEntry, RIDE_CATEGORY_ROLLERCOASTER))
+                stats.RollerCoasters++;
+            if (ride_entry_has_category(rideEntry, RIDE_CATEGORY_WATER))
+                stats.WaterRides++;
+            if (ride_entry_has_category(rideEntry, RIDE_CATEGORY_GENTLE))
+                stats.GentleRides++;
         }
 
-        if (ride.status != RIDE_STATUS_OPEN || (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
+        if (isOpen && ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_SELLS_FOOD))
         {
-            continue;
+            stats.FoodShops++;
+            if (rideEntry != nullptr && !(foodShopTypes & (1ULL << rideEntry->shop_item[0])))
+            {
+                foodShopTypes |= (1ULL << rideEntry->shop_item[0]);
+                stats.UniqueFoodShops++;
+            }
         }
+        if (isOpen && ride.type == RIDE_TYPE_TOILETS)
+            stats.Restrooms++;
 
-        if (!ride_entry_has_category(rideEntry, RIDE_CATEGORY_ROLLERCOASTER))
+        if (ride.last_crash_type != RIDE_CRASH_TYPE_NONE)
+            stats.AnyRideCrashed = true;
+
+        if (ride_has_ratings(&ride) && ride.popularity != 0xFF)
         {
-            continue;
+            stats.RatedRides++;
+            if (ride.popularity <= 6)
+                stats.DisappointingRides++;
         }
 
-        rollerCoasters++;
+        if (ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_HAS_TRACK))
+        {
+            if (isRunning && !(ride.lifecycle_flags & RIDE_LIFECYCLE_NOT_CUSTOM_DESIGN)
+                && ride.excitement >= RIDE_RATING(5, 50))
+            {
+                stats.CustomDesignedRides++;
+            }
+
+            stats.TrackedRides++;
+            auto mainTrackColour = ride.track_colour[0].main;
+            if (std::find(std::begin(dazzling_ride_colours), std::end(dazzling_ride_colours), mainTrackColour)
+                != std::end(dazzling_ride_colours))
+            {
+                stats.ColourfulRides++;
+            }
+        }
     }
-    return (rollerCoasters >= 6);
+}
+
+static AwardStats award_stats_calculate()
+{
+    AwardStats stats;
+    award_stats_add_peeps(stats);
+    award_stats_add_rides(stats);
+    return stats;
+}
+
+/** More than 1/16 of the total guests must be thinking untidy thoughts. */
+static bool award_is_deserved_most_untidy(int32_t activeAwardTypes, const AwardStats& stats)
+{
+    if (activeAwardTypes & EnumToFlag(ParkAward::MostBeautiful))
+        return false;
+    if (activeAwardTypes & EnumToFlag(ParkAward::BestStaff))
+        return false;
+    if (activeAwardTypes & EnumToFlag(ParkAward::MostTidy))
+        return false;
+
+    return (stats.GetUntidyThoughts() > gNumGuestsInPark / 16);
+}
+
+/** More than 1/64 of the total guests must be thinking tidy thoughts and less than 6 guests thinking untidy thoughts. */
+static bool award_is_deserved_most_tidy(int32_t activeAwardTypes, const AwardStats& stats)
+{
+    if (activeAwardTypes & EnumToFlag(ParkAward::MostUntidy))
+        return false;
+    if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
+        return false;
+
+    auto positiveCount = stats.FreshThoughts[PEEP_THOUGHT_TYPE_VERY_CLEAN];
+    return (stats.GetUntidyThoughts() <= 5 && positiveCount > gNumGuestsInPark / 64);
+}
+
+/** At least 6 open roller coasters. */
+static bool award_is_deserved_best_rollercoasters([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
+{
+    return (stats.RollerCoasters >= 6);
 }
 
 /** Entrance fee is 0.10 less than half of the total ride value. */
-static bool award_is_deserved_best_value(int32_t activeAwardTypes)
+static bool award_is_deserved_best_value(int32_t activeAwardTypes, [[maybe_unused]] const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::WorstValue))
         return false;
@@ -185,40 +260,19 @@ static bool award_is_deserved_best_value(int32_t activeAwardTypes)
 }
 
 /** More than 1/128 of the total guests must be thinking scenic thoughts and fewer than 16 untidy thoughts. */
-static bool award_is_deserved_most_beautiful(int32_t activeAwardTypes)
+static bool award_is_deserved_most_beautiful(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::MostUntidy))
         return false;
     if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    auto list = EntityList<Guest>(EntityListId::Peep);
-    for (auto peep : list)
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness > 5)
-            continue;
-
-        if (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_SCENERY)
-            positiveCount++;
-
-        if (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING
-            || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-        {
-            negativeCount++;
-        }
-    }
-
-    return (negativeCount <= 15 && positiveCount > gNumGuestsInPark / 128);
+    auto positiveCount = stats.FreshThoughts[PEEP_THOUGHT_TYPE_SCENERY];
+    return (stats.GetUntidyThoughts() <= 15 && positiveCount > gNumGuestsInPark / 128);
 }
 
 /** Entrance fee is more than total ride value. */
-static bool award_is_deserved_worst_value(int32_t activeAwardTypes)
+static bool award_is_deserved_worst_value(int32_t activeAwardTypes, [[maybe_unused]] const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::BestValue))
         return false;
@@ -234,334 +288,112 @@ static bool award_is_deserved_worst_value(int32_t activeAwardTypes)
 }
 
 /** No more than 2 people who think the vandalism is bad and no crashes. */
-static bool award_is_deserved_safest([[maybe_unused]] int32_t activeAwardTypes)
+static bool award_is_deserved_safest([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
 {
-    auto peepsWhoDislikeVandalism = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (peep->OutsideOfPark)
-            continue;
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-            peepsWhoDislikeVandalism++;
-    }
-
-    if (peepsWhoDislikeVandalism > 2)
+    if (stats.FreshThoughts[PEEP_THOUGHT_TYPE_VANDALISM] > 2)
         return false;
 
     // Check for rides that have crashed maybe?
-    const auto& rideManager = GetRideManager();
-    if (std::any_of(rideManager.begin(), rideManager.end(), [](const Ride& ride) {
-            return ride.last_crash_type != RIDE_CRASH_TYPE_NONE;
-        }))
-    {
-        return false;
-    }
-
-    return true;
+    return !stats.AnyRideCrashed;
 }
 
 /** All staff types, at least 20 staff, one staff per 32 peeps. */
-static bool award_is_deserved_best_staff(int32_t activeAwardTypes)
+static bool award_is_deserved_best_staff(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::MostUntidy))
         return false;
 
-    auto peepCount = 0;
-    auto staffCount = 0;
-    auto staffTypeFlags = 0;
-    for (auto peep : EntityList<Peep>(EntityListId::Peep))
-    {
-        if (peep->AssignedPeepType == PeepType::Staff)
-        {
-            staffCount++;
-            staffTypeFlags |= (1 << static_cast<uint8_t>(peep->AssignedStaffType));
-        }
-        else
-        {
-            peepCount++;
-        }
-    }
-
-    return ((staffTypeFlags & 0xF) && staffCount >= 20 && staffCount >= peepCount / 32);
+    return ((stats.StaffTypeFlags & 0xF) && stats.Staff >= 20 && stats.Staff >= stats.Guests / 32);
 }
 
 /** At least 7 shops, 4 unique, one shop per 128 guests and no more than 12 hungry guests. */
-static bool award_is_deserved_best_food(int32_t activeAwardTypes)
+static bool award_is_deserved_best_food(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::WorstFood))
         return false;
 
-    uint32_t shops = 0;
-    uint32_t uniqueShops = 0;
-    uint32_t shopTypes = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        if (ride.status != RIDE_STATUS_OPEN)
-            continue;
-        if (!ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_SELLS_FOOD))
-            continue;
-
-        shops++;
-        auto rideEntry = get_ride_entry(ride.subtype);
-        if (rideEntry != nullptr)
-        {
-            if (!(shopTypes & (1ULL << rideEntry->shop_item[0])))
-            {
-                shopTypes |= (1ULL << rideEntry->shop_item[0]);
-                uniqueShops++;
-            }
-        }
-    }
-
-    if (shops < 7 || uniqueShops < 4 || shops < gNumGuestsInPark / 128)
+    if (stats.FoodShops < 7 || stats.UniqueFoodShops < 4 || stats.FoodShops < gNumGuestsInPark / 128)
         return false;
 
-    // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-            hungryPeeps++;
-    }
-    return (hungryPeeps <= 12);
+    return (stats.FreshThoughts[PEEP_THOUGHT_TYPE_HUNGRY] <= 12);
 }
 
 /** No more than 2 unique shops, less than one shop per 256 guests and more than 15 hungry guests. */
-static bool award_is_deserved_worst_food(int32_t activeAwardTypes)
+static bool award_is_deserved_worst_food(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::BestFood))
         return false;
 
-    uint32_t shops = 0;
-    uint32_t uniqueShops = 0;
-    uint32_t shopTypes = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        if (ride.status != RIDE_STATUS_OPEN)
-            continue;
-        if (!ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_SELLS_FOOD))
-            continue;
-
-        shops++;
-        auto rideEntry = ride.GetRideEntry();
-        if (rideEntry != nullptr)
-        {
-            if (!(shopTypes & (1ULL << rideEntry->shop_item[0])))
-            {
-                shopTypes |= (1ULL << rideEntry->shop_item[0]);
-                uniqueShops++;
-            }
-        }
-    }
-
-    if (uniqueShops > 2 || shops > gNumGuestsInPark / 256)
+    if (stats.UniqueFoodShops > 2 || stats.FoodShops > gNumGuestsInPark / 256)
         return false;
 
-    // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-            hungryPeeps++;
-    }
-    return (hungryPeeps > 15);
+    return (stats.FreshThoughts[PEEP_THOUGHT_TYPE_HUNGRY] > 15);
 }
 
 /** At least 4 restrooms, 1 restroom per 128 guests and no more than 16 guests who think they need the restroom. */
-static bool award_is_deserved_best_restrooms([[maybe_unused]] int32_t activeAwardTypes)
+static bool award_is_deserved_best_restrooms([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
 {
-    // Count open restrooms
-    const auto& rideManager = GetRideManager();
-    auto numRestrooms = static_cast<size_t>(std::count_if(rideManager.begin(), rideManager.end(), [](const Ride& ride) {
-        return ride.type == RIDE_TYPE_TOILETS && ride.status == RIDE_STATUS_OPEN;
-    }));
-
     // At least 4 open restrooms
-    if (numRestrooms < 4)
+    if (stats.Restrooms < 4)
         return false;
 
     // At least one open restroom for every 128 guests
-    if (numRestrooms < gNumGuestsInPark / 128U)
+    if (stats.Restrooms < gNumGuestsInPark / 128U)
         return false;
 
-    // Count number of guests who are thinking they need the restroom
-    auto guestsWhoNeedRestroom = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        if (peep->Thoughts[0].freshness <= 5 && peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_TOILET)
-            guestsWhoNeedRestroom++;
-    }
-    return (guestsWhoNeedRestroom <= 16);
+    return (stats.FreshThoughts[PEEP_THOUGHT_TYPE_TOILET] <= 16);
 }
 
 /** More than half of the rides have satisfaction <= 6 and park rating <= 650. */
-static bool award_is_deserved_most_disappointing(int32_t activeAwardTypes)
+static bool award_is_deserved_most_disappointing(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::BestValue))
         return false;
     if (gParkRating > 650)
         return false;
 
-    // Count the number of disappointing rides
-    auto countedRides = 0;
-    auto disappointingRides = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        if (ride_has_ratings(&ride) && ride.popularity != 0xFF)
-        {
-            countedRides++;
-            if (ride.popularity <= 6)
-            {
-                disappointingRides++;
-            }
-        }
-    }
-
     // Half of the rides are disappointing
-    return (disappointingRides >= countedRides / 2);
+    return (stats.DisappointingRides >= stats.RatedRides / 2);
 }
 
 /** At least 6 open water rides. */
-static bool award_is_deserved_best_water_rides([[maybe_unused]] int32_t activeAwardTypes)
+static bool award_is_deserved_best_water_rides([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
 {
-    auto waterRides = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        auto rideEntry = ride.GetRideEntry();
-        if (rideEntry == nullptr)
-        {
-            continue;
-        }
-
-        if (ride.status != RIDE_STATUS_OPEN || (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
-        {
-            continue;
-        }
-
-        if (!ride_entry_has_category(rideEntry, RIDE_CATEGORY_WATER))
-        {
-            continue;
-        }
-
-        waterRides++;
-    }
-
-    return (waterRides >= 6);
+    return (stats.WaterRides >= 6);
 }
 
 /** At least 6 custom designed rides. */
-static bool award_is_deserved_best_custom_designed_rides(int32_t activeAwardTypes)
+static bool award_is_deserved_best_custom_designed_rides(int32_t activeAwardTypes, const AwardStats& stats)
 {
     if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
         return false;
 
-    auto customDesignedRides = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        if (!ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_HAS_TRACK))
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_NOT_CUSTOM_DESIGN)
-            continue;
-        if (ride.excitement < RIDE_RATING(5, 50))
-            continue;
-        if (ride.status != RIDE_STATUS_OPEN || (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
-            continue;
-
-        customDesignedRides++;
-    }
-
-    return (customDesignedRides >= 6);
+    return (stats.CustomDesignedRides >= 6);
 }
 
-static bool award_is_deserved_most_dazzling_ride_colours(int32_t activeAwardTypes)
+static bool award_is_deserved_most_dazzling_ride_colours(int32_t activeAwardTypes, const AwardStats& stats)
 {
     /** At least 5 colourful rides and more than half of the rides are colourful. */
-    static constexpr const colour_t dazzling_ride_colours[] = { COLOUR_BRIGHT_PURPLE, COLOUR_BRIGHT_GREEN, COLOUR_LIGHT_ORANGE,
-                                                                COLOUR_BRIGHT_PINK };
-
     if (activeAwardTypes & EnumToFlag(ParkAward::MostDisappointing))
         return false;
 
-    auto countedRides = 0;
-    auto colourfulRides = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        if (!ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_HAS_TRACK))
-            continue;
-
-        countedRides++;
-
-        auto mainTrackColour = ride.track_colour[0].main;
-        for (auto dazzling_ride_colour : dazzling_ride_colours)
-        {
-            if (mainTrackColour == dazzling_ride_colour)
-            {
-                colourfulRides++;
-                break;
-            }
-        }
-    }
-
-    return (colourfulRides >= 5 && colourfulRides >= countedRides - colourfulRides);
+    return (stats.ColourfulRides >= 5 && stats.ColourfulRides >= stats.TrackedRides - stats.ColourfulRides);
 }
 
 /** At least 10 peeps and more than 1/64 of total guests are lost or can't find something. */
-static bool award_is_deserved_most_confusing_layout([[maybe_unused]] int32_t activeAwardTypes)
+static bool award_is_deserved_most_confusing_layout([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
 {
-    uint32_t peepsCounted = 0;
-    uint32_t peepsLost = 0;
-    for (auto peep : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        peepsCounted++;
-        if (peep->Thoughts[0].freshness <= 5
-            && (peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_LOST || peep->Thoughts[0].type == PEEP_THOUGHT_TYPE_CANT_FIND))
-            peepsLost++;
-    }
-
-    return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
+    auto peepsLost = stats.FreshThoughts[PEEP_THOUGHT_TYPE_LOST] + stats.FreshThoughts[PEEP_THOUGHT_TYPE_CANT_FIND];
+    return (peepsLost >= 10 && peepsLost >= stats.GuestsInPark / 64);
 }
 
 /** At least 10 open gentle rides. */
-static bool award_is_deserved_best_gentle_rides([[maybe_unused]] int32_t activeAwardTypes)
+static bool award_is_deserved_best_gentle_rides([[maybe_unused]] int32_t activeAwardTypes, const AwardStats& stats)
 {
-    auto gentleRides = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        auto rideEntry = ride.GetRideEntry();
-        if (rideEntry == nullptr)
-        {
-            continue;
-        }
-
-        if (ride.status != RIDE_STATUS_OPEN || (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
-        {
-            continue;
-        }
-
-        if (!ride_entry_has_category(rideEntry, RIDE_CATEGORY_GENTLE))
-        {
-            continue;
-        }
-
-        gentleRides++;
-    }
-
-    return (gentleRides >= 10);
+    return (stats.GentleRides >= 10);
 }
 
-using award_deserved_check = bool (*)(int32_t);
+using award_deserved_check = bool (*)(int32_t, const AwardStats&);
 
 static constexpr const award_deserved_check _awardChecks[] = {
     award_is_deserved_most_untidy,
@@ -583,9 +415,9 @@ static constexpr const award_deserved_check _awardChecks[] = {
     award_is_deserved_best_gentle_rides,
 };
 
-static bool award_is_deserved(int32_t awardType, int32_t activeAwardTypes)
+static bool award_is_deserved(int32_t awardType, int32_t activeAwardTypes, const AwardStats& stats)
 {
-    return _awardChecks[awardType](activeAwardTypes);
+    return _awardChecks[awardType](activeAwardTypes, stats);
 }
 
 #pragma endregion
@@ -630,7 +462,7 @@ void award_update_all()
             } while (activeAwardTypes & (1 << awardType));
 
             // Check if award is deserved
-            if (award_is_deserved(awardType, activeAwardTypes))
+            if (award_is_deserved(awardType, activeAwardTypes, award_stats_calculate()))
             {
                 // Add award
                 gCurrentAwards[freeAwardEntryIndex].Type = awardType;
@@ -129,6 +129,7 @@ const std::array<NetworkAction, static_cast<size_t>(NetworkPermission::Count)> N
         {
             GAME_COMMAND_REMOVE_SCENERY,
             GAME_COMMAND_PLACE_SCENERY,
+            GAME_COMMAND_SCATTER_SCENERY,
             GAME_COMMAND_SET_BRAKES_SPEED,
             GAME_COMMAND_REMOVE_WALL,
             GAME_COMMAND_PLACE_WALL,
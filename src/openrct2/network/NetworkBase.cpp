@@ -13,6 +13,7 @@
 #include "../Game.h"
 #include "../GameStateSnapshots.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../PlatformEnvironment.h"
 #include "../actions/LoadOrQuitAction.hpp"
 #include "../actions/NetworkModifyGroupAction.hpp"
@@ -34,7 +35,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "1"
+#define NETWORK_STREAM_VERSION "10"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -44,6 +45,75 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// A desynchronised client sends the hash of each block of its map, the server replies with the blocks that differ.
+// All the hashes have to fit in one packet, which limits how large a map can be resynchronised this way.
+static constexpr uint32_t RESYNC_BLOCK_SIZE = 1024 * 16;
+static constexpr uint32_t RESYNC_MAX_BLOCKS = 3072;
+
+// The game actions of an update are sent in one packet, split up once they reach this size. Packets with more than
+// GAME_ACTIONS_COMPRESS_SIZE bytes of actions are compressed.
+static constexpr size_t GAME_ACTIONS_BATCH_SIZE = 1024 * 32;
+static constexpr size_t GAME_ACTIONS_COMPRESS_SIZE = 512;
+
+// A relay remembers which of its clients sent a game action until the server sends it back, which it does not for the
+// actions that fail. Those are forgotten after a minute.
+static constexpr uint32_t RELAY_ACTION_TIMEOUT_TICKS = GAME_UPDATE_FPS * 60;
+
+const char* network_get_command_name(NetworkCommand command)
+{
+    switch (command)
+    {
+        case NetworkCommand::Auth:
+            return "auth";
+        case NetworkCommand::Map:
+            return "map";
+        case NetworkCommand::Chat:
+            return "chat";
+        case NetworkCommand::Tick:
+            return "tick";
+        case NetworkCommand::PlayerList:
+            return "player_list";
+        case NetworkCommand::Ping:
+            return "ping";
+        case NetworkCommand::PingList:
+            return "ping_list";
+        case NetworkCommand::DisconnectMessage:
+            return "disconnect_message";
+        case NetworkCommand::GameInfo:
+            return "game_info";
+        case NetworkCommand::ShowError:
+            return "show_error";
+        case NetworkCommand::GroupList:
+            return "group_list";
+        case NetworkCommand::Event:
+            return "event";
+        case NetworkCommand::Token:
+            return "token";
+        case NetworkCommand::ObjectsList:
+            return "objects_list";
+        case NetworkCommand::MapRequest:
+            return "map_request";
+        case NetworkCommand::GameAction:
+            return "game_action";
+        case NetworkCommand::PlayerInfo:
+            return "player_info";
+        case NetworkCommand::RequestGameState:
+            return "request_game_state";
+        case NetworkCommand::GameState:
+            return "game_state";
+        case NetworkCommand::Scripts:
+            return "scripts";
+        case NetworkCommand::Heartbeat:
+            return "heartbeat";
+        case NetworkCommand::MapResync:
+            return "map_resync";
+        case NetworkCommand::MapDelta:
+            return "map_delta";
+        default:
+            return nullptr;
+    }
+}
+
 #ifndef DISABLE_NETWORK
 
 #    include "../Cheats.h"
@@ -52,6 +122,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "../actions/GameAction.h"
 #    include "../config/Config.h"
 #    include "../core/Console.hpp"
+#    include "../core/Crypt.h"
 #    include "../core/FileStream.hpp"
 #    include "../core/MemoryStream.h"
 #    include "../core/Nullable.hpp"
@@ -67,6 +138,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "../scenario/Scenario.h"
 #    include "../util/Util.h"
 #    include "../world/Park.h"
+#    include "../world/Sprite.h"
 #    include "NetworkAction.h"
 #    include "NetworkConnection.h"
 #    include "NetworkGroup.h"
@@ -80,6 +152,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include <algorithm>
 #    include <array>
 #    include <cerrno>
+#    include <cinttypes>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
@@ -126,6 +199,7 @@ NetworkBase::NetworkBase()
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::MapDelta] = &NetworkBase::Client_Handle_MAPDELTA;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::Server_Handle_CHAT;
@@ -136,6 +210,17 @@ NetworkBase::NetworkBase()
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Server_Handle_MAPREQUEST;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::Server_Handle_REQUEST_GAMESTATE;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
+    server_command_handlers[NetworkCommand::MapResync] = &NetworkBase::Server_Handle_MAPRESYNC;
+
+    relay_command_handlers[NetworkCommand::Auth] = &NetworkBase::Relay_Handle_AUTH;
+    relay_command_handlers[NetworkCommand::Chat] = &NetworkBase::Relay_Handle_CHAT;
+    relay_command_handlers[NetworkCommand::GameAction] = &NetworkBase::Relay_Handle_GAME_ACTION;
+    relay_command_handlers[NetworkCommand::Ping] = &NetworkBase::Server_Handle_PING;
+    relay_command_handlers[NetworkCommand::GameInfo] = &NetworkBase::Server_Handle_GAMEINFO;
+    relay_command_handlers[NetworkCommand::Token] = &NetworkBase::Server_Handle_TOKEN;
+    relay_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Relay_Handle_MAPREQUEST;
+    relay_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
+    relay_command_handlers[NetworkCommand::MapResync] = &NetworkBase::Relay_Handle_MAPRESYNC;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -170,7 +255,14 @@ void NetworkBase::Reconnect()
         _requireReconnect = true;
         return;
     }
-    BeginClient(_host, _port);
+    if (_relayPort != 0)
+    {
+        BeginRelay(_host, _port, _relayPort, _relayAddress);
+    }
+    else
+    {
+        BeginClient(_host, _port);
+    }
 }
 
 void NetworkBase::Close()
@@ -198,6 +290,18 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _mapStream = OpenRCT2::MemoryStream();
+        _mapStreamValid = false;
+        _mapStreamObjects.clear();
+        _serverGameState = OpenRCT2::MemoryStream();
+        _resyncBase = OpenRCT2::MemoryStream();
+        _resyncDelta = OpenRCT2::MemoryStream();
+        _resyncPending = false;
+        _pendingGameActions.Clear();
+        _numPendingGameActions = 0;
+        _relayGameActions.clear();
+        _relayActionOrigins.clear();
+        _relayBacklog.clear();
 
         gfx_invalidate_screen();
 
@@ -224,10 +328,15 @@ void NetworkBase::CloseConnection()
 {
     if (mode == NETWORK_MODE_CLIENT)
     {
+        // The clients of a relay are destroyed after this, like those of a server
+        _ioThread.reset();
+        _listenSocket.reset();
         _serverConnection.reset();
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        // Stopped before the connections it uses are destroyed
+        _ioThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -253,6 +362,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
     log_info("Connecting to %s:%u", host.c_str(), port);
     _host = host;
     _port = port;
+    _relayPort = 0;
 
     _serverConnection = std::make_unique<NetworkConnection>();
     _serverConnection->Socket = CreateTcpSocket();
@@ -340,6 +450,39 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
     return true;
 }
 
+/**
+ * Joins the server like any other client, then passes it on to clients of its own. Those all play as the relay's player,
+ * so the server only has to send everything once for all of them.
+ */
+bool NetworkBase::BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress)
+{
+    if (!BeginClient(host, port))
+    {
+        return false;
+    }
+
+    _userManager.Load();
+
+    log_verbose("Begin listening for relayed clients");
+    _listenSocket = CreateTcpSocket();
+    try
+    {
+        _listenSocket->Listen(listenAddress, listenPort);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        Close();
+        return false;
+    }
+    _ioThread = std::make_unique<NetworkIoThread>();
+    _relayPort = listenPort;
+    _relayAddress = listenAddress;
+
+    Console::WriteLine("Relaying %s:%u to clients on port %u", host.c_str(), port, listenPort);
+    return true;
+}
+
 bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
 {
     Close();
@@ -363,6 +506,7 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         Close();
         return false;
     }
+    _ioThread = std::make_unique<NetworkIoThread>();
 
     ServerName = gConfigNetwork.server_name;
     ServerDescription = gConfigNetwork.server_description;
@@ -452,8 +596,12 @@ NetworkConnection* NetworkBase::GetPlayerConnection(uint8_t id)
 
 void NetworkBase::Update()
 {
+    PROFILE_ZONE("NetworkBase::Update");
     _closeLock = true;
 
+    // Game actions run outside of a game tick, like the ones of clients or those run while paused, have not been sent yet
+    SendGameActions();
+
     // Update is not necessarily called per game tick, maintain our own delta time
     uint32_t ticks = platform_get_ticks();
     _currentDeltaTime = std::max<uint32_t>(ticks - _lastUpdateTime, 1);
@@ -469,6 +617,14 @@ void NetworkBase::Update()
             break;
     }
 
+    auto statsLogInterval = gConfigNetwork.stats_log_interval;
+    if (statsLogInterval > 0 && GetMode() != NETWORK_MODE_NONE
+        && ticks - _lastStatsLogTime >= static_cast<uint32_t>(statsLogInterval) * 1000)
+    {
+        LogStats();
+        _lastStatsLogTime = ticks;
+    }
+
     // If the Close() was called during the update, close it for real
     _closeLock = false;
     if (_requireClose)
@@ -483,16 +639,15 @@ void NetworkBase::Update()
 
 void NetworkBase::Flush()
 {
+    PROFILE_ZONE("NetworkBase::Flush");
+    SendGameActions();
     if (GetMode() == NETWORK_MODE_CLIENT)
     {
         _serverConnection->SendQueuedPackets();
     }
-    else
+    if (_ioThread != nullptr)
     {
-        for (auto& it : client_connection_list)
-        {
-            it->SendQueuedPackets();
-        }
+        _ioThread->Wake();
     }
 }
 
@@ -531,6 +686,9 @@ void NetworkBase::UpdateServer()
     {
         AddClient(std::move(tcpSocket));
     }
+
+    // Send what the packets handled above have queued
+    _ioThread->Wake();
 }
 
 void NetworkBase::UpdateClient()
@@ -643,6 +801,11 @@ void NetworkBase::UpdateClient()
                     Client_Send_HEARTBEAT(*_serverConnection);
                     _lastSentHeartbeat = ticks;
                 }
+
+                if (IsRelay())
+                {
+                    UpdateRelay();
+                }
             }
 
             break;
@@ -716,6 +879,14 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Keep the order in which the game actions and other packets were sent
+    if (packet.GetCommand() != NetworkCommand::GameAction)
+    {
+        SendGameActions();
+    }
+
+    // Serialised once, all the connections share the same bytes
+    auto buffer = packet.Serialise();
     for (auto& client_connection : client_connection_list)
     {
         if (client_connection->IsDisconnected)
@@ -735,11 +906,37 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        client_connection->QueuePacket(buffer, front);
     }
 }
 
+/**
+ * Hashes a few values of the game state that are cheap to get, unlike the sprite checksum this is done for every tick so a
+ * desync is noticed without having to wait for the next sprite checksum.
+ */
+static uint32_t network_get_state_hash()
+{
+    uint32_t hash = 2166136261u;
+    auto add = [&hash](uint32_t value) {
+        for (int32_t i = 0; i < 4; i++)
+        {
+            hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 16777619u;
+        }
+    };
+    add(scenario_rand_state().s1);
+    add(static_cast<uint32_t>(gCash));
+    add(static_cast<uint32_t>(gParkValue));
+    add(static_cast<uint32_t>(gCompanyValue));
+    add(gParkRating);
+    add(gNumGuestsInPark);
+    // Misc entities are left out of the game state, like they are of the sprite checksum
+    add(GetEntityListCount(EntityListId::TrainHead));
+    add(GetEntityListCount(EntityListId::Peep));
+    add(GetEntityListCount(EntityListId::Litter));
+    add(GetEntityListCount(EntityListId::Vehicle));
+    return hash;
+}
+
 bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 {
     // We have to wait for the map to be loaded first, ticks may match current loaded map.
@@ -759,9 +956,20 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
         return false;
     }
 
+    if (storedTick.stateHash)
+    {
+        uint32_t stateHash = network_get_state_hash();
+        if (stateHash != *storedTick.stateHash)
+        {
+            log_info("State hash mismatch, client = %08X, server = %08X", stateHash, *storedTick.stateHash);
+            return false;
+        }
+    }
+
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        auto algorithm = storedTick.spriteHashChunked ? SpriteChecksumAlgorithm::Chunked : SpriteChecksumAlgorithm::Serial;
+        rct_sprite_checksum checksum = sprite_checksum(algorithm);
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
@@ -794,11 +1002,6 @@ bool NetworkBase::CheckDesynchronizaton()
         intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
         context_open_intent(&intent);
 
-        if (!gConfigNetwork.stay_connected)
-        {
-            Close();
-        }
-
         return true;
     }
 
@@ -812,6 +1015,55 @@ void NetworkBase::RequestStateSnapshot()
     Client_Send_RequestGameState(_serverState.desyncTick);
 }
 
+static size_t GetResyncBlockLength(size_t mapLength, size_t index)
+{
+    return std::min<size_t>(RESYNC_BLOCK_SIZE, mapLength - index * RESYNC_BLOCK_SIZE);
+}
+
+static Crypt::Sha1Algorithm::Result GetResyncBlockHash(const MemoryStream& map, size_t index)
+{
+    const auto* data = static_cast<const uint8_t*>(map.GetData()) + index * RESYNC_BLOCK_SIZE;
+    return Crypt::SHA1(data, GetResyncBlockLength(map.GetLength(), index));
+}
+
+void NetworkBase::RequestResync()
+{
+    if (GetMode() != NETWORK_MODE_CLIENT || GetStatus() != NETWORK_STATUS_CONNECTED || _resyncPending)
+    {
+        return;
+    }
+
+    // Saved without encoding the chunks so that the blocks which are the same as on the server have the same hash
+    _resyncBase.Clear();
+    size_t numBlocks = 0;
+    if (SaveMap(&_resyncBase, {}, true))
+    {
+        numBlocks = (_resyncBase.GetLength() + RESYNC_BLOCK_SIZE - 1) / RESYNC_BLOCK_SIZE;
+    }
+    if (numBlocks == 0 || numBlocks > RESYNC_MAX_BLOCKS)
+    {
+        log_warning("Unable to resynchronise with the server, the map could not be hashed.");
+        _resyncBase = MemoryStream();
+        if (!gConfigNetwork.stay_connected)
+        {
+            Close();
+        }
+        return;
+    }
+
+    log_info("Requesting resynchronisation from tick %u, %u map blocks", gCurrentTicks, static_cast<uint32_t>(numBlocks));
+
+    NetworkPacket packet(NetworkCommand::MapResync);
+    packet << _serverState.desyncTick << static_cast<uint32_t>(_resyncBase.GetLength()) << static_cast<uint32_t>(numBlocks);
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+        auto hash = GetResyncBlockHash(_resyncBase, i);
+        packet.Write(hash.data(), hash.size());
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+    _resyncPending = true;
+}
+
 NetworkServerState_t NetworkBase::GetServerState() const
 {
     return _serverState;
@@ -1322,27 +1574,58 @@ void NetworkBase::Client_Send_HEARTBEAT(NetworkConnection& connection) const
     connection.QueuePacket(std::move(packet));
 }
 
+static void network_add_stats(NetworkStats_t& dst, const NetworkStats_t& src)
+{
+    for (size_t n = 0; n < EnumValue(NetworkStatisticsGroup::Max); n++)
+    {
+        dst.bytesReceived[n] += src.bytesReceived[n];
+        dst.bytesSent[n] += src.bytesSent[n];
+    }
+    for (size_t n = 0; n < EnumValue(NetworkCommand::Max); n++)
+    {
+        dst.commands[n].packetsReceived += src.commands[n].packetsReceived;
+        dst.commands[n].bytesReceived += src.commands[n].bytesReceived;
+        dst.commands[n].packetsSent += src.commands[n].packetsSent;
+        dst.commands[n].bytesSent += src.commands[n].bytesSent;
+    }
+    dst.queuedPackets += src.queuedPackets;
+    dst.queuedBytes += src.queuedBytes;
+    dst.sendLatencyTotal += src.sendLatencyTotal;
+    dst.sendLatencyCount += src.sendLatencyCount;
+    dst.sendLatencyMax = std::max(dst.sendLatencyMax, src.sendLatencyMax);
+}
+
 NetworkStats_t NetworkBase::GetStats() const
 {
     NetworkStats_t stats = {};
     if (mode == NETWORK_MODE_CLIENT)
     {
-        stats = _serverConnection->Stats;
+        stats = _serverConnection->GetStats();
     }
-    else
+    // The clients of a relay are counted along with its connection to the server
+    for (auto& connection : client_connection_list)
     {
-        for (auto& connection : client_connection_list)
-        {
-            for (size_t n = 0; n < EnumValue(NetworkStatisticsGroup::Max); n++)
-            {
-                stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
-                stats.bytesSent[n] += connection->Stats.bytesSent[n];
-            }
-        }
+        network_add_stats(stats, connection->GetStats());
     }
+    stats.mapsSaved = _mapStats.mapsSaved;
+    stats.mapBytesUncompressed = _mapStats.mapBytesUncompressed;
+    stats.mapBytesCompressed = _mapStats.mapBytesCompressed;
     return stats;
 }
 
+void NetworkBase::LogStats() const
+{
+    auto stats = GetStats();
+    auto sendLatency = stats.sendLatencyCount != 0 ? stats.sendLatencyTotal / stats.sendLatencyCount : 0;
+    log_info(
+        "Network: %" PRIu64 " bytes sent, %" PRIu64 " bytes received, %" PRIu64 " packets (%" PRIu64
+        " bytes) queued, send latency %" PRIu64 " ms average, %u ms max, %" PRIu64 " maps saved (%" PRIu64
+        " of %" PRIu64 " bytes)",
+        stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)],
+        stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)], stats.queuedPackets, stats.queuedBytes, sendLatency,
+        stats.sendLatencyMax, stats.mapsSaved, stats.mapBytesCompressed, stats.mapBytesUncompressed);
+}
+
 void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
 {
     uint8_t new_playerid = 0;
@@ -1350,6 +1633,11 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
     {
         new_playerid = connection.Player->Id;
     }
+    else if (IsRelay())
+    {
+        // The clients of a relay play as its player
+        new_playerid = player_id;
+    }
     NetworkPacket packet(NetworkCommand::Auth);
     packet << static_cast<uint32_t>(connection.AuthStatus) << new_playerid;
     if (connection.AuthStatus == NetworkAuth::BadVersion)
@@ -1365,6 +1653,9 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
 
 void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
 {
+    // The actions that have been run are part of the map, so they have to reach the clients first
+    SendGameActions();
+
     std::vector<const ObjectRepositoryItem*> objects;
     if (connection)
     {
@@ -1377,10 +1668,12 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         auto context = GetContext();
         auto& objManager = context->GetObjectManager();
         objects = objManager.GetPackableObjects();
+
+        // Sent after a new park has been loaded, which can have the same tick as the previous one
+        _mapStreamValid = false;
     }
 
-    auto header = save_for_network(objects);
-    if (header.empty())
+    if (!save_for_network(objects))
     {
         if (connection)
         {
@@ -1389,12 +1682,15 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         }
         return;
     }
+    // The packets are filled straight from the saved map
+    const auto* header = static_cast<const uint8_t*>(_mapStream.GetData());
+    const size_t headerSize = static_cast<size_t>(_mapStream.GetLength());
     size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+    for (size_t i = 0; i < headerSize; i += chunksize)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
+        size_t datasize = std::min(chunksize, headerSize - i);
         NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
+        packet << static_cast<uint32_t>(headerSize) << static_cast<uint32_t>(i);
         packet.Write(&header[i], datasize);
         if (connection)
         {
@@ -1407,39 +1703,37 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
     }
 }
 
-std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
+/**
+ * Saves the map into _mapStream, replacing the previous one unless it was saved for the same objects in the current tick.
+ */
+bool NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects)
 {
-    std::vector<uint8_t> header;
-    bool RLEState = gUseRLE;
-    gUseRLE = false;
-
-    auto ms = OpenRCT2::MemoryStream();
-    if (!SaveMap(&ms, objects))
+    // Game actions are only run as part of a tick, but while paused they run without the tick advancing
+    if (_mapStreamValid && _mapStreamTick == gCurrentTicks && !gGamePaused && _mapStreamObjects == objects)
     {
-        log_warning("Failed to export map.");
-        return header;
+        log_verbose("Sending map of size %u bytes saved earlier this tick", static_cast<uint32_t>(_mapStream.GetLength()));
+        return true;
     }
-    gUseRLE = RLEState;
-
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
 
-    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
-    if (compressed != std::nullopt)
-    {
-        std::string headerString = "open2_sv6_zlib";
-        header.resize(headerString.size() + 1 + compressed->size());
-        std::memcpy(&header[0], headerString.c_str(), headerString.size() + 1);
-        std::memcpy(&header[headerString.size() + 1], compressed->data(), compressed->size());
-        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, headerString.size() + 1 + compressed->size());
-    }
-    else
+    // The chunks of the map are compressed with zlib in parallel as they are saved, so unlike the older
+    // open2_sv6_zlib format the whole file does not have to be deflated again in one go afterwards.
+    _mapStreamValid = false;
+    _mapStream.Clear();
+    size_t chunksLength = 0;
+    if (!SaveMap(&_mapStream, objects, false, &chunksLength) || _mapStream.GetLength() == 0)
     {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header.resize(size);
-        std::memcpy(header.data(), data, size);
+        log_warning("Failed to export map.");
+        return false;
     }
-    return header;
+    _mapStats.mapsSaved++;
+    _mapStats.mapBytesUncompressed += chunksLength;
+    _mapStats.mapBytesCompressed += _mapStream.GetLength();
+    _mapStreamValid = true;
+    _mapStreamTick = gCurrentTicks;
+    _mapStreamObjects = objects;
+
+    log_verbose("Sending map of size %u bytes", static_cast<uint32_t>(_mapStream.GetLength()));
+    return true;
 }
 
 void NetworkBase::Client_Send_CHAT(const char* text)
@@ -1474,8 +1768,6 @@ void NetworkBase::Server_Send_CHAT(const char* text, const std::vector<uint8_t>&
 
 void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
 {
-    NetworkPacket packet(NetworkCommand::GameAction);
-
     uint32_t networkId = 0;
     networkId = ++_actionId;
 
@@ -1486,46 +1778,154 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
         _gameActionCallbacks.insert(std::make_pair(networkId, action->GetCallback()));
     }
 
-    DataSerialiser stream(true);
+    QueueGameAction(action);
+}
+
+void NetworkBase::Server_Send_GAME_ACTION(const GameAction* action)
+{
+    QueueGameAction(action);
+}
+
+void NetworkBase::QueueGameAction(const GameAction* action)
+{
+    // The stream is kept so its buffer is reused for every action
+    _gameActionStream.Clear();
+    DataSerialiser stream(true, _gameActionStream);
     action->Serialise(stream);
+    const auto& data = _gameActionStream;
+    if (_pendingGameActions.Data.size() + data.GetLength() > GAME_ACTIONS_BATCH_SIZE)
+    {
+        SendGameActions();
+    }
 
-    packet << gCurrentTicks << action->GetType() << stream;
-    _serverConnection->QueuePacket(std::move(packet));
+    _pendingGameActions << gCurrentTicks << action->GetType() << static_cast<uint32_t>(data.GetLength());
+    _pendingGameActions.Write(data.GetData(), data.GetLength());
+    _numPendingGameActions++;
 }
 
-void NetworkBase::Server_Send_GAME_ACTION(const GameAction* action)
+/**
+ * Makes the packet of a batch of game actions, each written as its tick, type, size and serialised data.
+ */
+static NetworkPacket network_make_game_actions_packet(const std::vector<uint8_t>& actions, uint32_t count)
 {
+    std::optional<std::vector<uint8_t>> compressed;
+    if (actions.size() > GAME_ACTIONS_COMPRESS_SIZE)
+    {
+        compressed = util_zlib_deflate(actions.data(), actions.size());
+        if (compressed && compressed->size() >= actions.size())
+        {
+            compressed.reset();
+        }
+    }
+
     NetworkPacket packet(NetworkCommand::GameAction);
+    packet << count << static_cast<uint8_t>(compressed ? 1 : 0);
+    if (compressed)
+    {
+        packet.Write(compressed->data(), compressed->size());
+    }
+    else
+    {
+        packet.Write(actions.data(), actions.size());
+    }
+    return packet;
+}
 
-    DataSerialiser stream(true);
-    action->Serialise(stream);
+void NetworkBase::SendGameActions()
+{
+    if (_numPendingGameActions == 0)
+    {
+        return;
+    }
 
-    packet << gCurrentTicks << action->GetType() << stream;
+    auto packet = network_make_game_actions_packet(_pendingGameActions.Data, _numPendingGameActions);
+    _pendingGameActions.Clear();
+    _numPendingGameActions = 0;
 
-    SendPacketToClients(packet);
+    if (GetMode() == NETWORK_MODE_SERVER)
+    {
+        SendPacketToClients(packet, false, true);
+    }
+    else if (GetMode() == NETWORK_MODE_CLIENT)
+    {
+        _serverConnection->QueuePacket(std::move(packet));
+    }
+}
+
+/**
+ * Calls enqueue with the tick, type and serialised data of each game action in a packet sent by SendGameActions.
+ */
+bool NetworkBase::ReadGameActions(
+    NetworkPacket& packet, const std::function<void(uint32_t, uint32_t, const uint8_t*, size_t)>& enqueue) const
+{
+    uint32_t count;
+    uint8_t isCompressed;
+    packet >> count >> isCompressed;
+    size_t size = packet.Header.Size - packet.BytesRead;
+    const uint8_t* data = packet.Read(size);
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    NetworkPacket actions;
+    if (isCompressed != 0)
+    {
+        size_t actionsSize = 0;
+        auto* inflated = util_zlib_inflate(const_cast<uint8_t*>(data), size, &actionsSize);
+        if (inflated == nullptr || actionsSize > GAME_ACTIONS_BATCH_SIZE * 2)
+        {
+            free(inflated);
+            return false;
+        }
+        actions.Write(inflated, actionsSize);
+        free(inflated);
+    }
+    else
+    {
+        actions.Write(data, size);
+    }
+    actions.Header.Size = static_cast<uint16_t>(actions.Data.size());
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t tick = 0;
+        uint32_t actionType = 0;
+        uint32_t actionSize = 0;
+        actions >> tick >> actionType >> actionSize;
+        const uint8_t* actionData = actions.Read(actionSize);
+        if (actionData == nullptr)
+        {
+            return false;
+        }
+        enqueue(tick, actionType, actionData, actionSize);
+    }
+    return true;
 }
 
 void NetworkBase::Server_Send_TICK()
 {
+    // The actions of this tick have to arrive before it is processed by the clients
+    SendGameActions();
+
     NetworkPacket packet(NetworkCommand::Tick);
     packet << gCurrentTicks << scenario_rand_state().s0;
-    uint32_t flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
-    static int32_t checksum_counter = 0;
-    checksum_counter++;
-    if (checksum_counter >= 100)
+    uint32_t flags = NETWORK_TICK_FLAG_STATE_HASH;
+    // The sprite checksum can get somewhat expensive, so it is only sent every checksum_interval ticks and not at all
+    // while there are no clients to check it.
+    auto checksumInterval = static_cast<uint32_t>(std::max(gConfigNetwork.checksum_interval, 0));
+    if (checksumInterval != 0 && !client_connection_list.empty() && gCurrentTicks - _lastChecksumTick >= checksumInterval)
     {
-        checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
+        _lastChecksumTick = gCurrentTicks;
+        flags |= NETWORK_TICK_FLAG_CHECKSUMS | NETWORK_TICK_FLAG_CHUNKED_CHECKSUMS;
     }
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     packet << flags;
+    packet << network_get_state_hash();
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum(SpriteChecksumAlgorithm::Chunked);
         packet.WriteString(checksum.ToString().c_str());
     }
 
@@ -1661,6 +2061,30 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
 
 bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 {
+    if (GetMode() == NETWORK_MODE_SERVER || &connection != _serverConnection.get())
+    {
+        // The packets of the clients of a server or relay have already been read by the I/O thread, which also sends the
+        // queued ones
+        NetworkPacket packet;
+        while (connection.PopInboundPacket(packet))
+        {
+            ProcessPacket(connection, packet);
+            if (connection.Socket == nullptr)
+            {
+                return false;
+            }
+        }
+        if (connection.IsReceiveClosed())
+        {
+            if (!connection.GetLastDisconnectReason())
+            {
+                connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            }
+            return false;
+        }
+        return ReceivedPacketRecently(connection);
+    }
+
     NetworkReadPacket packetStatus;
     do
     {
@@ -1693,6 +2117,11 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 
     connection.SendQueuedPackets();
 
+    return ReceivedPacketRecently(connection);
+}
+
+bool NetworkBase::ReceivedPacketRecently(NetworkConnection& connection)
+{
     if (!connection.ReceivedPacketRecently())
     {
         if (!connection.GetLastDisconnectReason())
@@ -1701,15 +2130,24 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
         }
         return false;
     }
-
     return true;
 }
 
 void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet)
 {
-    const auto& handlerList = GetMode() == NETWORK_MODE_SERVER ? server_command_handlers : client_command_handlers;
-    auto it = handlerList.find(packet.GetCommand());
-    if (it != handlerList.end())
+    const bool fromServer = GetMode() == NETWORK_MODE_CLIENT && &connection == _serverConnection.get();
+    const auto* handlerList = &server_command_handlers;
+    if (fromServer)
+    {
+        handlerList = &client_command_handlers;
+    }
+    else if (GetMode() == NETWORK_MODE_CLIENT)
+    {
+        handlerList = &relay_command_handlers;
+    }
+
+    auto it = handlerList->find(packet.GetCommand());
+    if (it != handlerList->end())
     {
         auto commandHandler = it->second;
         if (connection.AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
@@ -1718,12 +2156,19 @@ void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& pa
         }
     }
 
+    // A relay passes on what the server sends to all its clients once it has handled it itself
+    if (fromServer && IsRelay())
+    {
+        RelayPacket(packet);
+    }
+
     packet.Clear();
 }
 
 // This is called at the end of each game tick, this where things should be processed that affects the game state.
 void NetworkBase::ProcessPending()
 {
+    PROFILE_ZONE("NetworkBase::ProcessPending");
     if (GetMode() == NETWORK_MODE_SERVER)
     {
         ProcessDisconnectedClients();
@@ -1731,6 +2176,10 @@ void NetworkBase::ProcessPending()
     else if (GetMode() == NETWORK_MODE_CLIENT)
     {
         ProcessPlayerInfo();
+        if (IsRelay())
+        {
+            ProcessDisconnectedRelayClients();
+        }
     }
     ProcessPlayerList();
 }
@@ -1928,6 +2377,7 @@ void NetworkBase::ProcessDisconnectedClients()
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
 
+            _ioThread->RemoveConnection(*connection);
             it = client_connection_list.erase(it);
         }
         else
@@ -1948,6 +2398,7 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
 
+    _ioThread->AddConnection(*connection);
     client_connection_list.push_back(std::move(connection));
 }
 
@@ -2398,8 +2849,8 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
 
     if (offset == 0)
     {
-        // Reset
-        _serverGameState = MemoryStream();
+        // Reset, keeping the buffer of the previous game state
+        _serverGameState.Clear();
     }
 
     _serverGameState.SetPosition(offset);
@@ -2433,10 +2884,14 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
 
             char uniqueFileName[128] = {};
             snprintf(
-                uniqueFileName, sizeof(uniqueFileName), "desync_%llu_%u.txt",
+                uniqueFileName, sizeof(uniqueFileName), "desync_%llu_%u",
                 static_cast<long long unsigned>(platform_get_datetime_now_utc()), tick);
 
-            std::string outputFile = Path::Combine(outputPath, uniqueFileName);
+            std::string outputFileBase = Path::Combine(outputPath, uniqueFileName);
+            snapshots->WriteCompareDataToFile(outputFileBase + ".dat", cmpData);
+
+            String::Append(uniqueFileName, sizeof(uniqueFileName), ".txt");
+            std::string outputFile = outputFileBase + ".txt";
 
             if (snapshots->LogCompareDataToFile(outputFile, cmpData))
             {
@@ -2456,23 +2911,17 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
     }
 }
 
-void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+/**
+ * Reads the objects a client asked for in a map request into the requested objects of its connection. Returns false if
+ * it asked for more objects than there can be.
+ */
+static bool network_read_requested_objects(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
     packet >> size;
     if (size > OBJECT_ENTRY_COUNT)
     {
-        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
-        connection.Socket->Disconnect();
-        std::string playerName = "(unknown)";
-        if (connection.Player)
-        {
-            playerName = connection.Player->Name;
-        }
-        std::string text = std::string("Player ") + playerName + std::string(" requested invalid amount of objects");
-        AppendServerLog(text);
-        log_warning(text.c_str());
-        return;
+        return false;
     }
     log_verbose("Client requested %u objects", size);
     auto& repo = GetContext()->GetObjectRepository();
@@ -2492,6 +2941,25 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
             connection.RequestedObjects.push_back(item);
         }
     }
+    return true;
+}
+
+void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!network_read_requested_objects(connection, packet))
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+        std::string playerName = "(unknown)";
+        if (connection.Player)
+        {
+            playerName = connection.Player->Name;
+        }
+        std::string text = std::string("Player ") + playerName + std::string(" requested invalid amount of objects");
+        AppendServerLog(text);
+        log_warning(text.c_str());
+        return;
+    }
 
     const char* player_name = static_cast<const char*>(connection.Player->Name.c_str());
     Server_Send_MAP(&connection);
@@ -2499,68 +2967,161 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
     Server_Send_GROUPLIST(connection);
 }
 
-void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+void NetworkBase::Server_Handle_MAPRESYNC(NetworkConnection& connection, NetworkPacket& packet)
 {
-    if (connection.AuthStatus != NetworkAuth::Ok)
-    {
-        const char* gameversion = packet.ReadString();
-        const char* name = packet.ReadString();
-        const char* password = packet.ReadString();
-        const char* pubkey = packet.ReadString();
-        uint32_t sigsize;
-        packet >> sigsize;
-        if (pubkey == nullptr)
-        {
-            connection.AuthStatus = NetworkAuth::VerificationFailure;
-        }
-        else
-        {
-            try
-            {
-                std::vector<uint8_t> signature;
-                signature.resize(sigsize);
-
-                const uint8_t* signatureData = packet.Read(sigsize);
-                if (signatureData == nullptr)
-                {
-                    throw std::runtime_error("Failed to read packet.");
-                }
+    constexpr size_t hashSize = sizeof(Crypt::Sha1Algorithm::Result);
 
-                std::memcpy(signature.data(), signatureData, sigsize);
+    uint32_t desyncTick, clientMapLength, numClientBlocks;
+    packet >> desyncTick >> clientMapLength >> numClientBlocks;
+    const uint8_t* clientHashes = nullptr;
+    if (numClientBlocks <= RESYNC_MAX_BLOCKS
+        && numClientBlocks == (static_cast<size_t>(clientMapLength) + RESYNC_BLOCK_SIZE - 1) / RESYNC_BLOCK_SIZE)
+    {
+        clientHashes = packet.Read(numClientBlocks * hashSize);
+    }
+    if (clientHashes == nullptr)
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+        return;
+    }
 
-                auto ms = MemoryStream(pubkey, strlen(pubkey));
-                if (!connection.Key.LoadPublic(&ms))
-                {
-                    throw std::runtime_error("Failed to load public key.");
-                }
+    SendGameActions();
+
+    MemoryStream map;
+    size_t numBlocks = 0;
+    if (SaveMap(&map, {}, true))
+    {
+        numBlocks = (map.GetLength() + RESYNC_BLOCK_SIZE - 1) / RESYNC_BLOCK_SIZE;
+    }
+    if (numBlocks == 0 || numBlocks > RESYNC_MAX_BLOCKS)
+    {
+        log_warning("Unable to save map blocks for resynchronisation, sending the whole map.");
+        Server_Send_MAP(&connection);
+        return;
+    }
+
+    // Only the blocks whose contents differ from the client's make it into the delta
+    const auto* mapData = static_cast<const uint8_t*>(map.GetData());
+    const size_t mapLength = map.GetLength();
+    std::vector<uint32_t> blocks;
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+        size_t blockLength = GetResyncBlockLength(mapLength, i);
+        if (i < numClientBlocks && GetResyncBlockLength(clientMapLength, i) == blockLength)
+        {
+            auto hash = GetResyncBlockHash(map, i);
+            if (std::memcmp(hash.data(), clientHashes + i * hashSize, hashSize) == 0)
+            {
+                continue;
+            }
+        }
+        blocks.push_back(static_cast<uint32_t>(i));
+    }
+
+    MemoryStream delta;
+    delta.WriteValue<uint32_t>(static_cast<uint32_t>(mapLength));
+    delta.WriteValue<uint32_t>(static_cast<uint32_t>(blocks.size()));
+    for (auto index : blocks)
+    {
+        delta.WriteValue<uint32_t>(index);
+        delta.Write(mapData + index * RESYNC_BLOCK_SIZE, GetResyncBlockLength(mapLength, index));
+    }
+    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(delta.GetData()), delta.GetLength());
+    if (!compressed)
+    {
+        log_warning("Unable to compress map blocks for resynchronisation, sending the whole map.");
+        Server_Send_MAP(&connection);
+        return;
+    }
+
+    std::string playerName = connection.Player != nullptr ? connection.Player->Name : "(unknown)";
+    log_info(
+        "Player %s desynchronised at tick %u, sending %u of %u map blocks (%u bytes)", playerName.c_str(), desyncTick,
+        static_cast<uint32_t>(blocks.size()), static_cast<uint32_t>(numBlocks), static_cast<uint32_t>(compressed->size()));
+
+    const uint32_t size = static_cast<uint32_t>(compressed->size());
+    for (uint32_t offset = 0; offset < size; offset += CHUNK_SIZE)
+    {
+        uint32_t dataSize = std::min(CHUNK_SIZE, size - offset);
+        NetworkPacket packetDelta(NetworkCommand::MapDelta);
+        packetDelta << size << offset;
+        packetDelta.Write(compressed->data() + offset, dataSize);
+        connection.QueuePacket(std::move(packetDelta));
+    }
+}
+
+/**
+ * Reads the signature of the challenge that follows the public key in an auth packet and sets the auth status of the
+ * connection to Verified if it checks out.
+ */
+void NetworkBase::VerifyAuthKey(NetworkConnection& connection, NetworkPacket& packet, const char* pubkey)
+{
+    uint32_t sigsize;
+    packet >> sigsize;
+    if (pubkey == nullptr)
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+    }
+    else
+    {
+        try
+        {
+            std::vector<uint8_t> signature;
+            signature.resize(sigsize);
 
-                bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
-                const std::string hash = connection.Key.PublicKeyHash();
-                if (verified)
+            const uint8_t* signatureData = packet.Read(sigsize);
+            if (signatureData == nullptr)
+            {
+                throw std::runtime_error("Failed to read packet.");
+            }
+
+            std::memcpy(signature.data(), signatureData, sigsize);
+
+            auto ms = MemoryStream(pubkey, strlen(pubkey));
+            if (!connection.Key.LoadPublic(&ms))
+            {
+                throw std::runtime_error("Failed to load public key.");
+            }
+
+            bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
+            const std::string hash = connection.Key.PublicKeyHash();
+            if (verified)
+            {
+                log_verbose("Signature verification ok. Hash %s", hash.c_str());
+                if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
                 {
-                    log_verbose("Signature verification ok. Hash %s", hash.c_str());
-                    if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
-                    {
-                        log_verbose("Hash %s, not known", hash.c_str());
-                        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
-                    }
-                    else
-                    {
-                        connection.AuthStatus = NetworkAuth::Verified;
-                    }
+                    log_verbose("Hash %s, not known", hash.c_str());
+                    connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
                 }
                 else
                 {
-                    connection.AuthStatus = NetworkAuth::VerificationFailure;
-                    log_verbose("Signature verification failed!");
+                    connection.AuthStatus = NetworkAuth::Verified;
                 }
             }
-            catch (const std::exception&)
+            else
             {
                 connection.AuthStatus = NetworkAuth::VerificationFailure;
-                log_verbose("Signature verification failed, invalid data!");
+                log_verbose("Signature verification failed!");
             }
         }
+        catch (const std::exception&)
+        {
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            log_verbose("Signature verification failed, invalid data!");
+        }
+    }
+}
+
+void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus != NetworkAuth::Ok)
+    {
+        const char* gameversion = packet.ReadString();
+        const char* name = packet.ReadString();
+        const char* password = packet.ReadString();
+        const char* pubkey = packet.ReadString();
+        VerifyAuthKey(connection, packet, pubkey);
 
         bool passwordless = false;
         if (connection.AuthStatus == NetworkAuth::Verified)
@@ -2631,6 +3192,11 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
 
         _serverTickData.clear();
         _clientMapLoaded = false;
+
+        // What has been relayed so far is for the previous map, the clients of a relay are sent the new one
+        _relayGameActions.clear();
+        _relayActionOrigins.clear();
+        _relayBacklog.clear();
     }
     if (size > chunk_buffer.size())
     {
@@ -2658,7 +3224,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
         bool has_to_free = false;
         uint8_t* data = &chunk_buffer[0];
         size_t data_size = size;
-        // zlib-compressed
+        // zlib-compressed, as sent by older servers
         if (strcmp("open2_sv6_zlib", reinterpret_cast<char*>(&chunk_buffer[0])) == 0)
         {
             log_verbose("Received zlib-compressed sv6 map");
@@ -2674,7 +3240,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
         }
         else
         {
-            log_verbose("Assuming received map is in plain sv6 format");
+            log_verbose("Assuming received map is in sv6 format");
         }
 
         auto ms = MemoryStream(data, data_size);
@@ -2686,6 +3252,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             // window_network_status_open("Loaded new map from network");
             _serverState.state = NetworkServerState::Ok;
             _clientMapLoaded = true;
+            _resyncPending = false;
             gFirstTimeSaving = true;
 
             // Notify user he is now online and which shortcut key enables chat
@@ -2698,6 +3265,11 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             // Given that during map load game actions are buffered we have to process the
             // player list first to have valid players for the queued game actions.
             ProcessPlayerList();
+
+            if (IsRelay())
+            {
+                Relay_Send_MAP();
+            }
         }
         else
         {
@@ -2712,6 +3284,104 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     }
 }
 
+void NetworkBase::Client_Handle_MAPDELTA([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t size, offset;
+    packet >> size >> offset;
+    int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
+    if (chunksize <= 0 || !_resyncPending)
+    {
+        return;
+    }
+    if (offset == 0)
+    {
+        // The delta brings the map to the tick the server was on, so like a full map load the game actions
+        // up to then are dropped and the ones after are buffered until it has been applied.
+        GameActions::ClearQueue();
+        GameActions::SuspendQueue();
+
+        _serverTickData.clear();
+        _resyncDelta.Clear();
+    }
+    _resyncDelta.SetPosition(offset);
+    _resyncDelta.Write(packet.Read(chunksize), chunksize);
+    if (offset + chunksize < size)
+    {
+        return;
+    }
+
+    GameActions::ResumeQueue();
+    _resyncPending = false;
+    bool loaded = LoadMapDelta();
+    _resyncBase = MemoryStream();
+    _resyncDelta = MemoryStream();
+    if (!loaded)
+    {
+        log_warning("Failed to apply the map blocks sent by the server.");
+        if (!gConfigNetwork.stay_connected)
+        {
+            Close();
+        }
+        return;
+    }
+
+    // Keep the view of the client rather than the one saved by the server
+    viewport_set_saved_view();
+    gLoadKeepWindowsOpen = true;
+    game_load_init();
+    gLoadKeepWindowsOpen = false;
+
+    _serverState.tick = gCurrentTicks;
+    _serverState.state = NetworkServerState::Ok;
+    fix_invalid_vehicle_sprite_sizes();
+    ProcessPlayerList();
+
+    context_force_close_window_by_class(WC_NETWORK_STATUS);
+    log_info("Resynchronised with the server at tick %u", gCurrentTicks);
+}
+
+/**
+ * Rebuilds the map of the server from the blocks it sent and the ones of _resyncBase that were the same, then loads it.
+ */
+bool NetworkBase::LoadMapDelta()
+{
+    size_t deltaSize = 0;
+    auto* compressed = const_cast<uint8_t*>(static_cast<const uint8_t*>(_resyncDelta.GetData()));
+    auto* deltaData = util_zlib_inflate(compressed, _resyncDelta.GetLength(), &deltaSize);
+    if (deltaData == nullptr)
+    {
+        return false;
+    }
+
+    bool result = false;
+    try
+    {
+        auto delta = MemoryStream(deltaData, deltaSize);
+        auto mapLength = delta.ReadValue<uint32_t>();
+        auto numBlocks = delta.ReadValue<uint32_t>();
+
+        std::vector<uint8_t> map(mapLength);
+        std::memcpy(map.data(), _resyncBase.GetData(), std::min<size_t>(mapLength, _resyncBase.GetLength()));
+        for (uint32_t i = 0; i < numBlocks; i++)
+        {
+            auto index = delta.ReadValue<uint32_t>();
+            if (static_cast<size_t>(index) * RESYNC_BLOCK_SIZE >= mapLength)
+            {
+                throw std::runtime_error("Map block out of range");
+            }
+            delta.Read(&map[index * RESYNC_BLOCK_SIZE], GetResyncBlockLength(mapLength, index));
+        }
+
+        auto ms = MemoryStream(map.data(), map.size());
+        result = LoadMap(&ms);
+    }
+    catch (const std::exception&)
+    {
+    }
+    free(deltaData);
+    return result;
+}
+
 bool NetworkBase::LoadMap(IStream* stream)
 {
     bool result = false;
@@ -2757,6 +3427,8 @@ bool NetworkBase::LoadMap(IStream* stream)
         gCheatsDisableRideValueAging = stream->ReadValue<uint8_t>() != 0;
         gConfigGeneral.show_real_names_of_guests = stream->ReadValue<uint8_t>() != 0;
         gCheatsIgnoreResearchStatus = stream->ReadValue<uint8_t>() != 0;
+        gCheatsPathfindingBudget = stream->ReadValue<uint32_t>();
+        gCheatsRideRatingsPerTick = stream->ReadValue<uint8_t>();
 
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         result = true;
@@ -2767,17 +3439,23 @@ bool NetworkBase::LoadMap(IStream* stream)
     return result;
 }
 
-bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool NetworkBase::SaveMap(
+    IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool rawChunks, size_t* chunksLength) const
 {
     bool result = false;
-    map_reorganise_elements();
     viewport_set_saved_view();
     try
     {
         auto s6exporter = std::make_unique<S6Exporter>();
         s6exporter->ExportObjectsList = objects;
+        s6exporter->CompressChunks = true;
+        s6exporter->RawChunks = rawChunks;
         s6exporter->Export();
         s6exporter->SaveGame(stream);
+        if (chunksLength != nullptr)
+        {
+            *chunksLength = s6exporter->GetChunksLength();
+        }
 
         // Write other data not in normal save files
         stream->WriteValue<uint32_t>(gGamePaused);
@@ -2806,6 +3484,8 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
         stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
         stream->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
         stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
+        stream->WriteValue<uint32_t>(gCheatsPathfindingBudget);
+        stream->WriteValue<uint8_t>(gCheatsRideRatingsPerTick);
 
         result = true;
     }
@@ -2892,15 +3572,23 @@ void NetworkBase::Server_Handle_CHAT(NetworkConnection& connection, NetworkPacke
 
 void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
-    uint32_t tick;
-    uint32_t actionType;
-    packet >> tick >> actionType;
+    if (!ReadGameActions(packet, [this](uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size) {
+            ClientEnqueueGameAction(tick, actionType, data, size);
+        }))
+    {
+        log_error("Received invalid game actions from the server.");
+    }
 
-    MemoryStream stream;
-    const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.WriteArray(packet.Read(size), size);
-    stream.SetPosition(0);
+    if (IsRelay())
+    {
+        SendRelayGameActions();
+    }
+}
 
+void NetworkBase::ClientEnqueueGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size)
+{
+    // Read straight from the received data without copying it
+    MemoryStream stream(data, size);
     DataSerialiser ds(false, stream);
 
     GameAction::Ptr action = GameActions::Create(actionType);
@@ -2923,21 +3611,48 @@ void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection&
         }
     }
 
+    if (IsRelay())
+    {
+        RelayQueueGameAction(tick, *action);
+    }
+
     GameActions::Enqueue(std::move(action), tick);
 }
 
 void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet)
 {
-    uint32_t tick;
-    uint32_t actionType;
-
-    NetworkPlayer* player = connection.Player;
-    if (player == nullptr)
+    if (connection.Player == nullptr)
     {
         return;
     }
 
-    packet >> tick >> actionType;
+    if (!ReadGameActions(packet, [this, &connection](uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size) {
+            ServerEnqueueGameAction(connection, tick, actionType, data, size);
+        }))
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+    }
+}
+
+static bool network_group_can_run_action(const NetworkGroup& group, uint32_t actionType)
+{
+    if (actionType == GAME_COMMAND_CUSTOM)
+    {
+        return true;
+    }
+    if (!group.CanPerformCommand(actionType))
+    {
+        return false;
+    }
+    // Scattering scenery also needs the permission to use the scatter tool
+    return actionType != GAME_COMMAND_SCATTER_SCENERY || group.CanPerformCommand(MISC_COMMAND_TOGGLE_SCENERY_CLUSTER);
+}
+
+void NetworkBase::ServerEnqueueGameAction(
+    NetworkConnection& connection, uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size)
+{
+    NetworkPlayer* player = connection.Player;
 
     // Don't let clients send pause or quit
     if (actionType == GAME_COMMAND_TOGGLE_PAUSE || actionType == GAME_COMMAND_LOAD_OR_QUIT)
@@ -2945,15 +3660,12 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         return;
     }
 
-    if (actionType != GAME_COMMAND_CUSTOM)
+    // Check if player's group permission allows command to run
+    const NetworkGroup* group = GetGroupByID(connection.Player->Group);
+    if (group == nullptr || !network_group_can_run_action(*group, actionType))
     {
-        // Check if player's group permission allows command to run
-        NetworkGroup* group = GetGroupByID(connection.Player->Group);
-        if (group == nullptr || group->CanPerformCommand(actionType) == false)
-        {
-            Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
-            return;
-        }
+        Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
+        return;
     }
 
     // Create and enqueue the action.
@@ -2986,10 +3698,8 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         }
     }
 
-    DataSerialiser stream(false);
-    const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.GetStream().WriteArray(packet.Read(size), size);
-    stream.GetStream().SetPosition(0);
+    MemoryStream dataStream(data, size);
+    DataSerialiser stream(false, dataStream);
 
     ga->Serialise(stream);
     // Set player to sender, should be 0 if sent from client.
@@ -3010,12 +3720,20 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
     tickData.srand0 = srand0;
     tickData.tick = serverTick;
 
+    if (flags & NETWORK_TICK_FLAG_STATE_HASH)
+    {
+        uint32_t stateHash;
+        packet >> stateHash;
+        tickData.stateHash = stateHash;
+    }
+
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
         const char* text = packet.ReadString();
         if (text != nullptr)
         {
             tickData.spriteHash = text;
+            tickData.spriteHashChunked = (flags & NETWORK_TICK_FLAG_CHUNKED_CHECKSUMS) != 0;
         }
     }
 
@@ -3197,6 +3915,471 @@ void NetworkBase::Client_Handle_GAMEINFO([[maybe_unused]] NetworkConnection& con
     network_chat_show_server_greeting();
 }
 
+bool NetworkBase::IsRelay() const
+{
+    return mode == NETWORK_MODE_CLIENT && _listenSocket != nullptr;
+}
+
+void NetworkBase::UpdateRelay()
+{
+    for (auto& connection : client_connection_list)
+    {
+        // This can be called multiple times before the connection is removed.
+        if (connection->IsDisconnected)
+            continue;
+
+        if (!ProcessConnection(*connection))
+        {
+            connection->IsDisconnected = true;
+        }
+    }
+
+    uint32_t ticks = platform_get_ticks();
+    if (ticks > last_ping_sent_time + 3000)
+    {
+        Server_Send_PING();
+    }
+
+    // Clients are only let in once there is a map to send them
+    if (_clientMapLoaded)
+    {
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
+    }
+
+    for (auto it = _relayActionOrigins.begin(); it != _relayActionOrigins.end();)
+    {
+        if (gCurrentTicks - it->second.Tick > RELAY_ACTION_TIMEOUT_TICKS)
+        {
+            it = _relayActionOrigins.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    _relayBacklog.erase(
+        std::remove_if(
+            _relayBacklog.begin(), _relayBacklog.end(),
+            [](const RelayBacklogEntry& entry) { return entry.Tick < gCurrentTicks; }),
+        _relayBacklog.end());
+
+    // Send what the packets handled above have queued
+    _ioThread->Wake();
+}
+
+void NetworkBase::ProcessDisconnectedRelayClients()
+{
+    for (auto it = client_connection_list.begin(); it != client_connection_list.end();)
+    {
+        auto& connection = *it;
+        if (!connection->IsDisconnected)
+        {
+            it++;
+            continue;
+        }
+
+        if (connection->AuthStatus == NetworkAuth::Ok)
+        {
+            std::string text = std::string("Client ") + connection->RelayedName + " has left the relay";
+            AppendServerLog(text);
+            log_info(text.c_str());
+        }
+
+        // The actions of the client that are still on their way are passed on like anyone else's
+        for (auto origin = _relayActionOrigins.begin(); origin != _relayActionOrigins.end();)
+        {
+            if (origin->second.Connection == connection.get())
+            {
+                origin = _relayActionOrigins.erase(origin);
+            }
+            else
+            {
+                origin++;
+            }
+        }
+        for (auto& action : _relayGameActions)
+        {
+            if (action.Origin == connection.get())
+            {
+                action.Origin = nullptr;
+            }
+        }
+
+        _ioThread->RemoveConnection(*connection);
+        it = client_connection_list.erase(it);
+    }
+}
+
+void NetworkBase::RelayPacket(const NetworkPacket& packet)
+{
+    switch (packet.GetCommand())
+    {
+        case NetworkCommand::Tick:
+        case NetworkCommand::PlayerList:
+        case NetworkCommand::PlayerInfo:
+        {
+            // These start with the tick they are for, clients that are sent the map before it has been run need them
+            uint32_t tick = 0;
+            if (packet.Data.size() >= sizeof(tick))
+            {
+                std::memcpy(&tick, packet.Data.data(), sizeof(tick));
+                tick = ByteSwapBE(tick);
+            }
+            auto buffer = packet.Serialise();
+            SendPacketToRelayClients(buffer);
+            _relayBacklog.push_back({ tick, std::move(buffer) });
+            break;
+        }
+        case NetworkCommand::Chat:
+        case NetworkCommand::Event:
+        case NetworkCommand::GroupList:
+        case NetworkCommand::PingList:
+            SendPacketToRelayClients(packet.Serialise());
+            break;
+        default:
+            break;
+    }
+}
+
+void NetworkBase::SendPacketToRelayClients(const NetworkPacketBuffer& buffer)
+{
+    // While the relay loads a new map its clients are sent nothing, they get the map and the backlog once it is loaded
+    if (!_clientMapLoaded)
+    {
+        return;
+    }
+
+    for (auto& connection : client_connection_list)
+    {
+        if (connection->RelayedJoined && !connection->IsDisconnected)
+        {
+            connection->QueuePacket(buffer);
+        }
+    }
+}
+
+static std::vector<uint8_t> network_serialise_game_action(const GameAction& action, MemoryStream& stream)
+{
+    stream.Clear();
+    DataSerialiser ds(true, stream);
+    action.Serialise(ds);
+    const auto* data = static_cast<const uint8_t*>(stream.GetData());
+    return std::vector<uint8_t>(data, data + stream.GetLength());
+}
+
+void NetworkBase::RelayQueueGameAction(uint32_t tick, GameAction& action)
+{
+    // Each batch is for a single tick so it can be dropped from the backlog once that tick has been run
+    if (!_relayGameActions.empty() && _relayGameActions.back().Tick != tick)
+    {
+        SendRelayGameActions();
+    }
+
+    RelayGameAction relayAction{};
+    relayAction.Tick = tick;
+    relayAction.Type = action.GetType();
+
+    const uint32_t networkId = action.GetNetworkId();
+    if (player_id == action.GetPlayer().id)
+    {
+        // The client the action came from gets it back with its own network id, so its callback is run
+        auto it = _relayActionOrigins.find(networkId);
+        if (it != _relayActionOrigins.end())
+        {
+            relayAction.Origin = it->second.Connection;
+            action.SetNetworkId(it->second.NetworkId);
+            relayAction.OriginData = network_serialise_game_action(action, _gameActionStream);
+            _relayActionOrigins.erase(it);
+        }
+    }
+
+    // None of the clients give out network id 0, so they do not run their callbacks for the actions of others
+    action.SetNetworkId(0);
+    relayAction.Data = network_serialise_game_action(action, _gameActionStream);
+    action.SetNetworkId(networkId);
+
+    _relayGameActions.push_back(std::move(relayAction));
+}
+
+static void network_write_relay_game_action(
+    NetworkPacket& actions, uint32_t tick, uint32_t actionType, const std::vector<uint8_t>& data)
+{
+    actions << tick << actionType << static_cast<uint32_t>(data.size());
+    actions.Write(data.data(), data.size());
+}
+
+void NetworkBase::SendRelayGameActions()
+{
+    if (_relayGameActions.empty())
+    {
+        return;
+    }
+
+    const auto count = static_cast<uint32_t>(_relayGameActions.size());
+    NetworkPacket actions;
+    std::vector<NetworkConnection*> origins;
+    for (const auto& action : _relayGameActions)
+    {
+        network_write_relay_game_action(actions, action.Tick, action.Type, action.Data);
+        if (action.Origin != nullptr && std::find(origins.begin(), origins.end(), action.Origin) == origins.end())
+        {
+            origins.push_back(action.Origin);
+        }
+    }
+    auto buffer = network_make_game_actions_packet(actions.Data, count).Serialise();
+
+    if (_clientMapLoaded)
+    {
+        // Only the clients that sent some of the actions need a packet of their own
+        for (auto* origin : origins)
+        {
+            if (!origin->RelayedJoined || origin->IsDisconnected)
+                continue;
+
+            NetworkPacket originActions;
+            for (const auto& action : _relayGameActions)
+            {
+                const auto& data = action.Origin == origin ? action.OriginData : action.Data;
+                network_write_relay_game_action(originActions, action.Tick, action.Type, data);
+            }
+            origin->QueuePacket(network_make_game_actions_packet(originActions.Data, count));
+        }
+
+        for (auto& connection : client_connection_list)
+        {
+            if (!connection->RelayedJoined || connection->IsDisconnected)
+                continue;
+            if (std::find(origins.begin(), origins.end(), connection.get()) != origins.end())
+                continue;
+
+            connection->QueuePacket(buffer);
+        }
+    }
+
+    _relayBacklog.push_back({ _relayGameActions.front().Tick, std::move(buffer) });
+    _relayGameActions.clear();
+}
+
+void NetworkBase::SendRelayBacklog(NetworkConnection& connection)
+{
+    for (const auto& entry : _relayBacklog)
+    {
+        if (entry.Tick >= gCurrentTicks)
+        {
+            connection.QueuePacket(entry.Buffer);
+        }
+    }
+}
+
+/**
+ * Sends the map as the relay has it now to one of its clients, or to all of them after it has loaded a new one. It is
+ * followed by what has been relayed for the ticks that have not been run yet.
+ */
+void NetworkBase::Relay_Send_MAP(NetworkConnection* connection)
+{
+    // The actions that have been received are either part of the map or in the backlog after this
+    SendRelayGameActions();
+
+    if (connection == nullptr)
+    {
+        // This will send all custom objects to the clients, as Server_Send_MAP does after a new park has been loaded
+        auto& objManager = GetContext()->GetObjectManager();
+        auto objects = objManager.GetPackableObjects();
+        _mapStreamValid = false;
+        for (auto& client : client_connection_list)
+        {
+            if (client->RelayedJoined && !client->IsDisconnected)
+            {
+                client->RequestedObjects = objects;
+                Relay_Send_MAP(client.get());
+            }
+        }
+        return;
+    }
+
+    Relay_Send_PLAYERLIST(*connection);
+    Server_Send_MAP(connection);
+    Server_Send_GROUPLIST(*connection);
+    SendRelayBacklog(*connection);
+    connection->RelayedJoined = true;
+}
+
+void NetworkBase::Relay_Send_PLAYERLIST(NetworkConnection& connection)
+{
+    NetworkPacket packet(NetworkCommand::PlayerList);
+    packet << gCurrentTicks << static_cast<uint8_t>(player_list.size());
+    for (auto& player : player_list)
+    {
+        player->Write(packet);
+    }
+    connection.QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        return;
+    }
+
+    const char* gameversion = packet.ReadString();
+    const char* name = packet.ReadString();
+    const char* password = packet.ReadString();
+    const char* pubkey = packet.ReadString();
+    VerifyAuthKey(connection, packet, pubkey);
+
+    // The groups are the server's, the relay only has its own password
+    if (!gameversion || network_get_version() != gameversion)
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+    }
+    else if (!name)
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+    }
+    else if ((!password || strlen(password) == 0) && !_password.empty())
+    {
+        connection.AuthStatus = NetworkAuth::RequirePassword;
+    }
+    else if (password && _password != password)
+    {
+        connection.AuthStatus = NetworkAuth::BadPassword;
+    }
+
+    auto numClients = std::count_if(
+        client_connection_list.begin(), client_connection_list.end(),
+        [](const std::unique_ptr<NetworkConnection>& client) { return client->AuthStatus == NetworkAuth::Ok; });
+    if (gConfigNetwork.maxplayers <= numClients)
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+    }
+    else if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        connection.AuthStatus = NetworkAuth::Ok;
+        connection.RelayedName = name;
+
+        auto& objManager = GetContext()->GetObjectManager();
+        auto objects = objManager.GetPackableObjects();
+        Server_Send_OBJECTS_LIST(connection, objects);
+        Server_Send_SCRIPTS(connection);
+
+        std::string text = std::string("Client ") + name + " (" + connection.Key.PublicKeyHash() + ") has joined the relay";
+        AppendServerLog(text);
+        log_info(text.c_str());
+    }
+    else if (connection.AuthStatus != NetworkAuth::RequirePassword)
+    {
+        log_error("Unknown failure (%d) while authenticating relayed client", connection.AuthStatus);
+    }
+    Server_Send_AUTH(connection);
+}
+
+void NetworkBase::Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!network_read_requested_objects(connection, packet))
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+        log_warning("Client %s requested invalid amount of objects", connection.RelayedName.c_str());
+        return;
+    }
+
+    if (!_clientMapLoaded)
+    {
+        // Sent the map along with the other clients once the relay has loaded it
+        connection.RelayedJoined = true;
+        return;
+    }
+    Relay_Send_MAP(&connection);
+}
+
+void NetworkBase::Relay_Handle_MAPRESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    // Like the map, the blocks are followed by what has been relayed for the ticks that have not been run yet
+    SendRelayGameActions();
+    Server_Handle_MAPRESYNC(connection, packet);
+    SendRelayBacklog(connection);
+}
+
+void NetworkBase::Relay_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet)
+{
+    auto szText = packet.ReadString();
+    if (szText == nullptr || szText[0] == '\0' || !connection.RelayedJoined)
+        return;
+
+    auto* player = GetPlayerByID(player_id);
+    const NetworkGroup* group = player != nullptr ? GetGroupByID(player->Group) : nullptr;
+    if (group == nullptr || !group->CanPerformCommand(MISC_COMMAND_CHAT))
+        return;
+
+    // The server sends it on as the relay's player, the name of the client is kept in the text
+    std::string text = std::string("[") + connection.RelayedName + "] " + szText;
+    Client_Send_CHAT(text.c_str());
+}
+
+void NetworkBase::Relay_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!connection.RelayedJoined)
+    {
+        return;
+    }
+
+    if (!ReadGameActions(packet, [this, &connection](uint32_t, uint32_t actionType, const uint8_t* data, size_t size) {
+            RelayForwardGameAction(connection, actionType, data, size);
+        }))
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CLIENT_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+    }
+}
+
+/**
+ * Sends a game action of a client on to the server as the relay's own. It gets a network id of the relay, so the action
+ * can be given back to the client with the one it used when the server sends it back.
+ */
+void NetworkBase::RelayForwardGameAction(
+    NetworkConnection& connection, uint32_t actionType, const uint8_t* data, size_t size)
+{
+    // Don't let clients send pause or quit
+    if (actionType == GAME_COMMAND_TOGGLE_PAUSE || actionType == GAME_COMMAND_LOAD_OR_QUIT)
+    {
+        return;
+    }
+
+    // The server would refuse it as well, the client is told straight away rather than the relay
+    auto* player = GetPlayerByID(player_id);
+    const NetworkGroup* group = player != nullptr ? GetGroupByID(player->Group) : nullptr;
+    if (group == nullptr || !network_group_can_run_action(*group, actionType))
+    {
+        Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
+        return;
+    }
+
+    GameAction::Ptr action = GameActions::Create(actionType);
+    if (action == nullptr)
+    {
+        log_error(
+            "Received unregistered game action type: 0x%08X from relayed client %s", actionType,
+            connection.RelayedName.c_str());
+        return;
+    }
+
+    MemoryStream dataStream(data, size);
+    DataSerialiser stream(false, dataStream);
+    action->Serialise(stream);
+
+    const uint32_t networkId = ++_actionId;
+    _relayActionOrigins[networkId] = { &connection, action->GetNetworkId(), gCurrentTicks };
+    action->SetNetworkId(networkId);
+    action->SetPlayer(NetworkPlayerId_t{ player_id });
+    QueueGameAction(action.get());
+}
+
 void network_set_env(const std::shared_ptr<IPlatformEnvironment>& env)
 {
     gNetwork.SetEnvironment(env);
@@ -3227,6 +4410,11 @@ int32_t network_begin_server(int32_t port, const std::string& address)
     return gNetwork.BeginServer(port, address);
 }
 
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& listenAddress)
+{
+    return gNetwork.BeginRelay(host, port, listenPort, listenAddress);
+}
+
 void network_update()
 {
     gNetwork.Update();
@@ -3267,6 +4455,11 @@ void network_request_gamestate_snapshot()
     return gNetwork.RequestStateSnapshot();
 }
 
+void network_request_resync()
+{
+    gNetwork.RequestResync();
+}
+
 void network_send_tick()
 {
     gNetwork.Server_Send_TICK();
@@ -3959,6 +5152,16 @@ NetworkStats_t network_get_stats()
     return gNetwork.GetStats();
 }
 
+NetworkStats_t network_get_player_stats(uint32_t id)
+{
+    auto conn = gNetwork.GetPlayerConnection(id);
+    if (conn != nullptr)
+    {
+        return conn->GetStats();
+    }
+    return NetworkStats_t{};
+}
+
 NetworkServerState_t network_get_server_state()
 {
     return gNetwork.GetServerState();
@@ -4011,6 +5214,9 @@ bool network_check_desynchronisation()
 void network_request_gamestate_snapshot()
 {
 }
+void network_request_resync()
+{
+}
 void network_send_game_action(const GameAction* action)
 {
 }
@@ -4031,6 +5237,10 @@ int32_t network_begin_server(int32_t port, const std::string& address)
 {
     return 1;
 }
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& listenAddress)
+{
+    return 1;
+}
 int32_t network_get_num_players()
 {
     return 1;
@@ -4230,6 +5440,10 @@ NetworkStats_t network_get_stats()
 {
     return NetworkStats_t{};
 }
+NetworkStats_t network_get_player_stats(uint32_t id)
+{
+    return NetworkStats_t{};
+}
 NetworkServerState_t network_get_server_state()
 {
     return NetworkServerState_t{};
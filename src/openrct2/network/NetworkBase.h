@@ -3,12 +3,16 @@
 #include "../actions/GameAction.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
+#include "NetworkIoThread.h"
 #include "NetworkPlayer.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -20,6 +24,7 @@ public:
 public: // Uncategorized
     bool BeginServer(uint16_t port, const std::string& address);
     bool BeginClient(const std::string& host, uint16_t port);
+    bool BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress);
 
 public: // Common
     void SetEnvironment(const std::shared_ptr<OpenRCT2::IPlatformEnvironment>& env);
@@ -42,8 +47,14 @@ public: // Common
     void AppendChatLog(const std::string& s);
     void CloseChatLog();
     NetworkStats_t GetStats() const;
+    void LogStats() const;
     json_t GetServerInfoAsJson() const;
     bool ProcessConnection(NetworkConnection& connection);
+    bool ReceivedPacketRecently(NetworkConnection& connection);
+    void QueueGameAction(const GameAction* action);
+    void SendGameActions();
+    bool ReadGameActions(
+        NetworkPacket& packet, const std::function<void(uint32_t, uint32_t, const uint8_t*, size_t)>& enqueue) const;
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -68,8 +79,10 @@ public: // Server
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
-    bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    bool SaveMap(
+        OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool rawChunks = false,
+        size_t* chunksLength = nullptr) const;
+    bool save_for_network(const std::vector<const ObjectRepositoryItem*>& objects);
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
@@ -96,13 +109,17 @@ public: // Server
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_HEARTBEAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void VerifyAuthKey(NetworkConnection& connection, NetworkPacket& packet, const char* pubkey);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerEnqueueGameAction(
+        NetworkConnection& connection, uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size);
     void Server_Handle_PING(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAMEINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_MAPRESYNC(NetworkConnection& connection, NetworkPacket& packet);
 
 public: // Client
     void Reconnect();
@@ -117,10 +134,12 @@ public: // Client
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
     void RequestStateSnapshot();
+    void RequestResync();
     bool IsDesynchronised();
     NetworkServerState_t GetServerState() const;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
+    bool LoadMapDelta();
     void UpdateClient();
 
     // Packet dispatchers.
@@ -140,6 +159,7 @@ public: // Client
     void Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
+    void ClientEnqueueGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size);
     void Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet);
@@ -154,12 +174,35 @@ public: // Client
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_MAPDELTA(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
     NetworkKey _key;
     NetworkUserManager _userManager;
 
+public: // Relay
+    bool IsRelay() const;
+    void UpdateRelay();
+    void ProcessDisconnectedRelayClients();
+    void RelayPacket(const NetworkPacket& packet);
+    void RelayQueueGameAction(uint32_t tick, GameAction& action);
+    void RelayForwardGameAction(NetworkConnection& connection, uint32_t actionType, const uint8_t* data, size_t size);
+    void SendPacketToRelayClients(const NetworkPacketBuffer& buffer);
+    void SendRelayGameActions();
+    void SendRelayBacklog(NetworkConnection& connection);
+
+    // Packet dispatchers.
+    void Relay_Send_MAP(NetworkConnection* connection = nullptr);
+    void Relay_Send_PLAYERLIST(NetworkConnection& connection);
+
+    // Handlers.
+    void Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_MAPRESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
+
 public: // Public common
     std::string ServerName;
     std::string ServerDescription;
@@ -183,10 +226,15 @@ private: // Common Data
     bool _closeLock = false;
     bool _requireClose = false;
     bool wsa_initialized = false;
+    // The game actions to send, they go out together in one packet when the network is next flushed
+    NetworkPacket _pendingGameActions;
+    uint32_t _numPendingGameActions = 0;
+    OpenRCT2::MemoryStream _gameActionStream;
 
 private: // Server Data
     std::unordered_map<NetworkCommand, CommandHandler> server_command_handlers;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<NetworkIoThread> _ioThread;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::string _serverLogPath;
@@ -194,6 +242,15 @@ private: // Server Data
     std::ofstream _server_log_fs;
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
+    // Reused for every map that is sent, so it only has to grow the first time
+    OpenRCT2::MemoryStream _mapStream;
+    // What _mapStream was saved for, clients that request the same objects in the same tick are sent it as it is
+    bool _mapStreamValid = false;
+    uint32_t _mapStreamTick = 0;
+    std::vector<const ObjectRepositoryItem*> _mapStreamObjects;
+    NetworkStats_t _mapStats = {};
+    uint32_t _lastChecksumTick = 0;
+    uint32_t _lastStatsLogTime = 0;
 
 private: // Client Data
     struct PlayerListUpdate
@@ -206,6 +263,8 @@ private: // Client Data
         uint32_t srand0;
         uint32_t tick;
         std::string spriteHash;
+        bool spriteHashChunked = false;
+        std::optional<uint32_t> stateHash;
     };
 
     std::unordered_map<NetworkCommand, CommandHandler> client_command_handlers;
@@ -219,6 +278,10 @@ private: // Client Data
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::string _password;
     OpenRCT2::MemoryStream _serverGameState;
+    // The map as it was when the client asked to be resynchronised, the blocks sent by the server are applied on top of it
+    OpenRCT2::MemoryStream _resyncBase;
+    OpenRCT2::MemoryStream _resyncDelta;
+    bool _resyncPending = false;
     NetworkServerState_t _serverState;
     uint32_t _lastSentHeartbeat = 0;
     uint32_t last_ping_sent_time = 0;
@@ -230,6 +293,44 @@ private: // Client Data
     SocketStatus _lastConnectStatus = SocketStatus::Closed;
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
+
+private: // Relay Data
+    // A relay is a client of the server that also accepts clients of its own on _listenSocket. They are kept in
+    // client_connection_list and served by _ioThread like the clients of a server.
+    struct RelayGameAction
+    {
+        uint32_t Tick;
+        uint32_t Type;
+        // Serialised without the network id, which is the relay's own
+        std::vector<uint8_t> Data;
+        // The client the action came from and the action serialised with the network id that client gave it
+        NetworkConnection* Origin;
+        std::vector<uint8_t> OriginData;
+    };
+
+    struct RelayActionOrigin
+    {
+        NetworkConnection* Connection;
+        uint32_t NetworkId;
+        uint32_t Tick;
+    };
+
+    struct RelayBacklogEntry
+    {
+        uint32_t Tick;
+        NetworkPacketBuffer Buffer;
+    };
+
+    std::unordered_map<NetworkCommand, CommandHandler> relay_command_handlers;
+    // The game actions received from the server since the last ones were passed on
+    std::vector<RelayGameAction> _relayGameActions;
+    // The game actions of the relay's clients that have been sent to the server, by the network id the relay gave them
+    std::unordered_map<uint32_t, RelayActionOrigin> _relayActionOrigins;
+    // The ticks, game actions and player lists passed on for ticks that have not been run yet. A client that is sent the
+    // map gets these after it, as they are no longer part of it.
+    std::deque<RelayBacklogEntry> _relayBacklog;
+    std::string _relayAddress;
+    uint16_t _relayPort = 0;
 };
 
 #endif // DISABLE_NETWORK
@@ -17,6 +17,9 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <array>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
 
@@ -89,7 +92,8 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            std::lock_guard<std::mutex> lock(_mutex);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -98,69 +102,151 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    {
+        QueuePacket(packet.Serialise(), front);
+    }
+}
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth(packet.GetCommand()))
+    {
+        QueuePacket(packet.Serialise(), front);
+    }
+}
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
+void NetworkConnection::QueuePacket(const NetworkPacketBuffer& buffer, bool front)
+{
+    if (AuthStatus != NetworkAuth::Ok && NetworkPacket::CommandRequiresAuth(buffer.Command))
     {
-        packet.BytesTransferred += sent;
+        return;
     }
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+    OutboundPacket packet{ buffer, 0, platform_get_ticks() };
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (front)
     {
-        RecordPacketStats(packet, true);
+        // If the first packet was already partially sent add new packet to second position
+        if (!_outboundPackets.empty() && _outboundPackets.front().BytesSent > 0)
+        {
+            auto it = _outboundPackets.begin();
+            it++; // Second position
+            _outboundPackets.insert(it, std::move(packet));
+        }
+        else
+        {
+            _outboundPackets.push_front(std::move(packet));
+        }
+    }
+    else
+    {
+        _outboundPackets.push_back(std::move(packet));
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::SendQueuedPackets()
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (!_outboundPackets.empty())
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
-        if (front)
+        // Hand as many of the queued packets to the socket as it takes in one call
+        std::array<SocketBuffer, SOCKET_MAX_SEND_BUFFERS> buffers;
+        size_t count = 0;
+        size_t size = 0;
+        for (auto it = _outboundPackets.begin(); it != _outboundPackets.end() && count < buffers.size(); it++)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
+            const auto& bytes = *it->Buffer.Bytes;
+            buffers[count++] = { bytes.data() + it->BytesSent, bytes.size() - it->BytesSent };
+            size += bytes.size() - it->BytesSent;
+        }
+
+        size_t sent = Socket->SendData(buffers.data(), count);
+        for (size_t remaining = sent; remaining > 0;)
+        {
+            auto& packet = _outboundPackets.front();
+            size_t packetRemaining = packet.Buffer.Bytes->size() - packet.BytesSent;
+            if (remaining < packetRemaining)
             {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                packet.BytesSent += remaining;
+                break;
             }
-            else
+            remaining -= packetRemaining;
+            RecordPacketStats(packet.Buffer.Command, packet.Buffer.Bytes->size(), true);
+            RecordSendLatency(platform_get_ticks() - packet.QueueTime);
+            _outboundPackets.pop_front();
+        }
+
+        if (sent < size)
+        {
+            // The socket can not take any more for now
+            break;
+        }
+    }
+}
+
+bool NetworkConnection::HasQueuedPackets()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return !_outboundPackets.empty();
+}
+
+void NetworkConnection::ReceivePackets()
+{
+    try
+    {
+        NetworkReadPacket status;
+        do
+        {
+            status = ReadPacket();
+            if (status == NetworkReadPacket::Success)
             {
-                _outboundPackets.push_front(std::move(packet));
+                std::lock_guard<std::mutex> lock(_mutex);
+                _inboundPackets.push_back(std::move(InboundPacket));
+                InboundPacket = NetworkPacket();
             }
-        }
-        else
+        } while (status == NetworkReadPacket::Success);
+
+        if (status == NetworkReadPacket::Disconnected)
         {
-            _outboundPackets.push_back(std::move(packet));
+            _receiveClosed = true;
         }
     }
+    catch (const std::exception&)
+    {
+        _receiveClosed = true;
+    }
 }
 
-void NetworkConnection::SendQueuedPackets()
+bool NetworkConnection::PopInboundPacket(NetworkPacket& packet)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_inboundPackets.empty())
+    {
+        return false;
+    }
+    packet = std::move(_inboundPackets.front());
+    _inboundPackets.pop_front();
+    return true;
+}
+
+bool NetworkConnection::IsReceiveClosed() const
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    return _receiveClosed;
+}
+
+NetworkStats_t NetworkConnection::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto stats = _stats;
+    stats.queuedPackets = _outboundPackets.size();
+    for (const auto& packet : _outboundPackets)
     {
-        _outboundPackets.pop_front();
+        stats.queuedBytes += packet.Buffer.Bytes->size() - packet.BytesSent;
     }
+    return stats;
 }
 
 void NetworkConnection::ResetLastPacketTime()
@@ -207,17 +293,18 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+// Called with _mutex locked
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
             break;
         case NetworkCommand::Map:
+        case NetworkCommand::MapDelta:
             trafficGroup = NetworkStatisticsGroup::MapData;
             break;
         default:
@@ -227,14 +314,38 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
 
     if (sending)
     {
-        Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        _stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
+        _stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
     }
     else
     {
-        Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
-        Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        _stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
+        _stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
     }
+
+    // Packets from a peer can carry any command id, only the known ones are counted
+    if (EnumValue(command) < EnumValue(NetworkCommand::Max))
+    {
+        auto& commandStats = _stats.commands[EnumValue(command)];
+        if (sending)
+        {
+            commandStats.packetsSent++;
+            commandStats.bytesSent += packetSize;
+        }
+        else
+        {
+            commandStats.packetsReceived++;
+            commandStats.bytesReceived += packetSize;
+        }
+    }
+}
+
+// Called with _mutex locked
+void NetworkConnection::RecordSendLatency(uint32_t latency)
+{
+    _stats.sendLatencyTotal += latency;
+    _stats.sendLatencyCount++;
+    _stats.sendLatencyMax = std::max(_stats.sendLatencyMax, latency);
 }
 
 #endif
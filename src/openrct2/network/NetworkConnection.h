@@ -16,8 +16,11 @@
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
+#    include <atomic>
 #    include <deque>
 #    include <memory>
+#    include <mutex>
+#    include <string>
 #    include <vector>
 
 class NetworkPlayer;
@@ -29,40 +32,61 @@ public:
     std::unique_ptr<ITcpSocket> Socket = nullptr;
     NetworkPacket InboundPacket;
     NetworkAuth AuthStatus = NetworkAuth::None;
-    NetworkStats_t Stats = {};
     NetworkPlayer* Player = nullptr;
     uint32_t PingTime = 0;
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool IsDisconnected = false;
+    // Clients of a relay play as the relay's player, they are only known by the name they joined with
+    std::string RelayedName;
+    // Set once a client of a relay has been sent the map, from then on it is sent the ticks and game actions
+    bool RelayedJoined = false;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
     void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    // Used to send the same packet to several connections without serialising it for each of them
+    void QueuePacket(const NetworkPacketBuffer& buffer, bool front = false);
 
     void SendQueuedPackets();
+    bool HasQueuedPackets();
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
+    NetworkStats_t GetStats();
+
+    // Used when the socket is read by the network I/O thread, which calls ReceivePackets to queue the complete packets
+    // for PopInboundPacket on the game thread.
+    void ReceivePackets();
+    bool PopInboundPacket(NetworkPacket& packet);
+    bool IsReceiveClosed() const;
 
     const utf8* GetLastDisconnectReason() const;
     void SetLastDisconnectReason(const utf8* src);
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
-    uint32_t _lastPacketTime = 0;
+    struct OutboundPacket
+    {
+        NetworkPacketBuffer Buffer;
+        size_t BytesSent;
+        uint32_t QueueTime;
+    };
+
+    // Guards the packet queues and the stats, which are shared with the network I/O thread
+    std::mutex _mutex;
+    std::deque<OutboundPacket> _outboundPackets;
+    std::deque<NetworkPacket> _inboundPackets;
+    NetworkStats_t _stats = {};
+    std::atomic<uint32_t> _lastPacketTime{ 0 };
+    std::atomic<bool> _receiveClosed{ false };
     utf8* _lastDisconnectReason = nullptr;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending);
+    void RecordSendLatency(uint32_t latency);
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIoThread.h"
+
+#    include "../core/Console.hpp"
+#    include "NetworkConnection.h"
+
+#    include <algorithm>
+
+// Without a way to wake the thread up queued packets wait for the next timeout, so it has to be short
+constexpr uint32_t WAIT_TIMEOUT_MS = 100;
+constexpr uint32_t WAIT_TIMEOUT_NO_WAKE_MS = 1;
+
+NetworkIoThread::NetworkIoThread()
+    : _poller(CreateSocketPoller())
+{
+    _thread = std::thread([this]() { Run(); });
+}
+
+NetworkIoThread::~NetworkIoThread()
+{
+    _stop = true;
+    _poller->Wake();
+    _thread.join();
+}
+
+void NetworkIoThread::AddConnection(NetworkConnection& connection)
+{
+    {
+        std::lock_guard<PROFILE_LOCKABLE_TYPE(std::mutex)> lock(_mutex);
+        _connections.push_back(&connection);
+        _connectionsVersion++;
+    }
+    Wake();
+}
+
+void NetworkIoThread::RemoveConnection(NetworkConnection& connection)
+{
+    std::lock_guard<PROFILE_LOCKABLE_TYPE(std::mutex)> lock(_mutex);
+    _connections.erase(std::remove(_connections.begin(), _connections.end(), &connection), _connections.end());
+    _connectionsVersion++;
+}
+
+void NetworkIoThread::Wake()
+{
+    // Only the first wake up after the thread starts waiting has to reach it
+    if (_waiting.exchange(false))
+    {
+        _poller->Wake();
+    }
+}
+
+void NetworkIoThread::Run()
+{
+    PROFILE_THREAD_NAME("Network I/O");
+    const uint32_t timeout = _poller->CanWake() ? WAIT_TIMEOUT_MS : WAIT_TIMEOUT_NO_WAKE_MS;
+    std::vector<NetworkConnection*> polled;
+    while (!_stop)
+    {
+        // Set before looking at the queues, packets queued after that either make the socket wait for writing
+        // or wake the wait up
+        _waiting = true;
+
+        uint32_t version;
+        {
+            std::lock_guard<PROFILE_LOCKABLE_TYPE(std::mutex)> lock(_mutex);
+            _poller->Clear();
+            polled.clear();
+            for (auto* connection : _connections)
+            {
+                // A closed connection stays readable, it would never let the wait block until the game removes it
+                if (!connection->IsReceiveClosed())
+                {
+                    _poller->Add(*connection->Socket, connection->HasQueuedPackets());
+                    polled.push_back(connection);
+                }
+            }
+            version = _connectionsVersion;
+        }
+
+        _poller->Wait(timeout);
+        _waiting = false;
+
+        PROFILE_ZONE("NetworkIoThread::Transfer");
+        std::lock_guard<PROFILE_LOCKABLE_TYPE(std::mutex)> lock(_mutex);
+        if (version == _connectionsVersion)
+        {
+            for (size_t i = 0; i < polled.size(); i++)
+            {
+                if (_poller->IsReadable(i))
+                {
+                    polled[i]->ReceivePackets();
+                }
+            }
+        }
+        else
+        {
+            // The results of the wait can not be matched up with the connections if any were added or removed meanwhile
+            for (auto* connection : _connections)
+            {
+                if (!connection->IsReceiveClosed())
+                {
+                    connection->ReceivePackets();
+                }
+            }
+        }
+        for (auto* connection : _connections)
+        {
+            if (connection->HasQueuedPackets())
+            {
+                try
+                {
+                    connection->SendQueuedPackets();
+                }
+                catch (const std::exception& e)
+                {
+                    log_verbose("Unable to send packets: %s", e.what());
+                }
+            }
+        }
+    }
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../Profiling.h"
+#    include "../common.h"
+#    include "Socket.h"
+
+#    include <atomic>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <vector>
+
+class NetworkConnection;
+
+/**
+ * A thread that waits on the sockets of the server's connections and does all their reading and writing. The game thread
+ * only handles the packets it has assembled and queues the ones to be sent.
+ */
+class NetworkIoThread final
+{
+public:
+    NetworkIoThread();
+    ~NetworkIoThread();
+
+    void AddConnection(NetworkConnection& connection);
+    // Does not return while the thread is still using the connection, so it can be destroyed afterwards
+    void RemoveConnection(NetworkConnection& connection);
+
+    // Lets the thread know that packets have been queued so they are sent without waiting for the socket timeout
+    void Wake();
+
+private:
+    std::unique_ptr<ISocketPoller> _poller;
+    PROFILE_LOCKABLE(std::mutex, _mutex, "NetworkIoThread");
+    std::vector<NetworkConnection*> _connections;
+    // Incremented whenever _connections changes, so results of a wait are not applied to the wrong connection
+    uint32_t _connectionsVersion = 0;
+    std::atomic<bool> _waiting{ false };
+    std::atomic<bool> _stop{ false };
+    std::thread _thread;
+
+    void Run();
+};
+
+#endif // DISABLE_NETWORK
@@ -12,8 +12,53 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
+#    include <mutex>
+
+// Serialised packets are short lived, so their storage is kept for the next ones rather than freed
+constexpr size_t MAX_POOLED_BUFFERS = 256;
+
+struct NetworkBufferPool
+{
+    std::mutex Mutex;
+    std::vector<std::unique_ptr<std::vector<uint8_t>>> Buffers;
+};
+
+static NetworkBufferPool& GetBufferPool()
+{
+    // Never destroyed, buffers can still be released by connections that are destroyed on exit
+    static auto* pool = new NetworkBufferPool();
+    return *pool;
+}
+
+static std::unique_ptr<std::vector<uint8_t>> AcquireBuffer()
+{
+    auto& pool = GetBufferPool();
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    if (pool.Buffers.empty())
+    {
+        return std::make_unique<std::vector<uint8_t>>();
+    }
+    auto buffer = std::move(pool.Buffers.back());
+    pool.Buffers.pop_back();
+    return buffer;
+}
+
+static void ReleaseBuffer(const std::vector<uint8_t>* buffer)
+{
+    // The buffers are created by AcquireBuffer and nothing else refers to them any more
+    std::unique_ptr<std::vector<uint8_t>> owned(const_cast<std::vector<uint8_t>*>(buffer));
+    owned->clear();
+
+    auto& pool = GetBufferPool();
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    if (pool.Buffers.size() < MAX_POOLED_BUFFERS)
+    {
+        pool.Buffers.push_back(std::move(owned));
+    }
+}
 
 NetworkPacket::NetworkPacket(NetworkCommand id)
     : Header{ 0, id }
@@ -44,7 +89,12 @@ void NetworkPacket::Clear()
 
 bool NetworkPacket::CommandRequiresAuth()
 {
-    switch (GetCommand())
+    return CommandRequiresAuth(GetCommand());
+}
+
+bool NetworkPacket::CommandRequiresAuth(NetworkCommand command)
+{
+    switch (command)
     {
         case NetworkCommand::Ping:
         case NetworkCommand::Auth:
@@ -59,6 +109,28 @@ bool NetworkPacket::CommandRequiresAuth()
     }
 }
 
+NetworkPacketBuffer NetworkPacket::Serialise() const
+{
+    auto header = Header;
+    header.Size = static_cast<uint16_t>(Data.size());
+
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size += sizeof(header.Id);
+    header.Size = Convert::HostToNetwork(header.Size);
+    header.Id = ByteSwapBE(header.Id);
+
+    auto bytes = AcquireBuffer();
+    bytes->reserve(sizeof(header) + Data.size());
+    bytes->insert(bytes->end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    bytes->insert(bytes->end(), Data.begin(), Data.end());
+
+    NetworkPacketBuffer buffer;
+    buffer.Command = Header.Id;
+    buffer.Bytes = std::shared_ptr<const std::vector<uint8_t>>(bytes.release(), ReleaseBuffer);
+    return buffer;
+}
+
 void NetworkPacket::Write(const void* bytes, size_t size)
 {
     const uint8_t* src = reinterpret_cast<const uint8_t*>(bytes);
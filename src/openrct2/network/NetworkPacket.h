@@ -25,6 +25,16 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * The bytes of a packet as they go out on the wire, the header included. They are not changed once they have been
+ * serialised, so the outbound queues of all the connections a packet is sent to can share them.
+ */
+struct NetworkPacketBuffer
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::shared_ptr<const std::vector<uint8_t>> Bytes;
+};
+
 struct NetworkPacket final
 {
     NetworkPacket() = default;
@@ -37,6 +47,10 @@ struct NetworkPacket final
 
     void Clear();
     bool CommandRequiresAuth();
+    static bool CommandRequiresAuth(NetworkCommand command);
+
+    // The storage of the returned buffer goes back to a pool once the last reference to it is gone
+    NetworkPacketBuffer Serialise() const;
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
@@ -23,6 +23,10 @@ enum
 enum
 {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    // The sprite checksum was calculated with SpriteChecksumAlgorithm::Chunked.
+    NETWORK_TICK_FLAG_CHUNKED_CHECKSUMS = 1 << 1,
+    // The tick carries the hash of a few values of the game state, see network_get_state_hash.
+    NETWORK_TICK_FLAG_STATE_HASH = 1 << 2,
 };
 
 enum
@@ -83,6 +87,8 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    MapResync,
+    MapDelta,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -141,8 +147,31 @@ enum class NetworkStatisticsGroup : uint32_t
     Max,
 };
 
+struct NetworkCommandStats_t
+{
+    uint64_t packetsReceived;
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t bytesSent;
+};
+
 struct NetworkStats_t
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    NetworkCommandStats_t commands[EnumValue(NetworkCommand::Max)];
+
+    // Packets waiting in the send queues
+    uint64_t queuedPackets;
+    uint64_t queuedBytes;
+
+    // Milliseconds from queueing a packet until the socket took the last of it
+    uint64_t sendLatencyTotal;
+    uint64_t sendLatencyCount;
+    uint32_t sendLatencyMax;
+
+    // The maps saved for clients, before and after their chunks were compressed
+    uint64_t mapsSaved;
+    uint64_t mapBytesUncompressed;
+    uint64_t mapBytesCompressed;
 };
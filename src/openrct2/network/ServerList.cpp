@@ -14,6 +14,7 @@
 #    include "../Context.h"
 #    include "../PlatformEnvironment.h"
 #    include "../config/Config.h"
+#    include "../core/File.h"
 #    include "../core/FileStream.hpp"
 #    include "../core/Guard.hpp"
 #    include "../core/Http.h"
@@ -26,11 +27,57 @@
 #    include "network.h"
 
 #    include <algorithm>
+#    include <ctime>
 #    include <numeric>
 #    include <optional>
 
 using namespace OpenRCT2;
 
+// How long the servers fetched from the master server are shown again without fetching them again, in seconds
+constexpr int64_t SERVER_LIST_CACHE_TTL = 5 * 60;
+
+// How long the master server has to reply, in seconds
+constexpr uint32_t MASTER_SERVER_TIMEOUT = 10;
+
+static std::vector<ServerListEntry> ReadServerEntries(json_t& jServers)
+{
+    std::vector<ServerListEntry> entries;
+    for (auto& jServer : jServers)
+    {
+        if (jServer.is_object())
+        {
+            auto entry = ServerListEntry::FromJson(jServer);
+            if (entry.has_value())
+            {
+                entries.push_back(*entry);
+            }
+        }
+    }
+    return entries;
+}
+
+static std::string GetServerListCachePath()
+{
+    auto env = GetContext()->GetPlatformEnvironment();
+    return env->GetFilePath(PATHID::CACHE_SERVERS);
+}
+
+static void WriteServerListCache(const json_t& jServers)
+{
+    try
+    {
+        json_t jCache = {
+            { "time", static_cast<int64_t>(std::time(nullptr)) },
+            { "servers", jServers },
+        };
+        Json::WriteToFile(GetServerListCachePath().c_str(), jCache, -1);
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to write server list cache: %s", e.what());
+    }
+}
+
 int32_t ServerListEntry::CompareTo(const ServerListEntry& other) const
 {
     const auto& a = *this;
@@ -345,6 +392,7 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
     request.url = masterServerUrl;
     request.method = Http::Method::GET;
     request.header["Accept"] = "application/json";
+    request.timeout = MASTER_SERVER_TIMEOUT;
     Http::DoAsync(request, [p](Http::Response& response) -> void {
         json_t root;
         try
@@ -375,20 +423,8 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
                     throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_ARRAY);
                 }
 
-                std::vector<ServerListEntry> entries;
-                for (auto& jServer : jServers)
-                {
-                    if (jServer.is_object())
-                    {
-                        auto entry = ServerListEntry::FromJson(jServer);
-                        if (entry.has_value())
-                        {
-                            entries.push_back(*entry);
-                        }
-                    }
-                }
-
-                p->set_value(entries);
+                WriteServerListCache(jServers);
+                p->set_value(ReadServerEntries(jServers));
             }
         }
         catch (...)
@@ -400,6 +436,33 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
 #    endif
 }
 
+std::optional<std::vector<ServerListEntry>> ServerList::ReadCachedOnlineServerList() const
+{
+    auto path = GetServerListCachePath();
+    if (!File::Exists(path))
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        auto jCache = Json::ReadFromFile(path.c_str());
+        auto time = Json::GetNumber<int64_t>(jCache["time"]);
+        auto age = static_cast<int64_t>(std::time(nullptr)) - time;
+        auto jServers = jCache["servers"];
+        if (age < 0 || age >= SERVER_LIST_CACHE_TTL || !jServers.is_array())
+        {
+            return std::nullopt;
+        }
+        return ReadServerEntries(jServers);
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to read server list cache: %s", e.what());
+        return std::nullopt;
+    }
+}
+
 uint32_t ServerList::GetTotalPlayerCount() const
 {
     return std::accumulate(_serverEntries.begin(), _serverEntries.end(), 0, [](uint32_t acc, const ServerListEntry& entry) {
@@ -67,6 +67,11 @@ public:
 
     std::future<std::vector<ServerListEntry>> FetchLocalServerListAsync() const;
     std::future<std::vector<ServerListEntry>> FetchOnlineServerListAsync() const;
+
+    /**
+     * Returns the servers of the last fetch from the master server, unless it was too long ago to show them again.
+     */
+    std::optional<std::vector<ServerListEntry>> ReadCachedOnlineServerList() const;
     uint32_t GetTotalPlayerCount() const;
 };
 
@@ -9,6 +9,8 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
+#    include <array>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -49,8 +51,10 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -566,6 +570,46 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, SOCKET_MAX_SEND_BUFFERS);
+#    ifdef _WIN32
+        std::array<WSABUF, SOCKET_MAX_SEND_BUFFERS> wsaBuffers;
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = const_cast<CHAR*>(static_cast<const CHAR*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers.data(), static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        std::array<iovec, SOCKET_MAX_SEND_BUFFERS> vectors;
+        for (size_t i = 0; i < count; i++)
+        {
+            vectors[i].iov_base = const_cast<void*>(buffers[i].Data);
+            vectors[i].iov_len = buffers[i].Size;
+        }
+        msghdr message{};
+        message.msg_iov = vectors.data();
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -629,6 +673,11 @@ public:
         return _ipAddress;
     }
 
+    SOCKET GetSocket() const
+    {
+        return _socket;
+    }
+
 private:
     explicit TcpSocket(SOCKET socket, const std::string& hostName, const std::string& ipAddress)
     {
@@ -883,6 +932,134 @@ private:
     }
 };
 
+#    ifdef _WIN32
+using PollDescriptor = WSAPOLLFD;
+static int32_t PollSockets(PollDescriptor* descriptors, size_t count, int32_t timeout)
+{
+    return WSAPoll(descriptors, static_cast<ULONG>(count), timeout);
+}
+#    else
+using PollDescriptor = pollfd;
+static int32_t PollSockets(PollDescriptor* descriptors, size_t count, int32_t timeout)
+{
+    return poll(descriptors, static_cast<nfds_t>(count), timeout);
+}
+#    endif
+
+class SocketPoller final : public ISocketPoller, protected Socket
+{
+private:
+    // A UDP socket bound to the loopback address, Wake sends a datagram to it to end a Wait early
+    SOCKET _wakeSocket = INVALID_SOCKET;
+    sockaddr_in _wakeAddress{};
+    std::vector<PollDescriptor> _descriptors;
+
+public:
+    SocketPoller()
+    {
+        _wakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (_wakeSocket == INVALID_SOCKET)
+        {
+            log_warning("Unable to create socket to wake up the network thread.");
+            return;
+        }
+
+        _wakeAddress.sin_family = AF_INET;
+        _wakeAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addressLength = sizeof(_wakeAddress);
+        if (bind(_wakeSocket, reinterpret_cast<sockaddr*>(&_wakeAddress), addressLength) != 0
+            || getsockname(_wakeSocket, reinterpret_cast<sockaddr*>(&_wakeAddress), &addressLength) != 0
+            || !SetNonBlocking(_wakeSocket, true))
+        {
+            log_warning("Unable to bind socket to wake up the network thread.");
+            closesocket(_wakeSocket);
+            _wakeSocket = INVALID_SOCKET;
+        }
+    }
+
+    ~SocketPoller() override
+    {
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            closesocket(_wakeSocket);
+        }
+    }
+
+    bool CanWake() const override
+    {
+        return _wakeSocket != INVALID_SOCKET;
+    }
+
+    void Clear() override
+    {
+        _descriptors.clear();
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            PollDescriptor descriptor{};
+            descriptor.fd = _wakeSocket;
+            descriptor.events = POLLIN;
+            _descriptors.push_back(descriptor);
+        }
+    }
+
+    void Add(const ITcpSocket& tcpSocket, bool write) override
+    {
+        PollDescriptor descriptor{};
+        descriptor.fd = static_cast<const TcpSocket&>(tcpSocket).GetSocket();
+        descriptor.events = write ? (POLLIN | POLLOUT) : POLLIN;
+        _descriptors.push_back(descriptor);
+    }
+
+    void Wait(uint32_t timeoutMs) override
+    {
+        if (PollSockets(_descriptors.data(), _descriptors.size(), static_cast<int32_t>(timeoutMs)) <= 0)
+        {
+            for (auto& descriptor : _descriptors)
+            {
+                descriptor.revents = 0;
+            }
+        }
+
+        // Drain the wake up datagrams so the next wait blocks again
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            char buffer[16];
+            while (recv(_wakeSocket, buffer, sizeof(buffer), 0) > 0)
+            {
+            }
+        }
+    }
+
+    void Wake() override
+    {
+        if (_wakeSocket != INVALID_SOCKET)
+        {
+            char value = 0;
+            sendto(
+                _wakeSocket, &value, sizeof(value), 0, reinterpret_cast<const sockaddr*>(&_wakeAddress), sizeof(_wakeAddress));
+        }
+    }
+
+    bool IsReadable(size_t index) const override
+    {
+        // Errors and hang ups are reported as readable, the receive that follows finds out what happened
+        return (GetEvents(index) & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) != 0;
+    }
+
+    bool IsWritable(size_t index) const override
+    {
+        return (GetEvents(index) & POLLOUT) != 0;
+    }
+
+private:
+    int32_t GetEvents(size_t index) const
+    {
+        // The wake socket comes before the TCP sockets
+        index += _wakeSocket != INVALID_SOCKET ? 1 : 0;
+        return index < _descriptors.size() ? _descriptors[index].revents : 0;
+    }
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -895,6 +1072,12 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+    return std::make_unique<SocketPoller>();
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
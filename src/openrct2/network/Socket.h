@@ -33,6 +33,18 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+// The most buffers that are sent with one call, any after them are left for the next
+constexpr size_t SOCKET_MAX_SEND_BUFFERS = 64;
+
+/**
+ * A piece of memory to send, several of them can be sent with one call.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents an address and port.
  */
@@ -66,6 +78,8 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends as much of the buffers, in order, as the socket takes without blocking and returns how many bytes that was
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -98,8 +112,30 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Waits until any of a set of TCP sockets can be read from or written to, or until it is woken up from another thread.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    // Whether Wake can end a Wait early, otherwise the only way out is the timeout
+    virtual bool CanWake() const abstract;
+
+    virtual void Clear() abstract;
+    virtual void Add(const ITcpSocket& socket, bool write) abstract;
+    virtual void Wait(uint32_t timeoutMs) abstract;
+    virtual void Wake() abstract;
+
+    // The sockets are referred to by the order they were added in since the last Clear
+    virtual bool IsReadable(size_t index) const abstract;
+    virtual bool IsWritable(size_t index) const abstract;
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
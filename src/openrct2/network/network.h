@@ -45,12 +45,14 @@ void network_reconnect();
 void network_shutdown_client();
 int32_t network_begin_client(const std::string& host, int32_t port);
 int32_t network_begin_server(int32_t port, const std::string& address);
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& listenAddress);
 
 int32_t network_get_mode();
 int32_t network_get_status();
 bool network_is_desynchronised();
 bool network_check_desynchronisation();
 void network_request_gamestate_snapshot();
+void network_request_resync();
 void network_send_tick();
 bool network_gamestate_snapshots_enabled();
 void network_update();
@@ -119,5 +121,7 @@ const utf8* network_get_server_provider_website();
 std::string network_get_version();
 
 NetworkStats_t network_get_stats();
+NetworkStats_t network_get_player_stats(uint32_t id);
+const char* network_get_command_name(NetworkCommand command);
 NetworkServerState_t network_get_server_state();
 json_t network_get_server_info_as_json();
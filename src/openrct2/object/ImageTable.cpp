@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
+#include "../config/Config.h"
 #include "../core/File.h"
 #include "../core/FileScanner.h"
 #include "../core/IStream.hpp"
@@ -24,16 +25,114 @@
 #include "ObjectFactory.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
+// Deferred images are prefetched in small batches, so a frame waiting on the scheduler is not held up for long
+constexpr size_t PREFETCH_IMAGES_PER_TASK = 16;
+
+struct ImageTable::DeferredPngImage final : public DeferredImage
+{
+private:
+    std::string _path;
+    std::vector<uint8_t> _pngData;
+    ImageImporter::IMPORT_FLAGS _importFlags;
+    rct_g1_element _header{};
+
+    std::once_flag _decodeFlag;
+    ImageImporter::ImportResult _decoded;
+    bool _decodedValid = false;
+    // The PNG data until it is decoded, then the decoded image
+    std::atomic<size_t> _memoryUsage;
+
+public:
+    DeferredPngImage(
+        const std::string& path, std::vector<uint8_t>&& pngData, const rct_g1_element& header,
+        ImageImporter::IMPORT_FLAGS importFlags)
+        : _path(path)
+        , _pngData(std::move(pngData))
+        , _importFlags(importFlags)
+        , _header(header)
+        , _memoryUsage(_pngData.size())
+    {
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return _memoryUsage;
+    }
+
+    /**
+     * Creates a deferred image from the size in the PNG header, or returns nullptr if the header can not be used.
+     * Those images are decoded straight away instead, so any problem with them is reported while loading.
+     */
+    static std::unique_ptr<DeferredPngImage> TryCreate(
+        const std::string& path, std::vector<uint8_t>&& pngData, int16_t x, int16_t y, ImageImporter::IMPORT_FLAGS flags)
+    {
+        static constexpr uint8_t PngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        if (pngData.size() < 24 || std::memcmp(pngData.data(), PngSignature, sizeof(PngSignature)) != 0
+            || std::memcmp(pngData.data() + 12, "IHDR", 4) != 0)
+        {
+            return nullptr;
+        }
+
+        auto readUInt32BE = [&pngData](size_t offset) {
+            return (static_cast<uint32_t>(pngData[offset]) << 24) | (static_cast<uint32_t>(pngData[offset + 1]) << 16)
+                | (static_cast<uint32_t>(pngData[offset + 2]) << 8) | static_cast<uint32_t>(pngData[offset + 3]);
+        };
+        auto width = readUInt32BE(16);
+        auto height = readUInt32BE(20);
+        if (width > 256 || height > 256)
+        {
+            return nullptr;
+        }
+
+        rct_g1_element header{};
+        header.width = static_cast<int16_t>(width);
+        header.height = static_cast<int16_t>(height);
+        header.x_offset = x;
+        header.y_offset = y;
+        header.flags = (flags & ImageImporter::IMPORT_FLAGS::RLE ? G1_FLAG_RLE_COMPRESSION : G1_FLAG_BMP) | G1_FLAG_DEFERRED;
+        return std::make_unique<DeferredPngImage>(path, std::move(pngData), header, flags);
+    }
+
+    const rct_g1_element& GetHeader() const
+    {
+        return _header;
+    }
+
+    const rct_g1_element* Decode() override
+    {
+        std::call_once(_decodeFlag, [this]() {
+            try
+            {
+                auto image = Imaging::ReadFromBuffer(_pngData, IMAGE_FORMAT::PNG_32);
+                ImageImporter importer;
+                _decoded = importer.Import(image, _header.x_offset, _header.y_offset, _importFlags);
+                _decoded.Element.offset = _decoded.Buffer.data();
+                _decodedValid = true;
+            }
+            catch (const std::exception& e)
+            {
+                log_warning("Unable to load image '%s': %s", _path.c_str(), e.what());
+            }
+            _pngData = {};
+            _memoryUsage = _decoded.Buffer.size();
+        });
+        return _decodedValid ? &_decoded.Element : nullptr;
+    }
+};
+
 struct ImageTable::RequiredImage
 {
     rct_g1_element g1{};
     std::unique_ptr<RequiredImage> next_zoom;
+    std::unique_ptr<DeferredPngImage> deferred;
 
     bool HasData() const
     {
@@ -43,6 +142,13 @@ struct ImageTable::RequiredImage
     RequiredImage() = default;
     RequiredImage(const RequiredImage&) = delete;
 
+    RequiredImage(std::unique_ptr<DeferredPngImage> image)
+        : deferred(std::move(image))
+    {
+        // The data stays with the deferred image, g1 only describes it
+        g1 = deferred->GetHeader();
+    }
+
     RequiredImage(const rct_g1_element& orig)
     {
         auto length = g1_calculate_data_size(&orig);
@@ -129,22 +235,7 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
     }
     else
     {
-        try
-        {
-            auto imageData = context->GetData(s);
-            auto image = Imaging::ReadFromBuffer(imageData, IMAGE_FORMAT::PNG_32);
-
-            ImageImporter importer;
-            auto importResult = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE);
-
-            result.push_back(std::make_unique<RequiredImage>(importResult.Element));
-        }
-        catch (const std::exception& e)
-        {
-            auto msg = String::StdFormat("Unable to load image '%s': %s", s.c_str(), e.what());
-            context->LogWarning(ObjectError::BadImageTable, msg.c_str());
-            result.push_back(std::make_unique<RequiredImage>());
-        }
+        result.push_back(ParsePngImage(context, s, 0, 0, false));
     }
     return result;
 }
@@ -159,6 +250,13 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
     auto raw = Json::GetString(el["format"]) == "raw";
 
     std::vector<std::unique_ptr<RequiredImage>> result;
+    result.push_back(ParsePngImage(context, path, x, y, raw));
+    return result;
+}
+
+std::unique_ptr<ImageTable::RequiredImage> ImageTable::ParsePngImage(
+    IReadObjectContext* context, const std::string& path, int16_t x, int16_t y, bool raw)
+{
     try
     {
         auto flags = ImageImporter::IMPORT_FLAGS::NONE;
@@ -167,6 +265,14 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
             flags = static_cast<ImageImporter::IMPORT_FLAGS>(flags | ImageImporter::IMPORT_FLAGS::RLE);
         }
         auto imageData = context->GetData(path);
+        if (gConfigGeneral.lazy_object_images)
+        {
+            auto deferred = DeferredPngImage::TryCreate(path, std::move(imageData), x, y, flags);
+            if (deferred != nullptr)
+            {
+                return std::make_unique<RequiredImage>(std::move(deferred));
+            }
+        }
         auto image = Imaging::ReadFromBuffer(imageData, IMAGE_FORMAT::PNG_32);
 
         ImageImporter importer;
@@ -174,15 +280,14 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
         auto g1Element = importResult.Element;
         g1Element.x_offset = x;
         g1Element.y_offset = y;
-        result.push_back(std::make_unique<RequiredImage>(g1Element));
+        return std::make_unique<RequiredImage>(g1Element);
     }
     catch (const std::exception& e)
     {
         auto msg = String::StdFormat("Unable to load image '%s': %s", path.c_str(), e.what());
         context->LogWarning(ObjectError::BadImageTable, msg.c_str());
-        result.push_back(std::make_unique<RequiredImage>());
+        return std::make_unique<RequiredImage>();
     }
-    return result;
 }
 
 std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::LoadObjectImages(
@@ -288,13 +393,25 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
     return objectPath;
 }
 
+ImageTable::ImageTable() = default;
+
 ImageTable::~ImageTable()
 {
+    if (!_prefetchTasks.IsComplete())
+    {
+        _prefetchCancelled = true;
+        TaskScheduler::GetGlobal().Wait(_prefetchTasks);
+    }
+
     if (_data == nullptr)
     {
         for (auto& entry : _entries)
         {
-            delete[] entry.offset;
+            // Deferred entries point to an image owned by _deferredImages
+            if (!(entry.flags & G1_FLAG_DEFERRED))
+            {
+                delete[] entry.offset;
+            }
         }
     }
 }
@@ -359,6 +476,7 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         _data = std::move(data);
+        _dataSize += dataSize;
         _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
     }
     catch (const std::exception&)
@@ -374,15 +492,31 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 
     if (context->ShouldLoadImages())
     {
+        auto cachedImages = context->GetCachedImages();
+        if (cachedImages != nullptr)
+        {
+            for (const auto& g1 : *cachedImages)
+            {
+                AddImage(&g1);
+            }
+            return;
+        }
+
         // First gather all the required images from inspecting the JSON
         std::vector<std::unique_ptr<RequiredImage>> allImages;
         auto jsonImages = root["images"];
 
+        // Images taken from g1, csg or other objects can not be cached with the object
+        bool cacheable = true;
         for (auto& jsonImage : jsonImages)
         {
             if (jsonImage.is_string())
             {
                 auto strImage = jsonImage.get<std::string>();
+                if (String::StartsWith(strImage, "$"))
+                {
+                    cacheable = false;
+                }
                 auto images = ParseImages(context, strImage);
                 allImages.insert(
                     allImages.end(), std::make_move_iterator(images.begin()), std::make_move_iterator(images.end()));
@@ -399,8 +533,15 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         auto imagesStartIndex = GetCount();
         for (const auto& img : allImages)
         {
-            const auto& g1 = img->g1;
-            AddImage(&g1);
+            if (img->deferred != nullptr)
+            {
+                AddDeferredImage(std::move(img->deferred));
+            }
+            else
+            {
+                const auto& g1 = img->g1;
+                AddImage(&g1);
+            }
         }
 
         // Add all the zoom images at the very end of the image table.
@@ -429,6 +570,11 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
                 }
             }
         }
+
+        if (cacheable)
+        {
+            context->CacheImages(GetImages() + imagesStartIndex, GetCount() - imagesStartIndex);
+        }
     }
 }
 
@@ -444,6 +590,45 @@ void ImageTable::AddImage(const rct_g1_element* g1)
     {
         newg1.offset = new uint8_t[length];
         std::copy_n(g1->offset, length, newg1.offset);
+        _dataSize += length;
     }
     _entries.push_back(newg1);
 }
+
+void ImageTable::AddDeferredImage(std::unique_ptr<DeferredPngImage> image)
+{
+    rct_g1_element newg1 = image->GetHeader();
+    newg1.offset = reinterpret_cast<uint8_t*>(static_cast<DeferredImage*>(image.get()));
+    _entries.push_back(newg1);
+    _deferredImages.push_back(std::move(image));
+}
+
+size_t ImageTable::GetMemoryUsage() const
+{
+    size_t size = _dataSize + _entries.capacity() * sizeof(rct_g1_element);
+    for (const auto& image : _deferredImages)
+    {
+        size += image->GetMemoryUsage();
+    }
+    return size;
+}
+
+void ImageTable::PrefetchImages()
+{
+    if (_deferredImages.empty() || !_prefetchTasks.IsComplete())
+    {
+        return;
+    }
+
+    auto& scheduler = TaskScheduler::GetGlobal();
+    for (size_t start = 0; start < _deferredImages.size(); start += PREFETCH_IMAGES_PER_TASK)
+    {
+        auto end = std::min(start + PREFETCH_IMAGES_PER_TASK, _deferredImages.size());
+        scheduler.Schedule(_prefetchTasks, [this, start, end]() {
+            for (size_t i = start; i < end && !_prefetchCancelled; i++)
+            {
+                _deferredImages[i]->Decode();
+            }
+        });
+    }
+}
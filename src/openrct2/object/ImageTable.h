@@ -11,8 +11,10 @@
 
 #include "../common.h"
 #include "../core/JsonFwd.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -26,8 +28,17 @@ class ImageTable
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
+    size_t _dataSize = 0;
     std::vector<rct_g1_element> _entries;
 
+    /**
+     * A PNG image of a JSON object that is decoded when it is first drawn, see lazy_object_images.
+     */
+    struct DeferredPngImage;
+    std::vector<std::unique_ptr<DeferredPngImage>> _deferredImages;
+    TaskGroup _prefetchTasks;
+    std::atomic_bool _prefetchCancelled = { false };
+
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
@@ -41,9 +52,12 @@ private:
         IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range);
     static std::vector<int32_t> ParseRange(std::string s);
     static std::string FindLegacyObject(const std::string& name);
+    static std::unique_ptr<ImageTable::RequiredImage> ParsePngImage(
+        IReadObjectContext* context, const std::string& path, int16_t x, int16_t y, bool raw);
+    void AddDeferredImage(std::unique_ptr<DeferredPngImage> image);
 
 public:
-    ImageTable() = default;
+    ImageTable();
     ImageTable(const ImageTable&) = delete;
     ImageTable& operator=(const ImageTable&) = delete;
     ~ImageTable();
@@ -62,4 +76,13 @@ public:
         return static_cast<uint32_t>(_entries.size());
     }
     void AddImage(const rct_g1_element* g1);
+
+    // The size of the image data and headers, including deferred images which count their PNG data until decoded
+    size_t GetMemoryUsage() const;
+
+    /**
+     * Starts decoding the deferred images of the table on the task scheduler, so they are ready before they are
+     * drawn. Images that are drawn in the meantime are decoded on the spot.
+     */
+    void PrefetchImages();
 };
@@ -168,6 +168,15 @@ struct IReadObjectContext
     virtual bool ShouldLoadImages() abstract;
     virtual std::vector<uint8_t> GetData(const std::string_view& path) abstract;
 
+    /**
+     * Returns the decoded images of the object from the object cache, or nullptr if they have to be read.
+     */
+    virtual const std::vector<rct_g1_element>* GetCachedImages() abstract;
+    /**
+     * Passes on the images read from the object when they only depend on the object itself, so they can be cached.
+     */
+    virtual void CacheImages(const rct_g1_element* images, size_t count) abstract;
+
     virtual void LogWarning(ObjectError code, const utf8* text) abstract;
     virtual void LogError(ObjectError code, const utf8* text) abstract;
 };
@@ -284,6 +293,10 @@ public:
     {
         return _imageTable;
     }
+    void PrefetchImages()
+    {
+        _imageTable.PrefetchImages();
+    }
 
     rct_object_entry GetScgWallsHeader();
     rct_object_entry GetScgPathXHeader();
@@ -0,0 +1,229 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ObjectCache.h"
+
+#include "../Context.h"
+#include "../PlatformEnvironment.h"
+#include "../core/File.h"
+#include "../core/MappedFileStream.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "zlib.h"
+
+#include <cstring>
+
+using namespace OpenRCT2;
+
+static constexpr uint32_t OBJECT_CACHE_MAGIC = 0x434A424F; // OBJC
+// Increase whenever the format changes, or the way objects are read changes what they decode to
+static constexpr uint16_t OBJECT_CACHE_VERSION = 1;
+static constexpr auto OBJECT_CACHE_EXTENSION = ".objcache";
+
+static std::string GetCachePath(const std::string& key)
+{
+    auto env = GetContext()->GetPlatformEnvironment();
+    return Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), "object", key + OBJECT_CACHE_EXTENSION);
+}
+
+static uint32_t CalculateChecksum(const void* data, size_t length)
+{
+    return static_cast<uint32_t>(crc32(0, static_cast<const Bytef*>(data), static_cast<uInt>(length)));
+}
+
+void ObjectCacheEntry::SetImages(const rct_g1_element* images, size_t count)
+{
+    Images.clear();
+    ImageData.clear();
+
+    std::vector<size_t> dataOffsets;
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto* g1 = &images[i];
+        if (g1->flags & G1_FLAG_DEFERRED)
+        {
+            g1 = reinterpret_cast<DeferredImage*>(g1->offset)->Decode();
+        }
+
+        rct_g1_element image = {};
+        size_t length = 0;
+        if (g1 != nullptr)
+        {
+            image = *g1;
+            length = g1->offset != nullptr ? g1_calculate_data_size(g1) : 0;
+        }
+        dataOffsets.push_back(ImageData.size());
+        if (length != 0)
+        {
+            ImageData.insert(ImageData.end(), g1->offset, g1->offset + length);
+        }
+        else
+        {
+            image.offset = nullptr;
+        }
+        Images.push_back(image);
+    }
+
+    // Only point the images into the data once it has stopped growing
+    for (size_t i = 0; i < Images.size(); i++)
+    {
+        if (Images[i].offset != nullptr)
+        {
+            Images[i].offset = ImageData.data() + dataOffsets[i];
+        }
+    }
+    HasImages = true;
+}
+
+namespace ObjectCache
+{
+    std::string GetKey(const std::string& path)
+    {
+        auto stream = OpenFileForReading(path);
+        const auto length = static_cast<size_t>(stream->GetLength());
+
+        // Two independent checksums and the length, distinct enough for a cache of files on one machine
+        uLong crc = crc32(0, nullptr, 0);
+        uLong adler = adler32(0, nullptr, 0);
+        const auto* data = static_cast<const Bytef*>(stream->GetData());
+        if (data != nullptr)
+        {
+            crc = crc32(crc, data, static_cast<uInt>(length));
+            adler = adler32(adler, data, static_cast<uInt>(length));
+        }
+        else
+        {
+            std::vector<Bytef> block(64 * 1024);
+            uint64_t blockLength;
+            while ((blockLength = stream->TryRead(block.data(), block.size())) != 0)
+            {
+                crc = crc32(crc, block.data(), static_cast<uInt>(blockLength));
+                adler = adler32(adler, block.data(), static_cast<uInt>(blockLength));
+            }
+        }
+        return String::StdFormat(
+            "%08x%08x%llx", static_cast<uint32_t>(crc), static_cast<uint32_t>(adler), static_cast<unsigned long long>(length));
+    }
+
+    static std::unique_ptr<ObjectCacheEntry> ReadEntry(std::vector<uint8_t>& fileData)
+    {
+        if (fileData.size() < sizeof(uint32_t))
+        {
+            return nullptr;
+        }
+        const auto dataLength = fileData.size() - sizeof(uint32_t);
+        uint32_t checksum;
+        std::memcpy(&checksum, fileData.data() + dataLength, sizeof(checksum));
+        if (CalculateChecksum(fileData.data(), dataLength) != checksum)
+        {
+            return nullptr;
+        }
+
+        auto stream = MemoryStream(fileData.data(), dataLength);
+        if (stream.ReadValue<uint32_t>() != OBJECT_CACHE_MAGIC || stream.ReadValue<uint16_t>() != OBJECT_CACHE_VERSION)
+        {
+            return nullptr;
+        }
+
+        auto entry = std::make_unique<ObjectCacheEntry>();
+        entry->Json.resize(stream.ReadValue<uint32_t>());
+        stream.Read(entry->Json.data(), entry->Json.size());
+
+        entry->HasImages = stream.ReadValue<uint8_t>() != 0;
+        if (entry->HasImages)
+        {
+            auto numImages = stream.ReadValue<uint32_t>();
+            std::vector<uint32_t> dataOffsets;
+            for (uint32_t i = 0; i < numImages; i++)
+            {
+                rct_g1_element image = {};
+                auto dataOffset = stream.ReadValue<uint32_t>();
+                image.width = stream.ReadValue<int16_t>();
+                image.height = stream.ReadValue<int16_t>();
+                image.x_offset = stream.ReadValue<int16_t>();
+                image.y_offset = stream.ReadValue<int16_t>();
+                image.flags = stream.ReadValue<uint16_t>();
+                image.zoomed_offset = stream.ReadValue<int32_t>();
+                dataOffsets.push_back(dataOffset);
+                entry->Images.push_back(image);
+            }
+            entry->ImageData.resize(stream.ReadValue<uint32_t>());
+            stream.Read(entry->ImageData.data(), entry->ImageData.size());
+            for (size_t i = 0; i < entry->Images.size(); i++)
+            {
+                // Images without data are stored with an offset past the end
+                if (dataOffsets[i] < entry->ImageData.size())
+                {
+                    entry->Images[i].offset = entry->ImageData.data() + dataOffsets[i];
+                }
+            }
+        }
+        return entry;
+    }
+
+    std::unique_ptr<ObjectCacheEntry> Load(const std::string& key)
+    {
+        auto path = GetCachePath(key);
+        if (!File::Exists(path))
+        {
+            return nullptr;
+        }
+        try
+        {
+            auto fileData = File::ReadAllBytes(path);
+            return ReadEntry(fileData);
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to read object cache '%s': %s", path.c_str(), e.what());
+            return nullptr;
+        }
+    }
+
+    void Save(const std::string& key, const ObjectCacheEntry& entry)
+    {
+        MemoryStream stream;
+        stream.WriteValue(OBJECT_CACHE_MAGIC);
+        stream.WriteValue(OBJECT_CACHE_VERSION);
+        stream.WriteValue(static_cast<uint32_t>(entry.Json.size()));
+        stream.Write(entry.Json.data(), entry.Json.size());
+        stream.WriteValue<uint8_t>(entry.HasImages ? 1 : 0);
+        if (entry.HasImages)
+        {
+            stream.WriteValue(static_cast<uint32_t>(entry.Images.size()));
+            for (const auto& image : entry.Images)
+            {
+                auto dataOffset = image.offset != nullptr ? static_cast<uint32_t>(image.offset - entry.ImageData.data())
+                                                          : static_cast<uint32_t>(entry.ImageData.size());
+                stream.WriteValue(dataOffset);
+                stream.WriteValue(image.width);
+                stream.WriteValue(image.height);
+                stream.WriteValue(image.x_offset);
+                stream.WriteValue(image.y_offset);
+                stream.WriteValue(image.flags);
+                stream.WriteValue(image.zoomed_offset);
+            }
+            stream.WriteValue(static_cast<uint32_t>(entry.ImageData.size()));
+            stream.Write(entry.ImageData.data(), entry.ImageData.size());
+        }
+        stream.WriteValue(CalculateChecksum(stream.GetData(), static_cast<size_t>(stream.GetLength())));
+
+        auto path = GetCachePath(key);
+        try
+        {
+            Path::CreateDirectory(Path::GetDirectory(path));
+            File::WriteAllBytes(path, stream.GetData(), static_cast<size_t>(stream.GetLength()));
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to write object cache '%s': %s", path.c_str(), e.what());
+        }
+    }
+} // namespace ObjectCache
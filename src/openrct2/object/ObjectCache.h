@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../drawing/Drawing.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * What is kept of an object in the object cache: its JSON in binary form and its images, already decoded.
+ */
+struct ObjectCacheEntry
+{
+    // object.json as CBOR
+    std::vector<uint8_t> Json;
+    // Only set when the images of the object do not depend on any other file
+    bool HasImages = false;
+    // The offsets of the images point into ImageData
+    std::vector<rct_g1_element> Images;
+    std::vector<uint8_t> ImageData;
+
+    /**
+     * Copies the images into the entry, deferred images are decoded first.
+     */
+    void SetImages(const rct_g1_element* images, size_t count);
+};
+
+/**
+ * Keeps decoded .parkobj objects in the cache directory, by the contents of their file, so objects that have been read
+ * before do not have to be unzipped, parsed and have their images decoded again.
+ */
+namespace ObjectCache
+{
+    /**
+     * Returns the key of the object file's contents, which changes whenever the file does.
+     */
+    std::string GetKey(const std::string& path);
+
+    /**
+     * Returns the cached object for the key, or nullptr if there is none or it could not be read.
+     */
+    std::unique_ptr<ObjectCacheEntry> Load(const std::string& key);
+
+    void Save(const std::string& key, const ObjectCacheEntry& entry);
+} // namespace ObjectCache
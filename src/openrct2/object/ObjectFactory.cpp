@@ -26,6 +26,7 @@
 #include "FootpathObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
+#include "ObjectCache.h"
 #include "ObjectLimits.h"
 #include "ObjectList.h"
 #include "RideObject.h"
@@ -67,17 +68,28 @@ public:
 class ZipDataRetriever : public IFileDataRetriever
 {
 private:
-    const IZipArchive& _zipArchive;
+    std::string _path;
+    // Only opened once a file is needed, objects from the object cache usually do not need any
+    mutable std::unique_ptr<IZipArchive> _zipArchive;
 
 public:
-    ZipDataRetriever(const IZipArchive& zipArchive)
-        : _zipArchive(zipArchive)
+    ZipDataRetriever(const std::string_view& path)
+        : _path(path)
     {
     }
 
+    const IZipArchive& GetArchive() const
+    {
+        if (_zipArchive == nullptr)
+        {
+            _zipArchive = Zip::Open(_path, ZIP_ACCESS::READ);
+        }
+        return *_zipArchive;
+    }
+
     std::vector<uint8_t> GetData(const std::string_view& path) const override
     {
-        return _zipArchive.GetFileData(path);
+        return GetArchive().GetFileData(path);
     }
 };
 
@@ -87,6 +99,8 @@ private:
     IObjectRepository& _objectRepository;
     const IFileDataRetriever* _fileDataRetriever;
 
+    ObjectCacheEntry* _cacheEntry;
+
     std::string _identifier;
     bool _loadImages;
     std::string _basePath;
@@ -105,9 +119,10 @@ public:
 
     ReadObjectContext(
         IObjectRepository& objectRepository, const std::string& identifier, bool loadImages,
-        const IFileDataRetriever* fileDataRetriever)
+        const IFileDataRetriever* fileDataRetriever, ObjectCacheEntry* cacheEntry = nullptr)
         : _objectRepository(objectRepository)
         , _fileDataRetriever(fileDataRetriever)
+        , _cacheEntry(cacheEntry)
         , _identifier(identifier)
         , _loadImages(loadImages)
     {
@@ -137,6 +152,24 @@ public:
         return {};
     }
 
+    const std::vector<rct_g1_element>* GetCachedImages() override
+    {
+        if (_cacheEntry != nullptr && _cacheEntry->HasImages)
+        {
+            return &_cacheEntry->Images;
+        }
+        return nullptr;
+    }
+
+    void CacheImages(const rct_g1_element* images, size_t count) override
+    {
+        // Images that had problems are read again next time so the problems are still reported
+        if (_cacheEntry != nullptr && !_wasWarning && !_wasError)
+        {
+            _cacheEntry->SetImages(images, count);
+        }
+    }
+
     void LogWarning(ObjectError code, const utf8* text) override
     {
         _wasWarning = true;
@@ -165,7 +198,8 @@ namespace ObjectFactory
      * @note jRoot is deliberately left non-const: json_t behaviour changes when const
      */
     static std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever);
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever,
+        ObjectCacheEntry* cacheEntry = nullptr);
 
     static ObjectSourceGame ParseSourceGame(const std::string& s)
     {
@@ -355,19 +389,39 @@ namespace ObjectFactory
     {
         try
         {
-            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
-            auto jsonBytes = archive->GetFileData("object.json");
-            if (jsonBytes.empty())
+            // Objects that have not changed since they were last read are taken from the object cache
+            auto cacheKey = ObjectCache::GetKey(std::string(path));
+            auto cacheEntry = ObjectCache::Load(cacheKey);
+            const bool isCached = cacheEntry != nullptr;
+            const bool hadImages = isCached && cacheEntry->HasImages;
+
+            auto fileDataRetriever = ZipDataRetriever(path);
+            json_t jRoot;
+            if (isCached)
             {
-                throw std::runtime_error("Unable to open object.json.");
+                jRoot = json_t::from_cbor(cacheEntry->Json);
             }
+            else
+            {
+                auto jsonBytes = fileDataRetriever.GetArchive().GetFileData("object.json");
+                if (jsonBytes.empty())
+                {
+                    throw std::runtime_error("Unable to open object.json.");
+                }
 
-            json_t jRoot = Json::FromVector(jsonBytes);
+                jRoot = Json::FromVector(jsonBytes);
+                cacheEntry = std::make_unique<ObjectCacheEntry>();
+                cacheEntry->Json = json_t::to_cbor(jRoot);
+            }
 
             if (jRoot.is_object())
             {
-                auto fileDataRetriever = ZipDataRetriever(*archive);
-                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+                auto result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, cacheEntry.get());
+                if (result != nullptr && (!isCached || cacheEntry->HasImages != hadImages))
+                {
+                    ObjectCache::Save(cacheKey, *cacheEntry);
+                }
+                return result;
             }
         }
         catch (const std::exception& e)
@@ -428,7 +482,8 @@ namespace ObjectFactory
     }
 
     std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever)
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever,
+        ObjectCacheEntry* cacheEntry)
     {
         Guard::Assert(jRoot.is_object(), "ObjectFactory::CreateObjectFromJson expects parameter jRoot to be object");
 
@@ -456,7 +511,7 @@ namespace ObjectFactory
             result = CreateObject(entry);
             result->SetIdentifier(id);
             result->MarkAsJsonObject();
-            auto readContext = ReadObjectContext(objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever);
+            auto readContext = ReadObjectContext(objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever, cacheEntry);
             result->ReadJson(&readContext, jRoot);
             if (readContext.WasError())
             {
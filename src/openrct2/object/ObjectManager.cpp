@@ -10,10 +10,15 @@
 #include "ObjectManager.h"
 
 #include "../Context.h"
+#include "../HitchTracker.h"
 #include "../ParkImporter.h"
+#include "../Profiling.h"
+#include "../StartupTrace.h"
 #include "../core/Console.hpp"
 #include "../core/Memory.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/StringIds.h"
+#include "../paint/TilePaintCache.h"
 #include "FootpathItemObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
@@ -26,11 +31,79 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
-#include <mutex>
-#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
+/**
+ * How long the objects of each type took to read and to load, for the verbose log.
+ */
+class ObjectLoadStats
+{
+private:
+    struct TypeStats
+    {
+        size_t Count = 0;
+        std::chrono::duration<double> ReadTime{};
+        std::chrono::duration<double> LoadTime{};
+    };
+
+    static constexpr const char* TypeNames[] = {
+        "ride",
+        "small scenery",
+        "large scenery",
+        "wall",
+        "banner",
+        "footpath",
+        "footpath item",
+        "scenery group",
+        "park entrance",
+        "water",
+        "scenario text",
+        "terrain surface",
+        "terrain edge",
+        "station",
+        "music",
+    };
+    static_assert(std::size(TypeNames) == OBJECT_TYPE_COUNT);
+
+    std::array<TypeStats, OBJECT_TYPE_COUNT> _types{};
+
+public:
+    void AddRead(uint8_t type, std::chrono::duration<double> time)
+    {
+        if (type < OBJECT_TYPE_COUNT)
+        {
+            _types[type].Count++;
+            _types[type].ReadTime += time;
+        }
+    }
+
+    void AddLoad(uint8_t type, std::chrono::duration<double> time)
+    {
+        if (type < OBJECT_TYPE_COUNT)
+        {
+            _types[type].LoadTime += time;
+        }
+    }
+
+    void Log() const
+    {
+        for (size_t i = 0; i < _types.size(); i++)
+        {
+            const auto& type = _types[i];
+            if (type.Count != 0)
+            {
+                // Reading happens on several threads at once, so the read times add up to more than the time it took
+                log_verbose(
+                    "Read %zu %s objects in %.1f ms, loaded them in %.1f ms", type.Count, TypeNames[i],
+                    type.ReadTime.count() * 1000.0, type.LoadTime.count() * 1000.0);
+            }
+        }
+    }
+};
+
 class ObjectManager final : public IObjectManager
 {
 private:
@@ -134,6 +207,9 @@ public:
 
     void LoadObjects(const rct_object_entry* entries, size_t count) override
     {
+        StartupTraceSpan span("ObjectManager::LoadObjects");
+        PROFILE_ZONE("ObjectManager::LoadObjects");
+        hitch_tracker_note(HitchEvent::ObjectLoading);
         // Find all the required objects
         auto requiredObjects = GetRequiredObjects(entries, count);
 
@@ -145,6 +221,7 @@ public:
         LoadDefaultObjects();
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_paint_cache_invalidate_all();
         log_verbose("%u / %u new objects loaded", numNewLoadedObjects, requiredObjects.size());
     }
 
@@ -173,6 +250,7 @@ public:
         {
             UpdateSceneryGroupIndexes();
             ResetTypeToRideEntryIndexMap();
+            tile_paint_cache_invalidate_all();
         }
     }
 
@@ -184,6 +262,7 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_paint_cache_invalidate_all();
     }
 
     void ResetObjects() override
@@ -198,6 +277,21 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_paint_cache_invalidate_all();
+    }
+
+    size_t GetImageMemoryUsage() override
+    {
+        size_t size = 0;
+        for (const auto& loadedObject : _loadedObjects)
+        {
+            if (loadedObject != nullptr)
+            {
+                const Object& object = *loadedObject;
+                size += object.GetImageTable().GetMemoryUsage();
+            }
+        }
+        return size;
     }
 
     std::vector<const ObjectRepositoryItem*> GetPackableObjects() override
@@ -552,30 +646,6 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
-    {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
-    }
-
     std::vector<std::unique_ptr<Object>> LoadObjects(
         std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
     {
@@ -585,55 +655,80 @@ private:
         objects.resize(OBJECT_ENTRY_COUNT);
         loadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
-        // Read objects
-        std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
+        // The objects that are already loaded are moved over, given that the new list will be used as the next loaded
+        // object list. This is required as the resulting list must contain all loaded objects and not just the newly
+        // loaded ones.
+        std::unordered_map<const Object*, size_t> loadedObjectIndices;
+        loadedObjectIndices.reserve(_loadedObjects.size());
+        for (size_t i = 0; i < _loadedObjects.size(); i++)
+        {
+            if (_loadedObjects[i] != nullptr)
+            {
+                loadedObjectIndices.emplace(_loadedObjects[i].get(), i);
+            }
+        }
+
+        std::vector<size_t> objectsToRead;
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
             auto requiredObject = requiredObjects[i];
-            std::unique_ptr<Object> object;
-            if (requiredObject != nullptr)
+            if (requiredObject == nullptr)
             {
-                auto loadedObject = requiredObject->LoadedObject;
-                if (loadedObject == nullptr)
-                {
-                    // Object requires to be loaded, if the object successfully loads it will register it
-                    // as a loaded object otherwise placed into the badObjects list.
-                    object = _objectRepository.LoadObject(requiredObject);
-                    std::lock_guard<std::mutex> guard(commonMutex);
-                    if (object == nullptr)
-                    {
-                        badObjects.push_back(requiredObject->ObjectEntry);
-                        ReportObjectLoadProblem(&requiredObject->ObjectEntry);
-                    }
-                    else
-                    {
-                        loadedObjects.push_back(object.get());
-                        // Connect the ori to the registered object
-                        _objectRepository.RegisterLoadedObject(requiredObject, object.get());
-                    }
-                }
-                else
+                continue;
+            }
+            if (requiredObject->LoadedObject == nullptr)
+            {
+                objectsToRead.push_back(i);
+            }
+            else
+            {
+                auto it = loadedObjectIndices.find(requiredObject->LoadedObject);
+                if (it != loadedObjectIndices.end())
                 {
-                    // The object is already loaded, given that the new list will be used as the next loaded object list,
-                    // we can move the element out safely. This is required as the resulting list must contain all loaded
-                    // objects and not just the newly loaded ones.
-                    std::lock_guard<std::mutex> guard(commonMutex);
-                    auto it = std::find_if(_loadedObjects.begin(), _loadedObjects.end(), [loadedObject](const auto& obj) {
-                        return obj.get() == loadedObject;
-                    });
-                    if (it != _loadedObjects.end())
-                    {
-                        object = std::move(*it);
-                    }
+                    objects[i] = std::move(_loadedObjects[it->second]);
                 }
             }
-            objects[i] = std::move(object);
+        }
+
+        // Read the objects on the task scheduler, one task each as their sizes vary a lot. Each task only writes the slot
+        // of its own object, so no locks are needed.
+        std::vector<std::chrono::duration<double>> readTimes(objectsToRead.size());
+        TaskScheduler::GetGlobal().ParallelFor(0, objectsToRead.size(), 1, [&](size_t n) {
+            PROFILE_ZONE("Read object");
+            const auto i = objectsToRead[n];
+            auto startTime = std::chrono::high_resolution_clock::now();
+            objects[i] = _objectRepository.LoadObject(requiredObjects[i]);
+            readTimes[n] = std::chrono::high_resolution_clock::now() - startTime;
         });
 
+        // Register the objects in the order they are required in, objects that failed to read are reported instead
+        ObjectLoadStats stats;
+        for (size_t n = 0; n < objectsToRead.size(); n++)
+        {
+            const auto i = objectsToRead[n];
+            auto requiredObject = requiredObjects[i];
+            stats.AddRead(requiredObject->ObjectEntry.GetType(), readTimes[n]);
+            if (objects[i] == nullptr)
+            {
+                badObjects.push_back(requiredObject->ObjectEntry);
+                ReportObjectLoadProblem(&requiredObject->ObjectEntry);
+            }
+            else
+            {
+                loadedObjects.push_back(objects[i].get());
+                // Connect the ori to the registered object
+                _objectRepository.RegisterLoadedObject(requiredObject, objects[i].get());
+            }
+        }
+
         // Load objects
         for (auto obj : loadedObjects)
         {
+            auto startTime = std::chrono::high_resolution_clock::now();
             obj->Load();
+            stats.AddLoad(obj->GetObjectType(), std::chrono::high_resolution_clock::now() - startTime);
         }
+        stats.Log();
 
         if (!badObjects.empty())
         {
@@ -645,6 +740,12 @@ private:
             throw ObjectLoadException(std::move(badObjects));
         }
 
+        // Decode any deferred images in the background now the objects are in use
+        for (auto obj : loadedObjects)
+        {
+            obj->PrefetchImages();
+        }
+
         if (outNewObjectsLoaded != nullptr)
         {
             *outNewObjectsLoaded = loadedObjects.size();
@@ -659,6 +760,7 @@ private:
         if (loadedObject == nullptr)
         {
             // Try to load object
+            hitch_tracker_note(HitchEvent::ObjectLoading);
             object = _objectRepository.LoadObject(ori);
             if (object != nullptr)
             {
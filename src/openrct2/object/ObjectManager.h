@@ -40,6 +40,9 @@ struct IObjectManager
 
     virtual std::vector<const ObjectRepositoryItem*> GetPackableObjects() abstract;
     virtual const std::vector<ObjectEntryIndex>& GetAllRideEntries(uint8_t rideType) abstract;
+
+    // The size of the image tables of all loaded objects
+    virtual size_t GetImageMemoryUsage() abstract;
 };
 
 std::unique_ptr<IObjectManager> CreateObjectManager(IObjectRepository& objectRepository);
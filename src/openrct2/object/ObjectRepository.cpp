@@ -22,6 +22,7 @@
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../object/Object.h"
@@ -38,7 +39,9 @@
 #include "RideObject.h"
 
 #include <algorithm>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -229,6 +232,10 @@ class ObjectRepository final : public IObjectRepository
     std::vector<ObjectRepositoryItem> _items;
     ObjectEntryMap _itemMap;
 
+    // Objects packed for saved games by their path, every client that joins a server is sent the same ones
+    std::mutex _packedObjectsMutex;
+    std::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>> _packedObjects;
+
 public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
         : _env(env)
@@ -251,6 +258,7 @@ public:
 
     void Construct(int32_t language) override
     {
+        ClearPackedObjects();
         auto items = _fileIndex.Rebuild(language);
         AddItems(items);
         SortItems();
@@ -367,6 +375,54 @@ public:
         }
     }
 
+    bool ScanFile(const std::string& path) override
+    {
+        if (!_fileIndex.IsIndexedFile(path))
+        {
+            return false;
+        }
+
+        auto existing = std::find_if(
+            _items.begin(), _items.end(), [&path](const ObjectRepositoryItem& item) { return Path::Equals(item.Path, path); });
+        if (existing == _items.end())
+        {
+            ScanObject(path);
+            return true;
+        }
+        if (existing->LoadedObject != nullptr)
+        {
+            Console::WriteLine("Object '%s' is in use, it is not updated.", path.c_str());
+            return true;
+        }
+
+        auto language = LocalisationService_GetCurrentLanguage();
+        auto result = _fileIndex.Create(language, path);
+        if (!std::get<0>(result))
+        {
+            return true;
+        }
+
+        auto item = std::get<1>(result);
+        auto conflict = FindObject(&item.ObjectEntry);
+        if (conflict != nullptr && conflict->Id != existing->Id)
+        {
+            Console::Error::WriteLine("Object conflict: '%s'", conflict->Path.c_str());
+            Console::Error::WriteLine("               : '%s'", item.Path.c_str());
+            return true;
+        }
+
+        // Keeps the position of the item, other items are referenced by it
+        item.Id = existing->Id;
+        _itemMap.erase(existing->ObjectEntry);
+        _itemMap[item.ObjectEntry] = item.Id;
+        *existing = std::move(item);
+        {
+            std::lock_guard<std::mutex> lock(_packedObjectsMutex);
+            _packedObjects.erase(path);
+        }
+        return true;
+    }
+
     void ExportPackedObject(IStream* stream) override
     {
         auto chunkReader = SawyerChunkReader(stream);
@@ -388,6 +444,7 @@ public:
     void WritePackedObjects(IStream* stream, std::vector<const ObjectRepositoryItem*>& objects) override
     {
         log_verbose("packing %u objects", objects.size());
+        std::vector<const ObjectRepositoryItem*> customObjects;
         for (const auto& object : objects)
         {
             Guard::ArgumentNotNull(object);
@@ -395,13 +452,35 @@ public:
             log_verbose("exporting object %.8s", object->ObjectEntry.name);
             if (IsObjectCustom(object))
             {
-                WritePackedObject(stream, &object->ObjectEntry);
+                customObjects.push_back(object);
             }
             else
             {
                 log_warning("Refusing to pack vanilla/expansion object \"%s\"", object->ObjectEntry.name);
             }
         }
+
+        // The objects that have not been packed before are read and encoded in parallel, then all are written in order
+        std::vector<std::shared_ptr<const std::vector<uint8_t>>> packedObjects(customObjects.size());
+        std::vector<std::exception_ptr> errors(customObjects.size());
+        TaskScheduler::GetGlobal().ParallelFor(0, customObjects.size(), 1, [&](size_t i) {
+            try
+            {
+                packedObjects[i] = GetPackedObject(customObjects[i]);
+            }
+            catch (const std::exception&)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+        for (size_t i = 0; i < customObjects.size(); i++)
+        {
+            if (errors[i] != nullptr)
+            {
+                std::rethrow_exception(errors[i]);
+            }
+            stream->Write(packedObjects[i]->data(), packedObjects[i]->size());
+        }
     }
 
 private:
@@ -409,6 +488,13 @@ private:
     {
         _items.clear();
         _itemMap.clear();
+        ClearPackedObjects();
+    }
+
+    void ClearPackedObjects()
+    {
+        std::lock_guard<std::mutex> lock(_packedObjectsMutex);
+        _packedObjects.clear();
     }
 
     void SortItems()
@@ -627,14 +713,31 @@ private:
         return String::Convert(normalisedName, CODE_PAGE::CP_1252, CODE_PAGE::CP_UTF8);
     }
 
-    void WritePackedObject(OpenRCT2::IStream* stream, const rct_object_entry* entry)
+    std::shared_ptr<const std::vector<uint8_t>> GetPackedObject(const ObjectRepositoryItem* item)
     {
-        const ObjectRepositoryItem* item = FindObject(entry);
-        if (item == nullptr)
         {
-            throw std::runtime_error(String::StdFormat("Unable to find object '%.8s'", entry->name));
+            std::lock_guard<std::mutex> lock(_packedObjectsMutex);
+            auto it = _packedObjects.find(item->Path);
+            if (it != _packedObjects.end())
+            {
+                return it->second;
+            }
         }
 
+        MemoryStream ms;
+        WritePackedObject(&ms, item);
+        const auto* data = static_cast<const uint8_t*>(ms.GetData());
+        auto packedObject = std::make_shared<const std::vector<uint8_t>>(data, data + ms.GetLength());
+
+        std::lock_guard<std::mutex> lock(_packedObjectsMutex);
+        _packedObjects[item->Path] = packedObject;
+        return packedObject;
+    }
+
+    static void WritePackedObject(OpenRCT2::IStream* stream, const ObjectRepositoryItem* item)
+    {
+        const auto* entry = &item->ObjectEntry;
+
         // Read object data from file
         auto fs = OpenRCT2::FileStream(item->Path, OpenRCT2::FILE_MODE_OPEN);
         auto fileEntry = fs.ReadValue<rct_object_entry>();
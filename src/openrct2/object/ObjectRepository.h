@@ -80,6 +80,11 @@ struct IObjectRepository
 
     virtual void AddObject(const rct_object_entry* objectEntry, const void* data, size_t dataSize) abstract;
     virtual void AddObjectFromFile(const std::string_view& objectName, const void* data, size_t dataSize) abstract;
+    /**
+     * Adds the object of a file created or changed since the repository was loaded, or updates its item. Objects that
+     * are currently loaded are left as they are. Returns false if the file is not one the repository indexes.
+     */
+    virtual bool ScanFile(const std::string& path) abstract;
 
     virtual void ExportPackedObject(OpenRCT2::IStream* stream) abstract;
     virtual void WritePackedObjects(OpenRCT2::IStream* stream, std::vector<const ObjectRepositoryItem*>& objects) abstract;
@@ -48,6 +48,14 @@ static bool StringIsBlank(const utf8* str)
     return true;
 }
 
+StringTable::~StringTable()
+{
+    for (const auto& string : _strings)
+    {
+        StringPool::Release(string.Text);
+    }
+}
+
 void StringTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream, ObjectStringID id)
 {
     try
@@ -66,7 +74,7 @@ void StringTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream, O
                 StringTableEntry entry{};
                 entry.Id = id;
                 entry.LanguageId = languageId;
-                entry.Text = stringAsUtf8;
+                entry.Text = StringPool::Intern(stringAsUtf8);
                 _strings.push_back(entry);
             }
         }
@@ -124,7 +132,7 @@ std::string StringTable::GetString(ObjectStringID id) const
     {
         if (string.Id == id)
         {
-            return string.Text;
+            return StringPool::Get(string.Text);
         }
     }
     return std::string();
@@ -136,7 +144,7 @@ std::string StringTable::GetString(uint8_t language, ObjectStringID id) const
     {
         if (string.LanguageId == language && string.Id == id)
         {
-            return string.Text;
+            return StringPool::Get(string.Text);
         }
     }
     return std::string();
@@ -147,7 +155,7 @@ void StringTable::SetString(ObjectStringID id, uint8_t language, const std::stri
     StringTableEntry entry;
     entry.Id = id;
     entry.LanguageId = language;
-    entry.Text = text;
+    entry.Text = StringPool::Intern(text);
     _strings.push_back(entry);
 }
 
@@ -159,7 +167,7 @@ void StringTable::Sort()
         {
             if (a.LanguageId == b.LanguageId)
             {
-                return String::Compare(a.Text, b.Text, true) < 0;
+                return String::Compare(StringPool::Get(a.Text), StringPool::Get(b.Text), true) < 0;
             }
 
             if (a.LanguageId == targetLanguage)
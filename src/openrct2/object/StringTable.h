@@ -12,6 +12,7 @@
 #include "../common.h"
 #include "../core/JsonFwd.hpp"
 #include "../localisation/Language.h"
+#include "../localisation/StringPool.h"
 
 #include <string>
 #include <vector>
@@ -38,7 +39,8 @@ struct StringTableEntry
 {
     ObjectStringID Id = ObjectStringID::UNKNOWN;
     uint8_t LanguageId = LANGUAGE_UNDEFINED;
-    std::string Text;
+    // Holds a reference in the string pool, released by the string table
+    StringPoolId Text = STRING_POOL_ID_EMPTY;
 };
 
 class StringTable
@@ -49,6 +51,7 @@ private:
 
 public:
     StringTable() = default;
+    ~StringTable();
     StringTable(const StringTable&) = delete;
     StringTable& operator=(const StringTable&) = delete;
 
@@ -0,0 +1,247 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ImpostorCache.h"
+
+#include "../config/Config.h"
+#include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
+#include "../interface/Colour.h"
+#include "../interface/Viewport.h"
+#include "../interface/Window.h"
+#include "../world/Climate.h"
+#include "../world/Map.h"
+#include "Paint.h"
+#include "TilePaintCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+namespace
+{
+    /**
+     * The pixels of a square part of the view, as painted for one rotation and zoom level.
+     */
+    struct ImpostorBlock
+    {
+        uint64_t StateHash{};
+        std::vector<uint8_t> Pixels;
+    };
+
+    // Entities are not painted past zoom level 2 (see sprite_paint_setup), from here on the view only changes when
+    // the tile elements do.
+    constexpr ZoomLevel ImpostorMinZoom = 3;
+    // Width and height of a block in pixels.
+    constexpr int32_t BlockSize = 128;
+    // Limits the memory used by the cache, once full it is emptied and filled again from the blocks being drawn.
+    constexpr size_t MaxBlocks = 512;
+
+    // Blocks are shared so that a block dropped while another thread still copies from it stays alive until it is done.
+    std::mutex _mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<const ImpostorBlock>> _blocks;
+} // namespace
+
+static int32_t impostor_cache_floor_div(int32_t value, int32_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static uint32_t impostor_cache_get_key(int32_t blockX, int32_t blockY, uint8_t rotation, ZoomLevel zoom)
+{
+    const auto zoomBits = static_cast<uint32_t>(static_cast<int8_t>(zoom)) & 0xF;
+    return (static_cast<uint32_t>(blockX) & 0x3FF) | ((static_cast<uint32_t>(blockY) & 0x3FF) << 10)
+        | (static_cast<uint32_t>(rotation & 3) << 20) | (zoomBits << 22);
+}
+
+static uint64_t impostor_cache_get_state_hash(uint32_t viewFlags)
+{
+    // The weather gloom is drawn over each column as it is painted, so it ends up in the blocks as well.
+    const uint32_t gloom = gConfigGeneral.render_weather_gloom
+        ? static_cast<uint32_t>(climate_get_weather_gloom_palette_id(gClimateCurrent))
+        : 0;
+    uint64_t hash = tile_paint_cache_get_state_hash(viewFlags);
+    hash ^= gloom + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static bool impostor_cache_is_supported(const rct_viewport* viewport, const rct_drawpixelinfo* dpi)
+{
+    // Views drawn for anything other than a window, such as screenshots and track previews, are painted as usual.
+    if (viewport < std::begin(g_viewport_list) || viewport >= std::end(g_viewport_list))
+        return false;
+    if (viewport->zoom < ImpostorMinZoom)
+        return false;
+
+    // The blocks are copied straight into the pixels of the target.
+    auto drawingEngine = dpi->DrawingEngine;
+    if (drawingEngine == nullptr || !(drawingEngine->GetFlags() & DEF_PIXEL_BUFFER))
+        return false;
+
+    // Leaves the pixels of the target that nothing is painted on as they are.
+    if (viewport->flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+        return false;
+    if (gPaintBoundingBoxes || tile_paint_cache_is_overlay_visible(viewport->flags))
+        return false;
+    return true;
+}
+
+static std::shared_ptr<const ImpostorBlock> impostor_cache_render_block(
+    const rct_viewport* viewport, IDrawingEngine* drawingEngine, const ScreenCoordsXY& viewPos, uint64_t stateHash)
+{
+    const int32_t blockUnits = BlockSize * viewport->zoom;
+
+    auto block = std::make_shared<ImpostorBlock>();
+    block->StateHash = stateHash;
+    block->Pixels.resize(BlockSize * BlockSize, PALETTE_INDEX_0);
+
+    rct_viewport blockViewport{};
+    blockViewport.width = BlockSize;
+    blockViewport.height = BlockSize;
+    blockViewport.viewPos = viewPos;
+    blockViewport.view_width = blockUnits;
+    blockViewport.view_height = blockUnits;
+    blockViewport.flags = viewport->flags;
+    blockViewport.zoom = viewport->zoom;
+
+    rct_drawpixelinfo blockDpi{};
+    blockDpi.bits = block->Pixels.data();
+    blockDpi.width = BlockSize;
+    blockDpi.height = BlockSize;
+    blockDpi.DrawingEngine = drawingEngine;
+
+    viewport_paint(&blockViewport, &blockDpi, viewPos.x, viewPos.y, viewPos.x + blockUnits, viewPos.y + blockUnits);
+    return block;
+}
+
+/**
+ * Returns the block from the cache if it is still up to date, paints it again otherwise. The lock is not held while
+ * painting, the columns are painted on the task scheduler and waiting on it can run another viewport region.
+ */
+static std::shared_ptr<const ImpostorBlock> impostor_cache_get_block(
+    const rct_viewport* viewport, IDrawingEngine* drawingEngine, int32_t blockX, int32_t blockY, uint64_t stateHash)
+{
+    const auto key = impostor_cache_get_key(blockX, blockY, get_current_rotation(), viewport->zoom);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _blocks.find(key);
+        if (it != _blocks.end() && it->second->StateHash == stateHash)
+        {
+            return it->second;
+        }
+    }
+
+    const int32_t blockUnits = BlockSize * viewport->zoom;
+    auto block = impostor_cache_render_block(
+        viewport, drawingEngine, { blockX * blockUnits, blockY * blockUnits }, stateHash);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_blocks.size() >= MaxBlocks && _blocks.find(key) == _blocks.end())
+    {
+        _blocks.clear();
+    }
+    _blocks[key] = block;
+    return block;
+}
+
+bool impostor_cache_paint(const rct_viewport* viewport, rct_drawpixelinfo* dpi)
+{
+    if (!impostor_cache_is_supported(viewport, dpi))
+    {
+        return false;
+    }
+
+    const auto zoom = viewport->zoom;
+    const int32_t blockUnits = BlockSize * zoom;
+    const auto stateHash = impostor_cache_get_state_hash(viewport->flags);
+
+    // dpi is in view units, its position and size are multiples of the zoom factor like the blocks.
+    const int32_t left = dpi->x;
+    const int32_t top = dpi->y;
+    const int32_t right = dpi->x + dpi->width;
+    const int32_t bottom = dpi->y + dpi->height;
+    const int32_t dstStride = (dpi->width / zoom) + dpi->pitch;
+
+    for (int32_t blockY = impostor_cache_floor_div(top, blockUnits); blockY * blockUnits < bottom; blockY++)
+    {
+        for (int32_t blockX = impostor_cache_floor_div(left, blockUnits); blockX * blockUnits < right; blockX++)
+        {
+            const auto block = impostor_cache_get_block(viewport, dpi->DrawingEngine, blockX, blockY, stateHash);
+
+            const int32_t x0 = std::max(left, blockX * blockUnits);
+            const int32_t x1 = std::min(right, (blockX + 1) * blockUnits);
+            const int32_t y0 = std::max(top, blockY * blockUnits);
+            const int32_t y1 = std::min(bottom, (blockY + 1) * blockUnits);
+
+            const auto numColumns = static_cast<size_t>((x1 - x0) / zoom);
+            const int32_t numRows = (y1 - y0) / zoom;
+            const uint8_t* src = block->Pixels.data() + ((y0 - blockY * blockUnits) / zoom) * BlockSize
+                + ((x0 - blockX * blockUnits) / zoom);
+            uint8_t* dst = dpi->bits + ((y0 - top) / zoom) * dstStride + ((x0 - left) / zoom);
+            for (int32_t row = 0; row < numRows; row++)
+            {
+                std::memcpy(dst, src, numColumns);
+                src += BlockSize;
+                dst += dstStride;
+            }
+        }
+    }
+    return true;
+}
+
+void impostor_cache_invalidate_tile(const CoordsXY& mapPos, int32_t z0, int32_t z1, int32_t maxZoom)
+{
+    if (maxZoom != -1 && maxZoom < static_cast<int8_t>(ImpostorMinZoom))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_blocks.empty())
+    {
+        return;
+    }
+
+    const CoordsXYZ centre = { mapPos.x + 16, mapPos.y + 16, 0 };
+    for (uint8_t rotation = 0; rotation < 4; rotation++)
+    {
+        // The same area map_invalidate_tile invalidates in the viewports.
+        const auto screenCoords = translate_3d_to_2d_with_z(rotation, centre);
+        const int32_t left = screenCoords.x - 32;
+        const int32_t top = screenCoords.y - 32 - z1;
+        const int32_t right = screenCoords.x + 32;
+        const int32_t bottom = screenCoords.y + 32 - z0;
+
+        for (ZoomLevel zoom = ImpostorMinZoom; zoom <= ZoomLevel::max(); zoom++)
+        {
+            const int32_t blockUnits = BlockSize * zoom;
+            const int32_t lastBlockX = impostor_cache_floor_div(right, blockUnits);
+            const int32_t lastBlockY = impostor_cache_floor_div(bottom, blockUnits);
+            for (int32_t blockY = impostor_cache_floor_div(top, blockUnits); blockY <= lastBlockY; blockY++)
+            {
+                for (int32_t blockX = impostor_cache_floor_div(left, blockUnits); blockX <= lastBlockX; blockX++)
+                {
+                    _blocks.erase(impostor_cache_get_key(blockX, blockY, rotation, zoom));
+                }
+            }
+        }
+    }
+}
+
+void impostor_cache_invalidate_all()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _blocks.clear();
+}
@@ -0,0 +1,31 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct rct_drawpixelinfo;
+struct rct_viewport;
+
+/**
+ * Draws the area of the viewport described by dpi from bitmaps of the view that are kept between frames, painting only
+ * the blocks of the view that changed since they were last drawn. Only used at the furthest zoom levels, where no
+ * entities are painted and the view is made up of the tile elements alone. Returns false if the area has to be painted
+ * as usual.
+ */
+bool impostor_cache_paint(const rct_viewport* viewport, rct_drawpixelinfo* dpi);
+
+/**
+ * Drops the blocks of every rotation and zoom level that the tile with elements between z0 and z1 is drawn in, for
+ * invalidations of viewports up to maxZoom (-1 for all).
+ */
+void impostor_cache_invalidate_tile(const CoordsXY& mapPos, int32_t z0, int32_t z1, int32_t maxZoom);
+void impostor_cache_invalidate_all();
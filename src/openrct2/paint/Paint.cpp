@@ -16,12 +16,15 @@
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Painter.h"
+#include "TilePaintCache.h"
 #include "sprite/Paint.Sprite.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <limits>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -49,6 +52,7 @@ static constexpr const uint8_t BoundBoxDebugColours[] = {
 bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
 bool gPaintBlockedTiles;
+PaintSortMethod gPaintSortMethod = PaintSortMethod::Automatic;
 
 static void paint_attached_ps(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t viewFlags);
 static void paint_ps_image_with_bounding_boxes(
@@ -73,7 +77,8 @@ static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struc
 static paint_struct* sub_9819_c(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, CoordsXYZ boundBoxSize, CoordsXYZ boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    auto entry = session->PaintEntryChain.PeekNext();
+    if (entry == nullptr)
         return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
@@ -81,7 +86,7 @@ static paint_struct* sub_9819_c(
         return nullptr;
     }
 
-    paint_struct* ps = &session->NextFreePaintStruct->basic;
+    paint_struct* ps = &entry->basic;
     ps->image_id = image_id;
 
     uint8_t swappedRotation = (session->CurrentRotation * 3) % 4; // swaps 1 and 3
@@ -313,53 +318,19 @@ template<> bool check_bounding_box<3>(const paint_struct_bound_box& initialBBox,
     return false;
 }
 
-template<uint8_t _TRotation>
-static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+template<uint8_t _TRotation> static void paint_arrange_structs_legacy(paint_struct* ps)
 {
-    paint_struct* ps;
+    paint_struct* ps_next;
     paint_struct* ps_temp;
-    do
-    {
-        ps = ps_next;
-        ps_next = ps_next->next_quadrant_ps;
-        if (ps_next == nullptr)
-            return ps;
-    } while (quadrantIndex > ps_next->quadrant_index);
-
-    // Cache the last visited node so we don't have to walk the whole list again
-    paint_struct* ps_cache = ps;
-
-    ps_temp = ps;
-    do
-    {
-        ps = ps->next_quadrant_ps;
-        if (ps == nullptr)
-            break;
-
-        if (ps->quadrant_index > quadrantIndex + 1)
-        {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
-        }
-        else if (ps->quadrant_index == quadrantIndex + 1)
-        {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
-        }
-        else if (ps->quadrant_index == quadrantIndex)
-        {
-            ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
-        }
-    } while (ps->quadrant_index <= quadrantIndex + 1);
-    ps = ps_temp;
-
     while (true)
     {
         while (true)
         {
             ps_next = ps->next_quadrant_ps;
             if (ps_next == nullptr)
-                return ps_cache;
+                return;
             if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER)
-                return ps_cache;
+                return;
             if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL)
                 break;
             ps = ps_next;
@@ -399,6 +370,230 @@ static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next
     }
 }
 
+namespace
+{
+    struct PaintSortNode
+    {
+        paint_struct* Ps;
+        // Increases along the list, so the order of two nodes can be told without walking it
+        uint64_t Label;
+        uint32_t Prev;
+        uint32_t Next;
+    };
+
+    struct PaintSortCandidate
+    {
+        int32_t KeyX;
+        // Smallest KeyY and z of this and all preceding candidates
+        int32_t MinKeyY;
+        int32_t MinZ;
+        uint32_t Node;
+    };
+
+    struct PaintSortScratch
+    {
+        std::vector<PaintSortNode> Nodes;
+        std::vector<PaintSortCandidate> Candidates;
+        std::vector<uint32_t> Matches;
+    };
+} // namespace
+
+// Below this many structs in a quadrant pair, scanning the list is cheaper than building the index
+static constexpr size_t PaintSortIndexedMinimum = 32;
+static constexpr uint32_t PaintSortNoNode = std::numeric_limits<uint32_t>::max();
+static constexpr uint64_t PaintSortLabelSpacing = 1ULL << 32;
+
+static void paint_sort_relabel(std::vector<PaintSortNode>& nodes)
+{
+    uint64_t label = 0;
+    for (uint32_t i = 0; i != PaintSortNoNode; i = nodes[i].Next)
+    {
+        nodes[i].Label = label;
+        label += PaintSortLabelSpacing;
+    }
+}
+
+/**
+ * Produces exactly the same order as paint_arrange_structs_legacy. Instead of comparing each struct against every later
+ * one in the list, the structs that may have to move in front of it are looked up from the NEXT structs sorted by the
+ * extent that check_bounding_box tests first. Quadrants follow the diagonals of the map, so along that order the
+ * extents on the other axis only grow and the lookup can stop as soon as no earlier candidate can overlap any more.
+ */
+template<uint8_t _TRotation> static void paint_arrange_structs_indexed(paint_struct* psStart, bool force)
+{
+    // Flip the axes check_bounding_box compares the other way round, so all rotations search for KeyX <= BoundX
+    constexpr bool flipX = _TRotation == 1 || _TRotation == 2;
+    constexpr bool flipY = _TRotation == 2 || _TRotation == 3;
+
+    static thread_local PaintSortScratch scratch;
+    auto& nodes = scratch.Nodes;
+    auto& candidates = scratch.Candidates;
+    auto& matches = scratch.Matches;
+
+    // Node 0 stands for psStart, which stays in front of the quadrant pair
+    nodes.clear();
+    nodes.push_back({ psStart, 0, PaintSortNoNode, PaintSortNoNode });
+    paint_struct* psEnd = psStart->next_quadrant_ps;
+    for (; psEnd != nullptr && !(psEnd->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER); psEnd = psEnd->next_quadrant_ps)
+    {
+        auto index = static_cast<uint32_t>(nodes.size());
+        nodes.back().Next = index;
+        nodes.push_back({ psEnd, index * PaintSortLabelSpacing, index - 1, PaintSortNoNode });
+    }
+    if (!force && nodes.size() <= PaintSortIndexedMinimum)
+    {
+        paint_arrange_structs_legacy<_TRotation>(psStart);
+        return;
+    }
+
+    candidates.clear();
+    for (uint32_t i = 1; i < nodes.size(); i++)
+    {
+        const auto* ps = nodes[i].Ps;
+        if (ps->quadrant_flags & PAINT_QUADRANT_FLAG_NEXT)
+        {
+            const auto& bbox = ps->bounds;
+            candidates.push_back({ flipX ? -bbox.x : bbox.x, flipY ? -bbox.y : bbox.y, bbox.z, i });
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const PaintSortCandidate& a, const PaintSortCandidate& b) {
+        return a.KeyX < b.KeyX;
+    });
+    for (size_t i = 1; i < candidates.size(); i++)
+    {
+        candidates[i].MinKeyY = std::min(candidates[i].MinKeyY, candidates[i - 1].MinKeyY);
+        candidates[i].MinZ = std::min(candidates[i].MinZ, candidates[i - 1].MinZ);
+    }
+
+    auto cursor = nodes[0].Next;
+    while (cursor != PaintSortNoNode)
+    {
+        auto* ps = nodes[cursor].Ps;
+        if (!(ps->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL))
+        {
+            cursor = nodes[cursor].Next;
+            continue;
+        }
+        ps->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+
+        // Find the NEXT structs after this one that have to be drawn before it
+        const auto& initialBBox = ps->bounds;
+        const int32_t boundX = flipX ? -initialBBox.x_end - 1 : initialBBox.x_end;
+        const int32_t boundY = flipY ? -initialBBox.y_end - 1 : initialBBox.y_end;
+        const int32_t boundZ = initialBBox.z_end;
+        const auto label = nodes[cursor].Label;
+        auto it = std::upper_bound(
+            candidates.begin(), candidates.end(), boundX,
+            [](int32_t value, const PaintSortCandidate& candidate) { return value < candidate.KeyX; });
+        matches.clear();
+        while (it != candidates.begin())
+        {
+            --it;
+            if (it->MinKeyY > boundY || it->MinZ > boundZ)
+                break;
+            const auto& node = nodes[it->Node];
+            if (node.Label > label && check_bounding_box<_TRotation>(initialBBox, node.Ps->bounds))
+            {
+                matches.push_back(it->Node);
+            }
+        }
+        if (matches.empty())
+        {
+            cursor = nodes[cursor].Next;
+            continue;
+        }
+
+        // The scan in paint_arrange_structs_legacy moves each match directly in front of this struct in turn, which leaves
+        // them in reverse list order
+        std::sort(
+            matches.begin(), matches.end(), [&nodes](uint32_t a, uint32_t b) { return nodes[a].Label < nodes[b].Label; });
+        for (auto match : matches)
+        {
+            auto& node = nodes[match];
+            nodes[node.Prev].Next = node.Next;
+            if (node.Next != PaintSortNoNode)
+                nodes[node.Next].Prev = node.Prev;
+        }
+
+        auto step = (label - nodes[nodes[cursor].Prev].Label) / (matches.size() + 1);
+        if (step == 0)
+        {
+            paint_sort_relabel(nodes);
+            step = PaintSortLabelSpacing / (matches.size() + 1);
+        }
+        auto at = cursor;
+        for (auto match : matches)
+        {
+            auto& node = nodes[match];
+            node.Prev = nodes[at].Prev;
+            node.Next = at;
+            node.Label = nodes[at].Label - step;
+            nodes[node.Prev].Next = match;
+            nodes[at].Prev = match;
+            at = match;
+        }
+        cursor = at;
+    }
+
+    for (uint32_t i = 0; i != PaintSortNoNode; i = nodes[i].Next)
+    {
+        auto next = nodes[i].Next;
+        nodes[i].Ps->next_quadrant_ps = next != PaintSortNoNode ? nodes[next].Ps : psEnd;
+    }
+}
+
+template<uint8_t _TRotation>
+static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+{
+    paint_struct* ps;
+    paint_struct* ps_temp;
+    do
+    {
+        ps = ps_next;
+        ps_next = ps_next->next_quadrant_ps;
+        if (ps_next == nullptr)
+            return ps;
+    } while (quadrantIndex > ps_next->quadrant_index);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    paint_struct* ps_cache = ps;
+
+    ps_temp = ps;
+    do
+    {
+        ps = ps->next_quadrant_ps;
+        if (ps == nullptr)
+            break;
+
+        if (ps->quadrant_index > quadrantIndex + 1)
+        {
+            ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (ps->quadrant_index == quadrantIndex + 1)
+        {
+            ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (ps->quadrant_index == quadrantIndex)
+        {
+            ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (ps->quadrant_index <= quadrantIndex + 1);
+
+    switch (gPaintSortMethod)
+    {
+        case PaintSortMethod::Automatic:
+            paint_arrange_structs_indexed<_TRotation>(ps_temp, false);
+            break;
+        case PaintSortMethod::Legacy:
+            paint_arrange_structs_legacy<_TRotation>(ps_temp);
+            break;
+        case PaintSortMethod::Indexed:
+            paint_arrange_structs_indexed<_TRotation>(ps_temp, true);
+            break;
+    }
+    return ps_cache;
+}
+
 static paint_struct* paint_arrange_structs_helper(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation)
 {
     switch (rotation)
@@ -691,6 +886,129 @@ void paint_session_free([[maybe_unused]] paint_session* session)
     GetContext()->GetPainter()->ReleaseSession(session);
 }
 
+PaintEntryPool::Chain::Chain(PaintEntryPool* pool)
+    : Pool(pool)
+{
+}
+
+PaintEntryPool::Chain::Chain(Chain&& chain) noexcept
+{
+    *this = std::move(chain);
+}
+
+PaintEntryPool::Chain::~Chain()
+{
+    Clear();
+}
+
+PaintEntryPool::Chain& PaintEntryPool::Chain::operator=(Chain&& chain) noexcept
+{
+    if (this != &chain)
+    {
+        Clear();
+        Pool = chain.Pool;
+        Head = chain.Head;
+        Current = chain.Current;
+        chain.Pool = nullptr;
+        chain.Head = nullptr;
+        chain.Current = nullptr;
+    }
+    return *this;
+}
+
+paint_entry* PaintEntryPool::Chain::PeekNext()
+{
+    if (Current == nullptr || Current->Count >= NodeSize)
+    {
+        if (Pool == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto node = Pool->AllocateNode();
+        if (Current == nullptr)
+        {
+            Head = node;
+        }
+        else
+        {
+            Current->Next = node;
+        }
+        Current = node;
+    }
+    return &Current->PaintStructs[Current->Count];
+}
+
+void PaintEntryPool::Chain::Advance()
+{
+    assert(Current != nullptr && Current->Count < NodeSize);
+    Current->Count++;
+}
+
+void PaintEntryPool::Chain::Clear()
+{
+    if (Pool != nullptr && Head != nullptr)
+    {
+        Pool->FreeNodes(Head);
+    }
+    Head = nullptr;
+    Current = nullptr;
+}
+
+size_t PaintEntryPool::Chain::GetCount() const
+{
+    size_t count = 0;
+    for (auto node = Head; node != nullptr; node = node->Next)
+    {
+        count += node->Count;
+    }
+    return count;
+}
+
+PaintEntryPool::~PaintEntryPool()
+{
+    for (auto node : _available)
+    {
+        delete node;
+    }
+}
+
+PaintEntryPool::Node* PaintEntryPool::AllocateNode()
+{
+    // Sessions are generated on the paint workers, so nodes can be requested from several threads at once.
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Node* result;
+    if (_available.empty())
+    {
+        result = new Node();
+    }
+    else
+    {
+        result = _available.back();
+        _available.pop_back();
+    }
+    result->Next = nullptr;
+    result->Count = 0;
+    return result;
+}
+
+PaintEntryPool::Chain PaintEntryPool::Create()
+{
+    return Chain(this);
+}
+
+void PaintEntryPool::FreeNodes(Node* head)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto node = head; node != nullptr;)
+    {
+        auto next = node->Next;
+        _available.push_back(node);
+        node = next;
+    }
+}
+
 /**
  *  rct2: 0x006861AC, 0x00686337, 0x006864D0, 0x0068666B, 0x0098196C
  *
@@ -707,13 +1025,21 @@ paint_struct* sub_98196C(
     paint_session* session, uint32_t image_id, int8_t x_offset, int8_t y_offset, int16_t bound_box_length_x,
     int16_t bound_box_length_y, int8_t bound_box_length_z, int16_t z_offset)
 {
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record(
+            session, TilePaintOpType::Sub98196C, image_id, { x_offset, y_offset, z_offset },
+            { bound_box_length_x, bound_box_length_y, bound_box_length_z }, {});
+    }
+
     assert(static_cast<uint16_t>(bound_box_length_x) == static_cast<int16_t>(bound_box_length_x));
     assert(static_cast<uint16_t>(bound_box_length_y) == static_cast<int16_t>(bound_box_length_y));
 
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    auto entry = session->PaintEntryChain.PeekNext();
+    if (entry == nullptr)
     {
         return nullptr;
     }
@@ -724,7 +1050,7 @@ paint_struct* sub_98196C(
         return nullptr;
     }
 
-    paint_struct* ps = &session->NextFreePaintStruct->basic;
+    paint_struct* ps = &entry->basic;
     ps->image_id = image_id;
 
     CoordsXYZ coord_3d = {
@@ -832,7 +1158,7 @@ paint_struct* sub_98196C(
     }
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
 
     return ps;
 }
@@ -858,6 +1184,14 @@ paint_struct* sub_98197C(
     int16_t bound_box_length_y, int8_t bound_box_length_z, int16_t z_offset, int16_t bound_box_offset_x,
     int16_t bound_box_offset_y, int16_t bound_box_offset_z)
 {
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record(
+            session, TilePaintOpType::Sub98197C, image_id, { x_offset, y_offset, z_offset },
+            { bound_box_length_x, bound_box_length_y, bound_box_length_z },
+            { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z });
+    }
+
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
 
@@ -891,7 +1225,7 @@ paint_struct* sub_98197C(
     int32_t positionHash = attach.x + attach.y;
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
     return ps;
 }
 
@@ -916,6 +1250,14 @@ paint_struct* sub_98198C(
     int16_t bound_box_length_y, int8_t bound_box_length_z, int16_t z_offset, int16_t bound_box_offset_x,
     int16_t bound_box_offset_y, int16_t bound_box_offset_z)
 {
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record(
+            session, TilePaintOpType::Sub98198C, image_id, { x_offset, y_offset, z_offset },
+            { bound_box_length_x, bound_box_length_y, bound_box_length_z },
+            { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z });
+    }
+
     assert(static_cast<uint16_t>(bound_box_length_x) == static_cast<int16_t>(bound_box_length_x));
     assert(static_cast<uint16_t>(bound_box_length_y) == static_cast<int16_t>(bound_box_length_y));
 
@@ -933,7 +1275,7 @@ paint_struct* sub_98198C(
     }
 
     session->LastRootPS = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
     return ps;
 }
 
@@ -957,6 +1299,12 @@ paint_struct* sub_98199C(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, const CoordsXYZ& boundBoxLength,
     const CoordsXYZ& boundBoxOffset)
 {
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record(
+            session, TilePaintOpType::Sub98199C, image_id, offset, boundBoxLength, boundBoxOffset);
+    }
+
     if (session->LastRootPS == nullptr)
     {
         return sub_98197C(
@@ -975,7 +1323,7 @@ paint_struct* sub_98199C(
     old_ps->children = ps;
 
     session->LastRootPS = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
     return ps;
 }
 
@@ -1001,16 +1349,22 @@ paint_struct* sub_98199C(
  */
 bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record_attach(session, TilePaintOpType::AttachToPreviousAttach, image_id, x, y);
+    }
+
     if (session->UnkF1AD2C == nullptr)
     {
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    auto entry = session->PaintEntryChain.PeekNext();
+    if (entry == nullptr)
     {
         return false;
     }
-    attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct* ps = &entry->attached;
     ps->image_id = image_id;
     ps->x = x;
     ps->y = y;
@@ -1023,7 +1377,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
 
     session->UnkF1AD2C = ps;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
 
     return true;
 }
@@ -1038,11 +1392,17 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
  */
 bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (session->TileRecorder != nullptr)
+    {
+        return tile_paint_cache_record_attach(session, TilePaintOpType::AttachToPreviousPS, image_id, x, y);
+    }
+
+    auto entry = session->PaintEntryChain.PeekNext();
+    if (entry == nullptr)
     {
         return false;
     }
-    attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct* ps = &entry->attached;
 
     ps->image_id = image_id;
     ps->x = x;
@@ -1055,7 +1415,7 @@ bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, int1
         return false;
     }
 
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
 
     attached_paint_struct* oldFirstAttached = masterPs->attached_ps;
     masterPs->attached_ps = ps;
@@ -1081,12 +1441,18 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (session->TileRecorder != nullptr)
+    {
+        tile_paint_cache_record_unsupported(session);
+    }
+
+    auto entry = session->PaintEntryChain.PeekNext();
+    if (entry == nullptr)
     {
         return;
     }
 
-    paint_string_struct* ps = &session->NextFreePaintStruct->string;
+    paint_string_struct* ps = &entry->string;
     ps->string_id = string_id;
     ps->next = nullptr;
     ps->args[0] = amount;
@@ -1105,7 +1471,7 @@ void paint_floating_money_effect(
     ps->x = coord.x + offset_x;
     ps->y = coord.y;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntryChain.Advance();
 
     if (session->LastPSString == nullptr)
     {
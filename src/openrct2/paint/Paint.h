@@ -14,7 +14,11 @@
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <mutex>
+#include <vector>
+
 struct TileElement;
+struct TilePaintRecorder;
 enum ViewportInteractionItem : uint8_t;
 
 #pragma pack(push, 1)
@@ -134,18 +138,74 @@ struct tunnel_entry
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT 65
 
-struct paint_session
+/**
+ * Hands out paint entries in fixed size nodes. Nodes released by a session are kept for reuse by the
+ * next frame, so the amount of memory follows the most complex scene drawn rather than a fixed limit.
+ */
+struct PaintEntryPool
+{
+    static constexpr size_t NodeSize = 512;
+
+    struct Node
+    {
+        Node* Next{};
+        size_t Count{};
+        paint_entry PaintStructs[NodeSize]{};
+    };
+
+    /**
+     * The list of nodes used by a single paint session.
+     */
+    struct Chain
+    {
+        PaintEntryPool* Pool{};
+        Node* Head{};
+        Node* Current{};
+
+        Chain() = default;
+        explicit Chain(PaintEntryPool* pool);
+        Chain(const Chain&) = delete;
+        Chain(Chain&& chain) noexcept;
+        ~Chain();
+
+        Chain& operator=(const Chain&) = delete;
+        Chain& operator=(Chain&& chain) noexcept;
+
+        /**
+         * Returns the entry the next allocation will use without claiming it, nullptr if no entry
+         * could be provided. The entry is claimed by calling Advance.
+         */
+        paint_entry* PeekNext();
+        void Advance();
+        void Clear();
+        size_t GetCount() const;
+    };
+
+private:
+    std::vector<Node*> _available;
+    std::mutex _mutex;
+
+    Node* AllocateNode();
+
+public:
+    PaintEntryPool() = default;
+    PaintEntryPool(const PaintEntryPool&) = delete;
+    PaintEntryPool& operator=(const PaintEntryPool&) = delete;
+    ~PaintEntryPool();
+
+    Chain Create();
+    void FreeNodes(Node* head);
+};
+
+struct paint_session_core
 {
     rct_drawpixelinfo DPI;
-    paint_entry PaintStructs[4000];
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct PaintHead;
     uint32_t ViewFlags;
     uint32_t QuadrantBackIndex;
     uint32_t QuadrantFrontIndex;
     const void* CurrentlyDrawnItem;
-    paint_entry* EndOfPaintStructArray;
-    paint_entry* NextFreePaintStruct;
     CoordsXY SpritePosition;
     paint_struct* LastRootPS;
     attached_paint_struct* UnkF1AD2C;
@@ -169,6 +229,23 @@ struct paint_session
     uint8_t Unk141E9DB;
     uint16_t WaterHeight;
     uint32_t TrackColours[4];
+    TilePaintRecorder* TileRecorder;
+};
+
+struct paint_session : public paint_session_core
+{
+    PaintEntryPool::Chain PaintEntryChain;
+};
+
+/**
+ * A copy of a paint session with its paint entries flattened into a single array. The paint struct
+ * pointers of both the entries and the quadrants are stored as indices into Entries, with
+ * Entries.size() standing in for nullptr.
+ */
+struct RecordedPaintSession
+{
+    paint_session_core Session;
+    std::vector<paint_entry> Entries;
 };
 
 extern paint_session gPaintSession;
@@ -185,6 +262,16 @@ extern bool gPaintBoundingBoxes;
 extern bool gPaintBlockedTiles;
 extern bool gPaintWidePathsAsGhost;
 
+enum class PaintSortMethod : uint8_t
+{
+    // Indexed for quadrant pairs with many structs, legacy for the rest
+    Automatic,
+    Legacy,
+    // Same order as legacy, using an index of the bounding box extents to find overlapping structs
+    Indexed,
+};
+extern PaintSortMethod gPaintSortMethod;
+
 paint_struct* sub_98196C(
     paint_session* session, uint32_t image_id, int8_t x_offset, int8_t y_offset, int16_t bound_box_length_x,
     int16_t bound_box_length_y, int8_t bound_box_length_z, int16_t z_offset);
@@ -14,10 +14,14 @@
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
 #include "../config/Config.h"
+#include "../core/String.hpp"
 #include "../drawing/Drawing.h"
+#include "../TickProfiler.h"
+#include "../drawing/FrameProfiler.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Window.h"
 #include "../localisation/FormatCodes.h"
 #include "../localisation/Language.h"
 #include "../paint/Paint.h"
@@ -43,7 +47,11 @@ void Painter::Paint(IDrawingEngine& de)
     }
     else
     {
-        de.PaintWindows();
+        {
+            FramePhaseTimer timer(FramePhase::Windows);
+            window_flush_invalidations();
+            de.PaintWindows();
+        }
 
         update_palette_effects();
         _uiContext->Draw(dpi);
@@ -76,6 +84,10 @@ void Painter::Paint(IDrawingEngine& de)
     {
         PaintFPS(dpi);
     }
+    if (frame_profiler_is_overlay_visible())
+    {
+        PaintFrameProfiler(dpi, de);
+    }
     gCurrentDrawCount++;
 }
 
@@ -127,6 +139,75 @@ void Painter::PaintFPS(rct_drawpixelinfo* dpi)
     gfx_set_dirty_blocks({ { screenCoords - ScreenCoordsXY{ 16, 4 } }, { gLastDrawStringX + 16, 16 } });
 }
 
+// Shows the average and longest time of each phase over the recorded frames.
+void Painter::PaintFrameProfiler(rct_drawpixelinfo* dpi, IDrawingEngine& de)
+{
+    auto samples = frame_profiler_get_samples();
+    if (samples.empty())
+        return;
+
+    ScreenCoordsXY screenCoords(4, 32);
+    auto startCoords = screenCoords;
+    int32_t maxWidth = 0;
+    auto drawLine = [&](const char* text) {
+        utf8 buffer[128] = { 0 };
+        utf8* ch = buffer;
+        ch = utf8_write_codepoint(ch, FORMAT_MEDIUMFONT);
+        ch = utf8_write_codepoint(ch, FORMAT_OUTLINE);
+        ch = utf8_write_codepoint(ch, FORMAT_WHITE);
+        snprintf(ch, 128 - (ch - buffer), "%s", text);
+
+        gfx_draw_string(dpi, buffer, 0, screenCoords);
+        maxWidth = std::max(maxWidth, gfx_get_string_width(buffer));
+        screenCoords.y += 12;
+    };
+
+    for (size_t phase = 0; phase < static_cast<size_t>(FramePhase::Count); phase++)
+    {
+        int64_t total = 0;
+        int64_t longest = 0;
+        for (const auto& sample : samples)
+        {
+            total += sample.Nanoseconds[phase];
+            longest = std::max(longest, sample.Nanoseconds[phase]);
+        }
+
+        auto text = String::StdFormat(
+            "%s: %.2f ms (max %.2f ms)", frame_profiler_get_phase_name(static_cast<FramePhase>(phase)),
+            total / 1e6 / samples.size(), longest / 1e6);
+        drawLine(text.c_str());
+    }
+
+    auto statistics = de.GetLastFrameStatistics();
+    if (statistics.DrawCalls != 0)
+    {
+        auto text = String::StdFormat(
+            "draw calls: %u, uploaded: %zu KiB", statistics.DrawCalls, statistics.BytesUploaded / 1024);
+        drawLine(text.c_str());
+    }
+
+    // The stages of the game tick that took any measurable time
+    auto tickStats = tick_profiler_get_stats();
+    if (tickStats.Ticks != 0)
+    {
+        screenCoords.y += 6;
+        for (size_t phase = 0; phase < static_cast<size_t>(TickPhase::Count); phase++)
+        {
+            const auto& phaseStats = tickStats.Phases[phase];
+            if (phaseStats.MaxNanoseconds < 10000)
+                continue;
+
+            auto text = String::StdFormat(
+                "%s: %.2f ms (p99 %.2f ms, max %.2f ms)", tick_profiler_get_phase_name(static_cast<TickPhase>(phase)),
+                phaseStats.AverageNanoseconds / 1e6, phaseStats.P99Nanoseconds / 1e6, phaseStats.MaxNanoseconds / 1e6);
+            drawLine(text.c_str());
+        }
+    }
+
+    // Make area dirty so the text doesn't get drawn over the last
+    gfx_set_dirty_blocks({ startCoords, screenCoords + ScreenCoordsXY{ maxWidth + 16, 4 } });
+}
+
 void Painter::MeasureFPS()
 {
     _frames++;
@@ -142,6 +223,7 @@ void Painter::MeasureFPS()
 
 paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
+    std::lock_guard<std::mutex> lock(_sessionMutex);
     paint_session* session = nullptr;
 
     if (_freePaintSessions.empty() == false)
@@ -161,8 +243,7 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     }
 
     session->DPI = *dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->PaintEntryChain = _paintStructPool.Create();
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
     session->ViewFlags = viewFlags;
@@ -177,11 +258,14 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->TileRecorder = nullptr;
 
     return session;
 }
 
 void Painter::ReleaseSession(paint_session* session)
 {
+    std::lock_guard<std::mutex> lock(_sessionMutex);
+    session->PaintEntryChain.Clear();
     _freePaintSessions.push_back(session);
 }
@@ -14,6 +14,7 @@
 
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 struct rct_drawpixelinfo;
@@ -36,8 +37,12 @@ namespace OpenRCT2
         {
         private:
             std::shared_ptr<Ui::IUiContext> const _uiContext;
+            // Must outlive the sessions, which give their nodes back to it when destroyed.
+            PaintEntryPool _paintStructPool;
             std::vector<std::unique_ptr<paint_session>> _paintSessionPool;
             std::vector<paint_session*> _freePaintSessions;
+            // Viewports of separate dirty regions can be rendered at the same time.
+            std::mutex _sessionMutex;
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
@@ -52,6 +57,7 @@ namespace OpenRCT2
         private:
             void PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo* dpi);
+            void PaintFrameProfiler(rct_drawpixelinfo* dpi, Drawing::IDrawingEngine& de);
             void MeasureFPS();
         };
     } // namespace Paint
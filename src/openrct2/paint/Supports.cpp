@@ -15,6 +15,10 @@
 #include "Paint.h"
 #include "tile_element/Paint.TileElement.h"
 
+#include <array>
+#include <iterator>
+#include <vector>
+
 /** rct2: 0x0097AF20, 0x0097AF21 */
 // clang-format off
 static constexpr const CoordsXY SupportBoundBoxes[] = {
@@ -449,42 +453,162 @@ static constexpr const uint16_t word_97B3C4[] = {
 };
 // clang-format on
 
+namespace
+{
+    enum class SupportPaintOpType : uint8_t
+    {
+        Sub98196C,
+        Sub98197C,
+        // Prepended to session->WoodenSupportsPrependTo if there is one, used by curved supports
+        Sub98198CPrepend,
+    };
+
+    struct SupportPaintOp
+    {
+        SupportPaintOpType Type;
+        uint32_t ImageId;
+        int8_t OffsetX;
+        int8_t OffsetY;
+        int16_t OffsetZ;
+        int16_t BoundBoxLengthX;
+        int16_t BoundBoxLengthY;
+        int8_t BoundBoxLengthZ;
+        int16_t BoundBoxOffsetX;
+        int16_t BoundBoxOffsetY;
+        int16_t BoundBoxOffsetZ;
+    };
+
+    enum class SupportKind : uint32_t
+    {
+        WoodenA,
+        MetalA,
+        PathA,
+    };
+
+    // Everything the geometry of a support is worked out from
+    using SupportGeometryKey = std::array<uint32_t, 14>;
+
+    /**
+     * The paint calls of a support along with the results of working them out. They only depend on the key, so they
+     * are kept between frames and reused for every support with the same key, instead of being worked out each time.
+     */
+    struct SupportGeometry
+    {
+        SupportGeometryKey Key{};
+        bool IsValid{};
+        bool HasSupports{};
+        bool Underground{};
+        // The support segment the support ends on, which is updated with SegmentValue, or -1 if none is
+        int8_t SegmentIndex = -1;
+        support_height SegmentValue{};
+        std::vector<SupportPaintOp> Ops;
+
+        void Add98196C(
+            uint32_t imageId, int8_t xOffset, int8_t yOffset, int16_t boundBoxLengthX, int16_t boundBoxLengthY,
+            int8_t boundBoxLengthZ, int16_t zOffset)
+        {
+            Ops.push_back(
+                { SupportPaintOpType::Sub98196C, imageId, xOffset, yOffset, zOffset, boundBoxLengthX, boundBoxLengthY,
+                  boundBoxLengthZ, 0, 0, 0 });
+        }
+
+        void Add98197C(
+            uint32_t imageId, int8_t xOffset, int8_t yOffset, int16_t boundBoxLengthX, int16_t boundBoxLengthY,
+            int8_t boundBoxLengthZ, int16_t zOffset, int16_t boundBoxOffsetX, int16_t boundBoxOffsetY,
+            int16_t boundBoxOffsetZ, SupportPaintOpType type = SupportPaintOpType::Sub98197C)
+        {
+            Ops.push_back(
+                { type, imageId, xOffset, yOffset, zOffset, boundBoxLengthX, boundBoxLengthY, boundBoxLengthZ,
+                  boundBoxOffsetX, boundBoxOffsetY, boundBoxOffsetZ });
+        }
+    };
+
+    // A slot per key hash, every thread painting has its own as the viewport columns are painted in parallel
+    constexpr size_t SupportGeometryCacheSize = 1024;
+    thread_local std::array<SupportGeometry, SupportGeometryCacheSize> _supportGeometryCache;
+} // namespace
+
+static SupportGeometry& support_geometry_get_slot(const SupportGeometryKey& key)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (auto value : key)
+    {
+        hash ^= value;
+        hash *= 0x100000001B3ULL;
+    }
+    return _supportGeometryCache[(hash ^ (hash >> 32)) % SupportGeometryCacheSize];
+}
+
 /**
- * Adds paint structs for wooden supports.
- *  rct2: 0x006629BC
- * @param supportType (edi) Type and direction of supports.
- * @param special (ax) Used for curved supports.
- * @param height (dx) The height of the supports.
- * @param imageColourFlags (ebp) The colour and palette flags for the support sprites.
- * @param[out] underground (Carry flag) true if underground.
- * @returns (al) true if any supports have been drawn, otherwise false.
+ * Issues the paint calls of the support with the key, working them out with computeFn if they are not cached.
  */
-bool wooden_a_supports_paint_setup(
-    paint_session* session, int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags, bool* underground)
+template<typename TComputeFn>
+static bool support_geometry_paint(
+    paint_session* session, const SupportGeometryKey& key, bool* underground, TComputeFn&& computeFn)
 {
-    if (underground != nullptr)
+    auto& geometry = support_geometry_get_slot(key);
+    if (!geometry.IsValid || geometry.Key != key)
     {
-        *underground = false;
+        geometry.Key = key;
+        geometry.Underground = false;
+        geometry.SegmentIndex = -1;
+        geometry.Ops.clear();
+        geometry.HasSupports = computeFn(geometry);
+        geometry.IsValid = true;
     }
 
-    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
+    for (const auto& op : geometry.Ops)
     {
-        return false;
+        switch (op.Type)
+        {
+            case SupportPaintOpType::Sub98196C:
+                sub_98196C(
+                    session, op.ImageId, op.OffsetX, op.OffsetY, op.BoundBoxLengthX, op.BoundBoxLengthY, op.BoundBoxLengthZ,
+                    op.OffsetZ);
+                break;
+            case SupportPaintOpType::Sub98197C:
+                sub_98197C(
+                    session, op.ImageId, op.OffsetX, op.OffsetY, op.BoundBoxLengthX, op.BoundBoxLengthY, op.BoundBoxLengthZ,
+                    op.OffsetZ, op.BoundBoxOffsetX, op.BoundBoxOffsetY, op.BoundBoxOffsetZ);
+                break;
+            case SupportPaintOpType::Sub98198CPrepend:
+            {
+                auto ps = sub_98198C(
+                    session, op.ImageId, op.OffsetX, op.OffsetY, op.BoundBoxLengthX, op.BoundBoxLengthY, op.BoundBoxLengthZ,
+                    op.OffsetZ, op.BoundBoxOffsetX, op.BoundBoxOffsetY, op.BoundBoxOffsetZ);
+                if (ps != nullptr && session->WoodenSupportsPrependTo != nullptr)
+                {
+                    session->WoodenSupportsPrependTo->children = ps;
+                }
+                break;
+            }
+        }
     }
 
-    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
+    if (geometry.SegmentIndex >= 0)
     {
-        return false;
+        session->SupportSegments[geometry.SegmentIndex] = geometry.SegmentValue;
     }
+    if (underground != nullptr)
+    {
+        *underground = geometry.Underground;
+    }
+    return geometry.HasSupports;
+}
 
-    int32_t z = floor2(session->Support.height + 15, 16);
+/**
+ * Works out the paint calls of wooden_a_supports_paint_setup.
+ */
+static bool wooden_a_supports_compute(
+    int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags, support_height support,
+    uint16_t waterHeight, bool hasPrependTo, SupportGeometry& geometry)
+{
+    int32_t z = floor2(support.height + 15, 16);
     height -= z;
     if (height < 0)
     {
-        if (underground != nullptr)
-        {
-            *underground = true;
-        }
+        geometry.Underground = true;
         return false;
     }
     height /= 16;
@@ -493,7 +617,7 @@ bool wooden_a_supports_paint_setup(
     bool drawFlatPiece = false;
 
     // Draw base support (usually shaped to the slope)
-    int32_t slope = session->Support.slope;
+    int32_t slope = support.slope;
     if (slope & SUPPORTS_SLOPE_5)
     {
         // Above scenery (just put a base piece above it)
@@ -505,10 +629,7 @@ bool wooden_a_supports_paint_setup(
         height -= 2;
         if (height < 0)
         {
-            if (underground != nullptr)
-            {
-                *underground = true;
-            }
+            geometry.Underground = true;
             return false;
         }
 
@@ -521,9 +642,9 @@ bool wooden_a_supports_paint_setup(
         {
             imageId += word_97B3C4[slope & TILE_ELEMENT_SURFACE_SLOPE_MASK];
             imageId |= imageColourFlags;
-            sub_98197C(session, imageId, 0, 0, 32, 32, 11, z, 0, 0, z + 2);
+            geometry.Add98197C(imageId, 0, 0, 32, 32, 11, z, 0, 0, z + 2);
 
-            sub_98197C(session, imageId + 4, 0, 0, 32, 32, 11, z + 16, 0, 0, z + 16 + 2);
+            geometry.Add98197C(imageId + 4, 0, 0, 32, 32, 11, z + 16, 0, 0, z + 16 + 2);
 
             hasSupports = true;
         }
@@ -535,10 +656,7 @@ bool wooden_a_supports_paint_setup(
         height--;
         if (height < 0)
         {
-            if (underground != nullptr)
-            {
-                *underground = true;
-            }
+            geometry.Underground = true;
             return false;
         }
 
@@ -552,7 +670,7 @@ bool wooden_a_supports_paint_setup(
             imageId += word_97B3C4[slope & TILE_ELEMENT_SURFACE_SLOPE_MASK];
             imageId |= imageColourFlags;
 
-            sub_98197C(session, imageId, 0, 0, 32, 32, 11, z, 0, 0, z + 2);
+            geometry.Add98197C(imageId, 0, 0, 32, 32, 11, z, 0, 0, z + 2);
             hasSupports = true;
         }
         z += 16;
@@ -562,19 +680,19 @@ bool wooden_a_supports_paint_setup(
     if (drawFlatPiece)
     {
         int32_t imageId = WoodenSupportImageIds[supportType].flat | imageColourFlags;
-        sub_98196C(session, imageId, 0, 0, 32, 32, 0, z - 2);
+        geometry.Add98196C(imageId, 0, 0, 32, 32, 0, z - 2);
         hasSupports = true;
     }
 
     // Draw repeated supports for left over space
     while (height != 0)
     {
-        if ((z & 16) == 0 && height >= 2 && z + 16 != session->WaterHeight)
+        if ((z & 16) == 0 && height >= 2 && z + 16 != waterHeight)
         {
             // Full support
             int32_t imageId = WoodenSupportImageIds[supportType].full | imageColourFlags;
             uint8_t ah = height == 2 ? 23 : 28;
-            sub_98196C(session, imageId, 0, 0, 32, 32, ah, z);
+            geometry.Add98196C(imageId, 0, 0, 32, 32, ah, z);
             hasSupports = true;
             z += 32;
             height -= 2;
@@ -584,7 +702,7 @@ bool wooden_a_supports_paint_setup(
             // Half support
             int32_t imageId = WoodenSupportImageIds[supportType].half | imageColourFlags;
             uint8_t ah = height == 1 ? 7 : 12;
-            sub_98196C(session, imageId, 0, 0, 32, 32, ah, z);
+            geometry.Add98196C(imageId, 0, 0, 32, 32, ah, z);
             hasSupports = true;
             z += 16;
             height -= 1;
@@ -604,30 +722,67 @@ bool wooden_a_supports_paint_setup(
 
             unk_supports_desc_bound_box bBox = byte_97B23C[special].bounding_box;
 
-            if (byte_97B23C[special].var_6 == 0 || session->WoodenSupportsPrependTo == nullptr)
+            auto type = SupportPaintOpType::Sub98197C;
+            if (byte_97B23C[special].var_6 != 0 && hasPrependTo)
             {
-                sub_98197C(
-                    session, imageId, 0, 0, bBox.length.x, bBox.length.y, bBox.length.z, z, bBox.offset.x, bBox.offset.y,
-                    bBox.offset.z + z);
-                hasSupports = true;
-            }
-            else
-            {
-                hasSupports = true;
-                paint_struct* ps = sub_98198C(
-                    session, imageId, 0, 0, bBox.length.x, bBox.length.y, bBox.length.z, z, bBox.offset.x, bBox.offset.y,
-                    bBox.offset.z + z);
-                if (ps != nullptr)
-                {
-                    session->WoodenSupportsPrependTo->children = ps;
-                }
+                type = SupportPaintOpType::Sub98198CPrepend;
             }
+            geometry.Add98197C(
+                imageId, 0, 0, bBox.length.x, bBox.length.y, bBox.length.z, z, bBox.offset.x, bBox.offset.y,
+                bBox.offset.z + z, type);
+            hasSupports = true;
         }
     }
 
     return hasSupports;
 }
 
+/**
+ * Adds paint structs for wooden supports.
+ *  rct2: 0x006629BC
+ * @param supportType (edi) Type and direction of supports.
+ * @param special (ax) Used for curved supports.
+ * @param height (dx) The height of the supports.
+ * @param imageColourFlags (ebp) The colour and palette flags for the support sprites.
+ * @param[out] underground (Carry flag) true if underground.
+ * @returns (al) true if any supports have been drawn, otherwise false.
+ */
+bool wooden_a_supports_paint_setup(
+    paint_session* session, int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags, bool* underground)
+{
+    if (underground != nullptr)
+    {
+        *underground = false;
+    }
+
+    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
+    {
+        return false;
+    }
+
+    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
+    {
+        return false;
+    }
+
+    const auto support = session->Support;
+    const auto waterHeight = session->WaterHeight;
+    const bool hasPrependTo = session->WoodenSupportsPrependTo != nullptr;
+    const SupportGeometryKey key = {
+        static_cast<uint32_t>(SupportKind::WoodenA),
+        static_cast<uint32_t>(supportType),
+        static_cast<uint32_t>(special),
+        static_cast<uint32_t>(height),
+        imageColourFlags,
+        static_cast<uint32_t>(support.height) | (static_cast<uint32_t>(support.slope) << 16),
+        static_cast<uint32_t>(waterHeight) | (hasPrependTo ? 1u << 16 : 0),
+    };
+    return support_geometry_paint(session, key, underground, [&](SupportGeometry& geometry) {
+        return wooden_a_supports_compute(
+            supportType, special, height, imageColourFlags, support, waterHeight, hasPrependTo, geometry);
+    });
+}
+
 /**
  * Wooden supports
  *  rct2: 0x00662D5C
@@ -813,33 +968,15 @@ bool wooden_b_supports_paint_setup(
 }
 
 /**
- * Metal pole supports
- * @param supportType (edi)
- * @param segment (ebx)
- * @param special (ax)
- * @param height (edx)
- * @param imageColourFlags (ebp)
- *  rct2: 0x00663105
+ * Works out the paint calls of metal_a_supports_paint_setup.
  */
-bool metal_a_supports_paint_setup(
-    paint_session* session, uint8_t supportType, uint8_t segment, int32_t special, int32_t height, uint32_t imageColourFlags)
+static bool metal_a_supports_compute(
+    uint8_t supportType, uint8_t segment, int32_t special, int32_t height, uint32_t imageColourFlags, uint8_t rotation,
+    const support_height* supportSegments, SupportGeometry& geometry)
 {
-    support_height* supportSegments = session->SupportSegments;
-
-    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
-    {
-        return false;
-    }
-
-    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
-    {
-        return false;
-    }
-
     int16_t originalHeight = height;
     int32_t originalSegment = segment;
 
-    const uint8_t rotation = session->CurrentRotation;
     int16_t unk9E3294 = -1;
     if (height < supportSegments[segment].height)
     {
@@ -884,7 +1021,7 @@ bool metal_a_supports_paint_setup(
 
         uint32_t image_id = _metalSupportTypeToCrossbeamImages[supportType][ebp];
         image_id |= imageColourFlags;
-        sub_98196C(session, image_id, xOffset, yOffset, boundBoxLengthX, boundBoxLengthY, 1, height);
+        geometry.Add98196C(image_id, xOffset, yOffset, boundBoxLengthX, boundBoxLengthY, 1, height);
 
         segment = newSegment;
     }
@@ -903,7 +1040,7 @@ bool metal_a_supports_paint_setup(
         image_id += metal_supports_slope_image_map[supportSegments[segment].slope & TILE_ELEMENT_SURFACE_SLOPE_MASK];
         image_id |= imageColourFlags;
 
-        sub_98196C(session, image_id, xOffset, yOffset, 0, 0, 5, supportSegments[segment].height);
+        geometry.Add98196C(image_id, xOffset, yOffset, 0, 0, 5, supportSegments[segment].height);
 
         height = supportSegments[segment].height + 6;
     }
@@ -927,7 +1064,7 @@ bool metal_a_supports_paint_setup(
         image_id += heightDiff - 1;
         image_id |= imageColourFlags;
 
-        sub_98196C(session, image_id, xOffset, yOffset, 0, 0, heightDiff - 1, height);
+        geometry.Add98196C(image_id, xOffset, yOffset, 0, 0, heightDiff - 1, height);
     }
 
     height += heightDiff;
@@ -958,13 +1095,15 @@ bool metal_a_supports_paint_setup(
         if (count == 3 && z == 0x10)
             image_id++;
 
-        sub_98196C(session, image_id, xOffset, yOffset, 0, 0, z - 1, height);
+        geometry.Add98196C(image_id, xOffset, yOffset, 0, 0, z - 1, height);
 
         height += z;
     }
 
-    supportSegments[segment].height = unk9E3294;
-    supportSegments[segment].slope = 0x20;
+    geometry.SegmentIndex = segment;
+    geometry.SegmentValue = supportSegments[segment];
+    geometry.SegmentValue.height = unk9E3294;
+    geometry.SegmentValue.slope = 0x20;
 
     height = originalHeight;
     segment = originalSegment;
@@ -999,7 +1138,8 @@ bool metal_a_supports_paint_setup(
         image_id += z - 1;
         image_id |= imageColourFlags;
 
-        sub_98197C(session, image_id, xOffset, yOffset, 0, 0, 0, height, boundBoxOffset.x, boundBoxOffset.y, boundBoxOffset.z);
+        geometry.Add98197C(
+            image_id, xOffset, yOffset, 0, 0, 0, height, boundBoxOffset.x, boundBoxOffset.y, boundBoxOffset.z);
 
         height += z;
     }
@@ -1007,6 +1147,48 @@ bool metal_a_supports_paint_setup(
     return true;
 }
 
+/**
+ * Metal pole supports
+ * @param supportType (edi)
+ * @param segment (ebx)
+ * @param special (ax)
+ * @param height (edx)
+ * @param imageColourFlags (ebp)
+ *  rct2: 0x00663105
+ */
+bool metal_a_supports_paint_setup(
+    paint_session* session, uint8_t supportType, uint8_t segment, int32_t special, int32_t height, uint32_t imageColourFlags)
+{
+    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
+    {
+        return false;
+    }
+
+    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
+    {
+        return false;
+    }
+
+    const uint8_t rotation = session->CurrentRotation;
+    const support_height* supportSegments = session->SupportSegments;
+    SupportGeometryKey key = {
+        static_cast<uint32_t>(SupportKind::MetalA),
+        static_cast<uint32_t>(supportType) | (static_cast<uint32_t>(segment) << 8) | (static_cast<uint32_t>(rotation) << 16),
+        static_cast<uint32_t>(special),
+        static_cast<uint32_t>(height),
+        imageColourFlags,
+    };
+    for (size_t i = 0; i < std::size(session->SupportSegments); i++)
+    {
+        const auto& supportSegment = supportSegments[i];
+        key[5 + i] = static_cast<uint32_t>(supportSegment.height) | (static_cast<uint32_t>(supportSegment.slope) << 16);
+    }
+    return support_geometry_paint(session, key, nullptr, [&](SupportGeometry& geometry) {
+        return metal_a_supports_compute(
+            supportType, segment, special, height, imageColourFlags, rotation, supportSegments, geometry);
+    });
+}
+
 /**
  * Metal pole supports
  *  rct2: 0x00663584
@@ -1188,42 +1370,17 @@ bool metal_b_supports_paint_setup(
 }
 
 /**
- *  rct2: 0x006A2ECC
- *
- * @param supportType (edi)
- * @param special (ax)
- * @param height (dx)
- * @param imageColourFlags (ebp)
- * @param railingEntry (0x00F3EF6C)
- * @param[out] underground (Carry Flag)
- *
- * @return Whether supports were drawn
+ * Works out the paint calls of path_a_supports_paint_setup.
  */
-bool path_a_supports_paint_setup(
-    paint_session* session, int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags,
-    PathRailingsEntry* railingEntry, bool* underground)
+static bool path_a_supports_compute(
+    int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags, uint32_t bridgeImage,
+    support_height support, uint16_t waterHeight, bool hasPrependTo, SupportGeometry& geometry)
 {
-    if (underground != nullptr)
-    {
-        *underground = false; // AND
-    }
-
-    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
-    {
-        return false;
-    }
-
-    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
-    {
-        return false;
-    }
-
-    uint16_t baseHeight = ceil2(session->Support.height, 16);
+    uint16_t baseHeight = ceil2(support.height, 16);
     int32_t supportLength = height - baseHeight;
     if (supportLength < 0)
     {
-        if (underground != nullptr)
-            *underground = true; // STC
+        geometry.Underground = true; // STC
         return false;
     }
 
@@ -1231,47 +1388,43 @@ bool path_a_supports_paint_setup(
 
     int16_t heightSteps = supportLength / 16;
 
-    if (session->Support.slope & 0x20)
+    if (support.slope & 0x20)
     {
         // save dx2
-        sub_98196C(session, (railingEntry->bridge_image + 48) | imageColourFlags, 0, 0, 32, 32, 0, baseHeight - 2);
+        geometry.Add98196C((bridgeImage + 48) | imageColourFlags, 0, 0, 32, 32, 0, baseHeight - 2);
         hasSupports = true;
     }
-    else if (session->Support.slope & 0x10)
+    else if (support.slope & 0x10)
     {
         heightSteps -= 2;
         if (heightSteps < 0)
         {
-            if (underground != nullptr)
-                *underground = true; // STC
+            geometry.Underground = true; // STC
             return false;
         }
 
-        uint32_t imageId = (supportType * 24) + word_97B3C4[session->Support.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK]
-            + railingEntry->bridge_image;
+        uint32_t imageId = (supportType * 24) + word_97B3C4[support.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK] + bridgeImage;
 
-        sub_98197C(session, imageId | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
+        geometry.Add98197C(imageId | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
         baseHeight += 16;
 
-        sub_98197C(session, (imageId + 4) | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
+        geometry.Add98197C((imageId + 4) | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
         baseHeight += 16;
 
         hasSupports = true;
     }
-    else if (session->Support.slope & 0x0F)
+    else if (support.slope & 0x0F)
     {
         heightSteps -= 1;
         if (heightSteps < 0)
         {
-            if (underground != nullptr)
-                *underground = true; // STC
+            geometry.Underground = true; // STC
             return false;
         }
 
-        uint32_t ebx = (supportType * 24) + word_97B3C4[session->Support.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK]
-            + railingEntry->bridge_image;
+        uint32_t ebx = (supportType * 24) + word_97B3C4[support.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK] + bridgeImage;
 
-        sub_98197C(session, ebx | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
+        geometry.Add98197C(ebx | imageColourFlags, 0, 0, 32, 32, 11, baseHeight, 0, 0, baseHeight + 2);
 
         hasSupports = true;
         baseHeight += 16;
@@ -1279,20 +1432,20 @@ bool path_a_supports_paint_setup(
 
     while (heightSteps > 0)
     {
-        if (baseHeight & 0x10 || heightSteps == 1 || baseHeight + 16 == session->WaterHeight)
+        if (baseHeight & 0x10 || heightSteps == 1 || baseHeight + 16 == waterHeight)
         {
-            uint32_t imageId = (supportType * 24) + railingEntry->bridge_image + 23;
+            uint32_t imageId = (supportType * 24) + bridgeImage + 23;
 
-            sub_98196C(session, imageId | imageColourFlags, 0, 0, 32, 32, ((heightSteps == 1) ? 7 : 12), baseHeight);
+            geometry.Add98196C(imageId | imageColourFlags, 0, 0, 32, 32, ((heightSteps == 1) ? 7 : 12), baseHeight);
             heightSteps -= 1;
             baseHeight += 16;
             hasSupports = true;
         }
         else
         {
-            uint32_t imageId = (supportType * 24) + railingEntry->bridge_image + 22;
+            uint32_t imageId = (supportType * 24) + bridgeImage + 22;
 
-            sub_98196C(session, imageId | imageColourFlags, 0, 0, 32, 32, ((heightSteps == 2) ? 23 : 28), baseHeight);
+            geometry.Add98196C(imageId | imageColourFlags, 0, 0, 32, 32, ((heightSteps == 2) ? 23 : 28), baseHeight);
             heightSteps -= 2;
             baseHeight += 32;
             hasSupports = true;
@@ -1303,35 +1456,76 @@ bool path_a_supports_paint_setup(
     {
         uint16_t specialIndex = (special - 1) & 0xFFFF;
 
-        uint32_t imageId = railingEntry->bridge_image + 55 + specialIndex;
+        uint32_t imageId = bridgeImage + 55 + specialIndex;
 
         unk_supports_desc supportsDesc = byte_98D8D4[specialIndex];
         unk_supports_desc_bound_box boundBox = supportsDesc.bounding_box;
 
-        if (supportsDesc.var_6 == 0 || session->WoodenSupportsPrependTo == nullptr)
+        auto type = SupportPaintOpType::Sub98197C;
+        if (supportsDesc.var_6 != 0 && hasPrependTo)
         {
-            sub_98197C(
-                session, imageId | imageColourFlags, 0, 0, boundBox.length.y, boundBox.length.x, boundBox.length.z, baseHeight,
-                boundBox.offset.x, boundBox.offset.y, baseHeight + boundBox.offset.z);
-            hasSupports = true;
-        }
-        else
-        {
-            paint_struct* paintStruct = sub_98198C(
-                session, imageId | imageColourFlags, 0, 0, boundBox.length.y, boundBox.length.x, boundBox.length.z, baseHeight,
-                boundBox.offset.x, boundBox.offset.y, baseHeight + boundBox.offset.z);
-            hasSupports = true;
-            if (paintStruct != nullptr)
-            {
-                session->WoodenSupportsPrependTo->children = paintStruct;
-            }
+            type = SupportPaintOpType::Sub98198CPrepend;
         }
+        geometry.Add98197C(
+            imageId | imageColourFlags, 0, 0, boundBox.length.y, boundBox.length.x, boundBox.length.z, baseHeight,
+            boundBox.offset.x, boundBox.offset.y, baseHeight + boundBox.offset.z, type);
+        hasSupports = true;
     }
 
+    geometry.Underground = false; // AND
+
+    return hasSupports;
+}
+
+/**
+ *  rct2: 0x006A2ECC
+ *
+ * @param supportType (edi)
+ * @param special (ax)
+ * @param height (dx)
+ * @param imageColourFlags (ebp)
+ * @param railingEntry (0x00F3EF6C)
+ * @param[out] underground (Carry Flag)
+ *
+ * @return Whether supports were drawn
+ */
+bool path_a_supports_paint_setup(
+    paint_session* session, int32_t supportType, int32_t special, int32_t height, uint32_t imageColourFlags,
+    PathRailingsEntry* railingEntry, bool* underground)
+{
     if (underground != nullptr)
+    {
         *underground = false; // AND
+    }
 
-    return hasSupports;
+    if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SUPPORTS)
+    {
+        return false;
+    }
+
+    if (!(session->Unk141E9DB & G141E9DB_FLAG_1))
+    {
+        return false;
+    }
+
+    const uint32_t bridgeImage = railingEntry->bridge_image;
+    const auto support = session->Support;
+    const auto waterHeight = session->WaterHeight;
+    const bool hasPrependTo = session->WoodenSupportsPrependTo != nullptr;
+    const SupportGeometryKey key = {
+        static_cast<uint32_t>(SupportKind::PathA),
+        static_cast<uint32_t>(supportType),
+        static_cast<uint32_t>(special),
+        static_cast<uint32_t>(height),
+        imageColourFlags,
+        static_cast<uint32_t>(support.height) | (static_cast<uint32_t>(support.slope) << 16),
+        static_cast<uint32_t>(waterHeight) | (hasPrependTo ? 1u << 16 : 0),
+        bridgeImage,
+    };
+    return support_geometry_paint(session, key, underground, [&](SupportGeometry& geometry) {
+        return path_a_supports_compute(
+            supportType, special, height, imageColourFlags, bridgeImage, support, waterHeight, hasPrependTo, geometry);
+    });
 }
 
 /**
@@ -0,0 +1,687 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TilePaintCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../interface/Viewport.h"
+#include "../interface/ZoomLevel.hpp"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Banner.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/Sprite.h"
+#include "Paint.h"
+#include "VirtualFloor.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A single call to one of the paint primitives together with the session state it reads.
+ */
+struct TilePaintOp
+{
+    const void* CurrentlyDrawnItem;
+    CoordsXY SpritePosition;
+    CoordsXYZ Offset;
+    CoordsXYZ BoundBoxLength;
+    CoordsXYZ BoundBoxOffset;
+    uint32_t ImageId;
+    TilePaintOpType Type;
+    ViewportInteractionItem InteractionType;
+
+    // Values the paint code assigned to the created paint struct after the primitive returned.
+    bool HasFinalValues;
+    uint8_t FinalFlags;
+    uint32_t FinalImageId;
+    uint32_t FinalColour;
+};
+
+/**
+ * The session state left behind by painting a tile that the painting of the following tiles can read.
+ */
+struct TilePaintEndState
+{
+    const void* CurrentlyDrawnItem;
+    CoordsXY SpritePosition;
+    ViewportInteractionItem InteractionType;
+    support_height SupportSegments[9];
+    support_height Support;
+    TileElement* PathElementOnSameHeight;
+    TileElement* TrackElementOnSameHeight;
+    const TileElement* SurfaceElement;
+    bool DidPassSurface;
+    uint16_t WaterHeight;
+    uint8_t Unk141E9DB;
+};
+
+struct TilePaintRecorder
+{
+    CoordsXY MapPosition;
+    std::vector<TilePaintOp> Ops;
+    std::vector<void*> Results;
+    std::vector<paint_entry> CreatedEntries;
+    paint_struct* ExpectedLastRootPS = nullptr;
+    attached_paint_struct* ExpectedUnkF1AD2C = nullptr;
+    bool HasRoot = false;
+    bool IsValid = true;
+
+    void BeginOp(paint_session* session, TilePaintOp& op);
+    void EndOp(paint_session* session, const TilePaintOp& op, void* result);
+    void Finish(paint_session* session);
+};
+
+namespace
+{
+    struct TilePaintCacheEntry
+    {
+        uint64_t StateHash{};
+        uint64_t TileHash{};
+        const TileElement* FirstElement{};
+        bool IsCacheable{};
+        std::vector<TilePaintOp> Ops;
+        TilePaintEndState EndState{};
+    };
+
+    struct TilePaintCacheShard
+    {
+        std::mutex Mutex;
+        std::unordered_map<uint32_t, TilePaintCacheEntry> Entries;
+        size_t NumOps{};
+    };
+
+    // Tiles are spread over several independently locked shards, the viewport columns are painted in parallel.
+    constexpr size_t NumShards = 64;
+    // Limits the memory used by the cache, a full shard is emptied and filled again from the tiles being drawn.
+    constexpr size_t MaxOpsPerShard = 4096;
+
+    // The tile itself first, followed by the neighbours whose surfaces are taken into account when painting it.
+    // Set in the keys of entries holding only the surface of a tile, for tiles that can not be cached as a whole.
+    constexpr uint32_t SurfaceOnlyKeyFlag = 1u << 30;
+
+    constexpr const CoordsXY TileAndNeighbourOffsets[] = {
+        { 0, 0 }, { -COORDS_XY_STEP, 0 }, { 0, COORDS_XY_STEP }, { COORDS_XY_STEP, 0 }, { 0, -COORDS_XY_STEP },
+    };
+
+    std::array<TilePaintCacheShard, NumShards> _shards;
+    std::atomic<uint32_t> _generation = { 0 };
+
+    thread_local paint_session _recordingSession;
+} // namespace
+
+static PaintEntryPool& tile_paint_cache_get_recording_pool()
+{
+    static PaintEntryPool pool;
+    return pool;
+}
+
+static TilePaintCacheShard& tile_paint_cache_get_shard(const CoordsXY& mapPos)
+{
+    const auto tileX = static_cast<uint32_t>(mapPos.x / COORDS_XY_STEP);
+    const auto tileY = static_cast<uint32_t>(mapPos.y / COORDS_XY_STEP);
+    return _shards[(tileX * 31 + tileY) % NumShards];
+}
+
+static uint32_t tile_paint_cache_get_key(const CoordsXY& mapPos, uint8_t rotation, ZoomLevel zoom, bool surfaceOnly)
+{
+    const auto tileX = static_cast<uint32_t>(mapPos.x / COORDS_XY_STEP) & 0xFFF;
+    const auto tileY = static_cast<uint32_t>(mapPos.y / COORDS_XY_STEP) & 0xFFF;
+    const auto zoomBits = static_cast<uint32_t>(static_cast<int8_t>(zoom)) & 0xF;
+    const uint32_t key = tileX | (tileY << 12) | (static_cast<uint32_t>(rotation & 3) << 24) | (zoomBits << 26);
+    return surfaceOnly ? (key | SurfaceOnlyKeyFlag) : key;
+}
+
+static void tile_paint_cache_hash_combine(uint64_t& hash, const void* data, size_t length)
+{
+    // FNV-1a
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+}
+
+uint64_t tile_paint_cache_get_state_hash(uint32_t viewFlags)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const uint32_t generation = _generation;
+    const uint8_t screenFlags = gScreenFlags;
+    // Read by the height markers.
+    const int16_t heights[] = { get_height_marker_offset(), gMapBaseZ };
+    const bool flags[] = { gConfigGeneral.landscape_smoothing, gPaintWidePathsAsGhost, gPaintBlockedTiles, gCheatsSandboxMode };
+    tile_paint_cache_hash_combine(hash, &generation, sizeof(generation));
+    tile_paint_cache_hash_combine(hash, &viewFlags, sizeof(viewFlags));
+    tile_paint_cache_hash_combine(hash, &gMapSize, sizeof(gMapSize));
+    tile_paint_cache_hash_combine(hash, &screenFlags, sizeof(screenFlags));
+    tile_paint_cache_hash_combine(hash, heights, sizeof(heights));
+    tile_paint_cache_hash_combine(hash, flags, sizeof(flags));
+    return hash;
+}
+
+/**
+ * Returns whether the element is drawn the same in every frame as long as its data does not change.
+ */
+static bool tile_paint_cache_is_element_static(const TileElement* tileElement)
+{
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_SURFACE:
+            return true;
+        case TILE_ELEMENT_TYPE_PATH:
+            // Queue banners show the scrolling name of the ride.
+            return !tileElement->AsPath()->HasQueueBanner();
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        {
+            auto entry = tileElement->AsSmallScenery()->GetEntry();
+            return entry != nullptr && !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED);
+        }
+        case TILE_ELEMENT_TYPE_WALL:
+        {
+            auto entry = tileElement->AsWall()->GetEntry();
+            return entry != nullptr && !(entry->wall.flags2 & WALL_SCENERY_2_ANIMATED)
+                && entry->wall.scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+        {
+            // The text of signs is read from the banner rather than the element.
+            auto entry = tileElement->AsLargeScenery()->GetEntry();
+            return entry != nullptr && !(entry->large_scenery.flags & (LARGE_SCENERY_FLAG_3D_TEXT | LARGE_SCENERY_FLAG_ANIMATED))
+                && entry->large_scenery.scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        default:
+            return false;
+    }
+}
+
+static void tile_paint_cache_hash_neighbour_surfaces(const CoordsXY& mapPos, uint64_t& hash)
+{
+    for (size_t i = 1; i < std::size(TileAndNeighbourOffsets); i++)
+    {
+        const auto& offset = TileAndNeighbourOffsets[i];
+        auto surfaceElement = map_get_surface_element_at(mapPos + offset);
+        if (surfaceElement != nullptr)
+        {
+            tile_paint_cache_hash_combine(hash, surfaceElement, sizeof(TileElement));
+        }
+    }
+}
+
+/**
+ * Hashes the elements of the tile and the surfaces of its neighbours, returns false if the tile can not be cached.
+ */
+static bool tile_paint_cache_hash_tile(const CoordsXY& mapPos, const TileElement* firstElement, uint64_t& hash)
+{
+    // Elements below the surface would see the surface of the previously painted tile.
+    if (firstElement->GetType() != TILE_ELEMENT_TYPE_SURFACE || firstElement->GetBaseZ() == 0)
+    {
+        return false;
+    }
+
+    hash = 0xCBF29CE484222325ULL;
+    const TileElement* tileElement = firstElement;
+    do
+    {
+        if (!tile_paint_cache_is_element_static(tileElement))
+        {
+            return false;
+        }
+        tile_paint_cache_hash_combine(hash, tileElement, sizeof(TileElement));
+    } while (!(tileElement++)->IsLastForTile());
+
+    tile_paint_cache_hash_neighbour_surfaces(mapPos, hash);
+    return true;
+}
+
+bool tile_paint_cache_is_overlay_visible(uint32_t viewFlags)
+{
+    if (viewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+        return true;
+    if (gMapSelectFlags != 0 || gStaffDrawPatrolAreas != SPRITE_INDEX_NULL || gTrackDesignSaveMode
+        || gShowSupportSegmentHeights)
+        return true;
+    if (gConfigGeneral.virtual_floor_style != VirtualFloorStyles::Off && virtual_floor_is_enabled())
+        return true;
+    // Peep spawns are not part of the tile elements.
+    if ((viewFlags & VIEWPORT_FLAG_LAND_OWNERSHIP) && ((gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) || gCheatsSandboxMode))
+        return true;
+    return false;
+}
+
+static bool tile_paint_cache_is_bypassed(const paint_session* session)
+{
+    if (session->Unk141E9DB != 0 || session->WoodenSupportsPrependTo != nullptr)
+        return true;
+    return tile_paint_cache_is_overlay_visible(session->ViewFlags);
+}
+
+static void* tile_paint_cache_issue(paint_session* session, const TilePaintOp& op)
+{
+    switch (op.Type)
+    {
+        case TilePaintOpType::Sub98196C:
+            return sub_98196C(
+                session, op.ImageId, static_cast<int8_t>(op.Offset.x), static_cast<int8_t>(op.Offset.y),
+                static_cast<int16_t>(op.BoundBoxLength.x), static_cast<int16_t>(op.BoundBoxLength.y),
+                static_cast<int8_t>(op.BoundBoxLength.z), static_cast<int16_t>(op.Offset.z));
+        case TilePaintOpType::Sub98197C:
+            return sub_98197C(
+                session, op.ImageId, static_cast<int8_t>(op.Offset.x), static_cast<int8_t>(op.Offset.y),
+                static_cast<int16_t>(op.BoundBoxLength.x), static_cast<int16_t>(op.BoundBoxLength.y),
+                static_cast<int8_t>(op.BoundBoxLength.z), static_cast<int16_t>(op.Offset.z),
+                static_cast<int16_t>(op.BoundBoxOffset.x), static_cast<int16_t>(op.BoundBoxOffset.y),
+                static_cast<int16_t>(op.BoundBoxOffset.z));
+        case TilePaintOpType::Sub98198C:
+            return sub_98198C(
+                session, op.ImageId, static_cast<int8_t>(op.Offset.x), static_cast<int8_t>(op.Offset.y),
+                static_cast<int16_t>(op.BoundBoxLength.x), static_cast<int16_t>(op.BoundBoxLength.y),
+                static_cast<int8_t>(op.BoundBoxLength.z), static_cast<int16_t>(op.Offset.z),
+                static_cast<int16_t>(op.BoundBoxOffset.x), static_cast<int16_t>(op.BoundBoxOffset.y),
+                static_cast<int16_t>(op.BoundBoxOffset.z));
+        case TilePaintOpType::Sub98199C:
+            return sub_98199C(session, op.ImageId, op.Offset, op.BoundBoxLength, op.BoundBoxOffset);
+        case TilePaintOpType::AttachToPreviousPS:
+            if (paint_attach_to_previous_ps(
+                    session, op.ImageId, static_cast<int16_t>(op.Offset.x), static_cast<int16_t>(op.Offset.y)))
+            {
+                return session->UnkF1AD2C;
+            }
+            return nullptr;
+        case TilePaintOpType::AttachToPreviousAttach:
+            if (paint_attach_to_previous_attach(
+                    session, op.ImageId, static_cast<int16_t>(op.Offset.x), static_cast<int16_t>(op.Offset.y)))
+            {
+                return session->UnkF1AD2C;
+            }
+            return nullptr;
+    }
+    return nullptr;
+}
+
+static bool tile_paint_cache_is_attach(TilePaintOpType type)
+{
+    return type == TilePaintOpType::AttachToPreviousPS || type == TilePaintOpType::AttachToPreviousAttach;
+}
+
+void TilePaintRecorder::BeginOp(paint_session* session, TilePaintOp& op)
+{
+    // The primitives are replayed in order, so changes the paint code makes to the chaining state in between
+    // them or reading the state left behind by a previous tile can not be reproduced.
+    if (session->LastRootPS != ExpectedLastRootPS || session->UnkF1AD2C != ExpectedUnkF1AD2C)
+        IsValid = false;
+    if (!HasRoot && (op.Type == TilePaintOpType::Sub98199C || tile_paint_cache_is_attach(op.Type)))
+        IsValid = false;
+    if (session->MapPosition != MapPosition)
+        IsValid = false;
+
+    op.CurrentlyDrawnItem = session->CurrentlyDrawnItem;
+    op.SpritePosition = session->SpritePosition;
+    op.InteractionType = session->InteractionType;
+}
+
+void TilePaintRecorder::EndOp(paint_session* session, const TilePaintOp& op, void* result)
+{
+    if (!tile_paint_cache_is_attach(op.Type))
+        HasRoot = true;
+    ExpectedLastRootPS = session->LastRootPS;
+    ExpectedUnkF1AD2C = session->UnkF1AD2C;
+
+    paint_entry created{};
+    if (result != nullptr)
+    {
+        if (tile_paint_cache_is_attach(op.Type))
+            created.attached = *static_cast<attached_paint_struct*>(result);
+        else
+            created.basic = *static_cast<paint_struct*>(result);
+    }
+    Ops.push_back(op);
+    Results.push_back(result);
+    CreatedEntries.push_back(created);
+}
+
+void TilePaintRecorder::Finish(paint_session* session)
+{
+    if (session->WoodenSupportsPrependTo != nullptr || session->PSStringHead != nullptr)
+        IsValid = false;
+
+    // Find the values the paint code changed after the paint structs were created. They are only ever changed when
+    // the primitive succeeded, so they can be applied right after replaying it.
+    for (size_t i = 0; i < Ops.size() && IsValid; i++)
+    {
+        auto& op = Ops[i];
+        if (Results[i] == nullptr)
+            continue;
+
+        if (tile_paint_cache_is_attach(op.Type))
+        {
+            const auto& created = CreatedEntries[i].attached;
+            const auto& current = *static_cast<const attached_paint_struct*>(Results[i]);
+            if (current.x != created.x || current.y != created.y)
+                IsValid = false;
+            op.HasFinalValues = current.image_id != created.image_id || current.colour_image_id != created.colour_image_id
+                || current.flags != created.flags;
+            op.FinalImageId = current.image_id;
+            op.FinalColour = current.colour_image_id;
+            op.FinalFlags = current.flags;
+        }
+        else
+        {
+            const auto& created = CreatedEntries[i].basic;
+            const auto& current = *static_cast<const paint_struct*>(Results[i]);
+            if (std::memcmp(&current.bounds, &created.bounds, sizeof(created.bounds)) != 0 || current.x != created.x
+                || current.y != created.y || current.sprite_type != created.sprite_type || current.var_29 != created.var_29
+                || current.map_x != created.map_x || current.map_y != created.map_y || current.tileElement != created.tileElement)
+                IsValid = false;
+            op.HasFinalValues = current.image_id != created.image_id || current.tertiary_colour != created.tertiary_colour
+                || current.flags != created.flags;
+            op.FinalImageId = current.image_id;
+            op.FinalColour = current.tertiary_colour;
+            op.FinalFlags = current.flags;
+        }
+    }
+}
+
+paint_struct* tile_paint_cache_record(
+    paint_session* session, TilePaintOpType type, uint32_t imageId, const CoordsXYZ& offset, const CoordsXYZ& boundBoxLength,
+    const CoordsXYZ& boundBoxOffset)
+{
+    auto recorder = session->TileRecorder;
+
+    TilePaintOp op{};
+    op.Type = type;
+    op.ImageId = imageId;
+    op.Offset = offset;
+    op.BoundBoxLength = boundBoxLength;
+    op.BoundBoxOffset = boundBoxOffset;
+    recorder->BeginOp(session, op);
+
+    // Calls made by the primitive itself are part of this one.
+    session->TileRecorder = nullptr;
+    auto result = static_cast<paint_struct*>(tile_paint_cache_issue(session, op));
+    session->TileRecorder = recorder;
+
+    recorder->EndOp(session, op, result);
+    return result;
+}
+
+bool tile_paint_cache_record_attach(paint_session* session, TilePaintOpType type, uint32_t imageId, int16_t x, int16_t y)
+{
+    auto recorder = session->TileRecorder;
+
+    TilePaintOp op{};
+    op.Type = type;
+    op.ImageId = imageId;
+    op.Offset = { x, y, 0 };
+    recorder->BeginOp(session, op);
+
+    session->TileRecorder = nullptr;
+    auto result = tile_paint_cache_issue(session, op);
+    session->TileRecorder = recorder;
+
+    recorder->EndOp(session, op, result);
+    return result != nullptr;
+}
+
+void tile_paint_cache_record_unsupported(paint_session* session)
+{
+    session->TileRecorder->IsValid = false;
+}
+
+static TilePaintEndState tile_paint_cache_get_end_state(const paint_session* session)
+{
+    TilePaintEndState state{};
+    state.CurrentlyDrawnItem = session->CurrentlyDrawnItem;
+    state.SpritePosition = session->SpritePosition;
+    state.InteractionType = session->InteractionType;
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), std::begin(state.SupportSegments));
+    state.Support = session->Support;
+    state.PathElementOnSameHeight = session->PathElementOnSameHeight;
+    state.TrackElementOnSameHeight = session->TrackElementOnSameHeight;
+    state.SurfaceElement = session->SurfaceElement;
+    state.DidPassSurface = session->DidPassSurface;
+    state.WaterHeight = session->WaterHeight;
+    state.Unk141E9DB = session->Unk141E9DB;
+    return state;
+}
+
+static void tile_paint_cache_set_end_state(paint_session* session, const TilePaintEndState& state)
+{
+    session->CurrentlyDrawnItem = state.CurrentlyDrawnItem;
+    session->SpritePosition = state.SpritePosition;
+    session->InteractionType = state.InteractionType;
+    std::copy(std::begin(state.SupportSegments), std::end(state.SupportSegments), std::begin(session->SupportSegments));
+    session->Support = state.Support;
+    session->PathElementOnSameHeight = state.PathElementOnSameHeight;
+    session->TrackElementOnSameHeight = state.TrackElementOnSameHeight;
+    session->SurfaceElement = state.SurfaceElement;
+    session->DidPassSurface = state.DidPassSurface;
+    session->WaterHeight = state.WaterHeight;
+    session->Unk141E9DB = state.Unk141E9DB;
+}
+
+static void tile_paint_cache_replay(paint_session* session, const TilePaintCacheEntry& entry)
+{
+    for (const auto& op : entry.Ops)
+    {
+        session->CurrentlyDrawnItem = op.CurrentlyDrawnItem;
+        session->SpritePosition = op.SpritePosition;
+        session->InteractionType = op.InteractionType;
+
+        auto result = tile_paint_cache_issue(session, op);
+        if (result == nullptr || !op.HasFinalValues)
+            continue;
+
+        if (tile_paint_cache_is_attach(op.Type))
+        {
+            auto attached = static_cast<attached_paint_struct*>(result);
+            attached->image_id = op.FinalImageId;
+            attached->colour_image_id = op.FinalColour;
+            attached->flags = op.FinalFlags;
+        }
+        else
+        {
+            auto ps = static_cast<paint_struct*>(result);
+            ps->image_id = op.FinalImageId;
+            ps->tertiary_colour = op.FinalColour;
+            ps->flags = op.FinalFlags;
+        }
+    }
+    tile_paint_cache_set_end_state(session, entry.EndState);
+}
+
+/**
+ * Paints the tile into a session without a clip rectangle so that every primitive the tile issues is recorded,
+ * whichever part of it is visible in the session being drawn.
+ */
+static void tile_paint_cache_record_tile(
+    paint_session* session, TileElement* firstElement, TileElementsPaintFn paintFn, TilePaintCacheEntry& entry)
+{
+    auto& recordingSession = _recordingSession;
+    static_cast<paint_session_core&>(recordingSession) = *session;
+    recordingSession.DPI.x = -16384;
+    recordingSession.DPI.y = -16384;
+    recordingSession.DPI.width = INT16_MAX;
+    recordingSession.DPI.height = INT16_MAX;
+    recordingSession.LastRootPS = nullptr;
+    recordingSession.UnkF1AD2C = nullptr;
+    recordingSession.PSStringHead = nullptr;
+    recordingSession.LastPSString = nullptr;
+    recordingSession.PaintEntryChain = tile_paint_cache_get_recording_pool().Create();
+
+    TilePaintRecorder recorder;
+    recorder.MapPosition = session->MapPosition;
+    recordingSession.TileRecorder = &recorder;
+    auto lastElement = paintFn(&recordingSession, firstElement);
+    recordingSession.TileRecorder = nullptr;
+    recorder.Finish(&recordingSession);
+
+    entry.IsCacheable = recorder.IsValid && lastElement != nullptr;
+    entry.Ops.clear();
+    if (entry.IsCacheable)
+    {
+        entry.Ops = std::move(recorder.Ops);
+        entry.EndState = tile_paint_cache_get_end_state(&recordingSession);
+    }
+
+    // Leave the chain empty, the thread local session can outlive the pool.
+    recordingSession.PaintEntryChain.Clear();
+}
+
+/**
+ * Replays the entry stored under the key if it is still valid, records it again using paintFn otherwise.
+ */
+static bool tile_paint_cache_paint_entry(
+    paint_session* session, uint32_t key, uint64_t tileHash, TileElement* firstElement, TileElementsPaintFn paintFn)
+{
+    const auto stateHash = tile_paint_cache_get_state_hash(session->ViewFlags);
+    auto& shard = tile_paint_cache_get_shard(session->MapPosition);
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        auto it = shard.Entries.find(key);
+        if (it != shard.Entries.end())
+        {
+            const auto& entry = it->second;
+            if (entry.StateHash == stateHash && entry.TileHash == tileHash && entry.FirstElement == firstElement)
+            {
+                if (!entry.IsCacheable)
+                {
+                    return false;
+                }
+                tile_paint_cache_replay(session, entry);
+                return true;
+            }
+        }
+    }
+
+    TilePaintCacheEntry newEntry;
+    newEntry.StateHash = stateHash;
+    newEntry.TileHash = tileHash;
+    newEntry.FirstElement = firstElement;
+    tile_paint_cache_record_tile(session, firstElement, paintFn, newEntry);
+
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    auto& entry = shard.Entries[key];
+    shard.NumOps -= entry.Ops.size();
+    if (shard.NumOps + newEntry.Ops.size() > MaxOpsPerShard)
+    {
+        shard.Entries.clear();
+        shard.NumOps = 0;
+    }
+    shard.NumOps += newEntry.Ops.size();
+    auto& storedEntry = shard.Entries[key] = std::move(newEntry);
+    if (!storedEntry.IsCacheable)
+    {
+        return false;
+    }
+    tile_paint_cache_replay(session, storedEntry);
+    return true;
+}
+
+bool tile_paint_cache_paint(paint_session* session, TileElement* firstElement, TileElementsPaintFn paintFn)
+{
+    if (tile_paint_cache_is_bypassed(session))
+    {
+        return false;
+    }
+
+    const auto mapPos = session->MapPosition;
+    uint64_t tileHash;
+    if (!tile_paint_cache_hash_tile(mapPos, firstElement, tileHash))
+    {
+        return false;
+    }
+
+    const auto key = tile_paint_cache_get_key(mapPos, session->CurrentRotation, session->DPI.zoom_level, false);
+    return tile_paint_cache_paint_entry(session, key, tileHash, firstElement, paintFn);
+}
+
+static TileElement* tile_paint_cache_paint_surface_element(paint_session* session, TileElement* tileElement)
+{
+    const auto direction = tileElement->GetDirectionWithOffset(session->CurrentRotation);
+    surface_paint(session, direction, tileElement->GetBaseZ(), tileElement);
+    return tileElement + 1;
+}
+
+bool tile_paint_cache_paint_surface(paint_session* session, TileElement* surfaceElement)
+{
+    // While a whole tile is being recorded its surface is part of that recording.
+    if (session->TileRecorder != nullptr || tile_paint_cache_is_bypassed(session))
+    {
+        return false;
+    }
+
+    // The surface has to be painted first, before anything it could read from the session is set by other elements.
+    const auto mapPos = session->MapPosition;
+    if (session->DidPassSurface || surfaceElement->GetBaseZ() == 0 || map_get_first_element_at(mapPos) != surfaceElement)
+    {
+        return false;
+    }
+
+    uint64_t tileHash = 0xCBF29CE484222325ULL;
+    tile_paint_cache_hash_combine(tileHash, surfaceElement, sizeof(TileElement));
+    tile_paint_cache_hash_neighbour_surfaces(mapPos, tileHash);
+
+    // Found by the tile painting for the elements on the height of the surface, those following it still use them.
+    auto pathElementOnSameHeight = session->PathElementOnSameHeight;
+    auto trackElementOnSameHeight = session->TrackElementOnSameHeight;
+
+    const auto key = tile_paint_cache_get_key(mapPos, session->CurrentRotation, session->DPI.zoom_level, true);
+    const bool painted = tile_paint_cache_paint_entry(
+        session, key, tileHash, surfaceElement, tile_paint_cache_paint_surface_element);
+
+    session->PathElementOnSameHeight = pathElementOnSameHeight;
+    session->TrackElementOnSameHeight = trackElementOnSameHeight;
+    return painted;
+}
+
+void tile_paint_cache_invalidate(const CoordsXY& mapPos)
+{
+    const CoordsXY tilePos = mapPos.ToTileStart();
+    for (const auto& offset : TileAndNeighbourOffsets)
+    {
+        const auto pos = tilePos + offset;
+        auto& shard = tile_paint_cache_get_shard(pos);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        if (shard.Entries.empty())
+            continue;
+
+        for (uint8_t rotation = 0; rotation < 4; rotation++)
+        {
+            for (auto zoom = ZoomLevel::min(); zoom <= ZoomLevel::max(); zoom++)
+            {
+                for (bool surfaceOnly : { false, true })
+                {
+                    auto it = shard.Entries.find(tile_paint_cache_get_key(pos, rotation, zoom, surfaceOnly));
+                    if (it != shard.Entries.end())
+                    {
+                        shard.NumOps -= it->second.Ops.size();
+                        shard.Entries.erase(it);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void tile_paint_cache_invalidate_all()
+{
+    // Entries of an older generation are replaced as the tiles are drawn again.
+    _generation++;
+}
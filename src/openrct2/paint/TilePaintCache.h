@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct paint_session;
+struct paint_struct;
+struct TileElement;
+
+/**
+ * The paint primitives a tile can issue, recorded so they can be issued again in later frames.
+ */
+enum class TilePaintOpType : uint8_t
+{
+    Sub98196C,
+    Sub98197C,
+    Sub98198C,
+    Sub98199C,
+    AttachToPreviousPS,
+    AttachToPreviousAttach,
+};
+
+using TileElementsPaintFn = TileElement* (*)(paint_session* session, TileElement* tileElement);
+
+/**
+ * Paints the elements of the tile at session->MapPosition from the cache, recording them with paintFn first if
+ * needed. Only tiles made up of elements whose appearance solely depends on the tile element data are cached,
+ * for any other tile false is returned and the caller has to paint the elements itself.
+ */
+bool tile_paint_cache_paint(paint_session* session, TileElement* firstElement, TileElementsPaintFn paintFn);
+
+/**
+ * Paints the surface element at session->MapPosition from the cache, for tiles that can not be cached as a whole
+ * because of the other elements on them. The surface has to be the first element of the tile, returns false if it
+ * was not painted and the caller has to paint it itself.
+ */
+bool tile_paint_cache_paint_surface(paint_session* session, TileElement* surfaceElement);
+
+/**
+ * Drops the cached paint calls of a tile, together with those of its neighbours as surfaces are painted using
+ * the heights of the tiles next to them.
+ */
+void tile_paint_cache_invalidate(const CoordsXY& mapPos);
+void tile_paint_cache_invalidate_all();
+
+/**
+ * Hashes everything outside of the tile elements that the painting of static elements depends on.
+ */
+uint64_t tile_paint_cache_get_state_hash(uint32_t viewFlags);
+
+/**
+ * Returns whether something other than the tile elements is currently drawn on top of the tiles.
+ */
+bool tile_paint_cache_is_overlay_visible(uint32_t viewFlags);
+
+// Called by the paint primitives while a tile is being recorded.
+paint_struct* tile_paint_cache_record(
+    paint_session* session, TilePaintOpType type, uint32_t imageId, const CoordsXYZ& offset, const CoordsXYZ& boundBoxLength,
+    const CoordsXYZ& boundBoxOffset);
+bool tile_paint_cache_record_attach(paint_session* session, TilePaintOpType type, uint32_t imageId, int16_t x, int16_t y);
+void tile_paint_cache_record_unsupported(paint_session* session);
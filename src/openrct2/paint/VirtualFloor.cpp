@@ -21,7 +21,9 @@
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
 
 static uint16_t _virtualFloorBaseSize = 5 * 32;
 static uint16_t _virtualFloorHeight = 0;
@@ -36,6 +38,38 @@ enum VirtualFloorFlags
     VIRTUAL_FLOOR_FORCE_INVALIDATION = (1 << 2),
 };
 
+// Properties of a tile that only depend on its elements and the virtual floor height
+enum VirtualFloorTileFlags : uint32_t
+{
+    VIRTUAL_FLOOR_TILE_OCCUPIED = (1 << 4),
+    VIRTUAL_FLOOR_TILE_BELOW_GROUND = (1 << 5),
+    VIRTUAL_FLOOR_TILE_ABOVE_GROUND = (1 << 6),
+    VIRTUAL_FLOOR_TILE_GHOST = (1 << 7),
+    VIRTUAL_FLOOR_TILE_OWNED = (1 << 8),
+    VIRTUAL_FLOOR_TILE_OCCUPIED_EDGES_MASK = 0x0F,
+    VIRTUAL_FLOOR_TILE_PROPERTIES_MASK = 0xFFFF,
+};
+
+/**
+ * The properties of each tile are kept for the current height, every tile of the floor looks at its four neighbours
+ * and walking their elements again each frame is what makes the floor expensive. An entry holds the generation it
+ * was computed for in its upper 16 bits, moving the floor to another height only bumps the generation. Tiles are
+ * painted on several threads at once, which may compute the same entry twice but always store the same value.
+ */
+static std::unique_ptr<std::atomic<uint32_t>[]> _virtualFloorTileCache;
+static uint32_t _virtualFloorTileCacheGeneration = 0;
+
+static void virtual_floor_next_generation()
+{
+    _virtualFloorTileCacheGeneration = (_virtualFloorTileCacheGeneration + 1) & 0xFFFF;
+    if (_virtualFloorTileCacheGeneration == 0)
+    {
+        // Entries from the last time around could otherwise pass for current ones
+        virtual_floor_invalidate_all_tiles();
+        _virtualFloorTileCacheGeneration = 1;
+    }
+}
+
 bool virtual_floor_is_enabled()
 {
     return (_virtualFloorFlags & VIRTUAL_FLOOR_FLAG_ENABLED) != 0;
@@ -52,6 +86,7 @@ void virtual_floor_set_height(int16_t height)
     {
         virtual_floor_invalidate();
         _virtualFloorHeight = height;
+        virtual_floor_next_generation();
     }
 }
 
@@ -62,6 +97,7 @@ static void virtual_floor_reset()
     _virtualFloorLastMaxPos.x = std::numeric_limits<int32_t>::lowest();
     _virtualFloorLastMaxPos.y = std::numeric_limits<int32_t>::lowest();
     _virtualFloorHeight = 0;
+    virtual_floor_next_generation();
 }
 
 void virtual_floor_enable()
@@ -71,6 +107,12 @@ void virtual_floor_enable()
         return;
     }
 
+    if (_virtualFloorTileCache == nullptr)
+    {
+        _virtualFloorTileCache = std::make_unique<std::atomic<uint32_t>[]>(
+            MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+    }
+
     virtual_floor_reset();
     _virtualFloorFlags |= VIRTUAL_FLOOR_FLAG_ENABLED;
 }
@@ -167,6 +209,30 @@ void virtual_floor_invalidate()
     }
 }
 
+void virtual_floor_invalidate_tile(const CoordsXY& loc)
+{
+    if (_virtualFloorTileCache == nullptr || !map_is_location_valid(loc))
+    {
+        return;
+    }
+
+    auto tilePos = TileCoordsXY(loc);
+    _virtualFloorTileCache[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x].store(0, std::memory_order_relaxed);
+}
+
+void virtual_floor_invalidate_all_tiles()
+{
+    if (_virtualFloorTileCache == nullptr)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL; i++)
+    {
+        _virtualFloorTileCache[i].store(0, std::memory_order_relaxed);
+    }
+}
+
 bool virtual_floor_tile_is_floor(const CoordsXY& loc)
 {
     if (!virtual_floor_is_enabled())
@@ -198,43 +264,11 @@ bool virtual_floor_tile_is_floor(const CoordsXY& loc)
     return false;
 }
 
-static void virtual_floor_get_tile_properties(
-    const CoordsXY& loc, int16_t height, bool* outOccupied, bool* tileOwned, uint8_t* outOccupiedEdges, bool* outBelowGround,
-    bool* aboveGround, bool* outLit)
+static uint32_t virtual_floor_compute_tile_flags(const CoordsXY& loc, int16_t height)
 {
-    *outOccupied = false;
-    *outOccupiedEdges = 0;
-    *outBelowGround = false;
-    *outLit = false;
-    *aboveGround = false;
-    *tileOwned = false;
-
-    // See if we are a selected tile
-    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
-    {
-        if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
-        {
-            *outLit = true;
-        }
-    }
-
-    // See if we are on top of the selection tiles
-    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
-    {
-        for (const auto& tile : gMapSelectionTiles)
-        {
-            if (tile == loc)
-            {
-                *outLit = true;
-                break;
-            }
-        }
-    }
-
-    *tileOwned = map_is_location_owned({ loc, height });
-
-    if (gCheatsSandboxMode)
-        *tileOwned = true;
+    uint32_t flags = 0;
+    if (map_is_location_owned({ loc, height }))
+        flags |= VIRTUAL_FLOOR_TILE_OWNED;
 
     // Iterate through the map elements of the current tile to find:
     //  * Surfaces, which may put us underground
@@ -242,7 +276,7 @@ static void virtual_floor_get_tile_properties(
     //  * Ghost objects, which are displayed as lit squares
     TileElement* tileElement = map_get_first_element_at(loc);
     if (tileElement == nullptr)
-        return;
+        return flags;
     do
     {
         int32_t elementType = tileElement->GetType();
@@ -251,16 +285,15 @@ static void virtual_floor_get_tile_properties(
         {
             if (height < tileElement->GetClearanceZ())
             {
-                *outBelowGround = true;
+                flags |= VIRTUAL_FLOOR_TILE_BELOW_GROUND;
             }
             else if (height < (tileElement->GetBaseZ() + LAND_HEIGHT_STEP) && tileElement->AsSurface()->GetSlope() != 0)
             {
-                *outBelowGround = true;
-                *outOccupied = true;
+                flags |= VIRTUAL_FLOOR_TILE_BELOW_GROUND | VIRTUAL_FLOOR_TILE_OCCUPIED;
             }
             if (height > tileElement->GetBaseZ())
             {
-                *aboveGround = true;
+                flags |= VIRTUAL_FLOOR_TILE_ABOVE_GROUND;
             }
             continue;
         }
@@ -273,18 +306,73 @@ static void virtual_floor_get_tile_properties(
         if (elementType == TILE_ELEMENT_TYPE_WALL || elementType == TILE_ELEMENT_TYPE_BANNER)
         {
             int32_t direction = tileElement->GetDirection();
-            *outOccupiedEdges |= 1 << direction;
+            flags |= 1 << direction;
             continue;
         }
 
         if (tileElement->IsGhost())
         {
-            *outLit = true;
+            flags |= VIRTUAL_FLOOR_TILE_GHOST;
             continue;
         }
 
-        *outOccupied = true;
+        flags |= VIRTUAL_FLOOR_TILE_OCCUPIED;
     } while (!(tileElement++)->IsLastForTile());
+    return flags;
+}
+
+static uint32_t virtual_floor_get_tile_flags(const CoordsXY& loc, int16_t height)
+{
+    if (_virtualFloorTileCache == nullptr || !map_is_location_valid(loc) || height != _virtualFloorHeight)
+    {
+        return virtual_floor_compute_tile_flags(loc, height);
+    }
+
+    auto tilePos = TileCoordsXY(loc);
+    auto& entry = _virtualFloorTileCache[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x];
+    uint32_t value = entry.load(std::memory_order_relaxed);
+    if ((value >> 16) != _virtualFloorTileCacheGeneration)
+    {
+        value = (_virtualFloorTileCacheGeneration << 16) | virtual_floor_compute_tile_flags(loc, height);
+        entry.store(value, std::memory_order_relaxed);
+    }
+    return value & VIRTUAL_FLOOR_TILE_PROPERTIES_MASK;
+}
+
+static void virtual_floor_get_tile_properties(
+    const CoordsXY& loc, int16_t height, bool* outOccupied, bool* tileOwned, uint8_t* outOccupiedEdges, bool* outBelowGround,
+    bool* aboveGround, bool* outLit)
+{
+    const uint32_t flags = virtual_floor_get_tile_flags(loc, height);
+    *outOccupied = (flags & VIRTUAL_FLOOR_TILE_OCCUPIED) != 0;
+    *outOccupiedEdges = flags & VIRTUAL_FLOOR_TILE_OCCUPIED_EDGES_MASK;
+    *outBelowGround = (flags & VIRTUAL_FLOOR_TILE_BELOW_GROUND) != 0;
+    *aboveGround = (flags & VIRTUAL_FLOOR_TILE_ABOVE_GROUND) != 0;
+    *outLit = (flags & VIRTUAL_FLOOR_TILE_GHOST) != 0;
+    *tileOwned = (flags & VIRTUAL_FLOOR_TILE_OWNED) != 0 || gCheatsSandboxMode;
+
+    // The selection moves without the tiles changing, so it is looked at every time
+    // See if we are a selected tile
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
+    {
+        if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
+        {
+            *outLit = true;
+        }
+    }
+
+    // See if we are on top of the selection tiles
+    if (!*outLit && (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT))
+    {
+        for (const auto& tile : gMapSelectionTiles)
+        {
+            if (tile == loc)
+            {
+                *outLit = true;
+                break;
+            }
+        }
+    }
 }
 
 void virtual_floor_paint(paint_session* session)
@@ -31,6 +31,12 @@ void virtual_floor_enable();
 void virtual_floor_disable();
 void virtual_floor_invalidate();
 
+/**
+ * Drops the cached virtual floor properties of a tile whose elements or ownership changed.
+ */
+void virtual_floor_invalidate_tile(const CoordsXY& loc);
+void virtual_floor_invalidate_all_tiles();
+
 bool virtual_floor_tile_is_floor(const CoordsXY& loc);
 
 void virtual_floor_paint(paint_session* session);
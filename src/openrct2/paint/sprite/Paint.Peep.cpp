@@ -15,6 +15,80 @@
 #include "../Paint.h"
 #include "Paint.Sprite.h"
 
+static void peep_get_animation_frame(const Peep* peep, PeepActionSpriteType& actionSpriteType, uint8_t& imageOffset)
+{
+    actionSpriteType = peep->ActionSpriteType;
+    imageOffset = peep->ActionSpriteImageOffset;
+
+    if (peep->Action == PeepActionType::None1)
+    {
+        actionSpriteType = peep->NextActionSpriteType;
+        imageOffset = 0;
+    }
+}
+
+static PeepSpriteImages peep_select_images(
+    const Peep* peep, PeepActionSpriteType actionSpriteType, uint8_t imageOffset, int32_t imageDirection)
+{
+    uint32_t baseImageId = (imageDirection >> 3) + GetPeepAnimation(peep->SpriteType, actionSpriteType).base_image
+        + imageOffset * 4;
+
+    PeepSpriteImages images{};
+    images.ImageId = baseImageId | peep->TshirtColour << 19 | peep->TrousersColour << 24 | IMAGE_TYPE_REMAP
+        | IMAGE_TYPE_REMAP_2_PLUS;
+
+    if (baseImageId >= 10717 && baseImageId < 10749)
+    {
+        images.AccessoryImageId = (baseImageId + 32) | peep->HatColour << 19 | IMAGE_TYPE_REMAP;
+    }
+    else if (baseImageId >= 10781 && baseImageId < 10813)
+    {
+        images.AccessoryImageId = (baseImageId + 32) | peep->BalloonColour << 19 | IMAGE_TYPE_REMAP;
+    }
+    else if (baseImageId >= 11197 && baseImageId < 11229)
+    {
+        images.AccessoryImageId = (baseImageId + 32) | peep->UmbrellaColour << 19 | IMAGE_TYPE_REMAP;
+    }
+    return images;
+}
+
+static bool peep_sprite_cache_matches(
+    const PeepSpriteCache& cache, const Peep* peep, PeepActionSpriteType actionSpriteType, uint8_t imageOffset)
+{
+    return cache.Valid && cache.SpriteType == peep->SpriteType && cache.ActionSpriteType == actionSpriteType
+        && cache.ImageOffset == imageOffset && cache.TshirtColour == peep->TshirtColour
+        && cache.TrousersColour == peep->TrousersColour && cache.HatColour == peep->HatColour
+        && cache.BalloonColour == peep->BalloonColour && cache.UmbrellaColour == peep->UmbrellaColour;
+}
+
+void peep_update_sprite_cache(Peep* peep)
+{
+    PeepActionSpriteType actionSpriteType;
+    uint8_t imageOffset;
+    peep_get_animation_frame(peep, actionSpriteType, imageOffset);
+
+    auto& cache = peep->SpriteCache;
+    if (peep_sprite_cache_matches(cache, peep, actionSpriteType, imageOffset))
+    {
+        return;
+    }
+
+    cache.SpriteType = peep->SpriteType;
+    cache.ActionSpriteType = actionSpriteType;
+    cache.ImageOffset = imageOffset;
+    cache.TshirtColour = peep->TshirtColour;
+    cache.TrousersColour = peep->TrousersColour;
+    cache.HatColour = peep->HatColour;
+    cache.BalloonColour = peep->BalloonColour;
+    cache.UmbrellaColour = peep->UmbrellaColour;
+    // Only the direction of the peep relative to the view picks between the images, not the rotation itself
+    for (int32_t direction = 0; direction < static_cast<int32_t>(cache.Images.size()); direction++)
+    {
+        cache.Images[direction] = peep_select_images(peep, actionSpriteType, imageOffset, direction << 3);
+    }
+    cache.Valid = true;
+}
+
 /**
  *
  *  rct2: 0x0068F0FB
@@ -67,41 +141,22 @@ void peep_paint(paint_session* session, const Peep* peep, int32_t imageDirection
         return;
     }
 
-    PeepActionSpriteType actionSpriteType = peep->ActionSpriteType;
-    uint8_t imageOffset = peep->ActionSpriteImageOffset;
+    PeepActionSpriteType actionSpriteType;
+    uint8_t imageOffset;
+    peep_get_animation_frame(peep, actionSpriteType, imageOffset);
 
-    if (peep->Action == PeepActionType::None1)
-    {
-        actionSpriteType = peep->NextActionSpriteType;
-        imageOffset = 0;
-    }
+    // The cache is filled by the peep's update, peeps changed since then are worked out here instead. Painting never
+    // writes to it, viewport columns are painted on several threads.
+    const auto images = peep_sprite_cache_matches(peep->SpriteCache, peep, actionSpriteType, imageOffset)
+        ? peep->SpriteCache.Images[imageDirection >> 3]
+        : peep_select_images(peep, actionSpriteType, imageOffset, imageDirection);
 
-    // In the following 4 calls to sub_98197C/sub_98199C, we add 5 (instead of 3) to the
+    // In the following 2 calls to sub_98197C/sub_98199C, we add 5 (instead of 3) to the
     //  bound_box_offset_z to make sure peeps are drawn on top of railways
-    uint32_t baseImageId = (imageDirection >> 3) + GetPeepAnimation(peep->SpriteType, actionSpriteType).base_image
-        + imageOffset * 4;
-    uint32_t imageId = baseImageId | peep->TshirtColour << 19 | peep->TrousersColour << 24 | IMAGE_TYPE_REMAP
-        | IMAGE_TYPE_REMAP_2_PLUS;
-    sub_98197C(session, imageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
+    sub_98197C(session, images.ImageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
 
-    if (baseImageId >= 10717 && baseImageId < 10749)
+    if (images.AccessoryImageId != 0)
     {
-        imageId = (baseImageId + 32) | peep->HatColour << 19 | IMAGE_TYPE_REMAP;
-        sub_98199C(session, imageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
-        return;
-    }
-
-    if (baseImageId >= 10781 && baseImageId < 10813)
-    {
-        imageId = (baseImageId + 32) | peep->BalloonColour << 19 | IMAGE_TYPE_REMAP;
-        sub_98199C(session, imageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
-        return;
-    }
-
-    if (baseImageId >= 11197 && baseImageId < 11229)
-    {
-        imageId = (baseImageId + 32) | peep->UmbrellaColour << 19 | IMAGE_TYPE_REMAP;
-        sub_98199C(session, imageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
-        return;
+        sub_98199C(session, images.AccessoryImageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
     }
 }
@@ -20,6 +20,7 @@ void sprite_paint_setup(paint_session* session, const uint16_t x, const uint16_t
 void misc_paint(paint_session* session, const SpriteBase* misc, int32_t imageDirection);
 void litter_paint(paint_session* session, const Litter* litter, int32_t imageDirection);
 void peep_paint(paint_session* session, const Peep* peep, int32_t imageDirection);
+void peep_update_sprite_cache(Peep* peep);
 
 extern const uint32_t vehicle_particle_base_sprites[5];
 
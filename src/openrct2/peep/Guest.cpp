@@ -13,6 +13,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -22,6 +23,7 @@
 #include "../rct2/RCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideLocationIndex.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -30,6 +32,7 @@
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/LargeScenery.h"
 #include "../world/Map.h"
 #include "../world/Park.h"
@@ -43,6 +46,23 @@
 #include <algorithm>
 #include <iterator>
 
+// Fewer guests are not worth handing to the worker threads.
+static constexpr size_t GUEST_PREPARE_RIDE_DECISIONS_MIN_GUESTS = 16;
+
+// The ride consideration of guests without a map, worked out on the worker threads for the guests due their 128 tick
+// update before any guest is updated. Indexed by sprite index, an entry is only used in the tick it was prepared in
+// and while the guest is still at the same position.
+struct PreparedRideConsideration
+{
+    uint32_t Tick;
+    uint32_t Generation;
+    int16_t X;
+    int16_t Y;
+    std::bitset<MAX_RIDES> Rides;
+};
+
+static std::vector<PreparedRideConsideration> _preparedRideConsiderations;
+
 // Locations of the spiral slide platform that a peep walks from the entrance of the ride to the
 // entrance of the slide. Up to 4 waypoints for each 4 sides that an ride entrance can be located
 // and 4 different rotations of the ride. 4 * 4 * 4 = 64 locations.
@@ -1912,6 +1932,23 @@ Ride* Guest::FindBestRideToGoOn()
     return mostExcitingRide;
 }
 
+/**
+ * The rides a guest without a map considers from the given position: those with track within 10 tiles and the rides
+ * that can be seen from anywhere.
+ */
+static std::bitset<MAX_RIDES> guest_find_nearby_rides(int32_t x, int32_t y, const std::bitset<MAX_RIDES>& visibleRides)
+{
+    constexpr auto radius = 10;
+    TileCoordsXY centre = { floor2(x, 32) / COORDS_XY_STEP, floor2(y, 32) / COORDS_XY_STEP };
+
+    std::bitset<MAX_RIDES> rides;
+    ride_location_index_get_rides({ centre.x - radius, centre.y - radius }, { centre.x + radius, centre.y + radius }, rides);
+
+    // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
+    rides |= visibleRides;
+    return rides;
+}
+
 std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
 {
     std::bitset<MAX_RIDES> rideConsideration;
@@ -1932,45 +1969,69 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     }
     else
     {
-        // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
+        // Take nearby rides into consideration, using the set prepared for this tick if the guest has not moved since.
+        if (sprite_index < _preparedRideConsiderations.size())
         {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
+            const auto& prepared = _preparedRideConsiderations[sprite_index];
+            if (prepared.Tick == gCurrentTicks && prepared.Generation == footpath_node_cache_generation() && prepared.X == x
+                && prepared.Y == y)
             {
-                if (map_is_location_valid({ tileX, tileY }))
-                {
-                    auto tileElement = map_get_first_element_at({ tileX, tileY });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                rideConsideration[rideIndex] = true;
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
-            }
-        }
-
-        // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
-            {
-                rideConsideration[ride.id] = true;
+                return prepared.Rides;
             }
         }
+        rideConsideration = guest_find_nearby_rides(x, y, ride_get_visible_from_anywhere());
     }
 
     return rideConsideration;
 }
 
+void guest_prepare_ride_decisions()
+{
+    if (!gConfigGeneral.multithreading)
+        return;
+
+    // Only the guests due their 128 tick update can pick a ride to go on, see peep_update_all.
+    std::vector<Guest*> guests;
+    uint16_t maxSpriteIndex = 0;
+    uint32_t i = 0;
+    for (auto peep : EntityList<Peep>(EntityListId::Peep))
+    {
+        if ((i++ & 0x7F) != (gCurrentTicks & 0x7F))
+            continue;
+
+        auto guest = peep->AsGuest();
+        if (guest == nullptr || guest->State != PeepState::Walking || guest->GuestHeadingToRideId != RIDE_ID_NULL
+            || (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK) || guest->HasFood() || guest->x == LOCATION_NULL
+            || (guest->ItemStandardFlags & PEEP_ITEM_MAP))
+            continue;
+
+        guests.push_back(guest);
+        maxSpriteIndex = std::max(maxSpriteIndex, guest->sprite_index);
+    }
+    if (guests.size() < GUEST_PREPARE_RIDE_DECISIONS_MIN_GUESTS)
+        return;
+
+    if (_preparedRideConsiderations.size() <= maxSpriteIndex)
+    {
+        _preparedRideConsiderations.resize(maxSpriteIndex + 1);
+    }
+
+    // Bring the shared state up to date first, the worker threads only read from it.
+    ride_location_index_update();
+    const auto visibleRides = ride_get_visible_from_anywhere();
+    auto generation = footpath_node_cache_generation();
+
+    TaskScheduler::GetGlobal().ParallelFor(0, guests.size(), 0, [&](size_t index) {
+        const auto* guest = guests[index];
+        auto& prepared = _preparedRideConsiderations[guest->sprite_index];
+        prepared.Tick = gCurrentTicks;
+        prepared.Generation = generation;
+        prepared.X = guest->x;
+        prepared.Y = guest->y;
+        prepared.Rides = guest_find_nearby_rides(guest->x, guest->y, visibleRides);
+    });
+}
+
 /**
  * This function is called whenever a peep is deciding whether or not they want
  * to go on a ride or visit a shop. They may be physically present at the
@@ -3037,15 +3098,8 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
         }
     }
 
-    for (auto litter : EntityList<Litter>(EntityListId::Litter))
-    {
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
-    }
+    ForEachEntityInRange<Litter>(
+        { centre_x - 160, centre_y - 160, centre_x + 160, centre_y + 160 }, [&num_rubbish](Litter*) { num_rubbish++; });
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -5704,6 +5758,7 @@ void Guest::UpdateEnteringPark()
     SetState(PeepState::Falling);
 
     OutsideOfPark = false;
+    park_update_guest_thought(this);
     ParkEntryTime = gScenarioTicks;
     increment_guests_in_park();
     decrement_guests_heading_for_park();
@@ -5734,6 +5789,7 @@ void Guest::UpdateLeavingPark()
     }
 
     OutsideOfPark = true;
+    park_update_guest_thought(this);
     DestinationTolerance = 5;
     decrement_guests_in_park();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
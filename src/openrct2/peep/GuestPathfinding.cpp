@@ -9,6 +9,8 @@
 
 #include "GuestPathfinding.h"
 
+#include "../Cheats.h"
+#include "../Game.h"
 #include "../core/Guard.hpp"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
@@ -17,10 +19,16 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathNodeCache.h"
 #include "Peep.h"
 #include "Staff.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstring>
+#include <unordered_map>
+#include <vector>
 
 static bool _peepPathFindIsStaff;
 static int8_t _peepPathFindNumJunctions;
@@ -41,6 +49,114 @@ utf8 gPathFindDebugPeepName[256];
 
 static int32_t guest_surface_path_finding(Peep* peep);
 
+struct PathfindRideTime
+{
+    uint32_t Calls;
+    int64_t Nanoseconds;
+};
+
+static struct
+{
+    uint32_t ResetTick;
+    uint32_t Tick;
+    PathfindCounters Current;
+    PathfindCounters LastTick;
+    uint32_t LastTickNumber;
+    PathfindCounters Total;
+    // Indexed by ride, the last entry is used for RIDE_ID_NULL.
+    std::array<PathfindRideTime, MAX_RIDES + 1> Rides;
+} _pathfindStats;
+
+static void pathfind_counters_add(PathfindCounters& counters, const PathfindCounters& other)
+{
+    counters.Calls += other.Calls;
+    counters.Searches += other.Searches;
+    counters.TilesChecked += other.TilesChecked;
+    counters.Junctions += other.Junctions;
+    counters.LimitReached += other.LimitReached;
+    counters.DistanceFieldHits += other.DistanceFieldHits;
+    counters.BudgetDeferred += other.BudgetDeferred;
+    counters.Nanoseconds += other.Nanoseconds;
+}
+
+// Moves the counters of a completed tick to LastTick, any tick without pathfinding is left out.
+static void pathfind_stats_roll_over()
+{
+    if (_pathfindStats.Tick == gCurrentTicks)
+        return;
+
+    pathfind_counters_add(_pathfindStats.Total, _pathfindStats.Current);
+    _pathfindStats.LastTick = _pathfindStats.Current;
+    _pathfindStats.LastTickNumber = _pathfindStats.Tick;
+    _pathfindStats.Current = {};
+    _pathfindStats.Tick = gCurrentTicks;
+}
+
+// The tiles searched in the current tick, for the opt-in limit of gCheatsPathfindingBudget tiles per tick. Unlike the
+// statistics above this is part of the simulation, so it only depends on the park and never on the clock.
+static struct
+{
+    uint32_t Tick;
+    uint32_t TilesChecked;
+} _pathfindBudget;
+
+static void pathfind_budget_roll_over()
+{
+    if (_pathfindBudget.Tick != gCurrentTicks)
+    {
+        _pathfindBudget.Tick = gCurrentTicks;
+        _pathfindBudget.TilesChecked = 0;
+    }
+}
+
+static bool pathfind_budget_is_exhausted()
+{
+    if (gCheatsPathfindingBudget == 0)
+        return false;
+
+    pathfind_budget_roll_over();
+    return _pathfindBudget.TilesChecked >= gCheatsPathfindingBudget;
+}
+
+/**
+ * Adds the time until it goes out of scope to the statistics of the ride being searched for. Timers started while
+ * another one is running are ignored, so every choice of direction is counted once.
+ */
+class PathfindStatsTimer
+{
+private:
+    static inline bool _running = false;
+    bool _outermost;
+    size_t _rideIndex;
+    std::chrono::steady_clock::time_point _startTime;
+
+public:
+    PathfindStatsTimer()
+        : _outermost(!_running)
+        , _rideIndex(std::min<size_t>(gPeepPathFindQueueRideIndex, MAX_RIDES))
+    {
+        if (_outermost)
+        {
+            _running = true;
+            pathfind_stats_roll_over();
+            _startTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PathfindStatsTimer()
+    {
+        if (!_outermost)
+            return;
+
+        _running = false;
+        auto elapsed = std::chrono::steady_clock::now() - _startTime;
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        _pathfindStats.Current.Nanoseconds += nanoseconds;
+        _pathfindStats.Rides[_rideIndex].Calls++;
+        _pathfindStats.Rides[_rideIndex].Nanoseconds += nanoseconds;
+    }
+};
+
 /* A junction history for the peep pathfinding heuristic search
  * The magic number 16 is the largest value returned by
  * peep_pathfind_get_max_number_junctions() which should eventually
@@ -93,19 +209,41 @@ static TileElement* get_banner_on_path(TileElement* path_element)
     return nullptr;
 }
 
+// The edges the banners on a path element allow, remembered for the rest of the tick as crowds of guests keep
+// asking for the same busy tiles. Direct mapped on the address of the element, a collision just means a rescan.
+struct PathBannerEdgesEntry
+{
+    const TileElement* Element;
+    uint32_t Generation;
+    uint32_t Tick;
+    uint8_t AllowedEdges;
+};
+static constexpr size_t PATH_BANNER_EDGES_CACHE_SIZE = 4096;
+static std::array<PathBannerEdgesEntry, PATH_BANNER_EDGES_CACHE_SIZE> _pathBannerEdgesCache;
+
+static uint8_t path_get_banner_allowed_edges(TileElement* pathElement)
+{
+    auto slot = (reinterpret_cast<uintptr_t>(pathElement) / sizeof(TileElement)) % PATH_BANNER_EDGES_CACHE_SIZE;
+    auto& entry = _pathBannerEdgesCache[slot];
+    auto generation = footpath_node_cache_generation();
+    if (entry.Element == pathElement && entry.Generation == generation && entry.Tick == gCurrentTicks)
+        return entry.AllowedEdges;
+
+    uint8_t allowedEdges = 0xFF;
+    for (auto* bannerElement = get_banner_on_path(pathElement); bannerElement != nullptr;
+         bannerElement = get_banner_on_path(bannerElement))
+    {
+        allowedEdges &= bannerElement->AsBanner()->GetAllowedEdges();
+    }
+    entry = { pathElement, generation, gCurrentTicks, allowedEdges };
+    return allowedEdges;
+}
+
 static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
 {
     if (_peepPathFindIsStaff)
         return edges;
-    TileElement* bannerElement = get_banner_on_path(reinterpret_cast<TileElement*>(pathElement));
-    if (bannerElement != nullptr)
-    {
-        do
-        {
-            edges &= bannerElement->AsBanner()->GetAllowedEdges();
-        } while ((bannerElement = get_banner_on_path(bannerElement)) != nullptr);
-    }
-    return edges;
+    return edges & path_get_banner_allowed_edges(reinterpret_cast<TileElement*>(pathElement));
 }
 
 /**
@@ -235,8 +373,6 @@ static int32_t guest_surface_path_finding(Peep* peep)
  */
 static uint8_t footpath_element_next_in_direction(TileCoordsXYZ loc, PathElement* pathElement, Direction chosenDirection)
 {
-    TileElement* nextTileElement;
-
     if (pathElement->IsSloped())
     {
         if (pathElement->GetSlopeDirection() == chosenDirection)
@@ -246,13 +382,8 @@ static uint8_t footpath_element_next_in_direction(TileCoordsXYZ loc, PathElement
     }
 
     loc += TileDirectionDelta[chosenDirection];
-    nextTileElement = map_get_first_element_at(loc.ToCoordsXY());
-    do
+    for (auto* nextTileElement : footpath_node_cache_get(TileCoordsXY{ loc.x, loc.y }))
     {
-        if (nextTileElement == nullptr)
-            break;
-        if (nextTileElement->IsGhost())
-            continue;
         if (nextTileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
             continue;
         if (!IsValidPathZAndDirection(nextTileElement, loc.z, chosenDirection))
@@ -264,7 +395,7 @@ static uint8_t footpath_element_next_in_direction(TileCoordsXYZ loc, PathElement
             return PATH_SEARCH_RIDE_QUEUE;
 
         return PATH_SEARCH_OTHER;
-    } while (!(nextTileElement++)->IsLastForTile());
+    }
 
     return PATH_SEARCH_FAILED;
 }
@@ -290,23 +421,17 @@ static uint8_t footpath_element_next_in_direction(TileCoordsXYZ loc, PathElement
 static uint8_t footpath_element_dest_in_dir(
     TileCoordsXYZ loc, Direction chosenDirection, ride_id_t* outRideIndex, int32_t level)
 {
-    TileElement* tileElement;
     Direction direction;
 
     if (level > 25)
+    {
+        _pathfindStats.Current.LimitReached++;
         return PATH_SEARCH_LIMIT_REACHED;
+    }
 
     loc += TileDirectionDelta[chosenDirection];
-    tileElement = map_get_first_element_at(loc.ToCoordsXY());
-    if (tileElement == nullptr)
-    {
-        return PATH_SEARCH_FAILED;
-    }
-    do
+    for (auto* tileElement : footpath_node_cache_get(TileCoordsXY{ loc.x, loc.y }))
     {
-        if (tileElement->IsGhost())
-            continue;
-
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_TRACK:
@@ -377,7 +502,7 @@ static uint8_t footpath_element_dest_in_dir(
                 }
                 return PATH_SEARCH_DEAD_END;
         }
-    } while (!(tileElement++)->IsLastForTile());
+    }
 
     return PATH_SEARCH_FAILED;
 }
@@ -662,6 +787,8 @@ static void peep_pathfind_heuristic_search(
 
     ++counter;
     _peepPathFindTilesChecked--;
+    _pathfindStats.Current.TilesChecked++;
+    _pathfindBudget.TilesChecked++;
 
     /* If this is where the search started this is a search loop and the
      * current search path ends here.
@@ -699,18 +826,11 @@ static void peep_pathfind_heuristic_search(
 
     /* Get the next map element of interest in the direction of test_edge. */
     bool found = false;
-    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
-    if (tileElement == nullptr)
-    {
-        return;
-    }
-    do
+    for (auto* tileElement : footpath_node_cache_get(TileCoordsXY{ loc.x, loc.y }))
     {
         /* Look for all map elements that the peep could walk onto while
-         * navigating to the goal, including the goal tile. */
-
-        if (tileElement->IsGhost())
-            continue;
+         * navigating to the goal, including the goal tile. Ghosts and
+         * elements of any other type are left out of the node list. */
 
         ride_id_t rideIndex = RIDE_ID_NULL;
         switch (tileElement->GetType())
@@ -984,6 +1104,7 @@ static void peep_pathfind_heuristic_search(
          * - max number of steps or max tiles checked. */
         if (counter >= 200 || _peepPathFindTilesChecked <= 0)
         {
+            _pathfindStats.Current.LimitReached++;
             /* The current search ends here.
              * The path continues, so the goal could still be reachable from here.
              * If the search result is better than the best so far (in the parameters),
@@ -1098,6 +1219,7 @@ static void peep_pathfind_heuristic_search(
                  * then update the parameters with this search before continuing to the next map element. */
                 if (_peepPathFindNumJunctions <= 0)
                 {
+                    _pathfindStats.Current.LimitReached++;
                     if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
                     {
                         // Update the search results
@@ -1193,8 +1315,7 @@ static void peep_pathfind_heuristic_search(
             }
 #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
         } while ((next_test_edge = bitscanforward(edges)) != -1);
-
-    } while (!(tileElement++)->IsLastForTile());
+    }
 
     if (!found)
     {
@@ -1227,6 +1348,10 @@ static void peep_pathfind_heuristic_search(
  */
 Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 {
+    PathfindStatsTimer statsTimer;
+    _pathfindStats.Current.Calls++;
+    pathfind_budget_roll_over();
+
     // The max number of thin junctions searched - a per-search-path limit.
     _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
 
@@ -1425,6 +1550,7 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
             }
 
             _peepPathFindFewestNumSteps = 255;
+            _pathfindStats.Current.Searches++;
             /* Divide the maxTilesChecked global search limit
              * between the remaining edges to ensure the search
              * covers all of the remaining edges. */
@@ -1598,6 +1724,331 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
     return chosen_edge;
 }
 
+/*
+ * Distance fields
+ *
+ * Guests heading for the park entrances or exits nearly always share a handful of goals, so instead of running the
+ * heuristic search for each of them a field holding the number of steps from every path to the goal is computed once
+ * and the direction of a guest becomes a lookup. The fields are built on a graph of all the footpaths on the map that
+ * is rebuilt, together with the fields, whenever the footpath node cache is invalidated.
+ */
+
+static constexpr size_t PATHFIND_DISTANCE_FIELD_CACHE_SIZE = 8;
+static constexpr uint16_t PATHFIND_DISTANCE_UNREACHABLE = 0xFFFF;
+
+struct PathfindNodeEdge
+{
+    uint32_t Node;
+    Direction Dir;
+};
+
+struct PathfindNode
+{
+    TileCoordsXYZ Location;
+    // False for wide paths and the entrances and shops paths lead to, the search never continues past them.
+    bool Walkable;
+    // The ride of a queue guests can only walk along when queuing for that ride, RIDE_ID_NULL for other paths.
+    ride_id_t QueueRide;
+    std::vector<PathfindNodeEdge> Edges;
+    std::vector<uint32_t> Previous;
+};
+
+struct PathfindDistanceField
+{
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRide;
+    uint32_t Generation;
+    uint32_t LastUsed;
+    std::vector<uint16_t> Distances;
+};
+
+static struct
+{
+    uint32_t Generation;
+    std::vector<PathfindNode> Nodes;
+    std::unordered_map<uint32_t, uint32_t> NodeIndex;
+} _pathfindGraph;
+
+static std::vector<PathfindDistanceField> _pathfindDistanceFields;
+static uint32_t _pathfindDistanceFieldClock;
+
+static uint32_t pathfind_graph_node_key(const TileCoordsXYZ& loc)
+{
+    return static_cast<uint32_t>(loc.x) | (static_cast<uint32_t>(loc.y) << 8) | (static_cast<uint32_t>(loc.z) << 16);
+}
+
+static uint32_t pathfind_graph_get_node(const TileCoordsXYZ& loc)
+{
+    auto it = _pathfindGraph.NodeIndex.find(pathfind_graph_node_key(loc));
+    return it != _pathfindGraph.NodeIndex.end() ? it->second : UINT32_MAX;
+}
+
+static uint32_t pathfind_graph_add_node(const TileCoordsXYZ& loc, bool walkable, ride_id_t queueRide)
+{
+    auto nextIndex = static_cast<uint32_t>(_pathfindGraph.Nodes.size());
+    auto result = _pathfindGraph.NodeIndex.emplace(pathfind_graph_node_key(loc), nextIndex);
+    if (result.second)
+    {
+        _pathfindGraph.Nodes.push_back({ loc, walkable, queueRide, {}, {} });
+    }
+    return result.first->second;
+}
+
+/**
+ * Whether the heuristic search would end at the given element when stepping onto it in a direction, returning the
+ * location of the node the element belongs to.
+ */
+static bool pathfind_graph_get_edge_target(
+    TileElement* tileElement, const TileCoordsXY& tilePos, int32_t z, Direction direction, TileCoordsXYZ& target)
+{
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_PATH:
+            if (!IsValidPathZAndDirection(tileElement, z, direction))
+                return false;
+            target = { tilePos.x, tilePos.y, tileElement->base_height };
+            return true;
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            if (tileElement->base_height != z)
+                return false;
+            if (tileElement->AsEntrance()->GetEntranceType() != ENTRANCE_TYPE_PARK_ENTRANCE
+                && tileElement->GetDirection() != direction)
+                return false;
+            target = { tilePos.x, tilePos.y, z };
+            return true;
+        case TILE_ELEMENT_TYPE_TRACK:
+        {
+            if (tileElement->base_height != z)
+                return false;
+            auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+            if (ride == nullptr || !ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                return false;
+            target = { tilePos.x, tilePos.y, z };
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static void pathfind_graph_build()
+{
+    _pathfindGraph.Nodes.clear();
+    _pathfindGraph.NodeIndex.clear();
+
+    // Permitted edges depend on whether no entry banners are obeyed, distance fields are only used for guests.
+    bool wasStaff = _peepPathFindIsStaff;
+    _peepPathFindIsStaff = false;
+
+    // Add a node for every height with a path on it, the first path element decides its properties in the same way
+    // as in peep_pathfind_choose_direction.
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            for (auto* tileElement : footpath_node_cache_get({ x, y }))
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+                    continue;
+
+                auto* pathElement = tileElement->AsPath();
+                ride_id_t queueRide = RIDE_ID_NULL;
+                if (pathElement->IsQueue() && bitcount(pathElement->GetEdges()) == 2)
+                {
+                    queueRide = pathElement->GetRideIndex();
+                }
+                pathfind_graph_add_node({ x, y, tileElement->base_height }, !pathElement->IsWide(), queueRide);
+            }
+        }
+    }
+
+    // Connect the paths, adding the entrances and shops they lead to on the way.
+    size_t numPathNodes = _pathfindGraph.Nodes.size();
+    for (size_t i = 0; i < numPathNodes; i++)
+    {
+        auto loc = _pathfindGraph.Nodes[i].Location;
+        TileElement* firstPath = nullptr;
+        uint8_t permittedEdges = 0;
+        for (auto* tileElement : footpath_node_cache_get(loc))
+        {
+            if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->base_height != loc.z)
+                continue;
+            if (firstPath == nullptr)
+                firstPath = tileElement;
+            permittedEdges |= path_get_permitted_edges(tileElement->AsPath());
+        }
+
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            if (!(permittedEdges & (1 << direction)))
+                continue;
+
+            int32_t z = loc.z;
+            if (firstPath->AsPath()->IsSloped() && firstPath->AsPath()->GetSlopeDirection() == direction)
+                z += 2;
+
+            auto nextTile = TileCoordsXY{ loc.x, loc.y } + TileDirectionDelta[direction];
+            for (auto* tileElement : footpath_node_cache_get(nextTile))
+            {
+                TileCoordsXYZ target;
+                if (!pathfind_graph_get_edge_target(tileElement, nextTile, z, direction, target))
+                    continue;
+
+                auto targetNode = pathfind_graph_get_node(target);
+                if (targetNode == UINT32_MAX)
+                    targetNode = pathfind_graph_add_node(target, false, RIDE_ID_NULL);
+
+                auto& edges = _pathfindGraph.Nodes[i].Edges;
+                if (std::none_of(edges.begin(), edges.end(), [targetNode](const PathfindNodeEdge& edge) {
+                        return edge.Node == targetNode;
+                    }))
+                {
+                    edges.push_back({ targetNode, direction });
+                    _pathfindGraph.Nodes[targetNode].Previous.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    _peepPathFindIsStaff = wasStaff;
+}
+
+static bool pathfind_node_is_passable(const PathfindNode& node, ride_id_t queueRide)
+{
+    return node.Walkable && (node.QueueRide == RIDE_ID_NULL || node.QueueRide == queueRide);
+}
+
+/**
+ * Breadth first search from the goal along the reversed edges, only continuing over paths the heuristic search would
+ * continue over for a guest.
+ */
+static void pathfind_distance_field_compute(PathfindDistanceField& field)
+{
+    const auto& nodes = _pathfindGraph.Nodes;
+    field.Distances.assign(nodes.size(), PATHFIND_DISTANCE_UNREACHABLE);
+    field.Generation = _pathfindGraph.Generation;
+
+    auto goalNode = pathfind_graph_get_node(field.Goal);
+    if (goalNode == UINT32_MAX)
+        return;
+
+    std::vector<uint32_t> queue;
+    queue.push_back(goalNode);
+    field.Distances[goalNode] = 0;
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        auto current = queue[head];
+        auto distance = field.Distances[current];
+        if (distance + 1 >= PATHFIND_DISTANCE_UNREACHABLE)
+            break;
+
+        for (auto previous : nodes[current].Previous)
+        {
+            if (field.Distances[previous] != PATHFIND_DISTANCE_UNREACHABLE)
+                continue;
+            if (!pathfind_node_is_passable(nodes[previous], field.QueueRide))
+                continue;
+
+            field.Distances[previous] = distance + 1;
+            queue.push_back(previous);
+        }
+    }
+}
+
+static const PathfindDistanceField& pathfind_distance_field_get(const TileCoordsXYZ& goal, ride_id_t queueRide)
+{
+    auto generation = footpath_node_cache_generation();
+    if (_pathfindGraph.Generation != generation)
+    {
+        _pathfindGraph.Generation = generation;
+        pathfind_graph_build();
+    }
+
+    PathfindDistanceField* field = nullptr;
+    for (auto& cachedField : _pathfindDistanceFields)
+    {
+        if (cachedField.Goal == goal && cachedField.QueueRide == queueRide)
+        {
+            field = &cachedField;
+            break;
+        }
+    }
+    if (field == nullptr)
+    {
+        if (_pathfindDistanceFields.size() < PATHFIND_DISTANCE_FIELD_CACHE_SIZE)
+        {
+            field = &_pathfindDistanceFields.emplace_back();
+        }
+        else
+        {
+            field = &*std::min_element(
+                _pathfindDistanceFields.begin(), _pathfindDistanceFields.end(),
+                [](const PathfindDistanceField& a, const PathfindDistanceField& b) { return a.LastUsed < b.LastUsed; });
+        }
+        field->Goal = goal;
+        field->QueueRide = queueRide;
+        field->Distances.clear();
+    }
+    if (field->Generation != _pathfindGraph.Generation || field->Distances.size() != _pathfindGraph.Nodes.size())
+    {
+        pathfind_distance_field_compute(*field);
+    }
+    field->LastUsed = ++_pathfindDistanceFieldClock;
+    return *field;
+}
+
+/**
+ * Chooses the direction out of the given edges with the fewest steps to gPeepPathFindGoalPosition.
+ *
+ * Returns INVALID_DIRECTION when the goal cannot be reached along the given edges, in which case the heuristic search
+ * should be used instead.
+ */
+static Direction pathfind_distance_field_choose_direction(const TileCoordsXYZ& loc, uint8_t edges)
+{
+    const auto& field = pathfind_distance_field_get(gPeepPathFindGoalPosition, gPeepPathFindQueueRideIndex);
+
+    auto node = pathfind_graph_get_node(loc);
+    if (node == UINT32_MAX)
+        return INVALID_DIRECTION;
+
+    Direction chosenDirection = INVALID_DIRECTION;
+    uint16_t bestDistance = PATHFIND_DISTANCE_UNREACHABLE;
+    for (const auto& edge : _pathfindGraph.Nodes[node].Edges)
+    {
+        if (!(edges & (1 << edge.Dir)))
+            continue;
+
+        auto distance = field.Distances[edge.Node];
+        // Edges are stored in direction order, so ties go to the lowest direction.
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            chosenDirection = edge.Dir;
+        }
+    }
+    return chosenDirection;
+}
+
+/**
+ * Chooses the direction a guest heading for a park entrance or exit should walk in, using the shared distance field
+ * of the goal when it can be reached from here.
+ */
+static Direction guest_pathfind_choose_direction(Peep* peep, uint8_t edges)
+{
+    TileCoordsXYZ loc{ peep->NextLoc };
+    PathfindStatsTimer statsTimer;
+    Direction direction = pathfind_distance_field_choose_direction(loc, edges);
+    if (direction == INVALID_DIRECTION)
+    {
+        direction = peep_pathfind_choose_direction(loc, peep);
+    }
+    else
+    {
+        _pathfindStats.Current.DistanceFieldHits++;
+    }
+    return direction;
+}
+
 /**
  * Gets the nearest park entrance relative to point, by using Manhattan distance.
  * @param x x coordinate of location
@@ -1639,7 +2090,7 @@ static int32_t guest_path_find_entering_park(Peep* peep, uint8_t edges)
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
 
-    Direction chosenDirection = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep, edges);
 
     if (chosenDirection == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
@@ -1695,7 +2146,7 @@ static int32_t guest_path_find_leaving_park(Peep* peep, uint8_t edges)
 
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
-    direction = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    direction = guest_pathfind_choose_direction(peep, edges);
     if (direction == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
     else
@@ -1748,7 +2199,7 @@ static int32_t guest_path_find_park_entrance(Peep* peep, uint8_t edges)
     PathfindLoggingEnable(peep);
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-    Direction chosenDirection = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep, edges);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     PathfindLoggingDisable();
@@ -2202,6 +2653,18 @@ int32_t guest_path_finding(Guest* peep)
 
     get_ride_queue_end(loc);
 
+    if (pathfind_budget_is_exhausted())
+    {
+        // Keep going the same way if possible, the search is done again at the next junction in a later tick.
+        pathfind_stats_roll_over();
+        _pathfindStats.Current.BudgetDeferred++;
+        if (edges & (1 << peep->PeepDirection))
+        {
+            return peep_move_one_tile(peep->PeepDirection, peep);
+        }
+        return guest_path_find_aimless(peep, edges);
+    }
+
     gPeepPathFindGoalPosition = loc;
     gPeepPathFindIgnoreForeignQueues = true;
 
@@ -2314,3 +2777,39 @@ void PathfindLoggingDisable()
 #    endif // defined(PATHFIND_DEBUG) && PATHFIND_DEBUG
 }
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+PathfindStats pathfind_stats_get()
+{
+    pathfind_stats_roll_over();
+
+    PathfindStats stats{};
+    if (_pathfindStats.LastTickNumber == gCurrentTicks - 1)
+    {
+        stats.LastTick = _pathfindStats.LastTick;
+    }
+    stats.Tick = gCurrentTicks - 1;
+    stats.Ticks = gCurrentTicks - _pathfindStats.ResetTick;
+    stats.Total = _pathfindStats.Total;
+    pathfind_counters_add(stats.Total, _pathfindStats.Current);
+
+    for (size_t i = 0; i < _pathfindStats.Rides.size(); i++)
+    {
+        const auto& rideTime = _pathfindStats.Rides[i];
+        if (rideTime.Calls == 0)
+            continue;
+
+        auto rideIndex = i < MAX_RIDES ? static_cast<ride_id_t>(i) : RIDE_ID_NULL;
+        stats.Rides.push_back({ rideIndex, rideTime.Calls, rideTime.Nanoseconds });
+    }
+    std::sort(stats.Rides.begin(), stats.Rides.end(), [](const PathfindRideStats& a, const PathfindRideStats& b) {
+        return a.Nanoseconds > b.Nanoseconds;
+    });
+    return stats;
+}
+
+void pathfind_stats_reset()
+{
+    _pathfindStats = {};
+    _pathfindStats.ResetTick = gCurrentTicks;
+    _pathfindStats.Tick = gCurrentTicks;
+}
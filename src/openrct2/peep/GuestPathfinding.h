@@ -13,6 +13,8 @@
 #include "../ride/RideTypes.h"
 #include "../world/Location.hpp"
 
+#include <vector>
+
 struct Peep;
 struct Guest;
 struct TileElement;
@@ -51,6 +53,41 @@ bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_
 // Returns 0 if the guest has successfully had a new destination set up, nonzero otherwise.
 int32_t guest_path_finding(Guest* peep);
 
+// Counters of the work done by the pathfinding, always collected so expensive layouts can be found in release builds.
+struct PathfindCounters
+{
+    uint32_t Calls;             // Calls to peep_pathfind_choose_direction
+    uint32_t Searches;          // Heuristic searches started, one for each edge tried
+    uint32_t TilesChecked;      // Tiles visited by the heuristic searches
+    uint32_t Junctions;         // Thin junctions the heuristic searches went through
+    uint32_t LimitReached;      // Search paths cut off by the step, tile or junction limits
+    uint32_t DistanceFieldHits; // Directions taken from a shared distance field without searching
+    uint32_t BudgetDeferred;    // Searches put off to a later junction as the pathfinding budget of the tick ran out
+    int64_t Nanoseconds;        // Time spent in peep_pathfind_choose_direction and the distance fields
+};
+
+// Time spent finding the way to a ride. Searches for park entrances, exits and by staff have the ride RIDE_ID_NULL.
+struct PathfindRideStats
+{
+    ride_id_t Ride;
+    uint32_t Calls;
+    int64_t Nanoseconds;
+};
+
+struct PathfindStats
+{
+    // The counters of the last completed tick and the tick they were counted in.
+    uint32_t Tick;
+    PathfindCounters LastTick;
+    // The counters and the number of ticks since the statistics were reset, rides ordered by time spent.
+    uint32_t Ticks;
+    PathfindCounters Total;
+    std::vector<PathfindRideStats> Rides;
+};
+
+PathfindStats pathfind_stats_get();
+void pathfind_stats_reset();
+
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 #    define PATHFIND_DEBUG                                                                                                     \
         0 // Set to 0 to disable pathfinding debugging;
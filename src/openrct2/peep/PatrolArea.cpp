@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PatrolArea.h"
+
+#include "../util/Util.h"
+
+#include <algorithm>
+
+void PatrolArea::Set(const CoordsXY& coords, bool value)
+{
+    auto quad = GetQuad(coords);
+    auto& word = _words[quad.y * 2 + (quad.x >> 5)];
+    auto mask = 1u << (quad.x & 31);
+    if (value)
+    {
+        word |= mask;
+    }
+    else
+    {
+        word &= ~mask;
+    }
+}
+
+void PatrolArea::Toggle(const CoordsXY& coords)
+{
+    auto quad = GetQuad(coords);
+    _words[quad.y * 2 + (quad.x >> 5)] ^= 1u << (quad.x & 31);
+}
+
+void PatrolArea::Clear()
+{
+    std::fill_n(_words, PATROL_AREA_WORDS, 0);
+}
+
+bool PatrolArea::IsEmpty() const
+{
+    return std::all_of(_words, _words + PATROL_AREA_WORDS, [](uint32_t word) { return word == 0; });
+}
+
+int32_t PatrolArea::CountQuads() const
+{
+    int32_t count = 0;
+    for (int32_t i = 0; i < PATROL_AREA_WORDS; i++)
+    {
+        count += bitcount(_words[i]);
+    }
+    return count;
+}
+
+void PatrolArea::Union(const PatrolArea& other)
+{
+    for (int32_t i = 0; i < PATROL_AREA_WORDS; i++)
+    {
+        _words[i] |= other._words[i];
+    }
+}
+
+bool PatrolArea::IsQuadInterior(int32_t quadX, int32_t quadY) const
+{
+    // Rotate the three quads around quadX into the lowest bits of each row, wrapping like the lookups do at the
+    // edges of the map.
+    auto shift = (quadX - 1) & 63;
+    uint64_t neighbourhood = ~static_cast<uint64_t>(0);
+    for (int32_t dy = -1; dy <= 1; dy++)
+    {
+        auto row = GetRow(quadY + dy);
+        neighbourhood &= (row >> shift) | (row << ((64 - shift) & 63));
+    }
+    return (neighbourhood & 7) == 7;
+}
+
+bool PatrolArea::GetBounds(MapRange& bounds) const
+{
+    int32_t minY = -1;
+    int32_t maxY = -1;
+    uint64_t columns = 0;
+    for (int32_t quadY = 0; quadY < PATROL_AREA_QUADS_PER_AXIS; quadY++)
+    {
+        auto row = GetRow(quadY);
+        if (row != 0)
+        {
+            if (minY == -1)
+                minY = quadY;
+            maxY = quadY;
+            columns |= row;
+        }
+    }
+    if (minY == -1)
+        return false;
+
+    int32_t minX = 0;
+    while (!((columns >> minX) & 1))
+        minX++;
+    int32_t maxX = PATROL_AREA_QUADS_PER_AXIS - 1;
+    while (!((columns >> maxX) & 1))
+        maxX--;
+
+    bounds = MapRange(
+        minX * PATROL_AREA_QUAD_SIZE, minY * PATROL_AREA_QUAD_SIZE, (maxX + 1) * PATROL_AREA_QUAD_SIZE - COORDS_XY_STEP,
+        (maxY + 1) * PATROL_AREA_QUAD_SIZE - COORDS_XY_STEP);
+    return true;
+}
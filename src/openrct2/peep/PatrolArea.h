@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+// Patrol areas are made up of quads of 4x4 tiles, 64 quads along each axis of the map.
+constexpr int32_t PATROL_AREA_QUAD_SIZE = 4 * COORDS_XY_STEP;
+constexpr int32_t PATROL_AREA_QUADS_PER_AXIS = 64;
+// Every quad is a bit in the words of an area; each row of quads takes two 32-bit words, like in RCT2.
+constexpr int32_t PATROL_AREA_WORDS = PATROL_AREA_QUADS_PER_AXIS * 2;
+
+/**
+ * A view of the bits of one patrol area, as stored in gStaffPatrolAreas. The operations work on whole words or
+ * rows of quads at a time, so checking or combining the areas of many staff members stays cheap.
+ */
+class PatrolArea
+{
+private:
+    uint32_t* _words;
+
+public:
+    explicit PatrolArea(uint32_t* words)
+        : _words(words)
+    {
+    }
+
+    static TileCoordsXY GetQuad(const CoordsXY& coords)
+    {
+        return { (coords.x & 0x1F80) >> 7, (coords.y & 0x1F80) >> 7 };
+    }
+
+    bool IsQuadSet(int32_t quadX, int32_t quadY) const
+    {
+        return (GetRow(quadY) >> (quadX & 63)) & 1;
+    }
+    bool Get(const CoordsXY& coords) const
+    {
+        auto quad = GetQuad(coords);
+        return IsQuadSet(quad.x, quad.y);
+    }
+    void Set(const CoordsXY& coords, bool value);
+    void Toggle(const CoordsXY& coords);
+
+    // The quads of a row as a 64-bit mask, bit n being the quad n along the x axis.
+    uint64_t GetRow(int32_t quadY) const
+    {
+        auto index = (quadY & 63) * 2;
+        return _words[index] | (static_cast<uint64_t>(_words[index + 1]) << 32);
+    }
+
+    void Clear();
+    bool IsEmpty() const;
+    int32_t CountQuads() const;
+    void Union(const PatrolArea& other);
+
+    /**
+     * Whether the quad and all of the eight quads around it are set, in which case every tile next to a tile in the
+     * quad is inside the area too.
+     */
+    bool IsQuadInterior(int32_t quadX, int32_t quadY) const;
+
+    /**
+     * Gets the map range covered by the set quads, returns false if the area is empty.
+     */
+    bool GetBounds(MapRange& bounds) const;
+};
@@ -25,6 +25,7 @@
 #include "../management/Marketing.h"
 #include "../management/NewsItem.h"
 #include "../network/network.h"
+#include "../paint/sprite/Paint.Sprite.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/ShopItem.h"
@@ -387,10 +388,11 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    guest_prepare_ride_decisions();
+
     int32_t i = 0;
     // Warning this loop can delete peeps
-    for (auto peep : EntityList<Peep>(EntityListId::Peep))
-    {
+    ForEachEntityInList<Peep>(EntityListId::Peep, [&i](Peep* peep) {
         if (static_cast<uint32_t>(i & 0x7F) != (gCurrentTicks & 0x7F))
         {
             peep->Update();
@@ -405,7 +407,7 @@ void peep_update_all()
         }
 
         i++;
-    }
+    });
 }
 
 /**
@@ -829,6 +831,37 @@ void peep_sprite_remove(Peep* peep)
     context_broadcast_intent(&intent);
 }
 
+/**
+ * Removes many guests at once, as Peep::Remove would, but without taking them off their rides and queues. Only meant
+ * for when the rides no longer refer to the guests, like the remove all guests cheat does. The guest list and the
+ * guest count are refreshed once.
+ */
+void peep_remove_guests_bulk(const std::vector<Guest*>& guests)
+{
+    std::vector<SpriteBase*> entities;
+    entities.reserve(guests.size());
+    for (auto* guest : guests)
+    {
+        if (!guest->OutsideOfPark)
+        {
+            decrement_guests_in_park();
+        }
+        if (guest->State == PeepState::EnteringPark)
+        {
+            decrement_guests_heading_for_park();
+        }
+        window_close_by_number(WC_PEEP, guest->sprite_index);
+        News::DisableNewsItems(News::ItemType::PeepOnRide, guest->sprite_index);
+        entities.push_back(guest);
+    }
+    sprite_remove_bulk(entities);
+
+    auto countIntent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
+    context_broadcast_intent(&countIntent);
+    auto listIntent = Intent(INTENT_ACTION_REFRESH_GUEST_LIST);
+    context_broadcast_intent(&listIntent);
+}
+
 /**
  * New function removes peep from park existence. Works with staff.
  */
@@ -1073,6 +1106,7 @@ static void peep_update_thoughts(Peep* peep)
         peep->Thoughts[fresh_thought].freshness = 1;
         peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
     }
+    park_update_guest_thought(peep);
 }
 
 /**
@@ -1153,6 +1187,11 @@ void Peep::Update()
             }
         }
     }
+
+    if (!gOpenRCT2Headless)
+    {
+        peep_update_sprite_cache(this);
+    }
 }
 
 /**
@@ -1569,6 +1608,7 @@ void Peep::InsertNewThought(PeepThoughtType thoughtType, uint8_t thoughtArgument
     Thoughts[0].fresh_timeout = 0;
 
     WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+    park_update_guest_thought(this);
 }
 
 /**
@@ -1608,6 +1648,7 @@ Peep* Peep::Generate(const CoordsXYZ& coords)
     peep->PreviousRide = RIDE_ID_NULL;
     peep->Thoughts->type = PEEP_THOUGHT_TYPE_NONE;
     peep->WindowInvalidateFlags = 0;
+    park_update_guest_thought(peep);
 
     uint8_t intensityHighest = (scenario_rand() & 0x7) + 3;
     uint8_t intensityLowest = std::min(intensityHighest, static_cast<uint8_t>(7)) - 3;
@@ -2634,30 +2675,33 @@ static void peep_footpath_move_forward(Peep* peep, const CoordsXYE& coords, bool
     uint16_t crowded = 0;
     uint8_t litter_count = 0;
     uint8_t sick_count = 0;
-    auto quad = EntityTileList(coords);
-    for (auto entity : quad)
+    // Nothing on the tile can add to the counts unless it is busy enough to be crowded or there is litter.
+    if (GetPeepCountAtTile(coords) >= 10 || GetLitterCountAtTile(coords) != 0)
     {
-        if (auto other_peep = entity->As<Peep>(); other_peep != nullptr)
+        for (auto entity : EntityTileList(coords))
         {
-            if (other_peep->State != PeepState::Walking)
-                continue;
+            if (auto other_peep = entity->As<Peep>(); other_peep != nullptr)
+            {
+                if (other_peep->State != PeepState::Walking)
+                    continue;
 
-            if (abs(other_peep->z - peep->NextLoc.z) > 16)
-                continue;
-            crowded++;
-            continue;
-        }
-        else if (auto litter = entity->As<Litter>(); litter != nullptr)
-        {
-            if (abs(litter->z - peep->NextLoc.z) > 16)
+                if (abs(other_peep->z - peep->NextLoc.z) > 16)
+                    continue;
+                crowded++;
                 continue;
+            }
+            else if (auto litter = entity->As<Litter>(); litter != nullptr)
+            {
+                if (abs(litter->z - peep->NextLoc.z) > 16)
+                    continue;
 
-            litter_count++;
-            if (litter->type != LITTER_TYPE_SICK && litter->type != LITTER_TYPE_SICK_ALT)
-                continue;
+                litter_count++;
+                if (litter->type != LITTER_TYPE_SICK && litter->type != LITTER_TYPE_SICK_ALT)
+                    continue;
 
-            litter_count--;
-            sick_count++;
+                litter_count--;
+                sick_count++;
+            }
         }
     }
 
@@ -3151,10 +3195,38 @@ rct_string_id get_real_name_string_id_from_id(uint32_t id)
     return dx;
 }
 
-int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_b)
+namespace
+{
+    struct PeepSortKey
+    {
+        const Peep* Character;
+        // Formatted the first time a comparison needs it, so each name is only formatted once per sort
+        mutable std::optional<std::string> Name;
+
+        explicit PeepSortKey(const Peep* peep)
+            : Character(peep)
+        {
+        }
+
+        const std::string& GetName() const
+        {
+            if (!Name)
+            {
+                char name[256]{};
+                Formatter ft;
+                Character->FormatNameTo(ft);
+                format_string(name, sizeof(name), STR_STRINGID, ft.Data());
+                Name = name;
+            }
+            return *Name;
+        }
+    };
+} // namespace
+
+static int32_t peep_compare(const PeepSortKey& a, const PeepSortKey& b)
 {
-    Peep const* peep_a = GetEntity<Peep>(sprite_index_a);
-    Peep const* peep_b = GetEntity<Peep>(sprite_index_b);
+    Peep const* peep_a = a.Character;
+    Peep const* peep_b = b.Character;
     if (peep_a == nullptr || peep_b == nullptr)
     {
         return 0;
@@ -3180,16 +3252,29 @@ int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_
     }
 
     // Compare their names as strings
-    char nameA[256]{};
-    Formatter ft;
-    peep_a->FormatNameTo(ft);
-    format_string(nameA, sizeof(nameA), STR_STRINGID, ft.Data());
-
-    char nameB[256]{};
-    ft.Rewind();
-    peep_b->FormatNameTo(ft);
-    format_string(nameB, sizeof(nameB), STR_STRINGID, ft.Data());
-    return strlogicalcmp(nameA, nameB);
+    return strlogicalcmp(a.GetName().c_str(), b.GetName().c_str());
+}
+
+int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_b)
+{
+    return peep_compare(PeepSortKey(GetEntity<Peep>(sprite_index_a)), PeepSortKey(GetEntity<Peep>(sprite_index_b)));
+}
+
+void peep_sort(std::vector<uint16_t>& spriteIndices)
+{
+    std::vector<std::pair<uint16_t, PeepSortKey>> keys;
+    keys.reserve(spriteIndices.size());
+    for (auto spriteIndex : spriteIndices)
+    {
+        keys.emplace_back(spriteIndex, PeepSortKey(GetEntity<Peep>(spriteIndex)));
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return peep_compare(a.second, b.second) < 0; });
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        spriteIndices[i] = keys[i].first;
+    }
 }
 
 /**
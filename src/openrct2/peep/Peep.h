@@ -21,8 +21,10 @@
 #include "../world/SpriteBase.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <optional>
+#include <vector>
 
 #define PEEP_MAX_THOUGHTS 5
 #define PEEP_THOUGHT_ITEM_NONE 255
@@ -611,6 +613,32 @@ public:
     }
 };
 
+// The images a peep is painted with when facing one of the four directions of the view
+struct PeepSpriteImages
+{
+    uint32_t ImageId;
+    // 0 when the peep has no hat, balloon or umbrella in its current animation
+    uint32_t AccessoryImageId;
+};
+
+/**
+ * The images of a peep for each direction of the view, worked out when its animation frame or colours change rather
+ * than each time it is painted. They are only used while the state they were worked out from still matches the peep.
+ */
+struct PeepSpriteCache
+{
+    PeepSpriteType SpriteType;
+    PeepActionSpriteType ActionSpriteType;
+    uint8_t ImageOffset;
+    uint8_t TshirtColour;
+    uint8_t TrousersColour;
+    uint8_t HatColour;
+    uint8_t BalloonColour;
+    uint8_t UmbrellaColour;
+    bool Valid;
+    std::array<PeepSpriteImages, 4> Images;
+};
+
 struct Peep : SpriteBase
 {
     char* Name;
@@ -782,6 +810,8 @@ struct Peep : SpriteBase
     ride_id_t FavouriteRide;
     uint8_t FavouriteRideRating;
     uint32_t ItemStandardFlags;
+    // Only used for painting, not part of the game state
+    PeepSpriteCache SpriteCache;
 
 public: // Peep
     Guest* AsGuest();
@@ -1069,6 +1099,7 @@ Peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
 bool peep_can_be_picked_up(Peep* peep);
 void peep_update_all();
+void guest_prepare_ride_decisions();
 void peep_problem_warnings_update();
 void peep_stop_crowd_noise();
 void peep_update_crowd_noise();
@@ -1078,12 +1109,15 @@ void peep_thought_set_format_args(const rct_peep_thought* thought, Formatter& ft
 int32_t get_peep_face_sprite_small(Peep* peep);
 int32_t get_peep_face_sprite_large(Peep* peep);
 void peep_sprite_remove(Peep* peep);
+void peep_remove_guests_bulk(const std::vector<Guest*>& guests);
 
 void peep_window_state_update(Peep* peep);
 void peep_decrement_num_riders(Peep* peep);
 
 void peep_set_map_tooltip(Peep* peep);
 int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_b);
+// Sorts the peeps like peep_compare but formats each name at most once
+void peep_sort(std::vector<uint16_t>& spriteIndices);
 
 void peep_update_names(bool realNames);
 
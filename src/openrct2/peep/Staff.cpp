@@ -74,6 +74,7 @@ const rct_string_id StaffCostumeNames[] = {
 // Every staff member has STAFF_PATROL_AREA_SIZE elements assigned to in this array, indexed by their StaffId
 // Additionally there is a patrol area for each staff type, which is the union of the patrols of all staff members of that type
 uint32_t gStaffPatrolAreas[(STAFF_MAX_COUNT + static_cast<uint8_t>(StaffType::Count)) * STAFF_PATROL_AREA_SIZE];
+static_assert(STAFF_PATROL_AREA_SIZE == PATROL_AREA_WORDS);
 StaffMode gStaffModes[STAFF_MAX_COUNT + static_cast<uint8_t>(StaffType::Count)];
 uint16_t gStaffDrawPatrolAreas;
 colour_t gStaffHandymanColour;
@@ -152,28 +153,30 @@ bool staff_hire_new_member(StaffType staffType, EntertainerCostume entertainerTy
  */
 void staff_update_greyed_patrol_areas()
 {
-    for (int32_t staff_type = 0; staff_type < static_cast<uint8_t>(StaffType::Count); ++staff_type)
+    for (int32_t staffType = 0; staffType < static_cast<uint8_t>(StaffType::Count); ++staffType)
     {
-        int32_t staffPatrolOffset = (staff_type + STAFF_MAX_COUNT) * STAFF_PATROL_AREA_SIZE;
-        for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-        {
-            gStaffPatrolAreas[staffPatrolOffset + i] = 0;
-        }
+        staff_get_patrol_area_for_type(static_cast<StaffType>(staffType)).Clear();
+    }
 
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    {
+        if (peep->AssignedStaffType < StaffType::Count)
         {
-            if (static_cast<uint8_t>(peep->AssignedStaffType) == staff_type)
-            {
-                int32_t peepPatrolOffset = peep->StaffId * STAFF_PATROL_AREA_SIZE;
-                for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-                {
-                    gStaffPatrolAreas[staffPatrolOffset + i] |= gStaffPatrolAreas[peepPatrolOffset + i];
-                }
-            }
+            staff_get_patrol_area_for_type(peep->AssignedStaffType).Union(staff_get_patrol_area(peep->StaffId));
         }
     }
 }
 
+PatrolArea staff_get_patrol_area(int32_t staffIndex)
+{
+    return PatrolArea(&gStaffPatrolAreas[staffIndex * STAFF_PATROL_AREA_SIZE]);
+}
+
+PatrolArea staff_get_patrol_area_for_type(StaffType type)
+{
+    return staff_get_patrol_area(STAFF_MAX_COUNT + static_cast<uint8_t>(type));
+}
+
 /**
  *
  *  rct2: 0x006C0905
@@ -195,13 +198,24 @@ bool Staff::IsLocationInPatrol(const CoordsXY& loc) const
 // patrol zone for mechanic.
 bool Staff::IsLocationOnPatrolEdge(const CoordsXY& loc) const
 {
-    bool onZoneEdge = false;
-    for (uint8_t neighbourDir = 0; !onZoneEdge && neighbourDir <= 7; neighbourDir++)
+    // When the quads around the one of loc are all patrolled, so is every tile next to loc and only the ownership
+    // of those tiles is left to check.
+    bool checkPatrol = gStaffModes[StaffId] == StaffMode::Patrol;
+    if (checkPatrol)
+    {
+        auto quad = PatrolArea::GetQuad(loc);
+        checkPatrol = !staff_get_patrol_area(StaffId).IsQuadInterior(quad.x, quad.y);
+    }
+
+    for (uint8_t neighbourDir = 0; neighbourDir <= 7; neighbourDir++)
     {
         auto neighbourPos = loc + CoordsDirectionDelta[neighbourDir];
-        onZoneEdge = !IsLocationInPatrol(neighbourPos);
+        if (!map_is_location_owned_or_has_rights(neighbourPos))
+            return true;
+        if (checkPatrol && !IsPatrolAreaSet(neighbourPos))
+            return true;
     }
-    return onZoneEdge;
+    return false;
 }
 
 bool Staff::CanIgnoreWideFlag(const CoordsXYZ& staffPos, TileElement* path) const
@@ -372,56 +386,26 @@ void Staff::ResetStats()
     }
 }
 
-static std::pair<int32_t, int32_t> getPatrolAreaOffsetIndex(const CoordsXY& coords)
-{
-    // Patrol areas are 4 * 4 tiles (32 * 4) = 128 = 2^^7
-    auto hash = ((coords.x & 0x1F80) >> 7) | ((coords.y & 0x1F80) >> 1);
-    return { hash >> 5, hash & 0x1F };
-}
-
-static bool staff_is_patrol_area_set(int32_t staffIndex, const CoordsXY& coords)
-{
-    // Patrol quads are stored in a bit map (8 patrol quads per byte).
-    // Each patrol quad is 4x4.
-    // Therefore there are in total 64 x 64 patrol quads in the 256 x 256 map.
-    // At the end of the array (after the slots for individual staff members),
-    // there are slots that save the combined patrol area for every staff type.
-
-    int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    auto [offset, bitIndex] = getPatrolAreaOffsetIndex(coords);
-    return gStaffPatrolAreas[peepOffset + offset] & (1UL << bitIndex);
-}
-
 bool Staff::IsPatrolAreaSet(const CoordsXY& coords) const
 {
-    return staff_is_patrol_area_set(StaffId, coords);
+    return staff_get_patrol_area(StaffId).Get(coords);
 }
 
 bool staff_is_patrol_area_set_for_type(StaffType type, const CoordsXY& coords)
 {
-    return staff_is_patrol_area_set(STAFF_MAX_COUNT + static_cast<uint8_t>(type), coords);
+    // At the end of the array (after the slots for individual staff members),
+    // there are slots that save the combined patrol area for every staff type.
+    return staff_get_patrol_area_for_type(type).Get(coords);
 }
 
 void staff_set_patrol_area(int32_t staffIndex, const CoordsXY& coords, bool value)
 {
-    int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    auto [offset, bitIndex] = getPatrolAreaOffsetIndex(coords);
-    uint32_t* addr = &gStaffPatrolAreas[peepOffset + offset];
-    if (value)
-    {
-        *addr |= (1 << bitIndex);
-    }
-    else
-    {
-        *addr &= ~(1 << bitIndex);
-    }
+    staff_get_patrol_area(staffIndex).Set(coords, value);
 }
 
 void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords)
 {
-    int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    auto [offset, bitIndex] = getPatrolAreaOffsetIndex(coords);
-    gStaffPatrolAreas[peepOffset + offset] ^= (1 << bitIndex);
+    staff_get_patrol_area(staffIndex).Toggle(coords);
 }
 
 /**
@@ -433,19 +417,24 @@ void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords)
 Direction Staff::HandymanDirectionToNearestLitter() const
 {
     uint16_t nearestLitterDist = 0xFFFF;
+    uint32_t nearestLitterPosition = 0;
     Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>(EntityListId::Litter))
-    {
+    const MapRange searchRange{ x - MAX_LITTER_DISTANCE, y - MAX_LITTER_DISTANCE, x + MAX_LITTER_DISTANCE,
+                                y + MAX_LITTER_DISTANCE };
+    ForEachLitterInRange(searchRange, [&](Litter* litter) {
         uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
 
-        if (distance < nearestLitterDist)
+        // Of litter at the same distance, pick the one that comes first in the litter list.
+        auto position = GetEntityListPosition(litter->sprite_index);
+        if (distance < nearestLitterDist || (distance == nearestLitterDist && position > nearestLitterPosition))
         {
             nearestLitterDist = distance;
+            nearestLitterPosition = position;
             nearestLitter = litter;
         }
-    }
+    });
 
-    if (nearestLitterDist > MAX_LITTER_DISTANCE)
+    if (nearestLitter == nullptr || nearestLitterDist > MAX_LITTER_DISTANCE)
     {
         return INVALID_DIRECTION;
     }
@@ -975,23 +964,10 @@ bool Staff::DoMiscPathFinding()
  */
 void Staff::EntertainerUpdateNearbyPeeps() const
 {
-    for (auto guest : EntityList<Guest>(EntityListId::Peep))
-    {
-        if (guest->x == LOCATION_NULL)
-            continue;
-
+    ForEachEntityInRange<Guest>({ x - 96, y - 96, x + 96, y + 96 }, [this](Guest* guest) {
         int16_t z_dist = abs(z - guest->z);
         if (z_dist > 48)
-            continue;
-
-        int16_t x_dist = abs(x - guest->x);
-        int16_t y_dist = abs(y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
+            return;
 
         if (guest->State == PeepState::Walking)
         {
@@ -1002,7 +978,7 @@ void Staff::EntertainerUpdateNearbyPeeps() const
             guest->TimeInQueue = std::max(0, guest->TimeInQueue - 200);
             guest->HappinessTarget = std::min(guest->HappinessTarget + 3, PEEP_MAX_HAPPINESS);
         }
-    }
+    });
 }
 
 /**
@@ -11,6 +11,7 @@
 #define _STAFF_H_
 
 #include "../common.h"
+#include "PatrolArea.h"
 #include "Peep.h"
 
 #define STAFF_MAX_COUNT 200
@@ -67,6 +68,8 @@ void staff_reset_modes();
 void staff_set_name(uint16_t spriteIndex, const char* name);
 bool staff_hire_new_member(StaffType staffType, EntertainerCostume entertainerType);
 void staff_update_greyed_patrol_areas();
+PatrolArea staff_get_patrol_area(int32_t staffIndex);
+PatrolArea staff_get_patrol_area_for_type(StaffType type);
 bool staff_is_patrol_area_set_for_type(StaffType type, const CoordsXY& coords);
 void staff_set_patrol_area(int32_t staffIndex, const CoordsXY& coords, bool value);
 void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords);
@@ -13,11 +13,17 @@
 #    include "Platform2.h"
 #    include "platform.h"
 
+#    include <cerrno>
 #    include <clocale>
 #    include <cstdlib>
 #    include <cstring>
 #    include <ctime>
+#    include <fcntl.h>
 #    include <pwd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
 
 namespace Platform
 {
@@ -26,6 +32,16 @@ namespace Platform
         return platform_get_ticks();
     }
 
+    int64_t GetThreadCpuTime()
+    {
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        {
+            return 0;
+        }
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
     std::string GetEnvironmentVariable(const std::string& name)
     {
         return String::ToStd(getenv(name.c_str()));
@@ -104,6 +120,75 @@ namespace Platform
     {
         return false;
     }
+
+    const void* MapFile(const std::string& path, size_t* outLength)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            return nullptr;
+        }
+
+        void* data = nullptr;
+        struct stat statInfo;
+        if (fstat(fd, &statInfo) == 0 && S_ISREG(statInfo.st_mode) && statInfo.st_size > 0)
+        {
+            auto length = static_cast<size_t>(statInfo.st_size);
+            data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                data = nullptr;
+            }
+            else
+            {
+                // The file is read from start to end
+                madvise(data, length, MADV_SEQUENTIAL);
+                *outLength = length;
+            }
+        }
+
+        // The mapping stays valid after the file is closed
+        close(fd);
+        return data;
+    }
+
+    void UnmapFile(const void* data, size_t length)
+    {
+        munmap(const_cast<void*>(data), length);
+    }
+
+    ProcessHandle StartProcess(const std::string& path, const std::vector<std::string>& args)
+    {
+        // Built before forking, only exec and _exit are safe to call in the child of a multithreaded process
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(path.c_str()));
+        for (const auto& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        auto pid = fork();
+        if (pid == 0)
+        {
+            execv(path.c_str(), argv.data());
+            _exit(127);
+        }
+        return pid > 0 ? static_cast<ProcessHandle>(pid) : 0;
+    }
+
+    int32_t WaitForProcess(ProcessHandle process)
+    {
+        int status;
+        while (waitpid(static_cast<pid_t>(process), &status, 0) == -1)
+        {
+            if (errno != EINTR)
+            {
+                return -1;
+            }
+        }
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
 } // namespace Platform
 
 #endif
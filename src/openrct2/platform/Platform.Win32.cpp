@@ -57,6 +57,20 @@ namespace Platform
         return platform_get_ticks();
     }
 
+    int64_t GetThreadCpuTime()
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+        {
+            return 0;
+        }
+        // Both times are in units of 100 nanoseconds
+        auto toTicks = [](const FILETIME& ft) {
+            return (static_cast<int64_t>(ft.dwHighDateTime) << 32) | static_cast<int64_t>(ft.dwLowDateTime);
+        };
+        return (toTicks(kernelTime) + toTicks(userTime)) * 100;
+    }
+
     std::string GetEnvironmentVariable(const std::string& name)
     {
         std::wstring result;
@@ -520,6 +534,99 @@ namespace Platform
     {
         return false;
     }
+
+    const void* MapFile(const std::string& path, size_t* outLength)
+    {
+        auto pathW = String::ToWideChar(path);
+        HANDLE file = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        const void* data = nullptr;
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+            && static_cast<uint64_t>(fileSize.QuadPart) <= SIZE_MAX)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr)
+            {
+                data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (data != nullptr)
+                {
+                    *outLength = static_cast<size_t>(fileSize.QuadPart);
+                }
+
+                // The view keeps the mapping and the file open until it is unmapped
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        return data;
+    }
+
+    void UnmapFile(const void* data, size_t length)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    // Quotes the argument so CommandLineToArgvW splits it off again unchanged
+    static void AppendQuotedArgument(std::wstring& commandLine, const std::wstring& arg)
+    {
+        commandLine.push_back(L'"');
+        size_t numBackslashes = 0;
+        for (auto c : arg)
+        {
+            if (c == L'\\')
+            {
+                numBackslashes++;
+                continue;
+            }
+            commandLine.append(c == L'"' ? numBackslashes * 2 + 1 : numBackslashes, L'\\');
+            commandLine.push_back(c);
+            numBackslashes = 0;
+        }
+        commandLine.append(numBackslashes * 2, L'\\');
+        commandLine.push_back(L'"');
+    }
+
+    ProcessHandle StartProcess(const std::string& path, const std::vector<std::string>& args)
+    {
+        auto pathW = String::ToWideChar(path);
+        std::wstring commandLine;
+        AppendQuotedArgument(commandLine, pathW);
+        for (const auto& arg : args)
+        {
+            commandLine.push_back(L' ');
+            AppendQuotedArgument(commandLine, String::ToWideChar(arg));
+        }
+
+        STARTUPINFOW startupInfo{};
+        startupInfo.cb = sizeof(startupInfo);
+        PROCESS_INFORMATION processInfo{};
+        if (!CreateProcessW(
+                pathW.c_str(), commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo))
+        {
+            return 0;
+        }
+        CloseHandle(processInfo.hThread);
+        return reinterpret_cast<ProcessHandle>(processInfo.hProcess);
+    }
+
+    int32_t WaitForProcess(ProcessHandle process)
+    {
+        auto handle = reinterpret_cast<HANDLE>(process);
+        int32_t result = -1;
+        DWORD exitCode;
+        if (WaitForSingleObject(handle, INFINITE) == WAIT_OBJECT_0 && GetExitCodeProcess(handle, &exitCode))
+        {
+            result = static_cast<int32_t>(exitCode);
+        }
+        CloseHandle(handle);
+        return result;
+    }
 } // namespace Platform
 
 #endif
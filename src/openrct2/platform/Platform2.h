@@ -13,7 +13,9 @@
 #include "platform.h"
 
 #include <ctime>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 enum class SPECIAL_FOLDER
 {
@@ -28,6 +30,8 @@ enum class SPECIAL_FOLDER
 namespace Platform
 {
     uint32_t GetTicks();
+    // CPU time the calling thread has used so far, in nanoseconds
+    int64_t GetThreadCpuTime();
     std::string GetEnvironmentVariable(const std::string& name);
     std::string GetFolderPath(SPECIAL_FOLDER folder);
     std::string GetInstallPath();
@@ -43,6 +47,24 @@ namespace Platform
     std::string GetHomePath();
 #endif
 
+    /**
+     * Maps the whole of the file at the given path into memory for reading. Returns nullptr if the file could not be
+     * opened or mapped, or is empty. The mapping has to be released again with UnmapFile.
+     */
+    const void* MapFile(const std::string& path, size_t* outLength);
+    void UnmapFile(const void* data, size_t length);
+
+    // A process started by StartProcess, 0 if it could not be started
+    using ProcessHandle = uintptr_t;
+
+    /**
+     * Starts the program at the given path with the given arguments, it shares the console of the calling process.
+     * The process has to be waited on with WaitForProcess, which returns its exit code or -1 if it did not exit
+     * normally.
+     */
+    ProcessHandle StartProcess(const std::string& path, const std::vector<std::string>& args);
+    int32_t WaitForProcess(ProcessHandle process);
+
     std::string FormatShortDate(std::time_t timestamp);
     std::string FormatTime(std::time_t timestamp);
 
@@ -17,9 +17,9 @@
 #include "../audio/audio.h"
 #include "../core/Collections.hpp"
 #include "../core/Console.hpp"
-#include "../core/FileStream.hpp"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -156,22 +156,22 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, false, skipObjectCheck, path);
+        auto stream = OpenFileForReading(path);
+        auto result = LoadFromStream(stream.get(), false, skipObjectCheck, path);
         return result;
     }
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, true, skipObjectCheck, path);
+        auto stream = OpenFileForReading(path);
+        auto result = LoadFromStream(stream.get(), true, skipObjectCheck, path);
         return result;
     }
 
     ParkLoadResult LoadFromStream(
         IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck, const utf8* path) override
     {
-        _s4 = *ReadAndDecodeS4(stream, isScenario);
+        ReadAndDecodeS4(stream, isScenario);
         _s4Path = path;
         _isScenario = isScenario;
         _gameVersion = sawyercoding_detect_rct1_version(_s4.game_version) & FILE_VERSION_MASK;
@@ -209,6 +209,7 @@ public:
         determine_ride_entrance_and_exit_locations();
 
         game_convert_news_items_to_utf8();
+        park_calculate_size();
         map_count_remaining_land_rights();
         research_determine_first_of_type();
     }
@@ -298,32 +299,37 @@ public:
     }
 
 private:
-    std::unique_ptr<rct1_s4> ReadAndDecodeS4(IStream* stream, bool isScenario)
+    void ReadAndDecodeS4(IStream* stream, bool isScenario)
     {
-        auto s4 = std::make_unique<rct1_s4>();
+        // Decode straight from the stream when it is held in memory, such as a mapped file
         size_t dataSize = stream->GetLength() - stream->GetPosition();
         auto deleter_lambda = [dataSize](uint8_t* ptr) { Memory::FreeArray(ptr, dataSize); };
-        auto data = std::unique_ptr<uint8_t, decltype(deleter_lambda)>(stream->ReadArray<uint8_t>(dataSize), deleter_lambda);
-        auto decodedData = std::unique_ptr<uint8_t, decltype(&Memory::Free<uint8_t>)>(
-            Memory::Allocate<uint8_t>(sizeof(rct1_s4)), &Memory::Free<uint8_t>);
-
-        size_t decodedSize;
-        int32_t fileType = sawyercoding_detect_file_type(data.get(), dataSize);
-        if (isScenario && (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1)
+        auto dataCopy = std::unique_ptr<uint8_t, decltype(deleter_lambda)>(nullptr, deleter_lambda);
+        auto data = static_cast<const uint8_t*>(stream->GetData());
+        if (data != nullptr)
         {
-            decodedSize = sawyercoding_decode_sc4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
+            data += stream->GetPosition();
         }
         else
         {
-            decodedSize = sawyercoding_decode_sv4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
+            dataCopy.reset(stream->ReadArray<uint8_t>(dataSize));
+            data = dataCopy.get();
         }
 
-        if (decodedSize == sizeof(rct1_s4))
+        // The park is decoded into place, it is only valid when the whole of it is decoded
+        auto decodedData = reinterpret_cast<uint8_t*>(&_s4);
+        size_t decodedSize;
+        int32_t fileType = sawyercoding_detect_file_type(data, dataSize);
+        if (isScenario && (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1)
         {
-            std::memcpy(s4.get(), decodedData.get(), sizeof(rct1_s4));
-            return s4;
+            decodedSize = sawyercoding_decode_sc4(data, decodedData, dataSize, sizeof(rct1_s4));
         }
         else
+        {
+            decodedSize = sawyercoding_decode_sv4(data, decodedData, dataSize, sizeof(rct1_s4));
+        }
+
+        if (decodedSize != sizeof(rct1_s4))
         {
             throw std::runtime_error("Unable to decode park.");
         }
@@ -339,8 +345,8 @@ private:
         String::Set(gScenarioFileName, sizeof(gScenarioFileName), GetRCT1ScenarioName().c_str());
 
         // Do map initialisation, same kind of stuff done when loading scenario editor
+        // The objects are not unloaded, LoadObjects keeps the ones this park uses as well and replaces the rest.
         auto context = OpenRCT2::GetContext();
-        context->GetObjectManager().UnloadAll();
         context->GetGameState()->InitAll(mapSize);
         gS6Info.editor_step = EDITOR_STEP_OBJECT_SELECTION;
         gParkFlags |= PARK_FLAGS_SHOW_REAL_GUEST_NAMES;
@@ -1350,7 +1356,7 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < GetEntityCapacity(); i++)
         {
             auto vehicle = GetEntity<Vehicle>(i);
             if (vehicle != nullptr)
@@ -1864,18 +1870,18 @@ private:
 
     void LoadObjects()
     {
-        auto& objectManager = OpenRCT2::GetContext()->GetObjectManager();
-        objectManager.LoadDefaultObjects();
-
-        LoadObjects(OBJECT_TYPE_RIDE, _rideEntries);
-        LoadObjects(OBJECT_TYPE_SMALL_SCENERY, _smallSceneryEntries);
-        LoadObjects(OBJECT_TYPE_LARGE_SCENERY, _largeSceneryEntries);
-        LoadObjects(OBJECT_TYPE_WALLS, _wallEntries);
-        LoadObjects(OBJECT_TYPE_PATHS, _pathEntries);
-        LoadObjects(OBJECT_TYPE_PATH_BITS, _pathAdditionEntries);
-        LoadObjects(OBJECT_TYPE_SCENERY_GROUP, _sceneryGroupEntries);
-        LoadObjects(
-            OBJECT_TYPE_BANNERS,
+        // All objects are loaded in one go into the slots the entry maps expect them in. Objects that are already
+        // loaded, such as the ones used by the previous park, are kept rather than being read and loaded again.
+        std::vector<rct_object_entry> entries(OBJECT_ENTRY_COUNT);
+        AddObjectEntries(entries, OBJECT_TYPE_RIDE, _rideEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_SMALL_SCENERY, _smallSceneryEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_LARGE_SCENERY, _largeSceneryEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_WALLS, _wallEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_PATHS, _pathEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_PATH_BITS, _pathAdditionEntries);
+        AddObjectEntries(entries, OBJECT_TYPE_SCENERY_GROUP, _sceneryGroupEntries);
+        AddObjectEntries(
+            entries, OBJECT_TYPE_BANNERS,
             std::vector<const char*>({
                 "BN1     ",
                 "BN2     ",
@@ -1887,34 +1893,50 @@ private:
                 "BN8     ",
                 "BN9     ",
             }));
-        LoadObjects(OBJECT_TYPE_PARK_ENTRANCE, std::vector<const char*>({ "PKENT1  " }));
-        LoadObjects(OBJECT_TYPE_WATER, _waterEntry);
+        AddObjectEntries(entries, OBJECT_TYPE_PARK_ENTRANCE, std::vector<const char*>({ "PKENT1  " }));
+        AddObjectEntries(entries, OBJECT_TYPE_WATER, _waterEntry);
+
+        // Also loads the default objects
+        auto& objectManager = OpenRCT2::GetContext()->GetObjectManager();
+        objectManager.LoadObjects(entries.data(), entries.size());
     }
 
-    void LoadObjects(uint8_t objectType, const EntryList& entries)
+    void AddObjectEntries(std::vector<rct_object_entry>& entries, uint8_t objectType, const EntryList& entryList)
     {
-        LoadObjects(objectType, entries.GetEntries());
+        AddObjectEntries(entries, objectType, entryList.GetEntries());
     }
 
-    void LoadObjects(uint8_t objectType, const std::vector<const char*>& entries)
+    void AddObjectEntries(
+        std::vector<rct_object_entry>& entries, uint8_t objectType, const std::vector<const char*>& objectNames)
     {
-        auto& objectManager = OpenRCT2::GetContext()->GetObjectManager();
+        auto& objectRepository = OpenRCT2::GetContext()->GetObjectRepository();
 
-        uint32_t entryIndex = 0;
-        for (const char* objectName : entries)
+        size_t firstIndex = 0;
+        for (uint8_t i = 0; i < objectType; i++)
         {
-            rct_object_entry entry;
+            firstIndex += object_entry_group_counts[i];
+        }
+
+        size_t entryIndex = 0;
+        for (const char* objectName : objectNames)
+        {
+            rct_object_entry entry{};
             entry.flags = 0x00008000 + objectType;
             std::copy_n(objectName, 8, entry.name);
-            entry.checksum = 0;
 
-            Object* object = objectManager.LoadObject(&entry);
-            if (object == nullptr && objectType != OBJECT_TYPE_SCENERY_GROUP)
+            // Missing scenery groups are skipped, the ones after them move up a slot
+            bool isAvailable = objectRepository.FindObject(&entry) != nullptr;
+            if (!isAvailable || entryIndex >= static_cast<size_t>(object_entry_group_counts[objectType]))
             {
+                if (objectType == OBJECT_TYPE_SCENERY_GROUP)
+                {
+                    continue;
+                }
                 log_error("Failed to load %s.", objectName);
                 throw std::runtime_error("Failed to load object.");
             }
 
+            entries[firstIndex + entryIndex] = entry;
             entryIndex++;
         }
     }
@@ -2797,7 +2819,8 @@ private:
             *tilePointer++ = nextFreeTileElement++;
         }
 
-        gNextFreeTileElement = nextFreeTileElement;
+        // Lay the tiles out in the order the rest of the game expects them in.
+        map_reorganise_elements();
     }
 
     void FixWalls()
@@ -20,6 +20,7 @@ enum class SAWYER_ENCODING : uint8_t
     RLE,
     RLECOMPRESSED,
     ROTATE,
+    ZLIB,
 };
 
 /**
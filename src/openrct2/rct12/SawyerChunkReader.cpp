@@ -9,7 +9,12 @@
 
 #include "SawyerChunkReader.h"
 
+#include "../Profiling.h"
 #include "../core/IStream.hpp"
+#include "../core/TaskScheduler.h"
+#include "zlib.h"
+
+#include <exception>
 
 // malloc is very slow for large allocations in MSVC debug builds as it allocates
 // memory on a special debug heap and then initialises all the memory to 0xCC.
@@ -23,6 +28,7 @@ constexpr size_t MAX_UNCOMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
 
 constexpr const char* EXCEPTION_MSG_CORRUPT_CHUNK_SIZE = "Corrupt chunk size.";
 constexpr const char* EXCEPTION_MSG_CORRUPT_RLE = "Corrupt RLE compression data.";
+constexpr const char* EXCEPTION_MSG_CORRUPT_ZLIB = "Corrupt zlib compression data.";
 constexpr const char* EXCEPTION_MSG_DESTINATION_TOO_SMALL = "Chunk data larger than allocated destination capacity.";
 constexpr const char* EXCEPTION_MSG_INVALID_CHUNK_ENCODING = "Invalid chunk encoding.";
 constexpr const char* EXCEPTION_MSG_ZERO_SIZED_CHUNK = "Encountered zero-sized chunk.";
@@ -76,15 +82,13 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
             case CHUNK_ENCODING_RLE:
             case CHUNK_ENCODING_RLECOMPRESSED:
             case CHUNK_ENCODING_ROTATE:
+            case CHUNK_ENCODING_ZLIB:
             {
-                std::unique_ptr<uint8_t[]> compressedData(new uint8_t[header.length]);
-                if (_stream->TryRead(compressedData.get(), header.length) != header.length)
-                {
-                    throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
-                }
+                std::unique_ptr<uint8_t[]> compressedBuffer;
+                auto compressedData = ReadCompressedData(header.length, compressedBuffer);
 
                 auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
-                size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.get(), header);
+                size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData, header);
                 if (uncompressedLength == 0)
                 {
                     throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
@@ -116,16 +120,12 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
             throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
         }
         uint32_t compressedDataLength = compressedDataLength64;
-        auto compressedData = std::make_unique<uint8_t[]>(compressedDataLength);
-
-        if (_stream->TryRead(compressedData.get(), compressedDataLength) != compressedDataLength)
-        {
-            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
-        }
+        std::unique_ptr<uint8_t[]> compressedBuffer;
+        auto compressedData = ReadCompressedData(compressedDataLength, compressedBuffer);
 
         auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
         sawyercoding_chunk_header header{ CHUNK_ENCODING_RLE, compressedDataLength };
-        size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.get(), header);
+        size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData, header);
         if (uncompressedLength == 0)
         {
             throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
@@ -162,6 +162,124 @@ void SawyerChunkReader::ReadChunk(void* dst, size_t length)
     }
 }
 
+void SawyerChunkReader::ReadChunks(const std::vector<ChunkDestination>& destinations)
+{
+    struct PendingChunk
+    {
+        sawyercoding_chunk_header Header;
+        const uint8_t* CompressedData;
+        std::unique_ptr<uint8_t[]> CompressedBuffer;
+        std::exception_ptr Error;
+    };
+
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        // The stream can only be read from one thread, so read everything up front.
+        std::vector<PendingChunk> chunks(destinations.size());
+        for (auto& chunk : chunks)
+        {
+            chunk.Header = _stream->ReadValue<sawyercoding_chunk_header>();
+            if (chunk.Header.length >= MAX_UNCOMPRESSED_CHUNK_SIZE)
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+
+            chunk.CompressedData = ReadCompressedData(chunk.Header.length, chunk.CompressedBuffer);
+        }
+
+        TaskScheduler::GetGlobal().ParallelFor(0, chunks.size(), 1, [&chunks, &destinations](size_t i) {
+            PROFILE_ZONE("Decode chunk");
+            auto& chunk = chunks[i];
+            try
+            {
+                DecodeChunkTo(destinations[i].Data, destinations[i].Length, chunk.CompressedData, chunk.Header);
+            }
+            catch (const std::exception&)
+            {
+                chunk.Error = std::current_exception();
+            }
+            chunk.CompressedBuffer.reset();
+        });
+
+        for (const auto& chunk : chunks)
+        {
+            if (chunk.Error != nullptr)
+            {
+                std::rethrow_exception(chunk.Error);
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+}
+
+/**
+ * Returns the next length bytes of the stream. Streams held in memory, such as a mapped file, are pointed into
+ * directly, anything else is read into the given buffer.
+ */
+const uint8_t* SawyerChunkReader::ReadCompressedData(size_t length, std::unique_ptr<uint8_t[]>& buffer)
+{
+    auto position = _stream->GetPosition();
+    auto data = static_cast<const uint8_t*>(_stream->GetData());
+    if (data != nullptr)
+    {
+        if (position + length > _stream->GetLength())
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+        }
+        _stream->Seek(length, OpenRCT2::STREAM_SEEK_CURRENT);
+        return data + position;
+    }
+
+    buffer.reset(new uint8_t[length]);
+    if (_stream->TryRead(buffer.get(), length) != length)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+    }
+    return buffer.get();
+}
+
+/**
+ * Decodes a chunk into the destination buffer with the same truncating and padding as ReadChunk(dst, length).
+ */
+void SawyerChunkReader::DecodeChunkTo(void* dst, size_t length, const void* src, const sawyercoding_chunk_header& header)
+{
+    size_t uncompressedLength = 0;
+    try
+    {
+        uncompressedLength = DecodeChunk(dst, length, src, header);
+    }
+    catch (const SawyerChunkException&)
+    {
+        // Either the chunk is larger than the destination or it is corrupt, decoding it again the usual way
+        // truncates it in the first case and reports the error in the second.
+        auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
+        try
+        {
+            uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, src, header);
+        }
+        catch (const std::exception&)
+        {
+            FreeLargeTempBuffer(buffer);
+            throw;
+        }
+        std::memcpy(dst, buffer, std::min(uncompressedLength, length));
+        FreeLargeTempBuffer(buffer);
+    }
+
+    if (uncompressedLength == 0)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+    }
+    if (uncompressedLength < length)
+    {
+        std::fill_n(static_cast<uint8_t*>(dst) + uncompressedLength, length - uncompressedLength, 0x00);
+    }
+}
+
 size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header)
 {
     size_t resultLength;
@@ -184,6 +302,9 @@ size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void*
         case CHUNK_ENCODING_ROTATE:
             resultLength = DecodeChunkRotate(dst, dstCapacity, src, header.length);
             break;
+        case CHUNK_ENCODING_ZLIB:
+            resultLength = DecodeChunkZlib(dst, dstCapacity, src, header.length);
+            break;
         default:
             throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
     }
@@ -263,10 +384,14 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
             size_t count = (src8[i] & 7) + 1;
             const uint8_t* copySrc = dst8 + static_cast<int32_t>(src8[i] >> 3) - 32;
 
-            if (dst8 + count >= dstEnd || copySrc + count >= dstEnd)
+            if (dst8 + count > dstEnd || copySrc + count > dstEnd)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
+            if (copySrc < dst)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+            }
 
             std::memcpy(dst8, copySrc, count);
             dst8 += count;
@@ -293,6 +418,22 @@ size_t SawyerChunkReader::DecodeChunkRotate(void* dst, size_t dstCapacity, const
     return srcLength;
 }
 
+size_t SawyerChunkReader::DecodeChunkZlib(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
+{
+    auto dstLength = static_cast<uLongf>(dstCapacity);
+    auto result = uncompress(
+        static_cast<Bytef*>(dst), &dstLength, static_cast<const Bytef*>(src), static_cast<uLong>(srcLength));
+    if (result == Z_BUF_ERROR && dstLength == dstCapacity)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+    }
+    if (result != Z_OK)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_ZLIB);
+    }
+    return dstLength;
+}
+
 void* SawyerChunkReader::AllocateLargeTempBuffer()
 {
 #ifdef __USE_HEAP_ALLOC__
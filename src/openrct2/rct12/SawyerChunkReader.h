@@ -14,6 +14,7 @@
 #include "SawyerChunk.h"
 
 #include <memory>
+#include <vector>
 
 namespace OpenRCT2
 {
@@ -30,6 +31,15 @@ private:
     OpenRCT2::IStream* const _stream = nullptr;
 
 public:
+    /**
+     * A buffer a chunk is read into by ReadChunks.
+     */
+    struct ChunkDestination
+    {
+        void* Data;
+        size_t Length;
+    };
+
     explicit SawyerChunkReader(OpenRCT2::IStream* stream);
 
     /**
@@ -58,6 +68,14 @@ public:
      */
     void ReadChunk(void* dst, size_t length);
 
+    /**
+     * Reads the next chunks from the stream into the destination buffers,
+     * the same as calling ReadChunk(dst, length) for each of them in turn.
+     * The compressed data of all chunks is read first, after which the
+     * chunks are decoded in parallel straight into their destinations.
+     */
+    void ReadChunks(const std::vector<ChunkDestination>& destinations);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
@@ -71,11 +89,14 @@ public:
     }
 
 private:
+    const uint8_t* ReadCompressedData(size_t length, std::unique_ptr<uint8_t[]>& buffer);
+    static void DecodeChunkTo(void* dst, size_t length, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRotate(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
+    static size_t DecodeChunkZlib(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
 
     static void* AllocateLargeTempBuffer();
     static void* FinaliseLargeTempBuffer(void* buffer, size_t len);
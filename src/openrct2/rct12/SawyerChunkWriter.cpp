@@ -9,12 +9,59 @@
 
 #include "SawyerChunkWriter.h"
 
+#include "../Profiling.h"
 #include "../core/IStream.hpp"
+#include "../core/TaskScheduler.h"
 #include "../util/SawyerCoding.h"
 
+#include <exception>
+#include <mutex>
+
 // Maximum buffer size to store compressed data, maximum of 16 MiB
 constexpr size_t MAX_COMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
 
+// Enough for every chunk of a saved game to be encoded at the same time
+constexpr size_t MAX_POOLED_BUFFERS = 16;
+
+/**
+ * The buffers chunks are encoded into are kept for the next save rather than allocated again for every chunk, as
+ * autosaves and map sends write the same chunks over and over again. Only the pages of a buffer that have been
+ * written to take up memory.
+ */
+class EncodeBufferPool
+{
+private:
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<uint8_t[]>> _buffers;
+
+public:
+    std::unique_ptr<uint8_t[]> Acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_buffers.empty())
+            {
+                auto buffer = std::move(_buffers.back());
+                _buffers.pop_back();
+                return buffer;
+            }
+        }
+        // Left uninitialised, only the pages that are written to are ever touched
+        return std::unique_ptr<uint8_t[]>(new uint8_t[MAX_COMPRESSED_CHUNK_SIZE]);
+    }
+
+    void Release(std::unique_ptr<uint8_t[]> buffer)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_buffers.size() < MAX_POOLED_BUFFERS)
+        {
+            _buffers.push_back(std::move(buffer));
+        }
+    }
+};
+
+static EncodeBufferPool _encodeBufferPool;
+
 SawyerChunkWriter::SawyerChunkWriter(OpenRCT2::IStream* stream)
     : _stream(stream)
 {
@@ -31,10 +78,53 @@ void SawyerChunkWriter::WriteChunk(const void* src, size_t length, SAWYER_ENCODI
     header.encoding = static_cast<uint8_t>(encoding);
     header.length = static_cast<uint32_t>(length);
 
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
+    auto data = _encodeBufferPool.Acquire();
     size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), static_cast<const uint8_t*>(src), header);
 
     _stream->Write(data.get(), dataLength);
+    _encodeBufferPool.Release(std::move(data));
+}
+
+void SawyerChunkWriter::WriteChunks(const std::vector<ChunkSource>& sources)
+{
+    struct EncodedChunk
+    {
+        std::unique_ptr<uint8_t[]> Data;
+        size_t Length;
+        std::exception_ptr Error;
+    };
+
+    std::vector<EncodedChunk> chunks(sources.size());
+    TaskScheduler::GetGlobal().ParallelFor(0, sources.size(), 1, [&chunks, &sources](size_t i) {
+        PROFILE_ZONE("Encode chunk");
+        sawyercoding_chunk_header header;
+        header.encoding = static_cast<uint8_t>(sources[i].Encoding);
+        header.length = static_cast<uint32_t>(sources[i].Length);
+
+        try
+        {
+            chunks[i].Data = _encodeBufferPool.Acquire();
+            chunks[i].Length = sawyercoding_write_chunk_buffer(
+                chunks[i].Data.get(), static_cast<const uint8_t*>(sources[i].Data), header);
+        }
+        catch (const std::exception&)
+        {
+            chunks[i].Error = std::current_exception();
+        }
+    });
+
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.Error != nullptr)
+        {
+            std::rethrow_exception(chunk.Error);
+        }
+    }
+    for (auto& chunk : chunks)
+    {
+        _stream->Write(chunk.Data.get(), chunk.Length);
+        _encodeBufferPool.Release(std::move(chunk.Data));
+    }
 }
 
 /**
@@ -91,7 +181,7 @@ static size_t EncodeChunkRLE(const uint8_t* src_buffer, uint8_t* dst_buffer, siz
 
 void SawyerChunkWriter::WriteChunkTrack(const void* src, size_t length)
 {
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
+    auto data = _encodeBufferPool.Acquire();
     size_t dataLength = EncodeChunkRLE(static_cast<const uint8_t*>(src), data.get(), length);
 
     uint32_t checksum = 0;
@@ -105,4 +195,5 @@ void SawyerChunkWriter::WriteChunkTrack(const void* src, size_t length)
 
     _stream->Write(data.get(), dataLength);
     _stream->WriteValue<uint32_t>(checksum);
+    _encodeBufferPool.Release(std::move(data));
 }
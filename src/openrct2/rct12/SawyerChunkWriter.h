@@ -13,6 +13,7 @@
 #include "SawyerChunk.h"
 
 #include <memory>
+#include <vector>
 
 namespace OpenRCT2
 {
@@ -29,6 +30,16 @@ private:
     OpenRCT2::IStream* const _stream = nullptr;
 
 public:
+    /**
+     * A buffer written as a chunk by WriteChunks.
+     */
+    struct ChunkSource
+    {
+        const void* Data;
+        size_t Length;
+        SAWYER_ENCODING Encoding;
+    };
+
     explicit SawyerChunkWriter(OpenRCT2::IStream* stream);
 
     /**
@@ -43,6 +54,13 @@ public:
      */
     void WriteChunk(const void* src, size_t length, SAWYER_ENCODING encoding);
 
+    /**
+     * Writes a chunk to the stream for each of the given buffers, the same
+     * as calling WriteChunk(src, length, encoding) for each of them in turn.
+     * The chunks are encoded in parallel and written in order once done.
+     */
+    void WriteChunks(const std::vector<ChunkSource>& sources);
+
     /**
      * Writes a track chunk to the stream containing the given buffer.
      * @param src The source buffer.
@@ -10,9 +10,11 @@
 #include "SawyerEncoding.h"
 
 #include "../core/IStream.hpp"
+#include "../util/SawyerCoding.h"
 #include "RCT12.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace SawyerEncoding
 {
@@ -26,6 +28,16 @@ namespace SawyerEncoding
         }
         dataSize -= 4;
 
+        // Streams held in memory can be summed in place
+        auto data = static_cast<const uint8_t*>(stream->GetData());
+        if (data != nullptr)
+        {
+            uint32_t checksum = sawyercoding_calculate_checksum(data + initialPosition, static_cast<size_t>(dataSize));
+            uint32_t fileChecksum;
+            std::memcpy(&fileChecksum, data + initialPosition + dataSize, sizeof(fileChecksum));
+            return checksum == fileChecksum;
+        }
+
         try
         {
             // Calculate checksum
@@ -36,10 +48,7 @@ namespace SawyerEncoding
                 uint64_t bufferSize = std::min<uint64_t>(dataSize, sizeof(buffer));
                 stream->Read(buffer, bufferSize);
 
-                for (uint64_t i = 0; i < bufferSize; i++)
-                {
-                    checksum += buffer[i];
-                }
+                checksum += sawyercoding_calculate_checksum(buffer, static_cast<size_t>(bufferSize));
 
                 dataSize -= bufferSize;
             } while (dataSize != 0);
@@ -73,13 +82,20 @@ namespace SawyerEncoding
 
         try
         {
-            auto data{ stream->ReadArray<uint8_t>(dataSize) };
+            // Read in blocks rather than all at once, designs are validated one after another when they are indexed
+            uint8_t block[4096];
             uint32_t checksum = 0;
-            for (size_t i = 0; i < dataSize; i++, ++data)
+            for (uint64_t remaining = dataSize; remaining > 0;)
             {
-                uint8_t newByte = ((checksum & 0xFF) + *data) & 0xFF;
-                checksum = (checksum & 0xFFFFFF00) + newByte;
-                checksum = rol32(checksum, 3);
+                const auto blockSize = static_cast<size_t>(std::min<uint64_t>(remaining, sizeof(block)));
+                stream->Read(block, blockSize);
+                for (size_t i = 0; i < blockSize; i++)
+                {
+                    uint8_t newByte = ((checksum & 0xFF) + block[i]) & 0xFF;
+                    checksum = (checksum & 0xFFFFFF00) + newByte;
+                    checksum = rol32(checksum, 3);
+                }
+                remaining -= blockSize;
             }
 
             uint32_t fileChecksum = stream->ReadValue<uint32_t>();
@@ -28,6 +28,7 @@ constexpr const uint8_t RCT2_MAX_VEHICLES_PER_RIDE_ENTRY = 4;
 constexpr const uint8_t RCT2_DOWNTIME_HISTORY_SIZE = 8;
 constexpr const uint8_t RCT2_CUSTOMER_HISTORY_SIZE = 10;
 constexpr const uint16_t RCT2_MAX_SPRITES = 10000;
+constexpr const uint32_t RCT2_ENTITY_POOL_MAGIC = 0x4C4F4F50; // "POOL"
 constexpr const uint32_t RCT2_MAX_TILE_ELEMENTS = 0x30000;
 constexpr const uint16_t RCT2_MAX_ANIMATED_OBJECTS = 2000;
 constexpr const uint8_t RCT2_MAX_RESEARCHED_RIDE_TYPE_QUADS = 8;  // With 32 bits per uint32_t, this means there is room for 256
@@ -744,6 +745,19 @@ public:
 };
 assert_struct_size(RCT2Sprite, 0x100);
 
+/**
+ * OpenRCT2 extension to saved games, written as an extra chunk after the regular ones when the entity pool has grown
+ * beyond RCT2_MAX_SPRITES or is allowed to. The header is followed by the (capacity - RCT2_MAX_SPRITES) entities that
+ * do not fit in rct_s6_data::sprites.
+ */
+struct RCT2EntityPoolHeader
+{
+    uint32_t magic;
+    uint16_t capacity;
+    uint16_t max_entities;
+};
+assert_struct_size(RCT2EntityPoolHeader, 8);
+
 struct RCT2RideRatingCalculationData
 {
     uint16_t proximity_x;
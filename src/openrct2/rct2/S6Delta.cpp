@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "S6Delta.h"
+
+#include "../core/DataSerialiser.h"
+#include "../core/File.h"
+#include "../core/FileStream.hpp"
+#include "../core/MappedFileStream.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
+#include "../rct12/SawyerChunkReader.h"
+#include "../rct12/SawyerChunkWriter.h"
+#include "../scenario/Scenario.h"
+#include "../util/SawyerCoding.h"
+#include "S6Exporter.h"
+#include "zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace OpenRCT2;
+
+static constexpr uint32_t S6_DELTA_MAGIC = 0x4C443653; // S6DL
+static constexpr uint32_t S6_DELTA_VERSION = 1;
+
+// Blocks of the chunks are compared and stored in this size, small enough to hold a few entities or tiles each
+static constexpr size_t S6_DELTA_BLOCK_SIZE = 1024;
+
+static uint32_t ReadSavedGameChecksum(IStream& stream)
+{
+    const auto length = stream.GetLength();
+    if (length < sizeof(uint32_t))
+    {
+        throw IOException("Saved game is too short.");
+    }
+    stream.SetPosition(length - sizeof(uint32_t));
+    return stream.ReadValue<uint32_t>();
+}
+
+std::string S6DeltaWriter::Save(S6Exporter& exporter, const std::string& path, int32_t maxDeltas)
+{
+    if (!_baselinePath.empty() && _numDeltas < maxDeltas && File::Exists(_baselinePath))
+    {
+        auto deltaPath = Path::Combine(
+            Path::GetDirectory(path), Path::GetFileNameWithoutExtension(path) + S6_DELTA_EXTENSION);
+        if (TrySaveDelta(exporter, deltaPath))
+        {
+            _numDeltas++;
+            return deltaPath;
+        }
+    }
+
+    exporter.SaveGame(path.c_str());
+    SetBaseline(exporter, path);
+    return path;
+}
+
+bool S6DeltaWriter::TrySaveDelta(S6Exporter& exporter, const std::string& path) const
+{
+    auto chunks = exporter.GetSavedGameChunks();
+
+    // Collect the blocks that differ from the baseline, including any past its end
+    std::vector<std::vector<uint32_t>> changedBlocks(chunks.size());
+    MemoryStream blockData;
+    size_t totalLength = 0;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        const auto* data = static_cast<const uint8_t*>(chunks[i].Data);
+        const size_t length = chunks[i].Length;
+        const auto* baseline = i < _baselineChunks.size() ? &_baselineChunks[i] : nullptr;
+        for (size_t offset = 0; offset < length; offset += S6_DELTA_BLOCK_SIZE)
+        {
+            const size_t blockLength = std::min(S6_DELTA_BLOCK_SIZE, length - offset);
+            if (baseline == nullptr || offset + blockLength > baseline->size()
+                || std::memcmp(data + offset, baseline->data() + offset, blockLength) != 0)
+            {
+                changedBlocks[i].push_back(static_cast<uint32_t>(offset / S6_DELTA_BLOCK_SIZE));
+                blockData.Write(data + offset, blockLength);
+            }
+        }
+        totalLength += length;
+    }
+
+    // Once most of the park has changed a new baseline is smaller than the deltas that would follow
+    if (blockData.GetLength() * 2 > totalLength)
+    {
+        return false;
+    }
+
+    uLongf compressedLength = compressBound(static_cast<uLong>(blockData.GetLength()));
+    auto compressedData = std::make_unique<uint8_t[]>(compressedLength);
+    if (compress2(
+            compressedData.get(), &compressedLength, static_cast<const Bytef*>(blockData.GetData()),
+            static_cast<uLong>(blockData.GetLength()), Z_BEST_SPEED)
+        != Z_OK)
+    {
+        return false;
+    }
+
+    auto fs = FileStream(path, FILE_MODE_WRITE);
+    DataSerialiser ds(true, fs);
+
+    uint32_t magic = S6_DELTA_MAGIC;
+    uint32_t version = S6_DELTA_VERSION;
+    std::string baselineName = Path::GetFileName(_baselinePath);
+    uint32_t baselineChecksum = _baselineChecksum;
+    uint32_t numChunks = static_cast<uint32_t>(chunks.size());
+    ds << magic << version << baselineName << baselineChecksum << numChunks;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        uint32_t length = static_cast<uint32_t>(chunks[i].Length);
+        uint32_t numChangedBlocks = static_cast<uint32_t>(changedBlocks[i].size());
+        ds << length << numChangedBlocks;
+        for (auto blockIndex : changedBlocks[i])
+        {
+            ds << blockIndex;
+        }
+    }
+
+    uint32_t blockDataLength = static_cast<uint32_t>(blockData.GetLength());
+    auto compressedStream = MemoryStream(compressedData.get(), compressedLength);
+    ds << blockDataLength << compressedStream;
+    return true;
+}
+
+void S6DeltaWriter::SetBaseline(S6Exporter& exporter, const std::string& path)
+{
+    auto chunks = exporter.GetSavedGameChunks();
+    _baselineChunks.resize(chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        const auto* data = static_cast<const uint8_t*>(chunks[i].Data);
+        _baselineChunks[i].assign(data, data + chunks[i].Length);
+    }
+
+    auto fs = FileStream(path, FILE_MODE_OPEN);
+    _baselineChecksum = ReadSavedGameChecksum(fs);
+    _baselinePath = path;
+    _numDeltas = 0;
+}
+
+namespace S6Delta
+{
+    struct DeltaChunk
+    {
+        uint32_t Length = 0;
+        std::vector<uint32_t> ChangedBlocks;
+    };
+
+    std::unique_ptr<MemoryStream> Reconstruct(const std::string& path)
+    {
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        DataSerialiser ds(false, fs);
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        ds << magic << version;
+        if (magic != S6_DELTA_MAGIC || version != S6_DELTA_VERSION)
+        {
+            throw IOException("Not a supported saved game delta.");
+        }
+
+        std::string baselineName;
+        uint32_t baselineChecksum = 0;
+        uint32_t numChunks = 0;
+        ds << baselineName << baselineChecksum << numChunks;
+
+        std::vector<DeltaChunk> chunks(numChunks);
+        for (auto& chunk : chunks)
+        {
+            uint32_t numChangedBlocks = 0;
+            ds << chunk.Length << numChangedBlocks;
+            chunk.ChangedBlocks.resize(numChangedBlocks);
+            for (auto& blockIndex : chunk.ChangedBlocks)
+            {
+                ds << blockIndex;
+            }
+        }
+
+        uint32_t blockDataLength = 0;
+        MemoryStream compressedStream;
+        ds << blockDataLength << compressedStream;
+
+        std::vector<uint8_t> blockData(blockDataLength);
+        uLongf uncompressedLength = blockDataLength;
+        if (uncompress(
+                blockData.data(), &uncompressedLength, static_cast<const Bytef*>(compressedStream.GetData()),
+                static_cast<uLong>(compressedStream.GetLength()))
+                != Z_OK
+            || uncompressedLength != blockDataLength)
+        {
+            throw IOException("Saved game delta is corrupt.");
+        }
+
+        // The baseline must still be the file the delta was made against
+        auto baselinePath = Path::Combine(Path::GetDirectory(path), baselineName);
+        auto baseline = OpenFileForReading(baselinePath);
+        if (ReadSavedGameChecksum(*baseline) != baselineChecksum)
+        {
+            throw IOException("The baseline of the saved game delta has changed.");
+        }
+        const auto baselineLength = baseline->GetLength();
+        baseline->SetPosition(0);
+
+        // The header and packed objects are taken over as they are
+        auto chunkReader = SawyerChunkReader(baseline.get());
+        auto header = chunkReader.ReadChunkAs<rct_s6_header>();
+        for (uint16_t i = 0; i < header.num_packed_objects; i++)
+        {
+            baseline->ReadValue<rct_object_entry>();
+            chunkReader.SkipChunk();
+        }
+        const auto prefixLength = baseline->GetPosition();
+
+        std::vector<std::shared_ptr<SawyerChunk>> baselineChunks;
+        while (baseline->GetPosition() + sizeof(uint32_t) < baselineLength)
+        {
+            baselineChunks.push_back(chunkReader.ReadChunk());
+        }
+
+        auto result = std::make_unique<MemoryStream>();
+        {
+            std::vector<uint8_t> prefix(static_cast<size_t>(prefixLength));
+            baseline->SetPosition(0);
+            baseline->Read(prefix.data(), prefix.size());
+            result->Write(prefix.data(), prefix.size());
+        }
+
+        // The chunks are left unencoded, the result is only read back straight away
+        auto chunkWriter = SawyerChunkWriter(result.get());
+        size_t blockDataOffset = 0;
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            const auto& chunk = chunks[i];
+            std::vector<uint8_t> data(chunk.Length);
+            if (i < baselineChunks.size())
+            {
+                std::memcpy(
+                    data.data(), baselineChunks[i]->GetData(), std::min<size_t>(chunk.Length, baselineChunks[i]->GetLength()));
+            }
+            for (auto blockIndex : chunk.ChangedBlocks)
+            {
+                const size_t offset = static_cast<size_t>(blockIndex) * S6_DELTA_BLOCK_SIZE;
+                if (offset >= chunk.Length)
+                {
+                    throw IOException("Saved game delta is corrupt.");
+                }
+                const size_t blockLength = std::min(S6_DELTA_BLOCK_SIZE, chunk.Length - offset);
+                if (blockDataOffset + blockLength > blockData.size())
+                {
+                    throw IOException("Saved game delta is corrupt.");
+                }
+                std::memcpy(data.data() + offset, blockData.data() + blockDataOffset, blockLength);
+                blockDataOffset += blockLength;
+            }
+            chunkWriter.WriteChunk(data.data(), data.size(), SAWYER_ENCODING::NONE);
+        }
+
+        uint32_t checksum = sawyercoding_calculate_checksum(
+            static_cast<const uint8_t*>(result->GetData()), static_cast<size_t>(result->GetLength()));
+        result->WriteValue(checksum);
+        result->SetPosition(0);
+        return result;
+    }
+} // namespace S6Delta
@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2
+{
+    class MemoryStream;
+}
+
+class S6Exporter;
+
+constexpr const char* S6_DELTA_EXTENSION = ".sv6d";
+
+/**
+ * Writes saved games as a full saved game, the baseline, followed by delta files that only contain the blocks of the
+ * saved game chunks that changed since the baseline was written. A delta only depends on its baseline, not on the
+ * deltas written before it.
+ */
+class S6DeltaWriter final
+{
+private:
+    std::string _baselinePath;
+    uint32_t _baselineChecksum = 0;
+    std::vector<std::vector<uint8_t>> _baselineChunks;
+    int32_t _numDeltas = 0;
+
+public:
+    /**
+     * Saves the exported park to path as a new baseline, or as a delta file next to it when the baseline is fewer than
+     * maxDeltas deltas back and still exists, and the delta is small enough to be worth it.
+     * @returns The path of the file that was written.
+     */
+    std::string Save(S6Exporter& exporter, const std::string& path, int32_t maxDeltas);
+
+private:
+    bool TrySaveDelta(S6Exporter& exporter, const std::string& path) const;
+    void SetBaseline(S6Exporter& exporter, const std::string& path);
+};
+
+namespace S6Delta
+{
+    /**
+     * Rebuilds the saved game a delta file was written for from the delta and its baseline, which has to be in the
+     * same directory. The result can be loaded like any other saved game.
+     */
+    std::unique_ptr<OpenRCT2::MemoryStream> Reconstruct(const std::string& path);
+} // namespace S6Delta
@@ -12,7 +12,9 @@
 #include "../Context.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../HitchTracker.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../common.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
@@ -32,6 +34,8 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../peep/Staff.h"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -46,16 +50,23 @@
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
 #include "../world/Sprite.h"
+#include "S6Delta.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <memory>
 #include <optional>
 
 S6Exporter::S6Exporter()
 {
     RemoveTracklessRides = false;
+    CompressChunks = false;
+    RawChunks = false;
     std::memset(&_s6, 0x00, sizeof(_s6));
 }
 
@@ -83,12 +94,8 @@ void S6Exporter::SaveScenario(OpenRCT2::IStream* stream)
 
 void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
 {
-    _s6.header.type = isScenario ? S6_TYPE_SCENARIO : S6_TYPE_SAVEDGAME;
-    _s6.header.classic_flag = 0;
-    _s6.header.num_packed_objects = uint16_t(ExportObjectsList.size());
-    _s6.header.version = S6_RCT2_VERSION;
-    _s6.header.magic_number = S6_MAGIC_NUMBER;
-    _s6.game_version_number = 201028;
+    PROFILE_ZONE("S6Exporter::Save");
+    SetHeader(isScenario);
 
     auto chunkWriter = SawyerChunkWriter(stream);
 
@@ -108,49 +115,115 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
         objRepo.WritePackedObjects(stream, ExportObjectsList);
     }
 
+    // The remaining chunks are encoded in parallel
+    auto chunks = GetChunks();
+    _chunksLength = 0;
+    for (const auto& chunk : chunks)
+    {
+        _chunksLength += chunk.Length;
+    }
+    chunkWriter.WriteChunks(chunks);
+
+    // Determine number of bytes written
+    size_t fileSize = stream->GetLength();
+
+    // Read the written bytes back a block at a time for the checksum rather than holding the whole file in memory
+    stream->SetPosition(0);
+    uint32_t checksum = 0;
+    for (size_t remaining = fileSize; remaining != 0;)
+    {
+        uint8_t buffer[4096];
+        size_t blockSize = std::min(remaining, sizeof(buffer));
+        stream->Read(buffer, blockSize);
+        checksum += sawyercoding_calculate_checksum(buffer, blockSize);
+        remaining -= blockSize;
+    }
+
+    // Write the checksum on the end
+    stream->SetPosition(fileSize);
+    stream->WriteValue(checksum);
+}
+
+std::vector<SawyerChunkWriter::ChunkSource> S6Exporter::GetSavedGameChunks()
+{
+    SetHeader(false);
+    return GetChunks();
+}
+
+void S6Exporter::SetHeader(bool isScenario)
+{
+    _s6.header.type = isScenario ? S6_TYPE_SCENARIO : S6_TYPE_SAVEDGAME;
+    _s6.header.classic_flag = 0;
+    _s6.header.num_packed_objects = uint16_t(ExportObjectsList.size());
+    _s6.header.version = S6_RCT2_VERSION;
+    _s6.header.magic_number = S6_MAGIC_NUMBER;
+    _s6.game_version_number = 201028;
+}
+
+std::vector<SawyerChunkWriter::ChunkSource> S6Exporter::GetChunks()
+{
+    auto encoding = CompressChunks ? SAWYER_ENCODING::ZLIB : SAWYER_ENCODING::RLECOMPRESSED;
+    if (RawChunks)
+    {
+        encoding = SAWYER_ENCODING::NONE;
+    }
+    std::vector<SawyerChunkWriter::ChunkSource> chunks;
+
     // 3: Write available objects chunk
-    chunkWriter.WriteChunk(_s6.objects, sizeof(_s6.objects), SAWYER_ENCODING::ROTATE);
+    chunks.push_back({ _s6.objects, sizeof(_s6.objects), SAWYER_ENCODING::ROTATE });
 
     // 4: Misc fields (data, rand...) chunk
-    chunkWriter.WriteChunk(&_s6.elapsed_months, 16, SAWYER_ENCODING::RLECOMPRESSED);
+    chunks.push_back({ &_s6.elapsed_months, 16, encoding });
 
     // 5: Map elements + sprites and other fields chunk
-    chunkWriter.WriteChunk(&_s6.tile_elements, 0x180000, SAWYER_ENCODING::RLECOMPRESSED);
+    {
+        // The tile elements past the ones in use are padded back with zeroes when loaded, RCT2 does not pad them
+        // so they can only be left out when compressing.
+        size_t tileElementsLength = sizeof(_s6.tile_elements);
+        if (CompressChunks && !RawChunks)
+        {
+            tileElementsLength = std::max<size_t>(_numTileElements, 1) * sizeof(RCT12TileElement);
+        }
+        chunks.push_back({ &_s6.tile_elements, tileElementsLength, encoding });
+    }
 
     if (_s6.header.type == S6_TYPE_SCENARIO)
     {
         // 6 to 13:
-        chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x27104C, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.guests_in_park, 4, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.last_guests_in_park, 8, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.park_rating, 2, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.active_research_types, 1082, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.current_expenditure, 16, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.park_value, 4, SAWYER_ENCODING::RLECOMPRESSED);
-        chunkWriter.WriteChunk(&_s6.completed_company_value, 0x761E8, SAWYER_ENCODING::RLECOMPRESSED);
+        chunks.push_back({ &_s6.next_free_tile_element_pointer_index, 0x27104C, encoding });
+        chunks.push_back({ &_s6.guests_in_park, 4, encoding });
+        chunks.push_back({ &_s6.last_guests_in_park, 8, encoding });
+        chunks.push_back({ &_s6.park_rating, 2, encoding });
+        chunks.push_back({ &_s6.active_research_types, 1082, encoding });
+        chunks.push_back({ &_s6.current_expenditure, 16, encoding });
+        chunks.push_back({ &_s6.park_value, 4, encoding });
+        chunks.push_back({ &_s6.completed_company_value, 0x761E8, encoding });
     }
     else
     {
         // 6: Everything else...
-        chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
+        chunks.push_back({ &_s6.next_free_tile_element_pointer_index, 0x2E8570, encoding });
     }
 
-    // Determine number of bytes written
-    size_t fileSize = stream->GetLength();
-
-    // Read all written bytes back into a single buffer
-    stream->SetPosition(0);
-    auto data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-        stream->ReadArray<uint8_t>(fileSize), Memory::Free<uint8_t>);
-    uint32_t checksum = sawyercoding_calculate_checksum(data.get(), fileSize);
-
-    // Write the checksum on the end
-    stream->SetPosition(fileSize);
-    stream->WriteValue(checksum);
+    // 7: Entities beyond RCT2_MAX_SPRITES, these are unknown to RCT2 itself
+    _entityPoolBuffer.clear();
+    if (_entityPoolHeader.magic == RCT2_ENTITY_POOL_MAGIC)
+    {
+        size_t extraLength = _extraSprites.size() * sizeof(RCT2Sprite);
+        _entityPoolBuffer.resize(sizeof(_entityPoolHeader) + extraLength);
+        std::memcpy(_entityPoolBuffer.data(), &_entityPoolHeader, sizeof(_entityPoolHeader));
+        if (extraLength != 0)
+        {
+            std::memcpy(_entityPoolBuffer.data() + sizeof(_entityPoolHeader), _extraSprites.data(), extraLength);
+        }
+        chunks.push_back({ _entityPoolBuffer.data(), _entityPoolBuffer.size(), encoding });
+    }
+    return chunks;
 }
 
 void S6Exporter::Export()
 {
+    PROFILE_ZONE("S6Exporter::Export");
     int32_t regular_cycle = check_for_sprite_list_cycles(false);
     int32_t disjoint_sprites_count = fix_disjoint_sprites();
     openrct2_assert(regular_cycle == -1, "Sprite cycle exists in regular list %d", regular_cycle);
@@ -194,8 +267,6 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = state.s0;
     _s6.scenario_srand_1 = state.s1;
 
-    // Map elements must be reorganised prior to saving otherwise save may be invalid
-    map_reorganise_elements();
     ExportTileElements();
     ExportSprites();
     ExportParkName();
@@ -952,6 +1023,21 @@ void S6Exporter::ExportSprites()
         ExportSprite(&_s6.sprites[i], reinterpret_cast<const rct_sprite*>(GetEntity(i)));
     }
 
+    _entityPoolHeader = {};
+    _extraSprites.clear();
+    auto capacity = GetEntityCapacity();
+    if (capacity > RCT2_MAX_SPRITES || GetMaxEntities() != RCT2_MAX_SPRITES)
+    {
+        _entityPoolHeader.magic = RCT2_ENTITY_POOL_MAGIC;
+        _entityPoolHeader.capacity = static_cast<uint16_t>(std::max<size_t>(capacity, RCT2_MAX_SPRITES));
+        _entityPoolHeader.max_entities = static_cast<uint16_t>(GetMaxEntities());
+        for (size_t i = RCT2_MAX_SPRITES; i < capacity; i++)
+        {
+            _extraSprites.emplace_back();
+            ExportSprite(&_extraSprites.back(), reinterpret_cast<const rct_sprite*>(GetEntity(i)));
+        }
+    }
+
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
     {
         _s6.sprite_lists_head[i] = gSpriteListHead[i];
@@ -961,7 +1047,7 @@ void S6Exporter::ExportSprites()
 
 void S6Exporter::ExportSprite(RCT2Sprite* dst, const rct_sprite* src)
 {
-    std::memset(dst, 0, sizeof(rct_sprite));
+    std::memset(dst, 0, sizeof(RCT2Sprite));
     switch (src->generic.sprite_identifier)
     {
         case SPRITE_IDENTIFIER_NULL:
@@ -1413,9 +1499,13 @@ void S6Exporter::ExportMapAnimations()
 
 void S6Exporter::ExportTileElements()
 {
+    // Saves have the tiles one after another, which the map is only in right after reorganising it. Gathering them
+    // in that order here leaves the map as it is in the middle of a game.
+    auto tileElements = std::make_unique<TileElement[]>(RCT2_MAX_TILE_ELEMENTS);
+    _numTileElements = map_copy_elements_in_tile_order(tileElements.get(), RCT2_MAX_TILE_ELEMENTS);
     for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
     {
-        auto src = &gTileElements[index];
+        auto src = &tileElements[index];
         auto dst = &_s6.tile_elements[index];
         if (src->base_height == MAX_ELEMENT_HEIGHT)
         {
@@ -1677,16 +1767,21 @@ enum : uint32_t
 {
     S6_SAVE_FLAG_EXPORT = 1 << 0,
     S6_SAVE_FLAG_SCENARIO = 1 << 1,
+    S6_SAVE_FLAG_COMPRESS_CHUNKS = 1 << 2,
+    S6_SAVE_FLAG_DELTA = 1 << 3,
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
 /**
  *
  *  rct2: 0x006754F5
- * @param flags bit 0: pack objects, 1: save as scenario
+ * @param flags bit 0: pack objects, 1: save as scenario, 2: compress the chunks with zlib
  */
 int32_t scenario_save(const utf8* path, int32_t flags)
 {
+    // Do not let a manual save and the autosave write at the same time.
+    scenario_autosave_wait();
+
     if (flags & S6_SAVE_FLAG_SCENARIO)
     {
         log_verbose("scenario_save(%s, SCENARIO)", path);
@@ -1701,7 +1796,6 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         window_close_construction_windows();
     }
 
-    map_reorganise_elements();
     viewport_set_saved_view();
 
     bool result = false;
@@ -1714,6 +1808,7 @@ int32_t scenario_save(const utf8* path, int32_t flags)
             s6exporter->ExportObjectsList = objManager.GetPackableObjects();
         }
         s6exporter->RemoveTracklessRides = true;
+        s6exporter->CompressChunks = (flags & S6_SAVE_FLAG_COMPRESS_CHUNKS) != 0;
         s6exporter->Export();
         if (flags & S6_SAVE_FLAG_SCENARIO)
         {
@@ -1739,3 +1834,92 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     }
     return result;
 }
+
+static std::future<void> _autosaveFuture;
+// Only used by the autosave task, of which there is only ever one at a time
+static S6DeltaWriter _autosaveDeltaWriter;
+
+bool scenario_autosave_is_in_progress()
+{
+    return _autosaveFuture.valid() && _autosaveFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void scenario_autosave_wait()
+{
+    if (_autosaveFuture.valid())
+    {
+        hitch_tracker_note(HitchEvent::Autosave);
+        _autosaveFuture.wait();
+        _autosaveFuture = {};
+    }
+}
+
+/**
+ * Exports the park on the calling thread and leaves the encoding and writing of the file to a background thread, so
+ * the game does not stall while the autosave is written. Only one autosave is written at a time.
+ * @param backupPath The existing file at path is copied here before it is overwritten.
+ * @param flags bit 3: save a delta of the last full autosave instead when possible (saved games only), see S6DeltaWriter
+ */
+bool scenario_autosave(const utf8* path, const utf8* backupPath, int32_t flags)
+{
+    if (scenario_autosave_is_in_progress())
+    {
+        return false;
+    }
+    scenario_autosave_wait();
+    hitch_tracker_note(HitchEvent::Autosave);
+
+    viewport_set_saved_view();
+
+    auto s6exporter = std::make_unique<S6Exporter>();
+    try
+    {
+        s6exporter->RemoveTracklessRides = true;
+        s6exporter->CompressChunks = (flags & S6_SAVE_FLAG_COMPRESS_CHUNKS) != 0;
+        s6exporter->Export();
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+        return false;
+    }
+
+    gfx_invalidate_screen();
+
+    // The exporter holds a copy of everything that is saved, the game can carry on while it is written.
+    const bool isScenario = (flags & S6_SAVE_FLAG_SCENARIO) != 0;
+    const int32_t maxDeltas = (flags & S6_SAVE_FLAG_DELTA) && !isScenario ? gConfigGeneral.autosave_deltas : 0;
+    _autosaveFuture = std::async(
+        std::launch::async, [s6exporter = std::move(s6exporter), path = std::string(path),
+                             backupPath = std::string(backupPath), isScenario, maxDeltas]() {
+            PROFILE_ZONE("Autosave");
+            try
+            {
+                if (Platform::FileExists(path))
+                {
+                    platform_file_copy(path.c_str(), backupPath.c_str(), true);
+                }
+                if (isScenario)
+                {
+                    s6exporter->SaveScenario(path.c_str());
+                    log_verbose("Autosaved to '%s'", path.c_str());
+                }
+                else if (maxDeltas > 0)
+                {
+                    auto savedPath = _autosaveDeltaWriter.Save(*s6exporter, path, maxDeltas);
+                    log_verbose("Autosaved to '%s'", savedPath.c_str());
+                }
+                else
+                {
+                    s6exporter->SaveGame(path.c_str());
+                    log_verbose("Autosaved to '%s'", path.c_str());
+                }
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to save park: '%s'", e.what());
+                std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+            }
+        });
+    return true;
+}
@@ -11,6 +11,7 @@
 
 #include "../common.h"
 #include "../object/ObjectList.h"
+#include "../rct12/SawyerChunkWriter.h"
 #include "../scenario/Scenario.h"
 
 #include <optional>
@@ -34,6 +35,12 @@ class S6Exporter final
 {
 public:
     bool RemoveTracklessRides;
+    // Compresses the chunks after the object list with zlib and leaves out the unused tile elements. Such a file can only
+    // be loaded by OpenRCT2, but is a lot quicker to write than the RLE encoding RCT2 uses.
+    bool CompressChunks;
+    // Writes the chunks after the object list without any encoding, so the same game state always gives the same bytes at
+    // the same offsets. Used to find which parts of a map differ between the server and a desynchronised client.
+    bool RawChunks;
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
 
     S6Exporter();
@@ -54,11 +61,30 @@ public:
     void ExportSpriteMisc(RCT12SpriteBase* dst, const SpriteBase* src);
     void ExportSpriteLitter(RCT12SpriteLitter* dst, const Litter* src);
 
+    /**
+     * Returns the chunks of an exported saved game that follow its header and packed objects, the way SaveGame
+     * writes them. They point into the exporter and remain valid until it is used again.
+     */
+    std::vector<SawyerChunkWriter::ChunkSource> GetSavedGameChunks();
+
+    // Length of the chunks written by the last save before they were encoded
+    size_t GetChunksLength() const
+    {
+        return _chunksLength;
+    }
+
 private:
     rct_s6_data _s6{};
+    RCT2EntityPoolHeader _entityPoolHeader{};
+    size_t _numTileElements = 0;
+    size_t _chunksLength = 0;
+    std::vector<RCT2Sprite> _extraSprites;
+    std::vector<uint8_t> _entityPoolBuffer;
     std::vector<std::string> _userStrings;
 
     void Save(OpenRCT2::IStream* stream, bool isScenario);
+    void SetHeader(bool isScenario);
+    std::vector<SawyerChunkWriter::ChunkSource> GetChunks();
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
     void ExportResearchedRideTypes();
     void ExportResearchedRideEntries();
@@ -13,10 +13,11 @@
 #include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
+#include "../Profiling.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
-#include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Path.hpp"
 #include "../core/Random.hpp"
 #include "../core/String.hpp"
@@ -54,6 +55,7 @@
 #include "../world/Surface.h"
 
 #include <algorithm>
+#include <iterator>
 
 /**
  * Class to import RollerCoaster Tycoon 2 scenarios (*.SC6) and saved games (*.SV6).
@@ -65,6 +67,8 @@ private:
 
     const utf8* _s6Path = nullptr;
     rct_s6_data _s6{};
+    RCT2EntityPoolHeader _entityPoolHeader{};
+    std::vector<RCT2Sprite> _extraSprites;
     uint8_t _gameVersion = 0;
     bool _isSV7 = false;
 
@@ -93,16 +97,16 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, false, skipObjectCheck);
+        auto stream = OpenRCT2::OpenFileForReading(path);
+        auto result = LoadFromStream(stream.get(), false, skipObjectCheck);
         _s6Path = path;
         return result;
     }
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, true, skipObjectCheck);
+        auto stream = OpenRCT2::OpenFileForReading(path);
+        auto result = LoadFromStream(stream.get(), true, skipObjectCheck);
         _s6Path = path;
         return result;
     }
@@ -111,6 +115,7 @@ public:
         OpenRCT2::IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck = false,
         const utf8* path = String::Empty) override
     {
+        PROFILE_ZONE("S6Importer::LoadFromStream");
         if (isScenario && !gConfigGeneral.allow_loading_with_incorrect_checksum && !SawyerEncoding::ValidateChecksum(stream))
         {
             throw IOException("Invalid checksum.");
@@ -156,25 +161,30 @@ public:
 
         if (isScenario)
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 2560076);
-            chunkReader.ReadChunk(&_s6.guests_in_park, 4);
-            chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
-            chunkReader.ReadChunk(&_s6.park_rating, 2);
-            chunkReader.ReadChunk(&_s6.active_research_types, 1082);
-            chunkReader.ReadChunk(&_s6.current_expenditure, 16);
-            chunkReader.ReadChunk(&_s6.park_value, 4);
-            chunkReader.ReadChunk(&_s6.completed_company_value, 483816);
+            chunkReader.ReadChunks({
+                { &_s6.objects, sizeof(_s6.objects) },
+                { &_s6.elapsed_months, 16 },
+                { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                { &_s6.next_free_tile_element_pointer_index, 2560076 },
+                { &_s6.guests_in_park, 4 },
+                { &_s6.last_guests_in_park, 8 },
+                { &_s6.park_rating, 2 },
+                { &_s6.active_research_types, 1082 },
+                { &_s6.current_expenditure, 16 },
+                { &_s6.park_value, 4 },
+                { &_s6.completed_company_value, 483816 },
+            });
         }
         else
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
+            chunkReader.ReadChunks({
+                { &_s6.objects, sizeof(_s6.objects) },
+                { &_s6.elapsed_months, 16 },
+                { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                { &_s6.next_free_tile_element_pointer_index, 3048816 },
+            });
         }
+        ReadEntityPoolChunk(stream, chunkReader);
 
         _s6Path = path;
 
@@ -189,6 +199,7 @@ public:
 
     void Import() override
     {
+        PROFILE_ZONE("S6Importer::Import");
         Initialise();
 
         // _s6.header
@@ -462,6 +473,7 @@ public:
         map_strip_ghost_flag_from_elements();
         map_update_tile_pointers();
         game_convert_strings_to_utf8();
+        park_calculate_size();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
 
@@ -1019,8 +1031,7 @@ public:
     {
         // The number of riders might have overflown or underflown. Re-calculate the value.
         uint16_t numRiders = 0;
-        for (const auto& sprite : _s6.sprites)
-        {
+        auto countRider = [&numRiders, rideIndex](const RCT2Sprite& sprite) {
             if (sprite.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
             {
                 if (sprite.peep.current_ride == rideIndex
@@ -1030,7 +1041,9 @@ public:
                     numRiders++;
                 }
             }
-        }
+        };
+        std::for_each(std::begin(_s6.sprites), std::end(_s6.sprites), countRider);
+        std::for_each(_extraSprites.begin(), _extraSprites.end(), countRider);
         dst->num_riders = numRiders;
     }
 
@@ -1290,22 +1303,84 @@ public:
         }
     }
 
+    /**
+     * Reads the optional chunk holding the entities beyond RCT2_MAX_SPRITES, which follows the regular chunks in
+     * parks saved with a larger entity pool. Only the checksum remains after the last chunk of other files.
+     */
+    void ReadEntityPoolChunk(OpenRCT2::IStream* stream, SawyerChunkReader& chunkReader)
+    {
+        _entityPoolHeader = {};
+        _extraSprites.clear();
+        if (stream->GetPosition() + sizeof(uint32_t) >= stream->GetLength())
+        {
+            return;
+        }
+
+        auto chunk = chunkReader.ReadChunk();
+        if (chunk->GetLength() < sizeof(_entityPoolHeader))
+        {
+            log_warning("Ignoring unknown chunk at the end of the file.");
+            return;
+        }
+        auto data = static_cast<const uint8_t*>(chunk->GetData());
+        std::memcpy(&_entityPoolHeader, data, sizeof(_entityPoolHeader));
+        if (_entityPoolHeader.magic != RCT2_ENTITY_POOL_MAGIC)
+        {
+            log_warning("Ignoring unknown chunk at the end of the file.");
+            _entityPoolHeader = {};
+            return;
+        }
+        if (_entityPoolHeader.capacity < RCT2_MAX_SPRITES)
+        {
+            throw IOException("Invalid entity pool chunk.");
+        }
+
+        size_t numExtraSprites = _entityPoolHeader.capacity - RCT2_MAX_SPRITES;
+        if (chunk->GetLength() < sizeof(_entityPoolHeader) + numExtraSprites * sizeof(RCT2Sprite))
+        {
+            throw IOException("Entity pool chunk is truncated.");
+        }
+        _extraSprites.resize(numExtraSprites);
+        if (numExtraSprites != 0)
+        {
+            std::memcpy(_extraSprites.data(), data + sizeof(_entityPoolHeader), numExtraSprites * sizeof(RCT2Sprite));
+        }
+    }
+
     void ImportSprites()
     {
+        size_t capacity = RCT2_MAX_SPRITES;
+        size_t maxEntities = gConfigGeneral.max_entities;
+        if (_entityPoolHeader.magic == RCT2_ENTITY_POOL_MAGIC)
+        {
+            capacity = _entityPoolHeader.capacity;
+            maxEntities = _entityPoolHeader.max_entities;
+        }
+        else if (network_get_mode() == NETWORK_MODE_CLIENT)
+        {
+            // The server only leaves the chunk out when it uses the default pool itself.
+            maxEntities = RCT2_MAX_SPRITES;
+        }
+        reset_sprite_list(capacity, maxEntities);
+
         for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
         {
             auto src = &_s6.sprites[i];
             auto dst = GetEntity(i);
             ImportSprite(reinterpret_cast<rct_sprite*>(dst), src);
         }
+        for (size_t i = 0; i < _extraSprites.size(); i++)
+        {
+            auto dst = GetEntity(RCT2_MAX_SPRITES + i);
+            ImportSprite(reinterpret_cast<rct_sprite*>(dst), &_extraSprites[i]);
+        }
 
         for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
         {
             gSpriteListHead[i] = _s6.sprite_lists_head[i];
             gSpriteListCount[i] = _s6.sprite_lists_count[i];
         }
-        // This list contains the number of free slots. Increase it according to our own sprite limit.
-        gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] += (MAX_SPRITES - RCT2_MAX_SPRITES);
+        reset_entity_hot_data();
     }
 
     void ImportSprite(rct_sprite* dst, const RCT2Sprite* src)
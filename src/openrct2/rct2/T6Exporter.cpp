@@ -47,7 +47,12 @@ bool T6Exporter::SaveTrack(const utf8* path)
 
 bool T6Exporter::SaveTrack(OpenRCT2::IStream* stream)
 {
+    // The header, the elements and their terminators, so the stream is allocated only once
     OpenRCT2::MemoryStream tempStream;
+    tempStream.Reserve(
+        0xA3 + 4 * (_trackDesign->maze_elements.size() + 1) + 2 * _trackDesign->track_elements.size()
+        + 6 * _trackDesign->entrance_elements.size() + 2
+        + (sizeof(rct_object_entry) + 6) * _trackDesign->scenery_elements.size() + 1);
     tempStream.WriteValue<uint8_t>(_trackDesign->type);
     tempStream.WriteValue<uint8_t>(_trackDesign->vehicle_type);
     tempStream.WriteValue<uint32_t>(_trackDesign->flags);
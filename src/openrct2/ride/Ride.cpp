@@ -46,7 +46,9 @@
 #include "../windows/Intent.h"
 #include "../world/Banner.h"
 #include "../world/Climate.h"
+#include "../world/EntityScheduler.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
@@ -64,6 +66,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <climits>
 #include <cstdlib>
 #include <iterator>
@@ -125,6 +128,21 @@ Direction gRideEntranceExitPlaceDirection;
 
 uint8_t gLastEntranceStyle;
 
+// The mechanics in the order EntityList visits them, so calling a mechanic does not have to go through every guest.
+// Refreshed whenever entities have been added to or removed from the peep list.
+static struct
+{
+    bool Valid;
+    uint32_t Version;
+    std::vector<EntityHandle> Mechanics;
+} _mechanicIndex;
+
+static MechanicDispatchStats _mechanicDispatchCurrent;
+static MechanicDispatchStats _mechanicDispatchLast;
+
+static RideUpdateStats _rideUpdateCurrent;
+static RideUpdateStats _rideUpdateLast;
+
 // Static function declarations
 Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection);
 static void ride_breakdown_status_update(Ride* ride);
@@ -137,6 +155,7 @@ static void ride_inspection_update(Ride* ride);
 static void ride_mechanic_status_update(Ride* ride, int32_t mechanicStatus);
 static void ride_music_update(Ride* ride);
 static void ride_shop_connected(Ride* ride);
+static void ride_update_stats_roll_over();
 void loc_6DDF9C(Ride* ride, TileElement* tileElement);
 
 RideManager GetRideManager()
@@ -745,6 +764,57 @@ bool track_block_get_previous(const CoordsXYE& trackPos, track_begin_end* outTra
     return track_block_get_previous_from_zero({ coords, z }, ride, rotation, outTrackBeginEnd);
 }
 
+/**
+ * The states a track_circuit_iterator goes through from a start element. Testing or opening a ride runs several
+ * checks along the circuit, which now share a single walk of the track until the map changes.
+ */
+struct TrackCircuitWalk
+{
+    bool Valid;
+    uint32_t Generation;
+    CoordsXYE Start;
+    // The iterator after every successful step.
+    std::vector<track_circuit_iterator> Steps;
+    // Whether the walk ran into a cycle that does not pass through the start, detected the same way the checks did
+    // with a second iterator moving at half the speed. The walk stops at the step the cycle was found.
+    bool Cycled;
+    // The iterator after the step that failed, only set when the walk did not cycle.
+    track_circuit_iterator End;
+};
+static TrackCircuitWalk _trackCircuitWalk;
+
+static const TrackCircuitWalk& track_circuit_walk_get(const CoordsXYE& start)
+{
+    auto& walk = _trackCircuitWalk;
+    auto generation = footpath_node_cache_generation();
+    if (walk.Valid && walk.Generation == generation && walk.Start.x == start.x && walk.Start.y == start.y
+        && walk.Start.element == start.element)
+    {
+        return walk;
+    }
+
+    walk.Valid = true;
+    walk.Generation = generation;
+    walk.Start = start;
+    walk.Steps.clear();
+    walk.Cycled = false;
+
+    track_circuit_iterator it = {};
+    track_circuit_iterator_begin(&it, start);
+    while (track_circuit_iterator_next(&it))
+    {
+        walk.Steps.push_back(it);
+        auto numSteps = walk.Steps.size();
+        if (numSteps % 2 == 0 && track_circuit_iterators_match(&it, &walk.Steps[numSteps / 2 - 1]))
+        {
+            walk.Cycled = true;
+            return walk;
+        }
+    }
+    walk.End = it;
+    return walk;
+}
+
 /**
  *
  * Make sure to pass in the x and y of the start track element too.
@@ -770,32 +840,24 @@ int32_t ride_find_track_gap(const Ride* ride, CoordsXYE* input, CoordsXYE* outpu
         ride_construction_invalidate_current_track();
     }
 
-    bool moveSlowIt = true;
-    track_circuit_iterator it = {};
-    track_circuit_iterator_begin(&it, *input);
-    track_circuit_iterator slowIt = it;
-    while (track_circuit_iterator_next(&it))
+    const auto& walk = track_circuit_walk_get(*input);
+    for (const auto& it : walk.Steps)
     {
         if (!track_is_connected_by_shape(it.last.element, it.current.element))
         {
             *output = it.current;
             return 1;
         }
-        //#2081: prevent an infinite loop
-        moveSlowIt = !moveSlowIt;
-        if (moveSlowIt)
-        {
-            track_circuit_iterator_next(&slowIt);
-            if (track_circuit_iterators_match(&it, &slowIt))
-            {
-                *output = it.current;
-                return 1;
-            }
-        }
     }
-    if (!it.looped)
+    //#2081: prevent an infinite loop
+    if (walk.Cycled)
+    {
+        *output = walk.Steps.back().current;
+        return 1;
+    }
+    if (!walk.End.looped)
     {
-        *output = it.last;
+        *output = walk.End.last;
         return 1;
     }
 
@@ -1067,6 +1129,7 @@ static void ride_remove_vehicles(Ride* ride)
 void ride_clear_for_construction(Ride* ride)
 {
     ride->measurement = {};
+    ride->measurement_recorder = {};
 
     ride->lifecycle_flags &= ~(RIDE_LIFECYCLE_BREAKDOWN_PENDING | RIDE_LIFECYCLE_BROKEN_DOWN);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_MAIN | RIDE_INVALIDATE_RIDE_LIST;
@@ -1977,13 +2040,81 @@ void Ride::UpdateAll()
 
     window_update_viewport_ride_music();
 
+    ride_update_stats_roll_over();
+    bool profiling = entity_scheduler_is_profiling();
+
     // Update rides
     for (auto& ride : GetRideManager())
-        ride.Update();
+    {
+        auto activity = static_cast<size_t>(ride_get_activity(ride));
+        _rideUpdateCurrent.Rides[activity]++;
+        if (profiling)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+            ride.Update();
+            auto elapsed = std::chrono::steady_clock::now() - startTime;
+            _rideUpdateCurrent.Nanoseconds[activity] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        }
+        else
+        {
+            ride.Update();
+        }
+    }
 
     ride_music_update_final();
 }
 
+RideActivity ride_get_activity(const Ride& ride)
+{
+    if (ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED))
+        return RideActivity::Broken;
+    if (ride.status == RIDE_STATUS_CLOSED && ride.num_riders == 0)
+        return RideActivity::Closed;
+    // Testing and simulating rides run their trains without guests.
+    if (ride.status == RIDE_STATUS_OPEN && ride.num_riders == 0)
+        return RideActivity::OpenIdle;
+    return RideActivity::Operating;
+}
+
+const char* ride_get_activity_name(RideActivity activity)
+{
+    switch (activity)
+    {
+        case RideActivity::Closed:
+            return "closed";
+        case RideActivity::OpenIdle:
+            return "idle";
+        case RideActivity::Operating:
+            return "running";
+        case RideActivity::Broken:
+            return "broken";
+        default:
+            return "";
+    }
+}
+
+static void ride_update_stats_roll_over()
+{
+    if (_rideUpdateCurrent.Tick != gCurrentTicks)
+    {
+        _rideUpdateLast = _rideUpdateCurrent;
+        _rideUpdateCurrent = {};
+        _rideUpdateCurrent.Tick = gCurrentTicks;
+    }
+}
+
+RideUpdateStats ride_get_update_stats()
+{
+    ride_update_stats_roll_over();
+    if (_rideUpdateLast.Tick != gCurrentTicks - 1)
+    {
+        RideUpdateStats stats{};
+        stats.Tick = gCurrentTicks - 1;
+        return stats;
+    }
+    return _rideUpdateLast;
+}
+
 std::unique_ptr<TrackDesign> Ride::SaveToTrackDesign() const
 {
     if (!(lifecycle_flags & RIDE_LIFECYCLE_TESTED))
@@ -2022,8 +2153,15 @@ void Ride::Update()
 
     // Update stations
     if (type != RIDE_TYPE_MAZE)
+    {
         for (int32_t i = 0; i < MAX_STATIONS; i++)
-            ride_update_station(this, i);
+        {
+            if (ride_update_station(this, i))
+                _rideUpdateCurrent.StationsUpdated++;
+            else
+                _rideUpdateCurrent.StationsSkipped++;
+        }
+    }
 
     // Update financial statistics
     num_customers_timeout++;
@@ -2690,16 +2828,70 @@ Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection)
  *  rct2: 0x006B774B (forInspection = 0)
  *  rct2: 0x006B78C3 (forInspection = 1)
  */
+static const std::vector<EntityHandle>& mechanic_index_get()
+{
+    auto version = GetEntityListVersion(EntityListId::Peep);
+    if (!_mechanicIndex.Valid || _mechanicIndex.Version != version)
+    {
+        _mechanicIndex.Mechanics.clear();
+        for (auto staff : EntityList<Staff>(EntityListId::Peep))
+        {
+            if (staff->AssignedStaffType == StaffType::Mechanic)
+            {
+                _mechanicIndex.Mechanics.push_back(GetEntityHandle(staff));
+            }
+        }
+        _mechanicIndex.Version = version;
+        _mechanicIndex.Valid = true;
+    }
+    return _mechanicIndex.Mechanics;
+}
+
+static void mechanic_dispatch_stats_roll_over()
+{
+    if (_mechanicDispatchCurrent.Tick != gCurrentTicks)
+    {
+        _mechanicDispatchLast = _mechanicDispatchCurrent;
+        _mechanicDispatchCurrent = {};
+        _mechanicDispatchCurrent.Tick = gCurrentTicks;
+    }
+}
+
+MechanicDispatchStats ride_get_mechanic_dispatch_stats()
+{
+    mechanic_dispatch_stats_roll_over();
+    if (_mechanicDispatchLast.Tick != gCurrentTicks - 1)
+    {
+        MechanicDispatchStats stats{};
+        stats.Tick = gCurrentTicks - 1;
+        return stats;
+    }
+    return _mechanicDispatchLast;
+}
+
 Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection)
 {
+    mechanic_dispatch_stats_roll_over();
+    _mechanicDispatchCurrent.Calls++;
+
+    bool profiling = entity_scheduler_is_profiling();
+    std::chrono::steady_clock::time_point startTime;
+    if (profiling)
+    {
+        startTime = std::chrono::steady_clock::now();
+    }
+
     Peep* closestMechanic = nullptr;
     uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
 
-    for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    for (const auto& handle : mechanic_index_get())
     {
-        if (peep->AssignedStaffType != StaffType::Mechanic)
+        auto peep = GetEntity<Staff>(handle);
+        if (peep == nullptr)
             continue;
 
+        _mechanicDispatchCurrent.MechanicsChecked++;
+
         if (!forInspection)
         {
             if (peep->State == PeepState::HeadingToInspection)
@@ -2736,6 +2928,11 @@ Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspect
         }
     }
 
+    if (profiling)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        _mechanicDispatchCurrent.Nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
     return closestMechanic;
 }
 
@@ -2856,6 +3053,19 @@ static void ride_music_update(Ride* ride)
  *
  *  rct2: 0x006B64F2
  */
+/**
+ * Whether the vehicle is stopped at a point the measurements pause at, so that waiting does not fill the graphs.
+ */
+static bool ride_measurement_is_vehicle_held(const Vehicle& vehicle)
+{
+    uint8_t trackType = (vehicle.GetTrackType()) & 0xFF;
+    if (trackType == TrackElemType::BlockBrakes || trackType == TrackElemType::CableLiftHill
+        || trackType == TrackElemType::Up25ToFlat || trackType == TrackElemType::Up60ToFlat
+        || trackType == TrackElemType::DiagUp25ToFlat || trackType == TrackElemType::DiagUp60ToFlat)
+        return vehicle.velocity == 0;
+    return false;
+}
+
 static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
 {
     if (measurement.vehicle_index >= std::size(ride.vehicles))
@@ -2881,12 +3091,8 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
         return;
     }
 
-    uint8_t trackType = (vehicle->GetTrackType()) & 0xFF;
-    if (trackType == TrackElemType::BlockBrakes || trackType == TrackElemType::CableLiftHill
-        || trackType == TrackElemType::Up25ToFlat || trackType == TrackElemType::Up60ToFlat
-        || trackType == TrackElemType::DiagUp25ToFlat || trackType == TrackElemType::DiagUp60ToFlat)
-        if (vehicle->velocity == 0)
-            return;
+    if (ride_measurement_is_vehicle_held(*vehicle))
+        return;
 
     if (measurement.current_item >= RideMeasurement::MAX_ITEMS)
         return;
@@ -2971,6 +3177,120 @@ void ride_measurements_update()
     }
 }
 
+void RideMeasurementRecorder::Push(const RideMeasurementSample& sample)
+{
+    _recent[_recentHead] = sample;
+    _recentHead = (_recentHead + 1) % RecentCapacity;
+    _recentCount = std::min(_recentCount + 1, RecentCapacity);
+    _numSamples++;
+
+    _historySum[0] += sample.Velocity;
+    _historySum[1] += sample.Altitude;
+    _historySum[2] += sample.Vertical;
+    _historySum[3] += sample.Lateral;
+    if (++_historySumCount == HistoryInterval)
+    {
+        const auto count = static_cast<int32_t>(HistoryInterval);
+        auto& dst = _history[_historyHead];
+        dst.Velocity = static_cast<uint8_t>(_historySum[0] / count);
+        dst.Altitude = static_cast<uint8_t>(_historySum[1] / count);
+        dst.Vertical = static_cast<int8_t>(_historySum[2] / count);
+        dst.Lateral = static_cast<int8_t>(_historySum[3] / count);
+        _historyHead = (_historyHead + 1) % HistoryCapacity;
+        _historyCount = std::min(_historyCount + 1, HistoryCapacity);
+        std::fill(std::begin(_historySum), std::end(_historySum), 0);
+        _historySumCount = 0;
+    }
+}
+
+template<size_t TCapacity>
+static std::vector<RideMeasurementSample> ride_measurement_recorder_unroll(
+    const std::array<RideMeasurementSample, TCapacity>& ring, size_t head, size_t count)
+{
+    std::vector<RideMeasurementSample> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        result.push_back(ring[(head + TCapacity - count + i) % TCapacity]);
+    }
+    return result;
+}
+
+std::vector<RideMeasurementSample> RideMeasurementRecorder::GetRecent() const
+{
+    return ride_measurement_recorder_unroll(_recent, _recentHead, _recentCount);
+}
+
+std::vector<RideMeasurementSample> RideMeasurementRecorder::GetHistory() const
+{
+    return ride_measurement_recorder_unroll(_history, _historyHead, _historyCount);
+}
+
+/**
+ * Called by the head of every train as it updates. Only the train being followed records anything, so this costs a few
+ * comparisons for the other trains and nothing for rides without data logging.
+ */
+void ride_measurement_recorder_update(Ride& ride, const Vehicle& vehicle)
+{
+    if (!(ride.lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK) || ride.status == RIDE_STATUS_SIMULATING)
+        return;
+
+    auto recorder = ride.measurement_recorder.get();
+    if (recorder == nullptr || recorder->VehicleIndex != vehicle.sprite_index || !recorder->Running)
+    {
+        if (vehicle.status != Vehicle::Status::Departing && vehicle.status != Vehicle::Status::TravellingCableLift)
+            return;
+
+        // Keep following the current train unless it has stopped updating, such as when it was removed.
+        if (recorder != nullptr && recorder->Running && recorder->VehicleIndex != vehicle.sprite_index
+            && gScenarioTicks - recorder->LastUpdateTick <= 1)
+            return;
+
+        if (recorder == nullptr)
+        {
+            if (!ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_HAS_DATA_LOGGING))
+                return;
+
+            ride.measurement_recorder = std::make_unique<RideMeasurementRecorder>();
+            recorder = ride.measurement_recorder.get();
+        }
+        recorder->VehicleIndex = vehicle.sprite_index;
+        recorder->Running = true;
+    }
+    recorder->LastUpdateTick = gScenarioTicks;
+
+    if (vehicle.status == Vehicle::Status::UnloadingPassengers)
+    {
+        recorder->Running = false;
+        return;
+    }
+    if (ride_measurement_is_vehicle_held(vehicle))
+        return;
+
+    RideMeasurementSample sample;
+    if (ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_HAS_G_FORCES))
+    {
+        auto gForces = vehicle.GetGForces();
+        sample.Vertical = static_cast<int8_t>(std::clamp(gForces.VerticalG / 8, -127, 127));
+        sample.Lateral = static_cast<int8_t>(std::clamp(gForces.LateralG / 8, -127, 127));
+    }
+    sample.Velocity = static_cast<uint8_t>(std::min(std::abs((vehicle.velocity * 5) >> 16), 255));
+    sample.Altitude = static_cast<uint8_t>(std::min(vehicle.z / 8, 255));
+
+    // Averages each pair of ticks into one sample, the same as the ride window graphs.
+    if (gScenarioTicks % RideMeasurementRecorder::TicksPerSample == 0)
+    {
+        recorder->Pending = sample;
+        return;
+    }
+    const auto& pending = recorder->Pending;
+    sample.Velocity = static_cast<uint8_t>((sample.Velocity + pending.Velocity) / 2);
+    sample.Altitude = static_cast<uint8_t>((sample.Altitude + pending.Altitude) / 2);
+    sample.Vertical = static_cast<int8_t>((sample.Vertical + pending.Vertical) / 2);
+    sample.Lateral = static_cast<int8_t>((sample.Lateral + pending.Lateral) / 2);
+    recorder->Push(sample);
+}
+
 /**
  * If there are more than the threshold of allowed ride measurements, free the non-LRU one.
  */
@@ -3914,7 +4234,6 @@ static void sub_6B5952(Ride* ride)
 static int32_t ride_check_block_brakes(CoordsXYE* input, CoordsXYE* output)
 {
     rct_window* w;
-    track_circuit_iterator it;
     int32_t type;
 
     ride_id_t rideIndex = input->element->AsTrack()->GetRideIndex();
@@ -3922,8 +4241,8 @@ static int32_t ride_check_block_brakes(CoordsXYE* input, CoordsXYE* output)
     if (w != nullptr && _rideConstructionState != RIDE_CONSTRUCTION_STATE_0 && _currentRideIndex == rideIndex)
         ride_construction_invalidate_current_track();
 
-    track_circuit_iterator_begin(&it, *input);
-    while (track_circuit_iterator_next(&it))
+    const auto& walk = track_circuit_walk_get(*input);
+    for (const auto& it : walk.Steps)
     {
         if (it.current.element->AsTrack()->GetTrackType() == TrackElemType::BlockBrakes)
         {
@@ -3949,11 +4268,12 @@ static int32_t ride_check_block_brakes(CoordsXYE* input, CoordsXYE* output)
             }
         }
     }
-    if (!it.looped)
+    // A track that cycles without passing the start is never a complete circuit.
+    if (walk.Cycled || !walk.End.looped)
     {
         // Not sure why this is the case...
         gGameCommandErrorText = STR_BLOCK_BRAKES_CANNOT_BE_USED_DIRECTLY_AFTER_STATION;
-        *output = it.last;
+        *output = walk.Cycled ? walk.Steps.back().last : walk.End.last;
         return 0;
     }
 
@@ -3987,12 +4307,7 @@ static bool ride_check_track_contains_inversions(CoordsXYE* input, CoordsXYE* ou
         ride_construction_invalidate_current_track();
     }
 
-    bool moveSlowIt = true;
-    track_circuit_iterator it, slowIt;
-    track_circuit_iterator_begin(&it, *input);
-    slowIt = it;
-
-    while (track_circuit_iterator_next(&it))
+    for (const auto& it : track_circuit_walk_get(*input).Steps)
     {
         int32_t trackType = it.current.element->AsTrack()->GetTrackType();
         if (TrackFlags[trackType] & TRACK_ELEM_FLAG_INVERSION_TO_NORMAL)
@@ -4000,17 +4315,6 @@ static bool ride_check_track_contains_inversions(CoordsXYE* input, CoordsXYE* ou
             *output = it.current;
             return true;
         }
-
-        // Prevents infinite loops
-        moveSlowIt = !moveSlowIt;
-        if (moveSlowIt)
-        {
-            track_circuit_iterator_next(&slowIt);
-            if (track_circuit_iterators_match(&it, &slowIt))
-            {
-                return false;
-            }
-        }
     }
     return false;
 }
@@ -4045,12 +4349,7 @@ static bool ride_check_track_contains_banked(CoordsXYE* input, CoordsXYE* output
         ride_construction_invalidate_current_track();
     }
 
-    bool moveSlowIt = true;
-    track_circuit_iterator it, slowIt;
-    track_circuit_iterator_begin(&it, *input);
-    slowIt = it;
-
-    while (track_circuit_iterator_next(&it))
+    for (const auto& it : track_circuit_walk_get(*input).Steps)
     {
         int32_t trackType = output->element->AsTrack()->GetTrackType();
         if (TrackFlags[trackType] & TRACK_ELEM_FLAG_BANKED)
@@ -4058,17 +4357,6 @@ static bool ride_check_track_contains_banked(CoordsXYE* input, CoordsXYE* output
             *output = it.current;
             return true;
         }
-
-        // Prevents infinite loops
-        moveSlowIt = !moveSlowIt;
-        if (moveSlowIt)
-        {
-            track_circuit_iterator_next(&slowIt);
-            if (track_circuit_iterators_match(&it, &slowIt))
-            {
-                return false;
-            }
-        }
     }
     return false;
 }
@@ -6319,6 +6607,7 @@ bool ride_are_all_possible_entrances_and_exits_built(Ride* ride)
 void invalidate_test_results(Ride* ride)
 {
     ride->measurement = {};
+    ride->measurement_recorder = {};
     ride->excitement = RIDE_RATING_UNDEFINED;
     ride->lifecycle_flags &= ~RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags &= ~RIDE_LIFECYCLE_TEST_IN_PROGRESS;
@@ -7120,6 +7409,7 @@ void Ride::Delete()
 {
     custom_name = {};
     measurement = {};
+    measurement_recorder = {};
     type = RIDE_TYPE_NULL;
 }
 
@@ -19,8 +19,10 @@
 #include "RideTypes.h"
 #include "Vehicle.h"
 
+#include <array>
 #include <limits>
 #include <string_view>
+#include <vector>
 
 struct IObjectManager;
 class Formatter;
@@ -182,6 +184,61 @@ struct RideMeasurement
     uint8_t altitude[MAX_ITEMS]{};
 };
 
+/**
+ * One point of a ride measurement, in the same units as the graphs of the ride window.
+ */
+struct RideMeasurementSample
+{
+    uint8_t Velocity{};
+    uint8_t Altitude{};
+    int8_t Vertical{};
+    int8_t Lateral{};
+};
+
+/**
+ * Records the measurements of a ride whether or not its window is open, fed from the update of the head of the train
+ * being followed. Keeps the latest samples in a ring, along with a longer history where each sample is the average of
+ * HistoryInterval recent ones. Not part of the game state, recording starts again when the park is loaded.
+ */
+class RideMeasurementRecorder
+{
+public:
+    // A sample is recorded every other tick, like the ride window graphs.
+    static constexpr uint32_t TicksPerSample = 2;
+    static constexpr size_t RecentCapacity = 512;
+    static constexpr size_t HistoryCapacity = 256;
+    static constexpr size_t HistoryInterval = 32;
+
+    // The head of the train being recorded
+    uint16_t VehicleIndex{};
+    uint32_t LastUpdateTick{};
+    // Cleared while the train unloads, another train leaving the station can then be followed instead
+    bool Running{};
+    RideMeasurementSample Pending{};
+
+    void Push(const RideMeasurementSample& sample);
+
+    // The samples are returned oldest first.
+    std::vector<RideMeasurementSample> GetRecent() const;
+    std::vector<RideMeasurementSample> GetHistory() const;
+    uint32_t GetNumSamples() const
+    {
+        return _numSamples;
+    }
+
+private:
+    std::array<RideMeasurementSample, RecentCapacity> _recent{};
+    std::array<RideMeasurementSample, HistoryCapacity> _history{};
+    size_t _recentHead{};
+    size_t _recentCount{};
+    size_t _historyHead{};
+    size_t _historyCount{};
+    // Sums of the samples since the last history sample
+    int32_t _historySum[4]{};
+    size_t _historySumCount{};
+    uint32_t _numSamples{};
+};
+
 enum class RideClassification
 {
     Ride,
@@ -370,6 +427,7 @@ struct Ride
     uint8_t sheltered_eighths;
 
     std::unique_ptr<RideMeasurement> measurement;
+    std::unique_ptr<RideMeasurementRecorder> measurement_recorder;
 
 private:
     void Update();
@@ -1110,8 +1168,46 @@ vehicle_colour ride_get_vehicle_colour(Ride* ride, int32_t vehicleIndex);
 int32_t ride_get_unused_preset_vehicle_colour(uint8_t ride_sub_type);
 void ride_set_vehicle_colours_to_random_preset(Ride* ride, uint8_t preset_index);
 void ride_measurements_update();
+void ride_measurement_recorder_update(Ride& ride, const Vehicle& vehicle);
 void ride_breakdown_add_news_item(Ride* ride);
 Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection);
+
+struct MechanicDispatchStats
+{
+    uint32_t Tick;
+    uint32_t Calls;
+    uint32_t MechanicsChecked;
+    // Only measured while the profiler is running.
+    int64_t Nanoseconds;
+};
+
+// The work spent looking for mechanics to answer breakdowns and do inspections in the last tick.
+MechanicDispatchStats ride_get_mechanic_dispatch_stats();
+
+enum class RideActivity : uint8_t
+{
+    Closed,
+    OpenIdle,
+    Operating,
+    Broken,
+    Count,
+};
+
+RideActivity ride_get_activity(const Ride& ride);
+const char* ride_get_activity_name(RideActivity activity);
+
+struct RideUpdateStats
+{
+    uint32_t Tick;
+    uint32_t Rides[static_cast<size_t>(RideActivity::Count)];
+    uint32_t StationsUpdated;
+    uint32_t StationsSkipped;
+    // Only measured while the profiler is running.
+    int64_t Nanoseconds[static_cast<size_t>(RideActivity::Count)];
+};
+
+// The rides updated in the last tick by activity, with the stations that were skipped as settled.
+RideUpdateStats ride_get_update_stats();
 int32_t ride_is_valid_for_open(Ride* ride, int32_t goingToBeOpen, bool isApplying);
 int32_t ride_is_valid_for_test(Ride* ride, int32_t status, bool isApplying);
 int32_t ride_initialise_construction_window(Ride* ride);
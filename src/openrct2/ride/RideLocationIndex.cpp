@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideLocationIndex.h"
+
+#include "../Game.h"
+#include "../world/FootpathNodeCache.h"
+#include "../world/Map.h"
+#include "Track.h"
+
+#include <algorithm>
+#include <vector>
+
+constexpr int32_t RIDE_LOCATION_CELLS = MAXIMUM_MAP_SIZE_TECHNICAL / RIDE_LOCATION_CELL_TILES;
+
+struct RideLocationEntry
+{
+    uint8_t X;
+    uint8_t Y;
+    ride_id_t Ride;
+};
+
+struct RideLocationCell
+{
+    // Every ride with track in the cell, for when the whole cell is looked up.
+    std::bitset<MAX_RIDES> Rides;
+    // Each ride once for every tile it has track on, for when only part of the cell is looked up.
+    std::vector<RideLocationEntry> Entries;
+};
+
+static std::vector<RideLocationCell> _rideLocationCells(RIDE_LOCATION_CELLS * RIDE_LOCATION_CELLS);
+static uint32_t _rideLocationGeneration = 0;
+
+static std::bitset<MAX_RIDES> _visibleRides;
+static uint32_t _visibleRidesTick = 0;
+static uint32_t _visibleRidesGeneration = 0;
+static bool _visibleRidesValid = false;
+
+// Track is placed and removed by many actions, track designs and the tile inspector, so rather than updating the
+// index everywhere it is rebuilt whenever tile elements have changed.
+static void ride_location_index_rebuild()
+{
+    for (auto& cell : _rideLocationCells)
+    {
+        cell.Rides.reset();
+        cell.Entries.clear();
+    }
+
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            auto* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+
+            auto cellIndex = (y / RIDE_LOCATION_CELL_TILES) * RIDE_LOCATION_CELLS + x / RIDE_LOCATION_CELL_TILES;
+            auto& cell = _rideLocationCells[cellIndex];
+            auto firstEntry = cell.Entries.size();
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
+                    continue;
+
+                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                if (rideIndex >= MAX_RIDES)
+                    continue;
+
+                auto tileEntries = cell.Entries.begin() + firstEntry;
+                if (std::none_of(tileEntries, cell.Entries.end(), [rideIndex](const RideLocationEntry& entry) {
+                        return entry.Ride == rideIndex;
+                    }))
+                {
+                    cell.Entries.push_back({ static_cast<uint8_t>(x), static_cast<uint8_t>(y), rideIndex });
+                    cell.Rides[rideIndex] = true;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+}
+
+void ride_location_index_update()
+{
+    auto generation = footpath_node_cache_generation();
+    if (_rideLocationGeneration != generation)
+    {
+        ride_location_index_rebuild();
+        _rideLocationGeneration = generation;
+    }
+}
+
+void ride_location_index_get_rides(const TileCoordsXY& min, const TileCoordsXY& max, std::bitset<MAX_RIDES>& rides)
+{
+    ride_location_index_update();
+
+    auto minX = std::max(min.x, 0);
+    auto minY = std::max(min.y, 0);
+    auto maxX = std::min(max.x, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    auto maxY = std::min(max.y, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    for (int32_t cellY = minY / RIDE_LOCATION_CELL_TILES; cellY <= maxY / RIDE_LOCATION_CELL_TILES; cellY++)
+    {
+        for (int32_t cellX = minX / RIDE_LOCATION_CELL_TILES; cellX <= maxX / RIDE_LOCATION_CELL_TILES; cellX++)
+        {
+            const auto& cell = _rideLocationCells[cellY * RIDE_LOCATION_CELLS + cellX];
+            auto cellMinX = cellX * RIDE_LOCATION_CELL_TILES;
+            auto cellMinY = cellY * RIDE_LOCATION_CELL_TILES;
+            auto cellMaxX = cellMinX + RIDE_LOCATION_CELL_TILES - 1;
+            auto cellMaxY = cellMinY + RIDE_LOCATION_CELL_TILES - 1;
+            if (cellMinX >= minX && cellMaxX <= maxX && cellMinY >= minY && cellMaxY <= maxY)
+            {
+                rides |= cell.Rides;
+                continue;
+            }
+
+            for (const auto& entry : cell.Entries)
+            {
+                if (entry.X >= minX && entry.X <= maxX && entry.Y >= minY && entry.Y <= maxY)
+                {
+                    rides[entry.Ride] = true;
+                }
+            }
+        }
+    }
+}
+
+const std::bitset<MAX_RIDES>& ride_get_visible_from_anywhere()
+{
+    // The ratings and drop heights change during the ride and vehicle updates, after the guests have been updated.
+    auto generation = footpath_node_cache_generation();
+    if (!_visibleRidesValid || _visibleRidesTick != gCurrentTicks || _visibleRidesGeneration != generation)
+    {
+        _visibleRides.reset();
+        for (auto& ride : GetRideManager())
+        {
+            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+            {
+                _visibleRides[ride.id] = true;
+            }
+        }
+        _visibleRidesTick = gCurrentTicks;
+        _visibleRidesGeneration = generation;
+        _visibleRidesValid = true;
+    }
+    return _visibleRides;
+}
+
+void ride_visible_from_anywhere_invalidate()
+{
+    _visibleRidesValid = false;
+}
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "Ride.h"
+
+#include <bitset>
+
+// The ride location index groups the tiles of the map in square cells of this size.
+constexpr int32_t RIDE_LOCATION_CELL_TILES = 8;
+
+/**
+ * Adds every ride with a track piece (ghosts included) on a tile between min and max inclusive to rides, equivalent to
+ * looking through the elements of all those tiles. The index is rebuilt on demand after the map has changed.
+ */
+void ride_location_index_get_rides(const TileCoordsXY& min, const TileCoordsXY& max, std::bitset<MAX_RIDES>& rides);
+
+// Rebuilds the index if the map has changed, after which it can be looked up from multiple threads at once.
+void ride_location_index_update();
+
+/**
+ * The rides guests can see from anywhere in the park, those with a high drop or excitement rating. Recomputed at most
+ * once a tick, or after ride_visible_from_anywhere_invalidate.
+ */
+const std::bitset<MAX_RIDES>& ride_get_visible_from_anywhere();
+void ride_visible_from_anywhere_invalidate();
@@ -16,6 +16,7 @@
 #include "../localisation/Date.h"
 #include "../scripting/ScriptEngine.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Map.h"
 #include "../world/Surface.h"
 #include "Ride.h"
@@ -25,6 +26,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
@@ -120,7 +122,28 @@ void ride_ratings_update_all()
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
-    ride_ratings_update_state();
+    if (gCheatsRideRatingsPerTick == 0)
+    {
+        ride_ratings_update_state();
+        return;
+    }
+
+    // Rate whole rides, carrying on with the ride being rated first. Every ride slot is looked at no more than once
+    // while searching for the next ride, so a park without rides to rate does not loop.
+    for (int32_t i = 0; i < gCheatsRideRatingsPerTick; i++)
+    {
+        for (int32_t slot = 0; slot <= MAX_RIDES && gRideRatingsCalcData.State == RIDE_RATINGS_STATE_FIND_NEXT_RIDE; slot++)
+        {
+            ride_ratings_update_state();
+        }
+        if (gRideRatingsCalcData.State == RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+            break;
+
+        while (gRideRatingsCalcData.State != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+        {
+            ride_ratings_update_state();
+        }
+    }
 }
 
 static void ride_ratings_update_state()
@@ -535,17 +558,11 @@ static void ride_ratings_score_close_proximity_loops(TileElement* inputTileEleme
  *
  *  rct2: 0x006B5F9D
  */
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+static bool ride_ratings_score_close_proximity_scan(TileElement* inputTileElement)
 {
-    if (gRideRatingsCalcData.StationFlags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
-    {
-        return;
-    }
-
-    gRideRatingsCalcData.ProximityTotal++;
     TileElement* tileElement = map_get_first_element_at(gRideRatingsCalcData.Proximity);
     if (tileElement == nullptr)
-        return;
+        return false;
     do
     {
         if (tileElement->IsGhost())
@@ -706,6 +723,73 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
     ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction + 1) & 3);
     ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction - 1) & 3);
     ride_ratings_score_close_proximity_loops(inputTileElement);
+    return true;
+}
+
+/**
+ * The proximity scores a track piece adds, remembered until the map changes as the scenery around a ride rarely
+ * changes between two ratings of it. ProximityBaseHeight is carried over from the previous piece when a tile has no
+ * surface, so it is part of the key.
+ */
+struct ProximityCacheEntry
+{
+    CoordsXYZ Location;
+    uint8_t BaseHeightBefore;
+    uint8_t BaseHeightAfter;
+    bool HasTile;
+    uint16_t Scores[PROXIMITY_COUNT];
+};
+static std::unordered_map<const TileElement*, ProximityCacheEntry> _proximityCache;
+static uint32_t _proximityCacheGeneration;
+
+static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+{
+    if (gRideRatingsCalcData.StationFlags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
+    {
+        return;
+    }
+
+    gRideRatingsCalcData.ProximityTotal++;
+
+    auto generation = footpath_node_cache_generation();
+    if (_proximityCacheGeneration != generation)
+    {
+        _proximityCache.clear();
+        _proximityCacheGeneration = generation;
+    }
+
+    auto& scores = gRideRatingsCalcData.ProximityScores;
+    auto it = _proximityCache.find(inputTileElement);
+    if (it != _proximityCache.end() && it->second.Location == gRideRatingsCalcData.Proximity
+        && it->second.BaseHeightBefore == gRideRatingsCalcData.ProximityBaseHeight)
+    {
+        const auto& entry = it->second;
+        for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
+        {
+            scores[i] += entry.Scores[i];
+        }
+        gRideRatingsCalcData.ProximityBaseHeight = entry.BaseHeightAfter;
+        if (!entry.HasTile)
+            return;
+    }
+    else
+    {
+        ProximityCacheEntry entry{};
+        entry.Location = gRideRatingsCalcData.Proximity;
+        entry.BaseHeightBefore = gRideRatingsCalcData.ProximityBaseHeight;
+        std::copy(std::begin(scores), std::end(scores), std::begin(entry.Scores));
+
+        entry.HasTile = ride_ratings_score_close_proximity_scan(inputTileElement);
+
+        for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
+        {
+            entry.Scores[i] = scores[i] - entry.Scores[i];
+        }
+        entry.BaseHeightAfter = gRideRatingsCalcData.ProximityBaseHeight;
+        _proximityCache[inputTileElement] = entry;
+        if (!entry.HasTile)
+            return;
+    }
 
     switch (gRideRatingsCalcData.ProximityTrackType)
     {
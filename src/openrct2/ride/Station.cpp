@@ -11,6 +11,7 @@
 
 #include "../Game.h"
 #include "../scenario/Scenario.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Location.hpp"
 #include "../world/Sprite.h"
 #include "Track.h"
@@ -22,14 +23,63 @@ static void ride_update_station_race(Ride* ride, StationIndex stationIndex);
 static void ride_race_init_vehicle_speeds(Ride* ride);
 static void ride_invalidate_station_start(Ride* ride, StationIndex stationIndex, bool greenLight);
 
+/**
+ * A station of a closed ride that has reached the state updating it keeps it in, its depart value no longer counts
+ * down and its start has no green light. Updating it again would only look up and redraw the same track element.
+ */
+struct SettledStation
+{
+    bool Valid;
+    uint32_t Generation;
+    uint8_t Depart;
+};
+
+static SettledStation _settledStations[MAX_RIDES][MAX_STATIONS] = {};
+
+static bool ride_station_is_closed(const Ride* ride)
+{
+    return ride->status == RIDE_STATUS_CLOSED && ride->num_riders == 0
+        && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED));
+}
+
+static SettledStation* ride_station_get_settled(const Ride* ride, StationIndex stationIndex)
+{
+    if (ride->id >= MAX_RIDES || stationIndex >= MAX_STATIONS)
+        return nullptr;
+    return &_settledStations[ride->id][stationIndex];
+}
+
+static void ride_station_set_settled(const Ride* ride, StationIndex stationIndex)
+{
+    auto settled = ride_station_get_settled(ride, stationIndex);
+    if (settled != nullptr)
+    {
+        settled->Valid = true;
+        settled->Generation = footpath_node_cache_generation();
+        settled->Depart = ride->stations[stationIndex].Depart;
+    }
+}
+
 /**
  *
  *  rct2: 0x006ABFFB
  */
-void ride_update_station(Ride* ride, StationIndex stationIndex)
+bool ride_update_station(Ride* ride, StationIndex stationIndex)
 {
     if (ride->stations[stationIndex].Start.isNull())
-        return;
+        return true;
+
+    // The map changing through a game action or the depart value being set elsewhere wakes a settled station up.
+    auto settled = ride_station_get_settled(ride, stationIndex);
+    if (settled != nullptr && settled->Valid)
+    {
+        if (ride_station_is_closed(ride) && settled->Generation == footpath_node_cache_generation()
+            && settled->Depart == ride->stations[stationIndex].Depart)
+        {
+            return false;
+        }
+        settled->Valid = false;
+    }
 
     switch (ride->mode)
     {
@@ -47,6 +97,7 @@ void ride_update_station(Ride* ride, StationIndex stationIndex)
             ride_update_station_normal(ride, stationIndex);
             break;
     }
+    return true;
 }
 
 /**
@@ -65,6 +116,9 @@ static void ride_update_station_blocksection(Ride* ride, StationIndex stationInd
         if ((ride->stations[stationIndex].Depart & STATION_DEPART_FLAG)
             || (tileElement != nullptr && tileElement->AsTrack()->HasGreenLight()))
             ride_invalidate_station_start(ride, stationIndex, false);
+
+        if (ride_station_is_closed(ride))
+            ride_station_set_settled(ride, stationIndex);
     }
     else
     {
@@ -154,6 +208,9 @@ static void ride_update_station_normal(Ride* ride, StationIndex stationIndex)
 
         ride->stations[stationIndex].Depart = time;
         ride_invalidate_station_start(ride, stationIndex, false);
+
+        if ((time == 0 || time == 127) && ride_station_is_closed(ride))
+            ride_station_set_settled(ride, stationIndex);
     }
     else
     {
@@ -18,7 +18,8 @@ using StationIndex = uint8_t;
 
 constexpr const StationIndex STATION_INDEX_NULL = 0xFF;
 
-void ride_update_station(Ride* ride, StationIndex stationIndex);
+// Returns false if the station was skipped as updating it would not change anything.
+bool ride_update_station(Ride* ride, StationIndex stationIndex);
 StationIndex ride_get_first_valid_station_exit(Ride* ride);
 StationIndex ride_get_first_valid_station_start(const Ride* ride);
 StationIndex ride_get_first_empty_station_start(const Ride* ride);
@@ -46,6 +46,7 @@
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
@@ -67,8 +68,6 @@ using namespace OpenRCT2::Drawing;
 struct map_backup
 {
     TileElement tile_elements[MAX_TILE_ELEMENTS];
-    TileElement* tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
-    TileElement* next_free_tile_element;
     uint16_t map_size_units;
     uint16_t map_size_units_minus_2;
     uint16_t map_size;
@@ -93,6 +92,8 @@ bool _trackDesignPlaceStateSceneryUnavailable = false;
 static bool _trackDesignPlaceStateHasScenery = false;
 static bool _trackDesignPlaceStatePlaceScenery = true;
 static bool _trackDesignPlaceIsReplay = false;
+// Filled by PTD_OPERATION_GET_FOOTPRINT
+static TrackDesignFootprint* _trackDesignFootprint;
 
 static std::unique_ptr<map_backup> track_design_preview_backup_map();
 
@@ -853,6 +854,44 @@ static void track_design_add_selection_tile(const CoordsXY& coords)
     }
 }
 
+static void track_design_add_footprint_tile(const CoordsXY& coords)
+{
+    auto offset = coords - CoordsXY{ _trackPreviewOrigin };
+    auto& tiles = _trackDesignFootprint->Tiles;
+    if (std::find(tiles.begin(), tiles.end(), offset) == tiles.end())
+    {
+        tiles.push_back(offset);
+    }
+}
+
+static void track_design_add_footprint_sample(const CoordsXY& coords, int32_t z, bool liftsDesign)
+{
+    _trackDesignFootprint->Samples.push_back({ coords - CoordsXY{ _trackPreviewOrigin }, z, liftsDesign });
+}
+
+/**
+ * The height the track has to be at on a tile to be above the ground and any water.
+ */
+static int32_t track_design_get_place_surface_z(const SurfaceElement& surfaceElement)
+{
+    int32_t surfaceZ = surfaceElement.GetBaseZ();
+    if (surfaceElement.GetSlope() & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
+    {
+        surfaceZ += LAND_HEIGHT_STEP;
+        if (surfaceElement.GetSlope() & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT)
+        {
+            surfaceZ += LAND_HEIGHT_STEP;
+        }
+    }
+
+    auto waterZ = surfaceElement.GetWaterHeight();
+    if (waterZ > 0 && waterZ > surfaceZ)
+    {
+        surfaceZ = waterZ;
+    }
+    return surfaceZ;
+}
+
 static void track_design_update_max_min_coordinates(const CoordsXYZ& coords)
 {
     _trackPreviewMin = { std::min(_trackPreviewMin.x, coords.x), std::min(_trackPreviewMin.y, coords.y),
@@ -993,6 +1032,19 @@ static bool TrackDesignPlaceSceneryElement(
         return TrackDesignPlaceSceneryElementGetPlaceZ(scenery);
     }
 
+    if (_trackDesignPlaceOperation == PTD_OPERATION_GET_FOOTPRINT)
+    {
+        if (mode == 0)
+        {
+            int32_t z = scenery.z * COORDS_Z_STEP;
+            track_design_add_footprint_tile(mapCoord);
+            track_design_add_footprint_sample(mapCoord, z, false);
+            auto& minSceneryZ = _trackDesignFootprint->MinSceneryZ;
+            minSceneryZ = std::min(minSceneryZ.value_or(z), z);
+        }
+        return true;
+    }
+
     if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_QUERY || _trackDesignPlaceOperation == PTD_OPERATION_PLACE
         || _trackDesignPlaceOperation == PTD_OPERATION_PLACE_GHOST
         || _trackDesignPlaceOperation == PTD_OPERATION_PLACE_TRACK_PREVIEW)
@@ -1278,6 +1330,13 @@ static int32_t track_design_place_all_scenery(
             continue;
         }
 
+        // The second pass reconnects the placed paths, the queues they join are chained once it has finished
+        if (mode == 1)
+        {
+            footpath_queue_chain_begin_batch();
+        }
+
+        bool placed = true;
         for (const auto& scenery : sceneryList)
         {
             uint8_t rotation = _currentTrackPieceDirection;
@@ -1290,9 +1349,20 @@ static int32_t track_design_place_all_scenery(
 
             if (!TrackDesignPlaceSceneryElement(mapCoord, mode, scenery, rotation, originZ))
             {
-                return 0;
+                placed = false;
+                break;
             }
         }
+
+        if (mode == 1)
+        {
+            footpath_queue_chain_end_batch();
+        }
+
+        if (!placed)
+        {
+            return 0;
+        }
     }
     return 1;
 }
@@ -1323,6 +1393,13 @@ static int32_t track_design_place_maze(TrackDesign* td6, const CoordsXYZ& coords
             track_design_add_selection_tile(mapCoord);
         }
 
+        if (_trackDesignPlaceOperation == PTD_OPERATION_GET_FOOTPRINT)
+        {
+            _trackPreviewOrigin = coords;
+            track_design_add_footprint_tile(mapCoord);
+            track_design_add_footprint_sample(mapCoord, 0, true);
+        }
+
         if (_trackDesignPlaceOperation == PTD_OPERATION_PLACE_QUERY || _trackDesignPlaceOperation == PTD_OPERATION_PLACE
             || _trackDesignPlaceOperation == PTD_OPERATION_PLACE_GHOST
             || _trackDesignPlaceOperation == PTD_OPERATION_PLACE_TRACK_PREVIEW)
@@ -1463,21 +1540,7 @@ static int32_t track_design_place_maze(TrackDesign* td6, const CoordsXYZ& coords
             auto surfaceElement = map_get_surface_element_at(mapCoord);
             if (surfaceElement == nullptr)
                 continue;
-            int16_t surfaceZ = surfaceElement->GetBaseZ();
-            if (surfaceElement->GetSlope() & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
-            {
-                surfaceZ += LAND_HEIGHT_STEP;
-                if (surfaceElement->GetSlope() & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT)
-                {
-                    surfaceZ += LAND_HEIGHT_STEP;
-                }
-            }
-
-            int16_t waterZ = surfaceElement->GetWaterHeight();
-            if (waterZ > 0 && waterZ > surfaceZ)
-            {
-                surfaceZ = waterZ;
-            }
+            int16_t surfaceZ = track_design_get_place_surface_z(*surfaceElement);
 
             int16_t temp_z = coords.z + _trackDesignPlaceZ - surfaceZ;
             if (temp_z < 0)
@@ -1628,21 +1691,7 @@ static bool track_design_place_ride(TrackDesign* td6, const CoordsXYZ& origin, R
                         return false;
                     }
 
-                    int32_t surfaceZ = surfaceElement->GetBaseZ();
-                    if (surfaceElement->GetSlope() & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
-                    {
-                        surfaceZ += LAND_HEIGHT_STEP;
-                        if (surfaceElement->GetSlope() & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT)
-                        {
-                            surfaceZ += LAND_HEIGHT_STEP;
-                        }
-                    }
-
-                    auto waterZ = surfaceElement->GetWaterHeight();
-                    if (waterZ > 0 && waterZ > surfaceZ)
-                    {
-                        surfaceZ = waterZ;
-                    }
+                    int32_t surfaceZ = track_design_get_place_surface_z(*surfaceElement);
                     int32_t heightDifference = tempZ + _trackDesignPlaceZ + trackBlock->z - surfaceZ;
                     if (heightDifference < 0)
                     {
@@ -1651,6 +1700,17 @@ static bool track_design_place_ride(TrackDesign* td6, const CoordsXYZ& origin, R
                 }
                 break;
             }
+            case PTD_OPERATION_GET_FOOTPRINT:
+            {
+                int32_t tempZ = newCoords.z - TrackCoordinates[trackType].z_begin - origin.z;
+                for (const rct_preview_track* trackBlock = trackBlockArray[trackType]; trackBlock->index != 0xFF; trackBlock++)
+                {
+                    auto tile = CoordsXY{ newCoords } + CoordsXY{ trackBlock->x, trackBlock->y }.Rotate(rotation);
+                    track_design_add_footprint_tile(tile);
+                    track_design_add_footprint_sample(tile, tempZ + trackBlock->z, true);
+                }
+                break;
+            }
         }
 
         const rct_track_coordinates* track_coordinates = &TrackCoordinates[trackType];
@@ -1684,6 +1744,10 @@ static bool track_design_place_ride(TrackDesign* td6, const CoordsXYZ& origin, R
             case PTD_OPERATION_DRAW_OUTLINES:
                 track_design_add_selection_tile(newCoords);
                 break;
+            case PTD_OPERATION_GET_FOOTPRINT:
+                track_design_add_footprint_tile(newCoords);
+                track_design_add_footprint_sample(newCoords, entrance.z * COORDS_Z_STEP, false);
+                break;
             case PTD_OPERATION_PLACE_QUERY:
             case PTD_OPERATION_PLACE:
             case PTD_OPERATION_PLACE_GHOST:
@@ -1853,6 +1917,87 @@ int32_t place_virtual_track(TrackDesign* td6, uint8_t ptdOperation, bool placeSc
     return _trackDesignPlaceCost;
 }
 
+std::unique_ptr<TrackDesignFootprint> track_design_get_footprint(TrackDesign* td6, bool placeScenery, Ride* ride)
+{
+    auto footprint = std::make_unique<TrackDesignFootprint>();
+    footprint->Rotation = _currentTrackPieceDirection;
+    footprint->PlaceScenery = placeScenery && !gTrackDesignSceneryToggle;
+    footprint->IsMaze = td6->type == RIDE_TYPE_MAZE;
+
+    _trackDesignFootprint = footprint.get();
+    place_virtual_track(td6, PTD_OPERATION_GET_FOOTPRINT, placeScenery, ride, {});
+    _trackDesignFootprint = nullptr;
+    return footprint;
+}
+
+void track_design_footprint_draw_outlines(const TrackDesignFootprint& footprint, const CoordsXY& origin)
+{
+    gMapSelectionTiles.clear();
+    for (const auto& offset : footprint.Tiles)
+    {
+        gMapSelectionTiles.push_back(origin + offset);
+    }
+    gMapSelectArrowPosition = CoordsXYZ{ origin, tile_element_height(origin) };
+    gMapSelectArrowDirection = footprint.Rotation;
+
+    gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_CONSTRUCT;
+    gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_ARROW;
+    gMapSelectFlags &= ~MAP_SELECT_FLAG_GREEN;
+    map_invalidate_map_selection_tiles();
+}
+
+int32_t track_design_footprint_get_place_z(const TrackDesignFootprint& footprint, const CoordsXYZ& origin)
+{
+    int32_t placeZ = 0;
+    for (const auto& sample : footprint.Samples)
+    {
+        if (!sample.LiftsDesign)
+            continue;
+
+        auto tile = CoordsXY{ origin } + sample.Offset;
+        if (!map_is_location_valid(tile))
+            continue;
+
+        auto surfaceElement = map_get_surface_element_at(tile);
+        if (surfaceElement == nullptr)
+        {
+            if (footprint.IsMaze)
+                continue;
+            // The scenery is not looked at when the track could not be.
+            return placeZ;
+        }
+
+        int32_t heightDifference = origin.z + sample.Z + placeZ - track_design_get_place_surface_z(*surfaceElement);
+        if (heightDifference < 0)
+        {
+            placeZ -= heightDifference;
+        }
+    }
+
+    int32_t sceneryZ = 0;
+    if (footprint.PlaceScenery && footprint.MinSceneryZ)
+    {
+        sceneryZ = std::min(sceneryZ, *footprint.MinSceneryZ + placeZ);
+    }
+    return placeZ - sceneryZ;
+}
+
+bool track_design_footprint_is_clear(const TrackDesignFootprint& footprint, const CoordsXYZ& origin)
+{
+    constexpr uint16_t surfaceOnly = tile_element_type_bit(TILE_ELEMENT_TYPE_SURFACE);
+    for (const auto& sample : footprint.Samples)
+    {
+        auto tile = CoordsXY{ origin } + sample.Offset;
+        if (!map_is_location_valid(tile) || (map_get_tile_element_types(tile) & ~surfaceOnly) != 0)
+            return false;
+
+        auto surfaceElement = map_get_surface_element_at(tile);
+        if (surfaceElement == nullptr || origin.z + sample.Z < track_design_get_place_surface_z(*surfaceElement))
+            return false;
+    }
+    return true;
+}
+
 static money32 track_design_ride_create_command(int32_t type, int32_t subType, int32_t flags, ride_id_t* outRideIndex)
 {
     // Don't set colours as will be set correctly later.
@@ -2100,9 +2245,7 @@ static std::unique_ptr<map_backup> track_design_preview_backup_map()
     auto backup = std::make_unique<map_backup>();
     if (backup != nullptr)
     {
-        std::memcpy(backup->tile_elements, gTileElements, sizeof(backup->tile_elements));
-        std::memcpy(backup->tile_pointers, gTileElementTilePointers, sizeof(backup->tile_pointers));
-        backup->next_free_tile_element = gNextFreeTileElement;
+        map_copy_elements_in_tile_order(backup->tile_elements, std::size(backup->tile_elements));
         backup->map_size_units = gMapSizeUnits;
         backup->map_size_units_minus_2 = gMapSizeMinus2;
         backup->map_size = gMapSize;
@@ -2118,12 +2261,12 @@ static std::unique_ptr<map_backup> track_design_preview_backup_map()
 static void track_design_preview_restore_map(map_backup* backup)
 {
     std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
-    std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
-    gNextFreeTileElement = backup->next_free_tile_element;
+    map_update_tile_pointers();
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
     gCurrentRotation = backup->current_rotation;
+    footpath_node_cache_invalidate();
 }
 
 /**
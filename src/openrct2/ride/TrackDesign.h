@@ -17,6 +17,10 @@
 #include "../world/Map.h"
 #include "Vehicle.h"
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 struct Ride;
 
 #define TRACK_PREVIEW_IMAGE_SIZE (370 * 217)
@@ -182,6 +186,7 @@ enum
     PTD_OPERATION_PLACE_GHOST,
     PTD_OPERATION_PLACE_TRACK_PREVIEW,
     PTD_OPERATION_REMOVE_GHOST,
+    PTD_OPERATION_GET_FOOTPRINT,
 };
 
 static constexpr uint8_t PTD_OPERATION_FLAG_IS_REPLAY = (1 << 7);
@@ -208,6 +213,46 @@ void track_design_mirror(TrackDesign* td6);
 
 int32_t place_virtual_track(TrackDesign* td6, uint8_t ptdOperation, bool placeScenery, Ride* ride, const CoordsXYZ& coords);
 
+/**
+ * The tiles a design covers and the heights of its pieces relative to where it is placed, for one rotation. These do
+ * not depend on the map, so they are worked out once and each position the design is moved to only has to look at the
+ * tiles under it.
+ */
+struct TrackDesignFootprint
+{
+    struct Sample
+    {
+        CoordsXY Offset;
+        int32_t Z;
+        // Only the track is lifted above the ground when working out the height to place the design at.
+        bool LiftsDesign;
+    };
+
+    uint8_t Rotation{};
+    bool PlaceScenery{};
+    bool IsMaze{};
+    // The tiles outlined while placing the design, in the order PTD_OPERATION_DRAW_OUTLINES adds them
+    std::vector<CoordsXY> Tiles;
+    std::vector<Sample> Samples;
+    std::optional<int32_t> MinSceneryZ;
+};
+
+/**
+ * Works out the footprint of the design for _currentTrackPieceDirection, as it would be placed by place_virtual_track
+ * with the same arguments.
+ */
+std::unique_ptr<TrackDesignFootprint> track_design_get_footprint(TrackDesign* td6, bool placeScenery, Ride* ride);
+// Same as place_virtual_track with PTD_OPERATION_DRAW_OUTLINES.
+void track_design_footprint_draw_outlines(const TrackDesignFootprint& footprint, const CoordsXY& origin);
+// Same as place_virtual_track with PTD_OPERATION_GET_PLACE_Z.
+int32_t track_design_footprint_get_place_z(const TrackDesignFootprint& footprint, const CoordsXYZ& origin);
+/**
+ * Whether there is nothing but the ground on the tiles of the design placed at origin, and all of it is above the
+ * ground. Raising such a design can not clear anything in its way, so if it can not be placed at origin it can not be
+ * placed any higher either.
+ */
+bool track_design_footprint_is_clear(const TrackDesignFootprint& footprint, const CoordsXYZ& origin);
+
 ///////////////////////////////////////////////////////////////////////////////
 // Track design preview
 ///////////////////////////////////////////////////////////////////////////////
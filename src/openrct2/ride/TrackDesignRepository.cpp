@@ -38,6 +38,7 @@ struct TrackRepositoryItem
     uint8_t RideType = RIDE_TYPE_NULL;
     std::string ObjectEntry;
     uint32_t Flags = 0;
+    TrackDesignFileStats Stats;
 };
 
 enum TRACK_REPO_ITEM_FLAGS
@@ -57,7 +58,7 @@ class TrackDesignFileIndex final : public FileIndex<TrackRepositoryItem>
 {
 private:
     static constexpr uint32_t MAGIC_NUMBER = 0x58444954; // TIDX
-    static constexpr uint16_t VERSION = 3;
+    static constexpr uint16_t VERSION = 4;
     static constexpr auto PATTERN = "*.td4;*.td6";
 
 public:
@@ -88,11 +89,12 @@ public:
             {
                 item.Flags |= TRIF_READ_ONLY;
             }
+            item.Stats = GetStats(*td6);
             return std::make_tuple(true, item);
         }
         else
         {
-            return std::make_tuple(true, TrackRepositoryItem());
+            return std::make_tuple(false, TrackRepositoryItem());
         }
     }
 
@@ -104,6 +106,24 @@ protected:
         stream->WriteValue(item.RideType);
         stream->WriteString(item.ObjectEntry);
         stream->WriteValue(item.Flags);
+
+        const auto& stats = item.Stats;
+        stream->WriteValue(stats.excitement);
+        stream->WriteValue(stats.intensity);
+        stream->WriteValue(stats.nausea);
+        stream->WriteValue(stats.holes);
+        stream->WriteValue(stats.max_speed);
+        stream->WriteValue(stats.average_speed);
+        stream->WriteValue(stats.ride_length);
+        stream->WriteValue(stats.max_positive_vertical_g);
+        stream->WriteValue(stats.max_negative_vertical_g);
+        stream->WriteValue(stats.max_lateral_g);
+        stream->WriteValue(stats.total_air_time);
+        stream->WriteValue(stats.drops);
+        stream->WriteValue(stats.highest_drop_height);
+        stream->WriteValue(stats.inversions);
+        stream->WriteValue(stats.space_required_x);
+        stream->WriteValue(stats.space_required_y);
     }
 
     TrackRepositoryItem Deserialise(IStream* stream) const override
@@ -114,10 +134,50 @@ protected:
         item.RideType = stream->ReadValue<uint8_t>();
         item.ObjectEntry = stream->ReadStdString();
         item.Flags = stream->ReadValue<uint32_t>();
+
+        auto& stats = item.Stats;
+        stats.excitement = stream->ReadValue<uint8_t>();
+        stats.intensity = stream->ReadValue<uint8_t>();
+        stats.nausea = stream->ReadValue<uint8_t>();
+        stats.holes = stream->ReadValue<uint8_t>();
+        stats.max_speed = stream->ReadValue<int8_t>();
+        stats.average_speed = stream->ReadValue<int8_t>();
+        stats.ride_length = stream->ReadValue<uint16_t>();
+        stats.max_positive_vertical_g = stream->ReadValue<uint8_t>();
+        stats.max_negative_vertical_g = stream->ReadValue<int8_t>();
+        stats.max_lateral_g = stream->ReadValue<uint8_t>();
+        stats.total_air_time = stream->ReadValue<uint8_t>();
+        stats.drops = stream->ReadValue<uint8_t>();
+        stats.highest_drop_height = stream->ReadValue<uint8_t>();
+        stats.inversions = stream->ReadValue<uint8_t>();
+        stats.space_required_x = stream->ReadValue<uint8_t>();
+        stats.space_required_y = stream->ReadValue<uint8_t>();
         return item;
     }
 
 private:
+    static TrackDesignFileStats GetStats(const TrackDesign& td)
+    {
+        TrackDesignFileStats stats;
+        stats.excitement = td.excitement;
+        stats.intensity = td.intensity;
+        stats.nausea = td.nausea;
+        stats.holes = td.holes;
+        stats.max_speed = td.max_speed;
+        stats.average_speed = td.average_speed;
+        stats.ride_length = td.ride_length;
+        stats.max_positive_vertical_g = td.max_positive_vertical_g;
+        stats.max_negative_vertical_g = td.max_negative_vertical_g;
+        stats.max_lateral_g = td.max_lateral_g;
+        stats.total_air_time = td.total_air_time;
+        stats.drops = td.drops;
+        stats.highest_drop_height = td.highest_drop_height;
+        stats.inversions = td.inversions;
+        stats.space_required_x = td.space_required_x;
+        stats.space_required_y = td.space_required_y;
+        return stats;
+    }
+
     bool IsTrackReadOnly(const std::string& path) const
     {
         return String::StartsWith(path, SearchPaths[0]) || String::StartsWith(path, SearchPaths[1]);
@@ -209,6 +269,7 @@ public:
                 track_design_file_ref ref;
                 ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
                 ref.path = String::Duplicate(item.Path);
+                ref.stats = item.Stats;
                 refs.push_back(ref);
             }
         }
@@ -290,6 +351,31 @@ public:
         return result;
     }
 
+    bool ScanFile(const std::string& path) override
+    {
+        if (!_fileIndex.IsIndexedFile(path))
+        {
+            return false;
+        }
+
+        auto language = LocalisationService_GetCurrentLanguage();
+        auto td = _fileIndex.Create(language, path);
+        if (std::get<0>(td))
+        {
+            size_t index = GetTrackIndex(path);
+            if (index != SIZE_MAX)
+            {
+                _items[index] = std::get<1>(td);
+            }
+            else
+            {
+                _items.push_back(std::get<1>(td));
+            }
+            SortItems();
+        }
+        return true;
+    }
+
 private:
     void SortItems()
     {
@@ -13,10 +13,35 @@
 
 #include <memory>
 
+/**
+ * The statistics of a track design that are shown in the track list, kept in the track design index so they can be
+ * shown without reading the design.
+ */
+struct TrackDesignFileStats
+{
+    uint8_t excitement = 0;
+    uint8_t intensity = 0;
+    uint8_t nausea = 0;
+    uint8_t holes = 0;
+    int8_t max_speed = 0;
+    int8_t average_speed = 0;
+    uint16_t ride_length = 0;
+    uint8_t max_positive_vertical_g = 0;
+    int8_t max_negative_vertical_g = 0;
+    uint8_t max_lateral_g = 0;
+    uint8_t total_air_time = 0;
+    uint8_t drops = 0;
+    uint8_t highest_drop_height = 0;
+    uint8_t inversions = 0;
+    uint8_t space_required_x = 0xFF;
+    uint8_t space_required_y = 0xFF;
+};
+
 struct track_design_file_ref
 {
     utf8* name;
     utf8* path;
+    TrackDesignFileStats stats;
 };
 
 #include <string>
@@ -40,6 +65,11 @@ struct ITrackDesignRepository
     virtual bool Delete(const std::string& path) abstract;
     virtual std::string Rename(const std::string& path, const std::string& newName) abstract;
     virtual std::string Install(const std::string& path, const std::string& name) abstract;
+    /**
+     * Adds the track design of a file created or changed since the last scan, or updates its item. Returns false if
+     * the file is not one the repository indexes.
+     */
+    virtual bool ScanFile(const std::string& path) abstract;
 };
 
 std::unique_ptr<ITrackDesignRepository> CreateTrackDesignRepository(const std::shared_ptr<OpenRCT2::IPlatformEnvironment>& env);
@@ -27,6 +27,9 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+#include <vector>
+
 // clang-format off
 /* rct2: 0x007667AC */
 static constexpr TileCoordsXY EntranceOffsetEdgeNE[] = {
@@ -2131,6 +2134,35 @@ void track_paint_util_left_corkscrew_up_supports(paint_session* session, Directi
     }
 }
 
+using TrackPaintFunctionTable = std::array<TRACK_PAINT_FUNCTION, TrackElemType::Count>;
+
+static std::vector<TrackPaintFunctionTable> track_paint_create_function_tables()
+{
+    std::vector<TrackPaintFunctionTable> tables(RIDE_TYPE_COUNT);
+    for (size_t rideType = 0; rideType < tables.size(); rideType++)
+    {
+        auto paintFunctionGetter = RideTypeDescriptors[rideType].TrackPaintFunction;
+        auto& table = tables[rideType];
+        for (size_t trackType = 0; trackType < table.size(); trackType++)
+        {
+            table[trackType] = paintFunctionGetter != nullptr ? paintFunctionGetter(static_cast<int32_t>(trackType))
+                                                              : nullptr;
+        }
+    }
+    return tables;
+}
+
+TRACK_PAINT_FUNCTION track_paint_get_function(uint8_t rideType, int32_t trackType)
+{
+    // The getters only depend on the track type, so their results can be kept for the lifetime of the game.
+    static const auto tables = track_paint_create_function_tables();
+    if (rideType >= tables.size() || trackType < 0 || trackType >= TrackElemType::Count)
+    {
+        return nullptr;
+    }
+    return tables[rideType][trackType];
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2190,14 +2222,10 @@ void track_paint(paint_session* session, Direction direction, int32_t height, co
             session->TrackColours[SCHEME_3] = ghost_id;
         }
 
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = RideTypeDescriptors[ride->type].TrackPaintFunction;
-        if (paintFunctionGetter != nullptr)
+        TRACK_PAINT_FUNCTION paintFunction = track_paint_get_function(ride->type, trackType);
+        if (paintFunction != nullptr)
         {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
-            }
+            paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
         }
     }
 }
@@ -397,6 +397,9 @@ using TRACK_PAINT_FUNCTION = void (*)(
     const TileElement* tileElement);
 using TRACK_PAINT_FUNCTION_GETTER = TRACK_PAINT_FUNCTION (*)(int32_t trackType);
 
+// The paint function of a track type, looked up from a table filled in once from the TRACK_PAINT_FUNCTION_GETTERs.
+TRACK_PAINT_FUNCTION track_paint_get_function(uint8_t rideType, int32_t trackType);
+
 TRACK_PAINT_FUNCTION get_track_paint_function_stand_up_rc(int32_t trackType);
 TRACK_PAINT_FUNCTION get_track_paint_function_suspended_swinging_rc(int32_t trackType);
 TRACK_PAINT_FUNCTION get_track_paint_function_inverted_rc(int32_t trackType);
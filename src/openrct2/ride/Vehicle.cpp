@@ -26,6 +26,8 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/EntityScheduler.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
@@ -41,9 +43,11 @@
 #include "Track.h"
 #include "TrackData.h"
 #include "VehicleData.h"
+#include "VehiclePaint.h"
 #include "VehicleSubpositionData.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 
 static bool vehicle_boat_is_location_accessible(const CoordsXYZ& location);
@@ -736,6 +740,31 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return sprite_identifier == SPRITE_IDENTIFIER_VEHICLE;
 }
 
+static VehicleMotionStats _motionStatsCurrent;
+static VehicleMotionStats _motionStatsLast;
+
+static void vehicle_motion_stats_roll_over()
+{
+    if (_motionStatsCurrent.Tick != gCurrentTicks)
+    {
+        _motionStatsLast = _motionStatsCurrent;
+        _motionStatsCurrent = {};
+        _motionStatsCurrent.Tick = gCurrentTicks;
+    }
+}
+
+VehicleMotionStats vehicle_get_motion_stats()
+{
+    vehicle_motion_stats_roll_over();
+    if (_motionStatsLast.Tick != gCurrentTicks - 1)
+    {
+        VehicleMotionStats stats{};
+        stats.Tick = gCurrentTicks - 1;
+        return stats;
+    }
+    return _motionStatsLast;
+}
+
 static bool vehicle_move_info_valid(VehicleTrackSubposition trackSubposition, int32_t typeAndDirection, int32_t offset)
 {
     if (trackSubposition >= VehicleTrackSubposition{ std::size(gTrackVehicleInfo) })
@@ -791,12 +820,13 @@ static bool vehicle_move_info_valid(VehicleTrackSubposition trackSubposition, in
 static const rct_vehicle_info* vehicle_get_move_info(
     VehicleTrackSubposition trackSubposition, int32_t typeAndDirection, int32_t offset)
 {
+    _motionStatsCurrent.MoveInfoLookups++;
     if (!vehicle_move_info_valid(trackSubposition, typeAndDirection, offset))
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->info[offset];
+    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->GetInfo()[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -1041,34 +1071,34 @@ OpenRCT2::Audio::VehicleSoundParams Vehicle::CreateSoundParam(uint16_t priority)
  *
  *  rct2: 0x006BB9FF
  */
-void Vehicle::UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>& vehicleSoundParamsList) const
+void Vehicle::UpdateSoundParams(std::vector<VehicleSoundCandidate>& candidates) const
 {
     if (!SoundCanPlay())
         return;
 
     uint16_t soundPriority = GetSoundPriority();
     // Find a sound param of lower priority to use
-    auto soundParamIter = std::find_if(
-        vehicleSoundParamsList.begin(), vehicleSoundParamsList.end(),
-        [soundPriority](const auto& param) { return soundPriority > param.priority; });
+    auto candidateIter = std::find_if(candidates.begin(), candidates.end(), [soundPriority](const auto& candidate) {
+        return soundPriority > candidate.Priority;
+    });
 
-    if (soundParamIter == std::end(vehicleSoundParamsList))
+    if (candidateIter == std::end(candidates))
     {
-        if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
+        if (candidates.size() < OpenRCT2::Audio::MaxVehicleSounds)
         {
-            vehicleSoundParamsList.push_back(CreateSoundParam(soundPriority));
+            candidates.push_back({ soundPriority, this });
         }
     }
     else
     {
-        if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
+        if (candidates.size() < OpenRCT2::Audio::MaxVehicleSounds)
         {
             // Shift all sound params down one if using a free space
-            vehicleSoundParamsList.insert(soundParamIter, CreateSoundParam(soundPriority));
+            candidates.insert(candidateIter, { soundPriority, this });
         }
         else
         {
-            *soundParamIter = CreateSoundParam(soundPriority);
+            *candidateIter = { soundPriority, this };
         }
     }
 }
@@ -1274,14 +1304,27 @@ void vehicle_sounds_update()
     if (!OpenRCT2::Audio::IsAvailable())
         return;
 
-    std::vector<OpenRCT2::Audio::VehicleSoundParams> vehicleSoundParamsList;
-    vehicleSoundParamsList.reserve(OpenRCT2::Audio::MaxVehicleSounds);
+    // Both are reused every tick so selecting the sounds to play does not allocate.
+    static std::vector<VehicleSoundCandidate> candidates;
+    static std::vector<OpenRCT2::Audio::VehicleSoundParams> vehicleSoundParamsList;
+    candidates.clear();
+    vehicleSoundParamsList.clear();
 
     vehicle_sounds_update_window_setup();
 
-    for (auto vehicle : EntityList<Vehicle>(EntityListId::TrainHead))
+    // Without a listening viewport no train can be heard, but the sounds that are playing still have to be stopped.
+    if (g_music_tracking_viewport != nullptr)
     {
-        vehicle->UpdateSoundParams(vehicleSoundParamsList);
+        for (auto vehicle : EntityList<Vehicle>(EntityListId::TrainHead))
+        {
+            vehicle->UpdateSoundParams(candidates);
+        }
+    }
+
+    // Only the trains that made it onto the list get their sound params, which needs a surface lookup.
+    for (const auto& candidate : candidates)
+    {
+        vehicleSoundParamsList.push_back(candidate.Head->CreateSoundParam(candidate.Priority));
     }
 
     // Stop all playing sounds that no longer have priority to play after vehicle_update_sound_params
@@ -1362,10 +1405,7 @@ void vehicle_update_all()
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EDITOR_STEP_ROLLERCOASTER_DESIGNER)
         return;
 
-    for (auto vehicle : EntityList<Vehicle>(EntityListId::TrainHead))
-    {
-        vehicle->Update();
-    }
+    ForEachEntityInList<Vehicle>(EntityListId::TrainHead, [](Vehicle* vehicle) { vehicle->Update(); });
 }
 
 /**
@@ -1968,6 +2008,8 @@ void Vehicle::Update()
 
     if (HasUpdateFlag(VEHICLE_UPDATE_FLAG_TESTING))
         UpdateMeasurements();
+    if (IsHead())
+        ride_measurement_recorder_update(*curRide, *this);
 
     _vehicleBreakdown = 255;
     if (curRide->lifecycle_flags & (RIDE_LIFECYCLE_BREAKDOWN_PENDING | RIDE_LIFECYCLE_BROKEN_DOWN))
@@ -2055,6 +2097,14 @@ void Vehicle::Update()
             break;
     }
 
+    if (!gOpenRCT2Headless)
+    {
+        for (Vehicle* car = this; car != nullptr; car = GetEntity<Vehicle>(car->next_vehicle_on_train))
+        {
+            vehicle_update_sprite_cache(car);
+        }
+    }
+
     UpdateSound();
 }
 
@@ -2695,11 +2745,25 @@ static rct_synchronised_vehicle _synchronisedVehicles[SYNCHRONISED_VEHICLE_COUNT
 static rct_synchronised_vehicle* _lastSynchronisedVehicle = nullptr;
 
 /**
- * Checks if a map position contains a synchronised ride station and adds the vehicle
- * to synchronise to the vehicle synchronisation list.
+ * The synchronised stations found by probing the tiles either side of a station, in the order they are probed.
+ * Only depends on the map and the ride settings, so it is kept until the map changes.
+ */
+struct SynchronisedStationGroup
+{
+    uint32_t Generation;
+    bool Valid;
+    bool HasStartElement;
+    uint8_t Count;
+    std::pair<ride_id_t, StationIndex> Stations[SYNCHRONISED_VEHICLE_COUNT - 1];
+};
+
+static SynchronisedStationGroup _synchronisedStationGroups[MAX_RIDES][MAX_STATIONS] = {};
+
+/**
+ * Checks if a map position contains a station of a ride set to synchronise with adjacent stations.
  *  rct2: 0x006DE1A4
  */
-static bool try_add_synchronised_station(const CoordsXYZ& coords)
+static bool find_synchronised_station(const CoordsXYZ& coords, ride_id_t* rideIndex, StationIndex* stationIndex)
 {
     // make sure we are in map bounds
     if (!map_is_location_valid(coords))
@@ -2715,39 +2779,49 @@ static bool try_add_synchronised_station(const CoordsXYZ& coords)
         return false;
     }
 
-    auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-    auto ride = get_ride(rideIndex);
+    auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
     if (ride == nullptr || !(ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
     {
         /* Ride is not set to synchronise with adjacent stations. */
         return false;
     }
 
-    /* From this point on, the ride of the map element is one that is set
-     * to sync with adjacent stations, so it will return true.
-     * Still to determine if a vehicle to sync can be identified. */
-
-    auto stationIndex = tileElement->AsTrack()->GetStationIndex();
+    *rideIndex = ride->id;
+    *stationIndex = tileElement->AsTrack()->GetStationIndex();
+    return true;
+}
 
+/**
+ * Adds a synchronised station to the vehicle synchronisation list together with the vehicle waiting on it, if any.
+ *  rct2: 0x006DE1A4
+ */
+static void add_synchronised_station(ride_id_t rideIndex, StationIndex stationIndex)
+{
     rct_synchronised_vehicle* sv = _lastSynchronisedVehicle;
     sv->ride_id = rideIndex;
     sv->stationIndex = stationIndex;
     sv->vehicle_id = SPRITE_INDEX_NULL;
     _lastSynchronisedVehicle++;
 
+    auto ride = get_ride(rideIndex);
+    if (ride == nullptr)
+    {
+        return;
+    }
+
     /* Ride vehicles are not on the track (e.g. ride is/was under
      * construction), so just return; vehicle_id for this station
      * is SPRITE_INDEX_NULL. */
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK))
     {
-        return true;
+        return;
     }
 
     /* Station is not ready to depart, so just return;
      * vehicle_id for this station is SPRITE_INDEX_NULL. */
     if (!(ride->stations[stationIndex].Depart & STATION_DEPART_FLAG))
     {
-        return true;
+        return;
     }
 
     // Look for a vehicle on this station waiting to depart.
@@ -2777,79 +2851,106 @@ static bool try_add_synchronised_station(const CoordsXYZ& coords)
         }
 
         sv->vehicle_id = vehicle->sprite_index;
-        return true;
+        return;
     }
 
     /* No vehicle found waiting to depart (with sync adjacent) at the
      * station, so just return; vehicle_id for this station is
      * SPRITE_INDEX_NULL. */
-    return true;
 }
 
-/**
- * Checks whether a vehicle can depart a station when set to synchronise with adjacent stations.
- *  rct2: 0x006DE287
- * @param vehicle The vehicle waiting to depart.
- * @returns true if the vehicle can depart (all adjacent trains are ready or broken down), otherwise false.
- *
- * Permits vehicles to depart in two ways:
- *  Returns true, permitting the vehicle in the param to depart immediately;
- *  The vehicle flag VEHICLE_UPDATE_FLAG_WAIT_ON_ADJACENT is cleared for those
- *  vehicles that depart in sync with the vehicle in the param.
- */
-static bool ride_station_can_depart_synchronised(const Ride& ride, StationIndex station)
+static void synchronised_station_group_build(const Ride& ride, StationIndex station, SynchronisedStationGroup& group)
 {
-    auto location = ride.stations[station].GetStart();
+    group.Count = 0;
 
+    auto location = ride.stations[station].GetStart();
     auto tileElement = map_get_track_element_at(location);
+    group.HasStartElement = tileElement != nullptr;
     if (tileElement == nullptr)
     {
-        return false;
+        return;
     }
 
-    // Reset the list of synchronised vehicles to empty.
-    _lastSynchronisedVehicle = _synchronisedVehicles;
-
     /* Search for stations to sync in both directions from the current tile.
      * We allow for some space between stations, and every time a station
      *  is found we allow for space between that and the next.
      */
 
     int32_t direction = tileElement->GetDirectionWithOffset(1);
-    int32_t spaceBetween;
     int32_t maxCheckDistance = RIDE_ADJACENCY_CHECK_DISTANCE;
 
-    spaceBetween = maxCheckDistance;
-    while (_lastSynchronisedVehicle < &_synchronisedVehicles[SYNCHRONISED_VEHICLE_COUNT - 1])
+    for (int32_t pass = 0; pass < 2; pass++)
     {
-        location += CoordsXYZ{ CoordsDirectionDelta[direction], 0 };
-        if (try_add_synchronised_station(location))
+        if (pass == 1)
         {
-            spaceBetween = maxCheckDistance;
-            continue;
+            // Other search direction.
+            location = ride.stations[station].GetStart();
+            direction = direction_reverse(direction) & 3;
         }
-        if (spaceBetween-- == 0)
+
+        int32_t spaceBetween = maxCheckDistance;
+        while (group.Count < std::size(group.Stations))
         {
-            break;
+            location += CoordsXYZ{ CoordsDirectionDelta[direction], 0 };
+            auto& entry = group.Stations[group.Count];
+            if (find_synchronised_station(location, &entry.first, &entry.second))
+            {
+                group.Count++;
+                spaceBetween = maxCheckDistance;
+                continue;
+            }
+            if (spaceBetween-- == 0)
+            {
+                break;
+            }
         }
     }
+}
 
-    // Other search direction.
-    location = ride.stations[station].GetStart();
-    direction = direction_reverse(direction) & 3;
-    spaceBetween = maxCheckDistance;
-    while (_lastSynchronisedVehicle < &_synchronisedVehicles[SYNCHRONISED_VEHICLE_COUNT - 1])
+static const SynchronisedStationGroup& synchronised_station_group_get(const Ride& ride, StationIndex station)
+{
+    static SynchronisedStationGroup uncached;
+    if (ride.id >= MAX_RIDES || station >= MAX_STATIONS)
     {
-        location += CoordsXYZ{ CoordsDirectionDelta[direction], 0 };
-        if (try_add_synchronised_station(location))
-        {
-            spaceBetween = maxCheckDistance;
-            continue;
-        }
-        if (spaceBetween-- == 0)
-        {
-            break;
-        }
+        synchronised_station_group_build(ride, station, uncached);
+        return uncached;
+    }
+
+    auto& group = _synchronisedStationGroups[ride.id][station];
+    auto generation = footpath_node_cache_generation();
+    if (!group.Valid || group.Generation != generation)
+    {
+        synchronised_station_group_build(ride, station, group);
+        group.Generation = generation;
+        group.Valid = true;
+    }
+    return group;
+}
+
+/**
+ * Checks whether a vehicle can depart a station when set to synchronise with adjacent stations.
+ *  rct2: 0x006DE287
+ * @param vehicle The vehicle waiting to depart.
+ * @returns true if the vehicle can depart (all adjacent trains are ready or broken down), otherwise false.
+ *
+ * Permits vehicles to depart in two ways:
+ *  Returns true, permitting the vehicle in the param to depart immediately;
+ *  The vehicle flag VEHICLE_UPDATE_FLAG_WAIT_ON_ADJACENT is cleared for those
+ *  vehicles that depart in sync with the vehicle in the param.
+ */
+static bool ride_station_can_depart_synchronised(const Ride& ride, StationIndex station)
+{
+    const auto& group = synchronised_station_group_get(ride, station);
+    if (!group.HasStartElement)
+    {
+        return false;
+    }
+
+    // Reset the list of synchronised vehicles to empty.
+    _lastSynchronisedVehicle = _synchronisedVehicles;
+    for (uint8_t i = 0; i < group.Count; i++)
+    {
+        add_synchronised_station(group.Stations[i].first, group.Stations[i].second);
     }
 
     if (_lastSynchronisedVehicle == _synchronisedVehicles)
@@ -7618,6 +7719,7 @@ void Vehicle::UpdateReverserCarBogies()
  */
 bool Vehicle::UpdateMotionCollisionDetection(const CoordsXYZ& loc, uint16_t* otherVehicleIndex)
 {
+    _motionStatsCurrent.CollisionChecks++;
     if (HasUpdateFlag(VEHICLE_UPDATE_FLAG_1))
         return false;
 
@@ -8107,6 +8209,85 @@ bool Vehicle::UpdateTrackMotionForwardsGetNewTrack(uint16_t trackType, Ride* cur
     return true;
 }
 
+/**
+ * Whether moving forwards along the piece involves none of the behaviour tied to particular pieces or subpositions,
+ * such as brakes, boosters, lifts, reversers and splashes.
+ */
+static bool vehicle_track_is_plain(const Ride* curRide, int32_t trackType)
+{
+    switch (trackType)
+    {
+        case TrackElemType::Flat:
+            return curRide->type != RIDE_TYPE_REVERSE_FREEFALL_COASTER;
+        case TrackElemType::EndStation:
+        case TrackElemType::BeginStation:
+        case TrackElemType::MiddleStation:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Moves forwards along a plain piece until the vehicle runs out of distance, collides or reaches the last
+ * subposition of the piece. This does the same as stepping through UpdateTrackMotionForwards, but the subpositions
+ * and ride properties are only looked up once.
+ */
+Vehicle::PlainPieceResult Vehicle::UpdateTrackMotionForwardsPlainPiece(
+    rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, uint16_t* otherVehicleIndex)
+{
+    uint16_t trackTotalProgress = GetTrackProgress();
+    if (track_progress + 1 >= trackTotalProgress)
+    {
+        return PlainPieceResult::EndOfPiece;
+    }
+
+    const rct_vehicle_info* moveInfos = GetMoveInfo() - track_progress;
+    const int16_t zOffset = RideTypeDescriptors[curRide->type].Heights.VehicleZOffset;
+    const bool resetsSwinging = vehicleEntry->flags & VEHICLE_ENTRY_FLAG_25;
+    const bool detectsCollisions = this == _vehicleFrontVehicle && _vehicleVelocityF64E08 >= 0;
+    while (track_progress + 1 < trackTotalProgress)
+    {
+        track_progress++;
+        _motionStatsCurrent.PlainSteps++;
+
+        const auto& moveInfo = moveInfos[track_progress];
+        auto loc = TrackLocation + CoordsXYZ{ moveInfo.x, moveInfo.y, moveInfo.z + zOffset };
+        int32_t changedAxes = (loc.x != unk_F64E20.x ? 1 : 0) | (loc.y != unk_F64E20.y ? 2 : 0)
+            | (loc.z != unk_F64E20.z ? 4 : 0);
+        remaining_distance -= dword_9A2930[changedAxes];
+        unk_F64E20 = loc;
+        sprite_direction = moveInfo.direction;
+        bank_rotation = moveInfo.bank_rotation;
+        vehicle_sprite_type = moveInfo.vehicle_sprite_type;
+
+        if (resetsSwinging && moveInfo.vehicle_sprite_type != 0)
+        {
+            SwingSprite = 0;
+            SwingPosition = 0;
+            SwingSpeed = 0;
+        }
+
+        if (detectsCollisions)
+        {
+            *otherVehicleIndex = prev_vehicle_on_ride;
+            if (UpdateMotionCollisionDetection(loc, otherVehicleIndex))
+            {
+                return PlainPieceResult::Collided;
+            }
+        }
+
+        if (remaining_distance < 0x368A)
+        {
+            return PlainPieceResult::Settled;
+        }
+
+        acceleration += dword_9A2970[moveInfo.vehicle_sprite_type];
+        _vehicleUnkF64E10++;
+    }
+    return PlainPieceResult::EndOfPiece;
+}
+
 /**
  *
  *  rct2: 0x006DAEB9
@@ -8118,6 +8299,18 @@ bool Vehicle::UpdateTrackMotionForwards(rct_ride_entry_vehicle* vehicleEntry, Ri
 loc_6DAEB9:
     regs.cx = GetTrackType();
     int32_t trackType = GetTrackType();
+    if (vehicle_track_is_plain(curRide, trackType))
+    {
+        switch (UpdateTrackMotionForwardsPlainPiece(vehicleEntry, curRide, &otherVehicleIndex))
+        {
+            case PlainPieceResult::Settled:
+                return true;
+            case PlainPieceResult::Collided:
+                goto loc_6DB967;
+            case PlainPieceResult::EndOfPiece:
+                break;
+        }
+    }
     if (trackType == TrackElemType::HeartLineTransferUp || trackType == TrackElemType::HeartLineTransferDown)
     {
         if (track_progress == 80)
@@ -8206,13 +8399,14 @@ loc_6DAEB9:
     }
 
     regs.ax = track_progress + 1;
+    _motionStatsCurrent.Steps++;
 
     // Track Total Progress is in the two bytes before the move info list
-    uint16_t trackTotalProgress = GetTrackProgress();
-    if (regs.ax >= trackTotalProgress)
+    if (regs.ax >= GetTrackProgress())
     {
         UpdateCrossings();
 
+        _motionStatsCurrent.PieceChanges++;
         if (!UpdateTrackMotionForwardsGetNewTrack(trackType, curRide, rideEntry))
         {
             _vehicleMotionTrackFlags |= VEHICLE_UPDATE_MOTION_TRACK_FLAG_5;
@@ -8227,9 +8421,9 @@ loc_6DAEB9:
     UpdateHandleWaterSplash();
 
     // loc_6DB706
-    const auto moveInfo = GetMoveInfo();
     trackType = GetTrackType();
     {
+        const auto moveInfo = GetMoveInfo();
         auto loc = TrackLocation
             + CoordsXYZ{ moveInfo->x, moveInfo->y, moveInfo->z + RideTypeDescriptors[curRide->type].Heights.VehicleZOffset };
 
@@ -8550,10 +8744,12 @@ loc_6DBA33:;
     }
 
     regs.ax = track_progress - 1;
+    _motionStatsCurrent.Steps++;
     if (regs.ax == -1)
     {
         UpdateCrossings();
 
+        _motionStatsCurrent.PieceChanges++;
         if (!UpdateTrackMotionBackwardsGetNewTrack(trackType, curRide, reinterpret_cast<uint16_t*>(&regs.ax)))
         {
             goto loc_6DBE5E;
@@ -9442,6 +9638,15 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
         return UpdateTrackMotionMiniGolf(outStation);
     }
 
+    vehicle_motion_stats_roll_over();
+    _motionStatsCurrent.Calls++;
+    bool profiling = entity_scheduler_is_profiling();
+    std::chrono::steady_clock::time_point startTime;
+    if (profiling)
+    {
+        startTime = std::chrono::steady_clock::now();
+    }
+
     _vehicleF64E2C = 0;
     gCurrentVehicle = this;
     _vehicleMotionTrackFlags = 0;
@@ -9468,6 +9673,7 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
         {
             break;
         }
+        _motionStatsCurrent.Cars++;
         vehicleEntry = car->Entry();
         if (vehicleEntry == nullptr)
         {
@@ -9652,6 +9858,12 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
 
     vehicle->acceleration = curAcceleration;
 
+    if (profiling)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        _motionStatsCurrent.Nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
     // hook_setreturnregisters(&regs);
     if (outStation != nullptr)
         *outStation = _vehicleStationIndex;
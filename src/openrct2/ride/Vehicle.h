@@ -34,6 +34,15 @@ struct VehicleColour
     uint8_t Ternary;
 };
 
+struct Vehicle;
+
+// A train head that may be heard. Its sound params are only created once it is known to be among the loudest.
+struct VehicleSoundCandidate
+{
+    uint16_t Priority;
+    const Vehicle* Head;
+};
+
 #ifdef __TESTPAINT__
 #    pragma pack(push, 1)
 #endif // __TESTPAINT__
@@ -153,6 +162,32 @@ struct rct_vehicle_info
     uint8_t bank_rotation;       // 0x08
 };
 
+// The image and bounding box of a car worked out from its pitch, bank and direction
+struct VehicleSpriteSelection
+{
+    // Negative when the car has no image for its current state
+    int32_t BaseImageId;
+    uint8_t BoundBoxIndex;
+};
+
+/**
+ * The sprite selections of a car for each viewport rotation, worked out when the car moves rather than each time it is
+ * painted. They are only used while the state they were worked out from still matches the car.
+ */
+struct VehicleSpriteCache
+{
+    const rct_ride_entry_vehicle* Entry;
+    int16_t TrackType;
+    uint8_t SpriteDirection;
+    uint8_t VehicleSpriteType;
+    uint8_t BankRotation;
+    uint8_t SwingSprite;
+    uint8_t RestraintsPosition;
+    bool Inverted;
+    bool Valid;
+    std::array<VehicleSpriteSelection, 4> Selections;
+};
+
 struct Vehicle : SpriteBase
 {
     enum class Type : uint8_t
@@ -307,6 +342,8 @@ struct Vehicle : SpriteBase
     uint8_t seat_rotation;
     uint8_t target_seat_rotation;
     CoordsXY BoatLocation;
+    // Only used for painting, not part of the game state
+    VehicleSpriteCache SpriteCache;
 
     constexpr bool IsHead() const
     {
@@ -319,7 +356,8 @@ struct Vehicle : SpriteBase
     void Invalidate();
     void SetState(Vehicle::Status vehicleStatus, uint8_t subState = 0);
     bool IsGhost() const;
-    void UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>& vehicleSoundParamsList) const;
+    void UpdateSoundParams(std::vector<VehicleSoundCandidate>& candidates) const;
+    OpenRCT2::Audio::VehicleSoundParams CreateSoundParam(uint16_t priority) const;
     bool DodgemsCarWouldCollideAt(const CoordsXY& coords, uint16_t* spriteId) const;
     int32_t UpdateTrackMotion(int32_t* outStation);
     int32_t CableLiftUpdateTrackMotion();
@@ -355,7 +393,6 @@ private:
     uint16_t GetSoundPriority() const;
     const rct_vehicle_info* GetMoveInfo() const;
     uint16_t GetTrackProgress() const;
-    OpenRCT2::Audio::VehicleSoundParams CreateSoundParam(uint16_t priority) const;
     void CableLiftUpdate();
     bool CableLiftUpdateTrackMotionForwards();
     bool CableLiftUpdateTrackMotionBackwards();
@@ -405,6 +442,14 @@ private:
     void CheckIfMissing();
     bool CurrentTowerElementIsTop();
     bool UpdateTrackMotionForwards(rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, rct_ride_entry* rideEntry);
+    enum class PlainPieceResult : uint8_t
+    {
+        Settled,
+        Collided,
+        EndOfPiece,
+    };
+    PlainPieceResult UpdateTrackMotionForwardsPlainPiece(
+        rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, uint16_t* otherVehicleIndex);
     bool UpdateTrackMotionBackwards(rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, rct_ride_entry* rideEntry);
     int32_t UpdateTrackMotionPoweredRideAcceleration(
         rct_ride_entry_vehicle* vehicleEntry, uint32_t totalMass, const int32_t curAcceleration);
@@ -621,6 +666,24 @@ Vehicle* try_get_vehicle(uint16_t spriteIndex);
 void vehicle_update_all();
 void vehicle_sounds_update();
 
+struct VehicleMotionStats
+{
+    uint32_t Tick;
+    uint32_t Calls;
+    uint32_t Cars;
+    // Subpositions moved through by the generic path and by the path for plain pieces.
+    uint32_t Steps;
+    uint32_t PlainSteps;
+    uint32_t PieceChanges;
+    uint32_t MoveInfoLookups;
+    uint32_t CollisionChecks;
+    // Only measured while the profiler is running.
+    int64_t Nanoseconds;
+};
+
+// The work done by Vehicle::UpdateTrackMotion in the last tick.
+VehicleMotionStats vehicle_get_motion_stats();
+
 extern Vehicle* gCurrentVehicle;
 extern StationIndex _vehicleStationIndex;
 extern uint32_t _vehicleMotionTrackFlags;
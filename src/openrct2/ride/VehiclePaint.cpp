@@ -953,17 +953,23 @@ static void vehicle_sprite_paint(
     vehicle_visual_splash_effect(session, z, vehicle, vehicleEntry);
 }
 
+static void vehicle_sprite_select(VehicleSpriteSelection& selection, int32_t baseImageId, int32_t boundBoxIndex)
+{
+    selection.BaseImageId = baseImageId;
+    selection.BoundBoxIndex = static_cast<uint8_t>(boundBoxIndex);
+}
+
 // 6D520E
-static void vehicle_sprite_paint_6D520E(
-    paint_session* session, const Vehicle* vehicle, int32_t ebx, int32_t ecx, int32_t z,
+static void vehicle_sprite_select_6D520E(
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t ebx, int32_t ecx,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
-    vehicle_sprite_paint(session, vehicle, ebx + vehicle->SwingSprite, ecx, z, vehicleEntry);
+    vehicle_sprite_select(selection, ebx + vehicle->SwingSprite, ecx);
 }
 
 // 6D51EB
-static void vehicle_sprite_paint_6D51EB(
-    paint_session* session, const Vehicle* vehicle, int32_t ebx, int32_t z, const rct_ride_entry_vehicle* vehicleEntry)
+static void vehicle_sprite_select_6D51EB(
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t ebx, const rct_ride_entry_vehicle* vehicleEntry)
 {
     int32_t ecx = ebx / 2;
     if (vehicleEntry->flags & VEHICLE_ENTRY_FLAG_11)
@@ -975,26 +981,26 @@ static void vehicle_sprite_paint_6D51EB(
         ebx = ebx / 8;
     }
     ebx = (ebx * vehicleEntry->base_num_frames) + vehicle->SwingSprite + vehicleEntry->base_image_id;
-    vehicle_sprite_paint(session, vehicle, ebx, ecx, z, vehicleEntry);
+    vehicle_sprite_select(selection, ebx, ecx);
 }
 
 // 6D51DE
-static void vehicle_sprite_paint_6D51DE(
-    paint_session* session, const Vehicle* vehicle, int32_t ebx, int32_t z, const rct_ride_entry_vehicle* vehicleEntry)
+static void vehicle_sprite_select_6D51DE(
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t ebx, const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->restraints_position < 64)
     {
-        vehicle_sprite_paint_6D51EB(session, vehicle, ebx, z, vehicleEntry);
+        vehicle_sprite_select_6D51EB(selection, vehicle, ebx, vehicleEntry);
         return;
     }
     if (!(vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_RESTRAINT_ANIMATION))
     {
-        vehicle_sprite_paint_6D51EB(session, vehicle, ebx, z, vehicleEntry);
+        vehicle_sprite_select_6D51EB(selection, vehicle, ebx, vehicleEntry);
         return;
     }
     if (ebx & 7)
     {
-        vehicle_sprite_paint_6D51EB(session, vehicle, ebx, z, vehicleEntry);
+        vehicle_sprite_select_6D51EB(selection, vehicle, ebx, vehicleEntry);
         return;
     }
     int32_t ecx = ebx / 2;
@@ -1002,88 +1008,88 @@ static void vehicle_sprite_paint_6D51DE(
     ebx += ((vehicle->restraints_position - 64) / 64) * 4;
     ebx *= vehicleEntry->base_num_frames;
     ebx += vehicleEntry->restraint_image_id;
-    vehicle_sprite_paint(session, vehicle, ebx, ecx, z, vehicleEntry);
+    vehicle_sprite_select(selection, ebx, ecx);
 }
 
 // 6D51DE
 static void vehicle_sprite_0_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
-    vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+    vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
 }
 
 // 6D4EE7
 static void vehicle_sprite_0_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_BANKED)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 4) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F34
 static void vehicle_sprite_0_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_BANKED)
     {
         int32_t ecx = (imageDirection / 2) + 108;
         int32_t ebx = ((imageDirection + 16) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F0C
 static void vehicle_sprite_0_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_BANKED)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 4) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F5C
 static void vehicle_sprite_0_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_BANKED)
     {
         int32_t ecx = ((imageDirection / 2) ^ 8) + 108;
         int32_t ebx = ((imageDirection + 48) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F84
 static void vehicle_sprite_0_5(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1094,17 +1100,17 @@ static void vehicle_sprite_0_5(
     {
         int32_t ecx = (imageDirection / 8) + 124;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4FE4
 static void vehicle_sprite_0_6(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1115,17 +1121,17 @@ static void vehicle_sprite_0_6(
     {
         int32_t ecx = (imageDirection / 8) + 128;
         int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D5055
 static void vehicle_sprite_0_7(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1136,17 +1142,17 @@ static void vehicle_sprite_0_7(
     {
         int32_t ecx = (imageDirection / 8) + 132;
         int32_t ebx = (((imageDirection / 8) + 16) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D50C6
 static void vehicle_sprite_0_8(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1157,17 +1163,17 @@ static void vehicle_sprite_0_8(
     {
         int32_t ecx = (imageDirection / 8) + 136;
         int32_t ebx = (((imageDirection / 8) + 24) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D5137
 static void vehicle_sprite_0_9(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1178,17 +1184,17 @@ static void vehicle_sprite_0_9(
     {
         int32_t ecx = (imageDirection / 8) + 140;
         int32_t ebx = (((imageDirection / 8) + 32) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4FB1
 static void vehicle_sprite_0_10(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1199,17 +1205,17 @@ static void vehicle_sprite_0_10(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 124;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D501B
 static void vehicle_sprite_0_11(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1220,17 +1226,17 @@ static void vehicle_sprite_0_11(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 128;
         int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D508C
 static void vehicle_sprite_0_12(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1241,17 +1247,17 @@ static void vehicle_sprite_0_12(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 132;
         int32_t ebx = (((imageDirection / 8) + 20) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D50FD
 static void vehicle_sprite_0_13(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1262,17 +1268,17 @@ static void vehicle_sprite_0_13(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 136;
         int32_t ebx = (((imageDirection / 8) + 28) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D516E
 static void vehicle_sprite_0_14(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -1283,17 +1289,17 @@ static void vehicle_sprite_0_14(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 140;
         int32_t ebx = (((imageDirection / 8) + 36) * vehicleEntry->base_num_frames) + vehicleEntry->inline_twist_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4EE4
 static void vehicle_sprite_0_16(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -1301,17 +1307,17 @@ static void vehicle_sprite_0_16(
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 4) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F31
 static void vehicle_sprite_0_17(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -1319,17 +1325,17 @@ static void vehicle_sprite_0_17(
     {
         int32_t ecx = (imageDirection / 2) + 108;
         int32_t ebx = ((imageDirection + 16) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F09
 static void vehicle_sprite_0_18(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -1337,17 +1343,17 @@ static void vehicle_sprite_0_18(
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 4) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4F59
 static void vehicle_sprite_0_19(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -1355,156 +1361,156 @@ static void vehicle_sprite_0_19(
     {
         int32_t ecx = ((imageDirection / 2) ^ 8) + 108;
         int32_t ebx = ((imageDirection + 48) * vehicleEntry->base_num_frames) + vehicleEntry->banked_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D51D7
 static void vehicle_sprite_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3DE4:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_0_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_0_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_0_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_0_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_0_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_0_5(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_5(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_0_6(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_6(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_0_7(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_7(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_0_8(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_8(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_0_9(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_9(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_0_10(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_10(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_0_11(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_11(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_0_12(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_12(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_0_13(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_13(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_0_14(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_14(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_0_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_0_16(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_16(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_0_17(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_17(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_0_18(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_18(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_0_19(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_0_19(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D4614
 static void vehicle_sprite_1_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPES)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4662
 static void vehicle_sprite_1_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_BANKED_TRANSITIONS)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (imageDirection * vehicleEntry->base_num_frames) + vehicleEntry->flat_to_gentle_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D46DB
 static void vehicle_sprite_1_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_WHILE_BANKED_TRANSITIONS)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->flat_bank_to_gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_1_1(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_1_1(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D467D
 static void vehicle_sprite_1_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_BANKED_TRANSITIONS)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection + 32) * vehicleEntry->base_num_frames) + vehicleEntry->flat_to_gentle_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D46FD
 static void vehicle_sprite_1_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_WHILE_BANKED_TRANSITIONS)
@@ -1512,88 +1518,88 @@ static void vehicle_sprite_1_4(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames)
             + vehicleEntry->flat_bank_to_gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_1_3(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_1_3(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D460D
 static void vehicle_sprite_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3C04:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_1_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_1_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_1_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_1_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_1_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_1_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_1_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_1_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_1_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_1_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D4791
 static void vehicle_sprite_2_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPES)
@@ -1602,41 +1608,41 @@ static void vehicle_sprite_2_0(
         {
             int32_t ecx = (imageDirection / 2) + 16;
             int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             int32_t ecx = (imageDirection / 2) + 16;
             int32_t ebx = ((imageDirection + 8) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4833
 static void vehicle_sprite_2_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TRANSITIONS)
     {
         int32_t ecx = (imageDirection / 2) + 16;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_to_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D48D6
 static void vehicle_sprite_2_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TURNS)
@@ -1646,24 +1652,24 @@ static void vehicle_sprite_2_2(
         {
             ecx += 108;
             int32_t ebx = (imageDirection * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             ecx += 16;
             int32_t ebx = (imageDirection * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4858
 static void vehicle_sprite_2_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -1671,17 +1677,17 @@ static void vehicle_sprite_2_3(
         int32_t ecx = (imageDirection / 2) + 16;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames)
             + vehicleEntry->gentle_slope_to_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4910
 static void vehicle_sprite_2_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TURNS)
@@ -1692,164 +1698,164 @@ static void vehicle_sprite_2_4(
             ecx = (ecx ^ 8) + 108;
             int32_t ebx = ((imageDirection + 32) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             ecx += 16;
             int32_t ebx = ((imageDirection + 32) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D476C
 static void vehicle_sprite_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3CA4:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_2_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_2_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_2_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_2_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_2_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_2_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_2_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_2_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_2_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_2_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D49DC
 static void vehicle_sprite_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (!(vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_STEEP_SLOPES))
     {
-        vehicle_sprite_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2(selection, vehicle, imageDirection, vehicleEntry);
     }
     else
     {
         int32_t ecx = (imageDirection / 4) + 32;
         int32_t ebx = ((imageDirection / 4) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
 }
 
 // 6D4A31
 static void vehicle_sprite_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (!(vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_STEEP_SLOPES))
     {
-        vehicle_sprite_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2(selection, vehicle, imageDirection, vehicleEntry);
     }
     else
     {
         int32_t ecx = (imageDirection / 2) + 40;
         int32_t ebx = ((imageDirection + 16) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
 }
 
 // 6D463D
 static void vehicle_sprite_5_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPES)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D469B
 static void vehicle_sprite_5_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_BANKED_TRANSITIONS)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection + 64) * vehicleEntry->base_num_frames) + vehicleEntry->flat_to_gentle_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4722
 static void vehicle_sprite_5_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_WHILE_BANKED_TRANSITIONS)
@@ -1857,34 +1863,34 @@ static void vehicle_sprite_5_2(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames)
             + vehicleEntry->flat_bank_to_gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_5_1(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_5_1(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D46B9
 static void vehicle_sprite_5_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_BANKED_TRANSITIONS)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection + 96) * vehicleEntry->base_num_frames) + vehicleEntry->flat_to_gentle_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4747
 static void vehicle_sprite_5_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_FLAT_TO_GENTLE_SLOPE_WHILE_BANKED_TRANSITIONS)
@@ -1892,88 +1898,88 @@ static void vehicle_sprite_5_4(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames)
             + vehicleEntry->flat_bank_to_gentle_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_5_3(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_5_3(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4636
 static void vehicle_sprite_5(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3C54:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_5_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_5_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_5_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_5_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_5_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_5_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_5_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_5_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_5_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_5_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D47E4
 static void vehicle_sprite_6_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPES)
@@ -1982,24 +1988,24 @@ static void vehicle_sprite_6_0(
         {
             int32_t ecx = ((imageDirection / 2) ^ 8) + 16;
             int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             int32_t ecx = ((imageDirection / 2) ^ 8) + 16;
             int32_t ebx = ((imageDirection + 40) * vehicleEntry->base_num_frames) + vehicleEntry->gentle_slope_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4880
 static void vehicle_sprite_6_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2007,17 +2013,17 @@ static void vehicle_sprite_6_1(
         int32_t ecx = ((imageDirection / 2) ^ 8) + 16;
         int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames)
             + vehicleEntry->gentle_slope_to_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4953
 static void vehicle_sprite_6_2(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TURNS)
@@ -2028,25 +2034,25 @@ static void vehicle_sprite_6_2(
             ecx += 108;
             int32_t ebx = ((imageDirection + 64) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             ecx = (ecx ^ 8) + 16;
             int32_t ebx = ((imageDirection + 64) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D48AB
 static void vehicle_sprite_6_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2054,17 +2060,17 @@ static void vehicle_sprite_6_3(
         int32_t ecx = ((imageDirection / 2) ^ 8) + 16;
         int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames)
             + vehicleEntry->gentle_slope_to_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4996
 static void vehicle_sprite_6_4(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_GENTLE_SLOPE_BANKED_TURNS)
@@ -2075,266 +2081,266 @@ static void vehicle_sprite_6_4(
             ecx = (ecx ^ 8) + 108;
             int32_t ebx = ((imageDirection + 96) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
         else
         {
             ecx = (ecx ^ 8) + 16;
             int32_t ebx = ((imageDirection + 96) * vehicleEntry->base_num_frames)
                 + vehicleEntry->gentle_slope_bank_turn_image_id;
-            vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+            vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
         }
     }
     else
     {
-        vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D47DD
 static void vehicle_sprite_6(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3CF4:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_6_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_6_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_6_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_6_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_6_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_6_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_6_2(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_2(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_6_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_6_4(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_6_4(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D4A05
 static void vehicle_sprite_7(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_STEEP_SLOPES)
     {
         int32_t ecx = ((imageDirection / 4) ^ 4) + 32;
         int32_t ebx = (((imageDirection / 4) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4A59
 static void vehicle_sprite_8(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_STEEP_SLOPES)
     {
         int32_t ecx = ((imageDirection / 2) ^ 8) + 40;
         int32_t ebx = ((imageDirection + 48) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4A81
 static void vehicle_sprite_9(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 56;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4AE8
 static void vehicle_sprite_10(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 2) + 60;
         int32_t ebx = ((imageDirection + 8) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4B57
 static void vehicle_sprite_11(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 76;
         int32_t ebx = (((imageDirection / 8) + 72) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4BB7
 static void vehicle_sprite_12(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 80;
         int32_t ebx = (((imageDirection / 8) + 80) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4C17
 static void vehicle_sprite_13(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 84;
         int32_t ebx = (((imageDirection / 8) + 88) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4C77
 static void vehicle_sprite_14(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 88;
         int32_t ebx = (((imageDirection / 8) + 96) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4CD7
 static void vehicle_sprite_15(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 92;
         int32_t ebx = (((imageDirection / 8) + 104) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D37
 static void vehicle_sprite_16(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_VERTICAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 96;
         int32_t ebx = (((imageDirection / 8) + 112) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_4(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_4(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4AA3
 static void vehicle_sprite_17(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2349,17 +2355,17 @@ static void vehicle_sprite_17(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 56;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4B0D
 static void vehicle_sprite_18(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2374,17 +2380,17 @@ static void vehicle_sprite_18(
     {
         int32_t ecx = ((imageDirection / 2) ^ 8) + 60;
         int32_t ebx = ((imageDirection + 40) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4B80
 static void vehicle_sprite_19(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2395,17 +2401,17 @@ static void vehicle_sprite_19(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 76;
         int32_t ebx = (((imageDirection / 8) + 76) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4BE0
 static void vehicle_sprite_20(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2416,17 +2422,17 @@ static void vehicle_sprite_20(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 80;
         int32_t ebx = (((imageDirection / 8) + 84) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4C40
 static void vehicle_sprite_21(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2437,17 +2443,17 @@ static void vehicle_sprite_21(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 84;
         int32_t ebx = (((imageDirection / 8) + 92) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4CA0
 static void vehicle_sprite_22(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2458,17 +2464,17 @@ static void vehicle_sprite_22(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 88;
         int32_t ebx = (((imageDirection / 8) + 100) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D00
 static void vehicle_sprite_23(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2479,17 +2485,17 @@ static void vehicle_sprite_23(
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 92;
         int32_t ebx = (((imageDirection / 8) + 108) * vehicleEntry->base_num_frames) + vehicleEntry->vertical_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_8(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_8(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D51A5
 static void vehicle_sprite_24(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
@@ -2501,34 +2507,34 @@ static void vehicle_sprite_24(
         int32_t eax = ((vehicle->vehicle_sprite_type - 24) * 4);
         int32_t ecx = (imageDirection / 8) + eax + 144;
         int32_t ebx = (((imageDirection / 8) + eax) * vehicleEntry->base_num_frames) + vehicleEntry->corkscrew_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_paint_6D51DE(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_select_6D51DE(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D67
 static void vehicle_sprite_50_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4DB5
 static void vehicle_sprite_50_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2536,17 +2542,17 @@ static void vehicle_sprite_50_1(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = ((imageDirection / 8) * vehicleEntry->base_num_frames)
             + vehicleEntry->diagonal_to_gentle_slope_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4DD3
 static void vehicle_sprite_50_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2554,139 +2560,139 @@ static void vehicle_sprite_50_3(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames)
             + vehicleEntry->diagonal_to_gentle_slope_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D60
 static void vehicle_sprite_50(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3D44:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_50_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_50_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_50_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_50_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_50_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_50_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D4E3A
 static void vehicle_sprite_51(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 100;
         int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4E8F
 static void vehicle_sprite_52(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = (imageDirection / 8) + 104;
         int32_t ebx = (((imageDirection / 8) + 16) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D90
 static void vehicle_sprite_53_0(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 4) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4DF4
 static void vehicle_sprite_53_1(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2694,17 +2700,17 @@ static void vehicle_sprite_53_1(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 8) * vehicleEntry->base_num_frames)
             + vehicleEntry->diagonal_to_gentle_slope_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4E15
 static void vehicle_sprite_53_3(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_GENTLE_SLOPE_BANKED_TRANSITIONS)
@@ -2712,131 +2718,131 @@ static void vehicle_sprite_53_3(
         int32_t ecx = imageDirection / 2;
         int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames)
             + vehicleEntry->diagonal_to_gentle_slope_bank_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4D89
 static void vehicle_sprite_53(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     // 0x009A3D94:
     switch (vehicle->bank_rotation)
     {
         case 0:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 1:
-            vehicle_sprite_53_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 2:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 3:
-            vehicle_sprite_53_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 4:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 5:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 6:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 7:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 8:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 9:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 10:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 11:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 12:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 13:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 14:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 15:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 16:
-            vehicle_sprite_53_1(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_1(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 17:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 18:
-            vehicle_sprite_53_3(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_3(selection, vehicle, imageDirection, vehicleEntry);
             break;
         case 19:
-            vehicle_sprite_53_0(session, vehicle, imageDirection, z, vehicleEntry);
+            vehicle_sprite_53_0(selection, vehicle, imageDirection, vehicleEntry);
             break;
     }
 }
 
 // 6D4E63
 static void vehicle_sprite_54(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 100;
         int32_t ebx = (((imageDirection / 8) + 12) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4EB8
 static void vehicle_sprite_55(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_DIAGONAL_SLOPES)
     {
         int32_t ecx = ((imageDirection / 8) ^ 2) + 104;
         int32_t ebx = (((imageDirection / 8) + 20) * vehicleEntry->base_num_frames) + vehicleEntry->diagonal_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_0(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_0(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D47DA
 static void vehicle_sprite_56(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
-    vehicle_sprite_6(session, vehicle, imageDirection, z, vehicleEntry);
+    vehicle_sprite_6(selection, vehicle, imageDirection, vehicleEntry);
 }
 
 // 6D4A02
 static void vehicle_sprite_57(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -2844,17 +2850,17 @@ static void vehicle_sprite_57(
     {
         int32_t ecx = ((imageDirection / 4) ^ 4) + 32;
         int32_t ebx = (((imageDirection / 4) + 8) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4A56
 static void vehicle_sprite_58(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     vehicleEntry--;
@@ -2862,34 +2868,34 @@ static void vehicle_sprite_58(
     {
         int32_t ecx = ((imageDirection / 2) ^ 8) + 40;
         int32_t ebx = ((imageDirection + 48) * vehicleEntry->base_num_frames) + vehicleEntry->steep_slope_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_6(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_6(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 6D4773
 static void vehicle_sprite_59(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
     if (vehicleEntry->sprite_flags & VEHICLE_SPRITE_FLAG_CURVED_LIFT_HILL)
     {
         int32_t ecx = (imageDirection / 2) + 16;
         int32_t ebx = (imageDirection * vehicleEntry->base_num_frames) + vehicleEntry->curved_lift_hill_image_id;
-        vehicle_sprite_paint_6D520E(session, vehicle, ebx, ecx, z, vehicleEntry);
+        vehicle_sprite_select_6D520E(selection, vehicle, ebx, ecx, vehicleEntry);
     }
     else
     {
-        vehicle_sprite_2(session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_2(selection, vehicle, imageDirection, vehicleEntry);
     }
 }
 
 // 0x009A3B14:
 using vehicle_sprite_func = void (*)(
-    paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
+    VehicleSpriteSelection& selection, const Vehicle* vehicle, int32_t imageDirection,
     const rct_ride_entry_vehicle* vehicleEntry);
 
 // clang-format off
@@ -2957,6 +2963,27 @@ static constexpr const vehicle_sprite_func vehicle_sprite_funcs[] = {
 };
 // clang-format on
 
+static VehicleSpriteSelection vehicle_select_sprite(
+    const Vehicle* vehicle, int32_t imageDirection, const rct_ride_entry_vehicle* vehicleEntry)
+{
+    VehicleSpriteSelection selection{ -1, 0 };
+    if (vehicle->vehicle_sprite_type < std::size(vehicle_sprite_funcs))
+    {
+        vehicle_sprite_funcs[vehicle->vehicle_sprite_type](selection, vehicle, imageDirection, vehicleEntry);
+    }
+    return selection;
+}
+
+static bool vehicle_sprite_cache_matches(
+    const VehicleSpriteCache& cache, const Vehicle* vehicle, const rct_ride_entry_vehicle* vehicleEntry)
+{
+    return cache.Valid && cache.Entry == vehicleEntry && cache.TrackType == vehicle->track_type
+        && cache.SpriteDirection == vehicle->sprite_direction && cache.VehicleSpriteType == vehicle->vehicle_sprite_type
+        && cache.BankRotation == vehicle->bank_rotation && cache.SwingSprite == vehicle->SwingSprite
+        && cache.RestraintsPosition == vehicle->restraints_position
+        && cache.Inverted == vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES);
+}
+
 /**
  *
  *  rct2: 0x006D5600
@@ -3121,21 +3148,92 @@ void vehicle_visual_default(
     paint_session* session, int32_t imageDirection, int32_t z, const Vehicle* vehicle,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
-    if (vehicle->vehicle_sprite_type < std::size(vehicle_sprite_funcs))
+    VehicleSpriteSelection selection;
+    const auto& cache = vehicle->SpriteCache;
+    if (vehicle_sprite_cache_matches(cache, vehicle, vehicleEntry)
+        && ((imageDirection - vehicle->sprite_direction) & 7) == 0)
+    {
+        selection = cache.Selections[((imageDirection - vehicle->sprite_direction) & 31) >> 3];
+    }
+    else
+    {
+        selection = vehicle_select_sprite(vehicle, imageDirection, vehicleEntry);
+    }
+
+    if (selection.BaseImageId >= 0)
     {
-        vehicle_sprite_funcs[vehicle->vehicle_sprite_type](session, vehicle, imageDirection, z, vehicleEntry);
+        vehicle_sprite_paint(session, vehicle, selection.BaseImageId, selection.BoundBoxIndex, z, vehicleEntry);
     }
 }
 
+static const rct_ride_entry_vehicle* vehicle_get_paint_entry(const Vehicle* vehicle)
+{
+    if (vehicle->ride_subtype == RIDE_ENTRY_INDEX_NULL)
+    {
+        return &CableLiftVehicle;
+    }
+
+    auto rideEntry = vehicle->GetRideEntry();
+    if (rideEntry == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto vehicleEntryIndex = vehicle->vehicle_type;
+    if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
+    {
+        vehicleEntryIndex++;
+    }
+
+    if (vehicleEntryIndex >= std::size(rideEntry->vehicles))
+    {
+        return nullptr;
+    }
+    return &rideEntry->vehicles[vehicleEntryIndex];
+}
+
+/**
+ * Works out the sprite selections of the car for each viewport rotation when anything they depend on has changed since
+ * the last update.
+ */
+void vehicle_update_sprite_cache(Vehicle* vehicle)
+{
+    auto& cache = vehicle->SpriteCache;
+    const auto* vehicleEntry = vehicle_get_paint_entry(vehicle);
+    if (vehicleEntry == nullptr
+        || (vehicleEntry->car_visual != VEHICLE_VISUAL_DEFAULT && vehicleEntry->car_visual != VEHICLE_VISUAL_REVERSER))
+    {
+        cache.Valid = false;
+        return;
+    }
+
+    if (vehicle_sprite_cache_matches(cache, vehicle, vehicleEntry))
+    {
+        return;
+    }
+
+    cache.Entry = vehicleEntry;
+    cache.TrackType = vehicle->track_type;
+    cache.SpriteDirection = vehicle->sprite_direction;
+    cache.VehicleSpriteType = vehicle->vehicle_sprite_type;
+    cache.BankRotation = vehicle->bank_rotation;
+    cache.SwingSprite = vehicle->SwingSprite;
+    cache.RestraintsPosition = vehicle->restraints_position;
+    cache.Inverted = vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES);
+    for (int32_t rotation = 0; rotation < static_cast<int32_t>(cache.Selections.size()); rotation++)
+    {
+        auto imageDirection = ((rotation * 8) + vehicle->sprite_direction) & 31;
+        cache.Selections[rotation] = vehicle_select_sprite(vehicle, imageDirection, vehicleEntry);
+    }
+    cache.Valid = true;
+}
+
 /**
  *
  *  rct2: 0x006D4244
  */
 void vehicle_paint(paint_session* session, const Vehicle* vehicle, int32_t imageDirection)
 {
-    rct_ride_entry* rideEntry = nullptr;
-    const rct_ride_entry_vehicle* vehicleEntry;
-
     int32_t x = vehicle->x;
     int32_t y = vehicle->y;
     int32_t z = vehicle->z;
@@ -3147,30 +3245,14 @@ void vehicle_paint(paint_session* session, const Vehicle* vehicle, int32_t image
         return;
     }
 
-    if (vehicle->ride_subtype == RIDE_ENTRY_INDEX_NULL)
+    const auto* vehicleEntry = vehicle_get_paint_entry(vehicle);
+    if (vehicleEntry == nullptr)
     {
-        vehicleEntry = &CableLiftVehicle;
+        return;
     }
-    else
+    if (vehicle->ride_subtype != RIDE_ENTRY_INDEX_NULL && vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
     {
-        rideEntry = vehicle->GetRideEntry();
-        if (rideEntry == nullptr)
-        {
-            return;
-        }
-
-        auto vehicleEntryIndex = vehicle->vehicle_type;
-        if (vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES))
-        {
-            vehicleEntryIndex++;
-            z += 16;
-        }
-
-        if (vehicleEntryIndex >= std::size(rideEntry->vehicles))
-        {
-            return;
-        }
-        vehicleEntry = &rideEntry->vehicles[vehicleEntryIndex];
+        z += 16;
     }
 
     switch (vehicleEntry->car_visual)
@@ -9,9 +9,214 @@
 
 #include "VehicleSubpositionData.h"
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Each subposition is encoded as a flags byte, followed by the fields that could not be expressed by the flags:
+ * - two bits per axis giving the step from the previous position: none, +1, -1 or an explicit int16_t,
+ * - a bit for an explicit direction, vehicle_sprite_type and bank_rotation,
+ * - a bit for a count byte repeating the same steps for that many more subpositions.
+ * The first subposition is relative to a zeroed one.
+ */
+namespace VehicleInfoEncoding
+{
+    enum : uint8_t
+    {
+        StepNone = 0,
+        StepIncrement = 1,
+        StepDecrement = 2,
+        StepExplicit = 3,
+        StepMask = 3,
+        FlagAttitude = 1 << 6,
+        FlagRepeat = 1 << 7,
+    };
+
+    static constexpr uint8_t GetStep(int16_t previous, int16_t current)
+    {
+        if (current == previous)
+            return StepNone;
+        if (current == previous + 1)
+            return StepIncrement;
+        if (current == previous - 1)
+            return StepDecrement;
+        return StepExplicit;
+    }
+
+    static constexpr uint8_t GetFlags(const rct_vehicle_info& previous, const rct_vehicle_info& current)
+    {
+        uint8_t flags = GetStep(previous.x, current.x) | (GetStep(previous.y, current.y) << 2)
+            | (GetStep(previous.z, current.z) << 4);
+        if (current.direction != previous.direction || current.vehicle_sprite_type != previous.vehicle_sprite_type
+            || current.bank_rotation != previous.bank_rotation)
+        {
+            flags |= FlagAttitude;
+        }
+        return flags;
+    }
+
+    static constexpr bool IsRepeatable(uint8_t flags)
+    {
+        if (flags & FlagAttitude)
+            return false;
+        for (int32_t shift = 0; shift < 6; shift += 2)
+        {
+            if (((flags >> shift) & StepMask) == StepExplicit)
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr void Put(uint8_t* out, size_t& length, uint8_t value)
+    {
+        if (out != nullptr)
+            out[length] = value;
+        length++;
+    }
+
+    static constexpr void PutExplicit(uint8_t* out, size_t& length, uint8_t flags, int32_t shift, int16_t value)
+    {
+        if (((flags >> shift) & StepMask) == StepExplicit)
+        {
+            Put(out, length, static_cast<uint16_t>(value) & 0xFF);
+            Put(out, length, static_cast<uint16_t>(value) >> 8);
+        }
+    }
+
+    /**
+     * Encodes count subpositions into out, or only measures them when out is nullptr. Returns the encoded length.
+     */
+    static constexpr size_t Encode(const rct_vehicle_info* data, size_t count, uint8_t* out)
+    {
+        rct_vehicle_info previous{};
+        size_t length = 0;
+        size_t i = 0;
+        while (i < count)
+        {
+            const auto& current = data[i];
+            uint8_t flags = GetFlags(previous, current);
+            size_t flagsPosition = length;
+            Put(out, length, flags);
+            PutExplicit(out, length, flags, 0, current.x);
+            PutExplicit(out, length, flags, 2, current.y);
+            PutExplicit(out, length, flags, 4, current.z);
+            if (flags & FlagAttitude)
+            {
+                Put(out, length, current.direction);
+                Put(out, length, current.vehicle_sprite_type);
+                Put(out, length, current.bank_rotation);
+            }
+            previous = current;
+            i++;
+
+            if (IsRepeatable(flags))
+            {
+                uint8_t repeat = 0;
+                while (i < count && repeat < 255 && GetFlags(previous, data[i]) == flags)
+                {
+                    previous = data[i];
+                    repeat++;
+                    i++;
+                }
+                if (repeat != 0)
+                {
+                    if (out != nullptr)
+                        out[flagsPosition] |= FlagRepeat;
+                    Put(out, length, repeat);
+                }
+            }
+        }
+        return length;
+    }
+
+    template<size_t TLength, size_t TCount>
+    static constexpr std::array<uint8_t, TLength> Encode(const rct_vehicle_info (&data)[TCount])
+    {
+        std::array<uint8_t, TLength> result{};
+        Encode(data, TCount, result.data());
+        return result;
+    }
+
+    static int16_t ApplyStep(int16_t value, uint8_t step, const uint8_t*& in)
+    {
+        switch (step)
+        {
+            case StepIncrement:
+                return value + 1;
+            case StepDecrement:
+                return value - 1;
+            case StepExplicit:
+            {
+                auto result = static_cast<int16_t>(in[0] | (in[1] << 8));
+                in += 2;
+                return result;
+            }
+            default:
+                return value;
+        }
+    }
+
+    static void Decode(const uint8_t* in, rct_vehicle_info* out, size_t count)
+    {
+        rct_vehicle_info current{};
+        size_t i = 0;
+        while (i < count)
+        {
+            uint8_t flags = *in++;
+            current.x = ApplyStep(current.x, flags & StepMask, in);
+            current.y = ApplyStep(current.y, (flags >> 2) & StepMask, in);
+            current.z = ApplyStep(current.z, (flags >> 4) & StepMask, in);
+            if (flags & FlagAttitude)
+            {
+                current.direction = in[0];
+                current.vehicle_sprite_type = in[1];
+                current.bank_rotation = in[2];
+                in += 3;
+            }
+            out[i++] = current;
+
+            if (flags & FlagRepeat)
+            {
+                uint8_t repeat = *in++;
+                for (; repeat != 0 && i < count; repeat--)
+                {
+                    current.x = ApplyStep(current.x, flags & StepMask, in);
+                    current.y = ApplyStep(current.y, (flags >> 2) & StepMask, in);
+                    current.z = ApplyStep(current.z, (flags >> 4) & StepMask, in);
+                    out[i++] = current;
+                }
+            }
+        }
+    }
+} // namespace VehicleInfoEncoding
+
+// Owns the decoded subpositions, which live for as long as the game as the lists only hold on to a pointer.
+static std::mutex _decodeMutex;
+static std::vector<std::unique_ptr<rct_vehicle_info[]>> _decodedLists;
+
+const rct_vehicle_info* rct_vehicle_info_list::Decode() const
+{
+    std::lock_guard<std::mutex> lock(_decodeMutex);
+    auto info = decoded.load(std::memory_order_relaxed);
+    if (info == nullptr)
+    {
+        auto storage = std::make_unique<rct_vehicle_info[]>(size);
+        VehicleInfoEncoding::Decode(encoded, storage.get(), size);
+        info = storage.get();
+        _decodedLists.push_back(std::move(storage));
+        decoded.store(info, std::memory_order_release);
+    }
+    return info;
+}
+
+// Only the encoded form of the source arrays is referenced, the arrays themselves are not emitted into the binary.
 #define CREATE_VEHICLE_INFO(VAR, ...)                                                                                          \
     static constexpr const rct_vehicle_info VAR##_data[] = __VA_ARGS__;                                                        \
-    static constexpr const rct_vehicle_info_list VAR = { static_cast<uint16_t>(std::size(VAR##_data)), VAR##_data };
+    static constexpr const auto VAR##_encoded = VehicleInfoEncoding::Encode<VehicleInfoEncoding::Encode(                       \
+        VAR##_data, std::size(VAR##_data), nullptr)>(VAR##_data);                                                              \
+    static rct_vehicle_info_list VAR = { static_cast<uint16_t>(std::size(VAR##_data)), VAR##_encoded.data() };
 
 // clang-format off
 CREATE_VEHICLE_INFO(TrackVehicleInfo_8BE57A, {
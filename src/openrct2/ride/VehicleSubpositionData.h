@@ -11,12 +11,27 @@
 
 #include "Vehicle.h"
 
+#include <atomic>
 #include <cstdint>
 
+/**
+ * The subpositions of a track piece. They are stored delta encoded as consecutive positions mostly step by one
+ * and are only decoded the first time a vehicle moves along the piece.
+ */
 struct rct_vehicle_info_list
 {
     uint16_t size;
-    const rct_vehicle_info* info;
+    const uint8_t* encoded;
+    mutable std::atomic<const rct_vehicle_info*> decoded{};
+
+    const rct_vehicle_info* GetInfo() const
+    {
+        auto info = decoded.load(std::memory_order_acquire);
+        return info != nullptr ? info : Decode();
+    }
+
+private:
+    const rct_vehicle_info* Decode() const;
 };
 
 extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[17];
@@ -0,0 +1,299 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SavedGameRepository.h"
+
+#include "../Context.h"
+#include "../PlatformEnvironment.h"
+#include "../core/FileIndex.hpp"
+#include "../core/MappedFileStream.h"
+#include "../interface/Colour.h"
+#include "../localisation/Language.h"
+#include "../localisation/Localisation.h"
+#include "../rct12/RCT12.h"
+#include "../rct12/SawyerChunkReader.h"
+#include "../rct2/RCT2.h"
+#include "../world/Map.h"
+#include "Scenario.h"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+using namespace OpenRCT2;
+
+// Same colours as the map window uses for these
+static constexpr const uint8_t PreviewWaterColour = PALETTE_INDEX_195;
+static constexpr const uint8_t PreviewPathColour = PALETTE_INDEX_17;
+static constexpr const uint8_t PreviewTrackColour = PALETTE_INDEX_183;
+static constexpr const uint8_t PreviewEntranceColour = PALETTE_INDEX_186;
+static constexpr const uint8_t PreviewTerrainColour[] = {
+    PALETTE_INDEX_73,  // TERRAIN_GRASS
+    PALETTE_INDEX_40,  // TERRAIN_SAND
+    PALETTE_INDEX_108, // TERRAIN_DIRT
+    PALETTE_INDEX_12,  // TERRAIN_ROCK
+    PALETTE_INDEX_62,  // TERRAIN_MARTIAN
+    PALETTE_INDEX_10,  // TERRAIN_CHECKERBOARD
+    PALETTE_INDEX_73,  // TERRAIN_GRASS_CLUMPS
+    PALETTE_INDEX_141, // TERRAIN_ICE
+    PALETTE_INDEX_172, // TERRAIN_GRID_RED
+    PALETTE_INDEX_54,  // TERRAIN_GRID_YELLOW
+    PALETTE_INDEX_162, // TERRAIN_GRID_BLUE
+    PALETTE_INDEX_102, // TERRAIN_GRID_GREEN
+    PALETTE_INDEX_111, // TERRAIN_SAND_DARK
+    PALETTE_INDEX_222, // TERRAIN_SAND_LIGHT
+};
+
+class SavedGameFileIndex final : public FileIndex<SavedGamePreview>
+{
+private:
+    static constexpr uint32_t MAGIC_NUMBER = 0x58445653; // SVDX
+    static constexpr uint16_t VERSION = 1;
+    static constexpr auto PATTERN = "*.sv6";
+
+public:
+    explicit SavedGameFileIndex(const IPlatformEnvironment& env)
+        : FileIndex(
+            "saved game index", MAGIC_NUMBER, VERSION, env.GetFilePath(PATHID::CACHE_SAVES), std::string(PATTERN),
+            std::vector<std::string>({
+                env.GetDirectoryPath(DIRBASE::USER, DIRID::SAVE),
+            }))
+    {
+    }
+
+protected:
+    std::tuple<bool, SavedGamePreview> Create(int32_t, const std::string& path) const override
+    {
+        SavedGamePreview item;
+        item.Path = path;
+        try
+        {
+            ReadSavedGame(path, item);
+        }
+        catch (const std::exception& e)
+        {
+            // Keep the file in the index without details so it is not read again until it changes
+            log_verbose("Unable to read saved game '%s': %s", path.c_str(), e.what());
+        }
+        return std::make_tuple(true, item);
+    }
+
+    void Serialise(IStream* stream, const SavedGamePreview& item) const override
+    {
+        stream->WriteString(item.Path);
+        stream->WriteString(item.ParkName);
+        stream->WriteValue(item.ElapsedMonths);
+        stream->WriteValue(item.NumGuests);
+        stream->WriteValue(item.ParkRating);
+        stream->WriteValue<uint8_t>(item.Pixels.empty() ? 0 : 1);
+        if (!item.Pixels.empty())
+        {
+            stream->Write(item.Pixels.data(), item.Pixels.size());
+        }
+    }
+
+    SavedGamePreview Deserialise(IStream* stream) const override
+    {
+        SavedGamePreview item;
+        item.Path = stream->ReadStdString();
+        item.ParkName = stream->ReadStdString();
+        item.ElapsedMonths = stream->ReadValue<uint16_t>();
+        item.NumGuests = stream->ReadValue<uint16_t>();
+        item.ParkRating = stream->ReadValue<uint16_t>();
+        if (stream->ReadValue<uint8_t>() != 0)
+        {
+            item.Pixels.resize(SAVED_GAME_PREVIEW_SIZE * SAVED_GAME_PREVIEW_SIZE);
+            stream->Read(item.Pixels.data(), item.Pixels.size());
+        }
+        return item;
+    }
+
+private:
+    /**
+     * Reads the chunks of a saved game the same way S6Importer does, without loading its packed objects.
+     */
+    static void ReadSavedGame(const std::string& path, SavedGamePreview& item)
+    {
+        auto stream = OpenFileForReading(path);
+        auto chunkReader = SawyerChunkReader(stream.get());
+
+        auto s6 = std::make_unique<rct_s6_data>();
+        chunkReader.ReadChunk(&s6->header, sizeof(s6->header));
+        if (s6->header.type != S6_TYPE_SAVEDGAME)
+        {
+            throw std::runtime_error("Park is not a saved game.");
+        }
+        for (uint16_t i = 0; i < s6->header.num_packed_objects; i++)
+        {
+            stream->ReadValue<rct_object_entry>();
+            chunkReader.SkipChunk();
+        }
+        chunkReader.ReadChunks({
+            { &s6->objects, sizeof(s6->objects) },
+            { &s6->elapsed_months, 16 },
+            { &s6->tile_elements, sizeof(s6->tile_elements) },
+            { &s6->next_free_tile_element_pointer_index, 3048816 },
+        });
+
+        item.ParkName = GetUserString(*s6, s6->park_name);
+        item.ElapsedMonths = s6->elapsed_months;
+        item.NumGuests = s6->guests_in_park;
+        item.ParkRating = s6->park_rating;
+        item.Pixels = CreatePreview(*s6);
+    }
+
+    static std::string GetUserString(const rct_s6_data& s6, rct_string_id stringId)
+    {
+        if (!is_user_string_id(stringId))
+        {
+            return {};
+        }
+        const auto originalString = s6.custom_strings[(stringId - USER_STRING_START) % 1024];
+        std::string_view originalStringView(originalString, USER_STRING_MAX_LENGTH);
+        auto asUtf8 = rct2_to_utf8(originalStringView, RCT2_LANGUAGE_ID_ENGLISH_UK);
+        utf8_remove_format_codes(asUtf8.data(), /*allow colour*/ false);
+        return asUtf8.data();
+    }
+
+    static std::vector<uint8_t> CreatePreview(const rct_s6_data& s6)
+    {
+        const int32_t mapSize = s6.map_size;
+        if (mapSize < 3 || mapSize > MAXIMUM_MAP_SIZE_TECHNICAL)
+        {
+            throw std::runtime_error("Invalid map size.");
+        }
+
+        // Tile elements are stored tile by tile for the whole technical map size, find where each tile starts
+        std::vector<uint32_t> tileStarts(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+        uint32_t elementIndex = 0;
+        for (auto& tileStart : tileStarts)
+        {
+            tileStart = elementIndex;
+            while (elementIndex < RCT2_MAX_TILE_ELEMENTS && !s6.tile_elements[elementIndex].IsLastForTile())
+            {
+                elementIndex++;
+            }
+            if (++elementIndex > RCT2_MAX_TILE_ELEMENTS)
+            {
+                throw std::runtime_error("Invalid tile elements.");
+            }
+        }
+
+        // Sample the playable area, without the edge of the map
+        std::vector<uint8_t> pixels(SAVED_GAME_PREVIEW_SIZE * SAVED_GAME_PREVIEW_SIZE);
+        const int32_t playableSize = mapSize - 2;
+        for (int32_t py = 0; py < SAVED_GAME_PREVIEW_SIZE; py++)
+        {
+            const int32_t y = 1 + (py * playableSize) / SAVED_GAME_PREVIEW_SIZE;
+            for (int32_t px = 0; px < SAVED_GAME_PREVIEW_SIZE; px++)
+            {
+                const int32_t x = 1 + (px * playableSize) / SAVED_GAME_PREVIEW_SIZE;
+                pixels[py * SAVED_GAME_PREVIEW_SIZE + px] = GetPreviewColour(s6, tileStarts[y * MAXIMUM_MAP_SIZE_TECHNICAL + x]);
+            }
+        }
+        return pixels;
+    }
+
+    static uint8_t GetPreviewColour(const rct_s6_data& s6, uint32_t elementIndex)
+    {
+        uint8_t colour = PALETTE_INDEX_0;
+        for (; elementIndex < RCT2_MAX_TILE_ELEMENTS; elementIndex++)
+        {
+            const auto& element = s6.tile_elements[elementIndex];
+            switch (static_cast<RCT12TileElementType>(element.GetType()))
+            {
+                case RCT12TileElementType::Surface:
+                {
+                    auto surface = element.AsSurface();
+                    colour = surface->GetWaterHeight() > 0 ? PreviewWaterColour
+                                                           : PreviewTerrainColour[surface->GetSurfaceStyle()
+                                                                                  % std::size(PreviewTerrainColour)];
+                    break;
+                }
+                case RCT12TileElementType::Path:
+                    colour = PreviewPathColour;
+                    break;
+                case RCT12TileElementType::Track:
+                    return PreviewTrackColour;
+                case RCT12TileElementType::Entrance:
+                    return PreviewEntranceColour;
+                default:
+                    break;
+            }
+            if (element.IsLastForTile())
+            {
+                break;
+            }
+        }
+        return colour;
+    }
+};
+
+namespace SavedGameRepository
+{
+    struct State
+    {
+        std::mutex Mutex;
+        std::unordered_map<std::string, SavedGamePreview> Previews;
+        std::future<void> Refresh;
+    };
+
+    static State& GetState()
+    {
+        // Make sure the scheduler the index is built with outlives a refresh that is still running on exit
+        TaskScheduler::GetGlobal();
+        static State state;
+        return state;
+    }
+
+    void RefreshAsync()
+    {
+        auto& state = GetState();
+        if (state.Refresh.valid() && state.Refresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
+
+        auto env = GetContext()->GetPlatformEnvironment();
+        state.Refresh = std::async(std::launch::async, [env, &state]() {
+            auto index = SavedGameFileIndex(*env);
+            auto items = index.LoadOrBuild(0);
+
+            std::unordered_map<std::string, SavedGamePreview> previews;
+            previews.reserve(items.size());
+            for (auto& item : items)
+            {
+                auto itemPath = item.Path;
+                previews.emplace(std::move(itemPath), std::move(item));
+            }
+
+            std::lock_guard<std::mutex> lock(state.Mutex);
+            state.Previews = std::move(previews);
+        });
+    }
+
+    bool IsRefreshing()
+    {
+        auto& state = GetState();
+        return state.Refresh.valid() && state.Refresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
+    std::optional<SavedGamePreview> GetPreview(const std::string& path)
+    {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        auto it = state.Previews.find(path);
+        if (it == state.Previews.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+} // namespace SavedGameRepository
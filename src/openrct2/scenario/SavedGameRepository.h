@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+// Width and height of the map previews, in pixels
+constexpr uint16_t SAVED_GAME_PREVIEW_SIZE = 64;
+
+struct SavedGamePreview
+{
+    std::string Path;
+    std::string ParkName;
+    uint16_t ElapsedMonths = 0;
+    uint16_t NumGuests = 0;
+    uint16_t ParkRating = 0;
+    // Top down view of the map, one palette index per pixel. Empty if the file could not be read.
+    std::vector<uint8_t> Pixels;
+};
+
+/**
+ * Keeps an index of the saved games in the user's save directory (including autosaves) in the
+ * cache directory, so the load / save window can show details of a park without opening it.
+ */
+namespace SavedGameRepository
+{
+    /**
+     * Updates the index in the background, unless that is already being done. Only the files
+     * that were added or changed since the index was last written are read.
+     */
+    void RefreshAsync();
+
+    bool IsRefreshing();
+
+    /**
+     * Returns the details of the saved game at the given path as of the last finished refresh.
+     */
+    std::optional<SavedGamePreview> GetPreview(const std::string& path);
+} // namespace SavedGameRepository
@@ -457,6 +457,9 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+bool scenario_autosave(const utf8* path, const utf8* backupPath, int32_t flags);
+bool scenario_autosave_is_in_progress();
+void scenario_autosave_wait();
 void scenario_remove_trackless_rides(rct_s6_data* s6);
 void scenario_fix_ghosts(rct_s6_data* s6);
 void scenario_failure();
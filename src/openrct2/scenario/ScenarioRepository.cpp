@@ -13,6 +13,7 @@
 #include "../Game.h"
 #include "../ParkImporter.h"
 #include "../PlatformEnvironment.h"
+#include "../StartupTrace.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/File.h"
@@ -21,6 +22,7 @@
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/Language.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
@@ -143,7 +145,6 @@ public:
     {
     }
 
-protected:
     std::tuple<bool, scenario_index_entry> Create(int32_t, const std::string& path) const override
     {
         scenario_index_entry entry;
@@ -158,6 +159,7 @@ protected:
         }
     }
 
+protected:
     void Serialise(IStream* stream, const scenario_index_entry& item) const override
     {
         stream->Write(item.path, sizeof(item.path));
@@ -351,6 +353,10 @@ private:
     std::vector<scenario_index_entry> _scenarios;
     std::vector<scenario_highscore_entry*> _highscores;
 
+    // The scenarios are only scanned once they are needed, e.g. not by servers that load a park by its path
+    mutable bool _scanned = false;
+    mutable TaskGroup _scanTask;
+
 public:
     explicit ScenarioRepository(const std::shared_ptr<IPlatformEnvironment>& env)
         : _env(env)
@@ -360,35 +366,39 @@ public:
 
     virtual ~ScenarioRepository()
     {
+        TaskScheduler::GetGlobal().Wait(_scanTask);
         ClearHighscores();
     }
 
     void Scan(int32_t language) override
     {
-        ImportMegaPark();
+        TaskScheduler::GetGlobal().Wait(_scanTask);
+        ScanNow(language);
+    }
 
-        // Reload scenarios from index
-        _scenarios.clear();
-        auto scenarios = _fileIndex.LoadOrBuild(language);
-        for (auto scenario : scenarios)
+    void ScanInBackground(int32_t language) override
+    {
+        if (!_scanTask.IsComplete())
         {
-            AddScenario(scenario);
+            return;
         }
+        TaskScheduler::GetGlobal().Schedule(_scanTask, [this, language]() { ScanNow(language); });
+    }
 
-        // Sort the scenarios and load the highscores
-        Sort();
-        LoadScores();
-        LoadLegacyScores();
-        AttachHighscores();
+    bool IsScanning() const override
+    {
+        return !_scanTask.IsComplete();
     }
 
     size_t GetCount() const override
     {
+        EnsureScanned();
         return _scenarios.size();
     }
 
     const scenario_index_entry* GetByIndex(size_t index) const override
     {
+        EnsureScanned();
         const scenario_index_entry* result = nullptr;
         if (index < _scenarios.size())
         {
@@ -399,21 +409,13 @@ public:
 
     const scenario_index_entry* GetByFilename(const utf8* filename) const override
     {
-        for (const auto& scenario : _scenarios)
-        {
-            const utf8* scenarioFilename = Path::GetFileName(scenario.path);
-
-            // Note: this is always case insensitive search for cross platform consistency
-            if (String::Equals(filename, scenarioFilename, true))
-            {
-                return &scenario;
-            }
-        }
-        return nullptr;
+        EnsureScanned();
+        return FindByFilename(filename);
     }
 
     const scenario_index_entry* GetByInternalName(const utf8* name) const override
     {
+        EnsureScanned();
         for (size_t i = 0; i < _scenarios.size(); i++)
         {
             const scenario_index_entry* scenario = &_scenarios[i];
@@ -432,14 +434,43 @@ public:
 
     const scenario_index_entry* GetByPath(const utf8* path) const override
     {
-        for (const auto& scenario : _scenarios)
+        EnsureScanned();
+        return FindByPath(path);
+    }
+
+    bool ScanFile(const std::string& path) override
+    {
+        if (!_fileIndex.IsIndexedFile(path))
         {
-            if (Path::Equals(path, scenario.path))
+            return false;
+        }
+
+        TaskScheduler::GetGlobal().Wait(_scanTask);
+        if (!_scanned)
+        {
+            // Found by the first scan
+            return true;
+        }
+
+        auto language = LocalisationService_GetCurrentLanguage();
+        auto result = _fileIndex.Create(language, path);
+        if (std::get<0>(result) && std::get<1>(result).path[0] != '\0')
+        {
+            auto existingEntry = GetByPath(path.c_str());
+            if (existingEntry != nullptr)
             {
-                return &scenario;
+                auto highscore = existingEntry->highscore;
+                *existingEntry = std::get<1>(result);
+                existingEntry->highscore = highscore;
             }
+            else
+            {
+                AddScenario(std::get<1>(result));
+                AttachHighscores();
+            }
+            Sort();
         }
-        return nullptr;
+        return true;
     }
 
     bool TryRecordHighscore(int32_t language, const utf8* scenarioFileName, money32 companyValue, const utf8* name) override
@@ -482,16 +513,74 @@ public:
     }
 
 private:
+    void ScanNow(int32_t language)
+    {
+        StartupTraceSpan span("ScenarioRepository::Scan");
+        ImportMegaPark();
+
+        // Reload scenarios from index
+        _scenarios.clear();
+        auto scenarios = _fileIndex.LoadOrBuild(language);
+        for (auto scenario : scenarios)
+        {
+            AddScenario(scenario);
+        }
+
+        // Sort the scenarios and load the highscores
+        Sort();
+        LoadScores();
+        LoadLegacyScores();
+        AttachHighscores();
+        _scanned = true;
+    }
+
+    void EnsureScanned() const
+    {
+        if (!_scanTask.IsComplete())
+        {
+            TaskScheduler::GetGlobal().Wait(_scanTask);
+        }
+        if (!_scanned)
+        {
+            const_cast<ScenarioRepository*>(this)->ScanNow(LocalisationService_GetCurrentLanguage());
+        }
+    }
+
+    const scenario_index_entry* FindByFilename(const utf8* filename) const
+    {
+        for (const auto& scenario : _scenarios)
+        {
+            const utf8* scenarioFilename = Path::GetFileName(scenario.path);
+
+            // Note: this is always case insensitive search for cross platform consistency
+            if (String::Equals(filename, scenarioFilename, true))
+            {
+                return &scenario;
+            }
+        }
+        return nullptr;
+    }
+
+    const scenario_index_entry* FindByPath(const utf8* path) const
+    {
+        for (const auto& scenario : _scenarios)
+        {
+            if (Path::Equals(path, scenario.path))
+            {
+                return &scenario;
+            }
+        }
+        return nullptr;
+    }
+
     scenario_index_entry* GetByFilename(const utf8* filename)
     {
-        const ScenarioRepository* repo = this;
-        return const_cast<scenario_index_entry*>(repo->GetByFilename(filename));
+        return const_cast<scenario_index_entry*>(FindByFilename(filename));
     }
 
     scenario_index_entry* GetByPath(const utf8* path)
     {
-        const ScenarioRepository* repo = this;
-        return const_cast<scenario_index_entry*>(repo->GetByPath(path));
+        return const_cast<scenario_index_entry*>(FindByPath(path));
     }
 
     /**
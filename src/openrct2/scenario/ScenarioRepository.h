@@ -57,9 +57,16 @@ struct IScenarioRepository
     virtual ~IScenarioRepository() = default;
 
     /**
-     * Scans the scenario directories and grabs the metadata for all the scenarios.
+     * Scans the scenario directories and grabs the metadata for all the scenarios. Until the first scan the repository
+     * scans when it is first queried.
      */
     virtual void Scan(int32_t language) abstract;
+    /**
+     * Starts scanning on the task scheduler, queries made before it is done wait for it. Does nothing if a scan is
+     * already in progress.
+     */
+    virtual void ScanInBackground(int32_t language) abstract;
+    virtual bool IsScanning() const abstract;
 
     virtual size_t GetCount() const abstract;
     virtual const scenario_index_entry* GetByIndex(size_t index) const abstract;
@@ -69,6 +76,11 @@ struct IScenarioRepository
      */
     virtual const scenario_index_entry* GetByInternalName(const utf8* name) const abstract;
     virtual const scenario_index_entry* GetByPath(const utf8* path) const abstract;
+    /**
+     * Adds the scenario of a file created or changed since the last scan, or updates its entry. Returns false if the
+     * file is not one the repository indexes.
+     */
+    virtual bool ScanFile(const std::string& path) abstract;
 
     virtual bool TryRecordHighscore(
         int32_t language, const utf8* scenarioFileName, money32 companyValue, const utf8* name) abstract;
@@ -34,6 +34,35 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
     return (result != LookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+std::string_view OpenRCT2::Scripting::GetHookTypeName(HOOK_TYPE type)
+{
+    switch (type)
+    {
+        case HOOK_TYPE::ACTION_QUERY:
+            return "action.query";
+        case HOOK_TYPE::ACTION_EXECUTE:
+            return "action.execute";
+        case HOOK_TYPE::INTERVAL_TICK:
+            return "interval.tick";
+        case HOOK_TYPE::INTERVAL_DAY:
+            return "interval.day";
+        case HOOK_TYPE::NETWORK_CHAT:
+            return "network.chat";
+        case HOOK_TYPE::NETWORK_AUTHENTICATE:
+            return "network.authenticate";
+        case HOOK_TYPE::NETWORK_JOIN:
+            return "network.join";
+        case HOOK_TYPE::NETWORK_LEAVE:
+            return "network.leave";
+        case HOOK_TYPE::RIDE_RATINGS_CALCULATE:
+            return "ride.ratings.calculate";
+        case HOOK_TYPE::ACTION_LOCATION:
+            return "action.location";
+        default:
+            return "unknown";
+    }
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -95,53 +124,57 @@ bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
     auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    if (!hookList.Hooks.empty())
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        CallHooks(hookList, {}, isGameStateMutable);
     }
 }
 
 void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
 {
     auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    if (!hookList.Hooks.empty())
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        CallHooks(hookList, { arg }, isGameStateMutable);
     }
 }
 
-void HookEngine::Call(
-    HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable)
+void HookEngine::Call(HOOK_TYPE type, const std::initializer_list<HookArg>& args, bool isGameStateMutable)
 {
     auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    if (hookList.Hooks.empty())
     {
-        auto ctx = _scriptEngine.GetContext();
+        return;
+    }
 
-        // Convert key/value pairs into an object
-        auto objIdx = duk_push_object(ctx);
-        for (const auto& arg : args)
+    // Convert key/value pairs into an object, which every hook is given
+    auto ctx = _scriptEngine.GetContext();
+    auto objIdx = duk_push_object(ctx);
+    for (const auto& arg : args)
+    {
+        if (const auto* intValue = std::get_if<int32_t>(&arg.second))
         {
-            if (arg.second.type() == typeid(int32_t))
-            {
-                auto val = std::any_cast<int32_t>(arg.second);
-                duk_push_int(ctx, val);
-            }
-            else if (arg.second.type() == typeid(std::string))
-            {
-                const auto& val = std::any_cast<std::string>(arg.second);
-                duk_push_string(ctx, val.c_str());
-            }
-            else
-            {
-                throw std::runtime_error("Not implemented");
-            }
-            duk_put_prop_string(ctx, objIdx, arg.first.data());
+            duk_push_int(ctx, *intValue);
         }
+        else if (const auto* boolValue = std::get_if<bool>(&arg.second))
+        {
+            duk_push_boolean(ctx, *boolValue);
+        }
+        else
+        {
+            const auto& stringValue = std::get<std::string_view>(arg.second);
+            duk_push_lstring(ctx, stringValue.data(), stringValue.size());
+        }
+        duk_put_prop_lstring(ctx, objIdx, arg.first.data(), arg.first.size());
+    }
+    CallHooks(hookList, { DukValue::take_from_stack(ctx) }, isGameStateMutable);
+}
 
-        std::vector<DukValue> dukArgs;
-        dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+void HookEngine::CallHooks(HookList& hookList, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    for (auto& hook : hookList.Hooks)
+    {
+        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, args, isGameStateMutable, GetHookTypeName(hookList.Type));
     }
 }
 
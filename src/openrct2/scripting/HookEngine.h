@@ -14,10 +14,11 @@
 #    include "../common.h"
 #    include "Duktape.hpp"
 
-#    include <any>
 #    include <memory>
 #    include <string>
+#    include <string_view>
 #    include <tuple>
+#    include <variant>
 #    include <vector>
 
 namespace OpenRCT2::Scripting
@@ -43,6 +44,7 @@ namespace OpenRCT2::Scripting
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    std::string_view GetHookTypeName(HOOK_TYPE type);
 
     struct Hook
     {
@@ -59,6 +61,10 @@ namespace OpenRCT2::Scripting
         }
     };
 
+    // A property of the object passed to the hooks. Strings have to outlive the call.
+    using HookArgValue = std::variant<int32_t, bool, std::string_view>;
+    using HookArg = std::pair<std::string_view, HookArgValue>;
+
     struct HookList
     {
         HOOK_TYPE Type{};
@@ -86,10 +92,10 @@ namespace OpenRCT2::Scripting
         bool HasSubscriptions(HOOK_TYPE type) const;
         void Call(HOOK_TYPE type, bool isGameStateMutable);
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
-        void Call(
-            HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
+        void Call(HOOK_TYPE type, const std::initializer_list<HookArg>& args, bool isGameStateMutable);
 
     private:
+        void CallHooks(HookList& hookList, const std::vector<DukValue>& args, bool isGameStateMutable);
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
     };
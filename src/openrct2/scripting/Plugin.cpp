@@ -13,14 +13,47 @@
 
 #    include "../Diagnostic.h"
 #    include "../OpenRCT2.h"
+#    include "../core/File.h"
+#    include "../core/Path.hpp"
 #    include "Duktape.hpp"
 
 #    include <algorithm>
+#    include <cinttypes>
+#    include <cstdio>
+#    include <cstring>
 #    include <fstream>
 #    include <memory>
 
 using namespace OpenRCT2::Scripting;
 
+// Compiled plugin scripts are stored with this header, the bytecode can only be loaded by the Duktape version that wrote it
+struct BytecodeHeader
+{
+    uint32_t Magic;
+    uint32_t DuktapeVersion;
+    uint64_t CodeLength;
+};
+static constexpr uint32_t BYTECODE_MAGIC = 0x43425344; // DSBC
+
+static std::string GetBytecodeFileName(const std::string& code)
+{
+    // FNV-1a, the code length is checked as well when loading
+    uint64_t hash = 0xCBF29CE484222325;
+    for (auto c : code)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016" PRIx64 ".dukbc", hash);
+    return name;
+}
+
+static duk_ret_t duk_load_function_wrapper(duk_context* ctx, void*)
+{
+    duk_load_function(ctx);
+    return 1;
+}
+
 Plugin::Plugin(duk_context* context, const std::string& path)
     : _context(context)
     , _path(path)
@@ -32,38 +65,66 @@ void Plugin::SetCode(const std::string_view& code)
     _code = code;
 }
 
-void Plugin::Load()
+void Plugin::Load(const std::string& cacheDirectory)
 {
     if (!_path.empty())
     {
         LoadCodeFromFile();
     }
 
-    std::string projectedVariables = "console,context,date,map,network,park";
+    std::vector<const char*> projectedVariables = { "console", "context", "date", "map", "network", "park" };
     if (!gOpenRCT2Headless)
     {
-        projectedVariables += ",ui";
+        projectedVariables.push_back("ui");
+    }
+    std::string parameters;
+    for (const auto* name : projectedVariables)
+    {
+        if (!parameters.empty())
+            parameters.push_back(',');
+        parameters += name;
     }
 
     // Wrap the script in a function and pass the global objects as variables
     // so that if the script modifies them, they are not modified for other scripts.
 
     // clang-format off
-    auto code = _code;
-    code =
-        "     (function(" + projectedVariables + ") {"
+    std::string code =
+        "     function(" + parameters + ") {"
         "         var __metadata__ = null;"
         "         var registerPlugin = function(m) { __metadata__ = m };"
         "         (function(__metadata__) {"
-                      + code +
+                      + _code +
         "         })();"
         "         return __metadata__;"
-        "     })(" + projectedVariables + ");";
+        "     }";
     // clang-format on
 
-    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
-    auto result = duk_eval_raw(_context, code.c_str(), code.size(), flags);
-    if (result != DUK_ERR_NONE)
+    std::string bytecodePath;
+    if (!cacheDirectory.empty())
+    {
+        bytecodePath = Path::Combine(cacheDirectory, GetBytecodeFileName(code));
+    }
+    if (bytecodePath.empty() || !LoadBytecode(bytecodePath, code))
+    {
+        auto flags = DUK_COMPILE_FUNCTION | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
+        if (duk_compile_raw(_context, code.c_str(), code.size(), flags) != DUK_ERR_NONE)
+        {
+            auto val = std::string(duk_safe_to_string(_context, -1));
+            duk_pop(_context);
+            throw std::runtime_error("Failed to load plug-in script: " + val);
+        }
+        if (!bytecodePath.empty())
+        {
+            SaveBytecode(bytecodePath, code);
+        }
+    }
+
+    for (const auto* name : projectedVariables)
+    {
+        duk_get_global_string(_context, name);
+    }
+    if (duk_pcall(_context, static_cast<duk_idx_t>(projectedVariables.size())) != DUK_EXEC_SUCCESS)
     {
         auto val = std::string(duk_safe_to_string(_context, -1));
         duk_pop(_context);
@@ -99,6 +160,105 @@ void Plugin::Stop()
     _hasStarted = false;
 }
 
+PluginCallStats Plugin::GetTotalCallStats() const
+{
+    PluginCallStats total;
+    for (const auto& [kind, stats] : _callStats)
+    {
+        total.Calls += stats.Calls;
+        total.TotalTime += stats.TotalTime;
+        total.MaxTime = std::max(total.MaxTime, stats.MaxTime);
+    }
+    return total;
+}
+
+void Plugin::RecordCall(std::string_view kind, uint64_t time)
+{
+    auto it = _callStats.find(kind);
+    if (it == _callStats.end())
+    {
+        it = _callStats.emplace(std::string(kind), PluginCallStats()).first;
+    }
+    auto& stats = it->second;
+    stats.Calls++;
+    stats.TotalTime += time;
+    stats.MaxTime = std::max(stats.MaxTime, time);
+    _updateTime += time;
+}
+
+bool Plugin::LoadBytecode(const std::string& path, const std::string& code)
+{
+    std::vector<uint8_t> data;
+    try
+    {
+        if (!File::Exists(path))
+        {
+            return false;
+        }
+        data = File::ReadAllBytes(path);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    BytecodeHeader header;
+    if (data.size() <= sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.Magic != BYTECODE_MAGIC || header.DuktapeVersion != DUK_VERSION || header.CodeLength != code.size())
+    {
+        return false;
+    }
+
+    auto bytecodeLen = data.size() - sizeof(header);
+    auto buffer = duk_push_fixed_buffer(_context, bytecodeLen);
+    std::memcpy(buffer, data.data() + sizeof(header), bytecodeLen);
+    if (duk_safe_call(_context, duk_load_function_wrapper, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+    {
+        duk_pop(_context);
+        return false;
+    }
+    _bytecodePath = path;
+    return true;
+}
+
+void Plugin::SaveBytecode(const std::string& path, const std::string& code)
+{
+    // Entries of earlier versions of a plugin that was edited are no longer needed
+    if (!_bytecodePath.empty() && _bytecodePath != path)
+    {
+        File::Delete(_bytecodePath);
+    }
+    _bytecodePath = path;
+
+    duk_dup(_context, -1);
+    duk_dump_function(_context);
+    duk_size_t bytecodeLen{};
+    auto bytecode = duk_get_buffer_data(_context, -1, &bytecodeLen);
+
+    BytecodeHeader header;
+    header.Magic = BYTECODE_MAGIC;
+    header.DuktapeVersion = DUK_VERSION;
+    header.CodeLength = code.size();
+    std::vector<uint8_t> data(sizeof(header) + bytecodeLen);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), bytecode, bytecodeLen);
+    duk_pop(_context);
+
+    try
+    {
+        Path::CreateDirectory(Path::GetDirectory(path));
+        File::WriteAllBytes(path, data.data(), data.size());
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to write plugin cache '%s': %s", path.c_str(), e.what());
+    }
+}
+
 void Plugin::LoadCodeFromFile()
 {
     std::string code;
@@ -13,6 +13,7 @@
 
 #    include "Duktape.hpp"
 
+#    include <map>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -45,6 +46,16 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    /**
+     * Time spent in calls into the plugin, times are in microseconds.
+     */
+    struct PluginCallStats
+    {
+        uint64_t Calls{};
+        uint64_t TotalTime{};
+        uint64_t MaxTime{};
+    };
+
     class Plugin
     {
     private:
@@ -52,7 +63,11 @@ namespace OpenRCT2::Scripting
         std::string _path;
         PluginMetadata _metadata{};
         std::string _code;
+        std::string _bytecodePath;
         bool _hasStarted{};
+        std::map<std::string, PluginCallStats, std::less<>> _callStats;
+        uint64_t _updateTime{};
+        uint32_t _lastBudgetWarningTick{};
 
     public:
         std::string GetPath() const
@@ -80,18 +95,64 @@ namespace OpenRCT2::Scripting
             return _hasStarted;
         }
 
+        /**
+         * Per kind of call, e.g. the hook name.
+         */
+        const std::map<std::string, PluginCallStats, std::less<>>& GetCallStats() const
+        {
+            return _callStats;
+        }
+
+        /**
+         * The time spent in the plugin since the last ResetUpdateTime.
+         */
+        uint64_t GetUpdateTime() const
+        {
+            return _updateTime;
+        }
+
+        void ResetUpdateTime()
+        {
+            _updateTime = 0;
+        }
+
+        uint32_t GetLastBudgetWarningTick() const
+        {
+            return _lastBudgetWarningTick;
+        }
+
+        void SetLastBudgetWarningTick(uint32_t tick)
+        {
+            _lastBudgetWarningTick = tick;
+        }
+
+        void ResetCallStats()
+        {
+            _callStats.clear();
+        }
+
+        PluginCallStats GetTotalCallStats() const;
+        void RecordCall(std::string_view kind, uint64_t time);
+
         Plugin() = default;
         Plugin(duk_context* context, const std::string& path);
         Plugin(const Plugin&) = delete;
         Plugin(Plugin&&) = delete;
 
         void SetCode(const std::string_view& code);
-        void Load();
+
+        /**
+         * Compiles and runs the plugin script to get its metadata. The compiled script is kept in the given directory
+         * and reused the next time the same code is loaded, unless the directory is empty.
+         */
+        void Load(const std::string& cacheDirectory);
         void Start();
         void Stop();
 
     private:
         void LoadCodeFromFile();
+        bool LoadBytecode(const std::string& path, const std::string& code);
+        void SaveBytecode(const std::string& path, const std::string& code);
 
         static PluginMetadata GetMetadata(const DukValue& dukMetadata);
         static PluginType ParsePluginType(const std::string_view& type);
@@ -11,15 +11,18 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../TickProfiler.h"
 #    include "../actions/GameAction.h"
 #    include "../interface/Screenshot.h"
 #    include "../object/ObjectManager.h"
+#    include "../peep/GuestPathfinding.h"
 #    include "../scenario/Scenario.h"
 #    include "Duktape.hpp"
 #    include "HookEngine.h"
 #    include "ScConfiguration.hpp"
 #    include "ScDisposable.hpp"
 #    include "ScObject.hpp"
+#    include "ScWorker.hpp"
 #    include "ScriptEngine.h"
 
 #    include <cstdio>
@@ -30,6 +33,8 @@ namespace OpenRCT2::Scripting
     class ScContext
     {
     private:
+        static constexpr size_t MAX_WORKERS_PER_PLUGIN = 8;
+
         ScriptExecutionInfo& _execInfo;
         HookEngine& _hookEngine;
 
@@ -177,6 +182,49 @@ namespace OpenRCT2::Scripting
             return std::make_shared<ScDisposable>([this, hookType, cookie]() { _hookEngine.Unsubscribe(hookType, cookie); });
         }
 
+        IntervalHandle setInterval(const DukValue& callback, int32_t delay)
+        {
+            return AddInterval(callback, delay, true, false);
+        }
+
+        IntervalHandle setTimeout(const DukValue& callback, int32_t delay)
+        {
+            return AddInterval(callback, delay, false, false);
+        }
+
+        IntervalHandle setTickInterval(const DukValue& callback, int32_t ticks)
+        {
+            return AddInterval(callback, ticks, true, true);
+        }
+
+        IntervalHandle setTickTimeout(const DukValue& callback, int32_t ticks)
+        {
+            return AddInterval(callback, ticks, false, true);
+        }
+
+        void clearInterval(IntervalHandle handle)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            scriptEngine.RemoveInterval(_execInfo.GetCurrentPlugin(), handle);
+        }
+
+        IntervalHandle AddInterval(const DukValue& callback, int32_t delay, bool repeat, bool tickAligned)
+        {
+            if (!callback.is_function())
+            {
+                throw DukException() << "Expected function for callback";
+            }
+
+            auto owner = _execInfo.GetCurrentPlugin();
+            if (owner == nullptr)
+            {
+                throw DukException() << "Not in a plugin context";
+            }
+
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            return scriptEngine.AddInterval(owner, static_cast<uint32_t>(std::max(delay, 0)), repeat, tickAligned, callback);
+        }
+
         void queryAction(const std::string& action, const DukValue& args, const DukValue& callback)
         {
             QueryOrExecuteAction(action, args, callback, false);
@@ -277,6 +325,150 @@ namespace OpenRCT2::Scripting
             }
         }
 
+        static DukValue PathfindCountersToDuk(duk_context* ctx, const PathfindCounters& counters)
+        {
+            DukObject obj(ctx);
+            obj.Set("calls", counters.Calls);
+            obj.Set("searches", counters.Searches);
+            obj.Set("tilesChecked", counters.TilesChecked);
+            obj.Set("junctions", counters.Junctions);
+            obj.Set("limitReached", counters.LimitReached);
+            obj.Set("distanceFieldHits", counters.DistanceFieldHits);
+            obj.Set("budgetDeferred", counters.BudgetDeferred);
+            obj.Set("time", counters.Nanoseconds / 1000000.0);
+            return obj.Take();
+        }
+
+        DukValue getPathfindingStats() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto stats = pathfind_stats_get();
+
+            duk_push_array(ctx);
+            duk_uarridx_t index = 0;
+            for (const auto& rideStats : stats.Rides)
+            {
+                DukObject rideObj(ctx);
+                if (rideStats.Ride == RIDE_ID_NULL)
+                    rideObj.Set("ride", ToDuk(ctx, nullptr));
+                else
+                    rideObj.Set("ride", static_cast<int32_t>(rideStats.Ride));
+                rideObj.Set("calls", rideStats.Calls);
+                rideObj.Set("time", rideStats.Nanoseconds / 1000000.0);
+                rideObj.Take().push();
+                duk_put_prop_index(ctx, -2, index++);
+            }
+            auto rides = DukValue::take_from_stack(ctx);
+
+            DukObject obj(ctx);
+            obj.Set("tick", stats.Tick);
+            obj.Set("lastTick", PathfindCountersToDuk(ctx, stats.LastTick));
+            obj.Set("ticks", stats.Ticks);
+            obj.Set("total", PathfindCountersToDuk(ctx, stats.Total));
+            obj.Set("rides", rides);
+            return obj.Take();
+        }
+
+        void resetPathfindingStats()
+        {
+            pathfind_stats_reset();
+        }
+
+        DukValue getPluginStats() const
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+
+            duk_push_array(ctx);
+            duk_uarridx_t index = 0;
+            for (const auto& plugin : scriptEngine.GetPlugins())
+            {
+                duk_push_array(ctx);
+                duk_uarridx_t hookIndex = 0;
+                for (const auto& [kind, stats] : plugin->GetCallStats())
+                {
+                    auto hookObj = PluginCallStatsToDuk(ctx, stats);
+                    hookObj.Set("name", kind);
+                    hookObj.Take().push();
+                    duk_put_prop_index(ctx, -2, hookIndex++);
+                }
+                auto hooks = DukValue::take_from_stack(ctx);
+
+                auto pluginObj = PluginCallStatsToDuk(ctx, plugin->GetTotalCallStats());
+                pluginObj.Set("name", plugin->GetMetadata().Name);
+                pluginObj.Set("hooks", hooks);
+                pluginObj.Take().push();
+                duk_put_prop_index(ctx, -2, index++);
+            }
+            return DukValue::take_from_stack(ctx);
+        }
+
+        std::shared_ptr<ScWorker> createWorker(const std::string& source)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
+            if (scriptEngine.GetNumWorkers(plugin) >= MAX_WORKERS_PER_PLUGIN)
+            {
+                duk_error(scriptEngine.GetContext(), DUK_ERR_ERROR, "Too many workers.");
+            }
+            auto worker = std::make_shared<ScWorker>(plugin, source);
+            scriptEngine.AddWorker(worker);
+            return worker;
+        }
+
+        void resetPluginStats()
+        {
+            for (const auto& plugin : GetContext()->GetScriptEngine().GetPlugins())
+            {
+                plugin->ResetCallStats();
+            }
+        }
+
+        DukValue getTickStats() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            if (!tick_profiler_is_enabled())
+            {
+                return ToDuk(ctx, nullptr);
+            }
+
+            auto stats = tick_profiler_get_stats();
+            duk_push_array(ctx);
+            for (size_t i = 0; i < static_cast<size_t>(TickPhase::Count); i++)
+            {
+                const auto& phase = stats.Phases[i];
+                DukObject phaseObj(ctx);
+                phaseObj.Set("name", tick_profiler_get_phase_name(static_cast<TickPhase>(i)));
+                phaseObj.Set("average", phase.AverageNanoseconds / 1e6);
+                phaseObj.Set("p99", phase.P99Nanoseconds / 1e6);
+                phaseObj.Set("max", phase.MaxNanoseconds / 1e6);
+                phaseObj.Set("worst", stats.Worst.Nanoseconds[i] / 1e6);
+                phaseObj.Take().push();
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+            }
+            auto phases = DukValue::take_from_stack(ctx);
+
+            DukObject obj(ctx);
+            obj.Set("ticks", static_cast<uint32_t>(stats.Ticks));
+            obj.Set("worstTick", stats.Worst.Tick);
+            obj.Set("phases", phases);
+            return obj.Take();
+        }
+
+        void setTickProfiling(bool enabled)
+        {
+            tick_profiler_set_enabled(enabled);
+        }
+
+        static DukObject PluginCallStatsToDuk(duk_context* ctx, const PluginCallStats& stats)
+        {
+            DukObject obj(ctx);
+            obj.Set("calls", static_cast<double>(stats.Calls));
+            obj.Set("time", stats.TotalTime / 1000.0);
+            obj.Set("maxTime", stats.MaxTime / 1000.0);
+            return obj;
+        }
+
     public:
         static void Register(duk_context* ctx)
         {
@@ -286,7 +478,20 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScContext::getObject, "getObject");
             dukglue_register_method(ctx, &ScContext::getAllObjects, "getAllObjects");
             dukglue_register_method(ctx, &ScContext::getRandom, "getRandom");
+            dukglue_register_method(ctx, &ScContext::getPathfindingStats, "getPathfindingStats");
+            dukglue_register_method(ctx, &ScContext::resetPathfindingStats, "resetPathfindingStats");
+            dukglue_register_method(ctx, &ScContext::getPluginStats, "getPluginStats");
+            dukglue_register_method(ctx, &ScContext::resetPluginStats, "resetPluginStats");
+            dukglue_register_method(ctx, &ScContext::getTickStats, "getTickStats");
+            dukglue_register_method(ctx, &ScContext::setTickProfiling, "setTickProfiling");
+            dukglue_register_method(ctx, &ScContext::createWorker, "createWorker");
             dukglue_register_method(ctx, &ScContext::subscribe, "subscribe");
+            dukglue_register_method(ctx, &ScContext::setInterval, "setInterval");
+            dukglue_register_method(ctx, &ScContext::setTimeout, "setTimeout");
+            dukglue_register_method(ctx, &ScContext::setTickInterval, "setTickInterval");
+            dukglue_register_method(ctx, &ScContext::setTickTimeout, "setTickTimeout");
+            dukglue_register_method(ctx, &ScContext::clearInterval, "clearInterval");
+            dukglue_register_method(ctx, &ScContext::clearInterval, "clearTimeout");
             dukglue_register_method(ctx, &ScContext::queryAction, "queryAction");
             dukglue_register_method(ctx, &ScContext::executeAction, "executeAction");
             dukglue_register_method(ctx, &ScContext::registerAction, "registerAction");
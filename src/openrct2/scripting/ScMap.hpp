@@ -19,6 +19,12 @@
 #    include "ScRide.hpp"
 #    include "ScTile.hpp"
 
+#    include <algorithm>
+#    include <cstring>
+#    include <optional>
+#    include <type_traits>
+#    include <vector>
+
 namespace OpenRCT2::Scripting
 {
     class ScMap
@@ -50,7 +56,7 @@ namespace OpenRCT2::Scripting
 
         int32_t numEntities_get() const
         {
-            return MAX_SPRITES;
+            return static_cast<int32_t>(GetEntityCapacity());
         }
 
         std::vector<std::shared_ptr<ScRide>> rides_get() const
@@ -81,9 +87,14 @@ namespace OpenRCT2::Scripting
             return std::make_shared<ScTile>(coords);
         }
 
+        int32_t getPeepCount(int32_t x, int32_t y) const
+        {
+            return GetPeepCountAtTile(TileCoordsXY(x, y).ToCoordsXY());
+        }
+
         DukValue getEntity(int32_t id) const
         {
-            if (id >= 0 && id < MAX_SPRITES)
+            if (id >= 0 && static_cast<size_t>(id) < GetEntityCapacity())
             {
                 auto spriteId = static_cast<uint16_t>(id);
                 auto sprite = GetEntity(spriteId);
@@ -158,6 +169,148 @@ namespace OpenRCT2::Scripting
             return result;
         }
 
+        std::vector<DukValue> getAllEntitiesInRange(int32_t left, int32_t top, int32_t right, int32_t bottom) const
+        {
+            std::vector<DukValue> result;
+            ForEachEntityInRange({ left, top, right, bottom }, [this, &result](SpriteBase* sprite) {
+                result.push_back(GetEntityAsDukValue(sprite));
+            });
+            return result;
+        }
+
+        DukValue getGuestData() const
+        {
+            std::vector<int32_t> ids, xs, ys, zs, cash;
+            std::vector<uint8_t> happiness, energy, nausea, hunger, thirst;
+            for (auto peep : EntityList<Peep>(EntityListId::Peep))
+            {
+                if (peep->Is<Staff>())
+                    continue;
+
+                ids.push_back(peep->sprite_index);
+                xs.push_back(peep->x);
+                ys.push_back(peep->y);
+                zs.push_back(peep->z);
+                cash.push_back(peep->CashInPocket);
+                happiness.push_back(peep->Happiness);
+                energy.push_back(peep->Energy);
+                nausea.push_back(peep->Nausea);
+                hunger.push_back(peep->Hunger);
+                thirst.push_back(peep->Thirst);
+            }
+
+            auto ctx = _context;
+            auto objIdx = duk_push_object(ctx);
+            duk_push_uint(ctx, static_cast<duk_uint_t>(ids.size()));
+            duk_put_prop_string(ctx, objIdx, "count");
+            PutTypedArray(ctx, objIdx, "id", ids);
+            PutTypedArray(ctx, objIdx, "x", xs);
+            PutTypedArray(ctx, objIdx, "y", ys);
+            PutTypedArray(ctx, objIdx, "z", zs);
+            PutTypedArray(ctx, objIdx, "cash", cash);
+            PutTypedArray(ctx, objIdx, "happiness", happiness);
+            PutTypedArray(ctx, objIdx, "energy", energy);
+            PutTypedArray(ctx, objIdx, "nausea", nausea);
+            PutTypedArray(ctx, objIdx, "hunger", hunger);
+            PutTypedArray(ctx, objIdx, "thirst", thirst);
+            return DukValue::take_from_stack(ctx);
+        }
+
+        DukValue getSurfaceData(int32_t left, int32_t top, int32_t right, int32_t bottom) const
+        {
+            ClampTileRange(left, top, right, bottom);
+            auto width = std::max(0, right - left + 1);
+            auto height = std::max(0, bottom - top + 1);
+
+            // Row major, starting at the top left tile of the range
+            std::vector<uint8_t> baseHeights(static_cast<size_t>(width) * height);
+            std::vector<uint16_t> waterHeights(baseHeights.size());
+            size_t i = 0;
+            for (int32_t y = top; y <= bottom; y++)
+            {
+                for (int32_t x = left; x <= right; x++)
+                {
+                    auto surfaceElement = map_get_surface_element_at(TileCoordsXY(x, y).ToCoordsXY());
+                    if (surfaceElement != nullptr)
+                    {
+                        baseHeights[i] = surfaceElement->base_height;
+                        waterHeights[i] = static_cast<uint16_t>(surfaceElement->GetWaterHeight());
+                    }
+                    i++;
+                }
+            }
+
+            auto ctx = _context;
+            auto objIdx = duk_push_object(ctx);
+            duk_push_int(ctx, width);
+            duk_put_prop_string(ctx, objIdx, "width");
+            duk_push_int(ctx, height);
+            duk_put_prop_string(ctx, objIdx, "height");
+            PutTypedArray(ctx, objIdx, "baseHeight", baseHeights);
+            PutTypedArray(ctx, objIdx, "waterHeight", waterHeights);
+            return DukValue::take_from_stack(ctx);
+        }
+
+        DukValue getTileElementsInRange(
+            const std::string& type, int32_t left, int32_t top, int32_t right, int32_t bottom) const
+        {
+            auto elementType = GetTileElementType(type);
+            if (!elementType)
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Invalid tile element type.");
+            }
+
+            ClampTileRange(left, top, right, bottom);
+            std::vector<int32_t> xs, ys;
+            std::vector<uint16_t> indices;
+            std::vector<uint8_t> baseHeights, clearanceHeights;
+            for (int32_t y = top; y <= bottom; y++)
+            {
+                for (int32_t x = left; x <= right; x++)
+                {
+                    auto element = map_get_first_element_at(TileCoordsXY(x, y).ToCoordsXY());
+                    if (element == nullptr)
+                        continue;
+
+                    uint16_t index = 0;
+                    do
+                    {
+                        if (element->GetType() == *elementType)
+                        {
+                            xs.push_back(x);
+                            ys.push_back(y);
+                            indices.push_back(index);
+                            baseHeights.push_back(element->base_height);
+                            clearanceHeights.push_back(element->clearance_height);
+                        }
+                        index++;
+                    } while (!(element++)->IsLastForTile());
+                }
+            }
+
+            auto ctx = _context;
+            auto objIdx = duk_push_object(ctx);
+            duk_push_uint(ctx, static_cast<duk_uint_t>(xs.size()));
+            duk_put_prop_string(ctx, objIdx, "count");
+            PutTypedArray(ctx, objIdx, "x", xs);
+            PutTypedArray(ctx, objIdx, "y", ys);
+            PutTypedArray(ctx, objIdx, "index", indices);
+            PutTypedArray(ctx, objIdx, "baseHeight", baseHeights);
+            PutTypedArray(ctx, objIdx, "clearanceHeight", clearanceHeights);
+            return DukValue::take_from_stack(ctx);
+        }
+
+        void beginTileEdit()
+        {
+            ThrowIfGameStateNotMutable();
+            GetContext()->GetScriptEngine().BeginTileEdit();
+        }
+
+        void commitTileEdit()
+        {
+            GetContext()->GetScriptEngine().CommitTileEdit();
+        }
+
         static void Register(duk_context* ctx)
         {
             dukglue_register_property(ctx, &ScMap::size_get, nullptr, "size");
@@ -166,11 +319,76 @@ namespace OpenRCT2::Scripting
             dukglue_register_property(ctx, &ScMap::rides_get, nullptr, "rides");
             dukglue_register_method(ctx, &ScMap::getRide, "getRide");
             dukglue_register_method(ctx, &ScMap::getTile, "getTile");
+            dukglue_register_method(ctx, &ScMap::getPeepCount, "getPeepCount");
             dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
             dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
+            dukglue_register_method(ctx, &ScMap::getAllEntitiesInRange, "getAllEntitiesInRange");
+            dukglue_register_method(ctx, &ScMap::getGuestData, "getGuestData");
+            dukglue_register_method(ctx, &ScMap::getSurfaceData, "getSurfaceData");
+            dukglue_register_method(ctx, &ScMap::getTileElementsInRange, "getTileElementsInRange");
+            dukglue_register_method(ctx, &ScMap::beginTileEdit, "beginTileEdit");
+            dukglue_register_method(ctx, &ScMap::commitTileEdit, "commitTileEdit");
         }
 
     private:
+        /**
+         * Copies the values into a typed array of the matching element type and sets it as a property of the object.
+         */
+        template<typename T>
+        static void PutTypedArray(duk_context* ctx, duk_idx_t objIdx, const char* name, const std::vector<T>& values)
+        {
+            duk_uint_t bufferType;
+            if constexpr (std::is_same_v<T, int32_t>)
+                bufferType = DUK_BUFOBJ_INT32ARRAY;
+            else if constexpr (std::is_same_v<T, uint16_t>)
+                bufferType = DUK_BUFOBJ_UINT16ARRAY;
+            else
+            {
+                static_assert(std::is_same_v<T, uint8_t>, "Unsupported typed array element");
+                bufferType = DUK_BUFOBJ_UINT8ARRAY;
+            }
+
+            auto dataLen = values.size() * sizeof(T);
+            auto data = duk_push_fixed_buffer(ctx, dataLen);
+            if (dataLen != 0)
+            {
+                std::memcpy(data, values.data(), dataLen);
+            }
+            duk_push_buffer_object(ctx, -1, 0, dataLen, bufferType);
+            duk_remove(ctx, -2);
+            duk_put_prop_string(ctx, objIdx, name);
+        }
+
+        static void ClampTileRange(int32_t& left, int32_t& top, int32_t& right, int32_t& bottom)
+        {
+            auto maxTile = std::max(0, gMapSize - 1);
+            left = std::clamp(left, 0, maxTile);
+            top = std::clamp(top, 0, maxTile);
+            right = std::clamp(right, 0, maxTile);
+            bottom = std::clamp(bottom, 0, maxTile);
+        }
+
+        static std::optional<uint8_t> GetTileElementType(const std::string& type)
+        {
+            if (type == "surface")
+                return TILE_ELEMENT_TYPE_SURFACE;
+            if (type == "footpath")
+                return TILE_ELEMENT_TYPE_PATH;
+            if (type == "track")
+                return TILE_ELEMENT_TYPE_TRACK;
+            if (type == "small_scenery")
+                return TILE_ELEMENT_TYPE_SMALL_SCENERY;
+            if (type == "entrance")
+                return TILE_ELEMENT_TYPE_ENTRANCE;
+            if (type == "wall")
+                return TILE_ELEMENT_TYPE_WALL;
+            if (type == "large_scenery")
+                return TILE_ELEMENT_TYPE_LARGE_SCENERY;
+            if (type == "banner")
+                return TILE_ELEMENT_TYPE_BANNER;
+            return std::nullopt;
+        }
+
         DukValue GetEntityAsDukValue(const SpriteBase* sprite) const
         {
             auto spriteId = sprite->sprite_index;
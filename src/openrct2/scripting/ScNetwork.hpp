@@ -19,9 +19,45 @@
 #    include "../network/network.h"
 #    include "Duktape.hpp"
 #    include "ScSocket.hpp"
+#    include "ScriptEngine.h"
 
 namespace OpenRCT2::Scripting
 {
+    inline DukValue NetworkStatsToDuk(duk_context* ctx, const NetworkStats_t& stats)
+    {
+        // The counters can exceed 32 bits, so they are all given as numbers
+        DukObject commands(ctx);
+        for (uint32_t i = 0; i < EnumValue(NetworkCommand::Max); i++)
+        {
+            const auto& commandStats = stats.commands[i];
+            const auto* name = network_get_command_name(static_cast<NetworkCommand>(i));
+            if (name != nullptr)
+            {
+                DukObject command(ctx);
+                command.Set("packetsSent", static_cast<double>(commandStats.packetsSent));
+                command.Set("bytesSent", static_cast<double>(commandStats.bytesSent));
+                command.Set("packetsReceived", static_cast<double>(commandStats.packetsReceived));
+                command.Set("bytesReceived", static_cast<double>(commandStats.bytesReceived));
+                commands.Set(name, command.Take());
+            }
+        }
+
+        DukObject obj(ctx);
+        obj.Set("bytesSent", static_cast<double>(stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)]));
+        obj.Set("bytesReceived", static_cast<double>(stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)]));
+        obj.Set("commands", commands.Take());
+        obj.Set("queuedPackets", static_cast<double>(stats.queuedPackets));
+        obj.Set("queuedBytes", static_cast<double>(stats.queuedBytes));
+        obj.Set(
+            "sendLatencyAverage",
+            stats.sendLatencyCount != 0 ? static_cast<double>(stats.sendLatencyTotal) / stats.sendLatencyCount : 0.0);
+        obj.Set("sendLatencyMax", stats.sendLatencyMax);
+        obj.Set("mapsSaved", static_cast<double>(stats.mapsSaved));
+        obj.Set("mapBytesUncompressed", static_cast<double>(stats.mapBytesUncompressed));
+        obj.Set("mapBytesCompressed", static_cast<double>(stats.mapBytesCompressed));
+        return obj.Take();
+    }
+
     class ScPlayerGroup
     {
     private:
@@ -247,6 +283,12 @@ namespace OpenRCT2::Scripting
             return network_get_player_public_key_hash(_id);
         }
 
+        DukValue stats_get() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            return NetworkStatsToDuk(ctx, network_get_player_stats(_id));
+        }
+
         static void Register(duk_context* ctx)
         {
             dukglue_register_property(ctx, &ScPlayer::id_get, nullptr, "id");
@@ -257,6 +299,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_property(ctx, &ScPlayer::moneySpent_get, nullptr, "moneySpent");
             dukglue_register_property(ctx, &ScPlayer::ipAddress_get, nullptr, "ipAddress");
             dukglue_register_property(ctx, &ScPlayer::publicKeyHash_get, nullptr, "publicKeyHash");
+            dukglue_register_property(ctx, &ScPlayer::stats_get, nullptr, "stats");
         }
     };
 
@@ -319,6 +362,11 @@ namespace OpenRCT2::Scripting
 #    endif
         }
 
+        DukValue stats_get() const
+        {
+            return NetworkStatsToDuk(_context, network_get_stats());
+        }
+
         std::vector<std::shared_ptr<ScPlayerGroup>> groups_get() const
         {
             std::vector<std::shared_ptr<ScPlayerGroup>> groups;
@@ -491,6 +539,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_property(ctx, &ScNetwork::players_get, nullptr, "players");
             dukglue_register_property(ctx, &ScNetwork::currentPlayer_get, nullptr, "currentPlayer");
             dukglue_register_property(ctx, &ScNetwork::defaultGroup_get, &ScNetwork::defaultGroup_set, "defaultGroup");
+            dukglue_register_property(ctx, &ScNetwork::stats_get, nullptr, "stats");
             dukglue_register_method(ctx, &ScNetwork::addGroup, "addGroup");
             dukglue_register_method(ctx, &ScNetwork::getGroup, "getGroup");
             dukglue_register_method(ctx, &ScNetwork::removeGroup, "removeGroup");
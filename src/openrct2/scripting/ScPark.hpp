@@ -17,9 +17,11 @@
 #    include "../core/String.hpp"
 #    include "../management/Finance.h"
 #    include "../management/NewsItem.h"
+#    include "../peep/Peep.h"
 #    include "../windows/Intent.h"
 #    include "../world/Park.h"
 #    include "Duktape.hpp"
+#    include "ScRide.hpp"
 #    include "ScriptEngine.h"
 
 #    include <algorithm>
@@ -334,6 +336,71 @@ namespace OpenRCT2::Scripting
             gfx_invalidate_screen();
         }
 
+        DukValue getGuestStats() const
+        {
+            // Needs of the guests in the park are averaged, the guests heading to the park are only counted
+            int32_t count = 0;
+            int32_t inPark = 0;
+            int32_t queuing = 0;
+            int32_t onRide = 0;
+            uint32_t happiness = 0;
+            uint32_t energy = 0;
+            uint32_t hunger = 0;
+            uint32_t thirst = 0;
+            uint32_t nausea = 0;
+            uint32_t toilet = 0;
+            money32 cashInPocket = 0;
+            money32 cashSpent = 0;
+            for (auto peep : EntityList<Guest>(EntityListId::Peep))
+            {
+                count++;
+                if (peep->OutsideOfPark)
+                    continue;
+
+                inPark++;
+                if (peep->State == PeepState::Queuing)
+                    queuing++;
+                else if (peep->State == PeepState::OnRide)
+                    onRide++;
+                happiness += peep->Happiness;
+                energy += peep->Energy;
+                hunger += peep->Hunger;
+                thirst += peep->Thirst;
+                nausea += peep->Nausea;
+                toilet += peep->Toilet;
+                cashInPocket += peep->CashInPocket;
+                cashSpent += peep->CashSpent;
+            }
+
+            auto average = [inPark](uint32_t total) { return inPark != 0 ? static_cast<double>(total) / inPark : 0.0; };
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            DukObject obj(ctx);
+            obj.Set("count", count);
+            obj.Set("inPark", inPark);
+            obj.Set("queuing", queuing);
+            obj.Set("onRide", onRide);
+            obj.Set("happiness", average(happiness));
+            obj.Set("energy", average(energy));
+            obj.Set("hunger", average(hunger));
+            obj.Set("thirst", average(thirst));
+            obj.Set("nausea", average(nausea));
+            obj.Set("toilet", average(toilet));
+            obj.Set("cashInPocket", cashInPocket);
+            obj.Set("cashSpent", cashSpent);
+            return obj.Take();
+        }
+
+        std::vector<DukValue> getRideStats() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            std::vector<DukValue> result;
+            for (const auto& ride : GetRideManager())
+            {
+                result.push_back(ScRide::GetStats(ctx, ride));
+            }
+            return result;
+        }
+
         std::vector<std::shared_ptr<ScParkMessage>> messages_get() const
         {
             std::vector<std::shared_ptr<ScParkMessage>> result;
@@ -432,6 +499,8 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScPark::getFlag, "getFlag");
             dukglue_register_method(ctx, &ScPark::setFlag, "setFlag");
             dukglue_register_method(ctx, &ScPark::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScPark::getGuestStats, "getGuestStats");
+            dukglue_register_method(ctx, &ScPark::getRideStats, "getRideStats");
         }
     };
 } // namespace OpenRCT2::Scripting
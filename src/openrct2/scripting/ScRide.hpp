@@ -14,6 +14,7 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../ride/Ride.h"
+#    include "../ride/RideLocationIndex.h"
 #    include "Duktape.hpp"
 #    include "ScObject.hpp"
 #    include "ScriptEngine.h"
@@ -185,6 +186,44 @@ namespace OpenRCT2::Scripting
         {
         }
 
+        static DukValue GetStats(duk_context* ctx, const Ride& ride)
+        {
+            DukObject obj(ctx);
+            obj.Set("id", static_cast<int32_t>(ride.id));
+            obj.Set("queueLength", ride.GetTotalQueueLength());
+            obj.Set("maxQueueTime", ride.GetMaxQueueTime());
+            obj.Set("riders", static_cast<int32_t>(ride.num_riders));
+            obj.Set("customersPerHour", ride_customers_per_hour(&ride));
+            obj.Set("totalCustomers", ride.total_customers);
+            obj.Set("incomePerHour", ride.income_per_hour);
+            obj.Set("profit", ride.profit);
+            obj.Set("totalProfit", ride.total_profit);
+            obj.Set("satisfaction", static_cast<int32_t>(ride.satisfaction));
+            obj.Set("popularity", static_cast<int32_t>(ride.popularity));
+            return obj.Take();
+        }
+
+        static DukValue GetMeasurementSamples(duk_context* ctx, const std::vector<RideMeasurementSample>& samples)
+        {
+            auto pushValues = [ctx, &samples](auto getValue) {
+                duk_push_array(ctx);
+                duk_uarridx_t index = 0;
+                for (const auto& sample : samples)
+                {
+                    duk_push_int(ctx, getValue(sample));
+                    duk_put_prop_index(ctx, -2, index++);
+                }
+                return DukValue::take_from_stack(ctx);
+            };
+
+            DukObject obj(ctx);
+            obj.Set("velocity", pushValues([](const RideMeasurementSample& s) { return s.Velocity; }));
+            obj.Set("altitude", pushValues([](const RideMeasurementSample& s) { return s.Altitude; }));
+            obj.Set("vertical", pushValues([](const RideMeasurementSample& s) { return s.Vertical; }));
+            obj.Set("lateral", pushValues([](const RideMeasurementSample& s) { return s.Lateral; }));
+            return obj.Take();
+        }
+
     private:
         int32_t id_get() const
         {
@@ -498,6 +537,7 @@ namespace OpenRCT2::Scripting
             if (ride != nullptr)
             {
                 ride->excitement = value;
+                ride_visible_from_anywhere_invalidate();
             }
         }
 
@@ -640,6 +680,36 @@ namespace OpenRCT2::Scripting
             }
         }
 
+        DukValue getStats() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto ride = GetRide();
+            if (ride != nullptr)
+            {
+                return GetStats(ctx, *ride);
+            }
+            return ToDuk(ctx, nullptr);
+        }
+
+        DukValue getMeasurements() const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto ride = GetRide();
+            if (ride == nullptr || ride->measurement_recorder == nullptr)
+            {
+                return ToDuk(ctx, nullptr);
+            }
+
+            const auto& recorder = *ride->measurement_recorder;
+            DukObject obj(ctx);
+            obj.Set("numSamples", recorder.GetNumSamples());
+            obj.Set("ticksPerSample", RideMeasurementRecorder::TicksPerSample);
+            obj.Set("historyInterval", static_cast<uint32_t>(RideMeasurementRecorder::HistoryInterval));
+            obj.Set("recent", GetMeasurementSamples(ctx, recorder.GetRecent()));
+            obj.Set("history", GetMeasurementSamples(ctx, recorder.GetHistory()));
+            return obj.Take();
+        }
+
         Ride* GetRide() const
         {
             return get_ride(_rideId);
@@ -679,6 +749,8 @@ namespace OpenRCT2::Scripting
             dukglue_register_property(
                 ctx, &ScRide::inspectionInterval_get, &ScRide::inspectionInterval_set, "inspectionInterval");
             dukglue_register_property(ctx, &ScRide::value_get, &ScRide::value_set, "value");
+            dukglue_register_method(ctx, &ScRide::getStats, "getStats");
+            dukglue_register_method(ctx, &ScRide::getMeasurements, "getMeasurements");
         }
     };
 } // namespace OpenRCT2::Scripting
@@ -18,6 +18,7 @@
 #        include "ScriptEngine.h"
 
 #        include <algorithm>
+#        include <cstring>
 #        include <vector>
 
 namespace OpenRCT2::Scripting
@@ -99,7 +100,18 @@ namespace OpenRCT2::Scripting
             return _plugin;
         }
 
-        virtual void Update() = 0;
+        // The socket to wait on before updating, nullptr if it should be updated regardless
+        virtual ITcpSocket* GetPollSocket() const
+        {
+            return nullptr;
+        }
+
+        virtual bool HasPendingWrites() const
+        {
+            return false;
+        }
+
+        virtual void Update(bool readable, bool writable) = 0;
 
         virtual void Dispose()
         {
@@ -116,12 +128,24 @@ namespace OpenRCT2::Scripting
         static constexpr uint32_t EVENT_DATA = 1;
         static constexpr uint32_t EVENT_CONNECT_ONCE = 2;
         static constexpr uint32_t EVENT_ERROR = 3;
+        static constexpr uint32_t EVENT_DRAIN = 4;
+
+        // Most data read in one update, it is handed to the plugin as a single data event
+        static constexpr size_t MAX_RECEIVE_PER_UPDATE = 64 * 1024;
+        // Once this much is waiting to be sent, write returns false until the drain event
+        static constexpr size_t SEND_HIGH_WATER_MARK = 64 * 1024;
 
         EventList _eventList;
         std::unique_ptr<ITcpSocket> _socket;
+        std::vector<uint8_t> _receiveBuffer;
+        std::vector<uint8_t> _sendQueue;
+        size_t _sendOffset{};
         bool _disposed{};
         bool _connecting{};
         bool _wasConnected{};
+        bool _binary{};
+        bool _drainPending{};
+        bool _finishPending{};
 
     public:
         ScSocket(const std::shared_ptr<Plugin>& plugin)
@@ -151,6 +175,17 @@ namespace OpenRCT2::Scripting
             return this;
         }
 
+        ScSocket* setBinary(bool binary)
+        {
+            _binary = binary;
+            return this;
+        }
+
+        size_t bufferedAmount_get() const
+        {
+            return _sendQueue.size() - _sendOffset;
+        }
+
         ScSocket* connect(uint16_t port, const std::string& host, const DukValue& callback)
         {
             auto ctx = GetContext()->GetScriptEngine().GetContext();
@@ -196,39 +231,50 @@ namespace OpenRCT2::Scripting
             }
             else if (_socket != nullptr)
             {
-                if (data.type() == DukValue::Type::STRING)
+                if (data.type() != DukValue::Type::UNDEFINED)
+                {
+                    write(data);
+                }
+
+                // Anything still queued is sent before the socket is shut down
+                if (bufferedAmount_get() == 0)
                 {
-                    write(data.as_string());
                     _socket->Finish();
                 }
                 else
                 {
-                    _socket->Finish();
-                    auto ctx = GetContext()->GetScriptEngine().GetContext();
-                    duk_error(ctx, DUK_ERR_ERROR, "Only sending strings is currently supported.");
+                    _finishPending = true;
                 }
             }
             return this;
         }
 
-        bool write(const std::string& data)
+        bool write(const DukValue& data)
         {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
             if (_disposed)
             {
-                auto ctx = GetContext()->GetScriptEngine().GetContext();
                 duk_error(ctx, DUK_ERR_ERROR, "Socket is disposed.");
             }
-            else if (_socket != nullptr)
+            else if (_socket != nullptr && !_finishPending)
             {
-                try
+                if (data.type() == DukValue::Type::STRING)
                 {
-                    auto sentBytes = _socket->SendData(data.c_str(), data.size());
-                    return sentBytes != data.size();
+                    const auto& str = data.as_string();
+                    return Send(str.data(), str.size());
                 }
-                catch (const std::exception&)
+
+                data.push();
+                if (duk_is_buffer_data(ctx, -1))
                 {
-                    return false;
+                    duk_size_t size{};
+                    auto buffer = duk_get_buffer_data(ctx, -1, &size);
+                    auto result = Send(buffer, size);
+                    duk_pop(ctx);
+                    return result;
                 }
+                duk_pop(ctx);
+                duk_error(ctx, DUK_ERR_ERROR, "Only strings and buffers can be sent.");
             }
             return false;
         }
@@ -273,11 +319,126 @@ namespace OpenRCT2::Scripting
             _eventList.Raise(EVENT_CLOSE, GetPlugin(), { ToDuk(ctx, hadError) }, false);
         }
 
-        void RaiseOnData(const std::string& data)
+        void RaiseOnData(const uint8_t* data, size_t size)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
-            _eventList.Raise(EVENT_DATA, GetPlugin(), { ToDuk(ctx, data) }, false);
+            if (_binary)
+            {
+                auto buffer = duk_push_fixed_buffer(ctx, size);
+                std::memcpy(buffer, data, size);
+                duk_push_buffer_object(ctx, -1, 0, size, DUK_BUFOBJ_ARRAYBUFFER);
+                duk_remove(ctx, -2);
+                _eventList.Raise(EVENT_DATA, GetPlugin(), { DukValue::take_from_stack(ctx) }, false);
+            }
+            else
+            {
+                auto str = std::string_view(reinterpret_cast<const char*>(data), size);
+                _eventList.Raise(EVENT_DATA, GetPlugin(), { ToDuk(ctx, str) }, false);
+            }
+        }
+
+        bool Send(const void* data, size_t size)
+        {
+            try
+            {
+                // Only queue what the socket does not take straight away
+                size_t sentBytes = 0;
+                if (bufferedAmount_get() == 0)
+                {
+                    sentBytes = _socket->SendData(data, size);
+                }
+                auto remaining = static_cast<const uint8_t*>(data) + sentBytes;
+                _sendQueue.insert(_sendQueue.end(), remaining, static_cast<const uint8_t*>(data) + size);
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            if (bufferedAmount_get() >= SEND_HIGH_WATER_MARK)
+            {
+                _drainPending = true;
+                return false;
+            }
+            return true;
+        }
+
+        void FlushSendQueue()
+        {
+            if (bufferedAmount_get() != 0)
+            {
+                try
+                {
+                    _sendOffset += _socket->SendData(_sendQueue.data() + _sendOffset, bufferedAmount_get());
+                }
+                catch (const std::exception&)
+                {
+                    return;
+                }
+
+                if (_sendOffset == _sendQueue.size())
+                {
+                    _sendQueue.clear();
+                    _sendOffset = 0;
+                }
+                else if (_sendOffset >= SEND_HIGH_WATER_MARK)
+                {
+                    _sendQueue.erase(_sendQueue.begin(), _sendQueue.begin() + _sendOffset);
+                    _sendOffset = 0;
+                }
+            }
+
+            if (bufferedAmount_get() == 0)
+            {
+                if (_finishPending)
+                {
+                    _finishPending = false;
+                    _socket->Finish();
+                }
+                if (_drainPending)
+                {
+                    _drainPending = false;
+                    _eventList.Raise(EVENT_DRAIN, GetPlugin(), {}, false);
+                }
+            }
+        }
+
+        void Receive()
+        {
+            // Read everything the socket has, up to the limit, so the plugin gets one event instead of one per chunk
+            if (_receiveBuffer.empty())
+            {
+                _receiveBuffer.resize(MAX_RECEIVE_PER_UPDATE);
+            }
+
+            size_t totalRead = 0;
+            auto disconnected = false;
+            while (totalRead < _receiveBuffer.size())
+            {
+                auto requested = _receiveBuffer.size() - totalRead;
+                size_t bytesRead{};
+                auto result = _socket->ReceiveData(_receiveBuffer.data() + totalRead, requested, &bytesRead);
+                totalRead += bytesRead;
+                if (result == NetworkReadPacket::Disconnected)
+                {
+                    disconnected = true;
+                    break;
+                }
+                if (result != NetworkReadPacket::Success || bytesRead < requested)
+                {
+                    break;
+                }
+            }
+
+            if (totalRead != 0)
+            {
+                RaiseOnData(_receiveBuffer.data(), totalRead);
+            }
+            if (disconnected)
+            {
+                CloseSocket();
+            }
         }
 
         uint32_t GetEventType(std::string_view name)
@@ -288,11 +449,27 @@ namespace OpenRCT2::Scripting
                 return EVENT_DATA;
             if (name == "error")
                 return EVENT_ERROR;
+            if (name == "drain")
+                return EVENT_DRAIN;
             return EVENT_NONE;
         }
 
     public:
-        void Update() override
+        ITcpSocket* GetPollSocket() const override
+        {
+            if (_socket != nullptr && !_connecting && _socket->GetStatus() == SocketStatus::Connected)
+            {
+                return _socket.get();
+            }
+            return nullptr;
+        }
+
+        bool HasPendingWrites() const override
+        {
+            return bufferedAmount_get() != 0;
+        }
+
+        void Update(bool readable, bool writable) override
         {
             if (_disposed)
                 return;
@@ -326,21 +503,13 @@ namespace OpenRCT2::Scripting
                 }
                 else if (status == SocketStatus::Connected)
                 {
-                    char buffer[2048];
-                    size_t bytesRead{};
-                    auto result = _socket->ReceiveData(buffer, sizeof(buffer), &bytesRead);
-                    switch (result)
+                    if (writable)
+                    {
+                        FlushSendQueue();
+                    }
+                    if (readable && _socket != nullptr)
                     {
-                        case NetworkReadPacket::Success:
-                            RaiseOnData(std::string(buffer, bytesRead));
-                            break;
-                        case NetworkReadPacket::NoData:
-                            break;
-                        case NetworkReadPacket::MoreData:
-                            break;
-                        case NetworkReadPacket::Disconnected:
-                            CloseSocket();
-                            break;
+                        Receive();
                     }
                 }
                 else
@@ -365,6 +534,8 @@ namespace OpenRCT2::Scripting
         {
             dukglue_register_method(ctx, &ScSocket::destroy, "destroy");
             dukglue_register_method(ctx, &ScSocket::setNoDelay, "setNoDelay");
+            dukglue_register_method(ctx, &ScSocket::setBinary, "setBinary");
+            dukglue_register_property(ctx, &ScSocket::bufferedAmount_get, nullptr, "bufferedAmount");
             dukglue_register_method(ctx, &ScSocket::connect, "connect");
             dukglue_register_method(ctx, &ScSocket::end, "end");
             dukglue_register_method(ctx, &ScSocket::write, "write");
@@ -480,30 +651,37 @@ namespace OpenRCT2::Scripting
         {
         }
 
-        void Update() override
+        ITcpSocket* GetPollSocket() const override
         {
-            if (_disposed)
-                return;
+            if (_socket != nullptr && _socket->GetStatus() == SocketStatus::Listening)
+            {
+                return _socket.get();
+            }
+            return nullptr;
+        }
 
-            if (_socket == nullptr)
+        void Update(bool readable, bool writable) override
+        {
+            if (_disposed || !readable)
                 return;
 
-            if (_socket->GetStatus() == SocketStatus::Listening)
+            // Accept all pending clients, the listener may be closed by a connection handler
+            while (_socket != nullptr && _socket->GetStatus() == SocketStatus::Listening)
             {
                 auto client = _socket->Accept();
-                if (client != nullptr)
-                {
-                    // Default to using Nagle's algorithm like node.js does
-                    client->SetNoDelay(false);
+                if (client == nullptr)
+                    break;
 
-                    auto& scriptEngine = GetContext()->GetScriptEngine();
-                    auto clientSocket = std::make_shared<ScSocket>(GetPlugin(), std::move(client));
-                    scriptEngine.AddSocket(clientSocket);
+                // Default to using Nagle's algorithm like node.js does
+                client->SetNoDelay(false);
 
-                    auto ctx = scriptEngine.GetContext();
-                    auto dukClientSocket = GetObjectAsDukValue(ctx, clientSocket);
-                    _eventList.Raise(EVENT_CONNECTION, GetPlugin(), { dukClientSocket }, false);
-                }
+                auto& scriptEngine = GetContext()->GetScriptEngine();
+                auto clientSocket = std::make_shared<ScSocket>(GetPlugin(), std::move(client));
+                scriptEngine.AddSocket(clientSocket);
+
+                auto ctx = scriptEngine.GetContext();
+                auto dukClientSocket = GetObjectAsDukValue(ctx, clientSocket);
+                _eventList.Raise(EVENT_CONNECTION, GetPlugin(), { dukClientSocket }, false);
             }
         }
 
@@ -15,6 +15,7 @@
 #    include "../common.h"
 #    include "../core/Guard.hpp"
 #    include "../world/Footpath.h"
+#    include "../world/FootpathNodeCache.h"
 #    include "../world/Scenery.h"
 #    include "../world/Sprite.h"
 #    include "../world/Surface.h"
@@ -246,7 +247,7 @@ namespace OpenRCT2::Scripting
             auto el = _element->AsSurface();
             if (el != nullptr)
             {
-                el->SetOwnership(value);
+                map_set_surface_ownership(el, value);
                 Invalidate();
             }
         }
@@ -992,7 +993,9 @@ namespace OpenRCT2::Scripting
 
         void Invalidate()
         {
-            map_invalidate_tile_full(_coords);
+            // Plugins change elements in place, outside of any game action.
+            footpath_node_cache_invalidate();
+            GetContext()->GetScriptEngine().InvalidateTile(_coords);
         }
 
     public:
@@ -1140,42 +1143,23 @@ namespace OpenRCT2::Scripting
                 duk_size_t dataLen{};
                 auto data = duk_get_buffer_data(ctx, -1, &dataLen);
                 auto numElements = dataLen / sizeof(TileElement);
-                if (numElements == 0)
-                {
-                    map_set_tile_element(TileCoordsXY(_coords), nullptr);
-                }
-                else
+
+                // The tile's block is moved once at most, however many elements are added
+                auto first = tile_element_set_count(_coords, static_cast<uint32_t>(numElements));
+                if (first != nullptr)
                 {
-                    auto first = GetFirstElement();
-                    auto currentNumElements = GetNumElements(first);
-                    if (numElements > currentNumElements)
+                    std::memcpy(first, data, numElements * sizeof(TileElement));
+                    // Safely force last tile flag for last element to avoid read overrun
+                    for (size_t i = 0; i < numElements; i++)
                     {
-                        // Allocate space for the extra tile elements (inefficient but works)
-                        auto pos = TileCoordsXYZ(TileCoordsXY(_coords), 0).ToCoordsXYZ();
-                        auto numToInsert = numElements - currentNumElements;
-                        for (size_t i = 0; i < numToInsert; i++)
-                        {
-                            tile_element_insert(pos, 0);
-                        }
-
-                        // Copy data to element span
-                        first = map_get_first_element_at(_coords);
-                        currentNumElements = GetNumElements(first);
-                        if (currentNumElements != 0)
-                        {
-                            std::memcpy(first, data, currentNumElements * sizeof(TileElement));
-                            // Safely force last tile flag for last element to avoid read overrun
-                            first[numElements - 1].SetLastForTile(true);
-                        }
-                    }
-                    else
-                    {
-                        std::memcpy(first, data, numElements * sizeof(TileElement));
-                        // Safely force last tile flag for last element to avoid read overrun
-                        first[numElements - 1].SetLastForTile(true);
+                        first[i].SetLastForTile(i == numElements - 1);
                     }
                 }
-                map_invalidate_tile_full(_coords);
+                else if (numElements != 0)
+                {
+                    duk_error(ctx, DUK_ERR_ERROR, "Unable to allocate elements.");
+                }
+                GetContext()->GetScriptEngine().InvalidateTile(_coords);
             }
         }
 
@@ -1197,10 +1181,7 @@ namespace OpenRCT2::Scripting
             auto origNumElements = GetNumElements(first);
             if (index <= origNumElements)
             {
-                std::vector<TileElement> data(first, first + origNumElements);
-
-                auto pos = TileCoordsXYZ(TileCoordsXY(_coords), 0).ToCoordsXYZ();
-                auto newElement = tile_element_insert(pos, 0);
+                auto newElement = tile_element_insert_at(_coords, index);
                 if (newElement == nullptr)
                 {
                     auto ctx = GetDukContext();
@@ -1208,27 +1189,8 @@ namespace OpenRCT2::Scripting
                 }
                 else
                 {
-                    // Inefficient, requires a dedicated method in tile element manager
-                    first = GetFirstElement();
-                    // Copy elements before index
-                    if (index > 0)
-                    {
-                        std::memcpy(first, &data[0], index * sizeof(TileElement));
-                    }
-                    // Zero new element
-                    std::memset(first + index, 0, sizeof(TileElement));
-                    // Copy elements after index
-                    if (index < origNumElements)
-                    {
-                        std::memcpy(first + index + 1, &data[index], (origNumElements - index) * sizeof(TileElement));
-                    }
-                    for (size_t i = 0; i < origNumElements; i++)
-                    {
-                        first[i].SetLastForTile(false);
-                    }
-                    first[origNumElements].SetLastForTile(true);
-                    map_invalidate_tile_full(_coords);
-                    result = std::make_shared<ScTileElement>(_coords, &first[index]);
+                    GetContext()->GetScriptEngine().InvalidateTile(_coords);
+                    result = std::make_shared<ScTileElement>(_coords, newElement);
                 }
             }
             else
@@ -1246,7 +1208,7 @@ namespace OpenRCT2::Scripting
             if (index < GetNumElements(first))
             {
                 tile_element_remove(&first[index]);
-                map_invalidate_tile_full(_coords);
+                GetContext()->GetScriptEngine().InvalidateTile(_coords);
             }
         }
 
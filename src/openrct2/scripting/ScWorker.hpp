@@ -0,0 +1,281 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../Context.h"
+#    include "Duktape.hpp"
+#    include "ScriptEngine.h"
+
+#    include <condition_variable>
+#    include <memory>
+#    include <mutex>
+#    include <queue>
+#    include <string>
+#    include <thread>
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Runs plugin code on its own Duktape heap and thread. The heap has no access to the game, it can only exchange
+     * messages with the plugin, which are copied as JSON. Messages from the worker are handled on the game thread.
+     */
+    class ScWorker
+    {
+    private:
+        enum class MessageType
+        {
+            Message,
+            Log,
+            Error,
+        };
+
+        struct Message
+        {
+            MessageType Type;
+            std::string Data;
+        };
+
+        // Shared with the worker thread, which may outlive the worker object if it is still busy when terminated
+        struct State
+        {
+            std::mutex Mutex;
+            std::condition_variable Signal;
+            std::queue<std::string> Inbox;
+            std::queue<Message> Outbox;
+            bool Terminated{};
+        };
+
+        std::shared_ptr<Plugin> _plugin;
+        std::shared_ptr<State> _state = std::make_shared<State>();
+        DukValue _onMessage;
+        DukValue _onError;
+        bool _disposed{};
+
+    public:
+        ScWorker(const std::shared_ptr<Plugin>& plugin, const std::string& source)
+            : _plugin(plugin)
+        {
+            std::thread(Run, _state, source).detach();
+        }
+
+        ~ScWorker()
+        {
+            Dispose();
+        }
+
+        const std::shared_ptr<Plugin>& GetPlugin() const
+        {
+            return _plugin;
+        }
+
+        bool IsDisposed() const
+        {
+            return _disposed;
+        }
+
+        void Dispose()
+        {
+            if (!_disposed)
+            {
+                _disposed = true;
+                std::lock_guard<std::mutex> lock(_state->Mutex);
+                _state->Terminated = true;
+                _state->Signal.notify_one();
+            }
+        }
+
+        void Update()
+        {
+            std::queue<Message> messages;
+            {
+                std::lock_guard<std::mutex> lock(_state->Mutex);
+                std::swap(messages, _state->Outbox);
+            }
+
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+            while (!messages.empty() && !_disposed)
+            {
+                auto message = std::move(messages.front());
+                messages.pop();
+                if (message.Type == MessageType::Message)
+                {
+                    auto data = DuktapeTryParseJson(ctx, message.Data);
+                    if (data && _onMessage.is_function())
+                    {
+                        scriptEngine.ExecutePluginCall(_plugin, _onMessage, { *data }, false, "worker");
+                    }
+                }
+                else if (message.Type == MessageType::Error && _onError.is_function())
+                {
+                    scriptEngine.ExecutePluginCall(_plugin, _onError, { ToDuk(ctx, message.Data) }, false, "worker");
+                }
+                else
+                {
+                    scriptEngine.LogPluginInfo(_plugin, "[worker] " + message.Data);
+                }
+            }
+        }
+
+    private:
+        void postMessage(const DukValue& data)
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            if (_disposed)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Worker has been terminated.");
+            }
+
+            data.push();
+            auto json = duk_json_encode(ctx, -1);
+            std::string message = json != nullptr ? json : "null";
+            duk_pop(ctx);
+
+            std::lock_guard<std::mutex> lock(_state->Mutex);
+            _state->Inbox.push(std::move(message));
+            _state->Signal.notify_one();
+        }
+
+        void terminate()
+        {
+            Dispose();
+        }
+
+        DukValue onMessage_get() const
+        {
+            return _onMessage;
+        }
+        void onMessage_set(const DukValue& value)
+        {
+            _onMessage = value;
+        }
+
+        DukValue onError_get() const
+        {
+            return _onError;
+        }
+        void onError_set(const DukValue& value)
+        {
+            _onError = value;
+        }
+
+        static State* GetState(duk_context* ctx)
+        {
+            duk_push_heap_stash(ctx);
+            duk_get_prop_string(ctx, -1, "worker");
+            auto state = static_cast<State*>(duk_get_pointer(ctx, -1));
+            duk_pop_2(ctx);
+            return state;
+        }
+
+        static void PostFromWorker(duk_context* ctx, MessageType type, std::string data)
+        {
+            auto state = GetState(ctx);
+            std::lock_guard<std::mutex> lock(state->Mutex);
+            state->Outbox.push({ type, std::move(data) });
+        }
+
+        static duk_ret_t WorkerPostMessage(duk_context* ctx)
+        {
+            auto json = duk_json_encode(ctx, 0);
+            PostFromWorker(ctx, MessageType::Message, json != nullptr ? json : "null");
+            return 0;
+        }
+
+        static duk_ret_t WorkerLog(duk_context* ctx)
+        {
+            std::string text;
+            auto numArgs = duk_get_top(ctx);
+            for (duk_idx_t i = 0; i < numArgs; i++)
+            {
+                if (i != 0)
+                    text.push_back(' ');
+                text += duk_safe_to_string(ctx, i);
+            }
+            PostFromWorker(ctx, MessageType::Log, std::move(text));
+            return 0;
+        }
+
+        static void SetupWorkerGlobals(duk_context* ctx, State* state)
+        {
+            duk_push_heap_stash(ctx);
+            duk_push_pointer(ctx, state);
+            duk_put_prop_string(ctx, -2, "worker");
+            duk_pop(ctx);
+
+            duk_push_c_function(ctx, WorkerPostMessage, 1);
+            duk_put_global_string(ctx, "postMessage");
+
+            auto consoleIdx = duk_push_object(ctx);
+            duk_push_c_function(ctx, WorkerLog, DUK_VARARGS);
+            duk_put_prop_string(ctx, consoleIdx, "log");
+            duk_put_global_string(ctx, "console");
+        }
+
+        static void Run(std::shared_ptr<State> state, std::string source)
+        {
+            auto ctx = CreateDukHeap();
+            if (ctx == nullptr)
+            {
+                std::lock_guard<std::mutex> lock(state->Mutex);
+                state->Outbox.push({ MessageType::Error, "Unable to create a heap for the worker." });
+                return;
+            }
+
+            SetupWorkerGlobals(ctx, state.get());
+            if (duk_peval_string(ctx, source.c_str()) != 0)
+            {
+                PostFromWorker(ctx, MessageType::Error, duk_safe_to_string(ctx, -1));
+                duk_destroy_heap(ctx);
+                return;
+            }
+            duk_pop(ctx);
+
+            while (true)
+            {
+                std::string message;
+                {
+                    std::unique_lock<std::mutex> lock(state->Mutex);
+                    state->Signal.wait(lock, [&state] { return state->Terminated || !state->Inbox.empty(); });
+                    if (state->Terminated)
+                        break;
+                    message = std::move(state->Inbox.front());
+                    state->Inbox.pop();
+                }
+
+                duk_get_global_string(ctx, "onmessage");
+                if (duk_is_function(ctx, -1))
+                {
+                    duk_push_lstring(ctx, message.data(), message.size());
+                    duk_json_decode(ctx, -1);
+                    if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    {
+                        PostFromWorker(ctx, MessageType::Error, duk_safe_to_string(ctx, -1));
+                    }
+                }
+                duk_pop(ctx);
+            }
+            duk_destroy_heap(ctx);
+        }
+
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_method(ctx, &ScWorker::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScWorker::terminate, "terminate");
+            dukglue_register_property(ctx, &ScWorker::onMessage_get, &ScWorker::onMessage_set, "onMessage");
+            dukglue_register_property(ctx, &ScWorker::onError_get, &ScWorker::onError_set, "onError");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
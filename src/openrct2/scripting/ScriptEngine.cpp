@@ -11,6 +11,7 @@
 
 #    include "ScriptEngine.h"
 
+#    include "../Game.h"
 #    include "../PlatformEnvironment.h"
 #    include "../actions/CustomAction.hpp"
 #    include "../actions/GameAction.h"
@@ -21,6 +22,7 @@
 #    include "../core/Path.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform2.h"
+#    include "../world/Map.h"
 #    include "Duktape.hpp"
 #    include "ScCheats.hpp"
 #    include "ScConsole.hpp"
@@ -36,14 +38,26 @@
 #    include "ScScenario.hpp"
 #    include "ScSocket.hpp"
 #    include "ScTile.hpp"
+#    include "ScWorker.hpp"
 
+#    include <algorithm>
+#    include <atomic>
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdlib>
 #    include <iostream>
 #    include <stdexcept>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
-static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 7;
+static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 10;
+
+// How often a plugin that keeps going over its budget is reported, in milliseconds
+static constexpr uint32_t PLUGIN_BUDGET_WARNING_INTERVAL = 10000;
+
+// How long changes to the shared storage are collected before they are written, in milliseconds
+static constexpr uint32_t SHARED_STORAGE_SAVE_INTERVAL = 2000;
 
 struct ExpressionStringifier final
 {
@@ -347,9 +361,70 @@ public:
     }
 };
 
+// Every allocation of a heap starts with its size, so it can be taken off the total again when it is freed
+static constexpr size_t DUK_HEAP_ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+static std::atomic<size_t> _dukHeapMemoryUsage;
+
+static void* DukHeapAlloc(void*, duk_size_t size)
+{
+    auto header = static_cast<uint8_t*>(std::malloc(DUK_HEAP_ALLOCATION_HEADER_SIZE + size));
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(header) = size;
+    _dukHeapMemoryUsage += size;
+    return header + DUK_HEAP_ALLOCATION_HEADER_SIZE;
+}
+
+static void DukHeapFree(void*, void* ptr)
+{
+    if (ptr != nullptr)
+    {
+        auto header = static_cast<uint8_t*>(ptr) - DUK_HEAP_ALLOCATION_HEADER_SIZE;
+        _dukHeapMemoryUsage -= *reinterpret_cast<size_t*>(header);
+        std::free(header);
+    }
+}
+
+static void* DukHeapRealloc(void* udata, void* ptr, duk_size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return DukHeapAlloc(udata, size);
+    }
+    if (size == 0)
+    {
+        DukHeapFree(udata, ptr);
+        return nullptr;
+    }
+
+    auto header = static_cast<uint8_t*>(ptr) - DUK_HEAP_ALLOCATION_HEADER_SIZE;
+    auto oldSize = *reinterpret_cast<size_t*>(header);
+    auto newHeader = static_cast<uint8_t*>(std::realloc(header, DUK_HEAP_ALLOCATION_HEADER_SIZE + size));
+    if (newHeader == nullptr)
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(newHeader) = size;
+    _dukHeapMemoryUsage += size;
+    _dukHeapMemoryUsage -= oldSize;
+    return newHeader + DUK_HEAP_ALLOCATION_HEADER_SIZE;
+}
+
+duk_context* OpenRCT2::Scripting::CreateDukHeap()
+{
+    return duk_create_heap(DukHeapAlloc, DukHeapRealloc, DukHeapFree, nullptr, nullptr);
+}
+
+size_t OpenRCT2::Scripting::GetDukHeapMemoryUsage()
+{
+    return _dukHeapMemoryUsage;
+}
+
 DukContext::DukContext()
 {
-    _context = duk_create_heap_default();
+    _context = CreateDukHeap();
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -368,6 +443,15 @@ ScriptEngine::ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& en
 {
 }
 
+ScriptEngine::~ScriptEngine()
+{
+    if (!_dirtySharedStorage.empty())
+    {
+        SaveSharedStorage();
+    }
+    WaitForSharedStorageSave();
+}
+
 void ScriptEngine::Initialise()
 {
     auto ctx = static_cast<duk_context*>(_context);
@@ -402,6 +486,7 @@ void ScriptEngine::Initialise()
     ScScenario::Register(ctx);
     ScScenarioObjective::Register(ctx);
     ScStaff::Register(ctx);
+    ScWorker::Register(ctx);
 
     dukglue_register_global(ctx, std::make_shared<ScCheats>(), "cheats");
     dukglue_register_global(ctx, std::make_shared<ScConsole>(_console), "console");
@@ -453,6 +538,11 @@ void ScriptEngine::LoadPlugins()
     _pluginsStarted = false;
 }
 
+std::string ScriptEngine::GetPluginCacheDirectory() const
+{
+    return Path::Combine(_env.GetDirectoryPath(DIRBASE::CACHE), "plugin");
+}
+
 void ScriptEngine::LoadPlugin(const std::string& path)
 {
     auto plugin = std::make_shared<Plugin>(_context, path);
@@ -464,7 +554,7 @@ void ScriptEngine::LoadPlugin(std::shared_ptr<Plugin>& plugin)
     try
     {
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-        plugin->Load();
+        plugin->Load(GetPluginCacheDirectory());
 
         auto metadata = plugin->GetMetadata();
         if (metadata.MinApiVersion <= OPENRCT2_PLUGIN_API_VERSION)
@@ -489,6 +579,8 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
     {
         RemoveCustomGameActions(plugin);
         RemoveSockets(plugin);
+        RemoveWorkers(plugin);
+        RemoveIntervals(plugin);
         _hookEngine.UnsubscribeAll(plugin);
         for (auto callback : _pluginStoppedSubscriptions)
         {
@@ -548,7 +640,7 @@ void ScriptEngine::AutoReloadPlugins()
                     StopPlugin(plugin);
 
                     ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-                    plugin->Load();
+                    plugin->Load(GetPluginCacheDirectory());
                     LogPluginInfo(plugin, "Reloaded");
                     plugin->Start();
                 }
@@ -650,8 +742,43 @@ void ScriptEngine::Update()
         }
     }
 
+    UpdateRealTimeIntervals();
     UpdateSockets();
+    UpdateWorkers();
     ProcessREPL();
+    UpdatePluginBudgets();
+    UpdateSharedStorage();
+}
+
+void ScriptEngine::UpdatePluginBudgets()
+{
+    auto budget = static_cast<uint64_t>(gConfigPlugin.tick_budget) * 1000;
+    auto tick = Platform::GetTicks();
+    for (auto& plugin : _plugins)
+    {
+        auto updateTime = plugin->GetUpdateTime();
+        if (budget != 0 && updateTime > budget
+            && tick - plugin->GetLastBudgetWarningTick() >= PLUGIN_BUDGET_WARNING_INTERVAL)
+        {
+            LogPluginInfo(
+                plugin,
+                "took " + std::to_string(updateTime / 1000) + " ms in one update, the budget is "
+                    + std::to_string(gConfigPlugin.tick_budget) + " ms");
+            plugin->SetLastBudgetWarningTick(tick);
+        }
+        plugin->ResetUpdateTime();
+    }
+}
+
+bool ScriptEngine::IsPluginSuspended(const Plugin& plugin) const
+{
+    // Remote plugins run on every client and have to keep doing the same thing everywhere
+    if (!gConfigPlugin.suspend_over_budget || gConfigPlugin.tick_budget == 0
+        || plugin.GetMetadata().Type == PluginType::Remote)
+    {
+        return false;
+    }
+    return plugin.GetUpdateTime() > static_cast<uint64_t>(gConfigPlugin.tick_budget) * 1000;
 }
 
 void ScriptEngine::ProcessREPL()
@@ -673,6 +800,10 @@ void ScriptEngine::ProcessREPL()
             _console.WriteLine(result);
         }
         duk_pop(_context);
+        if (_isTileEditOpen)
+        {
+            CommitTileEdit();
+        }
         // Signal the promise so caller can continue
         promise.set_value();
     }
@@ -687,10 +818,11 @@ std::future<void> ScriptEngine::Eval(const std::string& s)
 }
 
 DukValue ScriptEngine::ExecutePluginCall(
-    const std::shared_ptr<Plugin>& plugin, const DukValue& func, const std::vector<DukValue>& args, bool isGameStateMutable)
+    const std::shared_ptr<Plugin>& plugin, const DukValue& func, const std::vector<DukValue>& args, bool isGameStateMutable,
+    std::string_view kind)
 {
     DukStackFrame frame(_context);
-    if (func.is_function())
+    if (func.is_function() && !IsPluginSuspended(*plugin))
     {
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, isGameStateMutable);
         func.push();
@@ -698,7 +830,17 @@ DukValue ScriptEngine::ExecutePluginCall(
         {
             arg.push();
         }
+        auto wasTileEditOpen = _isTileEditOpen;
+        auto startTime = std::chrono::steady_clock::now();
         auto result = duk_pcall(_context, static_cast<duk_idx_t>(args.size()));
+        auto duration = std::chrono::steady_clock::now() - startTime;
+        plugin->RecordCall(kind, std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+        // A tile edit does not outlive the call that began it
+        if (!wasTileEditOpen && _isTileEditOpen)
+        {
+            CommitTileEdit();
+        }
         if (result == DUK_EXEC_SUCCESS)
         {
             return DukValue::take_from_stack(_context);
@@ -751,11 +893,11 @@ std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameActio
         DukValue dukResult;
         if (!isExecute)
         {
-            dukResult = ExecutePluginCall(customAction.Owner, customAction.Query, { *dukArgs }, false);
+            dukResult = ExecutePluginCall(customAction.Owner, customAction.Query, { *dukArgs }, false, "action.custom");
         }
         else
         {
-            dukResult = ExecutePluginCall(customAction.Owner, customAction.Execute, { *dukArgs }, true);
+            dukResult = ExecutePluginCall(customAction.Owner, customAction.Execute, { *dukArgs }, true, "action.custom");
         }
         return DukToGameActionResult(dukResult);
     }
@@ -1010,6 +1152,7 @@ const static std::unordered_map<std::string, uint32_t> ActionNameToType = {
     { "signsetname", GAME_COMMAND_SET_SIGN_NAME },
     { "signsetstyle", GAME_COMMAND_SET_SIGN_STYLE },
     { "smallsceneryplace", GAME_COMMAND_PLACE_SCENERY },
+    { "smallsceneryscatter", GAME_COMMAND_SCATTER_SCENERY },
     { "smallsceneryremove", GAME_COMMAND_REMOVE_SCENERY },
     { "stafffire", GAME_COMMAND_FIRE_STAFF_MEMBER },
     { "staffhire", GAME_COMMAND_HIRE_NEW_STAFF_MEMBER },
@@ -1055,11 +1198,11 @@ static std::unique_ptr<GameAction> CreateGameActionFromActionId(const std::strin
 
 void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute)
 {
-    DukStackFrame frame(_context);
-
+    // Nothing is converted for the hooks unless there are any
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
     if (_hookEngine.HasSubscriptions(hookType))
     {
+        DukStackFrame frame(_context);
         DukObject obj(_context);
 
         auto actionId = action.GetType();
@@ -1158,7 +1301,15 @@ void ScriptEngine::InitSharedStorage()
 
 void ScriptEngine::LoadSharedStorage()
 {
+    // Write out anything not saved yet, the storage is read back from the file
+    if (!_dirtySharedStorage.empty())
+    {
+        SaveSharedStorage();
+    }
+    WaitForSharedStorageSave();
+
     InitSharedStorage();
+    _sharedStorageParts.clear();
 
     auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
     try
@@ -1180,20 +1331,74 @@ void ScriptEngine::LoadSharedStorage()
     }
 }
 
-void ScriptEngine::SaveSharedStorage()
+void ScriptEngine::SetSharedStorageDirty(std::string_view ns)
 {
-    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
-    try
+    _dirtySharedStorage.emplace(ns.substr(0, ns.find('.')));
+}
+
+void ScriptEngine::UpdateSharedStorage()
+{
+    auto tick = Platform::GetTicks();
+    if (!_dirtySharedStorage.empty() && tick - _lastSharedStorageSaveTick >= SHARED_STORAGE_SAVE_INTERVAL)
     {
-        _sharedStorage.push();
-        auto json = std::string(duk_json_encode(_context, -1));
-        duk_pop(_context);
+        SaveSharedStorage();
+    }
+}
 
-        File::WriteAllBytes(path, json.c_str(), json.size());
+void ScriptEngine::SaveSharedStorage()
+{
+    // The heap can only be used from this thread, so the changed namespaces are encoded here. Putting the file
+    // together and writing it is left to another thread.
+    std::vector<std::shared_ptr<const std::string>> parts;
+    _sharedStorage.push();
+    duk_enum(_context, -1, DUK_ENUM_OWN_PROPERTIES_ONLY);
+    while (duk_next(_context, -1, true))
+    {
+        std::string ns = duk_get_string(_context, -2);
+        auto& part = _sharedStorageParts[ns];
+        if (part == nullptr || _dirtySharedStorage.count(ns) != 0)
+        {
+            auto value = duk_json_encode(_context, -1);
+            auto key = duk_json_encode(_context, -2);
+            part = std::make_shared<const std::string>(std::string(key) + ':' + (value != nullptr ? value : "null"));
+        }
+        parts.push_back(part);
+        duk_pop_2(_context);
     }
-    catch (const std::exception&)
+    duk_pop_2(_context);
+    _dirtySharedStorage.clear();
+    _lastSharedStorageSaveTick = Platform::GetTicks();
+
+    WaitForSharedStorageSave();
+    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
+    _sharedStorageSaveTask = std::async(std::launch::async, [path, parts = std::move(parts)]() {
+        std::string json = "{";
+        for (const auto& part : parts)
+        {
+            if (json.size() > 1)
+            {
+                json.push_back(',');
+            }
+            json += *part;
+        }
+        json.push_back('}');
+
+        try
+        {
+            File::WriteAllBytes(path, json.c_str(), json.size());
+        }
+        catch (const std::exception&)
+        {
+            fprintf(stderr, "Unable to write to '%s'\n", path.c_str());
+        }
+    });
+}
+
+void ScriptEngine::WaitForSharedStorageSave()
+{
+    if (_sharedStorageSaveTask.valid())
     {
-        fprintf(stderr, "Unable to write to '%s'\n", path.c_str());
+        _sharedStorageSaveTask.wait();
     }
 }
 
@@ -1207,12 +1412,42 @@ void ScriptEngine::AddSocket(const std::shared_ptr<ScSocketBase>& socket)
 void ScriptEngine::UpdateSockets()
 {
 #    ifndef DISABLE_NETWORK
+    // Wait on all connected sockets at once without blocking, only the ones that are ready need reading or writing
+    if (_socketPoller == nullptr)
+    {
+        _socketPoller = CreateSocketPoller();
+    }
+    _socketPoller->Clear();
+    _polledSockets.clear();
+    for (auto& socket : _sockets)
+    {
+        auto pollSocket = socket->GetPollSocket();
+        if (pollSocket != nullptr)
+        {
+            _socketPoller->Add(*pollSocket, socket->HasPendingWrites());
+            _polledSockets.push_back(socket.get());
+        }
+    }
+    if (!_polledSockets.empty())
+    {
+        _socketPoller->Wait(0);
+    }
+
     // Use simple for i loop as Update calls can modify the list
+    size_t pollIndex = 0;
     auto it = _sockets.begin();
     while (it != _sockets.end())
     {
         auto& socket = *it;
-        socket->Update();
+        auto readable = true;
+        auto writable = true;
+        if (pollIndex < _polledSockets.size() && _polledSockets[pollIndex] == socket.get())
+        {
+            readable = _socketPoller->IsReadable(pollIndex);
+            writable = _socketPoller->IsWritable(pollIndex);
+            pollIndex++;
+        }
+        socket->Update(readable, writable);
         if (socket->IsDisposed())
         {
             it = _sockets.erase(it);
@@ -1245,6 +1480,189 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+uint64_t ScriptEngine::GetIntervalTime()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+IntervalHandle ScriptEngine::AddInterval(
+    const std::shared_ptr<Plugin>& plugin, uint32_t delay, bool repeat, bool tickAligned, const DukValue& callback)
+{
+    auto handle = _nextIntervalHandle++;
+    auto& interval = _intervals[handle];
+    interval.Owner = plugin;
+    interval.Callback = callback;
+    interval.Delay = std::max<uint32_t>(delay, 1);
+    interval.Repeat = repeat;
+    interval.TickAligned = tickAligned;
+    if (tickAligned)
+    {
+        interval.Due = gCurrentTicks + interval.Delay;
+        _tickIntervalQueue.emplace(interval.Due, handle);
+    }
+    else
+    {
+        interval.Due = GetIntervalTime() + interval.Delay;
+        _realTimeIntervalQueue.emplace(interval.Due, handle);
+    }
+    return handle;
+}
+
+void ScriptEngine::RemoveInterval(const std::shared_ptr<Plugin>& plugin, IntervalHandle handle)
+{
+    auto it = _intervals.find(handle);
+    if (it != _intervals.end() && it->second.Owner == plugin)
+    {
+        _intervals.erase(it);
+    }
+}
+
+void ScriptEngine::RemoveIntervals(const std::shared_ptr<Plugin>& plugin)
+{
+    for (auto it = _intervals.begin(); it != _intervals.end();)
+    {
+        if (it->second.Owner == plugin)
+        {
+            it = _intervals.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::UpdateRealTimeIntervals()
+{
+    if (!_realTimeIntervalQueue.empty())
+    {
+        RunDueIntervals(_realTimeIntervalQueue, GetIntervalTime());
+    }
+}
+
+void ScriptEngine::UpdateTickIntervals()
+{
+    if (!_tickIntervalQueue.empty())
+    {
+        RunDueIntervals(_tickIntervalQueue, gCurrentTicks);
+    }
+}
+
+void ScriptEngine::RunDueIntervals(IntervalQueue& queue, uint64_t now)
+{
+    while (!queue.empty() && queue.top().first <= now)
+    {
+        auto [due, handle] = queue.top();
+        queue.pop();
+
+        auto it = _intervals.find(handle);
+        if (it == _intervals.end() || it->second.Due != due)
+        {
+            continue;
+        }
+
+        // Callbacks may add or clear intervals, including their own
+        auto owner = it->second.Owner;
+        auto callback = it->second.Callback;
+        auto isGameStateMutable = it->second.TickAligned;
+        if (it->second.Repeat)
+        {
+            // An interval that fell behind is not run again for every time it was missed
+            auto& interval = it->second;
+            interval.Due = std::max(due + interval.Delay, now + 1);
+            queue.emplace(interval.Due, handle);
+        }
+        else
+        {
+            _intervals.erase(it);
+        }
+        ExecutePluginCall(owner, callback, {}, isGameStateMutable, isGameStateMutable ? "interval.tick" : "interval");
+    }
+}
+
+void ScriptEngine::BeginTileEdit()
+{
+    _isTileEditOpen = true;
+}
+
+void ScriptEngine::CommitTileEdit()
+{
+    _isTileEditOpen = false;
+    for (const auto& coords : _editedTiles)
+    {
+        map_invalidate_tile_full(coords);
+    }
+    _editedTiles.clear();
+    _editedTileIndices.clear();
+}
+
+void ScriptEngine::InvalidateTile(const CoordsXY& coords)
+{
+    if (!_isTileEditOpen)
+    {
+        map_invalidate_tile_full(coords);
+    }
+    else
+    {
+        auto tilePos = TileCoordsXY(coords);
+        auto index = static_cast<uint32_t>(tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x);
+        if (_editedTileIndices.insert(index).second)
+        {
+            _editedTiles.push_back(coords);
+        }
+    }
+}
+
+void ScriptEngine::AddWorker(const std::shared_ptr<ScWorker>& worker)
+{
+    _workers.push_back(worker);
+}
+
+size_t ScriptEngine::GetNumWorkers(const std::shared_ptr<Plugin>& plugin) const
+{
+    return std::count_if(_workers.begin(), _workers.end(), [&plugin](const std::shared_ptr<ScWorker>& worker) {
+        return worker->GetPlugin() == plugin;
+    });
+}
+
+void ScriptEngine::UpdateWorkers()
+{
+    // Messages might terminate workers or create new ones
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = *it;
+        worker->Update();
+        if (worker->IsDisposed())
+        {
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::RemoveWorkers(const std::shared_ptr<Plugin>& plugin)
+{
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = it->get();
+        if (worker->GetPlugin() == plugin)
+        {
+            worker->Dispose();
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
@@ -14,16 +14,19 @@
 #    include "../common.h"
 #    include "../core/FileWatcher.h"
 #    include "../management/Finance.h"
+#    include "../network/Socket.h"
 #    include "../world/Location.hpp"
 #    include "HookEngine.h"
 #    include "Plugin.h"
 
+#    include <functional>
 #    include <future>
 #    include <list>
 #    include <memory>
 #    include <mutex>
 #    include <queue>
 #    include <string>
+#    include <string_view>
 #    include <unordered_map>
 #    include <unordered_set>
 #    include <vector>
@@ -49,6 +52,20 @@ namespace OpenRCT2::Scripting
 #    ifndef DISABLE_NETWORK
     class ScSocketBase;
 #    endif
+    class ScWorker;
+
+    using IntervalHandle = int32_t;
+
+    struct ScriptInterval
+    {
+        std::shared_ptr<Plugin> Owner;
+        DukValue Callback;
+        // In milliseconds, or in game ticks for tick aligned intervals
+        uint32_t Delay{};
+        uint64_t Due{};
+        bool Repeat{};
+        bool TickAligned{};
+    };
 
     class ScriptExecutionInfo
     {
@@ -90,6 +107,13 @@ namespace OpenRCT2::Scripting
         }
     };
 
+    /**
+     * Creates a Duktape heap whose allocations are counted in GetDukHeapMemoryUsage, which covers the heaps of all
+     * plugins and workers.
+     */
+    duk_context* CreateDukHeap();
+    size_t GetDukHeapMemoryUsage();
+
     class DukContext
     {
     private:
@@ -126,6 +150,11 @@ namespace OpenRCT2::Scripting
         HookEngine _hookEngine;
         ScriptExecutionInfo _execInfo;
         DukValue _sharedStorage;
+        // The encoded "namespace":value parts of the shared storage file, only dirty namespaces are encoded again
+        std::unordered_map<std::string, std::shared_ptr<const std::string>> _sharedStorageParts;
+        std::unordered_set<std::string> _dirtySharedStorage;
+        uint32_t _lastSharedStorageSaveTick{};
+        std::future<void> _sharedStorageSaveTask;
 
         std::unique_ptr<FileWatcher> _pluginFileWatcher;
         std::unordered_set<std::string> _changedPluginFiles;
@@ -143,11 +172,28 @@ namespace OpenRCT2::Scripting
         std::unordered_map<std::string, CustomActionInfo> _customActions;
 #    ifndef DISABLE_NETWORK
         std::list<std::shared_ptr<ScSocketBase>> _sockets;
+        std::unique_ptr<ISocketPoller> _socketPoller;
+        std::vector<ScSocketBase*> _polledSockets;
 #    endif
+        std::list<std::shared_ptr<ScWorker>> _workers;
+
+        // Timers by handle, the queues hold when each is due next. Cleared timers are skipped once they come up.
+        using IntervalQueue = std::priority_queue<
+            std::pair<uint64_t, IntervalHandle>, std::vector<std::pair<uint64_t, IntervalHandle>>, std::greater<>>;
+        std::unordered_map<IntervalHandle, ScriptInterval> _intervals;
+        IntervalQueue _realTimeIntervalQueue;
+        IntervalQueue _tickIntervalQueue;
+        IntervalHandle _nextIntervalHandle = 1;
+
+        // Tiles changed while a tile edit is open, they are invalidated once when it is committed
+        bool _isTileEditOpen{};
+        std::vector<CoordsXY> _editedTiles;
+        std::unordered_set<uint32_t> _editedTileIndices;
 
     public:
         ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env);
         ScriptEngine(ScriptEngine&) = delete;
+        ~ScriptEngine();
 
         duk_context* GetContext()
         {
@@ -176,7 +222,7 @@ namespace OpenRCT2::Scripting
         std::future<void> Eval(const std::string& s);
         DukValue ExecutePluginCall(
             const std::shared_ptr<Plugin>& plugin, const DukValue& func, const std::vector<DukValue>& args,
-            bool isGameStateMutable);
+            bool isGameStateMutable, std::string_view kind = "callback");
 
         void LogPluginInfo(const std::shared_ptr<Plugin>& plugin, const std::string_view& message);
 
@@ -195,16 +241,29 @@ namespace OpenRCT2::Scripting
         void RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute);
         std::unique_ptr<GameAction> CreateGameAction(const std::string& actionid, const DukValue& args);
 
+        void SetSharedStorageDirty(std::string_view ns);
         void SaveSharedStorage();
 
 #    ifndef DISABLE_NETWORK
         void AddSocket(const std::shared_ptr<ScSocketBase>& socket);
 #    endif
+        void AddWorker(const std::shared_ptr<ScWorker>& worker);
+
+        IntervalHandle AddInterval(
+            const std::shared_ptr<Plugin>& plugin, uint32_t delay, bool repeat, bool tickAligned, const DukValue& callback);
+        void RemoveInterval(const std::shared_ptr<Plugin>& plugin, IntervalHandle handle);
+        void UpdateTickIntervals();
+
+        void BeginTileEdit();
+        void CommitTileEdit();
+        void InvalidateTile(const CoordsXY& coords);
+        size_t GetNumWorkers(const std::shared_ptr<Plugin>& plugin) const;
 
     private:
         void Initialise();
         void StartPlugins();
         void StopPlugins();
+        std::string GetPluginCacheDirectory() const;
         void LoadPlugin(const std::string& path);
         void LoadPlugin(std::shared_ptr<Plugin>& plugin);
         void StopPlugin(std::shared_ptr<Plugin> plugin);
@@ -213,6 +272,8 @@ namespace OpenRCT2::Scripting
         void SetupHotReloading();
         void AutoReloadPlugins();
         void ProcessREPL();
+        void UpdatePluginBudgets();
+        bool IsPluginSuspended(const Plugin& plugin) const;
         void RemoveCustomGameActions(const std::shared_ptr<Plugin>& plugin);
         std::unique_ptr<GameActions::Result> DukToGameActionResult(const DukValue& d);
         DukValue GameActionResultToDuk(const GameAction& action, const std::unique_ptr<GameActions::Result>& result);
@@ -221,9 +282,19 @@ namespace OpenRCT2::Scripting
 
         void InitSharedStorage();
         void LoadSharedStorage();
+        void UpdateSharedStorage();
+        void WaitForSharedStorageSave();
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        void UpdateRealTimeIntervals();
+        void RunDueIntervals(IntervalQueue& queue, uint64_t now);
+        void RemoveIntervals(const std::shared_ptr<Plugin>& plugin);
+        static uint64_t GetIntervalTime();
+
+        void UpdateWorkers();
+        void RemoveWorkers(const std::shared_ptr<Plugin>& plugin);
     };
 
     bool IsGameStateMutable();
@@ -14,6 +14,7 @@
 #include "../GameState.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
+#include "../StartupTrace.h"
 #include "../Version.h"
 #include "../audio/audio.h"
 #include "../config/Config.h"
@@ -114,6 +115,7 @@ void TitleScreen::SetHideVersionInfo(bool value)
 void TitleScreen::Load()
 {
     log_verbose("TitleScreen::Load()");
+    StartupTraceSpan span("TitleScreen::Load");
 
     if (game_is_paused())
     {
@@ -141,12 +143,23 @@ void TitleScreen::Load()
 
     if (_sequencePlayer != nullptr)
     {
-        _sequencePlayer->Begin(_currentSequence);
+        // The first park of the sequence is read in the background, the menu can already be used while it is.
+        // Update starts playing the sequence once the park is ready.
+        if (_sequencePlayer->Begin(_currentSequence))
+        {
+            _loadedTitleSequenceId = _currentSequence;
+            _firstParkPending = true;
+        }
 
-        // Force the title sequence to load / update so we
-        // don't see a blank screen for a split second.
-        TryLoadSequence();
-        _sequencePlayer->Update();
+        if (!_sequencePlayer->IsLoadingPark())
+        {
+            // Force the title sequence to load / update so we
+            // don't see a blank screen for a split second.
+            StartupTraceSpan sequenceSpan("TitleScreen::TryLoadSequence");
+            TryLoadSequence();
+            _sequencePlayer->Update();
+            _firstParkPending = false;
+        }
     }
 
     log_verbose("TitleScreen::Load() finished");
@@ -161,8 +174,17 @@ void TitleScreen::Update()
 
     if (game_is_not_paused())
     {
-        TryLoadSequence();
-        _sequencePlayer->Update();
+        if (!_sequencePlayer->IsLoadingPark())
+        {
+            TryLoadSequence();
+            if (!_sequencePlayer->Update() && _firstParkPending)
+            {
+                // The sequence begun by Load could not be played, fall back to the others
+                _loadedTitleSequenceId = SIZE_MAX;
+                TryLoadSequence();
+            }
+            _firstParkPending = false;
+        }
 
         int32_t numUpdates = 1;
         if (gGameSpeed > 1)
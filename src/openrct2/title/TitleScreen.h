@@ -45,6 +45,8 @@ namespace OpenRCT2
         size_t _currentSequence = SIZE_MAX;
         bool _hideVersionInfo = false;
         bool _previewingSequence = false;
+        // Set while the sequence begun by Load has not played its first park yet
+        bool _firstParkPending = false;
 
         void TitleInitialise();
         bool TryLoadSequence(bool loadPreview = false);
@@ -16,6 +16,11 @@ struct ITitleSequencePlayer
     virtual ~ITitleSequencePlayer() = default;
 
     virtual int32_t GetCurrentPosition() const abstract;
+    /**
+     * Whether the park the sequence is about to load is still being read in the background, updating the player until
+     * it is done would wait for it.
+     */
+    virtual bool IsLoadingPark() const abstract;
 
     virtual bool Begin(size_t titleSequenceId) abstract;
     virtual void Reset() abstract;
@@ -12,6 +12,7 @@
 #include "../platform/platform.h"
 #include "../scenario/Scenario.h"
 #include "Util.h"
+#include "zlib.h"
 
 #include <algorithm>
 #include <cstring>
@@ -25,7 +26,7 @@ static void encode_chunk_rotate(uint8_t* buffer, size_t length);
 
 bool gUseRLE = true;
 
-uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
+uint32_t sawyercoding_calculate_checksum_scalar(const uint8_t* buffer, size_t length)
 {
     size_t i;
     uint32_t checksum = 0;
@@ -35,6 +36,14 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
     return checksum;
 }
 
+uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
+{
+    static const auto checksumFn = avx2_available()
+        ? sawyercoding_calculate_checksum_avx2
+        : (sse41_available() ? sawyercoding_calculate_checksum_sse4_1 : sawyercoding_calculate_checksum_scalar);
+    return checksumFn(buffer, length);
+}
+
 /**
  *
  *  rct2: 0x006762E1
@@ -91,6 +100,22 @@ size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer,
 
             free(encode_buffer);
             break;
+        case CHUNK_ENCODING_ZLIB:
+        {
+            // Favour speed, the chunks are mostly empty arrays that compress well regardless
+            auto compressedLength = compressBound(static_cast<uLong>(chunkHeader.length));
+            if (compress2(
+                    dst_file + sizeof(sawyercoding_chunk_header), &compressedLength, buffer, chunkHeader.length,
+                    Z_BEST_SPEED)
+                != Z_OK)
+            {
+                chunkHeader.encoding = CHUNK_ENCODING_NONE;
+                return sawyercoding_write_chunk_buffer(dst_file, buffer, chunkHeader);
+            }
+            chunkHeader.length = static_cast<uint32_t>(compressedLength);
+            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
+            break;
+        }
     }
 
     return chunkHeader.length + sizeof(sawyercoding_chunk_header);
@@ -268,6 +293,8 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
  */
 static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
 {
+    static const auto count_run_fn = sse41_available() ? sawyercoding_count_run_sse4_1 : sawyercoding_count_run_scalar;
+
     const uint8_t* src = src_buffer;
     uint8_t* dst = dst_buffer;
     const uint8_t* end_src = src + length;
@@ -286,11 +313,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = static_cast<uint8_t>(count_run_fn(src, std::min<size_t>(125, end_src - src)));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -314,7 +337,57 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
     return dst - dst_buffer;
 }
 
-static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+size_t sawyercoding_count_run_scalar(const uint8_t* src, size_t maxLength)
+{
+    size_t count = 0;
+    while (count < maxLength && src[count] == src[0])
+    {
+        count++;
+    }
+    return count;
+}
+
+size_t sawyercoding_find_repeat_scalar(const uint8_t* src_buffer, size_t length, size_t i, size_t* repeatIndexOut)
+{
+    size_t searchIndex = (i < 32) ? 0 : (i - 32);
+    size_t searchEnd = i - 1;
+
+    size_t bestRepeatIndex = 0;
+    size_t bestRepeatCount = 0;
+    for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
+    {
+        size_t repeatCount = 0;
+        size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
+        // maxRepeatCount should not exceed length
+        assert(repeatIndex + maxRepeatCount < length);
+        assert(i + maxRepeatCount < length);
+        for (size_t j = 0; j <= maxRepeatCount; j++)
+        {
+            if (src_buffer[repeatIndex + j] == src_buffer[i + j])
+            {
+                repeatCount++;
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (repeatCount > bestRepeatCount)
+        {
+            bestRepeatIndex = repeatIndex;
+            bestRepeatCount = repeatCount;
+
+            // Maximum repeat count is 8
+            if (repeatCount == 8)
+                break;
+        }
+    }
+
+    *repeatIndexOut = bestRepeatIndex;
+    return bestRepeatCount;
+}
+
+size_t sawyercoding_encode_repeat_scalar(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
 {
     if (length == 0)
         return 0;
@@ -329,39 +402,8 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
     // Iterate through remainder of the source buffer
     for (size_t i = 1; i < length;)
     {
-        size_t searchIndex = (i < 32) ? 0 : (i - 32);
-        size_t searchEnd = i - 1;
-
-        size_t bestRepeatIndex = 0;
-        size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
-        {
-            size_t repeatCount = 0;
-            size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
-            // maxRepeatCount should not exceed length
-            assert(repeatIndex + maxRepeatCount < length);
-            assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++)
-            {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j])
-                {
-                    repeatCount++;
-                }
-                else
-                {
-                    break;
-                }
-            }
-            if (repeatCount > bestRepeatCount)
-            {
-                bestRepeatIndex = repeatIndex;
-                bestRepeatCount = repeatCount;
-
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
-                    break;
-            }
-        }
+        size_t bestRepeatIndex;
+        size_t bestRepeatCount = sawyercoding_find_repeat_scalar(src_buffer, length, i, &bestRepeatIndex);
 
         if (bestRepeatCount == 0)
         {
@@ -381,6 +423,14 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
     return outLength;
 }
 
+static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    static const auto encodeFn = avx2_available()
+        ? sawyercoding_encode_repeat_avx2
+        : (sse41_available() ? sawyercoding_encode_repeat_sse4_1 : sawyercoding_encode_repeat_scalar);
+    return encodeFn(src_buffer, dst_buffer, length);
+}
+
 static void encode_chunk_rotate(uint8_t* buffer, size_t length)
 {
     size_t i;
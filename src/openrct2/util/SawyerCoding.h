@@ -26,7 +26,9 @@ enum
     CHUNK_ENCODING_NONE,
     CHUNK_ENCODING_RLE,
     CHUNK_ENCODING_RLECOMPRESSED,
-    CHUNK_ENCODING_ROTATE
+    CHUNK_ENCODING_ROTATE,
+    // OpenRCT2 only, not understood by RCT2 itself
+    CHUNK_ENCODING_ZLIB
 };
 
 enum
@@ -56,4 +58,24 @@ int32_t sawyercoding_validate_track_checksum(const uint8_t* src, size_t length);
 int32_t sawyercoding_detect_file_type(const uint8_t* src, size_t length);
 int32_t sawyercoding_detect_rct1_version(int32_t gameVersion);
 
+// The hot loops of the codec for each instruction set, the functions above pick the best one the CPU supports.
+uint32_t sawyercoding_calculate_checksum_scalar(const uint8_t* buffer, size_t length);
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length);
+uint32_t sawyercoding_calculate_checksum_avx2(const uint8_t* buffer, size_t length);
+
+/**
+ * Returns how many of the first maxLength bytes of src are equal to the first one, src must hold at least one byte.
+ */
+size_t sawyercoding_count_run_scalar(const uint8_t* src, size_t maxLength);
+size_t sawyercoding_count_run_sse4_1(const uint8_t* src, size_t maxLength);
+
+/**
+ * Finds the longest run of up to 8 bytes at src[i] that also starts at one of the 32 bytes before it, the first
+ * of those if several are equally long. Returns the length of the run, or 0 if there is none, and its start.
+ */
+size_t sawyercoding_find_repeat_scalar(const uint8_t* src, size_t length, size_t i, size_t* repeatIndex);
+size_t sawyercoding_encode_repeat_scalar(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_repeat_avx2(const uint8_t* src, uint8_t* dst, size_t length);
+
 #endif
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+#include "Util.h"
+
+#ifdef __AVX2__
+
+#    include <immintrin.h>
+
+uint32_t sawyercoding_calculate_checksum_avx2(const uint8_t* buffer, size_t length)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum = zero;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        // Adds up each quarter of the bytes into a 64 bit lane
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(bytes, zero));
+    }
+
+    // The checksum wraps around, so only the low halves of the lanes matter.
+    const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    uint32_t checksum = static_cast<uint32_t>(_mm_cvtsi128_si32(halves))
+        + static_cast<uint32_t>(_mm_extract_epi32(halves, 2));
+    return checksum + sawyercoding_calculate_checksum_scalar(buffer + i, length - i);
+}
+
+/**
+ * Same as sawyercoding_find_repeat_scalar, for i >= 32 and at least 8 bytes from i to the end of the source. Rather
+ * than comparing each of the 32 earlier positions in turn, they are all compared with each next byte at once.
+ */
+static size_t find_repeat_avx2(const uint8_t* src, size_t i, size_t* repeatIndex)
+{
+    const uint8_t* window = src + i - 32;
+    uint32_t candidates = 0xFFFFFFFF;
+    size_t bestRepeatCount = 0;
+    for (size_t j = 0; j < 8; j++)
+    {
+        const __m256i next = _mm256_set1_epi8(static_cast<char>(src[i + j]));
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window + j));
+        const uint32_t matches = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, next)));
+
+        // A repeat can not reach past i, so the run starting at position k of the window is at most 32 - k long.
+        const uint32_t remaining = candidates & matches & (0xFFFFFFFFu >> j);
+        if (remaining == 0)
+            break;
+        candidates = remaining;
+        bestRepeatCount = j + 1;
+    }
+    if (bestRepeatCount != 0)
+    {
+        *repeatIndex = i - 32 + bitscanforward(static_cast<int32_t>(candidates));
+    }
+    return bestRepeatCount;
+}
+
+size_t sawyercoding_encode_repeat_avx2(const uint8_t* src, uint8_t* dst, size_t length)
+{
+    if (length == 0)
+        return 0;
+
+    uint8_t* dstStart = dst;
+    *dst++ = 255;
+    *dst++ = src[0];
+
+    for (size_t i = 1; i < length;)
+    {
+        size_t repeatIndex = 0;
+        size_t repeatCount = (i >= 32 && i + 8 <= length) ? find_repeat_avx2(src, i, &repeatIndex)
+                                                           : sawyercoding_find_repeat_scalar(src, length, i, &repeatIndex);
+        if (repeatCount == 0)
+        {
+            *dst++ = 255;
+            *dst++ = src[i];
+            i++;
+        }
+        else
+        {
+            *dst++ = static_cast<uint8_t>((repeatCount - 1) | ((32 - (i - repeatIndex)) << 3));
+            i += repeatCount;
+        }
+    }
+    return dst - dstStart;
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with AVX2 enabled, when targeting x86!
+#    endif
+
+uint32_t sawyercoding_calculate_checksum_avx2(const uint8_t* buffer, size_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+    return 0;
+}
+
+size_t sawyercoding_encode_repeat_avx2(const uint8_t* src, uint8_t* dst, size_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+    return 0;
+}
+
+#endif // __AVX2__
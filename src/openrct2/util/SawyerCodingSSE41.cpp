@@ -0,0 +1,140 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+#include "Util.h"
+
+#ifdef __SSE4_1__
+
+#    include <immintrin.h>
+
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        // Adds up each half of the bytes into a 64 bit lane
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(bytes, zero));
+    }
+
+    // The checksum wraps around, so only the low halves of the lanes matter.
+    uint32_t checksum = static_cast<uint32_t>(_mm_cvtsi128_si32(sum)) + static_cast<uint32_t>(_mm_extract_epi32(sum, 2));
+    return checksum + sawyercoding_calculate_checksum_scalar(buffer + i, length - i);
+}
+
+size_t sawyercoding_count_run_sse4_1(const uint8_t* src, size_t maxLength)
+{
+    const __m128i first = _mm_set1_epi8(static_cast<char>(src[0]));
+    size_t count = 0;
+    for (; count + 16 <= maxLength; count += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count));
+        const int32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, first));
+        if (equal != 0xFFFF)
+        {
+            return count + bitscanforward(~equal);
+        }
+    }
+    while (count < maxLength && src[count] == src[0])
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Same as sawyercoding_find_repeat_scalar, for i >= 32 and at least 8 bytes from i to the end of the source. Rather
+ * than comparing each of the 32 earlier positions in turn, they are all compared with each next byte at once.
+ */
+static size_t find_repeat_sse4_1(const uint8_t* src, size_t i, size_t* repeatIndex)
+{
+    const uint8_t* window = src + i - 32;
+    uint32_t candidates = 0xFFFFFFFF;
+    size_t bestRepeatCount = 0;
+    for (size_t j = 0; j < 8; j++)
+    {
+        const __m128i next = _mm_set1_epi8(static_cast<char>(src[i + j]));
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + j));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + 16 + j));
+        const uint32_t matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(low, next)))
+            | (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(high, next))) << 16);
+
+        // A repeat can not reach past i, so the run starting at position k of the window is at most 32 - k long.
+        const uint32_t remaining = candidates & matches & (0xFFFFFFFFu >> j);
+        if (remaining == 0)
+            break;
+        candidates = remaining;
+        bestRepeatCount = j + 1;
+    }
+    if (bestRepeatCount != 0)
+    {
+        *repeatIndex = i - 32 + bitscanforward(static_cast<int32_t>(candidates));
+    }
+    return bestRepeatCount;
+}
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src, uint8_t* dst, size_t length)
+{
+    if (length == 0)
+        return 0;
+
+    uint8_t* dstStart = dst;
+    *dst++ = 255;
+    *dst++ = src[0];
+
+    for (size_t i = 1; i < length;)
+    {
+        size_t repeatIndex = 0;
+        size_t repeatCount = (i >= 32 && i + 8 <= length) ? find_repeat_sse4_1(src, i, &repeatIndex)
+                                                           : sawyercoding_find_repeat_scalar(src, length, i, &repeatIndex);
+        if (repeatCount == 0)
+        {
+            *dst++ = 255;
+            *dst++ = src[i];
+            i++;
+        }
+        else
+        {
+            *dst++ = static_cast<uint8_t>((repeatCount - 1) | ((32 - (i - repeatIndex)) << 3));
+            i += repeatCount;
+        }
+    }
+    return dst - dstStart;
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targeting x86!
+#    endif
+
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+size_t sawyercoding_count_run_sse4_1(const uint8_t* src, size_t maxLength)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src, uint8_t* dst, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+#endif // __SSE4_1__
@@ -21,12 +21,15 @@
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../world/Banner.h"
+#include "../world/FootpathNodeCache.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "Intent.h"
 
+#include <algorithm>
 #include <iterator>
 #include <tuple>
+#include <vector>
 
 bool gDisableErrorWindowSound = false;
 
@@ -38,8 +41,45 @@ uint8_t _rideConstructionState2;
 bool _stationConstructed;
 bool _deferClose;
 
+namespace
+{
+    struct ProvisionalTrackPiece
+    {
+        ride_id_t RideIndex;
+        int32_t TrackType;
+        int32_t TrackDirection;
+        int32_t LiftHillAndAlternativeState;
+        CoordsXYZ TrackPos;
+
+        bool operator==(const ProvisionalTrackPiece& rhs) const
+        {
+            return RideIndex == rhs.RideIndex && TrackType == rhs.TrackType && TrackDirection == rhs.TrackDirection
+                && LiftHillAndAlternativeState == rhs.LiftHillAndAlternativeState && TrackPos == rhs.TrackPos;
+        }
+    };
+
+    // Limits the pieces remembered as failed, the height search of the place tool tries one per height.
+    constexpr size_t MaxFailedProvisionalPieces = 512;
+
+    // The ghost placed last, it is still on the map while TRACK_SELECTION_FLAG_TRACK is set and the map has not
+    // changed since, in which case placing the same piece again can be skipped.
+    ProvisionalTrackPiece _provisionalPiece{};
+    money32 _provisionalPieceCost{};
+    uint32_t _provisionalPieceGeneration{};
+
+    // The pieces that could not be placed on the map as it is, so moving the cursor over the same spot does not query
+    // every height again.
+    std::vector<ProvisionalTrackPiece> _failedProvisionalPieces;
+    uint32_t _failedProvisionalPiecesGeneration{};
+} // namespace
+
+static money32 place_provisional_track_piece_on_map(
+    Ride* ride, ride_id_t rideIndex, int32_t trackType, int32_t trackDirection, int32_t liftHillAndAlternativeState,
+    const CoordsXYZ& trackPos);
+
 /**
- *
+ * Places the ghost of a track piece, or keeps the current one if it is already the same piece. The legality of the
+ * piece is only queried again when the piece or the map changes.
  *  rct2: 0x006CA162
  */
 money32 place_provisional_track_piece(
@@ -50,8 +90,50 @@ money32 place_provisional_track_piece(
     if (ride == nullptr)
         return MONEY32_UNDEFINED;
 
-    money32 result;
+    const ProvisionalTrackPiece piece{ rideIndex, trackType, trackDirection, liftHillAndAlternativeState, trackPos };
+    if ((_currentTrackSelectionFlags & TRACK_SELECTION_FLAG_TRACK) && piece == _provisionalPiece
+        && _provisionalPieceGeneration == footpath_node_cache_generation())
+    {
+        return _provisionalPieceCost;
+    }
+
     ride_construction_remove_ghosts();
+
+    // Removing the ghosts changes the map, the failed pieces are checked against the map without them.
+    auto generation = footpath_node_cache_generation();
+    if (_failedProvisionalPiecesGeneration != generation)
+    {
+        _failedProvisionalPieces.clear();
+        _failedProvisionalPiecesGeneration = generation;
+    }
+    if (std::find(_failedProvisionalPieces.begin(), _failedProvisionalPieces.end(), piece)
+        != _failedProvisionalPieces.end())
+    {
+        return MONEY32_UNDEFINED;
+    }
+
+    auto result = place_provisional_track_piece_on_map(
+        ride, rideIndex, trackType, trackDirection, liftHillAndAlternativeState, trackPos);
+    if (result == MONEY32_UNDEFINED)
+    {
+        if (_failedProvisionalPieces.size() >= MaxFailedProvisionalPieces)
+            _failedProvisionalPieces.clear();
+        _failedProvisionalPieces.push_back(piece);
+    }
+    else
+    {
+        _provisionalPiece = piece;
+        _provisionalPieceCost = result;
+        _provisionalPieceGeneration = footpath_node_cache_generation();
+    }
+    return result;
+}
+
+static money32 place_provisional_track_piece_on_map(
+    Ride* ride, ride_id_t rideIndex, int32_t trackType, int32_t trackDirection, int32_t liftHillAndAlternativeState,
+    const CoordsXYZ& trackPos)
+{
+    money32 result;
     if (ride->type == RIDE_TYPE_MAZE)
     {
         int32_t flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "EntityScheduler.h"
+
+#include "../Game.h"
+#include "../peep/Peep.h"
+#include "../ride/Vehicle.h"
+#include "Sprite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+constexpr size_t NUM_ENTITY_UPDATE_GROUPS = static_cast<size_t>(EntityUpdateGroup::Count);
+
+static constexpr const char* EntityUpdateGroupNames[] = {
+    "peep",
+    "vehicle",
+    "misc",
+};
+static_assert(std::size(EntityUpdateGroupNames) == NUM_ENTITY_UPDATE_GROUPS);
+
+static bool _profiling = false;
+static uint32_t _lastTick = 0;
+static std::array<std::array<int64_t, NUM_ENTITY_UPDATE_GROUPS>, ENTITY_SCHEDULER_HISTORY> _samples{};
+static size_t _numSamples = 0;
+
+static int64_t entity_scheduler_now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static void entity_scheduler_run(EntityUpdateGroup group)
+{
+    switch (group)
+    {
+        case EntityUpdateGroup::Peep:
+            peep_update_all();
+            break;
+        case EntityUpdateGroup::Vehicle:
+            vehicle_update_all();
+            break;
+        case EntityUpdateGroup::Misc:
+            sprite_misc_update_all();
+            break;
+        case EntityUpdateGroup::Count:
+            break;
+    }
+}
+
+void entity_scheduler_update(EntityUpdateGroup group)
+{
+    if (!_profiling)
+    {
+        entity_scheduler_run(group);
+        return;
+    }
+
+    // Each tick gets its own row of the history, the first group updated in a tick clears it.
+    auto& sample = _samples[gCurrentTicks % ENTITY_SCHEDULER_HISTORY];
+    if (_numSamples == 0 || _lastTick != gCurrentTicks)
+    {
+        sample.fill(0);
+        _lastTick = gCurrentTicks;
+        _numSamples = std::min(_numSamples + 1, ENTITY_SCHEDULER_HISTORY);
+    }
+
+    auto startTime = entity_scheduler_now();
+    entity_scheduler_run(group);
+    sample[static_cast<size_t>(group)] += entity_scheduler_now() - startTime;
+}
+
+void entity_scheduler_set_profiling(bool enabled)
+{
+    if (enabled && !_profiling)
+    {
+        entity_scheduler_reset();
+    }
+    _profiling = enabled;
+}
+
+bool entity_scheduler_is_profiling()
+{
+    return _profiling;
+}
+
+void entity_scheduler_reset()
+{
+    _numSamples = 0;
+}
+
+EntityUpdateStats entity_scheduler_get_stats()
+{
+    EntityUpdateStats stats{};
+    stats.Tick = _lastTick;
+    if (_numSamples != 0)
+    {
+        // The samples are stored by tick number, the most recent ones are those below the last tick.
+        const auto& last = _samples[_lastTick % ENTITY_SCHEDULER_HISTORY];
+        for (size_t i = 0; i < NUM_ENTITY_UPDATE_GROUPS; i++)
+        {
+            stats.LastNanoseconds[i] = last[i];
+        }
+        for (size_t n = 0; n < _numSamples; n++)
+        {
+            const auto& sample = _samples[(_lastTick - n) % ENTITY_SCHEDULER_HISTORY];
+            for (size_t i = 0; i < NUM_ENTITY_UPDATE_GROUPS; i++)
+            {
+                stats.AverageNanoseconds[i] += sample[i];
+                stats.MaxNanoseconds[i] = std::max(stats.MaxNanoseconds[i], sample[i]);
+            }
+        }
+        for (auto& average : stats.AverageNanoseconds)
+        {
+            average /= static_cast<int64_t>(_numSamples);
+        }
+    }
+
+    // Peeps at the positions in the list matching the tick modulo 128 get their 128 tick update.
+    uint32_t numPeeps = GetEntityListCount(EntityListId::Peep);
+    uint32_t bucket = _lastTick & 0x7F;
+    uint32_t numTick128 = (numPeeps / 128) + ((numPeeps % 128) > bucket ? 1 : 0);
+    // The cars behind a train head are updated by the head.
+    stats.Entities[static_cast<size_t>(EntityUpdateCadence::EveryTick)] = numPeeps
+        + GetEntityListCount(EntityListId::TrainHead) + GetEntityListCount(EntityListId::Vehicle)
+        + GetEntityListCount(EntityListId::Misc);
+    stats.Entities[static_cast<size_t>(EntityUpdateCadence::Every128Ticks)] = numTick128;
+    stats.Entities[static_cast<size_t>(EntityUpdateCadence::Idle)] = GetEntityListCount(EntityListId::Litter);
+    return stats;
+}
+
+const char* entity_scheduler_get_group_name(EntityUpdateGroup group)
+{
+    auto index = static_cast<size_t>(group);
+    return index < NUM_ENTITY_UPDATE_GROUPS ? EntityUpdateGroupNames[index] : "";
+}
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <array>
+
+/**
+ * The groups of entities updated by the game logic, in the order they are updated.
+ */
+enum class EntityUpdateGroup : uint8_t
+{
+    Peep,    // peep_update_all
+    Vehicle, // vehicle_update_all
+    Misc,    // sprite_misc_update_all
+    Count,
+};
+
+/**
+ * How often an entity is updated. Peeps have their 128 tick update spread out over the ticks by their position in the
+ * peep list, litter is never updated.
+ */
+enum class EntityUpdateCadence : uint8_t
+{
+    EveryTick,
+    Every128Ticks,
+    Idle,
+    Count,
+};
+
+// Number of ticks the average update times are taken over, one cycle of the 128 tick updates.
+constexpr size_t ENTITY_SCHEDULER_HISTORY = 128;
+
+struct EntityUpdateStats
+{
+    uint32_t Tick;
+    std::array<int64_t, static_cast<size_t>(EntityUpdateGroup::Count)> LastNanoseconds;
+    std::array<int64_t, static_cast<size_t>(EntityUpdateGroup::Count)> AverageNanoseconds;
+    std::array<int64_t, static_cast<size_t>(EntityUpdateGroup::Count)> MaxNanoseconds;
+    // Number of entities of each cadence that were due in the last tick.
+    std::array<uint32_t, static_cast<size_t>(EntityUpdateCadence::Count)> Entities;
+};
+
+/**
+ * Updates a group of entities, timing it when the scheduler is profiling.
+ */
+void entity_scheduler_update(EntityUpdateGroup group);
+
+void entity_scheduler_set_profiling(bool enabled);
+bool entity_scheduler_is_profiling();
+void entity_scheduler_reset();
+EntityUpdateStats entity_scheduler_get_stats();
+const char* entity_scheduler_get_group_name(EntityUpdateGroup group);
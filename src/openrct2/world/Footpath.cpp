@@ -27,6 +27,7 @@
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
+#include "FootpathNodeCache.h"
 #include "Map.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -34,7 +35,10 @@
 #include "Surface.h"
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
+#include <unordered_map>
+#include <vector>
 
 void footpath_update_queue_entrance_banner(const CoordsXY& footpathPos, TileElement* tileElement);
 
@@ -52,8 +56,19 @@ uint8_t gFootpathConstructValidDirections;
 money32 gFootpathPrice;
 uint8_t gFootpathGroundFlags;
 
+// The cost of the provisional path and the map it was placed on, while PROVISIONAL_PATH_FLAG_1 is set.
+static money32 _footpathProvisionalCost;
+static uint32_t _footpathProvisionalGeneration;
+// The last provisional path that could not be placed, and the map it was tried on.
+static bool _footpathProvisionalFailed;
+static CoordsXYZ _footpathProvisionalFailedPosition;
+static uint8_t _footpathProvisionalFailedType;
+static uint8_t _footpathProvisionalFailedSlope;
+static uint32_t _footpathProvisionalFailedGeneration;
+
 static uint8_t* _footpathQueueChainNext;
 static uint8_t _footpathQueueChain[64];
+static bool _footpathQueueChainBatched;
 
 // This is the coordinates that a user of the bin should move to
 // rct2: 0x00992A4C
@@ -114,7 +129,7 @@ static bool entrance_has_direction(TileElement* tileElement, int32_t direction)
 
 TileElement* map_get_footpath_element(const CoordsXYZ& coords)
 {
-    TileElement* tileElement = map_get_first_element_at(coords);
+    TileElement* tileElement = map_get_first_element_of_type(coords, TILE_ELEMENT_TYPE_PATH);
     do
     {
         if (tileElement == nullptr)
@@ -141,20 +156,46 @@ money32 footpath_remove(const CoordsXYZ& footpathLoc, int32_t flags)
 }
 
 /**
- *
+ * Places the ghost of a footpath, or keeps the current one if it is already the same path. The legality of the path is
+ * only queried again when the path or the map changes.
  *  rct2: 0x006A76FF
  */
 money32 footpath_provisional_set(int32_t type, const CoordsXYZ& footpathLoc, int32_t slope)
 {
-    money32 cost;
+    if ((gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1) && gFootpathProvisionalType == type
+        && gFootpathProvisionalPosition == footpathLoc && gFootpathProvisionalSlope == slope
+        && _footpathProvisionalGeneration == footpath_node_cache_generation())
+    {
+        return _footpathProvisionalCost;
+    }
 
     footpath_provisional_remove();
 
-    auto footpathPlaceAction = FootpathPlaceAction(footpathLoc, slope, type);
-    footpathPlaceAction.SetFlags(GAME_COMMAND_FLAG_GHOST | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED);
-    auto res = GameActions::Execute(&footpathPlaceAction);
-    cost = res->Error == GameActions::Status::Ok ? res->Cost : MONEY32_UNDEFINED;
-    if (res->Error == GameActions::Status::Ok)
+    bool placed = false;
+    money32 cost = MONEY32_UNDEFINED;
+    if (!_footpathProvisionalFailed || _footpathProvisionalFailedType != type
+        || _footpathProvisionalFailedPosition != footpathLoc || _footpathProvisionalFailedSlope != slope
+        || _footpathProvisionalFailedGeneration != footpath_node_cache_generation())
+    {
+        auto footpathPlaceAction = FootpathPlaceAction(footpathLoc, slope, type);
+        footpathPlaceAction.SetFlags(GAME_COMMAND_FLAG_GHOST | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED);
+        auto res = GameActions::Execute(&footpathPlaceAction);
+        placed = res->Error == GameActions::Status::Ok;
+        if (placed)
+        {
+            cost = res->Cost;
+            _footpathProvisionalCost = cost;
+            _footpathProvisionalGeneration = footpath_node_cache_generation();
+        }
+
+        _footpathProvisionalFailed = !placed;
+        _footpathProvisionalFailedType = type;
+        _footpathProvisionalFailedPosition = footpathLoc;
+        _footpathProvisionalFailedSlope = slope;
+        _footpathProvisionalFailedGeneration = footpath_node_cache_generation();
+    }
+
+    if (placed)
     {
         gFootpathProvisionalType = type;
         gFootpathProvisionalPosition = footpathLoc;
@@ -176,7 +217,7 @@ money32 footpath_provisional_set(int32_t type, const CoordsXYZ& footpathLoc, int
 
     if (!scenery_tool_is_active())
     {
-        if (res->Error != GameActions::Status::Ok)
+        if (!placed)
         {
             // If we can't build this, don't show a virtual floor.
             virtual_floor_set_height(0);
@@ -220,6 +261,12 @@ void footpath_provisional_remove()
  *  rct2: 0x006A7831
  */
 void footpath_provisional_update()
+{
+    footpath_provisional_hide_arrow();
+    footpath_provisional_remove();
+}
+
+void footpath_provisional_hide_arrow()
 {
     if (gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_SHOW_ARROW)
     {
@@ -228,7 +275,6 @@ void footpath_provisional_update()
         gMapSelectFlags &= ~MAP_SELECT_FLAG_ENABLE_ARROW;
         map_invalidate_tile_full(gFootpathConstructFromPosition);
     }
-    footpath_provisional_remove();
 }
 
 /**
@@ -1174,6 +1220,10 @@ void footpath_chain_ride_queue(
 
 void footpath_queue_chain_reset()
 {
+    // A batch gathers the rides of all its paths, they are chained once it ends
+    if (_footpathQueueChainBatched)
+        return;
+
     _footpathQueueChainNext = _footpathQueueChain;
 }
 
@@ -1185,6 +1235,10 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
 {
     if (rideIndex != RIDE_ID_NULL)
     {
+        // Chaining a ride's queues twice gives the same result, so don't use up a slot on it
+        if (std::find(_footpathQueueChain, _footpathQueueChainNext, rideIndex) != _footpathQueueChainNext)
+            return;
+
         uint8_t* lastSlot = _footpathQueueChain + std::size(_footpathQueueChain) - 1;
         if (_footpathQueueChainNext <= lastSlot)
         {
@@ -1199,6 +1253,9 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
  */
 void footpath_update_queue_chains()
 {
+    if (_footpathQueueChainBatched)
+        return;
+
     for (uint8_t* queueChainPtr = _footpathQueueChain; queueChainPtr < _footpathQueueChainNext; queueChainPtr++)
     {
         ride_id_t rideIndex = *queueChainPtr;
@@ -1232,6 +1289,19 @@ void footpath_update_queue_chains()
     }
 }
 
+void footpath_queue_chain_begin_batch()
+{
+    footpath_queue_chain_reset();
+    _footpathQueueChainBatched = true;
+}
+
+void footpath_queue_chain_end_batch()
+{
+    _footpathQueueChainBatched = false;
+    footpath_update_queue_chains();
+    footpath_queue_chain_reset();
+}
+
 /**
  *
  *  rct2: 0x0069ADBD
@@ -1280,6 +1350,34 @@ static bool get_next_direction(int32_t edges, int32_t* direction)
     return true;
 }
 
+struct FootpathEdgeSearchBudget
+{
+    int32_t Level;
+    int32_t JunctionTolerance;
+    bool FromJunction;
+
+    // Whether a search with this budget can only get less far than one with the other budget
+    bool IsWithin(const FootpathEdgeSearchBudget& other) const
+    {
+        return Level >= other.Level && JunctionTolerance <= other.JunctionTolerance && (!FromJunction || other.FromJunction);
+    }
+};
+
+/**
+ * The searches from a junction that found no way to the edge, by where they started and how much of the limits were left.
+ * Paths that loop back onto themselves lead to the same searches over and over, which made the search exponential.
+ *
+ * Searches only start from the same place again after one of them has returned, which means they are exploring a junction.
+ * A junction only cares whether one of its directions succeeds, so a failed search can stand in for any later one that has
+ * no more room left. The later one can only explore less of the very same paths, and fixing the ownership of their tiles
+ * again would change nothing.
+ */
+using FootpathEdgeSearchFailures = std::unordered_map<uint64_t, std::vector<FootpathEdgeSearchBudget>>;
+
+static int32_t footpath_is_connected_to_map_edge_recurse(
+    const CoordsXYZ& footpathPos, int32_t direction, int32_t flags, int32_t level, int32_t distanceFromJunction,
+    int32_t junctionTolerance, FootpathEdgeSearchFailures& failures);
+
 /**
  *
  *  rct2: 0x0069AC1A
@@ -1287,9 +1385,9 @@ static bool get_next_direction(int32_t edges, int32_t* direction)
  *              (1 << 5): Unown
  *              (1 << 7): Ignore no entry signs
  */
-static int32_t footpath_is_connected_to_map_edge_recurse(
+static int32_t footpath_is_connected_to_map_edge_search(
     const CoordsXYZ& footpathPos, int32_t direction, int32_t flags, int32_t level, int32_t distanceFromJunction,
-    int32_t junctionTolerance)
+    int32_t junctionTolerance, FootpathEdgeSearchFailures& failures)
 {
     TileElement* tileElement;
     int32_t edges, slopeDirection;
@@ -1389,7 +1487,7 @@ searchFromFootpath:
             targetPos.z += PATH_HEIGHT_STEP;
         }
         return footpath_is_connected_to_map_edge_recurse(
-            targetPos, direction, flags, level, distanceFromJunction + 1, junctionTolerance);
+            targetPos, direction, flags, level, distanceFromJunction + 1, junctionTolerance, failures);
     }
     else
     {
@@ -1413,7 +1511,7 @@ searchFromFootpath:
                 targetPos.z += PATH_HEIGHT_STEP;
             }
             int32_t result = footpath_is_connected_to_map_edge_recurse(
-                targetPos, direction, flags, level, 0, junctionTolerance);
+                targetPos, direction, flags, level, 0, junctionTolerance, failures);
             if (result == FOOTPATH_SEARCH_SUCCESS)
             {
                 return result;
@@ -1424,11 +1522,47 @@ searchFromFootpath:
     }
 }
 
+static int32_t footpath_is_connected_to_map_edge_recurse(
+    const CoordsXYZ& footpathPos, int32_t direction, int32_t flags, int32_t level, int32_t distanceFromJunction,
+    int32_t junctionTolerance, FootpathEdgeSearchFailures& failures)
+{
+    auto key = (static_cast<uint64_t>(footpathPos.x & 0xFFFF) << 34) | (static_cast<uint64_t>(footpathPos.y & 0xFFFF) << 18)
+        | (static_cast<uint64_t>(footpathPos.z & 0xFFFF) << 2) | static_cast<uint64_t>(direction & 3);
+    auto budget = FootpathEdgeSearchBudget{ level, junctionTolerance, distanceFromJunction == 0 };
+
+    auto it = failures.find(key);
+    if (it != failures.end())
+    {
+        for (const auto& failedBudget : it->second)
+        {
+            if (budget.IsWithin(failedBudget))
+            {
+                return FOOTPATH_SEARCH_INCOMPLETE;
+            }
+        }
+    }
+
+    auto result = footpath_is_connected_to_map_edge_search(
+        footpathPos, direction, flags, level, distanceFromJunction, junctionTolerance, failures);
+    if (result != FOOTPATH_SEARCH_SUCCESS)
+    {
+        auto& failedBudgets = failures[key];
+        failedBudgets.erase(
+            std::remove_if(
+                failedBudgets.begin(), failedBudgets.end(),
+                [&budget](const FootpathEdgeSearchBudget& failedBudget) { return failedBudget.IsWithin(budget); }),
+            failedBudgets.end());
+        failedBudgets.push_back(budget);
+    }
+    return result;
+}
+
 // TODO: Use GAME_COMMAND_FLAGS
 int32_t footpath_is_connected_to_map_edge(const CoordsXYZ& footpathPos, int32_t direction, int32_t flags)
 {
     flags |= FOOTPATH_CONNECTED_MAP_EDGE_IGNORE_QUEUES;
-    return footpath_is_connected_to_map_edge_recurse(footpathPos, direction, flags, 0, 0, 16);
+    FootpathEdgeSearchFailures failures;
+    return footpath_is_connected_to_map_edge_recurse(footpathPos, direction, flags, 0, 0, 16, failures);
 }
 
 bool PathElement::IsSloped() const
@@ -1861,6 +1995,120 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+/**
+ * A tile's wide flags only depend on the footpaths around it and the wide flags of the tiles before it in the order
+ * the map used to be swept in, rows from the top with x going first. Working out the queued tiles in that same order,
+ * and queueing the tiles after one whose flags changed, gives the same flags as a sweep over the whole map.
+ */
+static struct
+{
+    bool All = true;
+    // Min-heap of tile indices, y * MAXIMUM_MAP_SIZE_TECHNICAL + x
+    std::vector<uint32_t> Heap;
+    std::vector<bool> Queued = std::vector<bool>(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+} _footpathWideQueue;
+
+static void footpath_queue_wide_flags_tile(int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return;
+    }
+
+    auto& queue = _footpathWideQueue;
+    auto index = static_cast<uint32_t>(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
+    if (!queue.Queued[index])
+    {
+        queue.Queued[index] = true;
+        queue.Heap.push_back(index);
+        std::push_heap(queue.Heap.begin(), queue.Heap.end(), std::greater<uint32_t>());
+    }
+}
+
+void footpath_queue_wide_flags_update(const CoordsXY& footpathPos)
+{
+    auto& queue = _footpathWideQueue;
+    if (queue.All)
+    {
+        return;
+    }
+
+    // Neighbours look at the footpaths of this tile in all eight directions
+    auto tilePos = TileCoordsXY(footpathPos);
+    for (int32_t dy = -1; dy <= 1; dy++)
+    {
+        for (int32_t dx = -1; dx <= 1; dx++)
+        {
+            footpath_queue_wide_flags_tile(tilePos.x + dx, tilePos.y + dy);
+        }
+    }
+}
+
+void footpath_queue_all_wide_flags_update()
+{
+    auto& queue = _footpathWideQueue;
+    queue.All = true;
+    queue.Heap.clear();
+    std::fill(queue.Queued.begin(), queue.Queued.end(), false);
+}
+
+uint64_t footpath_get_wide_flags(const CoordsXY& footpathPos)
+{
+    // One bit for each of the first 64 footpaths on the tile
+    uint64_t flags = 0;
+    int32_t pathIndex = 0;
+    TileElement* tileElement = map_get_first_element_at(footpathPos);
+    if (tileElement == nullptr)
+        return flags;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (pathIndex < 64 && tileElement->AsPath()->IsWide())
+            flags |= 1ULL << pathIndex;
+        pathIndex++;
+    } while (!(tileElement++)->IsLastForTile());
+    return flags;
+}
+
+void footpath_update_queued_wide_flags()
+{
+    auto& queue = _footpathWideQueue;
+    if (queue.All)
+    {
+        queue.All = false;
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                footpath_update_path_wide_flags(TileCoordsXY{ x, y }.ToCoordsXY());
+            }
+        }
+        return;
+    }
+
+    while (!queue.Heap.empty())
+    {
+        std::pop_heap(queue.Heap.begin(), queue.Heap.end(), std::greater<uint32_t>());
+        auto index = queue.Heap.back();
+        queue.Heap.pop_back();
+        queue.Queued[index] = false;
+
+        auto tilePos = TileCoordsXY(index % MAXIMUM_MAP_SIZE_TECHNICAL, index / MAXIMUM_MAP_SIZE_TECHNICAL);
+        auto footpathPos = tilePos.ToCoordsXY();
+        auto oldFlags = footpath_get_wide_flags(footpathPos);
+        footpath_update_path_wide_flags(footpathPos);
+        if (footpath_get_wide_flags(footpathPos) != oldFlags)
+        {
+            // The tiles that look at the wide flags of this one, all of them come after it
+            footpath_queue_wide_flags_tile(tilePos.x + 1, tilePos.y);
+            footpath_queue_wide_flags_tile(tilePos.x - 1, tilePos.y + 1);
+            footpath_queue_wide_flags_tile(tilePos.x, tilePos.y + 1);
+            footpath_queue_wide_flags_tile(tilePos.x + 1, tilePos.y + 1);
+        }
+    }
+}
+
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
 {
     auto pathElement = map_get_path_element_at(position);
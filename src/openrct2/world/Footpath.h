@@ -183,6 +183,7 @@ money32 footpath_remove(const CoordsXYZ& footpathLoc, int32_t flags);
 money32 footpath_provisional_set(int32_t type, const CoordsXYZ& footpathLoc, int32_t slope);
 void footpath_provisional_remove();
 void footpath_provisional_update();
+void footpath_provisional_hide_arrow();
 CoordsXY footpath_get_coordinates_from_pos(const ScreenCoordsXY& screenCoords, int32_t* direction, TileElement** tileElement);
 CoordsXY footpath_bridge_get_info_from_pos(const ScreenCoordsXY& screenCoords, int32_t* direction, TileElement** tileElement);
 void footpath_remove_litter(const CoordsXYZ& footpathPos);
@@ -192,6 +193,16 @@ bool fence_in_the_way(const CoordsXYRangedZ& fencePos, int32_t direction);
 void footpath_chain_ride_queue(
     ride_id_t rideIndex, int32_t entranceIndex, const CoordsXY& footpathPos, TileElement* tileElement, int32_t direction);
 void footpath_update_path_wide_flags(const CoordsXY& footpathPos);
+
+/**
+ * Queues the wide flags of the tile and its neighbours to be worked out again, for when an element on the tile changed.
+ * The queued tiles are updated by footpath_update_queued_wide_flags, along with the tiles after them whose flags
+ * depend on them.
+ */
+void footpath_queue_wide_flags_update(const CoordsXY& footpathPos);
+void footpath_queue_all_wide_flags_update();
+void footpath_update_queued_wide_flags();
+uint64_t footpath_get_wide_flags(const CoordsXY& footpathPos);
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position);
 
 int32_t footpath_is_connected_to_map_edge(const CoordsXYZ& footpathPos, int32_t direction, int32_t flags);
@@ -203,3 +214,9 @@ PathRailingsEntry* get_path_railings_entry(PathRailingsIndex entryIndex);
 
 void footpath_queue_chain_reset();
 void footpath_queue_chain_push(ride_id_t rideIndex);
+/**
+ * Reconnecting a group of paths, such as those of a placed design, chains the queues of every ride involved once when the
+ * batch ends instead of after each path.
+ */
+void footpath_queue_chain_begin_batch();
+void footpath_queue_chain_end_batch();
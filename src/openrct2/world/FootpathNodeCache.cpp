@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathNodeCache.h"
+
+#include "Map.h"
+#include "TileElement.h"
+
+#include <algorithm>
+
+constexpr size_t NUM_TILES = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
+
+// A list is valid while its stamp matches the generation, so invalidating everything is a single increment.
+static uint32_t _generation = 1;
+static std::vector<uint32_t> _tileStamps(NUM_TILES, 0);
+static std::vector<std::vector<TileElement*>> _tileNodes(NUM_TILES);
+static const std::vector<TileElement*> _noNodes;
+
+static bool footpath_node_cache_is_node(const TileElement* tileElement)
+{
+    if (tileElement->IsGhost())
+        return false;
+
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_PATH:
+        case TILE_ELEMENT_TYPE_TRACK:
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const std::vector<TileElement*>& footpath_node_cache_get(const TileCoordsXY& tilePos)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return _noNodes;
+
+    auto index = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+    auto& nodes = _tileNodes[index];
+    if (_tileStamps[index] != _generation)
+    {
+        nodes.clear();
+        auto* tileElement = map_get_first_element_at(tilePos.ToCoordsXY());
+        if (tileElement != nullptr)
+        {
+            do
+            {
+                if (footpath_node_cache_is_node(tileElement))
+                {
+                    nodes.push_back(tileElement);
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+        _tileStamps[index] = _generation;
+    }
+    return nodes;
+}
+
+void footpath_node_cache_invalidate()
+{
+    _generation++;
+    if (_generation == 0)
+    {
+        // Wrapped around, make sure no old stamp can match again.
+        std::fill(_tileStamps.begin(), _tileStamps.end(), 0);
+        _generation = 1;
+    }
+}
+
+uint32_t footpath_node_cache_generation()
+{
+    return _generation;
+}
@@ -0,0 +1,33 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+#include <vector>
+
+struct TileElement;
+
+/**
+ * The elements of a tile the pathfinding can walk onto or head for, that is all footpaths, track and entrances that
+ * are not ghosts, in the order they appear on the tile. Lists are rebuilt on demand after the map has changed, so they
+ * always match a scan of the tile.
+ */
+const std::vector<TileElement*>& footpath_node_cache_get(const TileCoordsXY& tilePos);
+
+/**
+ * Drops every cached list. Called whenever tile elements are added, removed, moved, change type or become (or stop
+ * being) a ghost, and after every game action as a catch all.
+ */
+void footpath_node_cache_invalidate();
+
+// Changes whenever footpath_node_cache_invalidate is called, for caches derived from the node lists.
+uint32_t footpath_node_cache_generation();
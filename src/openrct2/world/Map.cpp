@@ -12,6 +12,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../Game.h"
+#include "../HitchTracker.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../actions/BannerRemoveAction.hpp"
@@ -36,6 +37,9 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/ImpostorCache.h"
+#include "../paint/TilePaintCache.h"
+#include "../paint/VirtualFloor.h"
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -46,6 +50,7 @@
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathNodeCache.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -56,11 +61,16 @@
 #include "Wall.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <memory>
 
 using namespace OpenRCT2;
 
+static void map_mark_all_tiles_changed();
+static void map_wake_tile(const CoordsXY& mapPos);
+static void map_wake_all_tiles();
+
 /**
  * Replaces 0x00993CCC, 0x00993CCE
  */
@@ -107,6 +117,33 @@ std::vector<PeepSpawn> gPeepSpawns;
 TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
+// Tiles that grow are moved to blocks of a power of two elements. The blocks given up are kept in a free list per
+// size so the next tile to grow to that size takes them, once gTileElements is used up more pages are allocated.
+constexpr const size_t TILE_ELEMENT_BLOCK_SIZE_CLASSES = 32;
+constexpr const size_t TILE_ELEMENT_PAGE_SIZE = 0x4000;
+
+static uint32_t _tileElementCapacities[MAX_TILE_TILE_ELEMENT_POINTERS];
+static uint32_t _tileElementCount;
+static std::vector<TileElement*> _freeTileElementBlocks[TILE_ELEMENT_BLOCK_SIZE_CLASSES];
+static std::vector<std::unique_ptr<TileElement[]>> _tileElementPages;
+static TileElement* _tileElementPageNext;
+static size_t _tileElementPageRemaining;
+static size_t _tileElementPageCapacity;
+
+// The types of element found on each tile, see map_get_tile_element_types. Looked up from worker threads as well.
+static std::atomic<uint64_t> _tileElementTypes[MAX_TILE_TILE_ELEMENT_POINTERS];
+
+// Besides the types, each entry has the positions of the first surface and path elements on the tile plus one, or 0 if
+// not known, so the lookups of those start at the element rather than walking the tile from the bottom.
+constexpr const uint64_t TILE_ELEMENT_TYPES_STAMP_MASK = 0xFFFFFFFF00010000;
+constexpr const int32_t TILE_ELEMENT_SURFACE_POS_SHIFT = 17;
+constexpr const uint32_t TILE_ELEMENT_SURFACE_POS_MAX = 0x7F;
+constexpr const int32_t TILE_ELEMENT_PATH_POS_SHIFT = 24;
+constexpr const uint32_t TILE_ELEMENT_PATH_POS_MAX = 0xFF;
+
+// Tiles that map_update_tiles found nothing left to grow or age on, skipped by it until something on them changes.
+static std::vector<bool> _tileUpdateDormant = std::vector<bool>(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -203,6 +240,82 @@ TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n)
     return nullptr;
 }
 
+static std::atomic<uint64_t>& map_get_tile_element_types_entry(const TileCoordsXY& tilePos)
+{
+    return _tileElementTypes[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL];
+}
+
+// The generation in the upper half, a valid bit and the types in the lower half.
+static uint64_t map_get_tile_element_types_stamp()
+{
+    return (static_cast<uint64_t>(footpath_node_cache_generation()) << 32) | 0x10000;
+}
+
+static uint64_t map_get_tile_element_types_value(const CoordsXY& coords)
+{
+    if (!map_is_location_valid(coords))
+        return 0;
+
+    auto& entry = map_get_tile_element_types_entry(TileCoordsXY{ coords });
+    auto stamp = map_get_tile_element_types_stamp();
+    auto value = entry.load(std::memory_order_relaxed);
+    if ((value & TILE_ELEMENT_TYPES_STAMP_MASK) == stamp)
+        return value;
+
+    uint16_t types = 0;
+    uint64_t surfacePos = 0;
+    uint64_t pathPos = 0;
+    const TileElement* tileElement = map_get_first_element_at(coords);
+    if (tileElement != nullptr)
+    {
+        uint32_t pos = 1;
+        do
+        {
+            auto type = tileElement->GetType();
+            if (type == TILE_ELEMENT_TYPE_SURFACE && surfacePos == 0 && pos <= TILE_ELEMENT_SURFACE_POS_MAX)
+                surfacePos = pos;
+            else if (type == TILE_ELEMENT_TYPE_PATH && pathPos == 0 && pos <= TILE_ELEMENT_PATH_POS_MAX)
+                pathPos = pos;
+            types |= tile_element_type_bit(type);
+            pos++;
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    value = stamp | (pathPos << TILE_ELEMENT_PATH_POS_SHIFT) | (surfacePos << TILE_ELEMENT_SURFACE_POS_SHIFT) | types;
+    entry.store(value, std::memory_order_relaxed);
+    return value;
+}
+
+uint16_t map_get_tile_element_types(const CoordsXY& coords)
+{
+    return static_cast<uint16_t>(map_get_tile_element_types_value(coords));
+}
+
+TileElement* map_get_first_element_of_type(const CoordsXY& coords, uint8_t type)
+{
+    auto value = map_get_tile_element_types_value(coords);
+    if (!(value & tile_element_type_bit(type)))
+        return nullptr;
+
+    TileElement* tileElement = map_get_first_element_at(coords);
+    if (tileElement == nullptr)
+        return nullptr;
+
+    // The elements below the first one of the type can be skipped
+    if (type == TILE_ELEMENT_TYPE_SURFACE)
+    {
+        auto pos = (value >> TILE_ELEMENT_SURFACE_POS_SHIFT) & TILE_ELEMENT_SURFACE_POS_MAX;
+        if (pos != 0)
+            tileElement += pos - 1;
+    }
+    else if (type == TILE_ELEMENT_TYPE_PATH)
+    {
+        auto pos = (value >> TILE_ELEMENT_PATH_POS_SHIFT) & TILE_ELEMENT_PATH_POS_MAX;
+        if (pos != 0)
+            tileElement += pos - 1;
+    }
+    return tileElement;
+}
+
 void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
 {
     if (!map_is_location_valid(tilePos.ToCoordsXY()))
@@ -211,6 +324,7 @@ void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
         return;
     }
     gTileElementTilePointers[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+    footpath_node_cache_invalidate();
 }
 
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
@@ -220,6 +334,15 @@ SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
     if (tileElement == nullptr)
         return nullptr;
 
+    // Usually the first element of the tile, otherwise the types of the tile tell where it is without reading the
+    // elements below it.
+    if (tileElement->GetType() != TILE_ELEMENT_TYPE_SURFACE)
+    {
+        tileElement = map_get_first_element_of_type(coords, TILE_ELEMENT_TYPE_SURFACE);
+        if (tileElement == nullptr)
+            return nullptr;
+    }
+
     // Find the first surface element
     while (tileElement->GetType() != TILE_ELEMENT_TYPE_SURFACE)
     {
@@ -234,7 +357,7 @@ SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
 
 PathElement* map_get_path_element_at(const TileCoordsXYZ& loc)
 {
-    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    TileElement* tileElement = map_get_first_element_of_type(loc.ToCoordsXY(), TILE_ELEMENT_TYPE_PATH);
 
     if (tileElement == nullptr)
         return nullptr;
@@ -258,7 +381,7 @@ PathElement* map_get_path_element_at(const TileCoordsXYZ& loc)
 BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t position)
 {
     auto bannerTilePos = TileCoordsXYZ{ bannerPos };
-    TileElement* tileElement = map_get_first_element_at(bannerPos);
+    TileElement* tileElement = map_get_first_element_of_type(bannerPos, TILE_ELEMENT_TYPE_BANNER);
 
     if (tileElement == nullptr)
         return nullptr;
@@ -286,6 +409,11 @@ BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t pos
 void map_init(int32_t size)
 {
     gNextFreeTileElementPointerIndex = 0;
+    tile_paint_cache_invalidate_all();
+    virtual_floor_invalidate_all_tiles();
+    map_mark_all_tiles_changed();
+    map_wake_all_tiles();
+    footpath_node_cache_invalidate();
 
     for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
     {
@@ -324,6 +452,19 @@ void map_init(int32_t size)
  * but haven't been bought yet. It updates gLandRemainingOwnershipSales and
  * gLandRemainingConstructionSales.
  */
+static bool map_ownership_is_remaining_ownership_sale(uint8_t flags)
+{
+    // Do not combine this condition with (flags & OWNERSHIP_AVAILABLE)
+    // As some RCT1 parks have owned tiles with the 'construction rights available' flag also set
+    return !(flags & OWNERSHIP_OWNED) && (flags & OWNERSHIP_AVAILABLE);
+}
+
+static bool map_ownership_is_remaining_construction_sale(uint8_t flags)
+{
+    return !(flags & OWNERSHIP_OWNED) && !(flags & OWNERSHIP_AVAILABLE)
+        && (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) && (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) == 0;
+}
+
 void map_count_remaining_land_rights()
 {
     gLandRemainingOwnershipSales = 0;
@@ -341,25 +482,39 @@ void map_count_remaining_land_rights()
             }
 
             uint8_t flags = surfaceElement->GetOwnership();
-
-            // Do not combine this condition with (flags & OWNERSHIP_AVAILABLE)
-            // As some RCT1 parks have owned tiles with the 'construction rights available' flag also set
-            if (!(flags & OWNERSHIP_OWNED))
+            if (map_ownership_is_remaining_ownership_sale(flags))
             {
-                if (flags & OWNERSHIP_AVAILABLE)
-                {
-                    gLandRemainingOwnershipSales++;
-                }
-                else if (
-                    (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) && (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) == 0)
-                {
-                    gLandRemainingConstructionSales++;
-                }
+                gLandRemainingOwnershipSales++;
+            }
+            else if (map_ownership_is_remaining_construction_sale(flags))
+            {
+                gLandRemainingConstructionSales++;
             }
         }
     }
 }
 
+/**
+ * Sets the ownership of a surface element of the map and updates the park size and the remaining land rights counts by
+ * the difference, instead of counting them again over the whole map.
+ */
+void map_set_surface_ownership(SurfaceElement* surfaceElement, uint8_t ownership)
+{
+    uint8_t oldOwnership = surfaceElement->GetOwnership();
+    surfaceElement->SetOwnership(ownership);
+    uint8_t newOwnership = surfaceElement->GetOwnership();
+    if (newOwnership == oldOwnership)
+    {
+        return;
+    }
+
+    gParkSize += park_ownership_counts_towards_size(newOwnership) - park_ownership_counts_towards_size(oldOwnership);
+    gLandRemainingOwnershipSales += map_ownership_is_remaining_ownership_sale(newOwnership)
+        - map_ownership_is_remaining_ownership_sale(oldOwnership);
+    gLandRemainingConstructionSales += map_ownership_is_remaining_construction_sale(newOwnership)
+        - map_ownership_is_remaining_construction_sale(oldOwnership);
+}
+
 /**
  * This is meant to strip TILE_ELEMENT_FLAG_GHOST flag from all elements when
  * importing a park.
@@ -385,6 +540,11 @@ void map_update_tile_pointers()
 {
     int32_t i, x, y;
 
+    footpath_node_cache_invalidate();
+    footpath_queue_all_wide_flags_update();
+    map_mark_all_tiles_changed();
+    map_wake_all_tiles();
+
     for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
     {
         gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
@@ -392,17 +552,31 @@ void map_update_tile_pointers()
 
     TileElement* tileElement = gTileElements;
     TileElement** tile = gTileElementTilePointers;
+    uint32_t* capacity = _tileElementCapacities;
     for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
         for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
         {
+            TileElement* firstElement = tileElement;
             *tile++ = tileElement;
             while (!(tileElement++)->IsLastForTile())
                 ;
+            *capacity++ = static_cast<uint32_t>(tileElement - firstElement);
         }
     }
 
     gNextFreeTileElement = tileElement;
+    _tileElementCount = static_cast<uint32_t>(tileElement - gTileElements);
+
+    // All tiles are back in gTileElements, so the blocks elsewhere are no longer used.
+    for (auto& freeBlocks : _freeTileElementBlocks)
+    {
+        freeBlocks.clear();
+    }
+    _tileElementPages.clear();
+    _tileElementPageNext = nullptr;
+    _tileElementPageRemaining = 0;
+    _tileElementPageCapacity = 0;
 }
 
 /**
@@ -627,14 +801,23 @@ void map_update_path_wide_flags()
         return;
     }
 
-    // Presumably update_path_wide_flags is too computationally expensive to call for every
-    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-    // progress. A maximum of 128 calls is done per update.
+    // Only the tiles around elements that changed since the last update are worked out again
+    footpath_update_queued_wide_flags();
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // The sweep the flags used to be kept up to date by is kept to check that no change went unnoticed. With the flags
+    // already up to date it changes nothing. gWidePathTileLoopX and gWidePathTileLoopY store the x and y progress, a
+    // maximum of 128 calls is done per update.
     uint16_t x = gWidePathTileLoopX;
     uint16_t y = gWidePathTileLoopY;
     for (int32_t i = 0; i < 128; i++)
     {
+        auto oldFlags = footpath_get_wide_flags({ x, y });
         footpath_update_path_wide_flags({ x, y });
+        if (footpath_get_wide_flags({ x, y }) != oldFlags)
+        {
+            log_warning("Wide flags of footpaths at %d, %d were out of date", x / COORDS_XY_STEP, y / COORDS_XY_STEP);
+        }
 
         // Next x, y tile
         x += COORDS_XY_STEP;
@@ -650,6 +833,7 @@ void map_update_path_wide_flags()
     }
     gWidePathTileLoopX = x;
     gWidePathTileLoopY = y;
+#endif
 }
 
 /**
@@ -943,6 +1127,8 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    footpath_node_cache_invalidate();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -954,14 +1140,10 @@ void tile_element_remove(TileElement* tileElement)
         } while (!(++tileElement)->IsLastForTile());
     }
 
-    // Mark the latest element with the last element flag.
+    // Mark the latest element with the last element flag. The freed slot stays with the tile for its next insert.
     (tileElement - 1)->SetLastForTile(true);
     tileElement->base_height = MAX_ELEMENT_HEIGHT;
-
-    if ((tileElement + 1) == gNextFreeTileElement)
-    {
-        gNextFreeTileElement--;
-    }
+    _tileElementCount--;
 }
 
 /**
@@ -1069,23 +1251,9 @@ void map_invalidate_selection_rect()
     }
 }
 
-/**
- *
- *  rct2: 0x0068B111
- */
-void map_reorganise_elements()
+size_t map_copy_elements_in_tile_order(TileElement* dst, size_t maxElements)
 {
-    context_setcurrentcursor(CursorID::ZZZ);
-
-    auto newTileElements = std::make_unique<TileElement[]>(MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
-    TileElement* newElementsPtr = newTileElements.get();
-
-    if (newTileElements == nullptr)
-    {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
-    }
-
+    size_t numCopied = 0;
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
         for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
@@ -1097,13 +1265,42 @@ void map_reorganise_elements()
             while (!(endElement++)->IsLastForTile())
                 ;
 
-            const auto numElements = static_cast<uint32_t>(endElement - startElement);
-            std::memcpy(newElementsPtr, startElement, numElements * sizeof(TileElement));
-            newElementsPtr += numElements;
+            const auto numElements = std::min<size_t>(endElement - startElement, maxElements - numCopied);
+            std::memcpy(dst + numCopied, startElement, numElements * sizeof(TileElement));
+            numCopied += numElements;
         }
     }
+    return numCopied;
+}
+
+uint32_t map_get_tile_element_count()
+{
+    return _tileElementCount;
+}
+
+size_t map_get_tile_element_memory_usage()
+{
+    return sizeof(gTileElements) + sizeof(gTileElementTilePointers) + _tileElementPageCapacity * sizeof(TileElement);
+}
+
+/**
+ *
+ *  rct2: 0x0068B111
+ */
+void map_reorganise_elements()
+{
+    hitch_tracker_note(HitchEvent::MapReorganise);
+    context_setcurrentcursor(CursorID::ZZZ);
+    footpath_node_cache_invalidate();
+
+    auto newTileElements = std::make_unique<TileElement[]>(MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+    if (newTileElements == nullptr)
+    {
+        log_fatal("Unable to allocate memory for map elements.");
+        return;
+    }
 
-    const auto numElements = static_cast<uint32_t>(newElementsPtr - newTileElements.get());
+    const auto numElements = map_copy_elements_in_tile_order(newTileElements.get(), MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
     std::memcpy(gTileElements, newTileElements.get(), numElements * sizeof(TileElement));
     std::memset(gTileElements + numElements, 0, (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - numElements) * sizeof(TileElement));
 
@@ -1114,43 +1311,169 @@ void map_reorganise_elements()
  *
  *  rct2: 0x0068B044
  *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
+ *  Tiles are no longer stored in one fixed array, the limit remains as all elements have to fit into a saved game.
  */
 bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
-    if (numElements != 0)
+    if (numElements != 0 && _tileElementCount + static_cast<uint32_t>(numElements) > MAX_TILE_ELEMENTS)
+    {
+        // Not enough spare elements left :'(
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+        return false;
+    }
+    return true;
+}
+
+static uint32_t tile_element_get_size_class(uint32_t numElements)
+{
+    uint32_t sizeClass = 0;
+    while ((1u << sizeClass) < numElements)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
+        sizeClass++;
+    }
+    return sizeClass;
+}
 
-        // Check if is there is room for the required number of elements
-        auto newTileElementEnd = gNextFreeTileElement + numElements;
-        if (newTileElementEnd > tileElementEnd)
+/**
+ * Hands a block of elements back, split into the power of two sized blocks it is made of.
+ */
+static void tile_element_free_block(TileElement* block, size_t numElements)
+{
+    for (size_t i = 0; i < numElements; i++)
+    {
+        block[i].base_height = MAX_ELEMENT_HEIGHT;
+    }
+
+    for (size_t sizeClass = TILE_ELEMENT_BLOCK_SIZE_CLASSES; sizeClass-- > 0;)
+    {
+        size_t size = size_t{ 1 } << sizeClass;
+        if (numElements & size)
         {
-            // Defragment the map element list
-            map_reorganise_elements();
+            _freeTileElementBlocks[sizeClass].push_back(block);
+            block += size;
+        }
+    }
+}
 
-            // Check if there is any room again
-            newTileElementEnd = gNextFreeTileElement + numElements;
-            if (newTileElementEnd > tileElementEnd)
-            {
-                // Not enough spare elements left :'(
-                gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-                return false;
-            }
+static TileElement* tile_element_allocate_block(uint32_t sizeClass)
+{
+    auto& freeBlocks = _freeTileElementBlocks[sizeClass];
+    if (!freeBlocks.empty())
+    {
+        auto block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    size_t size = size_t{ 1 } << sizeClass;
+
+    // Use up the room left after the elements in gTileElements first.
+    auto remaining = static_cast<size_t>(std::end(gTileElements) - gNextFreeTileElement);
+    if (size <= remaining)
+    {
+        auto block = gNextFreeTileElement;
+        gNextFreeTileElement += size;
+        return block;
+    }
+    if (remaining != 0)
+    {
+        tile_element_free_block(gNextFreeTileElement, remaining);
+        gNextFreeTileElement = std::end(gTileElements);
+    }
+
+    if (size > _tileElementPageRemaining)
+    {
+        if (_tileElementPageRemaining != 0)
+        {
+            tile_element_free_block(_tileElementPageNext, _tileElementPageRemaining);
         }
+        auto pageSize = std::max(TILE_ELEMENT_PAGE_SIZE, size);
+        _tileElementPages.push_back(std::make_unique<TileElement[]>(pageSize));
+        _tileElementPageNext = _tileElementPages.back().get();
+        _tileElementPageRemaining = pageSize;
+        _tileElementPageCapacity += pageSize;
     }
-    return true;
+
+    auto block = _tileElementPageNext;
+    _tileElementPageNext += size;
+    _tileElementPageRemaining -= size;
+    return block;
 }
 
 /**
  *
  *  rct2: 0x0068B1F6
  */
+/**
+ * Returns the number of elements on the tile, a tile without elements has not got a block any more.
+ */
+static uint32_t tile_element_count_on_tile(size_t tileIndex)
+{
+    const TileElement* tileElement = gTileElementTilePointers[tileIndex];
+    if (tileElement == nullptr)
+    {
+        // Whatever the tile was stored in before its elements were taken away is not known any more.
+        _tileElementCapacities[tileIndex] = 0;
+        return 0;
+    }
+
+    uint32_t numElements = 0;
+    do
+    {
+        numElements++;
+    } while (!(tileElement++)->IsLastForTile());
+    return numElements;
+}
+
+/**
+ * Makes sure the tile's block has room for the given number of elements, moving its first elements to a larger block if
+ * needed. Returns the first element of the tile.
+ */
+static TileElement* tile_element_reserve(size_t tileIndex, uint32_t numElements, uint32_t numElementsToKeep)
+{
+    TileElement* originalTileElement = gTileElementTilePointers[tileIndex];
+    if (numElements <= _tileElementCapacities[tileIndex])
+    {
+        return originalTileElement;
+    }
+
+    auto sizeClass = tile_element_get_size_class(numElements);
+    auto newTileElement = tile_element_allocate_block(sizeClass);
+    if (originalTileElement != nullptr)
+    {
+        std::memcpy(newTileElement, originalTileElement, numElementsToKeep * sizeof(TileElement));
+        tile_element_free_block(originalTileElement, _tileElementCapacities[tileIndex]);
+    }
+
+    // Set tile index pointer to point to new element block
+    gTileElementTilePointers[tileIndex] = newTileElement;
+    _tileElementCapacities[tileIndex] = 1u << sizeClass;
+    return newTileElement;
+}
+
+/**
+ * Moves up the elements from the given index to make room for one more, the new element is not initialised.
+ */
+static TileElement* tile_element_make_room(size_t tileIndex, uint32_t numElements, uint32_t insertIndex)
+{
+    auto newTileElement = tile_element_reserve(tileIndex, numElements + 1, numElements);
+    std::memmove(
+        &newTileElement[insertIndex + 1], &newTileElement[insertIndex], (numElements - insertIndex) * sizeof(TileElement));
+
+    bool isLastForTile = insertIndex == numElements;
+    if (isLastForTile && numElements != 0)
+    {
+        // No more elements above the insert element
+        newTileElement[numElements - 1].SetLastForTile(false);
+    }
+    _tileElementCount++;
+    footpath_node_cache_invalidate();
+    return &newTileElement[insertIndex];
+}
+
 TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants)
 {
     const auto& tileLoc = TileCoordsXYZ(loc);
-    TileElement *originalTileElement, *newTileElement, *insertedElement;
-    bool isLastForTile = false;
 
     if (!map_check_free_elements_and_reorganise(1))
     {
@@ -1158,64 +1481,105 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
         return nullptr;
     }
 
-    newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x];
+    auto tileIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+    TileElement* originalTileElement = gTileElementTilePointers[tileIndex];
+    uint32_t numElements = tile_element_count_on_tile(tileIndex);
 
-    // Set tile index pointer to point to new element block
-    gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x] = newTileElement;
+    // The new element goes after all elements that are below the insert height
+    uint32_t insertIndex = 0;
+    while (insertIndex < numElements && loc.z >= originalTileElement[insertIndex].GetBaseZ())
+    {
+        insertIndex++;
+    }
 
-    if (originalTileElement == nullptr)
+    // Insert new map element
+    TileElement* insertedElement = tile_element_make_room(tileIndex, numElements, insertIndex);
+    insertedElement->type = 0;
+    insertedElement->SetBaseZ(loc.z);
+    insertedElement->Flags = 0;
+    insertedElement->SetLastForTile(insertIndex == numElements);
+    insertedElement->SetOccupiedQuadrants(occupiedQuadrants);
+    insertedElement->SetClearanceZ(loc.z);
+    std::memset(&insertedElement->pad_04, 0, sizeof(insertedElement->pad_04));
+    std::memset(&insertedElement->pad_08, 0, sizeof(insertedElement->pad_08));
+
+    // The caller only sets the type of the new element after this, until the map changes again the tile could have
+    // any type of element.
+    map_get_tile_element_types_entry(tileLoc).store(map_get_tile_element_types_stamp() | 0xFFFF, std::memory_order_relaxed);
+    return insertedElement;
+}
+
+TileElement* tile_element_insert_at(const CoordsXY& loc, uint32_t index)
+{
+    if (!map_is_location_valid(loc) || !map_check_free_elements_and_reorganise(1))
     {
-        isLastForTile = true;
+        return nullptr;
     }
-    else
+
+    auto tileLoc = TileCoordsXY(loc);
+    auto tileIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+    auto numElements = tile_element_count_on_tile(tileIndex);
+    if (index > numElements)
     {
-        // Copy all elements that are below the insert height
-        while (loc.z >= originalTileElement->GetBaseZ())
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
+        return nullptr;
+    }
 
-            if ((newTileElement - 1)->IsLastForTile())
-            {
-                // No more elements above the insert element
-                (newTileElement - 1)->SetLastForTile(false);
-                isLastForTile = true;
-                break;
-            }
-        }
+    auto insertedElement = tile_element_make_room(tileIndex, numElements, index);
+    std::memset(insertedElement, 0, sizeof(TileElement));
+    insertedElement->SetLastForTile(index == numElements);
+    map_get_tile_element_types_entry(tileLoc).store(map_get_tile_element_types_stamp() | 0xFFFF, std::memory_order_relaxed);
+    return insertedElement;
+}
+
+TileElement* tile_element_set_count(const CoordsXY& loc, uint32_t numElements)
+{
+    if (!map_is_location_valid(loc))
+    {
+        return nullptr;
     }
 
-    // Insert new map element
-    insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    std::memset(&newTileElement->pad_04, 0, sizeof(newTileElement->pad_04));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
-    newTileElement++;
-
-    // Insert rest of map elements above insert height
-    if (!isLastForTile)
+    auto tileLoc = TileCoordsXY(loc);
+    auto tileIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+    auto oldNumElements = tile_element_count_on_tile(tileIndex);
+    if (numElements > oldNumElements && !map_check_free_elements_and_reorganise(numElements - oldNumElements))
     {
-        do
+        return nullptr;
+    }
+
+    footpath_node_cache_invalidate();
+    if (numElements == 0)
+    {
+        if (oldNumElements != 0)
         {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
-        } while (!((newTileElement - 1)->IsLastForTile()));
+            tile_element_free_block(gTileElementTilePointers[tileIndex], _tileElementCapacities[tileIndex]);
+            gTileElementTilePointers[tileIndex] = nullptr;
+            _tileElementCapacities[tileIndex] = 0;
+        }
+        _tileElementCount -= oldNumElements;
+        return nullptr;
     }
 
-    gNextFreeTileElement = newTileElement;
-    return insertedElement;
+    auto first = tile_element_reserve(tileIndex, numElements, std::min(numElements, oldNumElements));
+    if (numElements > oldNumElements)
+    {
+        std::memset(&first[oldNumElements], 0, (numElements - oldNumElements) * sizeof(TileElement));
+    }
+    else
+    {
+        // The slots that are no longer used stay with the tile for its next insert
+        for (auto i = numElements; i < oldNumElements; i++)
+        {
+            first[i].base_height = MAX_ELEMENT_HEIGHT;
+        }
+    }
+    for (uint32_t i = 0; i < numElements; i++)
+    {
+        first[i].SetLastForTile(i == numElements - 1);
+    }
+    _tileElementCount += numElements;
+    _tileElementCount -= oldNumElements;
+    map_get_tile_element_types_entry(tileLoc).store(map_get_tile_element_types_stamp() | 0xFFFF, std::memory_order_relaxed);
+    return first;
 }
 
 /**
@@ -1533,12 +1897,15 @@ void map_update_tiles()
             interleaved_xy >>= 1;
         }
 
+        // Dormant tiles would neither change nor draw a random number, skipping them keeps the schedule the same.
+        const auto index = static_cast<size_t>(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
         auto mapPos = TileCoordsXY{ x, y }.ToCoordsXY();
-        auto* surfaceElement = map_get_surface_element_at(mapPos);
+        auto* surfaceElement = _tileUpdateDormant[index] ? nullptr : map_get_surface_element_at(mapPos);
         if (surfaceElement != nullptr)
         {
-            surfaceElement->UpdateGrassLength(mapPos);
-            scenery_update_tile(mapPos);
+            bool grassActive = surfaceElement->UpdateGrassLength(mapPos);
+            bool sceneryActive = scenery_update_tile(mapPos);
+            _tileUpdateDormant[index] = !grassActive && !sceneryActive;
         }
 
         gGrassSceneryTileLoopPosition++;
@@ -1546,6 +1913,20 @@ void map_update_tiles()
     }
 }
 
+static void map_wake_tile(const CoordsXY& mapPos)
+{
+    if (map_is_location_valid(mapPos))
+    {
+        auto tilePos = TileCoordsXY(mapPos);
+        _tileUpdateDormant[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x] = false;
+    }
+}
+
+static void map_wake_all_tiles()
+{
+    std::fill(_tileUpdateDormant.begin(), _tileUpdateDormant.end(), false);
+}
+
 void map_remove_provisional_elements()
 {
     if (gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1)
@@ -1614,7 +1995,7 @@ void map_remove_out_of_range_elements()
                 auto surfaceElement = map_get_surface_element_at(CoordsXY{ x, y });
                 if (surfaceElement != nullptr)
                 {
-                    surfaceElement->SetOwnership(OWNERSHIP_UNOWNED);
+                    map_set_surface_ownership(surfaceElement, OWNERSHIP_UNOWNED);
                     update_park_fences_around_tile({ x, y });
                 }
                 clear_elements_at({ x, y });
@@ -1717,7 +2098,7 @@ static void clear_element_at(const CoordsXY& loc, TileElement** elementPtr)
             element->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
             element->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
             element->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-            element->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
+            map_set_surface_ownership(element->AsSurface(), OWNERSHIP_UNOWNED);
             element->AsSurface()->SetParkFences(0);
             element->AsSurface()->SetWaterHeight(0);
             // Because this element is not completely removed, the pointer must be updated manually
@@ -1813,7 +2194,7 @@ int32_t map_get_highest_z(const CoordsXY& loc)
 
 LargeSceneryElement* map_get_large_scenery_segment(const CoordsXYZD& sceneryPos, int32_t sequence)
 {
-    TileElement* tileElement = map_get_first_element_at(sceneryPos);
+    TileElement* tileElement = map_get_first_element_of_type(sceneryPos, TILE_ELEMENT_TYPE_LARGE_SCENERY);
     if (tileElement == nullptr)
     {
         return nullptr;
@@ -1838,7 +2219,7 @@ LargeSceneryElement* map_get_large_scenery_segment(const CoordsXYZD& sceneryPos,
 EntranceElement* map_get_park_entrance_element_at(const CoordsXYZ& entranceCoords, bool ghost)
 {
     auto entranceTileCoords = TileCoordsXYZ(entranceCoords);
-    TileElement* tileElement = map_get_first_element_at(entranceCoords);
+    TileElement* tileElement = map_get_first_element_of_type(entranceCoords, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -1864,7 +2245,7 @@ EntranceElement* map_get_park_entrance_element_at(const CoordsXYZ& entranceCoord
 EntranceElement* map_get_ride_entrance_element_at(const CoordsXYZ& entranceCoords, bool ghost)
 {
     auto entranceTileCoords = TileCoordsXYZ{ entranceCoords };
-    TileElement* tileElement = map_get_first_element_at(entranceCoords);
+    TileElement* tileElement = map_get_first_element_of_type(entranceCoords, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -1890,7 +2271,7 @@ EntranceElement* map_get_ride_entrance_element_at(const CoordsXYZ& entranceCoord
 EntranceElement* map_get_ride_exit_element_at(const CoordsXYZ& exitCoords, bool ghost)
 {
     auto exitTileCoords = TileCoordsXYZ{ exitCoords };
-    TileElement* tileElement = map_get_first_element_at(exitCoords);
+    TileElement* tileElement = map_get_first_element_of_type(exitCoords, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -1916,7 +2297,7 @@ EntranceElement* map_get_ride_exit_element_at(const CoordsXYZ& exitCoords, bool
 SmallSceneryElement* map_get_small_scenery_element_at(const CoordsXYZ& sceneryCoords, int32_t type, uint8_t quadrant)
 {
     auto sceneryTileCoords = TileCoordsXYZ{ sceneryCoords };
-    TileElement* tileElement = map_get_first_element_at(sceneryCoords);
+    TileElement* tileElement = map_get_first_element_of_type(sceneryCoords, TILE_ELEMENT_TYPE_SMALL_SCENERY);
     if (tileElement != nullptr)
     {
         do
@@ -2012,11 +2393,98 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
     return ScreenCoordsXY{ rotated.y - rotated.x, ((rotated.x + rotated.y) >> 1) - pos.z };
 }
 
+// Tiles invalidated since the map window last looked, with a bit per tile so each is only listed once
+static struct
+{
+    bool AllChanged = true;
+    std::vector<TileCoordsXY> Tiles;
+    std::vector<bool> Listed = std::vector<bool>(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+} _mapChangedTiles;
+
+static void map_mark_tile_changed(const TileCoordsXY& tilePos)
+{
+    auto& changed = _mapChangedTiles;
+    if (changed.AllChanged || tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL
+        || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return;
+    }
+
+    auto index = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+    if (!changed.Listed[index])
+    {
+        changed.Listed[index] = true;
+        changed.Tiles.push_back(tilePos);
+    }
+}
+
+static void map_mark_all_tiles_changed()
+{
+    auto& changed = _mapChangedTiles;
+    changed.AllChanged = true;
+    changed.Tiles.clear();
+    std::fill(changed.Listed.begin(), changed.Listed.end(), false);
+}
+
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& tiles)
+{
+    auto& changed = _mapChangedTiles;
+    tiles.clear();
+    if (changed.AllChanged)
+    {
+        changed.AllChanged = false;
+        return false;
+    }
+
+    for (const auto& tilePos : changed.Tiles)
+    {
+        changed.Listed[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x] = false;
+    }
+    std::swap(tiles, changed.Tiles);
+    return true;
+}
+
+// Screen area of the tiles invalidated while a batch is open, kept apart for each zoom limit (-1, 0 and 1)
+static struct
+{
+    int32_t Depth;
+    bool Used[3];
+    int32_t Left[3];
+    int32_t Top[3];
+    int32_t Right[3];
+    int32_t Bottom[3];
+} _mapInvalidationBatch;
+
+static void map_invalidate_viewports(int32_t left, int32_t top, int32_t right, int32_t bottom, int32_t maxZoom)
+{
+    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    {
+        rct_viewport* viewport = &g_viewport_list[i];
+        if (viewport->width != 0 && (maxZoom == -1 || viewport->zoom <= maxZoom))
+        {
+            viewport_invalidate(viewport, left, top, right, bottom);
+        }
+    }
+}
+
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
+    // Invalidations limited to the closer zoom levels are for animations, the elements of the tile stay the same.
+    // Servers without a screen still need to know about the changes.
+    if (maxZoom == -1)
+    {
+        footpath_queue_wide_flags_update({ x, y });
+        map_wake_tile({ x, y });
+    }
+
     if (gOpenRCT2Headless)
         return;
 
+    tile_paint_cache_invalidate({ x, y });
+    impostor_cache_invalidate_tile({ x, y }, z0, z1, maxZoom);
+    virtual_floor_invalidate_tile({ x, y });
+    map_mark_tile_changed(TileCoordsXY(CoordsXY{ x, y }));
+
     int32_t x1, y1, x2, y2;
 
     x += 16;
@@ -2028,12 +2496,48 @@ static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int
     x2 = screenCoord.x + 32;
     y2 = screenCoord.y + 32 - z0;
 
-    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    if (_mapInvalidationBatch.Depth > 0)
     {
-        rct_viewport* viewport = &g_viewport_list[i];
-        if (viewport->width != 0 && (maxZoom == -1 || viewport->zoom <= maxZoom))
+        auto& batch = _mapInvalidationBatch;
+        auto index = maxZoom + 1;
+        if (!batch.Used[index])
         {
-            viewport_invalidate(viewport, x1, y1, x2, y2);
+            batch.Used[index] = true;
+            batch.Left[index] = x1;
+            batch.Top[index] = y1;
+            batch.Right[index] = x2;
+            batch.Bottom[index] = y2;
+        }
+        else
+        {
+            batch.Left[index] = std::min(batch.Left[index], x1);
+            batch.Top[index] = std::min(batch.Top[index], y1);
+            batch.Right[index] = std::max(batch.Right[index], x2);
+            batch.Bottom[index] = std::max(batch.Bottom[index], y2);
+        }
+        return;
+    }
+
+    map_invalidate_viewports(x1, y1, x2, y2, maxZoom);
+}
+
+void map_invalidate_batch_begin()
+{
+    _mapInvalidationBatch.Depth++;
+}
+
+void map_invalidate_batch_end()
+{
+    auto& batch = _mapInvalidationBatch;
+    if (batch.Depth == 0 || --batch.Depth > 0)
+        return;
+
+    for (int32_t index = 0; index < static_cast<int32_t>(std::size(batch.Used)); index++)
+    {
+        if (batch.Used[index])
+        {
+            batch.Used[index] = false;
+            map_invalidate_viewports(batch.Left[index], batch.Top[index], batch.Right[index], batch.Bottom[index], index - 1);
         }
     }
 }
@@ -2083,6 +2587,15 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    tile_paint_cache_invalidate_all();
+    for (int32_t y = mins.y; y <= maxs.y; y += COORDS_XY_STEP)
+    {
+        for (int32_t x = mins.x; x <= maxs.x; x += COORDS_XY_STEP)
+        {
+            map_mark_tile_changed(TileCoordsXY(CoordsXY{ x, y }));
+        }
+    }
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
@@ -2190,7 +2703,7 @@ void map_clear_all_elements()
  */
 TrackElement* map_get_track_element_at(const CoordsXYZ& trackPos)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement == nullptr)
         return nullptr;
     do
@@ -2214,7 +2727,7 @@ TrackElement* map_get_track_element_at(const CoordsXYZ& trackPos)
  */
 TileElement* map_get_track_element_at_of_type(const CoordsXYZ& trackPos, int32_t trackType)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement == nullptr)
         return nullptr;
     auto trackTilePos = TileCoordsXYZ{ trackPos };
@@ -2241,7 +2754,7 @@ TileElement* map_get_track_element_at_of_type(const CoordsXYZ& trackPos, int32_t
  */
 TileElement* map_get_track_element_at_of_type_seq(const CoordsXYZ& trackPos, int32_t trackType, int32_t sequence)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     auto trackTilePos = TileCoordsXYZ{ trackPos };
     do
     {
@@ -2264,7 +2777,7 @@ TileElement* map_get_track_element_at_of_type_seq(const CoordsXYZ& trackPos, int
 
 TrackElement* map_get_track_element_at_of_type(const CoordsXYZD& location, int32_t trackType)
 {
-    auto tileElement = map_get_first_element_at(location);
+    auto tileElement = map_get_first_element_of_type(location, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement != nullptr)
     {
         do
@@ -2287,7 +2800,7 @@ TrackElement* map_get_track_element_at_of_type(const CoordsXYZD& location, int32
 
 TrackElement* map_get_track_element_at_of_type_seq(const CoordsXYZD& location, int32_t trackType, int32_t sequence)
 {
-    auto tileElement = map_get_first_element_at(location);
+    auto tileElement = map_get_first_element_of_type(location, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement != nullptr)
     {
         do
@@ -2318,7 +2831,7 @@ TrackElement* map_get_track_element_at_of_type_seq(const CoordsXYZD& location, i
  */
 TileElement* map_get_track_element_at_of_type_from_ride(const CoordsXYZ& trackPos, int32_t trackType, ride_id_t rideIndex)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement == nullptr)
         return nullptr;
     auto trackTilePos = TileCoordsXYZ{ trackPos };
@@ -2347,7 +2860,7 @@ TileElement* map_get_track_element_at_of_type_from_ride(const CoordsXYZ& trackPo
  */
 TileElement* map_get_track_element_at_from_ride(const CoordsXYZ& trackPos, ride_id_t rideIndex)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement == nullptr)
         return nullptr;
     auto trackTilePos = TileCoordsXYZ{ trackPos };
@@ -2375,7 +2888,7 @@ TileElement* map_get_track_element_at_from_ride(const CoordsXYZ& trackPos, ride_
  */
 TileElement* map_get_track_element_at_with_direction_from_ride(const CoordsXYZD& trackPos, ride_id_t rideIndex)
 {
-    TileElement* tileElement = map_get_first_element_at(trackPos);
+    TileElement* tileElement = map_get_first_element_of_type(trackPos, TILE_ELEMENT_TYPE_TRACK);
     if (tileElement == nullptr)
         return nullptr;
     auto trackTilePos = TileCoordsXYZ{ trackPos };
@@ -2398,7 +2911,7 @@ TileElement* map_get_track_element_at_with_direction_from_ride(const CoordsXYZD&
 
 WallElement* map_get_wall_element_at(const CoordsXYRangedZ& coords)
 {
-    auto tileElement = map_get_first_element_at(coords);
+    auto tileElement = map_get_first_element_of_type(coords, TILE_ELEMENT_TYPE_WALL);
 
     if (tileElement != nullptr)
     {
@@ -2418,7 +2931,7 @@ WallElement* map_get_wall_element_at(const CoordsXYRangedZ& coords)
 WallElement* map_get_wall_element_at(const CoordsXYZD& wallCoords)
 {
     auto tileWallCoords = TileCoordsXYZ(wallCoords);
-    TileElement* tileElement = map_get_first_element_at(wallCoords);
+    TileElement* tileElement = map_get_first_element_of_type(wallCoords, TILE_ELEMENT_TYPE_WALL);
     if (tileElement == nullptr)
         return nullptr;
     do
@@ -2479,7 +2992,7 @@ void FixLandOwnershipTilesWithOwnership(std::initializer_list<TileCoordsXY> tile
         auto surfaceElement = map_get_surface_element_at(tile->ToCoordsXY());
         if (surfaceElement != nullptr)
         {
-            surfaceElement->SetOwnership(ownership);
+            map_set_surface_ownership(surfaceElement, ownership);
             update_park_fences_around_tile({ (*tile).x * 32, (*tile).y * 32 });
         }
     }
@@ -35,6 +35,9 @@ constexpr const int32_t MINIMUM_LAND_HEIGHT_BIG = MINIMUM_LAND_HEIGHT * COORDS_Z
 
 constexpr const uint32_t MAX_TILE_ELEMENTS_WITH_SPARE_ROOM = 0x30000;
 constexpr const uint32_t MAX_TILE_ELEMENTS = MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - 512;
+// Every tile has a surface element, so the tiles of the largest map have to fit into the elements of a saved game.
+// This is what keeps MAXIMUM_MAP_SIZE_TECHNICAL at 256 for as long as SV6 is the format parks are saved in.
+static_assert(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL <= MAX_TILE_ELEMENTS);
 #define MAX_TILE_TILE_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 #define MAX_PEEP_SPAWNS 2
 
@@ -147,11 +150,28 @@ extern const uint8_t tile_element_raise_styles[9][32];
 void map_init(int32_t size);
 
 void map_count_remaining_land_rights();
+void map_set_surface_ownership(SurfaceElement* surfaceElement, uint8_t ownership);
 void map_strip_ghost_flag_from_elements();
 void map_update_tile_pointers();
 TileElement* map_get_first_element_at(const CoordsXY& elementPos);
 TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n);
 void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements);
+
+constexpr uint16_t tile_element_type_bit(uint8_t type)
+{
+    return static_cast<uint16_t>(1 << ((type & TILE_ELEMENT_TYPE_MASK) >> 2));
+}
+
+/**
+ * Returns tile_element_type_bit of every type of element on the tile. Remembered until the map changes, so lookups for
+ * one type of element can skip the tiles without one without walking their elements.
+ */
+uint16_t map_get_tile_element_types(const CoordsXY& coords);
+/**
+ * Returns the element of the tile to start looking for an element of the given type from, or nullptr if the tile has
+ * none. For surfaces and paths this is the first element of the type, otherwise the first element of the tile.
+ */
+TileElement* map_get_first_element_of_type(const CoordsXY& coords, uint8_t type);
 int32_t map_height_from_slope(const CoordsXY& coords, int32_t slopeDirection, bool isSloped);
 BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t direction);
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords);
@@ -183,7 +203,18 @@ void map_invalidate_map_selection_tiles();
 void map_invalidate_selection_rect();
 void map_reorganise_elements();
 bool map_check_free_elements_and_reorganise(int32_t num_elements);
+// Copies the elements of every tile in the layout map_reorganise_elements leaves them in, without moving the map's own
+// elements. Returns the number of elements copied.
+size_t map_copy_elements_in_tile_order(TileElement* dst, size_t maxElements);
+uint32_t map_get_tile_element_count();
+// The size of gTileElements, the tile pointers and the pages allocated once gTileElements is full
+size_t map_get_tile_element_memory_usage();
 TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants);
+// Inserts a zeroed element at the given position of the tile's elements, returns nullptr if that is not possible.
+TileElement* tile_element_insert_at(const CoordsXY& loc, uint32_t index);
+// Grows or shrinks the tile to the given number of elements with at most one move of its block, added elements are
+// zeroed. Returns the first element of the tile.
+TileElement* tile_element_set_count(const CoordsXY& loc, uint32_t numElements);
 
 namespace GameActions
 {
@@ -236,6 +267,17 @@ void map_invalidate_tile_zoom0(const CoordsXYRangedZ& tilePos);
 void map_invalidate_tile_full(const CoordsXY& tilePos);
 void map_invalidate_element(const CoordsXY& elementPos, TileElement* tileElement);
 void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs);
+/**
+ * Tiles invalidated between these two calls are redrawn together when the outermost batch ends, as a single screen area
+ * covering all of them rather than by going through every viewport for each tile.
+ */
+void map_invalidate_batch_begin();
+void map_invalidate_batch_end();
+/**
+ * Moves the tiles invalidated since the last call into tiles, each tile is listed once. Returns false instead when the
+ * whole map was replaced in the meantime and every tile has to be considered changed.
+ */
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& tiles);
 
 int32_t map_get_tile_side(const CoordsXY& mapPos);
 int32_t map_get_tile_quadrant(const CoordsXY& mapPos);
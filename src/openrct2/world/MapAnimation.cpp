@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../OpenRCT2.h"
 #include "../interface/Viewport.h"
 #include "../object/StationObject.h"
 #include "../ride/Ride.h"
@@ -25,25 +26,43 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <unordered_set>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
 static std::vector<MapAnimation> _mapAnimations;
 
-constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
+// Every animation is a distinct (type, location) pair on an animated tile element, so the list can never grow past the
+// number of elements. The old limit of 2000 was only there because RCT2 saves can't hold more, and those are recreated
+// from the map on load.
+constexpr size_t MAX_ANIMATED_OBJECTS = MAX_TILE_ELEMENTS;
+
+// Keys of every animation in _mapAnimations so that the existence check doesn't have to walk the list, which happened
+// every time a vehicle opened a door.
+static std::unordered_set<uint64_t> _mapAnimationKeys;
+
+// The map is split into buckets of 8x8 tiles and each tick works out which of them could show up in a viewport. Only
+// animations in those are redrawn.
+constexpr int32_t MAP_ANIMATION_BUCKET_SHIFT = 3;
+constexpr int32_t MAP_ANIMATION_BUCKET_SIZE = COORDS_XY_STEP << MAP_ANIMATION_BUCKET_SHIFT;
+constexpr int32_t MAP_ANIMATION_BUCKET_COUNT = MAXIMUM_MAP_SIZE_TECHNICAL >> MAP_ANIMATION_BUCKET_SHIFT;
+
+static std::bitset<MAP_ANIMATION_BUCKET_COUNT * MAP_ANIMATION_BUCKET_COUNT> _visibleAnimationBuckets;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
+static uint64_t GetAnimationKey(int32_t type, const CoordsXYZ& location)
+{
+    return (static_cast<uint64_t>(type & 0xFFFF) << 48) | (static_cast<uint64_t>(location.x & 0xFFFF) << 32)
+        | (static_cast<uint64_t>(location.y & 0xFFFF) << 16) | static_cast<uint64_t>(location.z & 0xFFFF);
+}
+
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
-    for (const auto& a : _mapAnimations)
-    {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
-            return true;
-        }
-    }
-    return false;
+    return _mapAnimationKeys.find(GetAnimationKey(type, location)) != _mapAnimationKeys.end();
 }
 
 void map_animation_create(int32_t type, const CoordsXYZ& loc)
@@ -54,6 +73,7 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
         {
             // Create new animation
             _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            _mapAnimationKeys.insert(GetAnimationKey(type, loc));
         }
         else
         {
@@ -63,24 +83,107 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
 }
 
 /**
- *
- *  rct2: 0x0068AFAD
+ * Animations here only redraw their tile, they don't change anything in the game. These can be left alone while nobody
+ * can see them; at worst one that should be removed stays in the list a little longer.
  */
-void map_animation_invalidate_all()
+static bool IsMapAnimationVisualOnly(uint8_t type)
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    switch (type)
     {
-        if (InvalidateMapAnimation(*it))
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:      // Moves the peeps watching a clock
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:  // Counts down the photo flash
+        case MAP_ANIMATION_TYPE_REMOVE:             // Has to go regardless
+        case MAP_ANIMATION_TYPE_WALL_DOOR:          // Opens and closes the door
+            return false;
+        default:
+            return true;
+    }
+}
+
+static void UpdateVisibleAnimationBuckets()
+{
+    _visibleAnimationBuckets.reset();
+    if (gOpenRCT2Headless)
+        return;
+
+    // Same margins as map_invalidate_tile_zoom1, with the tallest element anywhere in the bucket
+    constexpr int32_t margin = 32 + 4 * COORDS_Z_STEP;
+    constexpr int32_t maxHeight = 255 * COORDS_Z_STEP;
+
+    auto rotation = get_current_rotation();
+    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    {
+        const auto& viewport = g_viewport_list[i];
+        if (viewport.width == 0 || viewport.zoom > 1 || viewport.visibility == VisibilityCache::Covered)
+            continue;
+
+        for (int32_t by = 0; by < MAP_ANIMATION_BUCKET_COUNT; by++)
         {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
+            for (int32_t bx = 0; bx < MAP_ANIMATION_BUCKET_COUNT; bx++)
+            {
+                auto index = (by * MAP_ANIMATION_BUCKET_COUNT) + bx;
+                if (_visibleAnimationBuckets[index])
+                    continue;
+
+                auto left = std::numeric_limits<int32_t>::max();
+                auto top = std::numeric_limits<int32_t>::max();
+                auto right = std::numeric_limits<int32_t>::min();
+                auto bottom = std::numeric_limits<int32_t>::min();
+                for (int32_t corner = 0; corner < 4; corner++)
+                {
+                    auto cornerPos = CoordsXY{ (bx + (corner & 1)) * MAP_ANIMATION_BUCKET_SIZE,
+                                               (by + (corner >> 1)) * MAP_ANIMATION_BUCKET_SIZE };
+                    auto screenPos = translate_3d_to_2d_with_z(rotation, { cornerPos, 0 });
+                    left = std::min(left, screenPos.x);
+                    top = std::min(top, screenPos.y);
+                    right = std::max(right, screenPos.x);
+                    bottom = std::max(bottom, screenPos.y);
+                }
+                left -= margin;
+                top -= margin + maxHeight;
+                right += margin;
+                bottom += margin;
+
+                if (right > viewport.viewPos.x && left < viewport.viewPos.x + viewport.view_width
+                    && bottom > viewport.viewPos.y && top < viewport.viewPos.y + viewport.view_height)
+                {
+                    _visibleAnimationBuckets[index] = true;
+                }
+            }
         }
-        else
+    }
+}
+
+static bool IsMapAnimationVisible(const CoordsXYZ& loc)
+{
+    auto bx = loc.x / MAP_ANIMATION_BUCKET_SIZE;
+    auto by = loc.y / MAP_ANIMATION_BUCKET_SIZE;
+    if (bx < 0 || by < 0 || bx >= MAP_ANIMATION_BUCKET_COUNT || by >= MAP_ANIMATION_BUCKET_COUNT)
+        return true;
+    return _visibleAnimationBuckets[(by * MAP_ANIMATION_BUCKET_COUNT) + bx];
+}
+
+/**
+ *
+ *  rct2: 0x0068AFAD
+ */
+void map_animation_invalidate_all()
+{
+    UpdateVisibleAnimationBuckets();
+
+    // Finished animations are dropped while keeping the rest in order, which is the order they are saved in
+    auto end = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), [](const MapAnimation& a) {
+        if (IsMapAnimationVisualOnly(a.type) && !IsMapAnimationVisible(a.location))
+            return false;
+
+        if (InvalidateMapAnimation(a))
         {
-            it++;
+            _mapAnimationKeys.erase(GetAnimationKey(a.type, a.location));
+            return true;
         }
-    }
+        return false;
+    });
+    _mapAnimations.erase(end, _mapAnimations.end());
 }
 
 /**
@@ -611,6 +714,7 @@ const std::vector<MapAnimation>& GetMapAnimations()
 static void ClearMapAnimations()
 {
     _mapAnimations.clear();
+    _mapAnimationKeys.clear();
 }
 
 void AutoCreateMapAnimations()
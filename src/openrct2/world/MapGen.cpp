@@ -15,6 +15,7 @@
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
 #include "../object/Object.h"
@@ -32,6 +33,11 @@
 #include <iterator>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define MAPGEN_SSE2
+#    include <emmintrin.h>
+#endif
+
 #pragma region Height map struct
 
 static struct
@@ -101,12 +107,6 @@ static int32_t get_height(int32_t x, int32_t y)
         return 0;
 }
 
-static void set_height(int32_t x, int32_t y, int32_t height)
-{
-    if (x >= 0 && y >= 0 && x < _heightSize && y < _heightSize)
-        _height[x + y * _heightSize] = height;
-}
-
 void mapgen_generate_blank(mapgen_settings* settings)
 {
     int32_t x, y;
@@ -411,29 +411,30 @@ static void mapgen_set_water_level(int32_t waterLevel)
  */
 static void mapgen_smooth_height(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
     int32_t arraySize = _heightSize * _heightSize * sizeof(uint8_t);
     uint8_t* copyHeight = new uint8_t[arraySize];
 
-    for (i = 0; i < iterations; i++)
+    for (int32_t i = 0; i < iterations; i++)
     {
         std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
-        {
-            for (x = 1; x < _heightSize - 1; x++)
+
+        // Every row only reads from the copy, so the rows can be smoothed in parallel
+        TaskScheduler::GetGlobal().ParallelFor(1, _heightSize - 1, 0, [copyHeight](size_t row) {
+            auto y = static_cast<int32_t>(row);
+            for (int32_t x = 1; x < _heightSize - 1; x++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                int32_t avg = 0;
+                for (int32_t yy = -1; yy <= 1; yy++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
+                    for (int32_t xx = -1; xx <= 1; xx++)
                     {
                         avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
                     }
                 }
                 avg /= 9;
-                set_height(x, y, avg);
+                _height[y * _heightSize + x] = avg;
             }
-        }
+        });
     }
 
     delete[] copyHeight;
@@ -563,8 +564,8 @@ static float generate(float x, float y)
     float y2 = y0 - 1.0f + 2.0f * G2;
 
     // Wrap the integer indices at 256, to avoid indexing perm[] out of bounds
-    int32_t ii = i % 256;
-    int32_t jj = j % 256;
+    int32_t ii = i & 0xFF;
+    int32_t jj = j & 0xFF;
 
     // Calculate the contribution from the three corners
     float t0 = 0.5f - x0 * x0 - y0 * y0;
@@ -618,10 +619,117 @@ static float grad(int32_t hash, float x, float y)
     return ((h & 1) != 0 ? -u : u) + ((h & 2) != 0 ? -2.0f * v : 2.0f * v);
 }
 
-static void mapgen_simplex(mapgen_settings* settings)
+#ifdef MAPGEN_SSE2
+
+/**
+ * Four lanes of generate(). Only the permutation lookups are done per lane, everything else is done in the same order
+ * as the scalar version so both give exactly the same heights.
+ */
+static __m128i fast_floor4(__m128 x)
 {
-    int32_t x, y;
+    __m128i truncated = _mm_cvttps_epi32(x);
+    __m128i positive = _mm_castps_si128(_mm_cmpgt_ps(x, _mm_setzero_ps()));
+    return _mm_add_epi32(truncated, _mm_andnot_si128(positive, _mm_set1_epi32(-1)));
+}
+
+static __m128 grad4(__m128i hash, __m128 x, __m128 y)
+{
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+    __m128 lowHash = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 u = _mm_or_ps(_mm_and_ps(lowHash, x), _mm_andnot_ps(lowHash, y));
+    __m128 v = _mm_or_ps(_mm_and_ps(lowHash, y), _mm_andnot_ps(lowHash, x));
+
+    __m128i bit1 = _mm_set1_epi32(1);
+    __m128i bit2 = _mm_set1_epi32(2);
+    __m128 negateU = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, bit1), bit1));
+    __m128 negateV = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, bit2), bit2));
+    u = _mm_xor_ps(u, _mm_and_ps(negateU, signBit));
+    v = _mm_xor_ps(_mm_mul_ps(v, _mm_set1_ps(2.0f)), _mm_and_ps(negateV, signBit));
+    return _mm_add_ps(u, v);
+}
+
+static __m128 corner4(__m128i hash, __m128 x, __m128 y)
+{
+    __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+    __m128 inside = _mm_cmpge_ps(t, _mm_setzero_ps());
+    t = _mm_mul_ps(t, t);
+    return _mm_and_ps(inside, _mm_mul_ps(_mm_mul_ps(t, t), grad4(hash, x, y)));
+}
+
+static __m128 generate4(__m128 x, __m128 y)
+{
+    const float G2 = 0.211324865f;
+    const __m128 F2v = _mm_set1_ps(0.366025403f);
+    const __m128 G2v = _mm_set1_ps(G2);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 s = _mm_mul_ps(_mm_add_ps(x, y), F2v);
+    __m128i i = fast_floor4(_mm_add_ps(x, s));
+    __m128i j = fast_floor4(_mm_add_ps(y, s));
+
+    __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), G2v);
+    __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+    __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+    __m128 lowerTriangle = _mm_cmpgt_ps(x0, y0);
+    __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(lowerTriangle, one)), G2v);
+    __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lowerTriangle, one)), G2v);
+    __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(2.0f * G2));
+    __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(2.0f * G2));
+
+    alignas(16) int32_t is[4], js[4], lower[4], hash0[4], hash1[4], hash2[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(is), i);
+    _mm_store_si128(reinterpret_cast<__m128i*>(js), j);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lower), _mm_castps_si128(lowerTriangle));
+    for (int32_t lane = 0; lane < 4; lane++)
+    {
+        int32_t ii = is[lane] & 0xFF;
+        int32_t jj = js[lane] & 0xFF;
+        int32_t i1 = lower[lane] != 0 ? 1 : 0;
+        int32_t j1 = 1 - i1;
+        hash0[lane] = perm[ii + perm[jj]];
+        hash1[lane] = perm[ii + i1 + perm[jj + j1]];
+        hash2[lane] = perm[ii + 1 + perm[jj + 1]];
+    }
+
+    __m128 n0 = corner4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash0)), x0, y0);
+    __m128 n1 = corner4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash1)), x1, y1);
+    __m128 n2 = corner4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash2)), x2, y2);
+    return _mm_mul_ps(_mm_set1_ps(40.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+}
 
+static void fractal_noise4(
+    int32_t x, int32_t y, float frequency, int32_t octaves, float lacunarity, float persistence, float* result)
+{
+    const __m128 xv = _mm_cvtepi32_ps(_mm_setr_epi32(x, x + 1, x + 2, x + 3));
+    const __m128 yv = _mm_set1_ps(static_cast<float>(y));
+
+    __m128 total = _mm_setzero_ps();
+    float amplitude = persistence;
+    for (int32_t i = 0; i < octaves; i++)
+    {
+        __m128 freq = _mm_set1_ps(frequency);
+        __m128 noise = generate4(_mm_mul_ps(xv, freq), _mm_mul_ps(yv, freq));
+        total = _mm_add_ps(total, _mm_mul_ps(noise, _mm_set1_ps(amplitude)));
+        frequency *= lacunarity;
+        amplitude *= persistence;
+    }
+    _mm_storeu_ps(result, total);
+}
+
+#endif // MAPGEN_SSE2
+
+static uint8_t noise_to_height(float noise, int32_t low, int32_t high)
+{
+    float noiseValue = std::clamp(noise, -1.0f, 1.0f);
+    float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+    return low + static_cast<int32_t>(normalisedNoiseValue * high);
+}
+
+static void mapgen_simplex(mapgen_settings* settings)
+{
     float freq = settings->simplex_base_freq * (1.0f / _heightSize);
     int32_t octaves = settings->simplex_octaves;
 
@@ -629,16 +737,28 @@ static void mapgen_simplex(mapgen_settings* settings)
     int32_t high = settings->simplex_high;
 
     noise_rand();
-    for (y = 0; y < _heightSize; y++)
-    {
-        for (x = 0; x < _heightSize; x++)
-        {
-            float noiseValue = std::clamp(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            set_height(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+    // The noise only depends on the position, so each row is generated straight into the height map on its own
+    TaskScheduler::GetGlobal().ParallelFor(0, _heightSize, 0, [freq, octaves, low, high](size_t row) {
+        auto y = static_cast<int32_t>(row);
+        uint8_t* dst = &_height[y * _heightSize];
+        int32_t x = 0;
+#ifdef MAPGEN_SSE2
+        for (; x + 4 <= _heightSize; x += 4)
+        {
+            float noise[4];
+            fractal_noise4(x, y, freq, octaves, 2.0f, 0.65f, noise);
+            for (int32_t lane = 0; lane < 4; lane++)
+            {
+                dst[x + lane] = noise_to_height(noise[lane], low, high);
+            }
         }
-    }
+#endif
+        for (; x < _heightSize; x++)
+        {
+            dst[x] = noise_to_height(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), low, high);
+        }
+    });
 }
 
 #pragma endregion
@@ -41,7 +41,9 @@
 #include "Surface.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -65,6 +67,11 @@ uint8_t gGuestsInParkHistory[32];
 // If this value is more than or equal to 0, the park rating is forced to this value. Used for cheat
 static int32_t _forcedParkRating = -1;
 
+// Guests in the park whose most recent thought is still fresh, by thought type
+static std::array<uint32_t, 256> _guestThoughtCounts;
+// The thought each guest is counted under in _guestThoughtCounts, by sprite index
+static std::vector<uint8_t> _guestCountedThoughts;
+
 /**
  * In a difficult guest generation scenario, no guests will be generated if over this value.
  */
@@ -246,6 +253,11 @@ uint16_t Park::GetParkRating() const
     return gParkRating;
 }
 
+uint32_t Park::GetGuestThoughtCount(uint8_t thoughtType) const
+{
+    return _guestThoughtCounts[thoughtType];
+}
+
 money32 Park::GetParkValue() const
 {
     return gParkValue;
@@ -323,12 +335,6 @@ void Park::Update(const Date& date)
         auto intent = Intent(INTENT_ACTION_UPDATE_PARK_RATING);
         context_broadcast_intent(&intent);
     }
-    // Every ~102 seconds
-    if (gCurrentTicks % 4096 == 0)
-    {
-        gParkSize = CalculateParkSize();
-        window_invalidate_by_class(WC_PARK_INFORMATION);
-    }
     // Every new week
     if (date.IsWeekStart())
     {
@@ -348,7 +354,7 @@ int32_t Park::CalculateParkSize() const
     {
         if (it.element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
         {
-            if (it.element->AsSurface()->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED))
+            if (park_ownership_counts_towards_size(it.element->AsSurface()->GetOwnership()))
             {
                 tiles++;
             }
@@ -793,11 +799,75 @@ void Park::UpdateHistories()
     window_invalidate_by_class(WC_FINANCES);
 }
 
+static uint8_t park_get_counted_guest_thought(const Peep* peep)
+{
+    if (peep->AssignedPeepType != PeepType::Guest || peep->OutsideOfPark || peep->Thoughts[0].freshness > 5)
+    {
+        return PEEP_THOUGHT_TYPE_NONE;
+    }
+    return peep->Thoughts[0].type;
+}
+
+static void park_set_counted_guest_thought(uint16_t spriteIndex, uint8_t thoughtType)
+{
+    if (spriteIndex >= _guestCountedThoughts.size())
+    {
+        if (thoughtType == PEEP_THOUGHT_TYPE_NONE)
+        {
+            return;
+        }
+        _guestCountedThoughts.resize(spriteIndex + 1, PEEP_THOUGHT_TYPE_NONE);
+    }
+
+    auto& countedThought = _guestCountedThoughts[spriteIndex];
+    if (countedThought == thoughtType)
+    {
+        return;
+    }
+    if (countedThought != PEEP_THOUGHT_TYPE_NONE)
+    {
+        _guestThoughtCounts[countedThought]--;
+    }
+    if (thoughtType != PEEP_THOUGHT_TYPE_NONE)
+    {
+        _guestThoughtCounts[thoughtType]++;
+    }
+    countedThought = thoughtType;
+}
+
+void park_update_guest_thought(const Peep* peep)
+{
+    park_set_counted_guest_thought(peep->sprite_index, park_get_counted_guest_thought(peep));
+}
+
+void park_remove_guest_thought(const Peep* peep)
+{
+    park_set_counted_guest_thought(peep->sprite_index, PEEP_THOUGHT_TYPE_NONE);
+}
+
+/**
+ * Counts the thoughts of every guest again, for when the entities have been replaced as a whole.
+ */
+void park_recount_guest_thoughts()
+{
+    _guestThoughtCounts.fill(0);
+    _guestCountedThoughts.clear();
+    for (auto peep : EntityList<Guest>(EntityListId::Peep))
+    {
+        park_update_guest_thought(peep);
+    }
+}
+
 int32_t park_is_open()
 {
     return GetContext()->GetGameState()->GetPark().IsOpen();
 }
 
+bool park_ownership_counts_towards_size(uint8_t ownership)
+{
+    return (ownership & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED)) != 0;
+}
+
 int32_t park_calculate_size()
 {
     auto tiles = GetContext()->GetGameState()->GetPark().CalculateParkSize();
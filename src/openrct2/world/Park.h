@@ -61,6 +61,11 @@ namespace OpenRCT2
         bool IsOpen() const;
 
         uint16_t GetParkRating() const;
+
+        /**
+         * Returns the number of guests in the park whose most recent thought is of the given type and still fresh.
+         */
+        uint32_t GetGuestThoughtCount(uint8_t thoughtType) const;
         money32 GetParkValue() const;
         money32 GetCompanyValue() const;
 
@@ -112,8 +117,19 @@ void set_forced_park_rating(int32_t rating);
 int32_t get_forced_park_rating();
 
 int32_t park_is_open();
+
+// Called whenever the most recent thought of a guest, its freshness or whether the guest is in the park changes
+void park_update_guest_thought(const Peep* peep);
+void park_remove_guest_thought(const Peep* peep);
+void park_recount_guest_thoughts();
 int32_t park_calculate_size();
 
+/**
+ * Whether a surface tile with the given ownership flags is part of the park size. The park size is counted over the whole
+ * map by park_calculate_size and kept up to date by map_set_surface_ownership after that.
+ */
+bool park_ownership_counts_towards_size(uint8_t ownership);
+
 void update_park_fences(const CoordsXY& coords);
 void update_park_fences_around_tile(const CoordsXY& coords);
 
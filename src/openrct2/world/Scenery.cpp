@@ -55,15 +55,27 @@ money32 gClearSceneryCost;
 // rct2: 0x009A3E74
 const CoordsXY SceneryQuadrantOffsets[] = { { 7, 7 }, { 7, 23 }, { 23, 23 }, { 23, 7 } };
 
-void scenery_update_tile(const CoordsXY& sceneryPos)
+/**
+ * Returns false if the tile has no scenery that ages or fountains that start, ghosts included.
+ */
+bool scenery_update_tile(const CoordsXY& sceneryPos)
 {
     TileElement* tileElement;
 
     tileElement = map_get_first_element_at(sceneryPos);
     if (tileElement == nullptr)
-        return;
+        return false;
+
+    bool active = false;
     do
     {
+        auto type = tileElement->GetType();
+        if (type == TILE_ELEMENT_TYPE_SMALL_SCENERY
+            || (type == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->HasAddition()))
+        {
+            active = true;
+        }
+
         // Ghosts are purely this-client-side and should not cause any interaction,
         // as that may lead to a desync.
         if (network_get_mode() != NETWORK_MODE_NONE)
@@ -95,6 +107,7 @@ void scenery_update_tile(const CoordsXY& sceneryPos)
             }
         }
     } while (!(tileElement++)->IsLastForTile());
+    return active;
 }
 
 /**
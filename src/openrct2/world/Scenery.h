@@ -253,7 +253,7 @@ extern const CoordsXY SceneryQuadrantOffsets[];
 extern money32 gClearSceneryCost;
 
 void init_scenery();
-void scenery_update_tile(const CoordsXY& sceneryPos);
+bool scenery_update_tile(const CoordsXY& sceneryPos);
 void scenery_set_default_placement_configuration();
 void scenery_remove_ghost_tool_placement();
 
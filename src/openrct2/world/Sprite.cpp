@@ -13,23 +13,48 @@
 #include "../Game.h"
 #include "../OpenRCT2.h"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Crypt.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "Park.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <memory>
+#include <vector>
 
 uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
-static rct_sprite _spriteList[MAX_SPRITES];
 
-static bool _spriteFlashingList[MAX_SPRITES];
+// Entities are stored in fixed size chunks so that growing the pool never moves existing entities.
+static constexpr size_t ENTITY_CHUNK_SHIFT = 10;
+static constexpr size_t ENTITY_CHUNK_SIZE = 1 << ENTITY_CHUNK_SHIFT;
+static constexpr size_t ENTITY_CHUNK_MASK = ENTITY_CHUNK_SIZE - 1;
+
+static std::vector<std::unique_ptr<rct_sprite[]>> _spriteChunks;
+static size_t _spriteCapacity;
+static size_t _maxEntities = MAX_SPRITES;
+
+static std::vector<bool> _spriteFlashingList;
+
+static EntityHotData _entityHotData;
+// Holds SPRITE_INDEX_NULL where entities have been removed, the free list index is only ever popped from the back
+// and doubles as the free stack.
+static std::vector<uint16_t> _entityListIndices[static_cast<uint8_t>(EntityListId::Count)];
+static size_t _entityListTombstones[static_cast<uint8_t>(EntityListId::Count)];
+static uint32_t _entityListVersions[static_cast<uint8_t>(EntityListId::Count)];
+// Whether the links of the free list match the free stack, see sprite_list_link_free.
+static bool _freeListLinked = true;
+static std::vector<uint16_t> _entityGenerations;
+// Position of each entity in the index of its list.
+static std::vector<uint32_t> _entityListPositions;
 
 uint16_t gSpriteSpatialIndex[SPATIAL_INDEX_SIZE];
 
@@ -46,11 +71,39 @@ const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_JUICE_CUP,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE };
 
-static CoordsXYZ _spritelocations1[MAX_SPRITES];
-static CoordsXYZ _spritelocations2[MAX_SPRITES];
+// The litter in each bucket of tiles, in no particular order, and the amount of litter on each tile.
+static std::vector<uint16_t> _litterBuckets[LITTER_BUCKETS_PER_ROW * LITTER_BUCKETS_PER_ROW];
+static std::vector<uint16_t> _litterTileCounts(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+
+// The number of peeps on each tile, and the tile each entity has been counted on.
+static constexpr uint32_t PEEP_DENSITY_TILE_NONE = std::numeric_limits<uint32_t>::max();
+static std::vector<uint16_t> _peepTileCounts(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+static std::vector<uint32_t> _peepCountedTiles;
+
+// The positions of the entities that moved during the last tick, before and after it.
+static std::vector<CoordsXYZ> _spritelocations1;
+static std::vector<CoordsXYZ> _spritelocations2;
+static std::vector<uint16_t> _tweenEntities;
+static std::vector<bool> _tweenTracked;
+// Whether moves are being recorded, from sprite_position_tween_store_a until sprite_position_tween_store_b.
+static bool _tweenRecording;
+
+// Redraw rectangles of entities, collected over a tick and merged before they are passed on to the viewports.
+struct PendingSpriteInvalidation
+{
+    int32_t Left;
+    int32_t Top;
+    int32_t Right;
+    int32_t Bottom;
+    int32_t MaxZoom;
+};
+static constexpr size_t MAX_PENDING_SPRITE_INVALIDATIONS = 16384;
+static std::vector<PendingSpriteInvalidation> _pendingSpriteInvalidations;
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
 static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex);
+static void sprite_position_tween_record(const SpriteBase* sprite);
+static void sprite_position_tween_clear();
 
 // Required for GetEntity to return a default
 template<> bool SpriteBase::Is<SpriteBase>() const
@@ -83,6 +136,394 @@ uint16_t GetEntityListCount(EntityListId list)
     return gSpriteListCount[static_cast<uint8_t>(list)];
 }
 
+size_t GetEntityCapacity()
+{
+    return _spriteCapacity;
+}
+
+size_t GetEntityMemoryUsage()
+{
+    size_t size = _spriteChunks.size() * ENTITY_CHUNK_SIZE * sizeof(rct_sprite);
+    size += _entityGenerations.capacity() * sizeof(uint16_t) + _entityListPositions.capacity() * sizeof(uint32_t);
+    for (const auto& indices : _entityListIndices)
+    {
+        size += indices.capacity() * sizeof(uint16_t);
+    }
+    size += (_spritelocations1.capacity() + _spritelocations2.capacity()) * sizeof(CoordsXYZ);
+    size += _peepCountedTiles.capacity() * sizeof(uint32_t);
+    size += _entityHotData.X.capacity() * (7 * sizeof(int16_t) + sizeof(uint8_t) + sizeof(EntityListId));
+    return size;
+}
+
+size_t GetMaxEntities()
+{
+    return _maxEntities;
+}
+
+void SetMaxEntities(size_t maxEntities)
+{
+    _maxEntities = std::clamp<size_t>(maxEntities, std::max<size_t>(MAX_SPRITES, _spriteCapacity), MAX_ENTITIES_LIMIT);
+}
+
+static rct_sprite& GetEntitySlot(size_t spriteIndex)
+{
+    return _spriteChunks[spriteIndex >> ENTITY_CHUNK_SHIFT][spriteIndex & ENTITY_CHUNK_MASK];
+}
+
+/**
+ * Makes sure there is storage for the given number of slots, the contents of newly allocated slots are zeroed.
+ */
+static void sprite_list_reserve(size_t capacity)
+{
+    size_t numChunks = (capacity + ENTITY_CHUNK_MASK) >> ENTITY_CHUNK_SHIFT;
+    while (_spriteChunks.size() < numChunks)
+    {
+        _spriteChunks.push_back(std::make_unique<rct_sprite[]>(ENTITY_CHUNK_SIZE));
+    }
+    _spriteFlashingList.resize(capacity, false);
+    _spritelocations1.resize(capacity);
+    _spritelocations2.resize(capacity);
+    _tweenTracked.resize(capacity, false);
+    _peepCountedTiles.resize(capacity, PEEP_DENSITY_TILE_NONE);
+
+    auto& hot = _entityHotData;
+    hot.X.resize(capacity, LOCATION_NULL);
+    hot.Y.resize(capacity, LOCATION_NULL);
+    hot.Z.resize(capacity, 0);
+    hot.SpriteLeft.resize(capacity, LOCATION_NULL);
+    hot.SpriteTop.resize(capacity, 0);
+    hot.SpriteRight.resize(capacity, 0);
+    hot.SpriteBottom.resize(capacity, 0);
+    hot.SpriteIdentifier.resize(capacity, SPRITE_IDENTIFIER_NULL);
+    hot.ListId.resize(capacity, EntityListId::Free);
+    _entityListPositions.resize(capacity, 0);
+    _entityGenerations.resize(capacity, 0);
+}
+
+const EntityHotData& GetEntityHotData()
+{
+    return _entityHotData;
+}
+
+const std::vector<uint16_t>& GetEntityListIndices(EntityListId list)
+{
+    return _entityListIndices[static_cast<uint8_t>(list)];
+}
+
+uint32_t GetEntityListVersion(EntityListId list)
+{
+    return _entityListVersions[static_cast<uint8_t>(list)];
+}
+
+std::vector<EntityHandle> GetEntityListHandles(EntityListId list)
+{
+    const auto& indices = _entityListIndices[static_cast<uint8_t>(list)];
+    std::vector<EntityHandle> handles;
+    handles.reserve(indices.size());
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it)
+    {
+        if (*it != SPRITE_INDEX_NULL)
+        {
+            handles.push_back({ *it, _entityGenerations[*it] });
+        }
+    }
+    return handles;
+}
+
+uint16_t GetEntityGeneration(size_t spriteIndex)
+{
+    return spriteIndex < _spriteCapacity ? _entityGenerations[spriteIndex] : 0;
+}
+
+uint32_t GetEntityListPosition(uint16_t spriteIndex)
+{
+    return spriteIndex < _spriteCapacity ? _entityListPositions[spriteIndex] : 0;
+}
+
+EntityHandle GetEntityHandle(const SpriteBase* entity)
+{
+    if (entity == nullptr)
+    {
+        return {};
+    }
+    return { entity->sprite_index, _entityGenerations[entity->sprite_index] };
+}
+
+static void entity_hot_data_update_position(const SpriteBase* sprite)
+{
+    auto& hot = _entityHotData;
+    auto i = sprite->sprite_index;
+    hot.X[i] = sprite->x;
+    hot.Y[i] = sprite->y;
+    hot.Z[i] = sprite->z;
+    hot.SpriteLeft[i] = sprite->sprite_left;
+    hot.SpriteTop[i] = sprite->sprite_top;
+    hot.SpriteRight[i] = sprite->sprite_right;
+    hot.SpriteBottom[i] = sprite->sprite_bottom;
+}
+
+static void entity_hot_data_update(const SpriteBase* sprite)
+{
+    entity_hot_data_update_position(sprite);
+    _entityHotData.SpriteIdentifier[sprite->sprite_index] = sprite->sprite_identifier;
+    _entityHotData.ListId[sprite->sprite_index] = sprite->linked_list_index;
+}
+
+/**
+ * Adds an entity to the index of a list, it is now the head of the linked list.
+ */
+static void entity_list_index_push(EntityListId list, uint16_t spriteIndex)
+{
+    auto& indices = _entityListIndices[static_cast<uint8_t>(list)];
+    _entityListPositions[spriteIndex] = static_cast<uint32_t>(indices.size());
+    indices.push_back(spriteIndex);
+    _entityListVersions[static_cast<uint8_t>(list)]++;
+}
+
+static void entity_list_index_compact(EntityListId list)
+{
+    auto& indices = _entityListIndices[static_cast<uint8_t>(list)];
+    indices.erase(std::remove(indices.begin(), indices.end(), SPRITE_INDEX_NULL), indices.end());
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        _entityListPositions[indices[i]] = static_cast<uint32_t>(i);
+    }
+    _entityListTombstones[static_cast<uint8_t>(list)] = 0;
+}
+
+static void entity_list_index_remove(EntityListId list, uint16_t spriteIndex)
+{
+    auto& indices = _entityListIndices[static_cast<uint8_t>(list)];
+    size_t position = _entityListPositions[spriteIndex];
+    if (position >= indices.size() || indices[position] != spriteIndex)
+    {
+        auto it = std::find(indices.begin(), indices.end(), spriteIndex);
+        if (it == indices.end())
+        {
+            log_error("Entity %u is missing from the index of its list.", spriteIndex);
+            return;
+        }
+        position = it - indices.begin();
+    }
+
+    // The order of the remaining entities determines the order in which the game updates them, so leave a hole
+    // rather than moving the last entity into it. Holes are squeezed out once they make up half of the index.
+    auto& tombstones = _entityListTombstones[static_cast<uint8_t>(list)];
+    indices[position] = SPRITE_INDEX_NULL;
+    _entityListVersions[static_cast<uint8_t>(list)]++;
+    tombstones++;
+    while (!indices.empty() && indices.back() == SPRITE_INDEX_NULL)
+    {
+        indices.pop_back();
+        tombstones--;
+    }
+    if (tombstones > 64 && tombstones * 2 > indices.size())
+    {
+        entity_list_index_compact(list);
+    }
+}
+
+/**
+ * Restores the links of the free list from the free stack. Allocating and freeing entities only updates the stack,
+ * the links are needed by the list repair functions and when saving.
+ */
+static void sprite_list_link_free()
+{
+    if (_freeListLinked)
+    {
+        return;
+    }
+
+    auto freeListIndex = static_cast<uint8_t>(EntityListId::Free);
+    const auto& freeStack = _entityListIndices[freeListIndex];
+    SpriteBase* previous = nullptr;
+    gSpriteListHead[freeListIndex] = SPRITE_INDEX_NULL;
+    for (auto it = freeStack.rbegin(); it != freeStack.rend(); ++it)
+    {
+        auto* spr = GetEntity(*it);
+        if (spr == nullptr)
+        {
+            continue;
+        }
+        spr->next = SPRITE_INDEX_NULL;
+        if (previous == nullptr)
+        {
+            spr->previous = SPRITE_INDEX_NULL;
+            gSpriteListHead[freeListIndex] = spr->sprite_index;
+        }
+        else
+        {
+            spr->previous = previous->sprite_index;
+            previous->next = spr->sprite_index;
+        }
+        previous = spr;
+    }
+    _freeListLinked = true;
+}
+
+/**
+ * Rebuilds the hot data and list indices from the entities, for use after entities or their lists have been modified
+ * directly, such as when loading a park.
+ */
+static bool litter_index_get_tile(const SpriteBase* litter, int32_t& tileX, int32_t& tileY)
+{
+    if (litter->x == LOCATION_NULL)
+        return false;
+
+    tileX = std::clamp(litter->x / COORDS_XY_STEP, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    tileY = std::clamp(litter->y / COORDS_XY_STEP, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    return true;
+}
+
+static void litter_index_add(const SpriteBase* litter)
+{
+    int32_t tileX, tileY;
+    if (!litter_index_get_tile(litter, tileX, tileY))
+        return;
+
+    auto bucketIndex = (tileX / LITTER_BUCKET_TILES) * LITTER_BUCKETS_PER_ROW + (tileY / LITTER_BUCKET_TILES);
+    _litterBuckets[bucketIndex].push_back(litter->sprite_index);
+    _litterTileCounts[tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY]++;
+}
+
+static void litter_index_remove(const SpriteBase* litter)
+{
+    int32_t tileX, tileY;
+    if (!litter_index_get_tile(litter, tileX, tileY))
+        return;
+
+    auto& bucket = _litterBuckets[(tileX / LITTER_BUCKET_TILES) * LITTER_BUCKETS_PER_ROW + (tileY / LITTER_BUCKET_TILES)];
+    auto it = std::find(bucket.begin(), bucket.end(), litter->sprite_index);
+    if (it == bucket.end())
+        return;
+
+    *it = bucket.back();
+    bucket.pop_back();
+    _litterTileCounts[tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY]--;
+}
+
+static void litter_index_rebuild()
+{
+    for (auto& bucket : _litterBuckets)
+    {
+        bucket.clear();
+    }
+    std::fill(_litterTileCounts.begin(), _litterTileCounts.end(), 0);
+    for (auto spriteIndex : _entityListIndices[static_cast<uint8_t>(EntityListId::Litter)])
+    {
+        auto* litter = GetEntity(spriteIndex);
+        if (litter != nullptr && litter->sprite_identifier == SPRITE_IDENTIFIER_LITTER)
+        {
+            litter_index_add(litter);
+        }
+    }
+}
+
+const std::vector<uint16_t>& GetLitterBucket(int32_t bucketX, int32_t bucketY)
+{
+    return _litterBuckets[bucketX * LITTER_BUCKETS_PER_ROW + bucketY];
+}
+
+uint16_t GetLitterCountAtTile(const CoordsXY& mapPos)
+{
+    auto tileX = mapPos.x / COORDS_XY_STEP;
+    auto tileY = mapPos.y / COORDS_XY_STEP;
+    if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return 0;
+    return _litterTileCounts[tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY];
+}
+
+/**
+ * Moves the entity to the count of the tile it is on now, or drops it from the counts if it is no longer a peep on
+ * the map.
+ */
+static void peep_density_update(const SpriteBase* entity)
+{
+    auto tile = PEEP_DENSITY_TILE_NONE;
+    if (entity->sprite_identifier == SPRITE_IDENTIFIER_PEEP && entity->x != LOCATION_NULL)
+    {
+        auto tileX = std::clamp(entity->x / COORDS_XY_STEP, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        auto tileY = std::clamp(entity->y / COORDS_XY_STEP, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        tile = tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY;
+    }
+
+    auto& countedTile = _peepCountedTiles[entity->sprite_index];
+    if (countedTile == tile)
+        return;
+
+    if (countedTile != PEEP_DENSITY_TILE_NONE)
+        _peepTileCounts[countedTile]--;
+    if (tile != PEEP_DENSITY_TILE_NONE)
+        _peepTileCounts[tile]++;
+    countedTile = tile;
+}
+
+static void peep_density_rebuild()
+{
+    std::fill(_peepTileCounts.begin(), _peepTileCounts.end(), 0);
+    std::fill(_peepCountedTiles.begin(), _peepCountedTiles.end(), PEEP_DENSITY_TILE_NONE);
+    for (auto spriteIndex : _entityListIndices[static_cast<uint8_t>(EntityListId::Peep)])
+    {
+        auto* peep = GetEntity(spriteIndex);
+        if (peep != nullptr)
+        {
+            peep_density_update(peep);
+        }
+    }
+}
+
+uint16_t GetPeepCountAtTile(const CoordsXY& mapPos)
+{
+    auto tileX = mapPos.x / COORDS_XY_STEP;
+    auto tileY = mapPos.y / COORDS_XY_STEP;
+    if (mapPos.x < 0 || mapPos.y < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return 0;
+    return _peepTileCounts[tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY];
+}
+
+void reset_entity_hot_data()
+{
+    for (size_t i = 0; i < _spriteCapacity; i++)
+    {
+        entity_hot_data_update(&GetEntitySlot(i).generic);
+    }
+
+    for (uint8_t list = 0; list < static_cast<uint8_t>(EntityListId::Count); list++)
+    {
+        if (list == static_cast<uint8_t>(EntityListId::Free) && !_freeListLinked)
+        {
+            // The free stack is more recent than the links of the free list.
+            entity_list_index_compact(EntityListId::Free);
+            continue;
+        }
+
+        auto& indices = _entityListIndices[list];
+        _entityListTombstones[list] = 0;
+        _entityListVersions[list]++;
+        indices.clear();
+        for (uint16_t spriteIndex = gSpriteListHead[list]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            auto* spr = GetEntity(spriteIndex);
+            if (spr == nullptr || indices.size() >= _spriteCapacity)
+            {
+                // Broken or cyclic list, check_for_sprite_list_cycles deals with those.
+                break;
+            }
+            indices.push_back(spriteIndex);
+            spriteIndex = spr->next;
+        }
+        std::reverse(indices.begin(), indices.end());
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            _entityListPositions[indices[i]] = static_cast<uint32_t>(i);
+        }
+    }
+
+    litter_index_rebuild();
+    peep_density_rebuild();
+    park_recount_guest_thoughts();
+}
+
 std::string rct_sprite_checksum::ToString() const
 {
     std::string result;
@@ -100,7 +541,7 @@ std::string rct_sprite_checksum::ToString() const
 
 SpriteBase* try_get_sprite(size_t spriteIndex)
 {
-    return spriteIndex >= MAX_SPRITES ? nullptr : &_spriteList[spriteIndex].generic;
+    return spriteIndex >= _spriteCapacity ? nullptr : &GetEntitySlot(spriteIndex).generic;
 }
 
 SpriteBase* get_sprite(size_t spriteIndex)
@@ -109,7 +550,7 @@ SpriteBase* get_sprite(size_t spriteIndex)
     {
         return nullptr;
     }
-    openrct2_assert(spriteIndex < MAX_SPRITES, "Tried getting sprite %u", spriteIndex);
+    openrct2_assert(spriteIndex < _spriteCapacity, "Tried getting sprite %u", spriteIndex);
     return try_get_sprite(spriteIndex);
 }
 
@@ -123,14 +564,59 @@ static void invalidate_sprite_max_zoom(SpriteBase* sprite, int32_t maxZoom)
     if (sprite->sprite_left == LOCATION_NULL)
         return;
 
+    _pendingSpriteInvalidations.push_back(
+        { sprite->sprite_left, sprite->sprite_top, sprite->sprite_right, sprite->sprite_bottom, maxZoom });
+    if (_pendingSpriteInvalidations.size() >= MAX_PENDING_SPRITE_INVALIDATIONS)
+    {
+        sprite_flush_invalidations();
+    }
+}
+
+void sprite_flush_invalidations()
+{
+    if (_pendingSpriteInvalidations.empty())
+        return;
+
+    // Sorted by left edge so that overlapping rectangles end up next to each other and can be merged in one pass.
+    std::sort(
+        _pendingSpriteInvalidations.begin(), _pendingSpriteInvalidations.end(),
+        [](const PendingSpriteInvalidation& a, const PendingSpriteInvalidation& b) { return a.Left < b.Left; });
+
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
     {
         rct_viewport* viewport = &g_viewport_list[i];
-        if (viewport->width != 0 && viewport->zoom <= maxZoom)
+        if (viewport->width == 0)
+            continue;
+
+        bool hasMerged = false;
+        PendingSpriteInvalidation merged{};
+        for (const auto& invalidation : _pendingSpriteInvalidations)
         {
-            viewport_invalidate(viewport, sprite->sprite_left, sprite->sprite_top, sprite->sprite_right, sprite->sprite_bottom);
+            if (viewport->zoom > invalidation.MaxZoom)
+                continue;
+
+            if (hasMerged && invalidation.Left <= merged.Right && invalidation.Top <= merged.Bottom
+                && invalidation.Bottom >= merged.Top)
+            {
+                merged.Right = std::max(merged.Right, invalidation.Right);
+                merged.Top = std::min(merged.Top, invalidation.Top);
+                merged.Bottom = std::max(merged.Bottom, invalidation.Bottom);
+                continue;
+            }
+
+            if (hasMerged)
+            {
+                viewport_invalidate(viewport, merged.Left, merged.Top, merged.Right, merged.Bottom);
+            }
+            merged = invalidation;
+            hasMerged = true;
+        }
+        if (hasMerged)
+        {
+            viewport_invalidate(viewport, merged.Left, merged.Top, merged.Right, merged.Bottom);
         }
     }
+    _pendingSpriteInvalidations.clear();
 }
 
 /**
@@ -165,20 +651,38 @@ void SpriteBase::Invalidate2()
  *  rct2: 0x0069EB13
  */
 void reset_sprite_list()
+{
+    reset_sprite_list(MAX_SPRITES, gConfigGeneral.max_entities);
+}
+
+/**
+ * Clears all entities and resizes the pool to the given number of slots, all of which end up in the free list.
+ * @param maxEntities the number of slots the pool is allowed to grow to when it runs out of free slots.
+ */
+void reset_sprite_list(size_t capacity, size_t maxEntities)
 {
     gSavedAge = 0;
-    std::memset(static_cast<void*>(_spriteList), 0, sizeof(_spriteList));
+
+    sprite_position_tween_clear();
+    capacity = std::clamp<size_t>(capacity, 1, MAX_ENTITIES_LIMIT);
+    sprite_list_reserve(capacity);
+    _spriteCapacity = capacity;
+    _maxEntities = 0;
+    SetMaxEntities(maxEntities);
+    for (auto& chunk : _spriteChunks)
+    {
+        std::memset(static_cast<void*>(chunk.get()), 0, ENTITY_CHUNK_SIZE * sizeof(rct_sprite));
+    }
 
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
     {
         gSpriteListHead[i] = SPRITE_INDEX_NULL;
         gSpriteListCount[i] = 0;
-        _spriteFlashingList[i] = false;
     }
 
     SpriteBase* previous_spr = nullptr;
 
-    for (int32_t i = 0; i < MAX_SPRITES; ++i)
+    for (int32_t i = 0; i < static_cast<int32_t>(capacity); ++i)
     {
         auto* spr = GetEntity(i);
         if (spr == nullptr)
@@ -205,9 +709,17 @@ void reset_sprite_list()
         previous_spr = spr;
     }
 
-    gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] = MAX_SPRITES;
+    gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] = static_cast<uint16_t>(capacity);
+
+    // Invalidate all handles to the entities that were just cleared.
+    for (auto& generation : _entityGenerations)
+    {
+        generation++;
+    }
 
+    _freeListLinked = true;
     reset_sprite_spatial_index();
+    reset_entity_hot_data();
 }
 
 /**
@@ -219,7 +731,7 @@ void reset_sprite_list()
 void reset_sprite_spatial_index()
 {
     std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         auto* spr = GetEntity(i);
         if (spr != nullptr && spr->sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -254,75 +766,142 @@ static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
 
 #ifndef DISABLE_NETWORK
 
-rct_sprite_checksum sprite_checksum()
+static void sprite_checksum_update(Crypt::Sha1Algorithm& hashAlg, const SpriteBase* sprite)
+{
+    // TODO create a way to copy only the specific type
+    // Upconvert it to rct_sprite so that the full size is copied.
+    auto copy = *reinterpret_cast<const rct_sprite*>(sprite);
+
+    // Only required for rendering/invalidation, has no meaning to the game state.
+    copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
+    copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
+
+    // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
+    while (auto* nextSprite = GetEntity(copy.generic.next_in_quadrant))
+    {
+        if (nextSprite->sprite_identifier == SPRITE_IDENTIFIER_MISC)
+            copy.generic.next_in_quadrant = nextSprite->next_in_quadrant;
+        else
+            break;
+    }
+
+    if (copy.generic.Is<Peep>())
+    {
+        // Name is pointer and will not be the same across clients
+        copy.peep.Name = {};
+
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
+        // game state.
+        copy.peep.WindowInvalidateFlags = 0;
+
+        // Only used for painting, clients that do not draw never fill it.
+        copy.peep.SpriteCache = {};
+    }
+    else if (copy.generic.Is<Vehicle>())
+    {
+        // Only used for painting and holds pointers, it is worked out differently on clients that do not draw.
+        copy.vehicle.SpriteCache = {};
+    }
+
+    hashAlg.Update(&copy, sizeof(copy));
+}
+
+static bool sprite_checksum_includes(const SpriteBase* sprite)
 {
-    using namespace Crypt;
+    return sprite != nullptr && sprite->sprite_identifier != SPRITE_IDENTIFIER_NULL
+        && sprite->sprite_identifier != SPRITE_IDENTIFIER_MISC;
+}
 
+static rct_sprite_checksum sprite_checksum_serial()
+{
     // TODO Remove statics, should be one of these per sprite manager / OpenRCT2 context.
     //      Alternatively, make a new class for this functionality.
-    static std::unique_ptr<HashAlgorithm<20>> _spriteHashAlg;
+    static std::unique_ptr<Crypt::Sha1Algorithm> _spriteHashAlg;
 
-    rct_sprite_checksum checksum;
+    if (_spriteHashAlg == nullptr)
+    {
+        _spriteHashAlg = Crypt::CreateSHA1();
+    }
 
-    try
+    rct_sprite_checksum checksum;
+    _spriteHashAlg->Clear();
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
-        if (_spriteHashAlg == nullptr)
+        auto* sprite = GetEntity(i);
+        if (sprite_checksum_includes(sprite))
         {
-            _spriteHashAlg = CreateSHA1();
+            sprite_checksum_update(*_spriteHashAlg, sprite);
         }
+    }
+    checksum.raw = _spriteHashAlg->Finish();
+    return checksum;
+}
 
-        _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_SPRITES; i++)
-        {
-            // TODO create a way to copy only the specific type
-            auto sprite = GetEntity(i);
-            if (sprite != nullptr && sprite->sprite_identifier != SPRITE_IDENTIFIER_NULL
-                && sprite->sprite_identifier != SPRITE_IDENTIFIER_MISC)
-            {
-                // Upconvert it to rct_sprite so that the full size is copied.
-                auto copy = *reinterpret_cast<rct_sprite*>(sprite);
-
-                // Only required for rendering/invalidation, has no meaning to the game state.
-                copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
-                copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
-
-                // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
-                while (auto* nextSprite = GetEntity(copy.generic.next_in_quadrant))
-                {
-                    if (nextSprite->sprite_identifier == SPRITE_IDENTIFIER_MISC)
-                        copy.generic.next_in_quadrant = nextSprite->next_in_quadrant;
-                    else
-                        break;
-                }
-
-                if (copy.generic.Is<Peep>())
-                {
-                    // Name is pointer and will not be the same across clients
-                    copy.peep.Name = {};
+/**
+ * Hashes every chunk of the entity pool on its own in parallel, the checksum is the hash of the chunk hashes in
+ * order. The chunks are laid out the same on all clients so the result only depends on the game state.
+ */
+static rct_sprite_checksum sprite_checksum_chunked()
+{
+    static std::vector<std::unique_ptr<Crypt::Sha1Algorithm>> _chunkHashAlgs;
+    static std::unique_ptr<Crypt::Sha1Algorithm> _combineHashAlg;
 
-                    // We set this to 0 because as soon the client selects a guest the window will remove the
-                    // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
-                    // game state.
-                    copy.peep.WindowInvalidateFlags = 0;
-                }
+    size_t numChunks = _spriteChunks.size();
+    while (_chunkHashAlgs.size() < numChunks)
+    {
+        _chunkHashAlgs.push_back(Crypt::CreateSHA1());
+    }
+    if (_combineHashAlg == nullptr)
+    {
+        _combineHashAlg = Crypt::CreateSHA1();
+    }
 
-                _spriteHashAlg->Update(&copy, sizeof(copy));
+    std::vector<Crypt::Sha1Algorithm::Result> chunkHashes(numChunks);
+    TaskScheduler::GetGlobal().ParallelFor(0, numChunks, 1, [&chunkHashes](size_t chunkIndex) {
+        auto& hashAlg = *_chunkHashAlgs[chunkIndex];
+        hashAlg.Clear();
+        size_t end = std::min(_spriteCapacity, (chunkIndex + 1) << ENTITY_CHUNK_SHIFT);
+        for (size_t i = chunkIndex << ENTITY_CHUNK_SHIFT; i < end; i++)
+        {
+            auto* sprite = GetEntity(i);
+            if (sprite_checksum_includes(sprite))
+            {
+                sprite_checksum_update(hashAlg, sprite);
             }
         }
+        chunkHashes[chunkIndex] = hashAlg.Finish();
+    });
 
-        checksum.raw = _spriteHashAlg->Finish();
+    rct_sprite_checksum checksum;
+    _combineHashAlg->Clear();
+    for (const auto& chunkHash : chunkHashes)
+    {
+        _combineHashAlg->Update(chunkHash.data(), chunkHash.size());
+    }
+    checksum.raw = _combineHashAlg->Finish();
+    return checksum;
+}
+
+rct_sprite_checksum sprite_checksum(SpriteChecksumAlgorithm algorithm)
+{
+    try
+    {
+        if (algorithm == SpriteChecksumAlgorithm::Chunked)
+        {
+            return sprite_checksum_chunked();
+        }
+        return sprite_checksum_serial();
     }
     catch (std::exception& e)
     {
         log_error("sprite_checksum failed: %s", e.what());
         throw;
     }
-
-    return checksum;
 }
 #else
 
-rct_sprite_checksum sprite_checksum()
+rct_sprite_checksum sprite_checksum([[maybe_unused]] SpriteChecksumAlgorithm algorithm)
 {
     return rct_sprite_checksum{};
 }
@@ -355,6 +934,7 @@ static void sprite_reset(SpriteBase* sprite)
  */
 void sprite_clear_all_unused()
 {
+    sprite_list_link_free();
     for (auto sprite : EntityList(EntityListId::Free))
     {
         sprite_reset(sprite);
@@ -375,9 +955,49 @@ static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc);
 
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 
+/**
+ * Adds another chunk of slots to the entity pool, limited by the maximum number of entities. The new slots are put
+ * on top of the free stack in ascending order so that allocation stays deterministic across clients.
+ * @return false if the pool has already reached its maximum size.
+ */
+static bool sprite_list_grow()
+{
+    size_t oldCapacity = _spriteCapacity;
+    size_t newCapacity = std::min(oldCapacity + ENTITY_CHUNK_SIZE, _maxEntities);
+    if (newCapacity <= oldCapacity)
+    {
+        return false;
+    }
+
+    sprite_list_reserve(newCapacity);
+    _spriteCapacity = newCapacity;
+
+    auto freeListIndex = static_cast<uint8_t>(EntityListId::Free);
+    for (size_t i = newCapacity; i-- > oldCapacity;)
+    {
+        auto& slot = GetEntitySlot(i);
+        std::memset(static_cast<void*>(&slot), 0, sizeof(rct_sprite));
+
+        auto* spr = &slot.generic;
+        spr->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        spr->sprite_index = static_cast<uint16_t>(i);
+        spr->linked_list_index = EntityListId::Free;
+        spr->next_in_quadrant = SPRITE_INDEX_NULL;
+        spr->previous = SPRITE_INDEX_NULL;
+        spr->next = SPRITE_INDEX_NULL;
+        entity_list_index_push(EntityListId::Free, spr->sprite_index);
+        entity_hot_data_update(spr);
+        _spriteFlashingList[i] = false;
+        _spritelocations1[i] = _spritelocations2[i] = { LOCATION_NULL, 0, 0 };
+    }
+    gSpriteListCount[freeListIndex] += static_cast<uint16_t>(newCapacity - oldCapacity);
+    _freeListLinked = false;
+    return true;
+}
+
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linkedListIndex)
 {
-    if (GetEntityListCount(EntityListId::Free) == 0)
+    if (GetEntityListCount(EntityListId::Free) == 0 && !sprite_list_grow())
     {
         // No free sprites.
         return nullptr;
@@ -389,13 +1009,22 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linke
         // free it will fail to keep slots for more relevant sprites.
         // Also there can't be more than MAX_MISC_SPRITES sprites in this list.
         uint16_t miscSlotsRemaining = MAX_MISC_SPRITES - GetEntityListCount(EntityListId::Misc);
-        if (miscSlotsRemaining >= GetEntityListCount(EntityListId::Free))
+        while (miscSlotsRemaining >= GetEntityListCount(EntityListId::Free))
         {
-            return nullptr;
+            if (GetEntityListCount(EntityListId::Misc) >= MAX_MISC_SPRITES || !sprite_list_grow())
+            {
+                return nullptr;
+            }
         }
     }
 
-    auto* sprite = GetEntity(gSpriteListHead[static_cast<uint8_t>(EntityListId::Free)]);
+    // Take the most recently freed slot, the same one the head of the free list would be.
+    const auto& freeStack = _entityListIndices[static_cast<uint8_t>(EntityListId::Free)];
+    if (freeStack.empty())
+    {
+        return nullptr;
+    }
+    auto* sprite = GetEntity(freeStack.back());
     if (sprite == nullptr)
     {
         return nullptr;
@@ -417,6 +1046,9 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linke
 
     SpriteSpatialInsert(sprite, { LOCATION_NULL, 0 });
 
+    entity_hot_data_update(sprite);
+    _entityHotData.SpriteIdentifier[sprite->sprite_index] = spriteIdentifier;
+
     return reinterpret_cast<rct_sprite*>(sprite);
 }
 
@@ -459,59 +1091,74 @@ static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex)
         return;
     }
 
-    // If the sprite is currently the head of the list, the
-    // sprite following this one becomes the new head of the list.
-    if (sprite->previous == SPRITE_INDEX_NULL)
+    // The free list is kept as a stack of indices, its links are only restored when they are needed.
+    if (oldListIndex == EntityListId::Free || newListIndex == EntityListId::Free)
     {
-        gSpriteListHead[static_cast<uint8_t>(oldListIndex)] = sprite->next;
+        _freeListLinked = false;
     }
-    else
+
+    if (oldListIndex != EntityListId::Free)
     {
-        // Hook up sprite->previous->next to sprite->next, removing the sprite from its old list
-        auto previous = GetEntity(sprite->previous);
-        if (previous == nullptr)
+        // If the sprite is currently the head of the list, the
+        // sprite following this one becomes the new head of the list.
+        if (sprite->previous == SPRITE_INDEX_NULL)
         {
-            log_error("Broken previous entity id. Entity list corrupted!");
+            gSpriteListHead[static_cast<uint8_t>(oldListIndex)] = sprite->next;
         }
         else
         {
-            previous->next = sprite->next;
+            // Hook up sprite->previous->next to sprite->next, removing the sprite from its old list
+            auto previous = GetEntity(sprite->previous);
+            if (previous == nullptr)
+            {
+                log_error("Broken previous entity id. Entity list corrupted!");
+            }
+            else
+            {
+                previous->next = sprite->next;
+            }
         }
-    }
 
-    // Similarly, hook up sprite->next->previous to sprite->previous
-    if (sprite->next != SPRITE_INDEX_NULL)
-    {
-        auto next = GetEntity(sprite->next);
-        if (next == nullptr)
-        {
-            log_error("Broken next entity id. Entity list corrupted!");
-        }
-        else
+        // Similarly, hook up sprite->next->previous to sprite->previous
+        if (sprite->next != SPRITE_INDEX_NULL)
         {
-            next->previous = sprite->previous;
+            auto next = GetEntity(sprite->next);
+            if (next == nullptr)
+            {
+                log_error("Broken next entity id. Entity list corrupted!");
+            }
+            else
+            {
+                next->previous = sprite->previous;
+            }
         }
     }
 
-    sprite->previous = SPRITE_INDEX_NULL; // We become the new head of the target list, so there's no previous sprite
     sprite->linked_list_index = newListIndex;
-
-    sprite->next = gSpriteListHead[static_cast<uint8_t>(
-        newListIndex)]; // This sprite's next sprite is the old head, since we're the new head
-    gSpriteListHead[static_cast<uint8_t>(newListIndex)] = sprite->sprite_index; // Store this sprite's index as head of its new
-                                                                                // list
-
-    if (sprite->next != SPRITE_INDEX_NULL)
+    if (newListIndex == EntityListId::Free)
     {
-        // Fix the chain by settings sprite->next->previous to sprite_index
-        auto next = GetEntity(sprite->next);
-        if (next == nullptr)
-        {
-            log_error("Broken next entity id. Entity list corrupted!");
-        }
-        else
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = SPRITE_INDEX_NULL;
+    }
+    else
+    {
+        // We become the new head of the target list, so there's no previous sprite and the old head is the next one
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = gSpriteListHead[static_cast<uint8_t>(newListIndex)];
+        gSpriteListHead[static_cast<uint8_t>(newListIndex)] = sprite->sprite_index;
+
+        if (sprite->next != SPRITE_INDEX_NULL)
         {
-            next->previous = sprite->sprite_index;
+            // Fix the chain by settings sprite->next->previous to sprite_index
+            auto next = GetEntity(sprite->next);
+            if (next == nullptr)
+            {
+                log_error("Broken next entity id. Entity list corrupted!");
+            }
+            else
+            {
+                next->previous = sprite->sprite_index;
+            }
         }
     }
 
@@ -519,6 +1166,10 @@ static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex)
     // Decrement old list counter, increment new list counter.
     gSpriteListCount[static_cast<uint8_t>(oldListIndex)]--;
     gSpriteListCount[static_cast<uint8_t>(newListIndex)]++;
+
+    entity_list_index_remove(oldListIndex, sprite->sprite_index);
+    entity_list_index_push(newListIndex, sprite->sprite_index);
+    _entityHotData.ListId[sprite->sprite_index] = newListIndex;
 }
 
 /**
@@ -723,6 +1374,13 @@ static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
  */
 void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
 {
+    sprite_position_tween_record(this);
+    bool isLitter = sprite_identifier == SPRITE_IDENTIFIER_LITTER;
+    if (isLitter)
+    {
+        litter_index_remove(this);
+    }
+
     auto loc = newLocation;
     if (!map_is_location_valid(loc))
     {
@@ -737,11 +1395,18 @@ void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
         x = loc.x;
         y = loc.y;
         z = loc.z;
+        entity_hot_data_update_position(this);
     }
     else
     {
         sprite_set_coordinates(loc, this);
     }
+
+    if (isLitter)
+    {
+        litter_index_add(this);
+    }
+    peep_density_update(this);
 }
 
 void sprite_set_coordinates(const CoordsXYZ& spritePos, SpriteBase* sprite)
@@ -755,6 +1420,7 @@ void sprite_set_coordinates(const CoordsXYZ& spritePos, SpriteBase* sprite)
     sprite->x = spritePos.x;
     sprite->y = spritePos.y;
     sprite->z = spritePos.z;
+    entity_hot_data_update_position(sprite);
 }
 
 /**
@@ -767,15 +1433,150 @@ void sprite_remove(SpriteBase* sprite)
     if (peep != nullptr)
     {
         peep->SetName({});
+        park_remove_guest_thought(peep);
+    }
+    if (sprite->sprite_identifier == SPRITE_IDENTIFIER_LITTER)
+    {
+        litter_index_remove(sprite);
     }
 
     move_sprite_to_list(sprite, EntityListId::Free);
     sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+    _entityHotData.SpriteIdentifier[sprite->sprite_index] = SPRITE_IDENTIFIER_NULL;
+    _entityGenerations[sprite->sprite_index]++;
+    // A new entity in this slot must not be tweened from where this one was.
+    _tweenTracked[sprite->sprite_index] = false;
     _spriteFlashingList[sprite->sprite_index] = false;
+    peep_density_update(sprite);
 
     SpriteSpatialRemove(sprite);
 }
 
+/**
+ * Restores the links of a list from its index, the order of the entities is kept.
+ */
+static void entity_list_relink(EntityListId list)
+{
+    auto listIndex = static_cast<uint8_t>(list);
+    const auto& indices = _entityListIndices[listIndex];
+    SpriteBase* previous = nullptr;
+    gSpriteListHead[listIndex] = SPRITE_INDEX_NULL;
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it)
+    {
+        auto* spr = GetEntity(*it);
+        spr->next = SPRITE_INDEX_NULL;
+        if (previous == nullptr)
+        {
+            spr->previous = SPRITE_INDEX_NULL;
+            gSpriteListHead[listIndex] = spr->sprite_index;
+        }
+        else
+        {
+            spr->previous = previous->sprite_index;
+            previous->next = spr->sprite_index;
+        }
+        previous = spr;
+    }
+}
+
+/**
+ * Removes many entities at once, leaving the lists, the free stack and the spatial index exactly as removing them
+ * one by one in the given order with sprite_remove would. Rather than unlinking every entity on its own, the lists and
+ * the spatial index are each rebuilt in a single pass. Every entity must be given only once.
+ */
+void sprite_remove_bulk(const std::vector<SpriteBase*>& entities)
+{
+    // Not worth the passes over the lists and the spatial index.
+    if (entities.size() < 64)
+    {
+        for (auto* entity : entities)
+        {
+            sprite_remove(entity);
+        }
+        return;
+    }
+
+    std::vector<bool> removed(_spriteCapacity, false);
+    bool listsAffected[static_cast<uint8_t>(EntityListId::Count)]{};
+    for (auto* sprite : entities)
+    {
+        auto peep = sprite->As<Peep>();
+        if (peep != nullptr)
+        {
+            peep->SetName({});
+            park_remove_guest_thought(peep);
+        }
+        if (sprite->sprite_identifier == SPRITE_IDENTIFIER_LITTER)
+        {
+            litter_index_remove(sprite);
+        }
+
+        auto spriteIndex = sprite->sprite_index;
+        auto oldListIndex = static_cast<uint8_t>(sprite->linked_list_index);
+        removed[spriteIndex] = true;
+        listsAffected[oldListIndex] = true;
+        gSpriteListCount[oldListIndex]--;
+        gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)]++;
+
+        sprite->linked_list_index = EntityListId::Free;
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = SPRITE_INDEX_NULL;
+        entity_list_index_push(EntityListId::Free, spriteIndex);
+
+        sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        _entityHotData.SpriteIdentifier[spriteIndex] = SPRITE_IDENTIFIER_NULL;
+        _entityHotData.ListId[spriteIndex] = EntityListId::Free;
+        _entityGenerations[spriteIndex]++;
+        _tweenTracked[spriteIndex] = false;
+        _spriteFlashingList[spriteIndex] = false;
+        peep_density_update(sprite);
+    }
+    _freeListLinked = false;
+
+    for (uint8_t list = 0; list < static_cast<uint8_t>(EntityListId::Count); list++)
+    {
+        if (!listsAffected[list] || list == static_cast<uint8_t>(EntityListId::Free))
+        {
+            continue;
+        }
+
+        auto& indices = _entityListIndices[list];
+        indices.erase(
+            std::remove_if(
+                indices.begin(), indices.end(),
+                [&removed](uint16_t spriteIndex) { return spriteIndex == SPRITE_INDEX_NULL || removed[spriteIndex]; }),
+            indices.end());
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            _entityListPositions[indices[i]] = static_cast<uint32_t>(i);
+        }
+        _entityListTombstones[list] = 0;
+        _entityListVersions[list]++;
+        entity_list_relink(static_cast<EntityListId>(list));
+    }
+
+    for (auto& head : gSpriteSpatialIndex)
+    {
+        auto* link = &head;
+        while (*link != SPRITE_INDEX_NULL)
+        {
+            auto* spr = GetEntity(*link);
+            if (spr == nullptr)
+            {
+                break;
+            }
+            if (removed[*link])
+            {
+                *link = spr->next_in_quadrant;
+            }
+            else
+            {
+                link = &spr->next_in_quadrant;
+            }
+        }
+    }
+}
+
 static bool litter_can_be_at(const CoordsXYZ& mapPos)
 {
     TileElement* tileElement;
@@ -857,6 +1658,10 @@ void litter_create(const CoordsXYZD& litterPos, int32_t type)
  */
 void litter_remove_at(const CoordsXYZ& litterPos)
 {
+    // Handymen sweep every tile they walk on, most of which are clean.
+    if (GetLitterCountAtTile(litterPos) == 0)
+        return;
+
     for (auto litter : EntityTileList<Litter>(litterPos))
     {
         if (abs(litter->z - litterPos.z) <= 16)
@@ -876,39 +1681,34 @@ void litter_remove_at(const CoordsXYZ& litterPos)
  */
 uint16_t remove_floating_sprites()
 {
-    uint16_t removed = 0;
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    std::vector<SpriteBase*> floating;
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         auto* entity = GetEntity(i);
-        if (entity->Is<Balloon>())
+        if (entity->Is<Balloon>() || entity->Is<MoneyEffect>())
         {
-            sprite_remove(entity);
-            removed++;
+            floating.push_back(entity);
         }
         else if (entity->Is<Duck>())
         {
             auto* duck = entity->As<Duck>();
             if (duck->IsFlying())
             {
-                duck->Remove();
-                removed++;
+                duck->Invalidate();
+                floating.push_back(entity);
             }
         }
-        else if (entity->Is<MoneyEffect>())
-        {
-            sprite_remove(entity);
-            removed++;
-        }
     }
-    return removed;
+    sprite_remove_bulk(floating);
+    return static_cast<uint16_t>(floating.size());
 }
 
 /**
  * Determines whether it's worth tweening a sprite or not when frame smoothing is on.
  */
-static bool sprite_should_tween(SpriteBase* sprite)
+static bool sprite_should_tween(uint8_t spriteIdentifier)
 {
-    switch (sprite->sprite_identifier)
+    switch (spriteIdentifier)
     {
         case SPRITE_IDENTIFIER_PEEP:
         case SPRITE_IDENTIFIER_VEHICLE:
@@ -917,44 +1717,68 @@ static bool sprite_should_tween(SpriteBase* sprite)
     return false;
 }
 
-static void store_sprite_locations(CoordsXYZ* sprite_locations)
+/**
+ * Remembers the position of an entity before it first moves during the tick being recorded, only the entities
+ * recorded here are tweened.
+ */
+static void sprite_position_tween_record(const SpriteBase* sprite)
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    auto spriteIndex = sprite->sprite_index;
+    if (!_tweenRecording || _tweenTracked[spriteIndex] || !sprite_should_tween(sprite->sprite_identifier))
     {
-        // skip going through `get_sprite` to not get stalled on assert,
-        // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite* sprite = &_spriteList[i];
-        sprite_locations[i].x = sprite->generic.x;
-        sprite_locations[i].y = sprite->generic.y;
-        sprite_locations[i].z = sprite->generic.z;
+        return;
     }
+
+    _tweenTracked[spriteIndex] = true;
+    _spritelocations1[spriteIndex] = { sprite->x, sprite->y, sprite->z };
+    _tweenEntities.push_back(spriteIndex);
+}
+
+static void sprite_position_tween_clear()
+{
+    for (auto spriteIndex : _tweenEntities)
+    {
+        _tweenTracked[spriteIndex] = false;
+    }
+    _tweenEntities.clear();
 }
 
 void sprite_position_tween_store_a()
 {
-    store_sprite_locations(_spritelocations1);
+    sprite_position_tween_clear();
+    _tweenRecording = true;
 }
 
 void sprite_position_tween_store_b()
 {
-    store_sprite_locations(_spritelocations2);
+    _tweenRecording = false;
+    for (auto spriteIndex : _tweenEntities)
+    {
+        if (_tweenTracked[spriteIndex])
+        {
+            const auto& hot = _entityHotData;
+            _spritelocations2[spriteIndex] = { hot.X[spriteIndex], hot.Y[spriteIndex], hot.Z[spriteIndex] };
+        }
+    }
 }
 
 void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (auto spriteIndex : _tweenEntities)
     {
-        auto* sprite = GetEntity(i);
-        if (sprite != nullptr && sprite_should_tween(sprite))
+        auto posA = _spritelocations1[spriteIndex];
+        auto posB = _spritelocations2[spriteIndex];
+        if (!_tweenTracked[spriteIndex] || posA == posB || posA.x == LOCATION_NULL
+            || !sprite_should_tween(_entityHotData.SpriteIdentifier[spriteIndex]))
+        {
+            continue;
+        }
+
+        auto* sprite = GetEntity(spriteIndex);
+        if (sprite != nullptr)
         {
-            auto posA = _spritelocations1[i];
-            auto posB = _spritelocations2[i];
-            if (posA == posB)
-            {
-                continue;
-            }
             sprite_set_coordinates(
                 { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
                   static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
@@ -970,14 +1794,19 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (auto spriteIndex : _tweenEntities)
     {
-        auto* sprite = GetEntity(i);
-        if (sprite != nullptr && sprite_should_tween(sprite))
+        if (!_tweenTracked[spriteIndex] || !sprite_should_tween(_entityHotData.SpriteIdentifier[spriteIndex]))
+        {
+            continue;
+        }
+
+        auto* sprite = GetEntity(spriteIndex);
+        if (sprite != nullptr)
         {
             sprite->Invalidate2();
 
-            auto pos = _spritelocations2[i];
+            auto pos = _spritelocations2[spriteIndex];
             sprite_set_coordinates(pos, sprite);
         }
     }
@@ -985,29 +1814,19 @@ void sprite_position_tween_restore()
 
 void sprite_position_tween_reset()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
-    {
-        auto* sprite = GetEntity(i);
-        if (sprite == nullptr)
-        {
-            continue;
-        }
-
-        _spritelocations1[i].x = _spritelocations2[i].x = sprite->x;
-        _spritelocations1[i].y = _spritelocations2[i].y = sprite->y;
-        _spritelocations1[i].z = _spritelocations2[i].z = sprite->z;
-    }
+    sprite_position_tween_clear();
+    _tweenRecording = false;
 }
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing)
 {
-    assert(sprite->sprite_index < MAX_SPRITES);
+    assert(sprite->sprite_index < _spriteCapacity);
     _spriteFlashingList[sprite->sprite_index] = flashing;
 }
 
 bool sprite_get_flashing(SpriteBase* sprite)
 {
-    assert(sprite->sprite_index < MAX_SPRITES);
+    assert(sprite->sprite_index < _spriteCapacity);
     return _spriteFlashingList[sprite->sprite_index];
 }
 
@@ -1061,6 +1880,7 @@ static bool index_is_in_list(uint16_t index, EntityListId sl)
 
 int32_t check_for_sprite_list_cycles(bool fix)
 {
+    sprite_list_link_free();
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
     {
         auto* cycle_start = find_sprite_list_cycle(gSpriteListHead[i]);
@@ -1100,6 +1920,7 @@ int32_t check_for_sprite_list_cycles(bool fix)
                     spr->next = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                reset_entity_hot_data();
             }
             return i;
         }
@@ -1114,8 +1935,10 @@ int32_t check_for_sprite_list_cycles(bool fix)
  */
 int32_t fix_disjoint_sprites()
 {
+    sprite_list_link_free();
+
     // Find reachable sprites
-    bool reachable[MAX_SPRITES] = { false };
+    std::vector<bool> reachable(_spriteCapacity, false);
 
     SpriteBase* null_list_tail = nullptr;
     for (uint16_t sprite_idx = gSpriteListHead[static_cast<uint8_t>(EntityListId::Free)]; sprite_idx != SPRITE_INDEX_NULL;)
@@ -1135,7 +1958,7 @@ int32_t fix_disjoint_sprites()
     int32_t count = 0;
 
     // Find all null sprites
-    for (uint16_t sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (uint16_t sprite_idx = 0; sprite_idx < _spriteCapacity; sprite_idx++)
     {
         auto* spr = GetEntity(sprite_idx);
         if (spr != nullptr && spr->sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -1162,5 +1985,9 @@ int32_t fix_disjoint_sprites()
             }
         }
     }
+    if (count > 0)
+    {
+        reset_entity_hot_data();
+    }
     return count;
 }
@@ -16,8 +16,15 @@
 #include "Fountain.h"
 #include "SpriteBase.h"
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #define SPRITE_INDEX_NULL 0xFFFF
+// The initial size of the entity pool, which is also the number of entities an RCT2 save can hold.
 #define MAX_SPRITES 10000
+// Entity indices are 16-bit with SPRITE_INDEX_NULL reserved, the pool can never grow beyond this.
+#define MAX_ENTITIES_LIMIT SPRITE_INDEX_NULL
 
 enum SPRITE_IDENTIFIER
 {
@@ -216,6 +223,89 @@ template<typename T = SpriteBase> T* TryGetEntity(size_t sprite_idx)
 }
 
 uint16_t GetEntityListCount(EntityListId list);
+
+/**
+ * Refers to an entity across frames. The generation of a slot changes whenever its entity is removed, so a handle
+ * kept after that no longer resolves, even once the slot has been reused by a new entity.
+ */
+struct EntityHandle
+{
+    uint16_t Index = SPRITE_INDEX_NULL;
+    uint16_t Generation = 0;
+
+    bool operator==(const EntityHandle& rhs) const
+    {
+        return Index == rhs.Index && Generation == rhs.Generation;
+    }
+    bool operator!=(const EntityHandle& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+uint16_t GetEntityGeneration(size_t spriteIndex);
+EntityHandle GetEntityHandle(const SpriteBase* entity);
+
+template<typename T = SpriteBase> T* GetEntity(const EntityHandle& handle)
+{
+    if (handle.Index == SPRITE_INDEX_NULL || GetEntityGeneration(handle.Index) != handle.Generation)
+    {
+        return nullptr;
+    }
+    return TryGetEntity<T>(handle.Index);
+}
+
+/**
+ * The fields of every entity read by loops over the whole pool, mirrored in structure-of-arrays form so that those
+ * loops do not have to pull in each rct_sprite. Indexed by sprite index and kept in sync with the entities by
+ * SpriteBase::MoveTo, sprite_set_coordinates and the functions adding entities to or removing them from lists.
+ */
+struct EntityHotData
+{
+    std::vector<int16_t> X;
+    std::vector<int16_t> Y;
+    std::vector<int16_t> Z;
+    std::vector<int16_t> SpriteLeft;
+    std::vector<int16_t> SpriteTop;
+    std::vector<int16_t> SpriteRight;
+    std::vector<int16_t> SpriteBottom;
+    std::vector<uint8_t> SpriteIdentifier;
+    std::vector<EntityListId> ListId;
+};
+const EntityHotData& GetEntityHotData();
+
+/**
+ * The sprite indices of the entities in a list. The head of the linked list is at the back, so iterating the array in
+ * reverse visits the entities in the same order as EntityList. Removed entities leave SPRITE_INDEX_NULL behind until
+ * the array is compacted. For the free list this is the stack allocation pops from, its back is the next free slot.
+ */
+const std::vector<uint16_t>& GetEntityListIndices(EntityListId list);
+
+/**
+ * Changes whenever entities are added to or removed from a list, or the list is rebuilt. Lets caches of the contents of
+ * a list tell when they have to be refreshed.
+ */
+uint32_t GetEntityListVersion(EntityListId list);
+
+/**
+ * Handles to the entities in a list, in the same order as EntityList.
+ */
+std::vector<EntityHandle> GetEntityListHandles(EntityListId list);
+
+/**
+ * The position of an entity in the index of its list, entities with a higher position come first in EntityList.
+ */
+uint32_t GetEntityListPosition(uint16_t spriteIndex);
+
+/**
+ * The number of slots currently in the entity pool. The pool starts out with MAX_SPRITES slots and grows in chunks
+ * whenever it runs out of free slots, up to the ceiling returned by GetMaxEntities().
+ */
+size_t GetEntityCapacity();
+// The size of the entity slots and the data kept for each slot
+size_t GetEntityMemoryUsage();
+size_t GetMaxEntities();
+void SetMaxEntities(size_t maxEntities);
 extern uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 extern uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
 
@@ -228,11 +318,14 @@ extern const rct_string_id litterNames[12];
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier);
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linkedListIndex);
 void reset_sprite_list();
+void reset_sprite_list(size_t capacity, size_t maxEntities);
 void reset_sprite_spatial_index();
+void reset_entity_hot_data();
 void sprite_clear_all_unused();
 void sprite_misc_update_all();
 void sprite_set_coordinates(const CoordsXYZ& spritePos, SpriteBase* sprite);
 void sprite_remove(SpriteBase* sprite);
+void sprite_remove_bulk(const std::vector<SpriteBase*>& entities);
 void litter_create(const CoordsXYZD& litterPos, int32_t type);
 void litter_remove_at(const CoordsXYZ& litterPos);
 uint16_t remove_floating_sprites();
@@ -245,6 +338,12 @@ void sprite_position_tween_all(float nudge);
 void sprite_position_tween_restore();
 void sprite_position_tween_reset();
 
+/**
+ * Passes the redraw rectangles of the entities invalidated since the last call on to the viewports, merging those
+ * that overlap. Called once per tick and before drawing a frame.
+ */
+void sprite_flush_invalidations();
+
 ///////////////////////////////////////////////////////////////
 // Balloon
 ///////////////////////////////////////////////////////////////
@@ -264,7 +363,15 @@ void duck_remove_all();
 void crashed_vehicle_particle_create(rct_vehicle_colour colours, const CoordsXYZ& vehiclePos);
 void crash_splash_create(const CoordsXYZ& splashPos);
 
-rct_sprite_checksum sprite_checksum();
+enum class SpriteChecksumAlgorithm : uint8_t
+{
+    // A single hash over all entities, used by replays.
+    Serial,
+    // Chunks of the entity pool are hashed in parallel, used by the network when both ends support it.
+    Chunked,
+};
+
+rct_sprite_checksum sprite_checksum(SpriteChecksumAlgorithm algorithm = SpriteChecksumAlgorithm::Serial);
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing);
 bool sprite_get_flashing(SpriteBase* sprite);
@@ -371,4 +478,136 @@ public:
     }
 };
 
+template<typename T, typename TFn> bool InvokeEntityQueryCallback(TFn& fn, T* entity)
+{
+    if constexpr (std::is_void_v<std::invoke_result_t<TFn&, T*>>)
+    {
+        fn(entity);
+        return true;
+    }
+    else
+    {
+        return fn(entity);
+    }
+}
+
+/**
+ * Calls fn for every entity of type T positioned within range (inclusive), only visiting the tiles of the spatial index
+ * the range overlaps. fn can return false to stop the search early, in which case false is returned. Entities are
+ * visited in no particular order and fn must not move or remove any entity other than the one it is passed.
+ */
+template<typename T = SpriteBase, typename TFn> bool ForEachEntityInRange(const MapRange& range, TFn&& fn)
+{
+    auto area = range.Normalise();
+    constexpr int32_t maxTileCoord = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * COORDS_XY_STEP;
+    auto firstX = std::clamp(floor2(area.GetLeft(), COORDS_XY_STEP), 0, maxTileCoord);
+    auto lastX = std::clamp(area.GetRight(), 0, maxTileCoord);
+    auto firstY = std::clamp(floor2(area.GetTop(), COORDS_XY_STEP), 0, maxTileCoord);
+    auto lastY = std::clamp(area.GetBottom(), 0, maxTileCoord);
+    for (int32_t tileX = firstX; tileX <= lastX; tileX += COORDS_XY_STEP)
+    {
+        for (int32_t tileY = firstY; tileY <= lastY; tileY += COORDS_XY_STEP)
+        {
+            for (auto* entity : EntityTileList<T>({ tileX, tileY }))
+            {
+                if (entity->x < area.GetLeft() || entity->x > area.GetRight() || entity->y < area.GetTop()
+                    || entity->y > area.GetBottom())
+                {
+                    continue;
+                }
+                if (!InvokeEntityQueryCallback(fn, entity))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Litter is also indexed in buckets of LITTER_BUCKET_TILES by LITTER_BUCKET_TILES tiles.
+constexpr int32_t LITTER_BUCKET_TILES = 8;
+constexpr int32_t LITTER_BUCKETS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / LITTER_BUCKET_TILES;
+
+const std::vector<uint16_t>& GetLitterBucket(int32_t bucketX, int32_t bucketY);
+uint16_t GetLitterCountAtTile(const CoordsXY& mapPos);
+
+// The number of guests and staff on a tile, kept up to date as they move.
+uint16_t GetPeepCountAtTile(const CoordsXY& mapPos);
+
+/**
+ * Calls fn for every litter positioned within range (inclusive), like ForEachEntityInRange but only visiting litter.
+ * fn must not move or remove any entity.
+ */
+template<typename TFn> bool ForEachLitterInRange(const MapRange& range, TFn&& fn)
+{
+    auto area = range.Normalise();
+    constexpr int32_t bucketSize = LITTER_BUCKET_TILES * COORDS_XY_STEP;
+    auto firstX = std::clamp(area.GetLeft() / bucketSize, 0, LITTER_BUCKETS_PER_ROW - 1);
+    auto lastX = std::clamp(area.GetRight() / bucketSize, 0, LITTER_BUCKETS_PER_ROW - 1);
+    auto firstY = std::clamp(area.GetTop() / bucketSize, 0, LITTER_BUCKETS_PER_ROW - 1);
+    auto lastY = std::clamp(area.GetBottom() / bucketSize, 0, LITTER_BUCKETS_PER_ROW - 1);
+    for (int32_t bucketX = firstX; bucketX <= lastX; bucketX++)
+    {
+        for (int32_t bucketY = firstY; bucketY <= lastY; bucketY++)
+        {
+            for (auto spriteIndex : GetLitterBucket(bucketX, bucketY))
+            {
+                auto* litter = GetEntity<Litter>(spriteIndex);
+                if (litter == nullptr || litter->x < area.GetLeft() || litter->x > area.GetRight()
+                    || litter->y < area.GetTop() || litter->y > area.GetBottom())
+                {
+                    continue;
+                }
+                if (!InvokeEntityQueryCallback(fn, litter))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Calls fn for every entity of type T within radius of centre on the map plane, see ForEachEntityInRange.
+ */
+template<typename T = SpriteBase, typename TFn> bool ForEachEntityInRadius(const CoordsXY& centre, int32_t radius, TFn&& fn)
+{
+    const int64_t radiusSquared = static_cast<int64_t>(radius) * radius;
+    return ForEachEntityInRange<T>(
+        { centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius }, [&fn, &centre, radiusSquared](T* entity) {
+            const int64_t dx = entity->x - centre.x;
+            const int64_t dy = entity->y - centre.y;
+            if (dx * dx + dy * dy > radiusSquared)
+            {
+                return true;
+            }
+            return InvokeEntityQueryCallback(fn, entity);
+        });
+}
+
+/**
+ * Calls fn for every entity of type T in the given list, in the same order as EntityList but using the dense index of
+ * the list rather than following SpriteBase::next through the pool. fn may add and remove entities: entities added
+ * during the loop are not visited and entities removed before they are reached are skipped.
+ */
+template<typename T, typename TFn> void ForEachEntityInList(EntityListId list, TFn&& fn)
+{
+    // Handles rather than indices, as fn can remove an entity and a new one can take its slot.
+    for (const auto& handle : GetEntityListHandles(list))
+    {
+        auto* entity = GetEntity(handle);
+        if (entity == nullptr || entity->linked_list_index != list)
+        {
+            continue;
+        }
+        auto* typedEntity = entity->As<T>();
+        if (typedEntity != nullptr)
+        {
+            fn(typedEntity);
+        }
+    }
+}
+
 #endif
@@ -110,14 +110,15 @@ void SurfaceElement::SetGrassLengthAndInvalidate(uint8_t length, const CoordsXY&
 }
 
 /**
+ * Returns false if the grass of the tile will stay as it is until something on the tile changes.
  *
  *  rct2: 0x006647A1
  */
-void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
+bool SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
 {
     // Check if tile is grass
     if (!CanGrassGrow())
-        return;
+        return false;
 
     uint8_t grassLengthTmp = GrassLength & 7;
 
@@ -127,7 +128,7 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
         if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
             SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
 
-        return;
+        return false;
     }
 
     // Grass can't grow any further than CLUMPS_2 but this code also cuts grass
@@ -185,9 +186,11 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
 
             if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
                 SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
+            return false;
         }
         break;
     }
+    return true;
 }
 
 uint8_t SurfaceElement::GetOwnership() const
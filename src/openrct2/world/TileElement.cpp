@@ -14,6 +14,7 @@
 #include "../localisation/Localisation.h"
 #include "../ride/Track.h"
 #include "Banner.h"
+#include "FootpathNodeCache.h"
 #include "LargeScenery.h"
 #include "Location.hpp"
 #include "Scenery.h"
@@ -27,6 +28,7 @@ void TileElementBase::SetType(uint8_t newType)
 {
     this->type &= ~TILE_ELEMENT_TYPE_MASK;
     this->type |= (newType & TILE_ELEMENT_TYPE_MASK);
+    footpath_node_cache_invalidate();
 }
 
 Direction TileElementBase::GetDirection() const
@@ -73,6 +75,7 @@ void TileElementBase::SetGhost(bool isGhost)
     {
         this->Flags &= ~TILE_ELEMENT_FLAG_GHOST;
     }
+    footpath_node_cache_invalidate();
 }
 
 bool tile_element_is_underground(TileElement* tileElement)
@@ -164,6 +167,7 @@ void TileElement::ClearAs(uint8_t newType)
     clearance_height = MINIMUM_LAND_HEIGHT;
     std::fill_n(pad_04, sizeof(pad_04), 0x00);
     std::fill_n(pad_08, sizeof(pad_08), 0x00);
+    footpath_node_cache_invalidate();
 }
 
 void TileElementBase::Remove()
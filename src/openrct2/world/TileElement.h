@@ -178,7 +178,7 @@ public:
     uint8_t GetGrassLength() const;
     void SetGrassLength(uint8_t newLength);
     void SetGrassLengthAndInvalidate(uint8_t newLength, const CoordsXY& coords);
-    void UpdateGrassLength(const CoordsXY& coords);
+    bool UpdateGrassLength(const CoordsXY& coords);
 
     uint8_t GetOwnership() const;
     void SetOwnership(uint8_t newOwnership);
@@ -23,6 +23,7 @@
 #include "../windows/tile_inspector.h"
 #include "Banner.h"
 #include "Footpath.h"
+#include "FootpathNodeCache.h"
 #include "LargeScenery.h"
 #include "Map.h"
 #include "Park.h"
@@ -60,6 +61,7 @@ static bool map_swap_elements_at(const CoordsXY& loc, int16_t first, int16_t sec
     TileElement temp = *firstElement;
     *firstElement = *secondElement;
     *secondElement = temp;
+    footpath_node_cache_invalidate();
 
     // Swap the 'last map element for tile' flag if either one of them was last
     if ((firstElement)->IsLastForTile() || (secondElement)->IsLastForTile())
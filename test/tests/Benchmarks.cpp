@@ -0,0 +1,278 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+// Microbenchmarks of the engine kernels, run on the same parks as the tests. Not run as part of the tests, compare the
+// JSON of the benchmarks target between builds.
+
+#include "TestData.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/PlatformEnvironment.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/peep/GuestPathfinding.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideRatings.h>
+#include <openrct2/ride/Station.h>
+#include <openrct2/scenario/Scenario.h>
+#include <openrct2/sprites.h>
+#include <openrct2/util/SawyerCoding.h>
+#include <openrct2/world/Map.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Loads the park from the test data, unless it is the one loaded last
+static void load_park(const char* name)
+{
+    static std::string loadedPark;
+    if (loadedPark != name)
+    {
+        std::string parkPath = TestData::GetParkPath(name);
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+        loadedPark = name;
+    }
+}
+
+static Ride* find_ride_by_name(const char* name)
+{
+    for (auto& ride : GetRideManager())
+    {
+        if (!_stricmp(ride.GetName().c_str(), name))
+        {
+            return &ride;
+        }
+    }
+    return nullptr;
+}
+
+// Picks the first direction of a guest walking to the entrance of a ride, the scenarios of the pathfinding tests
+static void BM_pathfind_choose_direction(benchmark::State& state, const char* rideName, TileCoordsXYZ start)
+{
+    load_park("pathfinding-tests.sv6");
+    scenario_rand_seed(0x12345678, 0x87654321);
+
+    auto ride = find_ride_by_name(rideName);
+    if (ride == nullptr)
+    {
+        state.SkipWithError("Ride not found in the park");
+        return;
+    }
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    Peep* peep = Peep::Generate(start.ToCoordsXYZ().ToTileCentre());
+    peep->OutsideOfPark = false;
+    peep->GuestHeadingToRideId = ride->id;
+
+    for (auto _ : state)
+    {
+        // Forget the previous search so each iteration starts from the same history
+        peep->ResetPathfindGoal();
+        gPeepPathFindGoalPosition = goal;
+        benchmark::DoNotOptimize(peep_pathfind_choose_direction(start, peep));
+    }
+
+    peep_sprite_remove(peep);
+}
+BENCHMARK_CAPTURE(BM_pathfind_choose_direction, StraightFlat, "StraightFlat", TileCoordsXYZ{ 19, 15, 14 });
+BENCHMARK_CAPTURE(BM_pathfind_choose_direction, SBend, "SBend", TileCoordsXYZ{ 15, 12, 14 });
+BENCHMARK_CAPTURE(BM_pathfind_choose_direction, CBend, "CBend", TileCoordsXYZ{ 14, 5, 14 });
+BENCHMARK_CAPTURE(BM_pathfind_choose_direction, TwoEqualRoutes, "TwoEqualRoutes", TileCoordsXYZ{ 9, 13, 14 });
+BENCHMARK_CAPTURE(BM_pathfind_choose_direction, SelfCrossingPath, "SelfCrossingPath", TileCoordsXYZ{ 6, 5, 14 });
+
+static void BM_tile_element_iterator(benchmark::State& state)
+{
+    load_park("bpb.sv6");
+    for (auto _ : state)
+    {
+        size_t numElements = 0;
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        while (tile_element_iterator_next(&it))
+        {
+            numElements++;
+        }
+        benchmark::DoNotOptimize(numElements);
+        state.counters["elements"] = static_cast<double>(numElements);
+    }
+}
+BENCHMARK(BM_tile_element_iterator);
+
+static void BM_tile_element_lookup(benchmark::State& state)
+{
+    load_park("bpb.sv6");
+    for (auto _ : state)
+    {
+        size_t numElements = 0;
+        for (int32_t y = 0; y < gMapSize; y++)
+        {
+            for (int32_t x = 0; x < gMapSize; x++)
+            {
+                auto element = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+                if (element == nullptr)
+                    continue;
+                do
+                {
+                    numElements++;
+                } while (!(element++)->IsLastForTile());
+            }
+        }
+        benchmark::DoNotOptimize(numElements);
+    }
+}
+BENCHMARK(BM_tile_element_lookup);
+
+static void BM_map_get_surface_element_at(benchmark::State& state)
+{
+    load_park("bpb.sv6");
+    for (auto _ : state)
+    {
+        for (int32_t y = 0; y < gMapSize; y++)
+        {
+            for (int32_t x = 0; x < gMapSize; x++)
+            {
+                benchmark::DoNotOptimize(map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY()));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * gMapSize * gMapSize);
+}
+BENCHMARK(BM_map_get_surface_element_at);
+
+static void BM_ride_ratings(benchmark::State& state)
+{
+    load_park("bpb.sv6");
+    for (auto _ : state)
+    {
+        for (const auto& ride : GetRideManager())
+        {
+            ride_ratings_update_ride(ride);
+        }
+    }
+    state.counters["rides"] = static_cast<double>(ride_get_count());
+}
+BENCHMARK(BM_ride_ratings)->Unit(benchmark::kMillisecond);
+
+// Runs of repeated bytes between stretches of noise, roughly how the tile elements of a saved park look
+static std::vector<uint8_t> create_sawyer_data()
+{
+    std::vector<uint8_t> data(0x100000);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < data.size();)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        size_t runLength = 1 + ((seed >> 8) & 63);
+        bool isRun = (seed >> 16) & 1;
+        for (size_t j = 0; j < runLength && i < data.size(); j++, i++)
+        {
+            data[i] = isRun ? static_cast<uint8_t>(seed >> 24) : static_cast<uint8_t>((seed >> 24) + j * 97);
+        }
+    }
+    return data;
+}
+
+static void BM_sawyercoding_encode(benchmark::State& state)
+{
+    auto data = create_sawyer_data();
+    std::vector<uint8_t> encoded(data.size() * 2 + sizeof(sawyercoding_chunk_header));
+
+    sawyercoding_chunk_header header;
+    header.encoding = static_cast<uint8_t>(state.range(0));
+    header.length = static_cast<uint32_t>(data.size());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_sawyercoding_encode)->Arg(CHUNK_ENCODING_RLE)->Arg(CHUNK_ENCODING_RLECOMPRESSED);
+
+static void BM_sawyercoding_decode(benchmark::State& state)
+{
+    auto data = create_sawyer_data();
+    std::vector<uint8_t> encoded(data.size() * 2 + sizeof(sawyercoding_chunk_header));
+
+    sawyercoding_chunk_header header;
+    header.encoding = static_cast<uint8_t>(state.range(0));
+    header.length = static_cast<uint32_t>(data.size());
+    auto encodedSize = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header);
+    for (auto _ : state)
+    {
+        MemoryStream ms(encoded.data(), encodedSize);
+        SawyerChunkReader reader(&ms);
+        benchmark::DoNotOptimize(reader.ReadChunk());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_sawyercoding_decode)->Arg(CHUNK_ENCODING_RLE)->Arg(CHUNK_ENCODING_RLECOMPRESSED);
+
+// Blits an even spread of the RCT2 sprites into an off-screen buffer
+static void BM_gfx_draw_sprite_software(benchmark::State& state)
+{
+    // The context is created without graphics, load the sprites here so the other benchmarks can run without them
+    static const bool g1Loaded = gfx_load_g1(*GetContext()->GetPlatformEnvironment());
+    if (!g1Loaded)
+    {
+        state.SkipWithError("g1.dat not found");
+        return;
+    }
+
+    constexpr int32_t BufferSize = 512;
+    constexpr int32_t NumSprites = 1024;
+    constexpr int32_t SpriteStep = (SPR_G2_BEGIN - SPR_SCROLLING_TEXT_END) / NumSprites;
+
+    std::vector<uint8_t> pixels(BufferSize * BufferSize);
+    rct_drawpixelinfo dpi{};
+    dpi.bits = pixels.data();
+    dpi.width = BufferSize;
+    dpi.height = BufferSize;
+
+    const ScreenCoordsXY centre = { BufferSize / 2, BufferSize / 2 };
+    for (auto _ : state)
+    {
+        for (int32_t i = 0; i < NumSprites; i++)
+        {
+            gfx_draw_sprite_software(&dpi, ImageId(SPR_SCROLLING_TEXT_END + i * SpriteStep), centre);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * NumSprites);
+}
+BENCHMARK(BM_gfx_draw_sprite_software);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    auto context = CreateContext();
+    if (!context->Initialise())
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
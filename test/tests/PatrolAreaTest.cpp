@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/peep/PatrolArea.h>
+#include <openrct2/util/Util.h>
+
+TEST(PatrolAreaTest, set_get_and_count)
+{
+    bitcount_init();
+    uint32_t words[PATROL_AREA_WORDS] = {};
+    PatrolArea area(words);
+    ASSERT_TRUE(area.IsEmpty());
+
+    area.Set({ 33 * COORDS_XY_STEP, 10 * COORDS_XY_STEP }, true);
+    area.Toggle({ 0, 0 });
+    ASSERT_FALSE(area.IsEmpty());
+    ASSERT_EQ(area.CountQuads(), 2);
+    // Every tile of the quad is covered.
+    ASSERT_TRUE(area.Get({ 35 * COORDS_XY_STEP, 11 * COORDS_XY_STEP }));
+    ASSERT_FALSE(area.Get({ 36 * COORDS_XY_STEP, 11 * COORDS_XY_STEP }));
+    // The layout is the one of RCT2: two words per row of quads.
+    ASSERT_EQ(words[2 * 2 + 0], 1u << 8);
+    ASSERT_EQ(words[0], 1u);
+
+    MapRange bounds;
+    ASSERT_TRUE(area.GetBounds(bounds));
+    ASSERT_EQ(bounds.GetLeft(), 0);
+    ASSERT_EQ(bounds.GetTop(), 0);
+    ASSERT_EQ(bounds.GetRight(), 35 * COORDS_XY_STEP);
+    ASSERT_EQ(bounds.GetBottom(), 11 * COORDS_XY_STEP);
+
+    area.Toggle({ 0, 0 });
+    area.Set({ 33 * COORDS_XY_STEP, 10 * COORDS_XY_STEP }, false);
+    ASSERT_TRUE(area.IsEmpty());
+    ASSERT_FALSE(area.GetBounds(bounds));
+}
+
+TEST(PatrolAreaTest, interior_quads)
+{
+    uint32_t words[PATROL_AREA_WORDS] = {};
+    PatrolArea area(words);
+    for (int32_t quadY = 30; quadY <= 32; quadY++)
+    {
+        for (int32_t quadX = 30; quadX <= 33; quadX++)
+        {
+            area.Set({ quadX * PATROL_AREA_QUAD_SIZE, quadY * PATROL_AREA_QUAD_SIZE }, true);
+        }
+    }
+    // The quads next to the word boundary between quads 31 and 32.
+    ASSERT_TRUE(area.IsQuadInterior(31, 31));
+    ASSERT_TRUE(area.IsQuadInterior(32, 31));
+    ASSERT_FALSE(area.IsQuadInterior(30, 31));
+    ASSERT_FALSE(area.IsQuadInterior(33, 31));
+    ASSERT_FALSE(area.IsQuadInterior(31, 30));
+
+    PatrolArea other(words);
+    uint32_t unionWords[PATROL_AREA_WORDS] = {};
+    PatrolArea combined(unionWords);
+    combined.Union(other);
+    ASSERT_TRUE(combined.IsQuadInterior(32, 31));
+}
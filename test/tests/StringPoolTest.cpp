@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/localisation/StringPool.h>
+
+TEST(StringPoolTest, identical_strings_share_an_id)
+{
+    auto count = StringPool::GetCount();
+    auto a = StringPool::Intern("Wooden Roller Coaster");
+    auto b = StringPool::Intern(std::string("Wooden Roller Coaster"));
+    auto c = StringPool::Intern("Wild Mouse");
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(StringPool::Get(a), "Wooden Roller Coaster");
+    ASSERT_EQ(StringPool::Get(c), "Wild Mouse");
+    ASSERT_EQ(StringPool::GetCount(), count + 2);
+
+    StringPool::Release(a);
+    StringPool::Release(b);
+    StringPool::Release(c);
+    ASSERT_EQ(StringPool::GetCount(), count);
+}
+
+TEST(StringPoolTest, string_stays_until_last_release)
+{
+    auto a = StringPool::Intern("Ferris Wheel");
+    const auto* text = StringPool::Get(a).c_str();
+    StringPool::AddRef(a);
+    StringPool::Release(a);
+    ASSERT_EQ(StringPool::Get(a).c_str(), text);
+    ASSERT_EQ(StringPool::Intern("Ferris Wheel"), a);
+    StringPool::Release(a);
+    StringPool::Release(a);
+
+    // A released id is reused for the next new string
+    auto b = StringPool::Intern("Merry-Go-Round");
+    ASSERT_EQ(b, a);
+    ASSERT_EQ(StringPool::Get(b), "Merry-Go-Round");
+    StringPool::Release(b);
+}
+
+TEST(StringPoolTest, empty_string)
+{
+    auto count = StringPool::GetCount();
+    auto id = StringPool::Intern("");
+    ASSERT_EQ(id, STRING_POOL_ID_EMPTY);
+    ASSERT_EQ(StringPool::Get(id), "");
+    StringPool::Release(id);
+    ASSERT_EQ(StringPool::GetCount(), count);
+}
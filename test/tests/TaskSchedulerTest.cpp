@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/core/TaskScheduler.h>
+#include <vector>
+
+TEST(TaskSchedulerTest, group_waits_for_all_tasks)
+{
+    TaskScheduler scheduler(4);
+    TaskGroup group;
+    std::atomic<int32_t> counter = { 0 };
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        scheduler.Schedule(group, [&counter]() { counter++; });
+    }
+    scheduler.Wait(group);
+    ASSERT_TRUE(group.IsComplete());
+    ASSERT_EQ(counter, 1000);
+}
+
+TEST(TaskSchedulerTest, parallel_for_visits_every_index_once)
+{
+    TaskScheduler scheduler(3);
+    std::vector<int32_t> visits(10007, 0);
+    scheduler.ParallelFor(0, visits.size(), 0, [&visits](size_t i) { visits[i]++; });
+    for (auto v : visits)
+    {
+        ASSERT_EQ(v, 1);
+    }
+
+    // Uneven chunk sizes and empty ranges.
+    std::fill(visits.begin(), visits.end(), 0);
+    scheduler.ParallelFor(5, 105, 33, [&visits](size_t i) { visits[i]++; });
+    scheduler.ParallelFor(10, 10, 1, [&visits](size_t i) { visits[i]++; });
+    ASSERT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 100);
+    ASSERT_EQ(visits[4], 0);
+    ASSERT_EQ(visits[5], 1);
+    ASSERT_EQ(visits[104], 1);
+    ASSERT_EQ(visits[105], 0);
+}
+
+TEST(TaskSchedulerTest, nested_waits_do_not_deadlock)
+{
+    // A single worker forces the nested groups to be completed by the waiting threads themselves.
+    TaskScheduler scheduler(1);
+    TaskGroup outer;
+    std::atomic<int32_t> counter = { 0 };
+    for (int32_t i = 0; i < 8; i++)
+    {
+        scheduler.Schedule(outer, [&scheduler, &counter]() {
+            TaskGroup inner;
+            for (int32_t j = 0; j < 8; j++)
+            {
+                scheduler.Schedule(inner, [&counter]() { counter++; });
+            }
+            scheduler.Wait(inner);
+        });
+    }
+    scheduler.Wait(outer);
+    ASSERT_EQ(counter, 64);
+}
+
+TEST(TaskSchedulerTest, report_callback_is_invoked)
+{
+    TaskScheduler scheduler(2);
+    TaskGroup group;
+    int32_t reports = 0;
+    scheduler.Schedule(group, []() {});
+    scheduler.Wait(group, [&reports]() { reports++; });
+    ASSERT_GE(reports, 1);
+}
@@ -171,3 +171,25 @@ TEST_F(TileElementWantsFootpathConnection, MapEdge)
     // The tile in the -X direction is a normal tile and should not be marked as an edge
     EXPECT_FALSE(edges & (1 << 2));
 }
+
+TEST_F(TileElementWantsFootpathConnection, TileElementTypes)
+{
+    // The type summary of every tile has to match the elements found by walking it
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            auto coords = TileCoordsXY{ x, y }.ToCoordsXY();
+            uint16_t types = 0;
+            const TileElement* tileElement = map_get_first_element_at(coords);
+            if (tileElement != nullptr)
+            {
+                do
+                {
+                    types |= tile_element_type_bit(tileElement->GetType());
+                } while (!(tileElement++)->IsLastForTile());
+            }
+            ASSERT_EQ(map_get_tile_element_types(coords), types);
+        }
+    }
+}
@@ -10,7 +10,12 @@
 #include <gtest/gtest.h>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
+#include <chrono>
+#include <cstdio>
 #include <openrct2/util/SawyerCoding.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -81,6 +86,11 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, write_read_chunk_zlib)
+{
+    test_encode_decode(CHUNK_ENCODING_ZLIB);
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and rountrip (encode + decode), which validates all uses.
@@ -106,6 +116,147 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+TEST_F(SawyerCodingTest, read_chunks)
+{
+    std::vector<uint8_t> data;
+    for (auto [chunk, size] : { std::make_pair(nonedata, sizeof(nonedata)), std::make_pair(rledata, sizeof(rledata)),
+                                std::make_pair(rlecompresseddata, sizeof(rlecompresseddata)),
+                                std::make_pair(rotatedata, sizeof(rotatedata)) })
+    {
+        data.insert(data.end(), chunk, chunk + size);
+    }
+
+    // Same sized, truncated and padded destinations.
+    std::vector<uint8_t> none(sizeof(randomdata));
+    std::vector<uint8_t> rle(sizeof(randomdata) / 2);
+    std::vector<uint8_t> rlecompressed(sizeof(randomdata) + 16, 0xFF);
+    std::vector<uint8_t> rotate(sizeof(randomdata));
+
+    OpenRCT2::MemoryStream ms(data.data(), data.size());
+    SawyerChunkReader reader(&ms);
+    reader.ReadChunks({
+        { none.data(), none.size() },
+        { rle.data(), rle.size() },
+        { rlecompressed.data(), rlecompressed.size() },
+        { rotate.data(), rotate.size() },
+    });
+    ASSERT_EQ(ms.GetPosition(), data.size());
+
+    ASSERT_EQ(memcmp(none.data(), randomdata, sizeof(randomdata)), 0);
+    ASSERT_EQ(memcmp(rle.data(), randomdata, rle.size()), 0);
+    ASSERT_EQ(memcmp(rlecompressed.data(), randomdata, sizeof(randomdata)), 0);
+    for (size_t i = sizeof(randomdata); i < rlecompressed.size(); i++)
+    {
+        ASSERT_EQ(rlecompressed[i], 0);
+    }
+    ASSERT_EQ(memcmp(rotate.data(), randomdata, sizeof(randomdata)), 0);
+}
+
+// Mixes runs, repeated sequences and noise the way the tile elements and sprites of a park do.
+static std::vector<uint8_t> CreateCodecTestData(size_t length)
+{
+    std::mt19937 rng(1234);
+    std::vector<uint8_t> data;
+    data.reserve(length + 256);
+    while (data.size() < length)
+    {
+        auto blockLength = 1 + rng() % 200;
+        switch (rng() % 3)
+        {
+            case 0:
+                data.insert(data.end(), blockLength, static_cast<uint8_t>(rng()));
+                break;
+            case 1:
+                for (size_t i = 0; i < blockLength; i++)
+                {
+                    data.push_back(static_cast<uint8_t>(rng()));
+                }
+                break;
+            case 2:
+                for (size_t i = 0; i < blockLength; i++)
+                {
+                    data.push_back(data.size() > 16 ? data[data.size() - 16] : static_cast<uint8_t>(rng() % 4));
+                }
+                break;
+        }
+    }
+    data.resize(length);
+    return data;
+}
+
+TEST_F(SawyerCodingTest, simd_kernels_match_scalar)
+{
+    auto data = CreateCodecTestData(256 * 1024);
+    std::vector<uint8_t> expected(data.size() * 2 + 2);
+    auto expectedLength = sawyercoding_encode_repeat_scalar(data.data(), expected.data(), data.size());
+    for (size_t length : { size_t(0), size_t(1), size_t(31), size_t(1000), data.size() })
+    {
+        ASSERT_EQ(
+            sawyercoding_calculate_checksum(data.data(), length), sawyercoding_calculate_checksum_scalar(data.data(), length));
+    }
+
+    std::vector<uint8_t> encoded(expected.size());
+    if (sse41_available())
+    {
+        ASSERT_EQ(
+            sawyercoding_calculate_checksum_sse4_1(data.data(), data.size()),
+            sawyercoding_calculate_checksum_scalar(data.data(), data.size()));
+        for (size_t i = 0; i < 1000; i++)
+        {
+            auto maxLength = std::min<size_t>(125, data.size() - i);
+            ASSERT_EQ(sawyercoding_count_run_sse4_1(&data[i], maxLength), sawyercoding_count_run_scalar(&data[i], maxLength));
+        }
+        ASSERT_EQ(sawyercoding_encode_repeat_sse4_1(data.data(), encoded.data(), data.size()), expectedLength);
+        ASSERT_EQ(memcmp(encoded.data(), expected.data(), expectedLength), 0);
+    }
+    if (avx2_available())
+    {
+        ASSERT_EQ(
+            sawyercoding_calculate_checksum_avx2(data.data(), data.size()),
+            sawyercoding_calculate_checksum_scalar(data.data(), data.size()));
+        ASSERT_EQ(sawyercoding_encode_repeat_avx2(data.data(), encoded.data(), data.size()), expectedLength);
+        ASSERT_EQ(memcmp(encoded.data(), expected.data(), expectedLength), 0);
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests to compare the codec speed of the scalar and best available kernels.
+TEST_F(SawyerCodingTest, DISABLED_benchmark_codec)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto data = CreateCodecTestData(3 * 1024 * 1024);
+    std::vector<uint8_t> encoded(BUFFER_SIZE * 2);
+    std::vector<uint8_t> decoded(data.size());
+
+    auto time = [](const char* name, auto&& fn) {
+        auto start = Clock::now();
+        fn();
+        auto ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::printf("%-28s %9.3f ms\n", name, ms);
+    };
+
+    auto encodeRepeatBest = avx2_available()
+        ? sawyercoding_encode_repeat_avx2
+        : (sse41_available() ? sawyercoding_encode_repeat_sse4_1 : sawyercoding_encode_repeat_scalar);
+    time("encode repeat (scalar)", [&]() { sawyercoding_encode_repeat_scalar(data.data(), encoded.data(), data.size()); });
+    time("encode repeat (best)", [&]() { encodeRepeatBest(data.data(), encoded.data(), data.size()); });
+
+    size_t chunkLength = 0;
+    time("encode rle+repeat chunk", [&]() {
+        sawyercoding_chunk_header header{ CHUNK_ENCODING_RLECOMPRESSED, static_cast<uint32_t>(data.size()) };
+        chunkLength = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header);
+    });
+    time("decode rle+repeat chunk", [&]() {
+        OpenRCT2::MemoryStream ms(encoded.data(), chunkLength);
+        SawyerChunkReader reader(&ms);
+        reader.ReadChunk(decoded.data(), decoded.size());
+    });
+    ASSERT_EQ(decoded, data);
+
+    uint32_t checksum = 0;
+    time("checksum (scalar)", [&]() { checksum = sawyercoding_calculate_checksum_scalar(data.data(), data.size()); });
+    time("checksum (best)", [&]() { ASSERT_EQ(sawyercoding_calculate_checksum(data.data(), data.size()), checksum); });
+}
+
 // 1024 bytes of random data
 // use `dd if=/dev/urandom bs=1024 count=1 | xxd -i` to get your own
 const uint8_t SawyerCodingTest::randomdata[] = {